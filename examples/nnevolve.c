@@ -361,8 +361,8 @@ void nnevolve_crossover_layerwise(population *pop, entity *mother, entity *fathe
       {
       for (i=1; i<=nn1->layer[l].neurons; i++)
         {
-        memcpy(nn1->layer[l].weight[i], ((network_t *)father->chromosome[0])->layer[l].weight[i], sizeof(float)*nn1->layer[l-1].neurons+1);
-        memcpy(nn2->layer[l].weight[i], ((network_t *)mother->chromosome[0])->layer[l].weight[i], sizeof(float)*nn1->layer[l-1].neurons+1);
+        memcpy(nn1->layer[l].weight[i], ((network_t *)father->chromosome[0])->layer[l].weight[i], sizeof(float)*(nn1->layer[l-1].neurons+1));
+        memcpy(nn2->layer[l].weight[i], ((network_t *)mother->chromosome[0])->layer[l].weight[i], sizeof(float)*(nn1->layer[l-1].neurons+1));
         }
       }
     }
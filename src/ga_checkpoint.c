@@ -0,0 +1,1003 @@
+/**********************************************************************
+  ga_checkpoint.c
+ **********************************************************************
+
+  ga_checkpoint - Checkpointing of running evolutions.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Incremental checkpointing of running evolutions.
+
+		At the end of every checkpoint interval, the evolving
+		population is snapshotted: its entities are packed,
+		with ga_entities_pack(), into a private buffer along
+		with the generation counter, the evolutionary
+		parameters, the random number generator's state, the
+		differential evolution, simulated annealling and tabu
+		search parameters, and any state private to the
+		evolutionary driver.  That is the only work done by
+		the evolution itself.  The snapshot is then written by
+		a background thread, if pthreads are available, while
+		the evolution continues.
+
+		A checkpoint file is a sequence of frames.  The first
+		is a full snapshot, which is written under a temporary
+		name and then renamed.  The following frames are
+		deltas, appended to the file, which store only those
+		entities that do not appear in the previous snapshot;
+		every other entity is stored as a reference to its
+		record in the previous snapshot.  A full snapshot
+		restarts the file every "full_interval" checkpoints.
+		An interrupted append only leaves a truncated final
+		frame, which is ignored on restoration.
+
+		ga_population_checkpoint_restore() replays the frames
+		into a population which has been set up with the same
+		callbacks as the original.  The next call to
+		ga_evolution(), ga_evolution_steady_state() or
+		ga_differentialevolution() then continues the run from
+		the restored generation, exactly as if it had never
+		been interrupted.
+
+		User data attached to entities or to the population is
+		not checkpointed.  Values are stored in host byte order.
+
+ **********************************************************************/
+
+#include "gaul/ga_checkpoint.h"
+
+/*
+ * Frame types.
+ */
+#define CHECKPOINT_MAGIC	"GAULCKP"
+#define CHECKPOINT_FULL		1
+#define CHECKPOINT_DELTA	2
+
+/*
+ * Header of each frame in a checkpoint file.
+ */
+typedef struct
+  {
+  char		magic[8];		/* CHECKPOINT_MAGIC. */
+  int		type;			/* Full or delta. */
+  int		generation;		/* Generation snapshotted. */
+  unsigned int	len;			/* Length of payload. */
+  } checkpoint_frame_t;
+
+/*
+ * Fixed-size part of each frame's payload.  It is followed by
+ * num_state ints of engine state, then, for deltas, by num_entities
+ * ints referring to records of the previous snapshot (or -1 for new
+ * records), and finally by the packed entities; for deltas, only
+ * the packed header and the new records.
+ */
+typedef struct
+  {
+  int		generation;		/* Generation counter. */
+  int		stable_size;		/* Requested population size. */
+  int		num_chromosomes;	/* For compatibility checks. */
+  int		len_chromosomes;
+  int		fitness_dimensions;
+  double	crossover_ratio;	/* Evolutionary parameters. */
+  double	mutation_ratio;
+  double	migration_ratio;
+  double	allele_mutation_prob;
+  int		allele_min_integer, allele_max_integer;
+  double	allele_min_double, allele_max_double;
+  int		scheme;
+  int		elitism;
+  int		island;
+  random_state	rng;			/* PRNG state. */
+  boolean	have_de;		/* Whether de is valid. */
+  ga_de_t	de;			/* Differential evolution parameters. */
+  boolean	have_sa;		/* Whether the sa_* values are valid. */
+  double	sa_initial_temp, sa_final_temp, sa_temp_step, sa_temperature;
+  int		sa_temp_freq;
+  boolean	have_tabu;		/* Whether the tabu_* values are valid. */
+  int		tabu_list_length, tabu_search_count;
+  int		num_state;		/* Number of engine state values. */
+  int		num_entities;		/* Number of entities, in rank order. */
+  unsigned int	header_len;		/* Length of packed header. */
+  unsigned int	record_len;		/* Length of each packed record. */
+  } checkpoint_state_t;
+
+/*
+ * A snapshot awaiting, or after, writing.
+ */
+typedef struct
+  {
+  int			type;		/* Full or delta. */
+  checkpoint_state_t	state;		/* Population state. */
+  int			*engine;	/* Engine state. */
+  gaulbyte		*entities;	/* All entities, packed. */
+  } checkpoint_snapshot_t;
+
+/*
+ * Background writer.
+ */
+typedef struct
+  {
+  char			*fname;		/* Checkpoint file. */
+  checkpoint_snapshot_t	*current;	/* Snapshot being written. */
+  checkpoint_snapshot_t	*previous;	/* Last snapshot written. */
+#ifdef HAVE_PTHREADS
+  pthread_t		tid;		/* Writer thread. */
+  boolean		running;	/* Whether tid must be joined. */
+#endif
+  } checkpoint_writer_t;
+
+
+/**********************************************************************
+  gaul_checkpoint_params()
+  synopsis:	Return a population's checkpointing parameters,
+		allocating them, with checkpointing disabled, if
+		necessary.
+  parameters:	population *pop
+  return:	Checkpointing parameters.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static ga_checkpoint_t *gaul_checkpoint_params(population *pop)
+  {
+
+  if (pop->checkpoint_params == NULL)
+    {
+    if ( !(pop->checkpoint_params = s_malloc(sizeof(ga_checkpoint_t))) )
+      die("Unable to allocate memory");
+
+    pop->checkpoint_params->fname = NULL;
+    pop->checkpoint_params->interval = 0;
+    pop->checkpoint_params->full_interval = 1;
+    pop->checkpoint_params->count = 0;
+    pop->checkpoint_params->resume = FALSE;
+    pop->checkpoint_params->num_state = 0;
+    pop->checkpoint_params->state = NULL;
+    pop->checkpoint_params->writer = NULL;
+    }
+
+  return pop->checkpoint_params;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_snapshot_free()
+  synopsis:	Deallocate a snapshot.
+  parameters:	checkpoint_snapshot_t *snapshot
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_checkpoint_snapshot_free(checkpoint_snapshot_t *snapshot)
+  {
+
+  if (!snapshot) return;
+
+  if (snapshot->engine) s_free(snapshot->engine);
+  if (snapshot->entities) s_free(snapshot->entities);
+  s_free(snapshot);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_fwrite()
+  synopsis:	Write to a checkpoint file, or die.
+  parameters:	FILE *fp
+		const void *data
+		const size_t len
+		const char *fname	For the error message.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_checkpoint_fwrite(FILE *fp, const void *data, const size_t len, const char *fname)
+  {
+
+  if ( len > 0 && fwrite(data, 1, len, fp) != len )
+    dief("Error writing checkpoint file \"%s\".", fname);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_hash()
+  synopsis:	FNV-1a hash of a packed entity record.
+  parameters:	const gaulbyte *record
+		const unsigned int len
+  return:	Hash value.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static unsigned int gaul_checkpoint_hash(const gaulbyte *record, const unsigned int len)
+  {
+  unsigned int	hash=2166136261U;	/* FNV offset basis. */
+  unsigned int	i;			/* Loop over bytes. */
+
+  for (i=0; i<len; i++)
+    {
+    hash ^= record[i];
+    hash *= 16777619U;
+    }
+
+  return hash;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_refs()
+  synopsis:	Match the records of a snapshot against those of the
+		previous snapshot.  The previous records are placed
+		in an open-addressing hash table; a match must be
+		byte-for-byte identical.
+  parameters:	checkpoint_snapshot_t *snapshot
+		checkpoint_snapshot_t *previous
+		int *refs	Filled with the index of each record in
+				the previous snapshot, or -1.
+  return:	Number of unmatched records.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static int gaul_checkpoint_refs( checkpoint_snapshot_t *snapshot,
+                                 checkpoint_snapshot_t *previous,
+                                 int *refs )
+  {
+  unsigned int	record_len = snapshot->state.record_len;
+  gaulbyte	*old_records = &(previous->entities[previous->state.header_len]);
+  gaulbyte	*new_records = &(snapshot->entities[snapshot->state.header_len]);
+  unsigned int	*hashes;		/* Hashes of previous records. */
+  int		*table;			/* Hash table of previous records. */
+  unsigned int	table_size=16;		/* Size of hash table. */
+  unsigned int	hash;			/* Hash of a new record. */
+  unsigned int	slot;			/* Hash table slot. */
+  int		num_new=0;		/* Unmatched records. */
+  int		i;			/* Loop over records. */
+
+  while (table_size < 2*(unsigned int)previous->state.num_entities)
+    table_size *= 2;
+
+  if ( !(table = s_malloc(sizeof(int)*table_size)) )
+    die("Unable to allocate memory");
+  if ( !(hashes = s_malloc(sizeof(unsigned int)*(previous->state.num_entities+1))) )
+    die("Unable to allocate memory");
+
+  for (slot=0; slot<table_size; slot++)
+    table[slot] = -1;
+
+  for (i=0; i<previous->state.num_entities; i++)
+    {
+    hashes[i] = gaul_checkpoint_hash(&(old_records[i*record_len]), record_len);
+    slot = hashes[i] & (table_size-1);
+    while (table[slot] != -1)
+      slot = (slot+1) & (table_size-1);
+    table[slot] = i;
+    }
+
+  for (i=0; i<snapshot->state.num_entities; i++)
+    {
+    hash = gaul_checkpoint_hash(&(new_records[i*record_len]), record_len);
+    slot = hash & (table_size-1);
+    refs[i] = -1;
+
+    while (table[slot] != -1)
+      {
+      if ( hashes[table[slot]] == hash &&
+           memcmp(&(old_records[table[slot]*record_len]),
+                  &(new_records[i*record_len]), record_len) == 0 )
+        {
+        refs[i] = table[slot];
+        break;
+        }
+      slot = (slot+1) & (table_size-1);
+      }
+
+    if (refs[i] == -1) num_new++;
+    }
+
+  s_free(hashes);
+  s_free(table);
+
+  return num_new;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_write()
+  synopsis:	Write the writer's current snapshot, either as a full
+		snapshot or as a delta against the previous snapshot.
+		The current snapshot then becomes the previous one.
+  parameters:	checkpoint_writer_t *writer
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_checkpoint_write(checkpoint_writer_t *writer)
+  {
+  checkpoint_snapshot_t	*snapshot = writer->current;
+  checkpoint_snapshot_t	*previous = writer->previous;
+  checkpoint_frame_t	frame;		/* Frame header. */
+  FILE			*fp;		/* Checkpoint file. */
+  char			*tmpname;	/* Temporary file name. */
+  int			*refs;		/* References to previous records. */
+  int			num_new;	/* Number of new records. */
+  unsigned int		record_len = snapshot->state.record_len;
+  unsigned int		engine_len = sizeof(int)*snapshot->state.num_state;
+  int			i;		/* Loop over records. */
+
+  if ( snapshot->type == CHECKPOINT_DELTA &&
+       ( !previous ||
+         previous->state.header_len != snapshot->state.header_len ||
+         previous->state.record_len != record_len ) )
+    snapshot->type = CHECKPOINT_FULL;
+
+  memset(&frame, 0, sizeof(checkpoint_frame_t));
+  strcpy(frame.magic, CHECKPOINT_MAGIC);
+  frame.type = snapshot->type;
+  frame.generation = snapshot->state.generation;
+
+  if (snapshot->type == CHECKPOINT_FULL)
+    {
+    frame.len = sizeof(checkpoint_state_t) + engine_len
+                + snapshot->state.header_len + snapshot->state.num_entities*record_len;
+
+    if ( !(tmpname = s_malloc(strlen(writer->fname)+5)) )
+      die("Unable to allocate memory");
+    sprintf(tmpname, "%s.tmp", writer->fname);
+
+    if ( !(fp=fopen(tmpname, "wb")) )
+      dief("Unable to open checkpoint file \"%s\" for output.", tmpname);
+
+    gaul_checkpoint_fwrite(fp, &frame, sizeof(checkpoint_frame_t), tmpname);
+    gaul_checkpoint_fwrite(fp, &(snapshot->state), sizeof(checkpoint_state_t), tmpname);
+    gaul_checkpoint_fwrite(fp, snapshot->engine, engine_len, tmpname);
+    gaul_checkpoint_fwrite(fp, snapshot->entities,
+                           snapshot->state.header_len + snapshot->state.num_entities*record_len,
+                           tmpname);
+
+    if ( fclose(fp) != 0 )
+      dief("Error writing checkpoint file \"%s\".", tmpname);
+
+    if ( rename(tmpname, writer->fname) != 0 )
+      dief("Unable to rename checkpoint file \"%s\" to \"%s\".", tmpname, writer->fname);
+
+    s_free(tmpname);
+    }
+  else
+    {
+    if ( !(refs = s_malloc(sizeof(int)*(snapshot->state.num_entities+1))) )
+      die("Unable to allocate memory");
+
+    num_new = gaul_checkpoint_refs(snapshot, previous, refs);
+
+    frame.len = sizeof(checkpoint_state_t) + engine_len
+                + sizeof(int)*snapshot->state.num_entities
+                + snapshot->state.header_len + num_new*record_len;
+
+    if ( !(fp=fopen(writer->fname, "ab")) )
+      dief("Unable to open checkpoint file \"%s\" for output.", writer->fname);
+
+    gaul_checkpoint_fwrite(fp, &frame, sizeof(checkpoint_frame_t), writer->fname);
+    gaul_checkpoint_fwrite(fp, &(snapshot->state), sizeof(checkpoint_state_t), writer->fname);
+    gaul_checkpoint_fwrite(fp, snapshot->engine, engine_len, writer->fname);
+    gaul_checkpoint_fwrite(fp, refs, sizeof(int)*snapshot->state.num_entities, writer->fname);
+    gaul_checkpoint_fwrite(fp, snapshot->entities, snapshot->state.header_len, writer->fname);
+
+    for (i=0; i<snapshot->state.num_entities; i++)
+      {
+      if (refs[i] == -1)
+        gaul_checkpoint_fwrite(fp, &(snapshot->entities[snapshot->state.header_len+i*record_len]),
+                               record_len, writer->fname);
+      }
+
+    if ( fclose(fp) != 0 )
+      dief("Error writing checkpoint file \"%s\".", writer->fname);
+
+    s_free(refs);
+
+    plog( LOG_DEBUG, "Checkpoint for generation %d stored %d of %d entities.",
+          snapshot->state.generation, num_new, snapshot->state.num_entities );
+    }
+
+  gaul_checkpoint_snapshot_free(previous);
+  writer->previous = snapshot;
+  writer->current = NULL;
+
+  return;
+  }
+
+
+#ifdef HAVE_PTHREADS
+/**********************************************************************
+  gaul_checkpoint_thread()
+  synopsis:	Background writer thread.
+  parameters:	void *data	The writer.
+  return:	NULL
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void *gaul_checkpoint_thread(void *data)
+  {
+
+  gaul_checkpoint_write((checkpoint_writer_t *)data);
+
+  return NULL;
+  }
+#endif
+
+
+/**********************************************************************
+  gaul_checkpoint_writer_free()
+  synopsis:	Wait for, then deallocate, a population's writer.  The
+		next checkpoint will be a full snapshot.
+  parameters:	population *pop
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_checkpoint_writer_free(population *pop)
+  {
+  checkpoint_writer_t	*writer;	/* Background writer. */
+
+  ga_population_checkpoint_wait(pop);
+
+  writer = (checkpoint_writer_t *)pop->checkpoint_params->writer;
+
+  if (writer)
+    {
+    gaul_checkpoint_snapshot_free(writer->previous);
+    s_free(writer->fname);
+    s_free(writer);
+    pop->checkpoint_params->writer = NULL;
+    }
+
+  pop->checkpoint_params->count = 0;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_take()
+  synopsis:	Snapshot a population and pass the snapshot to the
+		background writer.  Any previous checkpoint is
+		completed first.
+  parameters:	population *pop
+		const int num_state	Number of engine state values.
+		const int *state	Engine state values.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_checkpoint_take(population *pop, const int num_state, const int *state)
+  {
+  ga_checkpoint_t	*params = pop->checkpoint_params;
+  checkpoint_writer_t	*writer;	/* Background writer. */
+  checkpoint_snapshot_t	*snapshot;	/* New snapshot. */
+  unsigned int		len;		/* Packed length. */
+
+  ga_population_checkpoint_wait(pop);
+
+  if ( !(writer = (checkpoint_writer_t *)params->writer) )
+    {
+    if ( !(writer = s_malloc(sizeof(checkpoint_writer_t))) )
+      die("Unable to allocate memory");
+    writer->fname = s_strdup(params->fname);
+    writer->current = NULL;
+    writer->previous = NULL;
+#ifdef HAVE_PTHREADS
+    writer->running = FALSE;
+#endif
+    params->writer = writer;
+    }
+
+  if ( !(snapshot = s_malloc(sizeof(checkpoint_snapshot_t))) )
+    die("Unable to allocate memory");
+
+  snapshot->type = (params->count%params->full_interval == 0)?CHECKPOINT_FULL:CHECKPOINT_DELTA;
+  params->count++;
+
+  memset(&(snapshot->state), 0, sizeof(checkpoint_state_t));
+  snapshot->state.generation = pop->generation;
+  snapshot->state.stable_size = pop->stable_size;
+  snapshot->state.num_chromosomes = pop->num_chromosomes;
+  snapshot->state.len_chromosomes = pop->len_chromosomes;
+  snapshot->state.fitness_dimensions = pop->fitness_dimensions;
+  snapshot->state.crossover_ratio = pop->crossover_ratio;
+  snapshot->state.mutation_ratio = pop->mutation_ratio;
+  snapshot->state.migration_ratio = pop->migration_ratio;
+  snapshot->state.allele_mutation_prob = pop->allele_mutation_prob;
+  snapshot->state.allele_min_integer = pop->allele_min_integer;
+  snapshot->state.allele_max_integer = pop->allele_max_integer;
+  snapshot->state.allele_min_double = pop->allele_min_double;
+  snapshot->state.allele_max_double = pop->allele_max_double;
+  snapshot->state.scheme = pop->scheme;
+  snapshot->state.elitism = pop->elitism;
+  snapshot->state.island = pop->island;
+  snapshot->state.rng = random_get_state();
+
+  if (pop->de_params)
+    {
+    snapshot->state.have_de = TRUE;
+    snapshot->state.de = *(pop->de_params);
+    }
+
+  if (pop->sa_params)
+    {
+    snapshot->state.have_sa = TRUE;
+    snapshot->state.sa_initial_temp = pop->sa_params->initial_temp;
+    snapshot->state.sa_final_temp = pop->sa_params->final_temp;
+    snapshot->state.sa_temp_step = pop->sa_params->temp_step;
+    snapshot->state.sa_temp_freq = pop->sa_params->temp_freq;
+    snapshot->state.sa_temperature = pop->sa_params->temperature;
+    }
+
+  if (pop->tabu_params)
+    {
+    snapshot->state.have_tabu = TRUE;
+    snapshot->state.tabu_list_length = pop->tabu_params->list_length;
+    snapshot->state.tabu_search_count = pop->tabu_params->search_count;
+    }
+
+  snapshot->state.num_state = num_state;
+  snapshot->engine = NULL;
+  if (num_state > 0)
+    {
+    if ( !(snapshot->engine = s_malloc(sizeof(int)*num_state)) )
+      die("Unable to allocate memory");
+    memcpy(snapshot->engine, state, sizeof(int)*num_state);
+    }
+
+/*
+ * The packed entities are the snapshot's private copy, so the
+ * evolution may modify the population as soon as we return.
+ */
+  snapshot->state.num_entities = pop->size;
+  snapshot->state.header_len = ga_entities_packed_size(pop, 0);
+  len = ga_entities_packed_size(pop, pop->size);
+  if ( !(snapshot->entities = s_malloc(len)) )
+    die("Unable to allocate memory");
+  ga_entities_pack(pop, pop->size, NULL, snapshot->entities, len);
+  snapshot->state.record_len = pop->size>0?(len-snapshot->state.header_len)/pop->size:0;
+
+  writer->current = snapshot;
+
+#ifdef HAVE_PTHREADS
+  if (pthread_create(&(writer->tid), NULL, gaul_checkpoint_thread, (void *)writer) != 0)
+    dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+  writer->running = TRUE;
+#else
+  gaul_checkpoint_write(writer);
+#endif
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_set_checkpoint_parameters()
+  synopsis:	Sets the checkpointing parameters for a population.
+		ga_evolution(), ga_evolution_steady_state() and
+		ga_differentialevolution() will checkpoint the
+		population after every "interval" generations (or
+		iterations).  Every "full_interval"-th checkpoint is a
+		full snapshot, which restarts the file; the others only
+		store those entities which have changed.  The next
+		checkpoint is always a full snapshot.
+  parameters:	population *pop
+		const char *fname	Checkpoint file, or NULL to
+					disable checkpointing.
+		const int interval	Generations between checkpoints,
+					or 0 to disable checkpointing.
+		const int full_interval	Checkpoints between full
+					snapshots.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_checkpoint_parameters( population *pop,
+                                        const char	*fname,
+                                        const int	interval,
+                                        const int	full_interval )
+  {
+  ga_checkpoint_t	*params;	/* Checkpointing parameters. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( interval < 0 ) die("Negative checkpoint interval.");
+  if ( full_interval < 1 ) die("Full snapshot interval must be at least 1.");
+
+  plog( LOG_VERBOSE,
+        "Population's checkpoint parameters set: file = \"%s\" interval = %d full_interval = %d",
+        fname?fname:"(none)", interval, full_interval );
+
+  params = gaul_checkpoint_params(pop);
+  gaul_checkpoint_writer_free(pop);
+
+  if (params->fname) s_free(params->fname);
+  params->fname = fname?s_strdup(fname):NULL;
+  params->interval = interval;
+  params->full_interval = full_interval;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_checkpoint()
+  synopsis:	Checkpoint a population now, for example from a
+		generation hook of a custom evolutionary driver.  No
+		driver-specific state is recorded.  The checkpoint is
+		written in the background; the population may be
+		modified as soon as this function returns.
+  parameters:	population *pop
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_checkpoint( population *pop )
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->checkpoint_params || !pop->checkpoint_params->fname )
+    die("ga_population_set_checkpoint_parameters() must be called prior to ga_population_checkpoint().");
+
+  gaul_checkpoint_take(pop, 0, NULL);
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_checkpoint_wait()
+  synopsis:	Wait until any checkpoint being written in the
+		background is complete.
+  parameters:	population *pop
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_checkpoint_wait( population *pop )
+  {
+#ifdef HAVE_PTHREADS
+  checkpoint_writer_t	*writer;	/* Background writer. */
+#endif
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->checkpoint_params ) return;
+
+#ifdef HAVE_PTHREADS
+  writer = (checkpoint_writer_t *)pop->checkpoint_params->writer;
+
+  if ( writer && writer->running )
+    {
+    if ( pthread_join(writer->tid, NULL) != 0 )
+      dief("Error %d in pthread_join. (%s)", errno, errno==ESRCH?"ESRCH":errno==EINVAL?"EINVAL":errno==EDEADLK?"EDEADLK":"unknown");
+    writer->running = FALSE;
+    }
+#endif
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_checkpoint_restore()
+  synopsis:	Restore a population from a checkpoint file.  The
+		population must have been created with the same
+		callbacks, chromosome sizes and number of fitness
+		dimensions as the checkpointed population.  Its
+		entities are replaced, and its parameters, generation
+		counter and the random number generator's state are
+		restored.  The next call to ga_evolution(),
+		ga_evolution_steady_state() or
+		ga_differentialevolution() continues from the restored
+		generation, and its "max_generations" counts from the
+		start of the original run.  A truncated final frame,
+		left by an interrupted checkpoint, is ignored.
+  parameters:	population *pop
+		const char *fname	Checkpoint file.
+  return:	TRUE if restored, or FALSE if the file does not exist.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_checkpoint_restore( population *pop, const char *fname )
+  {
+  ga_checkpoint_t	*params;		/* Checkpointing parameters. */
+  FILE			*fp;			/* Checkpoint file. */
+  checkpoint_frame_t	frame;			/* Frame header. */
+  checkpoint_state_t	state;			/* Latest state. */
+  gaulbyte		*payload;		/* Frame payload. */
+  gaulbyte		*entities=NULL;		/* Latest packed entities. */
+  gaulbyte		*old_entities;		/* Previous packed entities. */
+  gaulbyte		*records;		/* New records in a delta. */
+  int			*engine=NULL;		/* Latest engine state. */
+  int			*refs=NULL;		/* References in a delta. */
+  unsigned int		old_record_len=0;	/* Previous record length. */
+  int			old_num_entities=0;	/* Previous number of entities. */
+  unsigned int		engine_len;		/* Length of engine state. */
+  unsigned int		expected;		/* Expected payload length. */
+  int			num_new;		/* New records in a delta. */
+  int			num_frames=0;		/* Frames read. */
+  int			i;			/* Loop over records. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !fname ) die("Null pointer to filename passed.");
+
+  if ( !(fp=fopen(fname, "rb")) ) return FALSE;
+
+  while ( fread(&frame, sizeof(checkpoint_frame_t), 1, fp) == 1 )
+    {
+    if ( strncmp(frame.magic, CHECKPOINT_MAGIC, 8) != 0 ||
+         (frame.type != CHECKPOINT_FULL && frame.type != CHECKPOINT_DELTA) ||
+         frame.len < sizeof(checkpoint_state_t) )
+      dief("Invalid checkpoint file \"%s\".", fname);
+
+    if ( num_frames == 0 && frame.type != CHECKPOINT_FULL )
+      dief("Checkpoint file \"%s\" does not begin with a full snapshot.", fname);
+
+    if ( !(payload = s_malloc(frame.len)) )
+      die("Unable to allocate memory");
+
+    if ( fread(payload, 1, frame.len, fp) != frame.len )
+      {
+      plog( LOG_WARNING, "Ignoring truncated checkpoint for generation %d in \"%s\".",
+            frame.generation, fname );
+      s_free(payload);
+      break;
+      }
+
+    memcpy(&state, payload, sizeof(checkpoint_state_t));
+    engine_len = sizeof(int)*state.num_state;
+
+    if (frame.type == CHECKPOINT_FULL)
+      {
+      num_new = state.num_entities;
+      expected = sizeof(checkpoint_state_t) + engine_len
+                 + state.header_len + num_new*state.record_len;
+      }
+    else
+      {
+      if (state.record_len != old_record_len)
+        dief("Invalid checkpoint file \"%s\".", fname);
+
+      refs = (int *)&(payload[sizeof(checkpoint_state_t)+engine_len]);
+      num_new = 0;
+      for (i=0; i<state.num_entities; i++)
+        {
+        if (refs[i] == -1)
+          num_new++;
+        else if (refs[i] < 0 || refs[i] >= old_num_entities)
+          dief("Invalid checkpoint file \"%s\".", fname);
+        }
+
+      expected = sizeof(checkpoint_state_t) + engine_len + sizeof(int)*state.num_entities
+                 + state.header_len + num_new*state.record_len;
+      }
+
+    if ( frame.len != expected )
+      dief("Invalid checkpoint file \"%s\".", fname);
+
+    if (engine) s_free(engine);
+    engine = NULL;
+    if (state.num_state > 0)
+      {
+      if ( !(engine = s_malloc(engine_len)) )
+        die("Unable to allocate memory");
+      memcpy(engine, &(payload[sizeof(checkpoint_state_t)]), engine_len);
+      }
+
+/*
+ * Assemble the complete set of packed entities.
+ */
+    old_entities = entities;
+    if ( !(entities = s_malloc(state.header_len + state.num_entities*state.record_len)) )
+      die("Unable to allocate memory");
+
+    if (frame.type == CHECKPOINT_FULL)
+      {
+      memcpy(entities, &(payload[sizeof(checkpoint_state_t)+engine_len]),
+             state.header_len + state.num_entities*state.record_len);
+      }
+    else
+      {
+      records = &(payload[sizeof(checkpoint_state_t)+engine_len+sizeof(int)*state.num_entities]);
+      memcpy(entities, records, state.header_len);
+      records += state.header_len;
+
+      for (i=0; i<state.num_entities; i++)
+        {
+        if (refs[i] == -1)
+          {
+          memcpy(&(entities[state.header_len+i*state.record_len]), records, state.record_len);
+          records += state.record_len;
+          }
+        else
+          {
+          memcpy(&(entities[state.header_len+i*state.record_len]),
+                 &(old_entities[state.header_len+refs[i]*state.record_len]), state.record_len);
+          }
+        }
+      }
+
+    if (old_entities) s_free(old_entities);
+    old_record_len = state.record_len;
+    old_num_entities = state.num_entities;
+
+    s_free(payload);
+    num_frames++;
+    }
+
+  fclose(fp);
+
+  if (num_frames == 0)
+    dief("Checkpoint file \"%s\" contains no snapshot.", fname);
+
+  if ( state.num_chromosomes != pop->num_chromosomes ||
+       state.len_chromosomes != pop->len_chromosomes ||
+       state.fitness_dimensions != pop->fitness_dimensions )
+    dief("Checkpoint file \"%s\" does not match the population's genome or fitness dimensions.", fname);
+
+/*
+ * Replace the entities.
+ */
+  params = gaul_checkpoint_params(pop);
+  gaul_checkpoint_writer_free(pop);
+
+  ga_genocide(pop, 0);
+  ga_entities_unpack(pop, entities, state.header_len + state.num_entities*state.record_len);
+  s_free(entities);
+
+/*
+ * Restore everything else.
+ */
+  pop->generation = state.generation;
+  pop->stable_size = state.stable_size;
+  pop->crossover_ratio = state.crossover_ratio;
+  pop->mutation_ratio = state.mutation_ratio;
+  pop->migration_ratio = state.migration_ratio;
+  pop->allele_mutation_prob = state.allele_mutation_prob;
+  pop->allele_min_integer = state.allele_min_integer;
+  pop->allele_max_integer = state.allele_max_integer;
+  pop->allele_min_double = state.allele_min_double;
+  pop->allele_max_double = state.allele_max_double;
+  pop->scheme = (ga_scheme_type) state.scheme;
+  pop->elitism = (ga_elitism_type) state.elitism;
+  pop->island = state.island;
+
+  if (state.have_de && pop->de_params)
+    *(pop->de_params) = state.de;
+
+  if (state.have_sa && pop->sa_params)
+    {
+    pop->sa_params->initial_temp = state.sa_initial_temp;
+    pop->sa_params->final_temp = state.sa_final_temp;
+    pop->sa_params->temp_step = state.sa_temp_step;
+    pop->sa_params->temp_freq = state.sa_temp_freq;
+    pop->sa_params->temperature = state.sa_temperature;
+    }
+
+  if (state.have_tabu && pop->tabu_params)
+    {
+    pop->tabu_params->list_length = state.tabu_list_length;
+    pop->tabu_params->search_count = state.tabu_search_count;
+    }
+
+  random_set_state(state.rng);
+
+  if (params->state) s_free(params->state);
+  params->state = engine;
+  params->num_state = state.num_state;
+  params->resume = TRUE;
+
+  plog( LOG_NORMAL, "Restored generation %d, with %d entities, from checkpoint \"%s\".",
+        state.generation, state.num_entities, fname );
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_resume()
+  synopsis:	Called by an evolutionary driver before it starts.  If
+		the population was restored from a checkpoint, the
+		driver's private state is restored and the driver
+		should continue from pop->generation without any
+		initialisation.
+  parameters:	population *pop
+		const int num_state	Number of engine state values.
+		int *state		Filled with engine state values,
+					if they were recorded.
+  return:	TRUE if the driver should continue a restored run.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+boolean gaul_checkpoint_resume(population *pop, const int num_state, int *state)
+  {
+  ga_checkpoint_t	*params = pop->checkpoint_params;
+
+  if ( !params || !params->resume ) return FALSE;
+
+  params->resume = FALSE;
+
+  if ( params->num_state > 0 )
+    {
+    if ( params->num_state != num_state )
+      dief("Checkpoint has %d values of engine state, not %d.", params->num_state, num_state);
+    memcpy(state, params->state, sizeof(int)*num_state);
+    }
+
+  if (params->state) s_free(params->state);
+  params->state = NULL;
+  params->num_state = 0;
+
+  plog( LOG_VERBOSE, "Continuing from generation %d.", pop->generation );
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_generation()
+  synopsis:	Called by an evolutionary driver at the end of each
+		generation.  Checkpoints the population if the
+		checkpoint interval has elapsed.
+  parameters:	population *pop
+		const int num_state	Number of engine state values.
+		const int *state	Engine state values.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+void gaul_checkpoint_generation(population *pop, const int num_state, const int *state)
+  {
+  ga_checkpoint_t	*params = pop->checkpoint_params;
+
+  if ( !params || !params->fname || params->interval < 1 ) return;
+
+  if ( pop->generation%params->interval == 0 )
+    gaul_checkpoint_take(pop, num_state, state);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_checkpoint_free()
+  synopsis:	Deallocate a population's checkpointing parameters,
+		after waiting for any checkpoint being written.
+  parameters:	population *pop
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+void gaul_checkpoint_free(population *pop)
+  {
+
+  gaul_checkpoint_writer_free(pop);
+
+  if (pop->checkpoint_params->fname) s_free(pop->checkpoint_params->fname);
+  if (pop->checkpoint_params->state) s_free(pop->checkpoint_params->state);
+  s_free(pop->checkpoint_params);
+  pop->checkpoint_params = NULL;
+
+  return;
+  }
@@ -102,6 +102,8 @@ GAULFUNC int ga_random_ascent_hillclimbing(	population		*pop,
   if (!pop->climbing_params->mutate_allele)
     die("Population's allele mutation callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_random_ascent_hillclimbing");
+
 /* Prepare working entity. */
   putative = ga_get_free_entity(pop);
 
@@ -121,7 +123,7 @@ GAULFUNC int ga_random_ascent_hillclimbing(	population		*pop,
 /*
  * Ensure that initial solution is scored.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
 
   plog( LOG_VERBOSE,
         "Prior to the first iteration, the current solution has fitness score of %f",
@@ -145,7 +147,7 @@ GAULFUNC int ga_random_ascent_hillclimbing(	population		*pop,
     allele_id = random_int(pop->len_chromosomes);
     pop->climbing_params->mutate_allele(pop, best, putative, chromo_id, allele_id);
     pop->mutate(pop, best, putative);
-    pop->evaluate(pop, putative);
+    gaul_evaluate(pop, putative);
 
 /*
  * Decide whether this new solution should be selected or discarded based
@@ -173,6 +175,8 @@ GAULFUNC int ga_random_ascent_hillclimbing(	population		*pop,
  */
   ga_entity_dereference(pop, putative);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -213,6 +217,8 @@ GAULFUNC int ga_next_ascent_hillclimbing(	population		*pop,
   if (!pop->climbing_params->mutate_allele)
     die("Population's allele mutation callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_next_ascent_hillclimbing");
+
 /* Prepare working entity. */
   putative = ga_get_free_entity(pop);
 
@@ -232,7 +238,7 @@ GAULFUNC int ga_next_ascent_hillclimbing(	population		*pop,
 /*
  * Ensure that initial solution is scored.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
 
   plog( LOG_VERBOSE,
         "Prior to the first iteration, the current solution has fitness score of %f",
@@ -262,7 +268,7 @@ GAULFUNC int ga_next_ascent_hillclimbing(	population		*pop,
  * Generate and score a new solution.
  */
     pop->climbing_params->mutate_allele(pop, best, putative, chromo_id, allele_id);
-    pop->evaluate(pop, putative);
+    gaul_evaluate(pop, putative);
 
 /*
  * Decide whether this new solution should be selected or discarded based
@@ -290,6 +296,8 @@ GAULFUNC int ga_next_ascent_hillclimbing(	population		*pop,
  */
   ga_entity_dereference(pop, putative);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -29,10 +29,47 @@
 
 		These routines return a distance between two entities.
 
+		ga_compare_matrix(), ga_compare_matrix_rows() and
+		ga_compare_neighbours() find the distances between
+		many pairs of entities at once.  For the built-in
+		comparison functions, the genomes are first packed
+		into contiguous rows: bitstring and boolean genomes
+		as 64-bit words, compared with popcount, and char,
+		integer and double genomes as arrays whose distance
+		loops the compiler can vectorise.  The pairs are then
+		compared in tiles of rows which fit in cache, and the
+		tiles are shared among threads.  On x86-64 with GCC,
+		the tile kernels are also compiled for AVX2 and FMA
+		and the best version is chosen at run time.  Any other
+		comparison function is called for each pair, in the
+		same tiles.
+
  **********************************************************************/
 
 #include "gaul/ga_core.h"
 
+/*
+ * Bytes of packed genomes compared by one tile, and the most rows in a
+ * tile.
+ */
+#define GA_COMPARE_TILE_BYTES	(64*1024)
+#define GA_COMPARE_TILE_MAX	64
+
+/*
+ * Run-time selection of the tile kernels for the best instruction set.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6 && defined(__x86_64__) && defined(__linux__)
+# define GAUL_COMPARE_CLONES	__attribute__((target_clones("arch=haswell","default")))
+#else
+# define GAUL_COMPARE_CLONES
+#endif
+
+#if defined(__GNUC__)
+# define GAUL_POPCOUNT(x)	__builtin_popcountll(x)
+#else
+# define GAUL_POPCOUNT(x)	gaul_compare_popcount(x)
+#endif
+
 /**********************************************************************
   ga_compare_char_hamming()
   synopsis:	Compares two char-array genomes and returns their
@@ -393,3 +430,600 @@ GAULFUNC double ga_compare_bitstring_euclidean(population *pop, entity *alpha, e
   }
 
 
+
+
+#if !defined(__GNUC__)
+/**********************************************************************
+  gaul_compare_popcount()
+  synopsis:	Count the bits set in a 64-bit word.
+  parameters:	unsigned long long x
+  return:	Number of bits set.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_compare_popcount(unsigned long long x)
+  {
+
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+
+  return (int) ((x * 0x0101010101010101ULL) >> 56);
+  }
+#endif
+
+
+/**********************************************************************
+  gaul_compare_pack()
+  synopsis:	Pack the genomes of a population into contiguous rows,
+		if the comparison function is a built-in one.  Unused
+		elements at the end of each row are zero, so they
+		never contribute to a distance.
+  parameters:	population *pop
+		GAcompare compare
+		gaul_compare_t *packed	Returns the packed genomes.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_compare_pack( population *pop, GAcompare compare,
+                        gaul_compare_t *packed )
+  {
+  unsigned long long	*bits;		/* Packed bits. */
+  gaulbyte		*bytes;		/* Bitstring chromosome. */
+  size_t		element=0;	/* Bytes per element. */
+  size_t		row_bytes;	/* Bytes per packed row. */
+  int			length;		/* Alleles per genome. */
+  int			i, j, k;	/* Loop over entities, chromosomes, alleles. */
+  int			bit;		/* Position in packed row. */
+
+  packed->pop = pop;
+  packed->compare = compare;
+  packed->rows = NULL;
+  packed->euclidean = FALSE;
+  packed->stride = 0;
+  length = pop->num_chromosomes*pop->len_chromosomes;
+
+  if (compare == ga_compare_bitstring_hamming || compare == ga_compare_bitstring_euclidean ||
+      compare == ga_compare_boolean_hamming || compare == ga_compare_boolean_euclidean)
+    {
+    packed->kind = GAUL_COMPARE_BITS;
+    packed->euclidean = compare == ga_compare_bitstring_euclidean ||
+                        compare == ga_compare_boolean_euclidean;
+    packed->stride = (length+63)/64;
+    element = sizeof(unsigned long long);
+    }
+  else if (compare == ga_compare_char_hamming || compare == ga_compare_char_euclidean)
+    {
+    packed->kind = GAUL_COMPARE_CHAR;
+    packed->euclidean = compare == ga_compare_char_euclidean;
+    packed->stride = (length+15)&~15;
+    element = sizeof(char);
+    }
+  else if (compare == ga_compare_integer_hamming || compare == ga_compare_integer_euclidean)
+    {
+    packed->kind = GAUL_COMPARE_INTEGER;
+    packed->euclidean = compare == ga_compare_integer_euclidean;
+    packed->stride = (length+7)&~7;
+    element = sizeof(int);
+    }
+  else if (compare == ga_compare_double_hamming || compare == ga_compare_double_euclidean)
+    {
+    packed->kind = GAUL_COMPARE_DOUBLE;
+    packed->euclidean = compare == ga_compare_double_euclidean;
+    packed->stride = (length+3)&~3;
+    element = sizeof(double);
+    }
+  else
+    {
+    packed->kind = GAUL_COMPARE_CALLBACK;
+    packed->tile = GA_COMPARE_TILE_MAX/4;
+    return;
+    }
+
+  row_bytes = packed->stride*element;
+  packed->tile = MIN(MAX(GA_COMPARE_TILE_BYTES/(2*row_bytes), 4), GA_COMPARE_TILE_MAX);
+
+  if ( !(packed->rows = s_malloc(MAX(pop->size, 1)*row_bytes)) )
+    die("Unable to allocate memory");
+  memset(packed->rows, 0, pop->size*row_bytes);
+
+  for (i=0; i<pop->size; i++)
+    {
+    for (j=0; j<pop->num_chromosomes; j++)
+      {
+      switch (packed->kind)
+        {
+        case GAUL_COMPARE_BITS:
+          bits = (unsigned long long *) packed->rows + (size_t) i*packed->stride;
+          bytes = (gaulbyte *) pop->entity_iarray[i]->chromosome[j];
+          for (k=0; k<pop->len_chromosomes; k++)
+            {
+            if (compare == ga_compare_bitstring_hamming || compare == ga_compare_bitstring_euclidean ?
+                ga_bit_get(bytes, k) : ((boolean *) pop->entity_iarray[i]->chromosome[j])[k])
+              {
+              bit = j*pop->len_chromosomes+k;
+              bits[bit/64] |= 1ULL << (bit%64);
+              }
+            }
+          break;
+        default:
+          memcpy( (char *) packed->rows + ((size_t) i*packed->stride + j*pop->len_chromosomes)*element,
+                  pop->entity_iarray[i]->chromosome[j], pop->len_chromosomes*element );
+        }
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_compare_tile()
+  synopsis:	Compare some rows of a population with a contiguous
+		range of entities.  Each kind of packed genome has a
+		kernel with independent partial sums, which the
+		compiler may vectorise.
+  parameters:	const gaul_compare_t *packed
+		const int *rows		Ranks of rows.
+		const int num_rows
+		const int first		First rank compared with.
+		const int last		Rank after the last compared with.
+		double *out		Returns distance of rows[r] and
+					entity j in out[r*ld+j-first].
+		const size_t ld		Leading dimension of out.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAUL_COMPARE_CLONES
+void gaul_compare_tile( const gaul_compare_t *packed,
+                        const int *rows, const int num_rows,
+                        const int first, const int last,
+                        double *out, const size_t ld )
+  {
+  const int	n=packed->stride;	/* Elements per row. */
+  int		r, j, k;		/* Loop over rows, entities, elements. */
+
+  for (r=0; r<num_rows; r++)
+    {
+    for (j=first; j<last; j++)
+      {
+      double	*dist=&(out[r*ld+j-first]);	/* Distance. */
+
+      switch (packed->kind)
+        {
+        case GAUL_COMPARE_BITS:
+          {
+          const unsigned long long	*a=(const unsigned long long *) packed->rows + (size_t) rows[r]*n;
+          const unsigned long long	*b=(const unsigned long long *) packed->rows + (size_t) j*n;
+          long	count=0;
+
+          for (k=0; k<n; k++)
+            count += GAUL_POPCOUNT(a[k]^b[k]);
+
+          *dist = packed->euclidean ? sqrt((double) count) : (double) count;
+          }
+          break;
+
+        case GAUL_COMPARE_CHAR:
+          {
+          const char	*a=(const char *) packed->rows + (size_t) rows[r]*n;
+          const char	*b=(const char *) packed->rows + (size_t) j*n;
+          int		sum=0;
+
+          if (packed->euclidean)
+            {
+            for (k=0; k<n; k++)
+              sum += ((int) a[k]-b[k])*((int) a[k]-b[k]);
+            *dist = sqrt((double) sum);
+            }
+          else
+            {
+            for (k=0; k<n; k++)
+              sum += abs((int) a[k]-b[k]);
+            *dist = (double) sum;
+            }
+          }
+          break;
+
+        case GAUL_COMPARE_INTEGER:
+          {
+          const int	*a=(const int *) packed->rows + (size_t) rows[r]*n;
+          const int	*b=(const int *) packed->rows + (size_t) j*n;
+          double	sum[4]={0.0, 0.0, 0.0, 0.0};
+          int		count=0;
+
+          if (packed->euclidean)
+            {
+            for (k=0; k<n; k+=4)
+              {
+              sum[0] += SQU((double) a[k]-b[k]);
+              sum[1] += SQU((double) a[k+1]-b[k+1]);
+              sum[2] += SQU((double) a[k+2]-b[k+2]);
+              sum[3] += SQU((double) a[k+3]-b[k+3]);
+              }
+            *dist = sqrt((sum[0]+sum[1])+(sum[2]+sum[3]));
+            }
+          else
+            {
+            for (k=0; k<n; k++)
+              count += abs(a[k]-b[k]);
+            *dist = (double) count;
+            }
+          }
+          break;
+
+        case GAUL_COMPARE_DOUBLE:
+          {
+          const double	*a=(const double *) packed->rows + (size_t) rows[r]*n;
+          const double	*b=(const double *) packed->rows + (size_t) j*n;
+          double	sum[4]={0.0, 0.0, 0.0, 0.0};
+
+          if (packed->euclidean)
+            {
+            for (k=0; k<n; k+=4)
+              {
+              sum[0] += SQU(a[k]-b[k]);
+              sum[1] += SQU(a[k+1]-b[k+1]);
+              sum[2] += SQU(a[k+2]-b[k+2]);
+              sum[3] += SQU(a[k+3]-b[k+3]);
+              }
+            *dist = sqrt((sum[0]+sum[1])+(sum[2]+sum[3]));
+            }
+          else
+            {
+            for (k=0; k<n; k+=4)
+              {
+              sum[0] += fabs(a[k]-b[k]);
+              sum[1] += fabs(a[k+1]-b[k+1]);
+              sum[2] += fabs(a[k+2]-b[k+2]);
+              sum[3] += fabs(a[k+3]-b[k+3]);
+              }
+            *dist = (sum[0]+sum[1])+(sum[2]+sum[3]);
+            }
+          }
+          break;
+
+        default:
+          *dist = packed->compare( packed->pop,
+                                   packed->pop->entity_iarray[rows[r]],
+                                   packed->pop->entity_iarray[j] );
+        }
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_compare_matrix()
+  synopsis:	Find the distance between every pair of entities in
+		a population.  The built-in ga_compare_*() functions
+		are recognised and replaced by vectorised kernels;
+		any other comparison function is called for each pair
+		once, and is assumed to be symmetric.  Entities are
+		taken in rank order.
+  parameters:	population *pop
+		GAcompare compare	Comparison function.
+		double *matrix		Returns the distance between the
+					entities of rank i and j in
+					matrix[i*pop->size+j].  Must hold
+					pop->size*pop->size values.
+  return:	TRUE on success.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_compare_matrix( population *pop,
+                                    GAcompare compare,
+                                    double *matrix )
+  {
+  gaul_compare_t	packed;		/* Packed genomes. */
+  int			*ranks;		/* Identity row list. */
+  int			num_tiles;	/* Tiles along each side. */
+  int			bi, bj;		/* Loop over tiles. */
+  int			i, j;		/* Loop over entities. */
+  int			i1, j1;		/* Ends of tiles. */
+  size_t		size;		/* Population size. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !compare ) die("Null pointer to comparison function passed.");
+  if ( !matrix ) die("Null pointer to matrix passed.");
+
+  if (pop->size < 1) return TRUE;
+
+  gaul_compare_pack(pop, compare, &packed);
+  size = pop->size;
+
+  if ( !(ranks = s_malloc(pop->size*sizeof(int))) )
+    die("Unable to allocate memory");
+  for (i=0; i<pop->size; i++)
+    ranks[i] = i;
+
+  num_tiles = (pop->size+packed.tile-1)/packed.tile;
+
+/*
+ * Only tiles on or above the diagonal are compared; each is mirrored
+ * below the diagonal by the thread which compared it.
+ */
+#pragma omp parallel for \
+   shared(pop,packed,ranks,num_tiles,matrix,size) private(bi,bj,i,j,i1,j1) \
+   schedule(dynamic,1)
+  for (bi=0; bi<num_tiles; bi++)
+    {
+    i1 = MIN((bi+1)*packed.tile, pop->size);
+    for (bj=bi; bj<num_tiles; bj++)
+      {
+      j1 = MIN((bj+1)*packed.tile, pop->size);
+      gaul_compare_tile( &packed, ranks+bi*packed.tile, i1-bi*packed.tile,
+                         bj*packed.tile, j1,
+                         matrix+bi*packed.tile*size+bj*packed.tile, size );
+      if (bj == bi) continue;
+      for (i=bi*packed.tile; i<i1; i++)
+        for (j=bj*packed.tile; j<j1; j++)
+          matrix[j*size+i] = matrix[i*size+j];
+      }
+    }
+
+  s_free(ranks);
+  if (packed.rows) s_free(packed.rows);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  ga_compare_matrix_rows()
+  synopsis:	Find the distances between some entities and every
+		entity in a population, as ga_compare_matrix().  This
+		suits incremental use, when only a few entities have
+		changed since the full matrix was found.
+  parameters:	population *pop
+		GAcompare compare	Comparison function.
+		const int num_rows	Number of entities.
+		const int *rows		Ranks of the entities.
+		double *matrix		Returns the distance between the
+					entities of rank rows[r] and j in
+					matrix[r*pop->size+j].  Must hold
+					num_rows*pop->size values.
+  return:	TRUE on success.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_compare_matrix_rows( population *pop,
+                                    GAcompare compare,
+                                    const int num_rows,
+                                    const int *rows,
+                                    double *matrix )
+  {
+  gaul_compare_t	packed;		/* Packed genomes. */
+  int			num_tiles;	/* Tiles of rows. */
+  int			num_columns;	/* Tiles of entities. */
+  int			b;		/* Loop over pairs of tiles. */
+  int			bi, bj;		/* Tiles of rows and entities. */
+  int			r;		/* Loop over rows. */
+  size_t		size;		/* Population size. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !compare ) die("Null pointer to comparison function passed.");
+  if ( num_rows > 0 && (!rows || !matrix) ) die("Null pointer to rows or matrix passed.");
+
+  for (r=0; r<num_rows; r++)
+    if (rows[r] < 0 || rows[r] >= pop->size) die("Invalid entity rank passed.");
+
+  if (pop->size < 1 || num_rows < 1) return TRUE;
+
+  gaul_compare_pack(pop, compare, &packed);
+  size = pop->size;
+
+  num_tiles = (num_rows+packed.tile-1)/packed.tile;
+  num_columns = (pop->size+packed.tile-1)/packed.tile;
+
+#pragma omp parallel for \
+   shared(pop,packed,rows,num_rows,num_tiles,num_columns,matrix,size) private(b,bi,bj) \
+   schedule(dynamic,1)
+  for (b=0; b<num_tiles*num_columns; b++)
+    {
+    bi = b/num_columns;
+    bj = b%num_columns;
+    gaul_compare_tile( &packed, rows+bi*packed.tile,
+                       MIN(packed.tile, num_rows-bi*packed.tile),
+                       bj*packed.tile, MIN((bj+1)*packed.tile, pop->size),
+                       matrix+bi*packed.tile*size+bj*packed.tile, size );
+    }
+
+  if (packed.rows) s_free(packed.rows);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  gaul_compare_heap_less()
+  synopsis:	Order of neighbours: by distance, then by rank.
+  parameters:
+  return:	Whether neighbour a is nearer than neighbour b.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean gaul_compare_heap_less( const double da, const int ia,
+                                       const double db, const int ib )
+  {
+  return da < db || (da == db && ia < ib);
+  }
+
+
+/**********************************************************************
+  gaul_compare_heap_sift()
+  synopsis:	Restore a max-heap of neighbours, moving the root
+		down.
+  parameters:	int *index		Ranks of neighbours.
+		double *dist		Distances of neighbours.
+		const int num		Neighbours in heap.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_compare_heap_sift(int *index, double *dist, const int num)
+  {
+  int		parent=0, child;	/* Heap positions. */
+  int		i=index[0];		/* Neighbour moving down. */
+  double	d=dist[0];		/* Its distance. */
+
+  while ((child = 2*parent+1) < num)
+    {
+    if ( child+1 < num &&
+         gaul_compare_heap_less(dist[child], index[child], dist[child+1], index[child+1]) )
+      child++;
+    if ( !gaul_compare_heap_less(d, i, dist[child], index[child]) ) break;
+    index[parent] = index[child];
+    dist[parent] = dist[child];
+    parent = child;
+    }
+
+  index[parent] = i;
+  dist[parent] = d;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_compare_neighbours()
+  synopsis:	Find the k nearest neighbours of every entity in a
+		population, using the same kernels as
+		ga_compare_matrix() but without storing the whole
+		matrix.  Ties are broken by rank.
+  parameters:	population *pop
+		GAcompare compare	Comparison function.
+		const int k		Neighbours per entity; fewer than
+					the population size.
+		int *neighbours		Returns the ranks of the neighbours
+					of entity i, nearest first, in
+					neighbours[i*k] to neighbours[i*k+k-1].
+		double *distances	Returns their distances, or NULL.
+  return:	TRUE on success.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_compare_neighbours( population *pop,
+                                    GAcompare compare,
+                                    const int k,
+                                    int *neighbours,
+                                    double *distances )
+  {
+  gaul_compare_t	packed;		/* Packed genomes. */
+  int			*ranks;		/* Identity row list. */
+  double		*dist;		/* Neighbour distances. */
+  double		*tile;		/* Distances of one tile. */
+  int			num_tiles;	/* Tiles along each side. */
+  int			bi, bj;		/* Loop over tiles. */
+  int			i, j;		/* Loop over entities. */
+  int			i1, j1;		/* Ends of tiles. */
+  int			num;		/* Neighbours found. */
+  int			child;		/* Heap position. */
+  int			*index;		/* Neighbours of entity. */
+  double		*d;		/* Distances of neighbours. */
+  double		distance;	/* Distance of candidate. */
+  double		swap_d;		/* Swap space. */
+  int			swap_i;		/* Swap space. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !compare ) die("Null pointer to comparison function passed.");
+  if ( !neighbours ) die("Null pointer to neighbours passed.");
+  if ( k < 1 || k >= pop->size ) die("Number of neighbours must be positive and less than the population size.");
+
+  gaul_compare_pack(pop, compare, &packed);
+
+  if (distances)
+    dist = distances;
+  else if ( !(dist = s_malloc((size_t) pop->size*k*sizeof(double))) )
+    die("Unable to allocate memory");
+
+  if ( !(ranks = s_malloc(pop->size*sizeof(int))) )
+    die("Unable to allocate memory");
+  for (i=0; i<pop->size; i++)
+    ranks[i] = i;
+
+  num_tiles = (pop->size+packed.tile-1)/packed.tile;
+
+/*
+ * Each thread owns a tile of rows, and compares it with every tile, so
+ * that each heap is only touched by one thread.
+ */
+#pragma omp parallel for \
+   shared(pop,packed,ranks,num_tiles,neighbours,dist) \
+   private(bi,bj,i,j,i1,j1,num,child,index,d,distance,tile,swap_d,swap_i) \
+   schedule(dynamic,1)
+  for (bi=0; bi<num_tiles; bi++)
+    {
+    if ( !(tile = s_malloc(packed.tile*packed.tile*sizeof(double))) )
+      die("Unable to allocate memory");
+
+    i1 = MIN((bi+1)*packed.tile, pop->size);
+
+    for (bj=0; bj<num_tiles; bj++)
+      {
+      j1 = MIN((bj+1)*packed.tile, pop->size);
+      gaul_compare_tile( &packed, ranks+bi*packed.tile, i1-bi*packed.tile,
+                         bj*packed.tile, j1, tile, packed.tile );
+
+      for (i=bi*packed.tile; i<i1; i++)
+        {
+        index = neighbours+(size_t) i*k;
+        d = dist+(size_t) i*k;
+        num = MIN(MAX(bj*packed.tile - (i < bj*packed.tile ? 1 : 0), 0), k);
+
+        for (j=bj*packed.tile; j<j1; j++)
+          {
+          if (j == i) continue;
+          distance = tile[(i-bi*packed.tile)*packed.tile+j-bj*packed.tile];
+
+          if (num < k)
+            {	/* Heap not full; sift up. */
+            child = num++;
+            while (child > 0 &&
+                   gaul_compare_heap_less(d[(child-1)/2], index[(child-1)/2], distance, j))
+              {
+              index[child] = index[(child-1)/2];
+              d[child] = d[(child-1)/2];
+              child = (child-1)/2;
+              }
+            index[child] = j;
+            d[child] = distance;
+            }
+          else if (gaul_compare_heap_less(distance, j, d[0], index[0]))
+            {	/* Nearer than the furthest kept; replace it. */
+            index[0] = j;
+            d[0] = distance;
+            gaul_compare_heap_sift(index, d, k);
+            }
+          }
+        }
+      }
+
+/*
+ * Sort each heap, nearest first.
+ */
+    for (i=bi*packed.tile; i<i1; i++)
+      {
+      index = neighbours+(size_t) i*k;
+      d = dist+(size_t) i*k;
+      for (num=k-1; num>0; num--)
+        {
+        swap_i = index[0]; index[0] = index[num]; index[num] = swap_i;
+        swap_d = d[0]; d[0] = d[num]; d[num] = swap_d;
+        gaul_compare_heap_sift(index, d, num);
+        }
+      }
+
+    s_free(tile);
+    }
+
+  s_free(ranks);
+  if (packed.rows) s_free(packed.rows);
+  if (!distances) s_free(dist);
+
+  return TRUE;
+  }
@@ -339,10 +339,21 @@ GAULFUNC population *ga_population_new(	const int stable_size,
   newpop->climbing_params = NULL;
   newpop->simplex_params = NULL;
   newpop->dc_params = NULL;
+  newpop->niche_params = NULL;
   newpop->gradient_params = NULL;
   newpop->search_params = NULL;
   newpop->de_params = NULL;
   newpop->sampling_params = NULL;
+  newpop->multistart_params = NULL;
+  newpop->migration_params = NULL;
+  newpop->checkpoint_params = NULL;
+  newpop->profile = NULL;
+  newpop->telemetry = NULL;
+  newpop->epoch = 0;
+  newpop->diversity = NULL;
+  newpop->stats.num = 0;
+  newpop->stats.fitness = NULL;
+  newpop->stats.max_fitness = 0;
   
 /*
  * Clean the callback functions.
@@ -406,7 +417,7 @@ GAULFUNC population *ga_population_new(	const int stable_size,
 		field is referenced.
   parameters:	population *	original population structure.
   return:	population *	new population structure.
-  last updated: 16 Feb 2005
+  last updated: 16 Oct 2026
  **********************************************************************/
 
 GAULFUNC population *ga_population_clone_empty(population *pop)
@@ -437,7 +448,7 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
   newpop->island = -1;
   newpop->generation = 0;
 
-  newpop->fitness_dimensions = 0;
+  newpop->fitness_dimensions = pop->fitness_dimensions;
 
   newpop->crossover_ratio = pop->crossover_ratio;
   newpop->mutation_ratio = pop->mutation_ratio;
@@ -446,10 +457,10 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
   newpop->elitism = pop->elitism;
 
   newpop->allele_mutation_prob = pop->allele_mutation_prob;
-  newpop->allele_min_integer = newpop->allele_min_integer;
-  newpop->allele_max_integer = newpop->allele_max_integer;
-  newpop->allele_min_double = newpop->allele_min_double;
-  newpop->allele_max_double = newpop->allele_max_double;
+  newpop->allele_min_integer = pop->allele_min_integer;
+  newpop->allele_max_integer = pop->allele_max_integer;
+  newpop->allele_min_double = pop->allele_min_double;
+  newpop->allele_max_double = pop->allele_max_double;
 
   THREAD_LOCK_NEW(newpop->lock);
 #ifdef USE_CHROMO_CHUNKS
@@ -560,6 +571,9 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
 	newpop->simplex_params->alpha = pop->simplex_params->alpha;
     newpop->simplex_params->beta = pop->simplex_params->beta;
 	newpop->simplex_params->gamma = pop->simplex_params->gamma;
+    newpop->simplex_params->num_parallel = pop->simplex_params->num_parallel;
+    newpop->simplex_params->num_threads = pop->simplex_params->num_threads;
+    newpop->simplex_params->num_simplices = pop->simplex_params->num_simplices;
     }
 
   if (pop->dc_params == NULL)
@@ -572,6 +586,27 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
       die("Unable to allocate memory");
 
     newpop->dc_params->compare = pop->dc_params->compare;
+    newpop->dc_params->num_threads = pop->dc_params->num_threads;
+    }
+
+  if (pop->niche_params == NULL)
+    {
+    newpop->niche_params = NULL;
+    }
+  else
+    {
+    if ( !(newpop->niche_params = s_malloc(sizeof(ga_niche_t))) )
+      die("Unable to allocate memory");
+
+    newpop->niche_params->type = pop->niche_params->type;
+    newpop->niche_params->compare = pop->niche_params->compare;
+    newpop->niche_params->radius = pop->niche_params->radius;
+    newpop->niche_params->alpha = pop->niche_params->alpha;
+    newpop->niche_params->capacity = pop->niche_params->capacity;
+    newpop->niche_params->num_niches = -1;
+    newpop->niche_params->num_raw = 0;
+    newpop->niche_params->raw = NULL;
+    newpop->niche_params->rng = pop->niche_params->rng;
     }
 
   if (pop->gradient_params == NULL)
@@ -589,6 +624,23 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
     newpop->gradient_params->step_size = pop->gradient_params->step_size;
     newpop->gradient_params->dimensions = pop->gradient_params->dimensions;
 	newpop->gradient_params->alpha = pop->gradient_params->alpha;
+    newpop->gradient_params->beta = pop->gradient_params->beta;
+    newpop->gradient_params->memory = pop->gradient_params->memory;
+    newpop->gradient_params->wolfe_c1 = pop->gradient_params->wolfe_c1;
+    newpop->gradient_params->wolfe_c2 = pop->gradient_params->wolfe_c2;
+    newpop->gradient_params->difference_type = pop->gradient_params->difference_type;
+    newpop->gradient_params->difference_step = pop->gradient_params->difference_step;
+    newpop->gradient_params->difference_threads = pop->gradient_params->difference_threads;
+    if (pop->gradient_params->difference_scale == NULL)
+      {
+      newpop->gradient_params->difference_scale = NULL;
+      }
+    else
+      {
+      if ( !(newpop->gradient_params->difference_scale = s_malloc(sizeof(double)*pop->gradient_params->dimensions)) )
+        die("Unable to allocate memory");
+      memcpy(newpop->gradient_params->difference_scale, pop->gradient_params->difference_scale, sizeof(double)*pop->gradient_params->dimensions);
+      }
     }
 
   if (pop->search_params == NULL)
@@ -603,6 +655,10 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
     newpop->search_params->scan_chromosome = pop->search_params->scan_chromosome;
     newpop->search_params->chromosome_state = 0;
     newpop->search_params->allele_state = 0;
+    newpop->search_params->num_threads = pop->search_params->num_threads;
+    newpop->search_params->chunk_size = pop->search_params->chunk_size;
+    newpop->search_params->checkpoint_fname = pop->search_params->checkpoint_fname?s_strdup(pop->search_params->checkpoint_fname):NULL;
+    newpop->search_params->checkpoint_interval = pop->search_params->checkpoint_interval;
     }
 
   if (pop->de_params == NULL)
@@ -622,7 +678,7 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
     newpop->de_params->weighting_max = pop->de_params->weighting_max;
     }
 
-  if (newpop->sampling_params == NULL)
+  if (pop->sampling_params == NULL)
     {
     newpop->sampling_params = NULL;
     }
@@ -634,6 +690,68 @@ GAULFUNC population *ga_population_clone_empty(population *pop)
 	  newpop->sampling_params->num_states = pop->sampling_params->num_states;
     }
 
+  if (pop->multistart_params == NULL)
+    {
+    newpop->multistart_params = NULL;
+    }
+  else
+    {
+    if ( !(newpop->multistart_params = s_malloc(sizeof(ga_multistart_t))) )
+      die("Unable to allocate memory");
+
+    newpop->multistart_params->search = pop->multistart_params->search;
+    newpop->multistart_params->num_threads = pop->multistart_params->num_threads;
+    newpop->multistart_params->max_evaluations = pop->multistart_params->max_evaluations;
+    newpop->multistart_params->target_fitness = pop->multistart_params->target_fitness;
+    }
+
+  if (pop->migration_params == NULL)
+    {
+    newpop->migration_params = NULL;
+    }
+  else
+    {
+    if ( !(newpop->migration_params = s_malloc(sizeof(ga_migration_t))) )
+      die("Unable to allocate memory");
+
+    newpop->migration_params->interval = pop->migration_params->interval;
+    newpop->migration_params->emigration = pop->migration_params->emigration;
+    newpop->migration_params->num_emigrants = pop->migration_params->num_emigrants;
+    newpop->migration_params->immigration = pop->migration_params->immigration;
+    newpop->migration_params->num_destinations = pop->migration_params->num_destinations;
+    if (pop->migration_params->destinations == NULL)
+      {
+      newpop->migration_params->destinations = NULL;
+      }
+    else
+      {
+      if ( !(newpop->migration_params->destinations = s_malloc(sizeof(int)*pop->migration_params->num_destinations)) )
+        die("Unable to allocate memory");
+      memcpy(newpop->migration_params->destinations, pop->migration_params->destinations, sizeof(int)*pop->migration_params->num_destinations);
+      }
+    }
+
+/*
+ * Checkpointing is not inherited, since two populations must never
+ * share a checkpoint file.
+ */
+  newpop->checkpoint_params = NULL;
+
+/*
+ * Nor is profiling, telemetry or diversity tracking.
+ */
+  newpop->profile = NULL;
+  newpop->telemetry = NULL;
+  newpop->epoch = 0;
+  newpop->diversity = NULL;
+
+/*
+ * The empty population has no fitness statistics.
+ */
+  newpop->stats.num = 0;
+  newpop->stats.fitness = NULL;
+  newpop->stats.max_fitness = 0;
+
 /*
  * Allocate arrays etc.
  */
@@ -1038,7 +1156,7 @@ GAULFUNC double ga_entity_evaluate(population *pop, entity *this_entity)
   if ( !this_entity ) die("Null pointer to entity structure passed.");
   if ( !pop->evaluate ) die("Evaluation callback not defined.");
 
-  if (pop->evaluate(pop, this_entity) == FALSE)
+  if (gaul_evaluate(pop, this_entity) == FALSE)
     this_entity->fitness = GA_MIN_FITNESS;
 
   return this_entity->fitness;
@@ -1082,7 +1200,7 @@ GAULFUNC boolean ga_population_score_and_sort(population *pop)
 #if GA_DEBUG>2
     origfitness = pop->entity_iarray[i]->fitness;
 #endif
-    pop->evaluate(pop, pop->entity_iarray[i]);
+    gaul_evaluate(pop, pop->entity_iarray[i]);
 
 #if GA_DEBUG>2
     if (origfitness != pop->entity_iarray[i]->fitness)
@@ -1389,6 +1507,7 @@ static boolean ga_entity_setup(population *pop, entity *joe)
 
 /* No fitness evaluated yet. */
   joe->fitness = GA_MIN_FITNESS;
+  joe->epoch = pop->epoch;
 
   if ( pop->fitness_dimensions > 0 )
     { /* This population is being used for multiobjective optimisation. */
@@ -1444,6 +1563,7 @@ GAULFUNC boolean ga_entity_dereference_by_rank(population *pop, int rank)
 
 /* Population size is one less now! */
   pop->size--;
+  gaul_stats_invalidate(pop);
 
 /* Deallocate chromosomes. */
   if (dying->chromosome) pop->chromosome_destructor(pop, dying);
@@ -1510,6 +1630,7 @@ GAULFUNC boolean ga_entity_dereference_by_id(population *pop, int id)
 
 /* Population size is one less now! */
   pop->size--;
+  gaul_stats_invalidate(pop);
 
   pop->entity_iarray[pop->size] = NULL;
 
@@ -1604,6 +1725,7 @@ GAULFUNC void ga_entity_blank(population *p, entity *this_entity)
     }
 
   this_entity->fitness=GA_MIN_FITNESS;
+  gaul_stats_invalidate(p);
 
 /* Clear multiobjective fitness vector. */
   for (i=0; i<p->fitness_dimensions; i++)
@@ -1825,6 +1947,8 @@ GAULFUNC boolean ga_entity_copy(population *pop, entity *dest, entity *src)
 
   ga_entity_copy_all_chromosomes(pop, dest, src);
   dest->fitness = src->fitness;
+  dest->epoch = src->epoch;
+  gaul_stats_invalidate(pop);
 
   return TRUE;
   }
@@ -1849,11 +1973,196 @@ GAULFUNC entity *ga_entity_clone(population *pop, entity *parent)
 
   ga_entity_copy_all_chromosomes(pop, dolly, parent);
   dolly->fitness = parent->fitness;
+  dolly->epoch = parent->epoch;
 
   return dolly;
   }
 
 
+/**********************************************************************
+  Packed entity batches.
+ **********************************************************************/
+
+/*
+ * Header of a batch of entities packed by ga_entities_pack().  Each
+ * entity follows as a record holding its fitness, fitness vector and
+ * serialised chromosomes, padded to a multiple of sizeof(double).
+ */
+typedef struct
+  {
+  int		num_entities;		/* Number of records. */
+  int		fitness_dimensions;	/* Length of fitness vectors. */
+  unsigned int	chromo_len;		/* Bytes of serialised chromosomes. */
+  unsigned int	record_len;		/* Bytes per record. */
+  } packed_header_t;
+
+#define PACKED_ALIGN(len)	((((len)+sizeof(double)-1)/sizeof(double))*sizeof(double))
+
+
+/**********************************************************************
+  ga_entities_packed_size()
+  synopsis:	Determine the buffer size required by
+		ga_entities_pack() for a number of this population's
+		entities.  The chromosome_to_bytes callback must
+		produce the same length for every entity.
+  parameters:	population *pop
+		const int num	Number of entities.
+  return:	Size in bytes.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC unsigned int ga_entities_packed_size( population *pop, const int num )
+  {
+  gaulbyte	*chromo=NULL;		/* Serialised chromosome. */
+  unsigned int	chromo_max=0;		/* Serialisation buffer size. */
+  unsigned int	chromo_len=0;		/* Serialised length. */
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!pop->chromosome_to_bytes) die("Population's chromosome to bytes callback is undefined.");
+  if (num < 0) die("Negative number of entities requested.");
+
+  if (num > 0)
+    {
+    if (pop->size < 1) die("No entities from which to determine serialised length.");
+    chromo_len = pop->chromosome_to_bytes(pop, pop->entity_iarray[0], &chromo, &chromo_max);
+    if (chromo_max > 0) s_free(chromo);
+    }
+
+  return PACKED_ALIGN(sizeof(packed_header_t))
+         + num*PACKED_ALIGN(sizeof(double)*(1+pop->fitness_dimensions)+chromo_len);
+  }
+
+
+/**********************************************************************
+  ga_entities_pack()
+  synopsis:	Pack the fitness, fitness vector and chromosomes of a
+		number of entities into one contiguous, caller
+		provided, buffer, so that they may be transferred as
+		a single message.  The built-in contiguous chromosome
+		types expose their storage through chromosome_to_bytes,
+		so each chromosome is copied only once, directly into
+		the buffer.
+  parameters:	population *pop
+		const int num		Number of entities.
+		const int *ranks	Ranks of entities to pack, or NULL
+					for the num fittest.
+		gaulbyte *buffer	Destination.
+		const unsigned int max_bytes	Size of buffer.
+  return:	Number of bytes used.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC unsigned int ga_entities_pack( population *pop, const int num, const int *ranks,
+                                        gaulbyte *buffer, const unsigned int max_bytes )
+  {
+  packed_header_t	header;		/* Batch header. */
+  entity	*this_entity;		/* Entity being packed. */
+  gaulbyte	*record;		/* Entity's record. */
+  gaulbyte	*chromo=NULL;		/* Serialised chromosome. */
+  unsigned int	chromo_max=0;		/* Serialisation buffer size. */
+  unsigned int	len;			/* Serialised length. */
+  unsigned int	size;			/* Bytes used. */
+  int		i;			/* Loop over entities. */
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!buffer) die("Null pointer to buffer passed.");
+  if (!pop->chromosome_to_bytes) die("Population's chromosome to bytes callback is undefined.");
+  if (num < 0 || num > pop->size) die("Invalid number of entities requested.");
+
+  header.num_entities = num;
+  header.fitness_dimensions = pop->fitness_dimensions;
+  header.chromo_len = 0;
+  header.record_len = 0;
+
+  size = PACKED_ALIGN(sizeof(packed_header_t));
+  if (size > max_bytes) die("Buffer too small for packed entities.");
+
+  for (i=0; i<num; i++)
+    {
+    this_entity = pop->entity_iarray[ranks?ranks[i]:i];
+
+    len = pop->chromosome_to_bytes(pop, this_entity, &chromo, &chromo_max);
+
+    if (i == 0)
+      {
+      header.chromo_len = len;
+      header.record_len = PACKED_ALIGN(sizeof(double)*(1+pop->fitness_dimensions)+len);
+      size += num*header.record_len;
+      if (size > max_bytes) die("Buffer too small for packed entities.");
+      }
+    else if (len != header.chromo_len)
+      {
+      die("Internal length mismatch");
+      }
+
+    record = &(buffer[PACKED_ALIGN(sizeof(packed_header_t))+i*header.record_len]);
+    memcpy(record, &(this_entity->fitness), sizeof(double));
+    if (pop->fitness_dimensions > 0)
+      memcpy(&(record[sizeof(double)]), this_entity->fitvector,
+             sizeof(double)*pop->fitness_dimensions);
+    memcpy(&(record[sizeof(double)*(1+pop->fitness_dimensions)]), chromo, len);
+    }
+
+  memcpy(buffer, &header, sizeof(packed_header_t));
+
+/*
+ * We only need to deallocate the buffer if it was allocated (i.e. if
+ * the "chromosome_to_bytes" callback set max_len).
+ */
+  if (chromo_max > 0) s_free(chromo);
+
+  return size;
+  }
+
+
+/**********************************************************************
+  ga_entities_unpack()
+  synopsis:	Append the entities from a buffer filled by
+		ga_entities_pack() to a compatible population.  The
+		population is not re-sorted.
+  parameters:	population *pop
+		gaulbyte *buffer	Packed entities.
+		const unsigned int len	Size of buffer.
+  return:	Number of entities appended.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_entities_unpack( population *pop, gaulbyte *buffer, const unsigned int len )
+  {
+  packed_header_t	header;		/* Batch header. */
+  entity	*this_entity;		/* New entity. */
+  gaulbyte	*record;		/* Entity's record. */
+  int		i;			/* Loop over entities. */
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!buffer) die("Null pointer to buffer passed.");
+  if (!pop->chromosome_from_bytes) die("Population's chromosome from bytes callback is undefined.");
+  if (len < sizeof(packed_header_t)) die("Truncated packed entities.");
+
+  memcpy(&header, buffer, sizeof(packed_header_t));
+
+  if (header.fitness_dimensions != pop->fitness_dimensions)
+    die("Packed entities have incompatible fitness dimensions.");
+  if (PACKED_ALIGN(sizeof(packed_header_t))+header.num_entities*header.record_len > len)
+    die("Truncated packed entities.");
+
+  for (i=0; i<header.num_entities; i++)
+    {
+    record = &(buffer[PACKED_ALIGN(sizeof(packed_header_t))+i*header.record_len]);
+
+    this_entity = ga_get_free_entity(pop);
+    memcpy(&(this_entity->fitness), record, sizeof(double));
+    if (pop->fitness_dimensions > 0)
+      memcpy(this_entity->fitvector, &(record[sizeof(double)]),
+             sizeof(double)*pop->fitness_dimensions);
+    pop->chromosome_from_bytes(pop, this_entity,
+                               &(record[sizeof(double)*(1+pop->fitness_dimensions)]));
+    }
+
+  return header.num_entities;
+  }
+
+
 /**********************************************************************
   Network communication (population/entity migration) functions.
  **********************************************************************/
@@ -1898,64 +2207,45 @@ static boolean mpi_receive(void *buf, const int count,
   ga_population_send_by_mask()
   synopsis:	Send selected entities from a population to another
 		processor.  Only fitness and chromosomes sent.
+		The entities are packed into a single message.
   parameters:
   return:
-  last updated: 31 Jan 2002
+  last updated: 16 Oct 2026
  **********************************************************************/
 
 GAULFUNC void ga_population_send_by_mask( population *pop, int dest_node, int num_to_send, boolean *send_mask )
   {
   int		i;
   int		count=0;
-  int		len=0;		/* Length of buffer to send. */
-  unsigned int	max_len=0;
-  gaulbyte		*buffer=NULL;
-
-/*
- * Send number of entities.
- */
-  MPI_Send(&num_to_send, 1, MPI_INT, dest_node, GA_TAG_NUMENTITIES, MPI_COMM_WORLD);
+  int		*ranks=NULL;		/* Ranks of entities to send. */
+  unsigned int	len;			/* Length of buffer to send. */
+  gaulbyte	*buffer=NULL;
 
-/* 
- * Slight knudge to determine length of buffer.  Should have a more
- * elegant approach for this.
- * Sending this length here should not be required at all.
- */
-  len = (int) pop->chromosome_to_bytes(pop, pop->entity_iarray[0], &buffer, &max_len);
-  MPI_Send(&len, 1, MPI_INT, dest_node, GA_TAG_ENTITYLEN, MPI_COMM_WORLD);
-
-/*
-  printf("DEBUG: Node %d sending %d entities of length %d to %d\n",
-           mpi_get_rank(), num_to_send, len, dest_node);
-*/
+  if ( !pop ) die("Null pointer to population structure passed.");
 
-/*
- * Send required entities individually.
- */
-  for (i=0; i<pop->size && count<num_to_send; i++)
+  if (num_to_send>0)
     {
-    if (send_mask[i])
+    if ( !(ranks = s_malloc(num_to_send*sizeof(int))) )
+      die("Unable to allocate memory");
+
+    for (i=0; i<pop->size && count<num_to_send; i++)
       {
-/* printf("DEBUG: Node %d sending entity %d/%d (%d/%d) with fitness %f\n",
-             mpi_get_rank(), count, num_to_send, i, pop->size, pop->entity_iarray[i]->fitness); */
-      MPI_Send(&(pop->entity_iarray[i]->fitness), 1, MPI_DOUBLE, dest_node, GA_TAG_ENTITYFITNESS, MPI_COMM_WORLD);
-      if (len != (int) pop->chromosome_to_bytes(pop, pop->entity_iarray[i], &buffer, &max_len))
-	die("Internal length mismatch");
-      MPI_Send(buffer, len, MPI_BYTE, dest_node, GA_TAG_ENTITYCHROMOSOME, MPI_COMM_WORLD);
-      count++;
+      if (send_mask[i]) ranks[count++] = i;
       }
     }
 
   if (count != num_to_send)
     die("Incorrect value for num_to_send");
 
-/*
- * We only need to deallocate the buffer if it was allocated (i.e. if
- * the "chromosome_to_bytes" callback set max_len).
- */
-  if (max_len!=0) s_free(buffer);
+  len = ga_entities_packed_size(pop, num_to_send);
+  if ( !(buffer = s_malloc(len*sizeof(gaulbyte))) )
+    die("Unable to allocate memory");
+
+  ga_entities_pack(pop, num_to_send, ranks, buffer, len);
+  MPI_Send(buffer, (int) len, MPI_BYTE, dest_node, GA_TAG_ENTITYBATCH, MPI_COMM_WORLD);
 
-/*  printf("DEBUG: Node %d finished sending\n", mpi_get_rank());*/
+  s_free(buffer);
+  if (ranks) s_free(ranks);
 
   return;
   }
@@ -1965,49 +2255,27 @@ GAULFUNC void ga_population_send_by_mask( population *pop, int dest_node, int nu
   ga_population_send_every()
   synopsis:	Send all entities from a population to another
 		processor.  Only fitness and chromosomes sent.
+		The entities are packed into a single message.
   parameters:
   return:
-  last updated: 31 Jan 2002
+  last updated: 16 Oct 2026
  **********************************************************************/
 
 GAULFUNC void ga_population_send_every( population *pop, int dest_node )
   {
-  int		i;
-  int		len;			/* Length of buffer to send. */
-  unsigned int	max_len=0;		/* Maximum length of buffer. */
-  gaulbyte		*buffer=NULL;
+  unsigned int	len;			/* Length of buffer to send. */
+  gaulbyte	*buffer=NULL;
 
   if ( !pop ) die("Null pointer to population structure passed.");
 
-/*
- * Send number of entities.
- */
-  MPI_Send(&(pop->size), 1, MPI_INT, dest_node, GA_TAG_NUMENTITIES, MPI_COMM_WORLD);
+  len = ga_entities_packed_size(pop, pop->size);
+  if ( !(buffer = s_malloc(len*sizeof(gaulbyte))) )
+    die("Unable to allocate memory");
 
-/* 
- * Slight kludge to determine length of buffer.  Should have a more
- * elegant approach for this.
- * Sending this length here should not be required at all.
- */
-  len = (int) pop->chromosome_to_bytes(pop, pop->entity_iarray[0], &buffer, &max_len);
-  MPI_Send(&len, 1, MPI_INT, dest_node, GA_TAG_ENTITYLEN, MPI_COMM_WORLD);
+  ga_entities_pack(pop, pop->size, NULL, buffer, len);
+  MPI_Send(buffer, (int) len, MPI_BYTE, dest_node, GA_TAG_ENTITYBATCH, MPI_COMM_WORLD);
 
-/*
- * Send all entities individually.
- */
-  for (i=0; i<pop->size; i++)
-    {
-    MPI_Send(&(pop->entity_iarray[i]->fitness), 1, MPI_DOUBLE, dest_node, GA_TAG_ENTITYFITNESS, MPI_COMM_WORLD);
-    if (len != (int) pop->chromosome_to_bytes(pop, pop->entity_iarray[i], &buffer, &max_len))
-      die("Internal length mismatch");
-    MPI_Send(buffer, len, MPI_BYTE, dest_node, GA_TAG_ENTITYCHROMOSOME, MPI_COMM_WORLD);
-    }
-
-/*
- * We only need to deallocate the buffer if it was allocated (i.e. if
- * the "chromosome_to_bytes" callback set max_len).
- */
-  if (max_len!=0) s_free(buffer);
+  s_free(buffer);
 
   return;
   }
@@ -2020,54 +2288,30 @@ GAULFUNC void ga_population_send_every( population *pop, int dest_node )
 		Only fitness and chromosomes received.
   parameters:
   return:
-  last updated: 31 Jan 2002
+  last updated: 16 Oct 2026
  **********************************************************************/
 
 GAULFUNC void ga_population_append_receive( population *pop, int src_node )
   {
-  int		i;
   int		len=0;			/* Length of buffer to receive. */
-  gaulbyte		*buffer;		/* Receive buffer. */
-  int		num_to_recv;		/* Number of entities to receive. */
-  entity	*this_entity;		/* New entity. */
+  gaulbyte	*buffer;		/* Receive buffer. */
+  MPI_Status	status;			/* MPI status struct. */
 
   if ( !pop ) die("Null pointer to population structure passed.");
 
 /*
- * Get number of entities to receive and the length of each.
- * FIXME: This length data shouldn't be needed!
+ * The batch size isn't known in advance, so probe for it.
  */
-  mpi_receive(&num_to_recv, 1, MPI_INT, src_node, GA_TAG_NUMENTITIES);
-  mpi_receive(&len, 1, MPI_INT, src_node, GA_TAG_ENTITYLEN);
-
-/*
-  printf("DEBUG: Node %d anticipating %d entities of length %d from %d\n",
-           mpi_get_rank(), num_to_recv, len, src_node);
-*/
-
-  if (num_to_recv>0)
-    {
-    if ( !(buffer = s_malloc(len*sizeof(gaulbyte))) )
-      die("Unable to allocate memory");
+  MPI_Probe(src_node, GA_TAG_ENTITYBATCH, MPI_COMM_WORLD, &status);
+  MPI_Get_count(&status, MPI_BYTE, &len);
 
-/*
- * Receive all entities individually.
- */
-    for (i=0; i<num_to_recv; i++)
-      {
-      entity = ga_get_free_entity(pop);
-      mpi_receive(&(entity->fitness), 1, MPI_DOUBLE, src_node, GA_TAG_ENTITYFITNESS);
-      mpi_receive(buffer, len, MPI_BYTE, src_node, GA_TAG_ENTITYCHROMOSOME);
-      pop->chromosome_from_bytes(pop, entity, buffer);
-/*      printf("DEBUG: Node %d received entity %d/%d (%d) with fitness %f\n",
-             mpi_get_rank(), i, num_to_recv, pop->size, entity->fitness);
- */
-      }
+  if ( !(buffer = s_malloc(len*sizeof(gaulbyte))) )
+    die("Unable to allocate memory");
 
-    s_free(buffer);
-    }
+  mpi_receive(buffer, len, MPI_BYTE, src_node, GA_TAG_ENTITYBATCH);
+  ga_entities_unpack(pop, buffer, (unsigned int) len);
 
-/*  printf("DEBUG: Node %d finished receiving\n", mpi_get_rank());*/
+  s_free(buffer);
 
   return;
   }
@@ -2249,7 +2493,7 @@ GAULFUNC entity *ga_multiproc_compare_entities( population *pop, entity *localne
       buffer_ptr += pop->len_chromosomes;
       }
 
-    pop->evaluate(pop, local);
+    gaul_evaluate(pop, local);
     if (local->fitness != global_max)
       dief("Best scores don't match %f %f.", local->fitness, global_max);
     }
@@ -2369,7 +2613,7 @@ GAULFUNC boolean ga_sendrecv_entities( population *pop, int *send_mask, int send
                pop->len_chromosomes*sizeof(int));
         buffer_ptr += pop->len_chromosomes;
         }
-      pop->evaluate(pop, immigrant);
+      gaul_evaluate(pop, immigrant);
 
 /*
       plog(LOG_VERBOSE, "Immigrant has fitness %f", immigrant->fitness);
@@ -2554,6 +2798,142 @@ GAULFUNC void ga_population_set_migration(	population	*pop,
   }
 
 
+/**********************************************************************
+  gaul_population_migration_params()
+  synopsis:	Return the population's migration parameters,
+		allocating them with the legacy defaults if required.
+  parameters:	population *pop
+  return:	ga_migration_t *
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static ga_migration_t *gaul_population_migration_params(population *pop)
+  {
+
+  if (pop->migration_params == NULL)
+    {
+    if ( !(pop->migration_params = s_malloc(sizeof(ga_migration_t))) )
+      die("Unable to allocate memory");
+
+    pop->migration_params->interval = 1;
+    pop->migration_params->emigration = GA_EMIGRATION_PROBABILISTIC;
+    pop->migration_params->num_emigrants = 0;
+    pop->migration_params->immigration = GA_IMMIGRATION_ADD;
+    pop->migration_params->num_destinations = 0;
+    pop->migration_params->destinations = NULL;
+    }
+
+  return pop->migration_params;
+  }
+
+
+/**********************************************************************
+  ga_population_set_migration_parameters()
+  synopsis:	Sets the island model migration policy for a
+		population.  Every interval generations, emigrants
+		are chosen either independently with probability
+		migration_ratio (GA_EMIGRATION_PROBABILISTIC, the
+		default), as the num_emigrants best entities
+		(GA_EMIGRATION_BEST) or as num_emigrants distinct
+		random entities (GA_EMIGRATION_RANDOM).  Arriving
+		immigrants are either added to the population
+		(GA_IMMIGRATION_ADD, the default) or replace the
+		same number of the worst (GA_IMMIGRATION_REPLACE_WORST)
+		or random (GA_IMMIGRATION_REPLACE_RANDOM) residents.
+  parameters:	population *pop
+		const int interval	Generations between emigrations.
+		const ga_emigration_type emigration
+		const int num_emigrants	Ignored for probabilistic emigration.
+		const ga_immigration_type immigration
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_migration_parameters( population	*pop,
+                                      const int			interval,
+                                      const ga_emigration_type	emigration,
+                                      const int			num_emigrants,
+                                      const ga_immigration_type	immigration )
+  {
+  ga_migration_t	*params;	/* Migration parameters. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( interval < 1 ) die("Migration interval must be at least one generation.");
+  if ( emigration != GA_EMIGRATION_PROBABILISTIC &&
+       emigration != GA_EMIGRATION_BEST &&
+       emigration != GA_EMIGRATION_RANDOM )
+    die("Unknown emigration policy.");
+  if ( emigration != GA_EMIGRATION_PROBABILISTIC && num_emigrants < 1 )
+    die("At least one emigrant is required.");
+  if ( immigration != GA_IMMIGRATION_ADD &&
+       immigration != GA_IMMIGRATION_REPLACE_WORST &&
+       immigration != GA_IMMIGRATION_REPLACE_RANDOM )
+    die("Unknown immigration policy.");
+
+  plog( LOG_VERBOSE,
+        "Population's migration parameters: interval = %d emigration = %d num_emigrants = %d immigration = %d",
+        interval, emigration, num_emigrants, immigration );
+
+  params = gaul_population_migration_params(pop);
+
+  params->interval = interval;
+  params->emigration = emigration;
+  params->num_emigrants = num_emigrants;
+  params->immigration = immigration;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_set_migration_destinations()
+  synopsis:	Sets the islands to which this population's
+		emigrants are sent, as indices into the array of
+		populations passed to the archipelago routines.
+		This allows an arbitrary, directed, migration graph.
+		Passing num_destinations=0 restores the default
+		cyclic topology, in which island i sends to island
+		i-1.  For ga_evolution_archipelago_mp(), the islands
+		on every processor are numbered together, in order of
+		processor rank.  See also ga_archipelago_set_topology().
+  parameters:	population *pop
+		const int num_destinations
+		const int *destinations
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_migration_destinations( population	*pop,
+                                      const int		num_destinations,
+                                      const int		*destinations )
+  {
+  ga_migration_t	*params;	/* Migration parameters. */
+  int			i;		/* Loop over destinations. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( num_destinations < 0 ) die("Negative number of destinations.");
+  if ( num_destinations > 0 && !destinations ) die("Null pointer to destinations array passed.");
+
+  for (i=0; i<num_destinations; i++)
+    if (destinations[i] < 0) die("Invalid destination island.");
+
+  params = gaul_population_migration_params(pop);
+
+  if (params->destinations) s_free(params->destinations);
+  params->destinations = NULL;
+  params->num_destinations = num_destinations;
+
+  if (num_destinations > 0)
+    {
+    if ( !(params->destinations = s_malloc(sizeof(int)*num_destinations)) )
+      die("Unable to allocate memory");
+    memcpy(params->destinations, destinations, sizeof(int)*num_destinations);
+    }
+
+  return;
+  }
+
+
 /**********************************************************************
   ga_population_set_crossover()
   synopsis:	Sets the crossover rate for a population.
@@ -2874,12 +3254,32 @@ GAULFUNC boolean ga_extinction(population *extinct)
     if (extinct->tabu_params) s_free(extinct->tabu_params);
     if (extinct->sa_params) s_free(extinct->sa_params);
     if (extinct->dc_params) s_free(extinct->dc_params);
+    if (extinct->niche_params) gaul_niche_free(extinct);
     if (extinct->climbing_params) s_free(extinct->climbing_params);
     if (extinct->simplex_params) s_free(extinct->simplex_params);
-    if (extinct->gradient_params) s_free(extinct->gradient_params);
-    if (extinct->search_params) s_free(extinct->search_params);
+    if (extinct->gradient_params)
+      {
+      if (extinct->gradient_params->difference_scale) s_free(extinct->gradient_params->difference_scale);
+      s_free(extinct->gradient_params);
+      }
+    if (extinct->search_params)
+      {
+      if (extinct->search_params->checkpoint_fname) s_free(extinct->search_params->checkpoint_fname);
+      s_free(extinct->search_params);
+      }
     if (extinct->de_params) s_free(extinct->de_params);
     if (extinct->sampling_params) s_free(extinct->sampling_params);
+    if (extinct->multistart_params) s_free(extinct->multistart_params);
+    if (extinct->checkpoint_params) gaul_checkpoint_free(extinct);
+    if (extinct->telemetry) gaul_telemetry_free(extinct);
+    if (extinct->diversity) gaul_diversity_free(extinct);
+    gaul_stats_free(extinct);
+    if (extinct->profile) s_free(extinct->profile);
+    if (extinct->migration_params)
+      {
+      if (extinct->migration_params->destinations) s_free(extinct->migration_params->destinations);
+      s_free(extinct->migration_params);
+      }
 
     if (extinct->data)
       {
@@ -2922,10 +3322,12 @@ GAULFUNC double ga_entity_get_fitness(entity *e)
 
 /**********************************************************************
   ga_entity_set_fitness()
-  synopsis:	Gets an entity's fitness.
+  synopsis:	Sets an entity's fitness.  The entity's population is
+		unknown, so the cached statistics of every population
+		are discarded.
   parameters:
   return:
-  last updated: 23 May 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 GAULFUNC boolean ga_entity_set_fitness(entity *e, double fitness)
@@ -2933,6 +3335,7 @@ GAULFUNC boolean ga_entity_set_fitness(entity *e, double fitness)
   if ( !e ) return FALSE;
 
   e->fitness=fitness;
+  gaul_stats_invalidate_all();
 
   return TRUE;
   }
@@ -111,9 +111,16 @@ static void _gaul_pick_random_entities(int *permutation, int num, int size, int
 /**********************************************************************
   ga_differentialevolution()
   synopsis:	Performs differential evolution.
+		If the population has been restored by
+		ga_population_checkpoint_restore(), the evolution
+		continues from the restored generation.  The
+		population is checkpointed as set by
+		ga_population_set_checkpoint_parameters(), along with
+		the permutation used for random selections.
   parameters:
-  return:
-  last updated:	12 Apr 2005
+  return:	Number of generations performed, including any
+		before a restored checkpoint.
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 GAULFUNC int ga_differentialevolution(	population		*pop,
@@ -142,24 +149,27 @@ GAULFUNC int ga_differentialevolution(	population		*pop,
 
   plog(LOG_VERBOSE, "The differential evolution has begun!");
 
-  pop->generation = 0;
+  if ( !pop->checkpoint_params || !pop->checkpoint_params->resume )
+    {
+    pop->generation = 0;
 
 /*
  * Score the initial population members.
  */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
+    if (pop->size < pop->stable_size)
+      gaul_population_fill(pop, pop->stable_size - pop->size);
 
-  if (pop->entity_iarray[0]->fitness == GA_MIN_FITNESS)
-    pop->evaluate(pop, pop->entity_iarray[0]);
+    if (pop->entity_iarray[0]->fitness == GA_MIN_FITNESS)
+      gaul_evaluate(pop, pop->entity_iarray[0]);
 
 #pragma omp parallel for \
    shared(pop) private(i) \
    schedule(static)
-  for (i=0; i<pop->size; i++)
-    {
-    if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
-      pop->evaluate(pop, pop->entity_iarray[i]);
+    for (i=0; i<pop->size; i++)
+      {
+      if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
+        gaul_evaluate(pop, pop->entity_iarray[i]);
+      }
     }
 
 /*
@@ -171,13 +181,19 @@ GAULFUNC int ga_differentialevolution(	population		*pop,
   for (i=0; i<pop->size; i++)
     permutation[i]=i;
 
+/*
+ * A population restored from a checkpoint continues where it stopped.
+ */
+  if (gaul_checkpoint_resume(pop, pop->size, permutation))
+    generation = pop->generation;
+
 /*
  * Do all the generations:
  *
  * Stop when (a) max_generations reached, or
  *           (b) "pop->generation_hook" returns FALSE.
  */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
+  while ( gaul_generation_hook(pop, generation) &&
            generation<max_generations )
     {
     generation++;
@@ -227,6 +243,12 @@ GAULFUNC int ga_differentialevolution(	population		*pop,
               "Best fitness is %f at start of generation %d",
               pop->entity_iarray[best]->fitness, generation );
 
+/*
+ * Trial solutions are constructed and evaluated within a single
+ * parallel loop, so they are profiled together as crossover.
+ */
+    gaul_profile_start(pop, GA_PHASE_CROSSOVER);
+
 #pragma omp parallel for \
    if (GAUL_DETERMINISTIC_OPENMP==0) \
    shared(pop) private(i) \
@@ -672,7 +694,7 @@ GAULFUNC int ga_differentialevolution(	population		*pop,
  * Evaluate new solution and restore the former chromosome values
  * if this new solution is not an improvement.
  */
-      if ( !pop->evaluate(pop, tmpentity) ||
+      if ( !gaul_evaluate(pop, tmpentity) ||
          ( pop->rank == ga_rank_fitness && pop->entity_iarray[i]->fitness > tmpentity->fitness ) ||
          ( pop->rank != ga_rank_fitness && pop->rank(pop, tmpentity, pop, pop->entity_iarray[i]) < 0 ) )
         {
@@ -683,15 +705,21 @@ GAULFUNC int ga_differentialevolution(	population		*pop,
 
       }
 
+    gaul_profile_stop(pop);
+
 /*
  * Eliminate the original population members.
  */
+    gaul_profile_start(pop, GA_PHASE_SURVIVAL);
+
     while (pop->orig_size > 0)
       {
       pop->orig_size--;
       ga_entity_dereference_by_rank(pop, pop->orig_size);
       }
 
+    gaul_profile_stop(pop);
+
 /*
  * End of generation.
  */
@@ -701,8 +729,12 @@ GAULFUNC int ga_differentialevolution(	population		*pop,
           pop->entity_iarray[0]->fitness,
           pop->entity_iarray[pop->size-1]->fitness );
 
+    gaul_checkpoint_generation(pop, pop->size, permutation);
+
     }	/* Generation loop. */
 
+  ga_population_checkpoint_wait(pop);
+
 /*
  * Ensure final ordering of population is correct.
  */
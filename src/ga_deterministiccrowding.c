@@ -31,6 +31,31 @@
 
 #include "gaul/ga_deterministiccrowding.h"
 
+/*
+ * Stages of offspring generation.
+ */
+#define GAUL_DC_CROSSOVER	0
+#define GAUL_DC_MUTATION	1
+
+/*
+ * State shared by the threads generating a generation's offspring.
+ * Each pair has a private PRNG stream, seeded in pair order by the
+ * calling thread, so the offspring do not depend on the number of
+ * threads or on which thread handles which pair.
+ */
+typedef struct
+  {
+  population	*pop;
+  int		stage;		/* GAUL_DC_CROSSOVER or GAUL_DC_MUTATION. */
+  int		num_pairs;
+  entity	**parent;	/* Mother and father of each pair. */
+  entity	**child;	/* Daughter and son of each pair. */
+  entity	**discard;	/* Unmutated children, or NULL. */
+  random_state	*rstate;	/* PRNG stream of each pair. */
+  int		next;		/* Next unclaimed pair. */
+  THREAD_LOCK_DECLARE(lock);	/* Guards next. */
+  } gaul_dc_batch_t;
+
 /**********************************************************************
   ga_population_set_deterministiccrowding_parameters()
   synopsis:     Sets the deterministic crowding parameters for a
@@ -38,7 +63,7 @@
   parameters:	population *pop		Population to set parameters of.
 		const GAcompare		Callback to compare two entities.
   return:	none
-  last updated: 20 May 2003
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 GAULFUNC void ga_population_set_deterministiccrowding_parameters( population		*pop,
@@ -54,6 +79,8 @@ GAULFUNC void ga_population_set_deterministiccrowding_parameters( population		*p
     {
     if ( !(pop->dc_params = s_malloc(sizeof(ga_dc_t))) )
       die("Unable to allocate memory");
+
+    pop->dc_params->num_threads = 1;
     }
 
   pop->dc_params->compare = compare;
@@ -62,6 +89,158 @@ GAULFUNC void ga_population_set_deterministiccrowding_parameters( population		*p
   }
 
 
+/**********************************************************************
+  ga_population_set_deterministiccrowding_threads()
+  synopsis:     Sets the number of threads used to generate and
+		evaluate offspring during deterministic crowding.
+		The crossover, mutation and evaluation callbacks
+		must be thread-safe if more than one thread is used.
+		The results do not depend on the number of threads.
+  parameters:	population *pop		Population to set parameters of.
+		const int num_threads	Number of threads, or 0 to use
+					the GAUL_NUM_THREADS setting.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_deterministiccrowding_threads( population	*pop,
+                                                         const int	num_threads )
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->dc_params )
+    die("ga_population_set_deterministiccrowding_parameters() must be used prior to ga_population_set_deterministiccrowding_threads().");
+  if ( num_threads < 0 ) die("Negative number of threads requested.");
+
+  plog( LOG_VERBOSE, "Population's deterministic crowding threads = %d",
+        num_threads );
+
+  pop->dc_params->num_threads = num_threads;
+
+  return;
+  }
+
+
+/**********************************************************************
+  _dc_offspring_thread()
+  synopsis:	Claim pairs in turn and perform the current stage of
+		offspring generation for each.  Crossover places the
+		daughter and son of pair i in child[2i] and
+		child[2i+1].  Mutation replaces a child by a mutant,
+		noting the original in discard[], which is only
+		dereferenced by the calling thread later.
+  parameters:	void *data	The gaul_dc_batch_t.
+  return:	NULL
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void *_dc_offspring_thread(void *data)
+  {
+  gaul_dc_batch_t	*batch = (gaul_dc_batch_t *) data;
+  population		*pop = batch->pop;
+  random_state		*old_rstate;	/* Thread's PRNG stream, if any. */
+  entity		*mutant;	/* Mutated child. */
+  int			pair;		/* Current pair. */
+  int			k;		/* Loop over children. */
+
+  old_rstate = random_get_thread_state();
+
+  while (TRUE)
+    {
+    THREAD_LOCK(batch->lock);
+    pair = batch->next++;
+    THREAD_UNLOCK(batch->lock);
+
+    if (pair >= batch->num_pairs) break;
+
+    random_set_thread_state(&(batch->rstate[pair]));
+
+    if (batch->stage == GAUL_DC_CROSSOVER)
+      {
+      batch->child[2*pair+1] = ga_get_free_entity(pop);
+      batch->child[2*pair] = ga_get_free_entity(pop);
+      pop->crossover(pop, batch->parent[2*pair], batch->parent[2*pair+1],
+                     batch->child[2*pair], batch->child[2*pair+1]);
+      }
+    else
+      {
+      for (k=2*pair; k<2*pair+2; k++)
+        {
+        batch->discard[k] = NULL;
+
+        if (random_boolean_prob(pop->mutation_ratio))
+          {
+          mutant = ga_get_free_entity(pop);
+          pop->mutate(pop, batch->child[k], mutant);
+          batch->discard[k] = batch->child[k];
+          batch->child[k] = mutant;
+          }
+        }
+      }
+    }
+
+  random_set_thread_state(old_rstate);
+
+  return NULL;
+  }
+
+
+/**********************************************************************
+  _dc_offspring()
+  synopsis:	Perform one stage of offspring generation for every
+		pair, using upto num_threads concurrent threads.  The
+		calling thread takes part.
+  parameters:	gaul_dc_batch_t *batch
+		const int stage		GAUL_DC_CROSSOVER or
+					GAUL_DC_MUTATION.
+		const int num_threads	Number of threads.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void _dc_offspring(gaul_dc_batch_t *batch, const int stage, const int num_threads)
+  {
+#ifdef HAVE_PTHREADS
+  pthread_t	*tids;			/* Thread ids. */
+  int		err;			/* Error code from pthreads. */
+  int		i;			/* Loop over threads. */
+#endif
+
+  batch->stage = stage;
+  batch->next = 0;
+
+#ifdef HAVE_PTHREADS
+  if (num_threads > 1)
+    {
+    if ( !(tids = s_malloc(sizeof(pthread_t)*(num_threads-1))) )
+      die("Unable to allocate memory");
+
+    for (i=0; i<num_threads-1; i++)
+      {
+      if ( (err = pthread_create(&(tids[i]), NULL, _dc_offspring_thread, (void *)batch)) != 0 )
+        dief("Error %d in pthread_create. (%s)", err, err==EAGAIN?"EAGAIN":err==ENOMEM?"ENOMEM":"unknown");
+      }
+
+    _dc_offspring_thread((void *)batch);
+
+    for (i=0; i<num_threads-1; i++)
+      {
+      if ( (err = pthread_join(tids[i], NULL)) != 0 )
+        dief("Error %d in pthread_join. (%s)", err, err==ESRCH?"ESRCH":err==EINVAL?"EINVAL":err==EDEADLK?"EDEADLK":"unknown");
+      }
+
+    s_free(tids);
+
+    return;
+    }
+#endif
+
+  _dc_offspring_thread((void *)batch);
+
+  return;
+  }
+
+
 /**********************************************************************
   ga_deterministiccrowding()
   synopsis:	Performs optimisation of the given population by a
@@ -73,14 +252,19 @@ GAULFUNC void ga_population_set_deterministiccrowding_parameters( population		*p
 		population.
 		This was designed as a niching algorithm rather than
 		an optimisation algorithm.
-		During a generation, children potentially replace
-		their parents as soon as they are created, rather
-		than replacing them at the end of the generation.
-		This differs slightly from the canonical
-		deterministic crowding algorithm.
+		Each entity is paired with a randomly permuted
+		partner.  During a generation, the offspring of every
+		pair are generated and evaluated, using the number
+		of threads set by
+		ga_population_set_deterministiccrowding_threads(),
+		and the four parent-child distances of every pair
+		are computed together.  The replacements are then
+		applied in pair order: each child replaces the
+		current occupant of its closest parent's slot if it
+		is fitter.
   parameters:
   return:
-  last updated:	18 Feb 2005
+  last updated:	17 Oct 2026
  **********************************************************************/
 
 GAULFUNC int ga_deterministiccrowding(	population		*pop,
@@ -88,11 +272,20 @@ GAULFUNC int ga_deterministiccrowding(	population		*pop,
   {
   int		generation=0;		/* Current generation number. */
   int		*permutation, *ordered;	/* Arrays of entities. */
-  entity	*mother, *father;	/* Current entities. */
-  entity	*son, *daughter, *this_entity;	/* Current entities. */
-  int		i;			/* Loop variable over entities. */
-  double	dist1, dist2;		/* Genetic or phenomic distances. */
-  int		rank;			/* Rank of entity in population. */
+  int		num_threads;		/* Number of threads to use. */
+  char		*num_threads_str;	/* Value of environment variable. */
+  int		num_pairs;		/* Number of pairs in this generation. */
+  int		max_pairs;		/* Size of per-pair arrays. */
+  gaul_dc_batch_t	batch;		/* Offspring generation state. */
+  entity	**occupant;		/* Current entity of each slot. */
+  entity	**loser;		/* Entities to dereference. */
+  int		num_losers;		/* Number of losers. */
+  double	*dist;			/* Parent-child distances. */
+  gaul_compare_t	packed;		/* Packed genomes. */
+  int		rows[2];		/* Ranks of parents. */
+  entity	*child;			/* Current child. */
+  int		slot;			/* Slot of closest parent. */
+  int		i, j, k;		/* Loop variables. */
 
 /* Checks. */
   if (!pop)
@@ -110,6 +303,20 @@ GAULFUNC int ga_deterministiccrowding(	population		*pop,
 
   pop->generation = 0;
 
+/*
+ * Determine number of threads.
+ */
+  num_threads = pop->dc_params->num_threads;
+  if (num_threads == 0)
+    {
+    num_threads_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
+    if (num_threads_str) num_threads = atoi(num_threads_str);
+    if (num_threads <= 0) num_threads = GA_DEFAULT_NUM_THREADS;
+    }
+#ifndef HAVE_PTHREADS
+  num_threads = 1;
+#endif
+
 /*
  * Score the initial population members.
  */
@@ -119,7 +326,7 @@ GAULFUNC int ga_deterministiccrowding(	population		*pop,
   for (i=0; i<pop->size; i++)
     {
     if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
-      pop->evaluate(pop, pop->entity_iarray[i]);
+      gaul_evaluate(pop, pop->entity_iarray[i]);
     }
 
   sort_population(pop);
@@ -137,6 +344,28 @@ GAULFUNC int ga_deterministiccrowding(	population		*pop,
   for (i=0; i<pop->size;i++)
     ordered[i]=i;
 
+/*
+ * Prepare per-pair arrays.  These grow if the population does.
+ */
+  max_pairs = pop->size;
+
+  batch.pop = pop;
+  if ( !(batch.parent = s_malloc(sizeof(entity *)*2*max_pairs)) )
+    die("Unable to allocate memory");
+  if ( !(batch.child = s_malloc(sizeof(entity *)*2*max_pairs)) )
+    die("Unable to allocate memory");
+  if ( !(batch.discard = s_malloc(sizeof(entity *)*2*max_pairs)) )
+    die("Unable to allocate memory");
+  if ( !(batch.rstate = s_malloc(sizeof(random_state)*max_pairs)) )
+    die("Unable to allocate memory");
+  if ( !(occupant = s_malloc(sizeof(entity *)*max_pairs)) )
+    die("Unable to allocate memory");
+  if ( !(loser = s_malloc(sizeof(entity *)*2*max_pairs)) )
+    die("Unable to allocate memory");
+  if ( !(dist = s_malloc(sizeof(double)*4*max_pairs)) )
+    die("Unable to allocate memory");
+  THREAD_LOCK_NEW(batch.lock);
+
   plog( LOG_VERBOSE,
         "Prior to the first generation, population has fitness scores between %f and %f",
         pop->entity_iarray[0]->fitness,
@@ -148,124 +377,156 @@ GAULFUNC int ga_deterministiccrowding(	population		*pop,
  * Stop when (a) max_generations reached, or
  *           (b) "pop->generation_hook" returns FALSE.
  */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
+  while ( gaul_generation_hook(pop, generation) &&
            generation<max_generations )
     {
     generation++;
     pop->generation = generation;
     pop->orig_size = pop->size;
+    num_pairs = pop->orig_size;
 
     plog(LOG_DEBUG,
               "Population size is %d at start of generation %d",
               pop->orig_size, generation );
 
+    if (num_pairs > max_pairs)
+      {
+      max_pairs = num_pairs;
+      permutation = s_realloc(permutation, sizeof(int)*max_pairs);
+      ordered = s_realloc(ordered, sizeof(int)*max_pairs);
+      batch.parent = s_realloc(batch.parent, sizeof(entity *)*2*max_pairs);
+      batch.child = s_realloc(batch.child, sizeof(entity *)*2*max_pairs);
+      batch.discard = s_realloc(batch.discard, sizeof(entity *)*2*max_pairs);
+      batch.rstate = s_realloc(batch.rstate, sizeof(random_state)*max_pairs);
+      occupant = s_realloc(occupant, sizeof(entity *)*max_pairs);
+      loser = s_realloc(loser, sizeof(entity *)*2*max_pairs);
+      dist = s_realloc(dist, sizeof(double)*4*max_pairs);
+
+      for (i=0; i<max_pairs; i++)
+        ordered[i]=i;
+      }
+
     sort_population(pop);
 
+    gaul_profile_start(pop, GA_PHASE_SELECTION);
     random_int_permutation(pop->orig_size, ordered, permutation);
+    gaul_profile_stop(pop);
 
-    for ( i=0; i<pop->orig_size; i++ )
+/*
+ * The parents and PRNG streams are fixed before any offspring exist.
+ */
+    for (i=0; i<num_pairs; i++)
       {
-      mother = pop->entity_iarray[i];
-      father = pop->entity_iarray[permutation[i]];
+      batch.parent[2*i] = pop->entity_iarray[i];
+      batch.parent[2*i+1] = pop->entity_iarray[permutation[i]];
+      random_seed_state(&(batch.rstate[i]), random_rand());
+      }
+    batch.num_pairs = num_pairs;
 
 /*
- * Crossover step.
+ * Crossover and mutation steps.
  */
-      plog(LOG_VERBOSE, "Crossover between %d (rank %d fitness %f) and %d (rank %d fitness %f)",
-           ga_get_entity_id(pop, mother),
-           ga_get_entity_rank(pop, mother), mother->fitness,
-           ga_get_entity_id(pop, father),
-           ga_get_entity_rank(pop, father), father->fitness);
+    gaul_profile_start(pop, GA_PHASE_CROSSOVER);
+    _dc_offspring(&batch, GAUL_DC_CROSSOVER,
+                  num_threads<num_pairs?num_threads:num_pairs);
+    gaul_profile_stop(pop);
 
-      son = ga_get_free_entity(pop);
-      daughter = ga_get_free_entity(pop);
-      pop->crossover(pop, mother, father, daughter, son);
+    gaul_profile_start(pop, GA_PHASE_MUTATION);
+    _dc_offspring(&batch, GAUL_DC_MUTATION,
+                  num_threads<num_pairs?num_threads:num_pairs);
+    gaul_profile_stop(pop);
 
 /*
- * Mutation step.
+ * Place the children, in pair order, directly after the parents and
+ * the unmutated children after those.
  */
-      if (random_boolean_prob(pop->mutation_ratio))
-        {
-        plog(LOG_VERBOSE, "Mutation of %d (rank %d)",
-             ga_get_entity_id(pop, daughter),
-             ga_get_entity_rank(pop, daughter) );
-
-        this_entity = ga_get_free_entity(pop);
-        pop->mutate(pop, daughter, this_entity);
-        ga_entity_dereference(pop, daughter);
-        daughter = this_entity;
-        }
+    j = pop->orig_size;
+    for (k=0; k<2*num_pairs; k++)
+      pop->entity_iarray[j++] = batch.child[k];
+    for (k=0; k<2*num_pairs; k++)
+      {
+      if (batch.discard[k]) pop->entity_iarray[j++] = batch.discard[k];
+      }
 
-      if (random_boolean_prob(pop->mutation_ratio))
-        {
-        plog(LOG_VERBOSE, "Mutation of %d (rank %d)",
-             ga_get_entity_id(pop, son),
-             ga_get_entity_rank(pop, son) );
-
-        this_entity = ga_get_free_entity(pop);
-        pop->mutate(pop, son, this_entity);
-        ga_entity_dereference(pop, son);
-        son = this_entity;
-        }
+    if (j != pop->size)
+      die("Internal error: unexpected number of offspring.");
 
 /*
  * Apply environmental adaptations, score entities, sort entities, etc.
  * FIXME: Currently no adaptation.
  */
-      pop->evaluate(pop, daughter);
-      pop->evaluate(pop, son);
+    gaul_profile_start(pop, GA_PHASE_EVALUATION);
+    ga_evaluate_entities(pop, batch.child, 2*num_pairs, num_threads);
+    gaul_profile_stop(pop);
 
 /*
- * Evaluate similarities.
+ * Evaluate similarities.  Each pair needs its parents compared with
+ * its two children, which are adjacent in the population.
  */
-      dist1 = pop->dc_params->compare(pop, mother, daughter) + pop->dc_params->compare(pop, father, son);
-      dist2 = pop->dc_params->compare(pop, mother, son) + pop->dc_params->compare(pop, father, daughter);
+    gaul_profile_start(pop, GA_PHASE_SURVIVAL);
+
+    gaul_compare_pack(pop, pop->dc_params->compare, &packed);
+
+#pragma omp parallel for \
+   shared(packed,permutation,dist,num_pairs,pop) private(i,rows) \
+   schedule(static)
+    for (i=0; i<num_pairs; i++)
+      {
+      rows[0] = i;
+      rows[1] = permutation[i];
+      gaul_compare_tile(&packed, rows, 2,
+                        pop->orig_size+2*i, pop->orig_size+2*i+2,
+                        &(dist[4*i]), 2);
+      }
+
+    if (packed.rows) s_free(packed.rows);
 
 /*
- * Determine which entities will survive, and kill the others.
+ * Determine which entities will survive.  Each child is matched with
+ * its closest parent, and competes with whichever entity currently
+ * holds that parent's slot.
  */
-      if (dist1 < dist2)
-        {
-        rank = ga_get_entity_rank(pop, daughter);
-        if (daughter->fitness < mother->fitness)
-          {
-          this_entity = pop->entity_iarray[i];
-          pop->entity_iarray[i] = pop->entity_iarray[rank];
-          pop->entity_iarray[rank] = this_entity;
-          }
-        ga_entity_dereference_by_rank(pop, rank);
+    for (i=0; i<num_pairs; i++)
+      occupant[i] = pop->entity_iarray[i];
 
-        rank = ga_get_entity_rank(pop, son);
-        if (son->fitness < father->fitness)
-          {
-          this_entity = pop->entity_iarray[permutation[i]];
-          pop->entity_iarray[permutation[i]] = pop->entity_iarray[rank];
-          pop->entity_iarray[rank] = this_entity;
-          }
-        ga_entity_dereference_by_rank(pop, rank);
-        }
-      else
+    num_losers = 0;
+    for (i=0; i<num_pairs; i++)
+      {
+      for (k=0; k<2; k++)
         {
-        rank = ga_get_entity_rank(pop, son);
-        if (son->fitness < mother->fitness)
+        slot = k==0?i:permutation[i];
+
+        if ( dist[4*i]+dist[4*i+3] < dist[4*i+1]+dist[4*i+2] )
+          child = batch.child[2*i+k];	/* Mother-daughter, father-son. */
+        else
+          child = batch.child[2*i+1-k];	/* Mother-son, father-daughter. */
+
+        if (child->fitness > occupant[slot]->fitness)
           {
-          this_entity = pop->entity_iarray[i];
-          pop->entity_iarray[i] = pop->entity_iarray[rank];
-          pop->entity_iarray[rank] = this_entity;
+          loser[num_losers++] = occupant[slot];
+          occupant[slot] = child;
           }
-        ga_entity_dereference_by_rank(pop, rank);
-
-        rank = ga_get_entity_rank(pop, daughter);
-        if (daughter->fitness < father->fitness)
+        else
           {
-          this_entity = pop->entity_iarray[permutation[i]];
-          pop->entity_iarray[permutation[i]] = pop->entity_iarray[rank];
-          pop->entity_iarray[rank] = this_entity;
+          loser[num_losers++] = child;
           }
-        ga_entity_dereference_by_rank(pop, rank);
         }
       }
 
+/*
+ * Kill the losers, and the unmutated children, from the end of the
+ * population.
+ */
+    for (i=0; i<num_pairs; i++)
+      pop->entity_iarray[i] = occupant[i];
+    for (k=0; k<num_losers; k++)
+      pop->entity_iarray[pop->orig_size+k] = loser[k];
+
+    while (pop->size > pop->orig_size)
+      ga_entity_dereference_by_rank(pop, pop->size-1);
+
+    gaul_profile_stop(pop);
+
 /*
  * Use callback.
  */
@@ -285,6 +546,14 @@ GAULFUNC int ga_deterministiccrowding(	population		*pop,
 /*
  * Clean-up.
  */
+  THREAD_LOCK_FREE(batch.lock);
+  s_free(batch.parent);
+  s_free(batch.child);
+  s_free(batch.discard);
+  s_free(batch.rstate);
+  s_free(occupant);
+  s_free(loser);
+  s_free(dist);
   s_free(permutation);
   s_free(ordered);
 
@@ -0,0 +1,1222 @@
+/**********************************************************************
+  ga_diversity.c
+ **********************************************************************
+
+  ga_diversity - Population diversity measures.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Population diversity measures which scale to large
+		populations, for use in generation hooks and as
+		stopping criteria.
+
+		The convergence functions in ga_core.c, and any
+		measure built from the ga_compare_*() or
+		ga_similarity_*() functions, compare every pair of
+		entities, which costs O(N^2 L) for N entities of L
+		alleles.  The measures here cost O(N L) or less.
+
+		For boolean, char, integer and bitstring genomes, a
+		tracker attached to the population keeps a snapshot of
+		each entity's genome and the number of times each
+		allele occurs at each locus.  On each call, only the
+		entities which have changed since the previous call
+		update the counts, and the per-locus entropy and
+		Gini-Simpson sums are adjusted in constant time for
+		each changed allele.  The mean pairwise Hamming
+		distance follows exactly from the same counts.
+
+		The tracker also holds a sketch of each entity, which
+		is only recomputed when the entity changes.  Bitstrings
+		have 64-bit SimHash fingerprints, from which the mean
+		angular distance over all pairs follows in O(N).
+		Integer and char genomes have one-permutation MinHash
+		sketches of their (locus, allele) pairs, which estimate
+		the Jaccard distance of a pair of entities in constant
+		time.
+
+		For double genomes, the centroid and per-locus variance
+		are found in one pass.
+
+		Finally, the mean of any GAcompare distance may be
+		estimated from randomly sampled pairs, with a 95%
+		confidence interval.
+
+		Sampling uses a private random number generator, so
+		measuring diversity never perturbs an evolution.
+
+ **********************************************************************/
+
+#include "gaul/ga_core.h"
+
+/*
+ * Symbols counted per locus.  Integer alleles with a larger range are
+ * hashed onto this many symbols.
+ */
+#define GA_DIVERSITY_MAX_ALLELES	256
+
+/*
+ * MinHash buckets per sketch; also the number of SimHash bits.
+ */
+#define GA_DIVERSITY_SKETCH		64
+
+/*
+ * Default number of pairs sampled by the MinHash measures.
+ */
+#define GA_DIVERSITY_DEFAULT_PAIRS	1000
+
+/*
+ * Two-sided 95% quantile of the normal distribution.
+ */
+#define GA_DIVERSITY_Z95		1.959963984540054
+
+/*
+ * Kinds of genome which may be tracked.
+ */
+#define GAUL_GENOME_NONE		0
+#define GAUL_GENOME_BOOLEAN		1
+#define GAUL_GENOME_CHAR		2
+#define GAUL_GENOME_INTEGER		3
+#define GAUL_GENOME_BITSTRING		4
+
+/*
+ * A population's diversity tracker.  Per-entity arrays are indexed by
+ * entity id.
+ */
+struct ga_diversity_s
+  {
+  int		kind;			/* Kind of genome tracked. */
+  int		num_loci;		/* Alleles per genome. */
+  int		alphabet;		/* Symbols per locus. */
+  int		chromosome_bytes;	/* Bytes per chromosome. */
+  int		stride;			/* Bytes per genome snapshot. */
+  int		max_ids;		/* Size of per-entity arrays. */
+  int		num;			/* Entities counted. */
+  entity	**member;		/* Entity counted under each id, or NULL. */
+  gaulbyte	*snapshot;		/* Genome of each counted entity. */
+  boolean	*sketched;		/* Whether each sketch is current. */
+  unsigned int	*sketch;		/* Sketch of each counted entity. */
+  int		*count;			/* Allele counts, by locus then symbol. */
+  double	*clogc;			/* Sum of c log(c) over symbols, per locus. */
+  double	*csq;			/* Sum of c^2 over symbols, per locus. */
+  double	*xlogx;			/* Table of c log(c). */
+  unsigned long	updates;		/* Count changes since sums were recomputed. */
+  gaulbyte	*hyperplanes;		/* SimHash hyperplanes. */
+  double	*centroid;		/* Centroid of double genomes. */
+  double	*variance;		/* Per-locus variance of double genomes. */
+  int		num_centroid;		/* Length of centroid. */
+  int		num_pairs;		/* Pairs sampled by MinHash measures. */
+  unsigned int	rng;			/* Private random number generator state. */
+  GAdiversity	stop_measure;		/* Stopping criterion, or NULL. */
+  double	stop_threshold;		/* Stop when diversity falls below this. */
+  };
+
+/*
+ * Number of bits set in each byte.
+ */
+static const unsigned char gaul_diversity_bits[256] =
+  {
+  0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4,1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,
+  1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
+  1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
+  2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
+  1,2,2,3,2,3,3,4,2,3,3,4,3,4,4,5,2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,
+  2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
+  2,3,3,4,3,4,4,5,3,4,4,5,4,5,5,6,3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,
+  3,4,4,5,4,5,5,6,4,5,5,6,5,6,6,7,4,5,5,6,5,6,6,7,5,6,6,7,6,7,7,8
+  };
+
+/**********************************************************************
+  gaul_diversity_random()
+  synopsis:	Private xorshift random number generator.
+  parameters:	ga_diversity_t *tracker
+  return:	Pseudo-random number.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static unsigned int gaul_diversity_random(ga_diversity_t *tracker)
+  {
+  unsigned int	x=tracker->rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+
+  return tracker->rng = x;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_hash()
+  synopsis:	Mix the bits of an integer.
+  parameters:	unsigned int x
+  return:	Hashed value.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static unsigned int gaul_diversity_hash(unsigned int x)
+  {
+
+  x ^= x >> 16;
+  x *= 0x7feb352dU;
+  x ^= x >> 15;
+  x *= 0x846ca68bU;
+  x ^= x >> 16;
+
+  return x;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_tracker()
+  synopsis:	Return a population's diversity tracker, creating it
+		if necessary.
+  parameters:	population *pop
+  return:	The tracker.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static ga_diversity_t *gaul_diversity_tracker(population *pop)
+  {
+  ga_diversity_t	*tracker;	/* New tracker. */
+
+  if (pop->diversity) return pop->diversity;
+
+  if ( !(tracker = s_malloc(sizeof(ga_diversity_t))) )
+    die("Unable to allocate memory");
+  memset(tracker, 0, sizeof(ga_diversity_t));
+
+  tracker->kind = GAUL_GENOME_NONE;
+  tracker->num_pairs = GA_DIVERSITY_DEFAULT_PAIRS;
+  tracker->rng = 2463534242U;
+
+  pop->diversity = tracker;
+
+  return tracker;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_reset()
+  synopsis:	Discard a tracker's counts and sketches.
+  parameters:	ga_diversity_t *tracker
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_diversity_reset(ga_diversity_t *tracker)
+  {
+
+  if (tracker->member) s_free(tracker->member);
+  if (tracker->snapshot) s_free(tracker->snapshot);
+  if (tracker->sketched) s_free(tracker->sketched);
+  if (tracker->sketch) s_free(tracker->sketch);
+  if (tracker->count) s_free(tracker->count);
+  if (tracker->clogc) s_free(tracker->clogc);
+  if (tracker->csq) s_free(tracker->csq);
+  if (tracker->xlogx) s_free(tracker->xlogx);
+  if (tracker->hyperplanes) s_free(tracker->hyperplanes);
+
+  tracker->member = NULL;
+  tracker->snapshot = NULL;
+  tracker->sketched = NULL;
+  tracker->sketch = NULL;
+  tracker->count = NULL;
+  tracker->clogc = NULL;
+  tracker->csq = NULL;
+  tracker->xlogx = NULL;
+  tracker->hyperplanes = NULL;
+  tracker->kind = GAUL_GENOME_NONE;
+  tracker->max_ids = 0;
+  tracker->num = 0;
+  tracker->updates = 0;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_configure()
+  synopsis:	Prepare a tracker for a kind of genome.
+  parameters:	population *pop
+		ga_diversity_t *tracker
+		const int kind
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_diversity_configure(population *pop, ga_diversity_t *tracker, const int kind)
+  {
+  long		range;		/* Range of integer alleles. */
+  int		i;		/* Loop over bytes. */
+
+  gaul_diversity_reset(tracker);
+
+  tracker->kind = kind;
+  tracker->num_loci = pop->num_chromosomes*pop->len_chromosomes;
+
+  switch (kind)
+    {
+    case GAUL_GENOME_BOOLEAN:
+      tracker->alphabet = 2;
+      tracker->chromosome_bytes = pop->len_chromosomes*sizeof(boolean);
+      break;
+    case GAUL_GENOME_CHAR:
+      tracker->alphabet = 256;
+      tracker->chromosome_bytes = pop->len_chromosomes*sizeof(char);
+      break;
+    case GAUL_GENOME_INTEGER:
+      range = (long) pop->allele_max_integer - pop->allele_min_integer + 1;
+      tracker->alphabet = range>0 && range<=GA_DIVERSITY_MAX_ALLELES ? (int) range : GA_DIVERSITY_MAX_ALLELES;
+      tracker->chromosome_bytes = pop->len_chromosomes*sizeof(int);
+      break;
+    case GAUL_GENOME_BITSTRING:
+      tracker->alphabet = 2;
+      tracker->chromosome_bytes = ga_bit_sizeof(pop->len_chromosomes);
+      break;
+    default:
+      die("Unknown genome kind.");
+    }
+
+  tracker->stride = pop->num_chromosomes*tracker->chromosome_bytes;
+
+  if ( !(tracker->count = s_malloc(tracker->num_loci*tracker->alphabet*sizeof(int))) ||
+       !(tracker->clogc = s_malloc(tracker->num_loci*sizeof(double))) ||
+       !(tracker->csq = s_malloc(tracker->num_loci*sizeof(double))) )
+    die("Unable to allocate memory");
+
+  memset(tracker->count, 0, tracker->num_loci*tracker->alphabet*sizeof(int));
+  for (i=0; i<tracker->num_loci; i++)
+    {
+    tracker->clogc[i] = 0.0;
+    tracker->csq[i] = 0.0;
+    }
+
+  if (kind == GAUL_GENOME_BITSTRING)
+    {
+    if ( !(tracker->hyperplanes = s_malloc(GA_DIVERSITY_SKETCH*tracker->stride)) )
+      die("Unable to allocate memory");
+    for (i=0; i<GA_DIVERSITY_SKETCH*tracker->stride; i++)
+      tracker->hyperplanes[i] = (gaulbyte) (gaul_diversity_random(tracker)>>24);
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_grow()
+  synopsis:	Enlarge a tracker's per-entity arrays to cover every
+		possible entity id in the population.
+  parameters:	population *pop
+		ga_diversity_t *tracker
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_diversity_grow(population *pop, ga_diversity_t *tracker)
+  {
+  int		i;		/* Loop over new ids. */
+
+  if (tracker->max_ids >= pop->max_size) return;
+
+  if ( !(tracker->member = s_realloc(tracker->member, pop->max_size*sizeof(entity *))) ||
+       !(tracker->snapshot = s_realloc(tracker->snapshot, (size_t) pop->max_size*tracker->stride)) ||
+       !(tracker->sketched = s_realloc(tracker->sketched, pop->max_size*sizeof(boolean))) ||
+       !(tracker->sketch = s_realloc(tracker->sketch, (size_t) pop->max_size*GA_DIVERSITY_SKETCH*sizeof(unsigned int))) ||
+       !(tracker->xlogx = s_realloc(tracker->xlogx, (pop->max_size+2)*sizeof(double))) )
+    die("Unable to allocate memory");
+
+  for (i=tracker->max_ids; i<pop->max_size; i++)
+    {
+    tracker->member[i] = NULL;
+    tracker->sketched[i] = FALSE;
+    }
+
+  for (i=0; i<pop->max_size+2; i++)
+    tracker->xlogx[i] = i>1 ? i*log((double) i) : 0.0;
+
+  tracker->max_ids = pop->max_size;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_symbol()
+  synopsis:	Symbol of an allele in a genome snapshot.
+  parameters:	population *pop
+		ga_diversity_t *tracker
+		const gaulbyte *snapshot
+		const int locus
+  return:	Symbol, from 0 to alphabet-1.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_diversity_symbol( population *pop, ga_diversity_t *tracker,
+                                  const gaulbyte *snapshot, const int locus )
+  {
+  int		allele;		/* Integer allele. */
+  int		chromosome, bit;	/* Position of bit. */
+
+  switch (tracker->kind)
+    {
+    case GAUL_GENOME_BOOLEAN:
+      return ((const boolean *) snapshot)[locus] ? 1 : 0;
+
+    case GAUL_GENOME_CHAR:
+      return snapshot[locus];
+
+    case GAUL_GENOME_INTEGER:
+      allele = ((const int *) snapshot)[locus];
+      if ((long) pop->allele_max_integer - pop->allele_min_integer + 1 == tracker->alphabet)
+        return MIN(MAX(allele-pop->allele_min_integer, 0), tracker->alphabet-1);
+      return (int) (gaul_diversity_hash((unsigned int) allele) % GA_DIVERSITY_MAX_ALLELES);
+
+    default:
+      chromosome = locus/pop->len_chromosomes;
+      bit = locus%pop->len_chromosomes;
+      return (snapshot[chromosome*tracker->chromosome_bytes + bit/BYTEBITS] >> (bit%BYTEBITS)) & 1;
+    }
+  }
+
+
+/**********************************************************************
+  gaul_diversity_count()
+  synopsis:	Add or remove the alleles of a genome snapshot from the
+		counts, adjusting the per-locus sums.
+  parameters:	population *pop
+		ga_diversity_t *tracker
+		const gaulbyte *snapshot
+		const int delta		+1 or -1.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_diversity_count( population *pop, ga_diversity_t *tracker,
+                                  const gaulbyte *snapshot, const int delta )
+  {
+  int		locus;		/* Loop over loci. */
+  int		*count;		/* Count of symbol. */
+  int		old;		/* Previous count. */
+
+  for (locus=0; locus<tracker->num_loci; locus++)
+    {
+    count = &(tracker->count[locus*tracker->alphabet
+                             + gaul_diversity_symbol(pop, tracker, snapshot, locus)]);
+    old = *count;
+    *count += delta;
+    tracker->clogc[locus] += tracker->xlogx[*count] - tracker->xlogx[old];
+    tracker->csq[locus] += (double) *count * *count - (double) old * old;
+    }
+
+  tracker->updates += tracker->num_loci;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_update()
+  synopsis:	Bring a tracker up to date with a population.  Only
+		entities which have been added, removed or changed
+		since the last update alter the counts.  The per-locus
+		sums are recomputed from the counts occasionally, so
+		that rounding errors can't accumulate.
+  parameters:	population *pop
+		const int kind		Kind of genome.
+  return:	The tracker.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static ga_diversity_t *gaul_diversity_update(population *pop, const int kind)
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  entity		*this_entity;	/* Current entity. */
+  gaulbyte		*snapshot;	/* Entity's snapshot. */
+  boolean		same;		/* Whether genome is unchanged. */
+  int			id;		/* Loop over entity ids. */
+  int			i, j;		/* Loop over chromosomes, symbols. */
+  double		c;		/* Count. */
+
+  if (pop->num_chromosomes < 1 || pop->len_chromosomes < 1)
+    die("Population has no alleles.");
+
+  tracker = gaul_diversity_tracker(pop);
+
+  if (tracker->kind != kind) gaul_diversity_configure(pop, tracker, kind);
+
+  gaul_diversity_grow(pop, tracker);
+
+  for (id=0; id<pop->max_size; id++)
+    {
+    this_entity = pop->entity_array[id];
+    snapshot = tracker->snapshot + (size_t) id*tracker->stride;
+
+    if (this_entity == NULL && tracker->member[id] == NULL) continue;
+
+    if (this_entity != NULL && tracker->member[id] != NULL)
+      {
+      same = TRUE;
+      for (i=0; i<pop->num_chromosomes && same; i++)
+        same = memcmp( this_entity->chromosome[i],
+                       snapshot + i*tracker->chromosome_bytes,
+                       tracker->chromosome_bytes ) == 0;
+      if (same)
+        {
+        tracker->member[id] = this_entity;
+        continue;
+        }
+      }
+
+    if (tracker->member[id] != NULL)
+      {
+      gaul_diversity_count(pop, tracker, snapshot, -1);
+      tracker->num--;
+      }
+
+    if (this_entity != NULL)
+      {
+      for (i=0; i<pop->num_chromosomes; i++)
+        memcpy( snapshot + i*tracker->chromosome_bytes,
+                this_entity->chromosome[i], tracker->chromosome_bytes );
+      gaul_diversity_count(pop, tracker, snapshot, 1);
+      tracker->num++;
+      }
+
+    tracker->member[id] = this_entity;
+    tracker->sketched[id] = FALSE;
+    }
+
+  if (tracker->updates > (unsigned long) tracker->num_loci*tracker->alphabet)
+    {
+    for (i=0; i<tracker->num_loci; i++)
+      {
+      tracker->clogc[i] = 0.0;
+      tracker->csq[i] = 0.0;
+      for (j=0; j<tracker->alphabet; j++)
+        {
+        c = tracker->count[i*tracker->alphabet+j];
+        tracker->clogc[i] += tracker->xlogx[(int) c];
+        tracker->csq[i] += c*c;
+        }
+      }
+    tracker->updates = 0;
+    }
+
+  return tracker;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_entropy()
+  synopsis:	Mean normalised per-locus allele entropy.  Each locus
+		is normalised by the largest entropy possible for the
+		population size and alphabet, so the result is between
+		0 (fully converged) and 1.
+  parameters:	population *pop
+		const int kind		Kind of genome.
+  return:	Mean normalised entropy.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static double gaul_diversity_entropy(population *pop, const int kind)
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  double		n;		/* Number of entities. */
+  double		norm;		/* Maximum entropy. */
+  double		sum=0.0;	/* Sum of entropies. */
+  int			locus;		/* Loop over loci. */
+
+  tracker = gaul_diversity_update(pop, kind);
+
+  if (tracker->num < 2) return 0.0;
+
+  n = tracker->num;
+  norm = log((double) MIN(tracker->alphabet, tracker->num));
+
+  for (locus=0; locus<tracker->num_loci; locus++)
+    sum += log(n) - tracker->clogc[locus]/n;
+
+  return MAX(sum/(norm*tracker->num_loci), 0.0);
+  }
+
+
+/**********************************************************************
+  ga_diversity_boolean_entropy()
+  synopsis:	Mean normalised per-locus allele entropy of a
+		population of boolean genomes, from 0 (converged) to
+		1.  Maintained incrementally between calls.
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_boolean_entropy(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return gaul_diversity_entropy(pop, GAUL_GENOME_BOOLEAN);
+  }
+
+
+/**********************************************************************
+  ga_diversity_char_entropy()
+  synopsis:	Mean normalised per-locus allele entropy of a
+		population of char genomes, from 0 (converged) to 1.
+		Maintained incrementally between calls.
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_char_entropy(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return gaul_diversity_entropy(pop, GAUL_GENOME_CHAR);
+  }
+
+
+/**********************************************************************
+  ga_diversity_integer_entropy()
+  synopsis:	Mean normalised per-locus allele entropy of a
+		population of integer genomes, from 0 (converged) to
+		1.  Maintained incrementally between calls.  If the
+		allele range is larger than 256, alleles are hashed
+		onto 256 symbols, which slightly underestimates the
+		entropy.
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_integer_entropy(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return gaul_diversity_entropy(pop, GAUL_GENOME_INTEGER);
+  }
+
+
+/**********************************************************************
+  ga_diversity_bitstring_entropy()
+  synopsis:	Mean normalised per-locus allele entropy of a
+		population of bitstring genomes, from 0 (converged) to
+		1.  Maintained incrementally between calls.
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_bitstring_entropy(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return gaul_diversity_entropy(pop, GAUL_GENOME_BITSTRING);
+  }
+
+
+/**********************************************************************
+  ga_diversity_get_entropy()
+  synopsis:	Per-locus detail of the allele counts maintained for
+		the most recently used entropy, SimHash or MinHash
+		measure.  The counts are brought up to date first.
+  parameters:	population *pop
+		double *locus_entropy	Returns the normalised entropy of
+					each locus, chromosome by
+					chromosome, or NULL.
+		double *hamming		Returns the exact mean Hamming
+					distance between pairs of entities,
+					as a fraction of the loci, or NULL.
+  return:	FALSE if no allele counts are maintained.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_diversity_get_entropy( population *pop,
+                                        double		*locus_entropy,
+                                        double		*hamming )
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  double		n;		/* Number of entities. */
+  double		norm;		/* Maximum entropy. */
+  double		sum=0.0;	/* Sum of pairwise differences. */
+  int			locus;		/* Loop over loci. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  if ( !pop->diversity || pop->diversity->kind == GAUL_GENOME_NONE ) return FALSE;
+
+  tracker = gaul_diversity_update(pop, pop->diversity->kind);
+
+  n = tracker->num;
+  norm = log((double) MIN(tracker->alphabet, MAX(tracker->num, 2)));
+
+  for (locus=0; locus<tracker->num_loci; locus++)
+    {
+    if (locus_entropy)
+      locus_entropy[locus] = tracker->num<2 ? 0.0 : MAX((log(n) - tracker->clogc[locus]/n)/norm, 0.0);
+    if (tracker->num > 1)
+      sum += (n*n - tracker->csq[locus])/(n*(n-1));
+    }
+
+  if (hamming) *hamming = sum/tracker->num_loci;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_simhash()
+  synopsis:	Compute the 64-bit SimHash fingerprint of a bitstring
+		snapshot.  Each bit is the side of a random hyperplane
+		on which the genome, as a vector of +1 and -1, lies.
+		Unused bits at the end of each chromosome are ignored.
+  parameters:	population *pop
+		ga_diversity_t *tracker
+		const gaulbyte *snapshot
+		unsigned int *fingerprint	Returns two words.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_diversity_simhash( population *pop, ga_diversity_t *tracker,
+                                    const gaulbyte *snapshot,
+                                    unsigned int *fingerprint )
+  {
+  const gaulbyte	*plane;		/* Current hyperplane. */
+  gaulbyte		mask;		/* Used bits of last byte. */
+  int			differ;		/* Bits which differ from hyperplane. */
+  int			b, c, k;	/* Loop over fingerprint bits, chromosomes, bytes. */
+
+  mask = pop->len_chromosomes%BYTEBITS ? (gaulbyte) ((1 << (pop->len_chromosomes%BYTEBITS)) - 1) : (gaulbyte) ~0;
+
+  fingerprint[0] = 0;
+  fingerprint[1] = 0;
+
+  for (b=0; b<GA_DIVERSITY_SKETCH; b++)
+    {
+    plane = tracker->hyperplanes + b*tracker->stride;
+    differ = 0;
+    for (c=0; c<pop->num_chromosomes; c++)
+      {
+      for (k=c*tracker->chromosome_bytes; k<(c+1)*tracker->chromosome_bytes-1; k++)
+        differ += gaul_diversity_bits[snapshot[k]^plane[k]];
+      differ += gaul_diversity_bits[(snapshot[k]^plane[k])&mask];
+      }
+
+    if (2*differ < tracker->num_loci || (2*differ == tracker->num_loci && b%2))
+      fingerprint[b/32] |= 1U << (b%32);
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_diversity_bitstring_simhash()
+  synopsis:	Estimate the mean angular distance between all pairs
+		of bitstring genomes, from their SimHash fingerprints,
+		as a fraction of pi.  For random genomes this is 0.5;
+		for a converged population, 0.  Fingerprints are only
+		recomputed for entities which have changed, and the
+		mean over all pairs follows from the number of
+		fingerprints with each bit set, in O(N).
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_bitstring_simhash(population *pop)
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  unsigned int		*fingerprint;	/* Entity's fingerprint. */
+  double		set[GA_DIVERSITY_SKETCH];	/* Fingerprints with each bit set. */
+  double		n, sum=0.0;	/* Number of entities, differing pairs. */
+  int			id, b;		/* Loop over entities, bits. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  tracker = gaul_diversity_update(pop, GAUL_GENOME_BITSTRING);
+
+  if (tracker->num < 2) return 0.0;
+
+  for (b=0; b<GA_DIVERSITY_SKETCH; b++)
+    set[b] = 0.0;
+
+  for (id=0; id<tracker->max_ids; id++)
+    {
+    if (!tracker->member[id]) continue;
+
+    fingerprint = tracker->sketch + (size_t) id*GA_DIVERSITY_SKETCH;
+    if (!tracker->sketched[id])
+      {
+      gaul_diversity_simhash(pop, tracker, tracker->snapshot + (size_t) id*tracker->stride, fingerprint);
+      tracker->sketched[id] = TRUE;
+      }
+
+    for (b=0; b<GA_DIVERSITY_SKETCH; b++)
+      if (fingerprint[b/32] & (1U << (b%32))) set[b]++;
+    }
+
+  n = tracker->num;
+  for (b=0; b<GA_DIVERSITY_SKETCH; b++)
+    sum += set[b]*(n-set[b]);
+
+  return sum/(n*(n-1)/2)/GA_DIVERSITY_SKETCH;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_minhash()
+  synopsis:	Compute the one-permutation MinHash sketch of the
+		(locus, allele) pairs of a genome snapshot.  Each pair
+		is hashed once; the top bits of the hash choose a
+		bucket and the remainder compete for its minimum.
+  parameters:	population *pop
+		ga_diversity_t *tracker
+		const gaulbyte *snapshot
+		unsigned int *sketch	Returns GA_DIVERSITY_SKETCH values.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_diversity_minhash( population *pop, ga_diversity_t *tracker,
+                                    const gaulbyte *snapshot,
+                                    unsigned int *sketch )
+  {
+  unsigned int	allele;		/* Allele value. */
+  unsigned int	h;		/* Hash of (locus, allele). */
+  int		locus, b;	/* Loop over loci, buckets. */
+
+  for (b=0; b<GA_DIVERSITY_SKETCH; b++)
+    sketch[b] = 0xffffffffU;
+
+  for (locus=0; locus<tracker->num_loci; locus++)
+    {
+    if (tracker->kind == GAUL_GENOME_INTEGER)
+      allele = (unsigned int) ((const int *) snapshot)[locus];
+    else
+      allele = snapshot[locus];
+
+    h = gaul_diversity_hash(gaul_diversity_hash(allele) ^ ((unsigned int) locus*0x9e3779b9U));
+    b = h >> 26;
+    h &= 0x03ffffffU;
+    if (h < sketch[b]) sketch[b] = h;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_minhash_mean()
+  synopsis:	Mean Jaccard distance between the MinHash sketches of
+		pairs of entities.  All pairs are used if there are no
+		more than the tracker's sample size, otherwise pairs
+		are sampled.
+  parameters:	population *pop
+		const int kind		Kind of genome.
+  return:	Mean distance.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static double gaul_diversity_minhash_mean(population *pop, const int kind)
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  int			*ids;		/* Ids of counted entities. */
+  unsigned int		*a, *b;		/* Sketches of pair. */
+  int			num=0;		/* Number of counted entities. */
+  int			i, j;		/* Entities of pair. */
+  int			k, m;		/* Loop over pairs, buckets. */
+  int			num_pairs;	/* Number of pairs compared. */
+  int			equal, filled;	/* Matching and non-empty buckets. */
+  double		sum=0.0;	/* Sum of distances. */
+
+  tracker = gaul_diversity_update(pop, kind);
+
+  if (tracker->num < 2) return 0.0;
+
+  if ( !(ids = s_malloc(tracker->num*sizeof(int))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<tracker->max_ids; i++)
+    {
+    if (!tracker->member[i]) continue;
+
+    if (!tracker->sketched[i])
+      {
+      gaul_diversity_minhash( pop, tracker,
+                              tracker->snapshot + (size_t) i*tracker->stride,
+                              tracker->sketch + (size_t) i*GA_DIVERSITY_SKETCH );
+      tracker->sketched[i] = TRUE;
+      }
+    ids[num++] = i;
+    }
+
+  if ((double) num*(num-1)/2 <= tracker->num_pairs)
+    num_pairs = num*(num-1)/2;
+  else
+    num_pairs = tracker->num_pairs;
+
+  for (k=0, i=0, j=1; k<num_pairs; k++)
+    {
+    if (num_pairs == num*(num-1)/2)
+      {	/* Every pair, in turn. */
+      a = tracker->sketch + (size_t) ids[i]*GA_DIVERSITY_SKETCH;
+      b = tracker->sketch + (size_t) ids[j]*GA_DIVERSITY_SKETCH;
+      if (++j == num) { i++; j = i+1; }
+      }
+    else
+      {
+      i = gaul_diversity_random(tracker)%num;
+      j = gaul_diversity_random(tracker)%(num-1);
+      if (j >= i) j++;
+      a = tracker->sketch + (size_t) ids[i]*GA_DIVERSITY_SKETCH;
+      b = tracker->sketch + (size_t) ids[j]*GA_DIVERSITY_SKETCH;
+      }
+
+    equal = 0;
+    filled = 0;
+    for (m=0; m<GA_DIVERSITY_SKETCH; m++)
+      {
+      if (a[m] == 0xffffffffU && b[m] == 0xffffffffU) continue;
+      filled++;
+      if (a[m] == b[m]) equal++;
+      }
+    sum += filled>0 ? 1.0 - (double) equal/filled : 0.0;
+    }
+
+  s_free(ids);
+
+  return sum/num_pairs;
+  }
+
+
+/**********************************************************************
+  ga_diversity_integer_minhash()
+  synopsis:	Estimate the mean Jaccard distance between integer
+		genomes, regarded as sets of (locus, allele) pairs,
+		from MinHash sketches.  If k of L loci match, the
+		distance is 1-k/(2L-k).  Sketches are only recomputed
+		for entities which have changed.  Pairs are sampled,
+		as set by ga_population_set_diversity_pairs(), unless
+		there are fewer pairs than that.
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_integer_minhash(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return gaul_diversity_minhash_mean(pop, GAUL_GENOME_INTEGER);
+  }
+
+
+/**********************************************************************
+  ga_diversity_char_minhash()
+  synopsis:	Estimate the mean Jaccard distance between char
+		genomes, as ga_diversity_integer_minhash().
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_char_minhash(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return gaul_diversity_minhash_mean(pop, GAUL_GENOME_CHAR);
+  }
+
+
+/**********************************************************************
+  ga_diversity_double_spread()
+  synopsis:	Root mean square distance of double genomes from their
+		centroid, found in one pass.
+  parameters:	population *pop
+  return:	Diversity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_double_spread(population *pop)
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  double		*allele;	/* Alleles of chromosome. */
+  double		delta;		/* Distance from running mean. */
+  double		sum=0.0;	/* Total variance. */
+  int			num_loci;	/* Alleles per genome. */
+  int			i, j, k;	/* Loop over entities, chromosomes, alleles. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  tracker = gaul_diversity_tracker(pop);
+  num_loci = pop->num_chromosomes*pop->len_chromosomes;
+
+  if (tracker->num_centroid != num_loci)
+    {
+    if ( !(tracker->centroid = s_realloc(tracker->centroid, num_loci*sizeof(double))) ||
+         !(tracker->variance = s_realloc(tracker->variance, num_loci*sizeof(double))) )
+      die("Unable to allocate memory");
+    tracker->num_centroid = num_loci;
+    }
+
+  for (k=0; k<num_loci; k++)
+    {
+    tracker->centroid[k] = 0.0;
+    tracker->variance[k] = 0.0;
+    }
+
+  for (i=0; i<pop->size; i++)
+    {
+    for (j=0; j<pop->num_chromosomes; j++)
+      {
+      allele = (double *) pop->entity_iarray[i]->chromosome[j];
+      for (k=0; k<pop->len_chromosomes; k++)
+        {
+        delta = allele[k] - tracker->centroid[j*pop->len_chromosomes+k];
+        tracker->centroid[j*pop->len_chromosomes+k] += delta/(i+1);
+        tracker->variance[j*pop->len_chromosomes+k] += delta*(allele[k] - tracker->centroid[j*pop->len_chromosomes+k]);
+        }
+      }
+    }
+
+  for (k=0; k<num_loci; k++)
+    {
+    if (pop->size > 0) tracker->variance[k] /= pop->size;
+    sum += tracker->variance[k];
+    }
+
+  return sqrt(sum);
+  }
+
+
+/**********************************************************************
+  ga_diversity_get_centroid()
+  synopsis:	Centroid and per-locus variance of double genomes, as
+		found by the most recent ga_diversity_double_spread().
+  parameters:	population *pop
+		double *centroid	Returns the centroid, or NULL.
+		double *variance	Returns the variances, or NULL.
+  return:	FALSE if ga_diversity_double_spread() hasn't been
+		called.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_diversity_get_centroid( population *pop,
+                                        double		*centroid,
+                                        double		*variance )
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  if ( !pop->diversity || !pop->diversity->centroid ) return FALSE;
+
+  if (centroid)
+    memcpy(centroid, pop->diversity->centroid, pop->diversity->num_centroid*sizeof(double));
+  if (variance)
+    memcpy(variance, pop->diversity->variance, pop->diversity->num_centroid*sizeof(double));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  ga_diversity_sampled()
+  synopsis:	Estimate the mean distance between pairs of entities,
+		using any distance function such as the ga_compare_*()
+		functions, from randomly sampled pairs.  If there are
+		no more than num_pairs pairs, all are used and the
+		result is exact.
+  parameters:	population *pop
+		GAcompare compare	Distance function.
+		const int num_pairs	Number of pairs to sample.
+		double *lower		Returns lower limit of 95%
+					confidence interval, or NULL.
+		double *upper		Returns upper limit, or NULL.
+  return:	Mean distance.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_diversity_sampled( population *pop,
+                                        GAcompare	compare,
+                                        const int	num_pairs,
+                                        double		*lower,
+                                        double		*upper )
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+  double		distance;	/* Distance between pair. */
+  double		mean=0.0, m2=0.0;	/* Running mean and sum of squares. */
+  double		half=0.0;	/* Half width of interval. */
+  boolean		all;		/* Whether every pair is used. */
+  int			n=0;		/* Pairs compared. */
+  int			i, j;		/* Entities of pair. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !compare ) die("Null pointer to distance function passed.");
+  if ( num_pairs < 1 ) die("Number of pairs must be positive.");
+
+  tracker = gaul_diversity_tracker(pop);
+
+  if (pop->size < 2)
+    {
+    if (lower) *lower = 0.0;
+    if (upper) *upper = 0.0;
+    return 0.0;
+    }
+
+  all = (double) pop->size*(pop->size-1)/2 <= num_pairs;
+
+  for (i=0, j=1; all ? i<pop->size-1 : n<num_pairs; )
+    {
+    if (!all)
+      {
+      i = gaul_diversity_random(tracker)%pop->size;
+      j = gaul_diversity_random(tracker)%(pop->size-1);
+      if (j >= i) j++;
+      }
+
+    distance = compare(pop, pop->entity_iarray[i], pop->entity_iarray[j]);
+    n++;
+    m2 += (distance-mean)*(distance-mean)*(n-1)/n;
+    mean += (distance-mean)/n;
+
+    if (all && ++j == pop->size) { i++; j = i+1; }
+    }
+
+  if (!all && n > 1) half = GA_DIVERSITY_Z95*sqrt(m2/(n-1)/n);
+
+  if (lower) *lower = mean-half;
+  if (upper) *upper = mean+half;
+
+  return mean;
+  }
+
+
+/**********************************************************************
+  ga_population_set_diversity_pairs()
+  synopsis:	Set the number of pairs sampled by the MinHash
+		diversity measures.  The default is 1000.
+  parameters:	population *pop
+		const int num_pairs
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_diversity_pairs( population *pop,
+                                        const int	num_pairs )
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( num_pairs < 1 ) die("Number of pairs must be positive.");
+
+  gaul_diversity_tracker(pop)->num_pairs = num_pairs;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_set_diversity_stop()
+  synopsis:	Stop any evolution of the population, at the start of
+		a generation, once a diversity measure falls below a
+		threshold.  The measure is taken every generation,
+		before the generation hook is called.  Passing a NULL
+		measure removes the criterion.
+  parameters:	population *pop
+		GAdiversity measure	E.g. ga_diversity_bitstring_entropy.
+		const double threshold
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_diversity_stop( population *pop,
+                                        GAdiversity	measure,
+                                        const double	threshold )
+  {
+  ga_diversity_t	*tracker;	/* The tracker. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  tracker = gaul_diversity_tracker(pop);
+  tracker->stop_measure = measure;
+  tracker->stop_threshold = threshold;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_stop()
+  synopsis:	Whether the population's diversity stopping criterion
+		has been met.
+  parameters:	population *pop
+  return:	TRUE if the evolution should stop.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+boolean gaul_diversity_stop(population *pop)
+  {
+  double	diversity;	/* Measured diversity. */
+
+  if ( !pop->diversity || !pop->diversity->stop_measure ) return FALSE;
+
+  diversity = pop->diversity->stop_measure(pop);
+
+  if (diversity >= pop->diversity->stop_threshold) return FALSE;
+
+  plog( LOG_VERBOSE, "Diversity %f is below %f; stopping.",
+        diversity, pop->diversity->stop_threshold );
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  gaul_diversity_free()
+  synopsis:	Free a population's diversity tracker.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_diversity_free(population *pop)
+  {
+
+  if (!pop->diversity) return;
+
+  gaul_diversity_reset(pop->diversity);
+  if (pop->diversity->centroid) s_free(pop->diversity->centroid);
+  if (pop->diversity->variance) s_free(pop->diversity->variance);
+  s_free(pop->diversity);
+  pop->diversity = NULL;
+
+  return;
+  }
@@ -39,7 +39,17 @@
 		You might want to think carefully about your convergence
 		criteria.
 
-  References:
+		ga_lbfgs() and ga_conjugategradient() use a line search
+		satisfying the strong Wolfe conditions, and typically
+		need far fewer evaluations than ga_steepestascent().
+
+		If no analytical gradient is available,
+		ga_gradient_finite_difference() may be passed as the
+		gradient callback.  It evaluates the finite differences
+		concurrently.
+
+  References:	Nocedal J. and Wright S.J., "Numerical Optimization",
+		2nd edition, Springer, 2006.  Chapters 3, 5 and 7.
 
  **********************************************************************/
 
@@ -76,6 +86,7 @@ GAULFUNC void ga_population_set_gradient_parameters( population		*pop,
     {
     if ( !(pop->gradient_params = s_malloc(sizeof(ga_gradient_t))) )
       die("Unable to allocate memory");
+    pop->gradient_params->difference_scale = NULL;
     }
 
   pop->gradient_params->to_double = to_double;
@@ -85,6 +96,17 @@ GAULFUNC void ga_population_set_gradient_parameters( population		*pop,
   pop->gradient_params->dimensions = dimensions;
   pop->gradient_params->alpha = 0.5;	/* Step-size scale-down factor. */
   pop->gradient_params->beta = 1.2;	/* Step-size scale-up factor. */
+  pop->gradient_params->memory = 7;	/* L-BFGS correction pairs. */
+  pop->gradient_params->wolfe_c1 = 1.0e-4;	/* Sufficient increase. */
+  pop->gradient_params->wolfe_c2 = 0.9;	/* Curvature condition. */
+  pop->gradient_params->difference_type = GA_GRADIENT_DIFFERENCE_CENTRAL;
+  pop->gradient_params->difference_step = 0.0;	/* Automatic. */
+  pop->gradient_params->difference_threads = 0;	/* Use GAUL_NUM_THREADS. */
+  if (pop->gradient_params->difference_scale)
+    {
+    s_free(pop->gradient_params->difference_scale);
+    pop->gradient_params->difference_scale = NULL;
+    }
 
   return;
   }
@@ -133,6 +155,8 @@ GAULFUNC int ga_steepestascent(	population	*pop,
   if (!pop->gradient_params->from_double) die("Population's genome from double callback is undefined.");
   if (!pop->gradient_params->gradient) die("Population's first derivatives callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_steepestascent");
+
 /* 
  * Prepare working entity and double arrays.
  */
@@ -161,7 +185,7 @@ GAULFUNC int ga_steepestascent(	population	*pop,
 /*
  * Get initial fitness and derivatives.
  */
-  pop->evaluate(pop, current);
+  gaul_evaluate(pop, current);
   pop->gradient_params->to_double(pop, current, current_d);
 
   grms = pop->gradient_params->gradient(pop, current, current_d, current_g);
@@ -196,7 +220,7 @@ GAULFUNC int ga_steepestascent(	population	*pop,
       putative_d[i]=current_d[i]+step_size*current_g[i];
 
     pop->gradient_params->from_double(pop, putative, putative_d);
-    pop->evaluate(pop, putative);
+    gaul_evaluate(pop, putative);
 
 #if GA_DEBUG>2
     printf("DEBUG: current_d = %f %f %f %f\n", current_d[0], current_d[1], current_d[2], current_d[3]);
@@ -216,7 +240,7 @@ GAULFUNC int ga_steepestascent(	population	*pop,
           putative_d[i]=current_d[i]+step_size*current_g[i];
 
         pop->gradient_params->from_double(pop, putative, putative_d);
-        pop->evaluate(pop, putative);
+        gaul_evaluate(pop, putative);
 
 #if GA_DEBUG>2
         printf("DEBUG: putative_d = %f %f %f %f fitness = %f\n", putative_d[0], putative_d[1], putative_d[2], putative_d[3], putative->fitness);
@@ -260,6 +284,8 @@ GAULFUNC int ga_steepestascent(	population	*pop,
 
   s_free(buffer);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -304,6 +330,8 @@ GAULFUNC int ga_steepestascent_double(	population	*pop,
   if (!pop->gradient_params) die("ga_population_set_gradient_params(), or similar, must be used prior to ga_gradient().");
   if (!pop->gradient_params->gradient) die("Population's first derivatives callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_steepestascent_double");
+
 /* 
  * Prepare working entity and gradient array.
  */
@@ -328,7 +356,7 @@ GAULFUNC int ga_steepestascent_double(	population	*pop,
 /*
  * Get initial fitness and derivatives.
  */
-  pop->evaluate(pop, current);
+  gaul_evaluate(pop, current);
 
   grms = pop->gradient_params->gradient(pop, current, (double *)current->chromosome[0], current_g);
 
@@ -361,7 +389,7 @@ GAULFUNC int ga_steepestascent_double(	population	*pop,
     for( i=0; i<pop->len_chromosomes; i++ )
       ((double *)putative->chromosome[0])[i]=((double *)current->chromosome[0])[i]+step_size*current_g[i];
 
-    pop->evaluate(pop, putative);
+    gaul_evaluate(pop, putative);
 
 #if GA_DEBUG>2
     printf("DEBUG: current_d = %f %f %f %f\n", current_d[0], current_d[1], current_d[2], current_d[3]);
@@ -380,7 +408,7 @@ GAULFUNC int ga_steepestascent_double(	population	*pop,
         for( i=0; i<pop->len_chromosomes; i++ )
           ((double *)putative->chromosome[0])[i]=((double *)current->chromosome[0])[i]+step_size*current_g[i];
 
-        pop->evaluate(pop, putative);
+        gaul_evaluate(pop, putative);
         } while( current->fitness > putative->fitness && step_size > ApproxZero);
 
       if (step_size <= ApproxZero && grms <= ApproxZero) force_terminate=TRUE;
@@ -414,6 +442,849 @@ GAULFUNC int ga_steepestascent_double(	population	*pop,
  */
   ga_entity_dereference(pop, putative);
 
+  gaul_trace_end();
+
+  return iteration;
+  }
+
+
+
+/**********************************************************************
+  ga_population_set_gradient_linesearch_parameters()
+  synopsis:     Sets the parameters for the line search used by
+		ga_lbfgs() and ga_conjugategradient().
+		ga_population_set_gradient_parameters() must have been
+		called first, which sets the defaults of memory=7,
+		c1=1.0e-4 and c2=0.9.
+  parameters:	population *pop		Population to set parameters of.
+		const int memory	Number of correction pairs stored
+					by ga_lbfgs().
+		const double c1		Sufficient increase constant for
+					the strong Wolfe conditions.
+		const double c2		Curvature constant for the strong
+					Wolfe conditions.  At most 0.1 is
+					used by ga_conjugategradient().
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_gradient_linesearch_parameters( population	*pop,
+					const int		memory,
+					const double		c1,
+					const double		c2)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->gradient_params ) die("ga_population_set_gradient_parameters() must be called first.");
+  if ( memory < 1 ) die("L-BFGS memory must be at least 1.");
+  if ( c1 <= 0.0 || c2 <= c1 || c2 >= 1.0 ) die("Wolfe conditions require 0 < c1 < c2 < 1.");
+
+  plog( LOG_VERBOSE,
+        "Population's gradient line search parameters set: memory = %d c1 = %f c2 = %f",
+        memory, c1, c2 );
+
+  pop->gradient_params->memory = memory;
+  pop->gradient_params->wolfe_c1 = c1;
+  pop->gradient_params->wolfe_c2 = c2;
+
+  return;
+  }
+
+
+/*
+ * Workspace for the line search.  Each point holds an entity,
+ * its double array and its gradient; they are swapped, rather
+ * than copied, as the search proceeds.
+ */
+typedef struct
+  {
+  int		dimensions;	/* Size of double arrays. */
+  entity	*cur;		/* Current point. */
+  double	*cur_d, *cur_g;
+  entity	*trial;		/* Most recently evaluated point. */
+  double	*trial_d, *trial_g;
+  entity	*prev;		/* Lower bracketing point. */
+  double	*prev_d, *prev_g;
+  boolean	prev_valid;	/* Whether prev holds an evaluated point. */
+  double	*dir;		/* Search direction. */
+  } linesearch_t;
+
+#define LINESEARCH_MAX_EVALUATIONS	20
+
+
+/**********************************************************************
+  _linesearch_swap()
+  synopsis:	Swap the trial point with the previous, or the
+		current, point.
+  parameters:	linesearch_t *ls
+		const boolean to_current
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void _linesearch_swap(linesearch_t *ls, const boolean to_current)
+  {
+  entity	*tmpentity;
+  double	*tmpdoubleptr;
+
+  if (to_current)
+    {
+    tmpentity = ls->cur; ls->cur = ls->trial; ls->trial = tmpentity;
+    tmpdoubleptr = ls->cur_d; ls->cur_d = ls->trial_d; ls->trial_d = tmpdoubleptr;
+    tmpdoubleptr = ls->cur_g; ls->cur_g = ls->trial_g; ls->trial_g = tmpdoubleptr;
+    }
+  else
+    {
+    tmpentity = ls->prev; ls->prev = ls->trial; ls->trial = tmpentity;
+    tmpdoubleptr = ls->prev_d; ls->prev_d = ls->trial_d; ls->trial_d = tmpdoubleptr;
+    tmpdoubleptr = ls->prev_g; ls->prev_g = ls->trial_g; ls->trial_g = tmpdoubleptr;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  _linesearch_evaluate()
+  synopsis:	Evaluate the trial point at the given step along the
+		search direction.  Returns the function to be
+		minimised, i.e. the negated fitness, and its
+		directional derivative.
+  parameters:	population *pop
+		linesearch_t *ls
+		const double step
+		double *phi		Returned negated fitness.
+		double *dphi		Returned directional derivative.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void _linesearch_evaluate(population *pop, linesearch_t *ls,
+                                 const double step, double *phi, double *dphi)
+  {
+  int	i;
+
+  for (i=0; i<ls->dimensions; i++)
+    ls->trial_d[i] = ls->cur_d[i] + step*ls->dir[i];
+
+  ga_entity_blank(pop, ls->trial);
+  pop->gradient_params->from_double(pop, ls->trial, ls->trial_d);
+  gaul_evaluate(pop, ls->trial);
+  pop->gradient_params->gradient(pop, ls->trial, ls->trial_d, ls->trial_g);
+
+  *phi = -ls->trial->fitness;
+  *dphi = 0.0;
+  for (i=0; i<ls->dimensions; i++)
+    *dphi -= ls->trial_g[i]*ls->dir[i];
+
+  return;
+  }
+
+
+/**********************************************************************
+  _linesearch_interpolate()
+  synopsis:	Minimiser of the cubic interpolating two points and
+		their derivatives, safeguarded to lie well inside the
+		interval, otherwise the midpoint.
+  parameters:
+  return:	Interpolated step.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static double _linesearch_interpolate( const double a_lo, const double phi_lo, const double dphi_lo,
+                                       const double a_hi, const double phi_hi, const double dphi_hi )
+  {
+  double	d1, d2;		/* Intermediate values. */
+  double	a;		/* Interpolated step. */
+  double	a_min, a_max;	/* Safeguard bounds. */
+  double	width = fabs(a_hi-a_lo);
+
+  a_min = MIN(a_lo, a_hi) + 0.1*width;
+  a_max = MAX(a_lo, a_hi) - 0.1*width;
+
+  d1 = dphi_lo + dphi_hi - 3.0*(phi_lo-phi_hi)/(a_lo-a_hi);
+  d2 = d1*d1 - dphi_lo*dphi_hi;
+
+  if (d2 < 0.0) return 0.5*(a_lo+a_hi);
+
+  d2 = sqrt(d2);
+  if (a_hi < a_lo) d2 = -d2;
+
+  a = a_hi - (a_hi-a_lo)*(dphi_hi+d2-d1)/(dphi_hi-dphi_lo+2.0*d2);
+
+  if ( !(a >= a_min && a <= a_max) ) return 0.5*(a_lo+a_hi);
+
+  return a;
+  }
+
+
+/**********************************************************************
+  _linesearch()
+  synopsis:	Line search for a step satisfying the strong Wolfe
+		conditions, following algorithms 3.5 and 3.6 of
+		Nocedal and Wright.  On success, the accepted point
+		becomes the current point.  If the evaluation limit is
+		reached, the best point which gave a sufficient
+		increase in fitness is accepted instead.
+  parameters:	population *pop
+		linesearch_t *ls
+		const double initial_step
+		const double c1, c2	Wolfe constants.
+		double *step		Returned accepted step.
+  return:	TRUE if a step was accepted.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean _linesearch( population *pop, linesearch_t *ls,
+                            const double initial_step, const double c1, const double c2,
+                            double *step )
+  {
+  int		i, evaluations=0;
+  double	phi0, dphi0;		/* Values at current point. */
+  double	a, phi, dphi;		/* Trial step and values. */
+  double	a_lo, phi_lo, dphi_lo;	/* Lower bracket. */
+  double	a_hi, phi_hi, dphi_hi;	/* Upper bracket. */
+  boolean	zoom=FALSE;		/* Whether a bracket has been found. */
+
+  phi0 = -ls->cur->fitness;
+  dphi0 = 0.0;
+  for (i=0; i<ls->dimensions; i++)
+    dphi0 -= ls->cur_g[i]*ls->dir[i];
+
+  if (dphi0 >= 0.0) return FALSE;	/* Not an ascent direction. */
+
+  ls->prev_valid = FALSE;
+  a_lo = 0.0; phi_lo = phi0; dphi_lo = dphi0;
+  a_hi = 0.0; phi_hi = phi0; dphi_hi = dphi0;
+  a = initial_step;
+
+/*
+ * Bracketing phase.
+ */
+  while (!zoom && evaluations < LINESEARCH_MAX_EVALUATIONS)
+    {
+    _linesearch_evaluate(pop, ls, a, &phi, &dphi);
+    evaluations++;
+
+    if ( phi > phi0 + c1*a*dphi0 || (evaluations > 1 && phi >= phi_lo) )
+      {
+      a_hi = a; phi_hi = phi; dphi_hi = dphi;
+      zoom = TRUE;
+      }
+    else if ( fabs(dphi) <= -c2*dphi0 )
+      {
+      _linesearch_swap(ls, TRUE);
+      *step = a;
+      return TRUE;
+      }
+    else if ( dphi >= 0.0 )
+      {
+      a_hi = a_lo; phi_hi = phi_lo; dphi_hi = dphi_lo;
+      a_lo = a; phi_lo = phi; dphi_lo = dphi;
+      _linesearch_swap(ls, FALSE);
+      ls->prev_valid = TRUE;
+      zoom = TRUE;
+      }
+    else
+      {
+      a_lo = a; phi_lo = phi; dphi_lo = dphi;
+      _linesearch_swap(ls, FALSE);
+      ls->prev_valid = TRUE;
+      a *= 2.0;
+      }
+    }
+
+/*
+ * Zoom phase.  a_lo always satisfies the sufficient increase
+ * condition, and has the best fitness found so far.
+ */
+  while (zoom && evaluations < LINESEARCH_MAX_EVALUATIONS)
+    {
+    a = _linesearch_interpolate(a_lo, phi_lo, dphi_lo, a_hi, phi_hi, dphi_hi);
+
+    _linesearch_evaluate(pop, ls, a, &phi, &dphi);
+    evaluations++;
+
+    if ( phi > phi0 + c1*a*dphi0 || phi >= phi_lo )
+      {
+      a_hi = a; phi_hi = phi; dphi_hi = dphi;
+      }
+    else
+      {
+      if ( fabs(dphi) <= -c2*dphi0 )
+        {
+        _linesearch_swap(ls, TRUE);
+        *step = a;
+        return TRUE;
+        }
+
+      if ( dphi*(a_hi-a_lo) >= 0.0 )
+        {
+        a_hi = a_lo; phi_hi = phi_lo; dphi_hi = dphi_lo;
+        }
+
+      a_lo = a; phi_lo = phi; dphi_lo = dphi;
+      _linesearch_swap(ls, FALSE);
+      ls->prev_valid = TRUE;
+      }
+
+    if ( fabs(a_hi-a_lo) <= TINY*MAX(1.0,a_lo) ) break;
+    }
+
+/*
+ * No step satisfying the curvature condition was found, so fall
+ * back to the best point which gave sufficient increase.
+ */
+  if (ls->prev_valid)
+    {
+    _linesearch_swap(ls, FALSE);	/* prev -> trial */
+    _linesearch_swap(ls, TRUE);		/* trial -> cur */
+    *step = a_lo;
+    return TRUE;
+    }
+
+  return FALSE;
+  }
+
+
+/**********************************************************************
+  _gradient_linesearch_method()
+  synopsis:	Driver shared by ga_lbfgs() and ga_conjugategradient().
+  parameters:	population *pop
+		entity *initial
+		const int max_iterations
+		const boolean use_lbfgs		Otherwise, use the
+						Polak-Ribiere conjugate
+						gradient method.
+  return:	Number of iterations performed.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static int _gradient_linesearch_method( population	*pop,
+					entity		*initial,
+					const int	max_iterations,
+					const boolean	use_lbfgs )
+  {
+  int		iteration=0;		/* Current iteration number. */
+  int		i, k;			/* Loop variables. */
+  int		n;			/* Dimensions. */
+  int		m=0;			/* Number of stored corrections. */
+  int		newest=-1;		/* Index of newest correction. */
+  int		memory;			/* Maximum stored corrections. */
+  linesearch_t	ls;			/* Line search workspace. */
+  double	*buffer;		/* Storage for all double arrays. */
+  double	*s, *y, *rho, *coeff;	/* L-BFGS corrections. */
+  double	*old_d, *old_g;		/* Previous point. */
+  double	c1, c2;			/* Wolfe constants. */
+  double	step=0.0;		/* Accepted step length. */
+  double	initial_step;		/* First trial step length. */
+  double	grms;			/* Current RMS gradient. */
+  double	dg, old_dg=0.0;		/* Directional derivatives. */
+  double	sy, yy, beta, tmp;	/* Intermediate values. */
+  boolean	restarted=FALSE;	/* Whether direction was just reset. */
+  entity	*start=initial;		/* Caller's solution. */
+
+/*
+ * Checks.
+ */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->gradient_params) die("ga_population_set_gradient_params(), or similar, must be used prior to ga_lbfgs() or ga_conjugategradient().");
+  if (!pop->gradient_params->to_double) die("Population's genome to double callback is undefined.");
+  if (!pop->gradient_params->from_double) die("Population's genome from double callback is undefined.");
+  if (!pop->gradient_params->gradient) die("Population's first derivatives callback is undefined.");
+
+  gaul_trace_begin(GAUL_TRACE_SEARCH, use_lbfgs?"ga_lbfgs":"ga_conjugategradient");
+
+  n = pop->gradient_params->dimensions;
+  memory = use_lbfgs?pop->gradient_params->memory:0;
+  c1 = pop->gradient_params->wolfe_c1;
+  c2 = pop->gradient_params->wolfe_c2;
+  if (!use_lbfgs && c2 > 0.1) c2 = 0.1;
+
+/* 
+ * Prepare working entities and double arrays.  Memory use is
+ * O(memory*dimensions).
+ */
+  if ( !(buffer = s_malloc(sizeof(double)*(n*(9+2*memory)+2*memory))) )
+    die("Unable to allocate memory");
+
+  ls.dimensions = n;
+  ls.cur_d = buffer;
+  ls.cur_g = &(buffer[n]);
+  ls.trial_d = &(buffer[2*n]);
+  ls.trial_g = &(buffer[3*n]);
+  ls.prev_d = &(buffer[4*n]);
+  ls.prev_g = &(buffer[5*n]);
+  ls.dir = &(buffer[6*n]);
+  old_d = &(buffer[7*n]);
+  old_g = &(buffer[8*n]);
+  s = &(buffer[9*n]);
+  y = &(buffer[(9+memory)*n]);
+  rho = &(buffer[(9+2*memory)*n]);
+  coeff = &(buffer[(9+2*memory)*n+memory]);
+
+  ls.cur = ga_get_free_entity(pop);
+  ls.trial = ga_get_free_entity(pop);
+  ls.prev = ga_get_free_entity(pop);
+
+/* Do we need to generate a random starting solution? */
+  if (!start)
+    {
+    plog(LOG_VERBOSE, "Will perform %s search with random starting solution.", use_lbfgs?"L-BFGS":"conjugate gradient");
+
+    ga_entity_seed(pop, ls.cur);
+    }
+  else
+    {
+    plog(LOG_VERBOSE, "Will perform %s search with specified starting solution.", use_lbfgs?"L-BFGS":"conjugate gradient");
+
+    ga_entity_copy(pop, ls.cur, start);
+    }
+
+/*
+ * Get initial fitness and derivatives.
+ */
+  gaul_evaluate(pop, ls.cur);
+  pop->gradient_params->to_double(pop, ls.cur, ls.cur_d);
+  grms = pop->gradient_params->gradient(pop, ls.cur, ls.cur_d, ls.cur_g);
+
+  plog( LOG_VERBOSE,
+        "Prior to the first iteration, the current solution has fitness score of %f and a RMS gradient of %f",
+         ls.cur->fitness, grms );
+
+  for (i=0; i<n; i++)
+    ls.dir[i] = ls.cur_g[i];
+  restarted = TRUE;
+
+/*
+ * Do all the iterations:
+ *
+ * Stop when (a) max_iterations reached, or
+ *           (b) "pop->iteration_hook" returns FALSE, or
+ *           (c) the gradient vanishes, or
+ *           (d) no step along the steepest ascent direction helps.
+ */
+  while ( grms > ApproxZero &&
+          (pop->iteration_hook?pop->iteration_hook(iteration, ls.cur):TRUE) &&
+          iteration<max_iterations )
+    {
+    iteration++;
+
+    dg = 0.0;
+    for (i=0; i<n; i++)
+      dg += ls.cur_g[i]*ls.dir[i];
+
+    if (restarted)
+      {	/* First step, or after a reset, has length step_size. */
+      initial_step = pop->gradient_params->step_size/sqrt(dg);
+      }
+    else if (use_lbfgs)
+      {
+      initial_step = 1.0;
+      }
+    else
+      {
+      initial_step = step*old_dg/dg;
+      }
+    old_dg = dg;
+
+    memcpy(old_d, ls.cur_d, sizeof(double)*n);
+    memcpy(old_g, ls.cur_g, sizeof(double)*n);
+
+    if ( !_linesearch(pop, &ls, initial_step, c1, c2, &step) )
+      {
+      if (restarted) break;	/* Steepest ascent failed too. */
+
+      plog(LOG_VERBOSE, "Line search failed, resetting search direction.");
+
+      m = 0;
+      newest = -1;
+      for (i=0; i<n; i++)
+        ls.dir[i] = ls.cur_g[i];
+      restarted = TRUE;
+      continue;
+      }
+
+    grms = 0.0;
+    for (i=0; i<n; i++)
+      grms += ls.cur_g[i]*ls.cur_g[i];
+    grms = sqrt(grms/n);
+
+    restarted = FALSE;
+
+    if (use_lbfgs)
+      {
+/*
+ * Store the new correction pair, for minimisation of the negated
+ * fitness, provided that it has positive curvature.
+ */
+      k = (newest+1)%memory;
+      sy = 0.0;
+      yy = 0.0;
+      for (i=0; i<n; i++)
+        {
+        s[k*n+i] = ls.cur_d[i]-old_d[i];
+        y[k*n+i] = old_g[i]-ls.cur_g[i];
+        sy += s[k*n+i]*y[k*n+i];
+        yy += y[k*n+i]*y[k*n+i];
+        }
+
+      if (sy > TINY*yy)
+        {
+        rho[k] = 1.0/sy;
+        newest = k;
+        if (m < memory) m++;
+        }
+
+/*
+ * Two-loop recursion for the new ascent direction.
+ */
+      for (i=0; i<n; i++)
+        ls.dir[i] = ls.cur_g[i];
+
+      for (k=0; k<m; k++)
+        {
+        int	j = (newest-k+memory)%memory;
+
+        tmp = 0.0;
+        for (i=0; i<n; i++) tmp += s[j*n+i]*ls.dir[i];
+        coeff[j] = rho[j]*tmp;
+        for (i=0; i<n; i++) ls.dir[i] -= coeff[j]*y[j*n+i];
+        }
+
+      if (m > 0)
+        {
+        sy = 0.0;
+        yy = 0.0;
+        for (i=0; i<n; i++)
+          {
+          sy += s[newest*n+i]*y[newest*n+i];
+          yy += y[newest*n+i]*y[newest*n+i];
+          }
+        for (i=0; i<n; i++) ls.dir[i] *= sy/yy;
+        }
+
+      for (k=m-1; k>=0; k--)
+        {
+        int	j = (newest-k+memory)%memory;
+
+        tmp = 0.0;
+        for (i=0; i<n; i++) tmp += y[j*n+i]*ls.dir[i];
+        tmp = coeff[j]-rho[j]*tmp;
+        for (i=0; i<n; i++) ls.dir[i] += tmp*s[j*n+i];
+        }
+      }
+    else
+      {
+/*
+ * Polak-Ribiere update, restarting with the steepest ascent
+ * direction if beta would be negative, every n iterations or if
+ * the result is not an ascent direction.
+ */
+      tmp = 0.0;
+      beta = 0.0;
+      for (i=0; i<n; i++)
+        {
+        beta += ls.cur_g[i]*(ls.cur_g[i]-old_g[i]);
+        tmp += old_g[i]*old_g[i];
+        }
+      beta = (tmp > 0.0 && iteration%n != 0) ? MAX(0.0, beta/tmp) : 0.0;
+
+      dg = 0.0;
+      for (i=0; i<n; i++)
+        {
+        ls.dir[i] = ls.cur_g[i] + beta*ls.dir[i];
+        dg += ls.cur_g[i]*ls.dir[i];
+        }
+
+      if (dg <= 0.0)
+        {
+        for (i=0; i<n; i++)
+          ls.dir[i] = ls.cur_g[i];
+        }
+      }
+
+    plog( LOG_VERBOSE,
+          "After iteration %d, the current solution has fitness score of %f and RMS gradient of %f (step = %f)",
+          iteration, ls.cur->fitness, grms, step );
+
+    }	/* Iteration loop. */
+
+/*
+ * Store best solution.
+ */
+  if (start)
+    {
+    ga_entity_blank(pop, start);
+    ga_entity_copy(pop, start, ls.cur);
+    }
+
+/*
+ * Cleanup.
+ */
+  ga_entity_dereference(pop, ls.cur);
+  ga_entity_dereference(pop, ls.trial);
+  ga_entity_dereference(pop, ls.prev);
+
+  s_free(buffer);
+
+  gaul_trace_end();
+
   return iteration;
   }
 
+
+/**********************************************************************
+  ga_lbfgs()
+  synopsis:	Performs optimisation on the passed entity by using
+		the limited-memory BFGS quasi-Newton method.  Only the
+		last "memory" position and gradient differences are
+		stored, so the memory requirement is
+		O(memory*dimensions).  The passed entity will have its
+		data overwritten.  If initial is NULL, a random
+		starting solution is used.
+  parameters:	population *pop
+		entity *initial
+		const int max_iterations
+  return:	Number of iterations performed.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_lbfgs(	population	*pop,
+			entity		*initial,
+			const int	max_iterations )
+  {
+  return _gradient_linesearch_method(pop, initial, max_iterations, TRUE);
+  }
+
+
+/**********************************************************************
+  ga_conjugategradient()
+  synopsis:	Performs optimisation on the passed entity by using
+		the Polak-Ribiere nonlinear conjugate gradient method,
+		with automatic restarts.  The passed entity will have
+		its data overwritten.  If initial is NULL, a random
+		starting solution is used.
+  parameters:	population *pop
+		entity *initial
+		const int max_iterations
+  return:	Number of iterations performed.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_conjugategradient(	population	*pop,
+					entity		*initial,
+					const int	max_iterations )
+  {
+  return _gradient_linesearch_method(pop, initial, max_iterations, FALSE);
+  }
+
+
+
+/**********************************************************************
+  ga_population_set_gradient_difference_parameters()
+  synopsis:     Sets the parameters used by
+		ga_gradient_finite_difference().
+		ga_population_set_gradient_parameters() must have been
+		called first, which selects central differences with an
+		automatic step and the default number of threads.
+		The step along dimension i is
+		step*scale[i]*max(1,|x[i]|).
+  parameters:	population *pop		Population to set parameters of.
+		const ga_gradient_difference_type type	Forward,
+					central or Richardson extrapolated
+					central differences.
+		const double step	Step size, or 0.0 to choose a
+					step suited to the scheme.
+		const double *scale	Per-dimension step scaling,
+					which is copied, or NULL for none.
+		const int num_threads	Upper limit on concurrent
+					evaluations, or 0 to use the
+					GAUL_NUM_THREADS setting.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_gradient_difference_parameters( population	*pop,
+					const ga_gradient_difference_type	type,
+					const double		step,
+					const double		*scale,
+					const int		num_threads)
+  {
+  int		i;		/* Loop over dimensions. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->gradient_params ) die("ga_population_set_gradient_parameters() must be called first.");
+  if ( type != GA_GRADIENT_DIFFERENCE_FORWARD &&
+       type != GA_GRADIENT_DIFFERENCE_CENTRAL &&
+       type != GA_GRADIENT_DIFFERENCE_RICHARDSON ) die("Unknown finite difference scheme.");
+  if ( step < 0.0 ) die("Negative finite difference step.");
+  if ( num_threads < 0 ) die("Negative number of threads requested.");
+
+  plog( LOG_VERBOSE,
+        "Population's finite difference parameters set: type = %d step = %e num_threads = %d",
+        (int) type, step, num_threads );
+
+  pop->gradient_params->difference_type = type;
+  pop->gradient_params->difference_step = step;
+  pop->gradient_params->difference_threads = num_threads;
+
+  if (scale == NULL)
+    {
+    if (pop->gradient_params->difference_scale)
+      {
+      s_free(pop->gradient_params->difference_scale);
+      pop->gradient_params->difference_scale = NULL;
+      }
+    }
+  else
+    {
+    if (!pop->gradient_params->difference_scale)
+      {
+      if ( !(pop->gradient_params->difference_scale = s_malloc(sizeof(double)*pop->gradient_params->dimensions)) )
+        die("Unable to allocate memory");
+      }
+
+    for (i=0; i<pop->gradient_params->dimensions; i++)
+      {
+      if (scale[i] <= 0.0) die("Finite difference scale factors must be positive.");
+      pop->gradient_params->difference_scale[i] = scale[i];
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_gradient_finite_difference()
+  synopsis:	Gradient callback which approximates the first
+		derivatives by finite differences, for use when no
+		analytical gradient is available.  It may be passed to
+		ga_population_set_gradient_parameters() in place of a
+		user-defined GAgradient.  The perturbed solutions are
+		built with the from_double callback in scratch entities
+		and evaluated concurrently using
+		ga_evaluate_entities(), so the population's evaluation
+		callback must be thread-safe unless a single thread is
+		requested.  Forward differences need "dimensions"
+		evaluations and use the fitness already held by the
+		passed entity; central differences need twice as many,
+		and Richardson extrapolation four times as many.
+  parameters:	population *pop
+		entity *this_entity	The evaluated solution.
+		double *params		Its double array.
+		double *grad		Returned gradient.
+  return:	RMS gradient.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_gradient_finite_difference( population	*pop,
+					entity		*this_entity,
+					double		*params,
+					double		*grad )
+  {
+  static const double	offsets[4]={1.0, -1.0, 0.5, -0.5};	/* Perturbations, in steps. */
+  int		n;			/* Dimensions. */
+  int		num_points;		/* Perturbations per dimension. */
+  int		i, k;			/* Loop variables. */
+  entity	**scratch;		/* Perturbed solutions. */
+  double	*buffer;		/* Storage for double arrays. */
+  double	*h;			/* Step along each dimension. */
+  double	*x;			/* Perturbed double array. */
+  double	step;			/* Basic step size. */
+  double	central, half;		/* Central differences. */
+  double	grms=0.0;		/* RMS gradient. */
+  volatile double	tmp;		/* Forces rounding of steps. */
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!this_entity) die("Null pointer to entity structure passed.");
+  if (!pop->gradient_params) die("Population's gradient parameters are undefined.");
+  if (!pop->gradient_params->from_double) die("Population's genome from double callback is undefined.");
+
+  n = pop->gradient_params->dimensions;
+  step = pop->gradient_params->difference_step;
+
+  switch (pop->gradient_params->difference_type)
+    {
+    case GA_GRADIENT_DIFFERENCE_FORWARD:
+      num_points = 1;
+      if (step == 0.0) step = sqrt(DBL_EPSILON);
+      break;
+    case GA_GRADIENT_DIFFERENCE_CENTRAL:
+      num_points = 2;
+      if (step == 0.0) step = pow(DBL_EPSILON, 1.0/3.0);
+      break;
+    case GA_GRADIENT_DIFFERENCE_RICHARDSON:
+      num_points = 4;
+      if (step == 0.0) step = pow(DBL_EPSILON, 1.0/5.0);
+      break;
+    default:
+      die("Unknown finite difference scheme.");
+      return 0.0;
+    }
+
+  if ( !(buffer = s_malloc(sizeof(double)*2*n)) )
+    die("Unable to allocate memory");
+  if ( !(scratch = s_malloc(sizeof(entity *)*n*num_points)) )
+    die("Unable to allocate memory");
+
+  h = buffer;
+  x = &(buffer[n]);
+
+/*
+ * Build the perturbed solutions.  The steps are rounded so that
+ * x+h-x is exactly representable.
+ */
+  memcpy(x, params, sizeof(double)*n);
+
+  for (i=0; i<n; i++)
+    {
+    tmp = params[i] + step * MAX(1.0, fabs(params[i])) *
+          (pop->gradient_params->difference_scale?pop->gradient_params->difference_scale[i]:1.0);
+    h[i] = tmp - params[i];
+
+    for (k=0; k<num_points; k++)
+      {
+      scratch[i*num_points+k] = ga_get_free_entity(pop);
+      x[i] = params[i] + offsets[k]*h[i];
+      pop->gradient_params->from_double(pop, scratch[i*num_points+k], x);
+      }
+
+    x[i] = params[i];
+    }
+
+  ga_evaluate_entities(pop, scratch, n*num_points, pop->gradient_params->difference_threads);
+
+/*
+ * Combine the fitnesses.
+ */
+  for (i=0; i<n; i++)
+    {
+    switch (pop->gradient_params->difference_type)
+      {
+      case GA_GRADIENT_DIFFERENCE_FORWARD:
+        grad[i] = (scratch[i]->fitness - this_entity->fitness)/h[i];
+        break;
+      case GA_GRADIENT_DIFFERENCE_CENTRAL:
+        grad[i] = (scratch[2*i]->fitness - scratch[2*i+1]->fitness)/(2.0*h[i]);
+        break;
+      default:
+        central = (scratch[4*i]->fitness - scratch[4*i+1]->fitness)/(2.0*h[i]);
+        half = (scratch[4*i+2]->fitness - scratch[4*i+3]->fitness)/h[i];
+        grad[i] = (4.0*half - central)/3.0;
+      }
+
+    grms += grad[i]*grad[i];
+    }
+
+  for (i=0; i<n*num_points; i++)
+    ga_entity_dereference(pop, scratch[i]);
+
+  s_free(scratch);
+  s_free(buffer);
+
+  return sqrt(grms/n);
+  }
+
@@ -433,8 +433,8 @@ static int ga_entity_score_slang(int *pop_id, int *joe)
 
   if (!pop->evaluate) die("Scoring function not defined.");
 
-/*  return pop->evaluate(pop, ga_get_entity_from_id(pop, *joe));*/
-  pop->evaluate(pop, ga_get_entity_from_id(pop, *joe));
+/*  return gaul_evaluate(pop, ga_get_entity_from_id(pop, *joe));*/
+  gaul_evaluate(pop, ga_get_entity_from_id(pop, *joe));
 
 /*
   plog(LOG_DEBUG, "Return from pop->evaluate().\n");
@@ -787,7 +787,11 @@ static double ga_entity_get_fitness_slang(int *pop, int *id)
 
 static int ga_entity_set_fitness_slang(int *pop, int *id, double *fitness)
   {
-  ga_get_entity_from_id(ga_get_population_from_id(*pop), *id)->fitness = *fitness;
+  population	*p=ga_get_population_from_id(*pop);
+
+  ga_get_entity_from_id(p, *id)->fitness = *fitness;
+  gaul_stats_invalidate(p);
+
   return TRUE;
   }
 
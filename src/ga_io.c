@@ -37,6 +37,12 @@
 
 #include "gaul/ga_core.h"
 
+#ifndef USE_WINDOWS_H
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #define BUFFER_SIZE	1024
 
 /**********************************************************************
@@ -202,76 +208,26 @@ enum GA_POPULATION_HOOK_OFFSET
     GA_POPULATION_HOOK_COUNT
   };
 
+#ifndef USE_WINDOWS_H
 /**********************************************************************
-  ga_population_write()
-  synopsis:	Writes entire population and it's genetic data to disk,
-		using a binary format.
-		Note: Currently does not (and probably can not) store
-		any of the userdata.
-  parameters:
-  return:
-  last updated: 29 Jan 2006
+  gaul_population_get_hooks()
+  synopsis:	Convert a population's callbacks to function ids for
+		storage.  Note that user-implemented functions
+		currently can't be handled in these files.
+		id = -1 - Unknown, external function.
+		id = 0  - NULL function.
+		id > 0  - GAUL defined function.
+  parameters:	population *pop
+		int *id		Array of GA_POPULATION_HOOK_COUNT ids.
+  return:	none
+  last updated: 16 Oct 2026
  **********************************************************************/
 
-#ifndef USE_WINDOWS_H
-GAULFUNC boolean ga_population_write(population *pop, char *fname)
+static void gaul_population_get_hooks(population *pop, int *id)
   {
-  FILE          *fp;				/* File handle. */
-  int		i;				/* Loop variables. */
-  char		buffer[BUFFER_SIZE];		/* String buffer. */
-  int		id[GA_POPULATION_HOOK_COUNT];	/* Array of hook indices. */
+  int		i;				/* Loop over hooks. */
   int		count=0;			/* Number of unrecognised hook functions. */
-  char		*format_str="FORMAT: GAUL POPULATION 004";	/* Format tag. */
-
-/* Checks. */
-  if ( !pop ) die("Null pointer to population structure passed.");
-  if ( !fname ) die("Null pointer to filename passed.");
-
-/*
- * Open output file.
- */
-  if( !(fp=fopen(fname,"w")) )
-    dief("Unable to open population file \"%s\" for output.", fname);
 
-/*
- * Program info.
- */
-  fwrite(format_str, sizeof(char), strlen(format_str), fp);
-  for (i=0; i<64; i++) buffer[i]='\0';
-  snprintf(buffer, 64, "%s %s", GA_VERSION_STRING, GA_BUILD_DATE_STRING);
-  fwrite(buffer, sizeof(char), 64, fp);
-
-/*
- * Population info.
- */
-  fwrite(&(pop->size), sizeof(int), 1, fp);
-  fwrite(&(pop->stable_size), sizeof(int), 1, fp);
-  fwrite(&(pop->num_chromosomes), sizeof(int), 1, fp);
-  fwrite(&(pop->len_chromosomes), sizeof(int), 1, fp);
-
-/*
- * GA parameters.
- */
-  fwrite(&(pop->crossover_ratio), sizeof(double), 1, fp);
-  fwrite(&(pop->mutation_ratio), sizeof(double), 1, fp);
-  fwrite(&(pop->migration_ratio), sizeof(double), 1, fp);
-  fwrite(&(pop->allele_mutation_prob), sizeof(double), 1, fp);
-  fwrite(&(pop->allele_min_integer), sizeof(int), 1, fp);
-  fwrite(&(pop->allele_max_integer), sizeof(int), 1, fp);
-  fwrite(&(pop->allele_min_double), sizeof(double), 1, fp);
-  fwrite(&(pop->allele_max_double), sizeof(double), 1, fp);
-  fwrite(&(pop->scheme), sizeof(int), 1, fp);
-  fwrite(&(pop->elitism), sizeof(int), 1, fp);
-
-  fwrite(&(pop->island), sizeof(int), 1, fp);
-
-/*
- * Callback handling.  Note that user-implemented functions currently
- * can't be handled in these files.
- * id = -1 - Unknown, external function.
- * id = 0  - NULL function.
- * id > 0  - GAUL defined function.
- */
   id[GA_POPULATION_HOOK_OFFSET_GENERATION_HOOK] = ga_funclookup_ptr_to_id((void *)pop->generation_hook);
   id[GA_POPULATION_HOOK_OFFSET_ITERATION_HOOK]  = ga_funclookup_ptr_to_id((void *)pop->iteration_hook);
 
@@ -298,7 +254,59 @@ GAULFUNC boolean ga_population_write(population *pop, char *fname)
   id[GA_POPULATION_HOOK_OFFSET_REPLACE]     = ga_funclookup_ptr_to_id((void *)pop->replace);
   id[GA_POPULATION_HOOK_OFFSET_RANK]        = ga_funclookup_ptr_to_id((void *)pop->rank);
 
-  fwrite(id, sizeof(int), GA_POPULATION_HOOK_COUNT, fp);
+/*
+ * Warn user of any unhandled data.
+ */
+  for (i=0; i < GA_POPULATION_HOOK_COUNT; i++)
+    if (id[i] == -1) count++;
+
+  if (count>0)
+    plog(LOG_NORMAL, "Unable to handle %d hook function%sspecified in population structure.", count, count==1?" ":"s ");
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_population_set_hooks()
+  synopsis:	Restore a population's callbacks from stored function
+		ids.  See gaul_population_get_hooks().
+  parameters:	population *pop
+		int *id		Array of GA_POPULATION_HOOK_COUNT ids.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_population_set_hooks(population *pop, int *id)
+  {
+  int		i;				/* Loop over hooks. */
+  int		count=0;			/* Number of unrecognised hook functions. */
+
+  pop->generation_hook        = (GAgeneration_hook)  ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_GENERATION_HOOK]);
+  pop->iteration_hook         = (GAiteration_hook)   ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_ITERATION_HOOK]);
+
+  pop->data_destructor        = (GAdata_destructor)      ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_DATA_DESTRUCTOR]);
+  pop->data_ref_incrementor   = (GAdata_ref_incrementor) ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_DATA_REF_INCREMENTOR]);
+
+  pop->population_data_destructor = (GAdata_destructor) ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_POPULATION_DATA_DESTRUCTOR]);
+  pop->population_data_copy   = (GAdata_copy)           ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_POPULATION_DATA_COPY]);
+
+  pop->chromosome_constructor = (GAchromosome_constructor) ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_CONSTRUCTOR]);
+  pop->chromosome_destructor  = (GAchromosome_destructor)  ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_DESTRUCTOR]);
+  pop->chromosome_replicate   = (GAchromosome_replicate)   ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_REPLICATE]);
+  pop->chromosome_to_bytes    = (GAchromosome_to_bytes)    ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_TO_BYTES]);
+  pop->chromosome_from_bytes  = (GAchromosome_from_bytes)  ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_FROM_BYTES]);
+  pop->chromosome_to_string   = (GAchromosome_to_string)   ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_TO_STRING]);
+
+  pop->evaluate               = (GAevaluate)       ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_EVALUATE]);
+  pop->seed                   = (GAseed)           ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_SEED]);
+  pop->adapt                  = (GAadapt)          ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_ADAPT]);
+  pop->select_one             = (GAselect_one)     ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_SELECT_ONE]);
+  pop->select_two             = (GAselect_two)     ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_SELECT_TWO]);
+  pop->mutate                 = (GAmutate)         ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_MUTATE]);
+  pop->crossover              = (GAcrossover)      ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CROSSOVER]);
+  pop->replace                = (GAreplace)        ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_REPLACE]);
+  pop->rank                   = (GArank)           ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_RANK]);
 
 /*
  * Warn user of any unhandled data.
@@ -309,26 +317,729 @@ GAULFUNC boolean ga_population_write(population *pop, char *fname)
   if (count>0)
     plog(LOG_NORMAL, "Unable to handle %d hook function%sspecified in population structure.", count, count==1?" ":"s ");
 
+  return;
+  }
+
 /*
- * Entity info.
+ * GAUL POPULATION 005 files.
+ *
+ * The header occupies the first POPFILE_ALIGN bytes, so that the
+ * entity records that follow are page aligned.  Each record has the
+ * same stride, and holds the entity's fitness, its fitness vector and
+ * then its serialised chromosomes, which start on a RECORD_ALIGN byte
+ * boundary.  Records are stored in the order that they were written.
+ * They are followed by the index, which lists the record number of
+ * each entity in rank order.  Any entity can therefore be found
+ * directly in a memory-mapped file.  Values are stored in the host's
+ * byte order, as for format 004.
  */
-  for (i=0; i<pop->size; i++)
+#define POPFILE_FORMAT		"FORMAT: GAUL POPULATION 005"
+#define POPFILE_FORMAT_004	"FORMAT: GAUL POPULATION 004"
+#define POPFILE_ALIGN		4096
+#define RECORD_ALIGN		16
+#define POPFILE_PAD(len, align)	((((len)+(align)-1)/(align))*(align))
+
+typedef struct
+  {
+  char		format[32];		/* POPFILE_FORMAT. */
+  char		version[64];		/* GAUL version and build date. */
+  int		complete;		/* Whether the writer finished. */
+  int		size;			/* Number of entities. */
+  int		stable_size;
+  int		num_chromosomes;
+  int		len_chromosomes;
+  int		fitness_dimensions;
+  unsigned int	chromo_len;		/* Bytes of serialised chromosomes. */
+  unsigned int	chromo_offset;		/* Offset of chromosomes in a record. */
+  unsigned int	record_len;		/* Stride of records. */
+  double	crossover_ratio;
+  double	mutation_ratio;
+  double	migration_ratio;
+  double	allele_mutation_prob;
+  int		allele_min_integer;
+  int		allele_max_integer;
+  double	allele_min_double;
+  double	allele_max_double;
+  int		scheme;
+  int		elitism;
+  int		island;
+  int		id[GA_POPULATION_HOOK_COUNT];	/* Callback ids. */
+  size_t	records_offset;		/* Offset of first record. */
+  size_t	index_offset;		/* Offset of index. */
+  } popfile_header_t;
+
+/*
+ * An open population file; either memory-mapped for reading, or being
+ * streamed to disk.
+ */
+struct ga_population_file_t
+  {
+  popfile_header_t	*header;	/* File header. */
+  gaulbyte		*map;		/* Mapped file, or NULL if writing. */
+  size_t		map_len;	/* Length of mapping. */
+  unsigned int		*index;		/* Record number of each rank. */
+  FILE			*fp;		/* Output file, or NULL if reading. */
+  char			*fname;		/* Output filename. */
+  gaulbyte		*record;	/* Record being written. */
+  double		*fitness;	/* Fitness of each record written. */
+  int			max_entities;	/* Size of fitness array. */
+  boolean		ranked;		/* Whether records are written in rank order. */
+  };
+
+/*
+ * Index entry used for sorting records by fitness.
+ */
+typedef struct
+  {
+  double	fitness;
+  unsigned int	record;
+  } popfile_rank_t;
+
+
+/**********************************************************************
+  gaul_popfile_compare()
+  synopsis:	qsort() comparison of records: fittest first, then in
+		the order written.
+  parameters:	const void *a
+		const void *b
+  return:	Comparison.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static int gaul_popfile_compare(const void *a, const void *b)
+  {
+  const popfile_rank_t	*ra=a, *rb=b;	/* Records to compare. */
+
+  if (ra->fitness > rb->fitness) return -1;
+  if (ra->fitness < rb->fitness) return 1;
+  if (ra->record < rb->record) return -1;
+  if (ra->record > rb->record) return 1;
+
+  return 0;
+  }
+
+
+/**********************************************************************
+  gaul_popfile_write()
+  synopsis:	Write to a population file, or die.
+  parameters:	ga_population_file *file
+		const void *data
+		const size_t len
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void gaul_popfile_write(ga_population_file *file, const void *data, const size_t len)
+  {
+
+  if (len > 0 && fwrite(data, 1, len, file->fp) != len)
+    dief("Unable to write population file \"%s\".", file->fname);
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_file_create()
+  synopsis:	Start streaming entities to a new population file, in
+		format 005.  Entities are added, in any order, with
+		ga_population_file_append(), without the need to hold
+		them all in memory, and the file is completed by
+		ga_population_file_close().  The population provides
+		the parameters and callbacks that are stored.
+		Note: Currently does not (and probably can not) store
+		any of the userdata.
+  parameters:	population *pop
+		char *fname	Filename to write to.
+  return:	New population file.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC ga_population_file *ga_population_file_create(population *pop, char *fname)
+  {
+  ga_population_file	*file;		/* New population file. */
+  popfile_header_t	*header;	/* File header. */
+  gaulbyte		*padding;	/* Header block. */
+
+/* Checks. */
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !fname ) die("Null pointer to filename passed.");
+  if ( !pop->chromosome_to_bytes ) die("Population's chromosome to bytes callback is undefined.");
+
+  if ( !(file = s_malloc(sizeof(ga_population_file))) )
+    die("Unable to allocate memory");
+  if ( !(file->header = s_malloc(sizeof(popfile_header_t))) )
+    die("Unable to allocate memory");
+
+  file->map = NULL;
+  file->map_len = 0;
+  file->index = NULL;
+  file->record = NULL;
+  file->fitness = NULL;
+  file->max_entities = 0;
+  file->ranked = FALSE;
+  file->fname = s_strdup(fname);
+
+  if( !(file->fp=fopen(fname,"w")) )
+    dief("Unable to open population file \"%s\" for output.", fname);
+
+/*
+ * The header is finalised when the file is closed.
+ */
+  header = file->header;
+  memset(header, 0, sizeof(popfile_header_t));
+  strcpy(header->format, POPFILE_FORMAT);
+  snprintf(header->version, 64, "%s %s", GA_VERSION_STRING, GA_BUILD_DATE_STRING);
+  header->complete = FALSE;
+  header->size = 0;
+  header->stable_size = pop->stable_size;
+  header->num_chromosomes = pop->num_chromosomes;
+  header->len_chromosomes = pop->len_chromosomes;
+  header->fitness_dimensions = pop->fitness_dimensions;
+  header->chromo_offset = POPFILE_PAD(sizeof(double)*(1+pop->fitness_dimensions), RECORD_ALIGN);
+  header->crossover_ratio = pop->crossover_ratio;
+  header->mutation_ratio = pop->mutation_ratio;
+  header->migration_ratio = pop->migration_ratio;
+  header->allele_mutation_prob = pop->allele_mutation_prob;
+  header->allele_min_integer = pop->allele_min_integer;
+  header->allele_max_integer = pop->allele_max_integer;
+  header->allele_min_double = pop->allele_min_double;
+  header->allele_max_double = pop->allele_max_double;
+  header->scheme = pop->scheme;
+  header->elitism = pop->elitism;
+  header->island = pop->island;
+  header->records_offset = POPFILE_PAD(sizeof(popfile_header_t), POPFILE_ALIGN);
+  gaul_population_get_hooks(pop, header->id);
+
+  if ( !(padding = s_calloc(header->records_offset, sizeof(gaulbyte))) )
+    die("Unable to allocate memory");
+  gaul_popfile_write(file, padding, header->records_offset);
+  s_free(padding);
+
+  return file;
+  }
+
+
+/**********************************************************************
+  ga_population_file_append()
+  synopsis:	Write an entity to a population file opened with
+		ga_population_file_create().  The chromosome_to_bytes
+		callback must produce the same length for every
+		entity.
+  parameters:	ga_population_file *file
+		population *pop
+		entity *this_entity
+  return:	Success.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_file_append( ga_population_file *file,
+                                            population *pop, entity *this_entity )
+  {
+  popfile_header_t	*header;	/* File header. */
+  gaulbyte		*chromo=NULL;	/* Serialised chromosomes. */
+  unsigned int		chromo_max=0;	/* Serialisation buffer size. */
+  unsigned int		len;		/* Serialised length. */
+
+/* Checks. */
+  if ( !file || !file->fp ) die("Population file not open for writing.");
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !this_entity ) die("Null pointer to entity structure passed.");
+
+  header = file->header;
+
+  if (pop->fitness_dimensions != header->fitness_dimensions)
+    die("Entity has incompatible fitness dimensions.");
+
+  len = pop->chromosome_to_bytes(pop, this_entity, &chromo, &chromo_max);
+
+  if (!file->record)
+    {
+    header->chromo_len = len;
+    header->record_len = POPFILE_PAD(header->chromo_offset+len, RECORD_ALIGN);
+    if ( !(file->record = s_calloc(header->record_len, sizeof(gaulbyte))) )
+      die("Unable to allocate memory");
+    }
+  else if (len != header->chromo_len)
+    {
+    die("Entities have differing serialised lengths.");
+    }
+
+  if (header->size == file->max_entities)
     {
-    gaul_write_entity_posix(fp, pop, pop->entity_iarray[i]);
+    file->max_entities = file->max_entities?file->max_entities*2:1024;
+    if ( !(file->fitness = s_realloc(file->fitness, file->max_entities*sizeof(double))) )
+      die("Unable to allocate memory");
     }
+  file->fitness[header->size] = this_entity->fitness;
 
 /*
- * Footer info.
+ * Assemble the record, so that it is written in one call.
  */
-  fwrite("END", sizeof(char), 4, fp); 
+  memcpy(file->record, &(this_entity->fitness), sizeof(double));
+  if (header->fitness_dimensions > 0)
+    memcpy(&(file->record[sizeof(double)]), this_entity->fitvector,
+           sizeof(double)*header->fitness_dimensions);
+  memcpy(&(file->record[header->chromo_offset]), chromo, len);
+
+  gaul_popfile_write(file, file->record, header->record_len);
+
+  header->size++;
 
 /*
- * Close file.
+ * We only need to deallocate the buffer if it was allocated (i.e. if
+ * the "chromosome_to_bytes" callback set max_len).
  */
-  fclose(fp);
+  if (chromo_max > 0) s_free(chromo);
 
   return TRUE;
-}
+  }
+
+
+/**********************************************************************
+  ga_population_file_open()
+  synopsis:	Memory-map a population file written in format 005,
+		for random access to its entities.  Nothing is read
+		until it is used, so the fittest few entities of a
+		large file may be loaded cheaply.
+  parameters:	char *fname	Filename to read from.
+  return:	Population file.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC ga_population_file *ga_population_file_open(char *fname)
+  {
+  ga_population_file	*file;		/* Population file. */
+  popfile_header_t	*header;	/* File header. */
+  int			fd;		/* File descriptor. */
+  struct stat		st;		/* File details. */
+
+/* Checks. */
+  if ( !fname ) die("Null pointer to filename passed.");
+
+  if ( (fd = open(fname, O_RDONLY)) == -1 )
+    dief("Unable to open population file \"%s\" for input.", fname);
+
+  if ( fstat(fd, &st) != 0 )
+    dief("Unable to determine size of population file \"%s\".", fname);
+
+  if ( (size_t) st.st_size < sizeof(popfile_header_t) )
+    {
+    close(fd);
+    die("Invalid file format");
+    }
+
+  if ( !(file = s_malloc(sizeof(ga_population_file))) )
+    die("Unable to allocate memory");
+
+  file->map_len = (size_t) st.st_size;
+  file->map = mmap(NULL, file->map_len, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+
+  if (file->map == MAP_FAILED)
+    dief("Unable to map population file \"%s\".", fname);
+
+  file->header = header = (popfile_header_t *) file->map;
+  file->fp = NULL;
+  file->fname = NULL;
+  file->record = NULL;
+  file->fitness = NULL;
+  file->max_entities = 0;
+  file->ranked = FALSE;
+
+  if (strcmp(header->format, POPFILE_FORMAT)!=0)
+    {
+    ga_population_file_close(file);
+    die("Invalid file format");
+    }
+
+  if ( !header->complete ||
+       header->index_offset+header->size*sizeof(unsigned int) > file->map_len )
+    {
+    ga_population_file_close(file);
+    die("Corrupt population file?");
+    }
+
+  file->index = (unsigned int *) &(file->map[header->index_offset]);
+
+  return file;
+  }
+
+
+/**********************************************************************
+  ga_population_file_close()
+  synopsis:	Close a population file.  If it was created by
+		ga_population_file_create(), the index of entities in
+		order of decreasing fitness is written, and the file
+		is completed.  Otherwise, it is unmapped.
+  parameters:	ga_population_file *file
+  return:	Success.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_file_close(ga_population_file *file)
+  {
+  popfile_header_t	*header;	/* File header. */
+  popfile_rank_t	*ranks;		/* Records sorted by fitness. */
+  unsigned int		*index;		/* Record number of each rank. */
+  int			i;		/* Loop over entities. */
+
+  if ( !file ) die("Null pointer to population file passed.");
+
+  if (file->map)
+    {
+    munmap(file->map, file->map_len);
+    s_free(file);
+    return TRUE;
+    }
+
+  header = file->header;
+
+  if ( !(index = s_malloc((header->size+1)*sizeof(unsigned int))) )
+    die("Unable to allocate memory");
+
+  if (file->ranked)
+    {
+    for (i=0; i<header->size; i++)
+      index[i] = i;
+    }
+  else
+    {
+    if ( !(ranks = s_malloc((header->size+1)*sizeof(popfile_rank_t))) )
+      die("Unable to allocate memory");
+
+    for (i=0; i<header->size; i++)
+      {
+      ranks[i].fitness = file->fitness[i];
+      ranks[i].record = i;
+      }
+
+    qsort(ranks, header->size, sizeof(popfile_rank_t), gaul_popfile_compare);
+
+    for (i=0; i<header->size; i++)
+      index[i] = ranks[i].record;
+
+    s_free(ranks);
+    }
+
+  header->index_offset = header->records_offset + (size_t) header->size*header->record_len;
+  gaul_popfile_write(file, index, header->size*sizeof(unsigned int));
+  s_free(index);
+
+/*
+ * Finally, rewrite the header.
+ */
+  header->complete = TRUE;
+  if ( fseek(file->fp, 0, SEEK_SET) != 0 )
+    dief("Unable to write population file \"%s\".", file->fname);
+  gaul_popfile_write(file, header, sizeof(popfile_header_t));
+
+  if ( fclose(file->fp) != 0 )
+    dief("Unable to write population file \"%s\".", file->fname);
+
+  s_free(header);
+  if (file->record) s_free(file->record);
+  if (file->fitness) s_free(file->fitness);
+  s_free(file->fname);
+  s_free(file);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  ga_population_file_get_size()
+  synopsis:	Number of entities in a population file.
+  parameters:	ga_population_file *file
+  return:	Number of entities.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_population_file_get_size(ga_population_file *file)
+  {
+  if ( !file ) die("Null pointer to population file passed.");
+
+  return file->header->size;
+  }
+
+
+/**********************************************************************
+  gaul_popfile_record()
+  synopsis:	Locate the record of the entity with a given rank in a
+		mapped population file.
+  parameters:	ga_population_file *file
+		const int rank
+  return:	Record.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static gaulbyte *gaul_popfile_record(ga_population_file *file, const int rank)
+  {
+  size_t	offset;		/* Offset of record. */
+
+  if ( !file || !file->map ) die("Population file not open for reading.");
+  if ( rank < 0 || rank >= file->header->size ) die("Invalid entity rank.");
+
+  offset = file->header->records_offset + (size_t) file->index[rank]*file->header->record_len;
+  if ( offset+file->header->record_len > file->header->index_offset )
+    die("Corrupt population file?");
+
+  return &(file->map[offset]);
+  }
+
+
+/**********************************************************************
+  ga_population_file_get_fitness()
+  synopsis:	Fitness of the entity with a given rank in a population
+		file, without loading the entity.
+  parameters:	ga_population_file *file
+		const int rank
+  return:	Fitness.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_population_file_get_fitness(ga_population_file *file, const int rank)
+  {
+  double	fitness;	/* Fitness of entity. */
+
+  memcpy(&fitness, gaul_popfile_record(file, rank), sizeof(double));
+
+  return fitness;
+  }
+
+
+/**********************************************************************
+  ga_population_file_get_entity()
+  synopsis:	Load the entity with a given rank in a population file
+		into a compatible population.  The population is not
+		re-sorted.
+  parameters:	ga_population_file *file
+		population *pop
+		const int rank
+  return:	New entity.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC entity *ga_population_file_get_entity( ga_population_file *file,
+                                                population *pop, const int rank )
+  {
+  gaulbyte	*record;	/* Entity's record. */
+  entity	*this_entity;	/* New entity. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->chromosome_from_bytes ) die("Population's chromosome from bytes callback is undefined.");
+
+  record = gaul_popfile_record(file, rank);
+
+  if (pop->fitness_dimensions != file->header->fitness_dimensions)
+    die("Population has incompatible fitness dimensions.");
+
+  this_entity = ga_get_free_entity(pop);
+  memcpy(&(this_entity->fitness), record, sizeof(double));
+  if (pop->fitness_dimensions > 0)
+    memcpy(this_entity->fitvector, &(record[sizeof(double)]),
+           sizeof(double)*pop->fitness_dimensions);
+  pop->chromosome_from_bytes(pop, this_entity, &(record[file->header->chromo_offset]));
+
+  return this_entity;
+  }
+
+
+/**********************************************************************
+  ga_population_file_get_population()
+  synopsis:	Create a population from a population file, holding
+		its fittest entities.  The population's parameters and
+		callbacks are restored as far as possible.  See
+		ga_population_file_create() for details.
+  parameters:	ga_population_file *file
+		const int num	Number of entities to load, or -1 for
+				all of them.
+  return:	New population.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC population *ga_population_file_get_population(ga_population_file *file, const int num)
+  {
+  popfile_header_t	*header;	/* File header. */
+  population		*pop;		/* New population. */
+  int			i;		/* Loop over entities. */
+  int			count;		/* Number of entities to load. */
+
+  if ( !file || !file->map ) die("Population file not open for reading.");
+
+  header = file->header;
+
+  pop = ga_population_new(header->stable_size, header->num_chromosomes, header->len_chromosomes);
+  if ( !pop ) die("Unable to allocate population structure.");
+
+  pop->fitness_dimensions = header->fitness_dimensions;
+  pop->crossover_ratio = header->crossover_ratio;
+  pop->mutation_ratio = header->mutation_ratio;
+  pop->migration_ratio = header->migration_ratio;
+  pop->allele_mutation_prob = header->allele_mutation_prob;
+  pop->allele_min_integer = header->allele_min_integer;
+  pop->allele_max_integer = header->allele_max_integer;
+  pop->allele_min_double = header->allele_min_double;
+  pop->allele_max_double = header->allele_max_double;
+  pop->scheme = header->scheme;
+  pop->elitism = header->elitism;
+  pop->island = header->island;
+  gaul_population_set_hooks(pop, header->id);
+
+  count = (num < 0 || num > header->size) ? header->size : num;
+
+  for (i=0; i<count; i++)
+    ga_population_file_get_entity(file, pop, i);
+
+  plog(LOG_DEBUG, "Have read %d entities into population.", pop->size);
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  ga_population_read_best()
+  synopsis:	Reads the fittest entities of a population from disk.
+		Only their records are read from a format 005 file;
+		other formats are read in full, then reduced.
+  parameters:	char *fname		Filename to read from.
+		const int num		Number of entities to keep.
+  return:	population *pop		New population structure.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC population *ga_population_read_best(char *fname, const int num)
+  {
+  population		*pop;		/* New population. */
+  ga_population_file	*file;		/* Population file. */
+  FILE			*fp;		/* File handle. */
+  char			format_str_in[32]="";	/* Input format tag. */
+
+  if ( !fname ) die("Null pointer to filename passed.");
+  if ( num < 0 ) die("Negative number of entities requested.");
+
+  if( !(fp=fopen(fname,"r")) )
+    dief("Unable to open population file \"%s\" for input.", fname);
+  fread(format_str_in, sizeof(char), strlen(POPFILE_FORMAT), fp);
+  fclose(fp);
+
+  if (strcmp(POPFILE_FORMAT, format_str_in)!=0)
+    {
+    pop = ga_population_read(fname);
+    ga_genocide(pop, num);
+    return pop;
+    }
+
+  file = ga_population_file_open(fname);
+  pop = ga_population_file_get_population(file, num);
+  ga_population_file_close(file);
+
+  return pop;
+  }
+
+#else
+
+GAULFUNC ga_population_file *ga_population_file_create(population *pop, char *fname)
+  {
+  die("Population file format 005 not supported on this platform.");
+  return NULL;
+  }
+
+GAULFUNC boolean ga_population_file_append( ga_population_file *file,
+                                            population *pop, entity *this_entity )
+  {
+  die("Population file format 005 not supported on this platform.");
+  return FALSE;
+  }
+
+GAULFUNC ga_population_file *ga_population_file_open(char *fname)
+  {
+  die("Population file format 005 not supported on this platform.");
+  return NULL;
+  }
+
+GAULFUNC boolean ga_population_file_close(ga_population_file *file)
+  {
+  die("Population file format 005 not supported on this platform.");
+  return FALSE;
+  }
+
+GAULFUNC int ga_population_file_get_size(ga_population_file *file)
+  {
+  die("Population file format 005 not supported on this platform.");
+  return 0;
+  }
+
+GAULFUNC double ga_population_file_get_fitness(ga_population_file *file, const int rank)
+  {
+  die("Population file format 005 not supported on this platform.");
+  return 0.0;
+  }
+
+GAULFUNC entity *ga_population_file_get_entity( ga_population_file *file,
+                                                population *pop, const int rank )
+  {
+  die("Population file format 005 not supported on this platform.");
+  return NULL;
+  }
+
+GAULFUNC population *ga_population_file_get_population(ga_population_file *file, const int num)
+  {
+  die("Population file format 005 not supported on this platform.");
+  return NULL;
+  }
+
+GAULFUNC population *ga_population_read_best(char *fname, const int num)
+  {
+  population	*pop;		/* New population. */
+
+  if ( num < 0 ) die("Negative number of entities requested.");
+
+  pop = ga_population_read(fname);
+  ga_genocide(pop, num);
+
+  return pop;
+  }
+
+#endif
+
+
+/**********************************************************************
+  ga_population_write()
+  synopsis:	Writes entire population and it's genetic data to disk,
+		using a binary format.  On POSIX systems, this is
+		format 005, which may be memory-mapped; see
+		ga_population_file_create().  Otherwise, format 004
+		is used.
+		Note: Currently does not (and probably can not) store
+		any of the userdata.
+  parameters:
+  return:
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+#ifndef USE_WINDOWS_H
+GAULFUNC boolean ga_population_write(population *pop, char *fname)
+  {
+  ga_population_file	*file;		/* Population file. */
+  int			i;		/* Loop over entities. */
+
+/* Checks. */
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !fname ) die("Null pointer to filename passed.");
+
+  file = ga_population_file_create(pop, fname);
+
+/*
+ * Entities are written in rank order, so the index needn't be sorted.
+ */
+  file->ranked = TRUE;
+
+  for (i=0; i<pop->size; i++)
+    ga_population_file_append(file, pop, pop->entity_iarray[i]);
+
+  return ga_population_file_close(file);
+  }
 #else
 
 GAULFUNC boolean ga_population_write(population *pop, char *fname)
@@ -476,10 +1187,11 @@ GAULFUNC boolean ga_population_write(population *pop, char *fname)
   ga_population_read()
   synopsis:	Reads entire population and it's genetic data back
 		from disk.   Some things can't be restored.  See
-		ga_population_write() for details.
+		ga_population_write() for details.  Formats 004 and,
+		on POSIX systems, 005 are understood.
   parameters:	char *fname		Filename to read from.
   return:	population *pop		New population structure.
-  last updated: 24 Feb 2005
+  last updated: 16 Oct 2026
  **********************************************************************/
 
 #ifndef USE_WINDOWS_H
@@ -491,10 +1203,10 @@ GAULFUNC population *ga_population_read(char *fname)
   int		i;				/* Loop variables. */
   char		buffer[BUFFER_SIZE];		/* String buffer. */
   int		id[GA_POPULATION_HOOK_COUNT];			/* Array of hook indices. */
-  int		count=0;			/* Number of unrecognised hook functions. */
-  char		*format_str="FORMAT: GAUL POPULATION 004";	/* Format tag. */
+  char		*format_str=POPFILE_FORMAT_004;	/* Format tag. */
   char		format_str_in[32]="";		/* Input format tag. (Empty initialiser to avoid valgrind warning...) */
   int		size, stable_size, num_chromosomes, len_chromosomes;	/* Input data. */
+  ga_population_file	*file;			/* Format 005 file. */
 
 /* Checks. */
   if ( !fname ) die("Null pointer to filename passed.");
@@ -509,6 +1221,18 @@ GAULFUNC population *ga_population_read(char *fname)
  * Program info.
  */
   fread(format_str_in, sizeof(char), strlen(format_str), fp);
+
+  if (strcmp(POPFILE_FORMAT, format_str_in)==0)
+    {
+    fclose(fp);
+
+    file = ga_population_file_open(fname);
+    pop = ga_population_file_get_population(file, -1);
+    ga_population_file_close(file);
+
+    return pop;
+    }
+
   if (strcmp(format_str, format_str_in)!=0)
     {
     fclose(fp);
@@ -559,40 +1283,7 @@ GAULFUNC population *ga_population_read(char *fname)
  */
   fread(id, sizeof(int), GA_POPULATION_HOOK_COUNT, fp);
 
-  pop->generation_hook        = (GAgeneration_hook)  ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_GENERATION_HOOK]);
-  pop->iteration_hook         = (GAiteration_hook)   ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_ITERATION_HOOK]);
-
-  pop->data_destructor        = (GAdata_destructor)      ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_DATA_DESTRUCTOR]);
-  pop->data_ref_incrementor   = (GAdata_ref_incrementor) ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_DATA_REF_INCREMENTOR]);
-
-  pop->population_data_destructor = (GAdata_destructor) ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_POPULATION_DATA_DESTRUCTOR]);
-  pop->population_data_copy   = (GAdata_copy)           ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_POPULATION_DATA_COPY]);
-
-  pop->chromosome_constructor = (GAchromosome_constructor) ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_CONSTRUCTOR]);
-  pop->chromosome_destructor  = (GAchromosome_destructor)  ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_DESTRUCTOR]);
-  pop->chromosome_replicate   = (GAchromosome_replicate)   ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_REPLICATE]);
-  pop->chromosome_to_bytes    = (GAchromosome_to_bytes)    ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_TO_BYTES]);
-  pop->chromosome_from_bytes  = (GAchromosome_from_bytes)  ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_FROM_BYTES]);
-  pop->chromosome_to_string   = (GAchromosome_to_string)   ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CHROMOSOME_TO_STRING]);
-
-  pop->evaluate               = (GAevaluate)       ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_EVALUATE]);
-  pop->seed                   = (GAseed)           ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_SEED]);
-  pop->adapt                  = (GAadapt)          ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_ADAPT]);
-  pop->select_one             = (GAselect_one)     ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_SELECT_ONE]);
-  pop->select_two             = (GAselect_two)     ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_SELECT_TWO]);
-  pop->mutate                 = (GAmutate)         ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_MUTATE]);
-  pop->crossover              = (GAcrossover)      ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_CROSSOVER]);
-  pop->replace                = (GAreplace)        ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_REPLACE]);
-  pop->rank                   = (GArank)           ga_funclookup_id_to_ptr(id[GA_POPULATION_HOOK_OFFSET_RANK]);
-
-/*
- * Warn user of any unhandled data.
- */
-  for (i=0; i < GA_POPULATION_HOOK_COUNT; i++)
-    if (id[i] == -1) count++;
-
-  if (count>0)
-    plog(LOG_NORMAL, "Unable to handle %d hook function%sspecified in population structure.", count, count==1?" ":"s ");
+  gaul_population_set_hooks(pop, id);
 
 /*
  * Entity info.
@@ -0,0 +1,527 @@
+/**********************************************************************
+  ga_multistart.c
+ **********************************************************************
+
+  ga_multistart - Concurrent multi-start local search.
+  Copyright ©2002-2009, Stewart Adcock (http://saa.dyndns.org/)
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:     Runs many independent local searches concurrently.
+
+		Any of the local search routines sharing the
+		GAlocal_search prototype, i.e. ga_sa(), ga_tabu(),
+		ga_simplex(), ga_steepestascent(),
+		ga_next_ascent_hillclimbing() and
+		ga_random_ascent_hillclimbing(), may be used.
+
+		Each search works in a fresh, private, clone of the
+		population, so that the searches never contend for the
+		population's lock and any parameters adjusted by the
+		search routine (e.g. the simplex step size) do not leak
+		between starts.  Random numbers are drawn from a
+		private stream which is reseeded at the beginning of
+		every start.  Provided that neither an evaluation
+		budget nor a target fitness are set, the outcome of
+		each start is therefore independent of the number of
+		threads and of their scheduling.
+
+		The threads share a single best-so-far solution, and
+		all of them are stopped once the total evaluation
+		budget is exhausted or the target fitness is reached.
+
+ **********************************************************************/
+
+#include "gaul/ga_multistart.h"
+
+/*
+ * Shared state for a single call to ga_multistart().
+ */
+typedef struct
+  {
+  population	*pop;			/* Master population. */
+  entity	**initial;		/* Starting solutions, or NULL. */
+  int		num_starts;		/* Total number of starts. */
+  int		max_iterations;		/* Per-start iteration limit. */
+  unsigned int	*seeds;			/* Per-start PRNG seeds. */
+  entity	*best;			/* Best-so-far, in master population. */
+  int		next_start;		/* Next unclaimed start. */
+  int		num_evaluations;	/* Total fitness evaluations performed. */
+  boolean	terminate;		/* Set to stop all searches. */
+  THREAD_LOCK_DECLARE(lock);		/* Guards all of the above. */
+  } multistart_t;
+
+/*
+ * Private state for a single search thread.
+ */
+typedef struct
+  {
+  multistart_t	*shared;		/* Shared state. */
+  population	*pop;			/* Private clone for current start. */
+  entity	*start_best;		/* Best of current start, in pop. */
+  random_state	rstate;			/* Private PRNG stream. */
+  GAevaluate	evaluate;		/* User's evaluation callback. */
+  GAiteration_hook	iteration_hook;	/* User's iteration callback. */
+#ifdef HAVE_PTHREADS
+  pthread_t	pid;
+#endif
+  } multistart_thread_t;
+
+/*
+ * The search routines only pass an entity to the iteration hook,
+ * so the current thread's state is found via thread-specific data.
+ */
+#ifdef HAVE_PTHREADS
+static pthread_key_t	multistart_key;
+static pthread_once_t	multistart_key_once = PTHREAD_ONCE_INIT;
+
+static void _multistart_key_create(void)
+  {
+  if (pthread_key_create(&multistart_key, NULL) != 0)
+    die("Unable to create thread-specific data key.");
+
+  return;
+  }
+
+#define MULTISTART_SELF()	((multistart_thread_t *) pthread_getspecific(multistart_key))
+#else
+static multistart_thread_t	*multistart_self=NULL;
+
+#define MULTISTART_SELF()	(multistart_self)
+#endif
+
+
+/**********************************************************************
+  ga_population_set_multistart_parameters()
+  synopsis:     Sets the multi-start parameters for a population.
+  parameters:	population *pop		Population.
+		GAlocal_search search	Local search routine.
+		const int num_threads	Number of concurrent searches,
+					or 0 to use GAUL_NUM_THREADS.
+		const int max_evaluations	Total budget of fitness
+					evaluations, or 0 for no limit.
+		const double target_fitness	Stop once this fitness
+					is reached, or DBL_MAX for
+					no target.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_multistart_parameters( population	*pop,
+                                      GAlocal_search	search,
+                                      const int		num_threads,
+                                      const int		max_evaluations,
+                                      const double	target_fitness)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !search ) die("Null pointer to GAlocal_search callback passed.");
+  if ( num_threads < 0 ) die("Negative number of threads requested.");
+  if ( max_evaluations < 0 ) die("Negative evaluation budget requested.");
+
+  plog( LOG_VERBOSE,
+        "Population's multi-start parameters: num_threads = %d max_evaluations = %d target_fitness = %f",
+        num_threads, max_evaluations, target_fitness );
+
+  if (pop->multistart_params == NULL)
+    {
+    if ( !(pop->multistart_params = s_malloc(sizeof(ga_multistart_t))) )
+      die("Unable to allocate memory");
+    }
+
+  pop->multistart_params->search = search;
+  pop->multistart_params->num_threads = num_threads;
+  pop->multistart_params->max_evaluations = max_evaluations;
+  pop->multistart_params->target_fitness = target_fitness;
+
+  return;
+  }
+
+
+/**********************************************************************
+  _multistart_record()
+  synopsis:	Note a freshly scored entity as a candidate for both
+		the thread's best-of-start and the shared best-so-far.
+		Raises the termination flag if the target fitness has
+		been reached.
+  parameters:	multistart_thread_t *self
+		entity *candidate	Entity in the thread's population.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void _multistart_record(multistart_thread_t *self, entity *candidate)
+  {
+  multistart_t	*shared = self->shared;
+
+  if (candidate->fitness == GA_MIN_FITNESS) return;
+
+  if (candidate->fitness > self->start_best->fitness)
+    {
+    ga_entity_blank(self->pop, self->start_best);
+    ga_entity_copy(self->pop, self->start_best, candidate);
+    }
+
+  THREAD_LOCK(shared->lock);
+  if (candidate->fitness > shared->best->fitness)
+    {
+    ga_entity_blank(shared->pop, shared->best);
+    ga_entity_copy(shared->pop, shared->best, candidate);
+
+    if (shared->best->fitness >= shared->pop->multistart_params->target_fitness)
+      shared->terminate = TRUE;
+    }
+  THREAD_UNLOCK(shared->lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  _multistart_evaluate()
+  synopsis:	Evaluation callback installed in each thread's private
+		population.  Accounts for the evaluation budget, calls
+		the user's evaluation callback and updates the best
+		solutions.  Once the searches have been told to stop,
+		no further evaluations are performed and the entity
+		is simply marked as unfit.
+  parameters:	population *pop		Thread's population.
+		entity *joe		Entity to score.
+  return:	boolean		Success.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean _multistart_evaluate(population *pop, entity *joe)
+  {
+  multistart_thread_t	*self = MULTISTART_SELF();
+  multistart_t		*shared = self->shared;
+  int			max_evaluations = shared->pop->multistart_params->max_evaluations;
+  boolean		proceed;	/* Whether budget remains. */
+  boolean		success;	/* Result from user's callback. */
+
+  THREAD_LOCK(shared->lock);
+  proceed = !shared->terminate;
+  if (proceed)
+    {
+    shared->num_evaluations++;
+    if (max_evaluations > 0 && shared->num_evaluations >= max_evaluations)
+      shared->terminate = TRUE;
+    }
+  THREAD_UNLOCK(shared->lock);
+
+  if (!proceed)
+    {
+    joe->fitness = GA_MIN_FITNESS;
+    return FALSE;
+    }
+
+  success = self->evaluate(pop, joe);
+
+  if (success)
+    _multistart_record(self, joe);
+  else
+    joe->fitness = GA_MIN_FITNESS;
+
+  return success;
+  }
+
+
+/**********************************************************************
+  _multistart_iteration_hook()
+  synopsis:	Iteration callback installed in each thread's private
+		population.  Stops the search once the termination
+		flag has been raised, and otherwise defers to the
+		user's iteration callback, if any.
+  parameters:	const int iteration
+		entity *joe
+  return:	boolean		Whether to continue.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean _multistart_iteration_hook(const int iteration, entity *joe)
+  {
+  multistart_thread_t	*self = MULTISTART_SELF();
+  boolean		terminate;
+
+  THREAD_LOCK(self->shared->lock);
+  terminate = self->shared->terminate;
+  THREAD_UNLOCK(self->shared->lock);
+
+  if (terminate) return FALSE;
+
+  return self->iteration_hook?self->iteration_hook(iteration, joe):TRUE;
+  }
+
+
+/**********************************************************************
+  _multistart_thread()
+  synopsis:	Body of each search thread.  Repeatedly claims the next
+		unstarted search, runs it in a private population and
+		returns the result to the caller's starting entity.
+  parameters:	void *data	multistart_thread_t structure.
+  return:	NULL
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void *_multistart_thread(void *data)
+  {
+  multistart_thread_t	*self = (multistart_thread_t *) data;
+  multistart_t		*shared = self->shared;
+  random_state		*old_rstate;	/* Caller's PRNG stream, if any. */
+  int			start;		/* Current start. */
+  entity		*joe;		/* Starting solution. */
+
+#ifdef HAVE_PTHREADS
+  if (pthread_setspecific(multistart_key, (void *) self) != 0)
+    die("Unable to set thread-specific data.");
+#else
+  multistart_self = self;
+#endif
+
+  old_rstate = random_get_thread_state();
+  random_set_thread_state(&(self->rstate));
+
+  while (TRUE)
+    {
+    THREAD_LOCK(shared->lock);
+    if (shared->terminate || shared->next_start >= shared->num_starts)
+      start = -1;
+    else
+      start = shared->next_start++;
+    THREAD_UNLOCK(shared->lock);
+
+    if (start < 0) break;
+
+    random_seed_state(&(self->rstate), shared->seeds[start]);
+
+    self->pop = ga_population_clone_empty(shared->pop);
+    self->pop->evaluate = _multistart_evaluate;
+    self->pop->iteration_hook = _multistart_iteration_hook;
+
+/*
+ * The starts already run concurrently, and the evaluation wrapper
+ * expects to be called from this thread, so nested parallelism
+ * within the search routine is disabled.
+ */
+    if (self->pop->simplex_params)
+      {
+      self->pop->simplex_params->num_threads = 1;
+      self->pop->simplex_params->num_simplices = 1;
+      }
+    if (self->pop->gradient_params)
+      self->pop->gradient_params->difference_threads = 1;
+
+    self->start_best = ga_get_free_entity(self->pop);
+
+    if (shared->initial && shared->initial[start])
+      {
+      joe = ga_entity_clone(self->pop, shared->initial[start]);
+      _multistart_record(self, joe);
+      }
+    else
+      {
+      joe = ga_get_free_entity(self->pop);
+      ga_entity_seed(self->pop, joe);
+      }
+
+    plog( LOG_VERBOSE, "Commencing local search %d of %d.",
+          start+1, shared->num_starts );
+
+    shared->pop->multistart_params->search(self->pop, joe, shared->max_iterations);
+
+    plog( LOG_VERBOSE, "Local search %d finished with fitness score of %f",
+          start+1, self->start_best->fitness );
+
+/*
+ * The search routines may swap their working entities, so the
+ * tracked best-of-start is returned rather than joe.
+ */
+    if ( shared->initial && shared->initial[start] &&
+         self->start_best->fitness > shared->initial[start]->fitness )
+      {
+      ga_entity_blank(shared->pop, shared->initial[start]);
+      ga_entity_copy(shared->pop, shared->initial[start], self->start_best);
+      }
+
+/*
+ * Population data is only owned by the clone if it was copied.
+ */
+    if (!shared->pop->population_data_copy) self->pop->data = NULL;
+    ga_extinction(self->pop);
+    self->pop = NULL;
+    }
+
+  random_set_thread_state(old_rstate);
+
+#ifndef HAVE_PTHREADS
+  multistart_self = NULL;
+#endif
+
+  return NULL;
+  }
+
+
+/**********************************************************************
+  ga_multistart()
+  synopsis:	Performs num_starts independent local searches, using
+		the search routine specified with
+		ga_population_set_multistart_parameters(), upto
+		num_threads of them concurrently.
+		If initial is non-NULL, it should contain num_starts
+		entities from pop, which are used as the starting
+		solutions and will be overwritten with the best
+		solution found by the corresponding search.  NULL
+		elements, or a NULL initial array, result in randomly
+		seeded starting solutions.
+		The searches are halted early if the evaluation budget
+		is exhausted or the target fitness reached.  Searches
+		which have not commenced by then are skipped.
+  parameters:	population *pop		Population.
+		entity **initial	Starting solutions, or NULL.
+		const int num_starts	Number of searches.
+		const int max_iterations	Per-search iterations.
+  return:	entity *	Best solution found, which is a new
+			entity in pop, or NULL if no evaluations
+			were performed.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC entity *ga_multistart( population	*pop,
+                                entity		**initial,
+                                const int	num_starts,
+                                const int	max_iterations )
+  {
+  multistart_t		shared;		/* Shared state. */
+  multistart_thread_t	*threads;	/* Per-thread state. */
+  int			num_threads;	/* Number of search threads. */
+  char			*num_threads_str;	/* Environment value. */
+  int			i;		/* Loop variable over starts/threads. */
+#ifdef HAVE_PTHREADS
+  int			err;		/* Error code from pthreads. */
+#endif
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->multistart_params)
+    die("ga_population_set_multistart_parameters() must be used prior to ga_multistart().");
+  if (num_starts < 1) die("At least one start is required.");
+
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_multistart");
+
+/*
+ * Determine number of threads.
+ */
+  num_threads = pop->multistart_params->num_threads;
+  if (num_threads == 0)
+    {
+    num_threads_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
+    if (num_threads_str) num_threads = atoi(num_threads_str);
+    if (num_threads <= 0) num_threads = GA_DEFAULT_NUM_THREADS;
+    }
+  if (num_threads > num_starts) num_threads = num_starts;
+#ifndef HAVE_PTHREADS
+  num_threads = 1;
+#endif
+
+  plog( LOG_VERBOSE, "Will perform %d local searches using %d threads.",
+        num_starts, num_threads );
+
+/*
+ * Prepare shared state.  The seeds are drawn here, from the
+ * caller's stream, so that each start's outcome does not depend
+ * upon which thread happens to run it.
+ */
+  shared.pop = pop;
+  shared.initial = initial;
+  shared.num_starts = num_starts;
+  shared.max_iterations = max_iterations;
+  shared.next_start = 0;
+  shared.num_evaluations = 0;
+  shared.terminate = FALSE;
+  THREAD_LOCK_NEW(shared.lock);
+
+  if ( !(shared.seeds = s_malloc(num_starts*sizeof(unsigned int))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<num_starts; i++)
+    shared.seeds[i] = random_rand();
+
+  shared.best = ga_get_free_entity(pop);
+
+/*
+ * Prepare per-thread state.
+ */
+  if ( !(threads = s_malloc(num_threads*sizeof(multistart_thread_t))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<num_threads; i++)
+    {
+    threads[i].shared = &shared;
+    threads[i].pop = NULL;
+    threads[i].start_best = NULL;
+    threads[i].evaluate = pop->evaluate;
+    threads[i].iteration_hook = pop->iteration_hook;
+    }
+
+/*
+ * Run the searches.
+ */
+#ifdef HAVE_PTHREADS
+  pthread_once(&multistart_key_once, _multistart_key_create);
+
+  for (i=0; i<num_threads; i++)
+    {
+    if ( (err = pthread_create(&(threads[i].pid), NULL, _multistart_thread, (void *)&(threads[i]))) != 0 )
+      dief("Error %d in pthread_create. (%s)", err, err==EAGAIN?"EAGAIN":err==ENOMEM?"ENOMEM":"unknown");
+    }
+
+  for (i=0; i<num_threads; i++)
+    {
+    if ( (err = pthread_join(threads[i].pid, NULL)) != 0 )
+      dief("Error %d in pthread_join. (%s)", err, err==ESRCH?"ESRCH":err==EINVAL?"EINVAL":err==EDEADLK?"EDEADLK":"unknown");
+    }
+#else
+  _multistart_thread((void *)&(threads[0]));
+#endif
+
+  plog( LOG_VERBOSE, "Local searches performed %d evaluations and found a best fitness score of %f",
+        shared.num_evaluations, shared.best->fitness );
+
+/*
+ * Cleanup.
+ */
+  s_free(threads);
+  s_free(shared.seeds);
+  THREAD_LOCK_FREE(shared.lock);
+
+  if (shared.best->fitness == GA_MIN_FITNESS)
+    {
+    ga_entity_dereference(pop, shared.best);
+    gaul_trace_end();
+    return NULL;
+    }
+
+  gaul_trace_end();
+
+  return shared.best;
+  }
+
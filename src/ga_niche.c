@@ -0,0 +1,1394 @@
+/**********************************************************************
+  ga_niche.c
+ **********************************************************************
+
+  ga_niche - Niching.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Niching by fitness sharing, clearing and restricted
+		tournament replacement, applied by the generational
+		evolution drivers just before survival.
+
+		Sharing divides each entity's fitness by the number of
+		fitter entities in its niche, weighted by distance, so
+		that truncation survival keeps a share of every niche
+		rather than dropping crowded niches whole.  Clearing
+		keeps the fitness of the best few entities of each
+		niche and drops the rest below every other entity.  In
+		both cases, the raw fitnesses are restored after
+		survival, so selection and the caller see the fitness
+		returned by the evaluation callback.  Restricted
+		tournament replacement lets each child replace the
+		most similar parent only if the child is fitter.
+
+		Neighbours are found through a spatial index which is
+		rebuilt each generation.  Double genomes compared by
+		ga_compare_double_euclidean() or
+		ga_compare_double_hamming() are placed in a k-d tree,
+		so a generation costs O(N log N) plus the number of
+		neighbours found.  Bitstring, boolean, char and integer
+		genomes compared by the built-in ga_compare_*()
+		functions are hashed into locality-sensitive buckets,
+		each keyed on a random sample of loci, and only
+		entities which share a bucket are compared.  The
+		bucket keys are chosen so that a pair of entities at
+		the niche radius shares a bucket with probability of
+		at least 1-2^-32.  Any other comparison function is
+		applied to every pair, using ga_compare_matrix().
+
+		The index draws from a private random number
+		generator, so niching doesn't disturb the random
+		number stream of the evolution.
+
+ **********************************************************************/
+
+#include "gaul/ga_core.h"
+
+/*
+ * Most entities in a leaf of the k-d tree.
+ */
+#define GA_NICHE_LEAF		8
+
+/*
+ * Locality-sensitive hash tables, and most loci per key.
+ */
+#define GA_NICHE_LSH_TABLES	32
+#define GA_NICHE_LSH_KEYS	32
+
+/*
+ * Parents compared with a child, when restricted tournament
+ * replacement finds no parent in the child's buckets.
+ */
+#define GA_NICHE_RTR_WINDOW	20
+
+/*
+ * Kinds of spatial index.
+ */
+#define GAUL_NICHE_MATRIX	0
+#define GAUL_NICHE_KDTREE	1
+#define GAUL_NICHE_LSH		2
+
+/*
+ * An entry of a hash table.
+ */
+typedef struct
+  {
+  unsigned int	hash;		/* Key. */
+  int		rank;		/* Entity. */
+  } gaul_niche_bucket_t;
+
+/*
+ * A spatial index over some of the entities of a population, by rank.
+ */
+typedef struct
+  {
+  population	*pop;		/* Population indexed. */
+  GAcompare	compare;	/* Comparison function. */
+  int		kind;		/* Kind of index. */
+  int		num_members;	/* Entities indexed. */
+  int		*member;	/* Their ranks; in tree order for a k-d tree. */
+
+/* k-d tree: */
+  boolean	manhattan;	/* Manhattan, rather than Euclidean, distance. */
+  int		num_dims;	/* Alleles per genome. */
+  double	*points;	/* Genomes of every entity, by rank. */
+  int		*split;		/* Splitting dimension of each node. */
+
+/* Locality-sensitive hashing: */
+  int		num_keys;	/* Loci per key. */
+  int		*loci;		/* Loci of each table's key. */
+  unsigned int	*hash;		/* Key of every entity in each table, by rank. */
+  gaul_niche_bucket_t	*table;	/* Sorted entries of each table. */
+  int		*stamp;		/* Last query to see each entity. */
+  int		query;		/* Current query. */
+  gaul_compare_t	packed;		/* Packed genomes, to compare candidates. */
+
+/* Fallback: */
+  double	*matrix;	/* Distances between every pair. */
+  } gaul_niche_index_t;
+
+/*
+ * Visit one neighbour found by a range query.
+ */
+typedef void (*gaul_niche_visitor)(void *data, const int rank, const double distance);
+
+/**********************************************************************
+  gaul_niche_random()
+  synopsis:	Private xorshift random number generator.
+  parameters:	ga_niche_t *niche
+  return:	Pseudo-random number.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static unsigned int gaul_niche_random(ga_niche_t *niche)
+  {
+  unsigned int	x=niche->rng;
+
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+
+  return niche->rng = x;
+  }
+
+
+/**********************************************************************
+  ga_population_set_niching_parameters()
+  synopsis:	Sets the niching mode of a population, which is
+		applied by ga_evolution() and the other generational
+		drivers just before survival.
+		GA_NICHE_SHARING divides the fitness of each entity by
+		its niche count, the sum of 1-(d/radius)^alpha over
+		itself and every fitter entity within the radius.
+		Negative fitnesses are multiplied by the niche count
+		instead.
+		GA_NICHE_CLEARING keeps the fitness of the best
+		capacity entities within the radius of each niche's
+		best entity, and drops the others below every other
+		entity.
+		GA_NICHE_RTR lets each child replace the most similar
+		parent if the child is fitter, and discards it
+		otherwise.  It requires GA_ELITISM_PARENTS_SURVIVE or
+		GA_ELITISM_RESCORE_PARENTS.
+		GA_NICHE_NONE turns niching off.
+  parameters:	population *pop
+		const ga_niche_type type	Niching mode.
+		const GAcompare compare		Distance between entities.
+		const double radius		Niche radius, in units of
+						compare.
+		const double alpha		Shape of sharing function.
+		const int capacity		Winners per niche, for
+						clearing.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_niching_parameters( population *pop,
+                                        const ga_niche_type	type,
+                                        const GAcompare		compare,
+                                        const double		radius,
+                                        const double		alpha,
+                                        const int		capacity )
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  if (type == GA_NICHE_NONE)
+    {
+    gaul_niche_free(pop);
+    return;
+    }
+
+  if ( type != GA_NICHE_SHARING && type != GA_NICHE_CLEARING && type != GA_NICHE_RTR )
+    die("Unknown niching mode.");
+  if ( !compare ) die("Null pointer to GAcompare callback passed.");
+  if ( type != GA_NICHE_RTR && radius <= 0.0 ) die("Niche radius must be positive.");
+  if ( type == GA_NICHE_SHARING && alpha <= 0.0 ) die("Sharing function shape must be positive.");
+  if ( type == GA_NICHE_CLEARING && capacity < 1 ) die("Niche capacity must be positive.");
+
+  plog( LOG_VERBOSE, "Population's niching parameters set" );
+
+  if (pop->niche_params == NULL)
+    {
+    if ( !(pop->niche_params = s_malloc(sizeof(ga_niche_t))) )
+      die("Unable to allocate memory");
+    pop->niche_params->num_raw = 0;
+    pop->niche_params->raw = NULL;
+    pop->niche_params->rng = 2463534242U;
+    }
+
+  pop->niche_params->type = type;
+  pop->niche_params->compare = compare;
+  pop->niche_params->radius = radius;
+  pop->niche_params->alpha = alpha;
+  pop->niche_params->capacity = capacity;
+  pop->niche_params->num_niches = -1;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_get_niches()
+  synopsis:	Number of niches found in the latest generation: the
+		entities with no fitter entity within the radius when
+		sharing, or the entities which kept their fitness
+		without a fitter entity nearby when clearing.
+  parameters:	population *pop
+  return:	Number of niches, or -1 if unknown.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_population_get_niches( population *pop )
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return pop->niche_params ? pop->niche_params->num_niches : -1;
+  }
+
+
+/**********************************************************************
+  gaul_niche_select()
+  synopsis:	Partially sort members of a k-d tree node, so that
+		the one at position mid has the median coordinate in
+		dimension dim, with none larger before it and none
+		smaller after it.
+  parameters:	gaul_niche_index_t *index
+		int lo, int hi		Range of positions.
+		const int mid		Position of median.
+		const int dim		Dimension.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_select( gaul_niche_index_t *index,
+                               int lo, int hi, const int mid, const int dim )
+  {
+  int		*m=index->member;	/* Members. */
+  double	pivot;			/* Pivot coordinate. */
+  int		i, j, swap;		/* Partition. */
+
+  hi--;
+  while (lo < hi)
+    {
+    pivot = index->points[(size_t) m[(lo+hi)/2]*index->num_dims+dim];
+    i = lo;
+    j = hi;
+    while (i <= j)
+      {
+      while (index->points[(size_t) m[i]*index->num_dims+dim] < pivot) i++;
+      while (index->points[(size_t) m[j]*index->num_dims+dim] > pivot) j--;
+      if (i <= j)
+        {
+        swap = m[i]; m[i] = m[j]; m[j] = swap;
+        i++;
+        j--;
+        }
+      }
+    if (mid <= j) hi = j;
+    else if (mid >= i) lo = i;
+    else break;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_kd_build()
+  synopsis:	Build a k-d tree node, splitting on the dimension of
+		greatest spread at the median.
+  parameters:	gaul_niche_index_t *index
+		const int lo, const int hi	Range of positions.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_kd_build(gaul_niche_index_t *index, const int lo, const int hi)
+  {
+  double	x, low, high;		/* Coordinate and its range. */
+  double	spread=-1.0;		/* Greatest spread. */
+  int		mid=(lo+hi)/2;		/* Position of median. */
+  int		i, d;			/* Loop over members, dimensions. */
+
+  if (hi-lo <= GA_NICHE_LEAF) return;
+
+  index->split[mid] = 0;
+  for (d=0; d<index->num_dims; d++)
+    {
+    low = high = index->points[(size_t) index->member[lo]*index->num_dims+d];
+    for (i=lo+1; i<hi; i++)
+      {
+      x = index->points[(size_t) index->member[i]*index->num_dims+d];
+      if (x < low) low = x;
+      if (x > high) high = x;
+      }
+    if (high-low > spread)
+      {
+      spread = high-low;
+      index->split[mid] = d;
+      }
+    }
+
+  gaul_niche_select(index, lo, hi, mid, index->split[mid]);
+
+  gaul_niche_kd_build(index, lo, mid);
+  gaul_niche_kd_build(index, mid+1, hi);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_kd_distance()
+  synopsis:	Distance between two entities in a k-d tree, as
+		ga_compare_double_euclidean() or
+		ga_compare_double_hamming() would find it.
+  parameters:	const gaul_niche_index_t *index
+		const int a, const int b	Ranks of entities.
+  return:	Distance.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static double gaul_niche_kd_distance(const gaul_niche_index_t *index, const int a, const int b)
+  {
+  const double	*x=index->points+(size_t) a*index->num_dims;
+  const double	*y=index->points+(size_t) b*index->num_dims;
+  double	sum=0.0;	/* Distance. */
+  int		d;		/* Loop over dimensions. */
+
+  if (index->manhattan)
+    {
+    for (d=0; d<index->num_dims; d++)
+      sum += fabs(x[d]-y[d]);
+    return sum;
+    }
+
+  for (d=0; d<index->num_dims; d++)
+    sum += SQU(x[d]-y[d]);
+
+  return sqrt(sum);
+  }
+
+
+/**********************************************************************
+  gaul_niche_kd_range()
+  synopsis:	Visit every member of a k-d tree node within a radius
+		of an entity.
+  parameters:	const gaul_niche_index_t *index
+		const int rank		Entity queried.
+		const double radius
+		const int lo, const int hi	Range of positions.
+		gaul_niche_visitor visit
+		void *data		Passed to visit.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_kd_range( const gaul_niche_index_t *index,
+                                 const int rank, const double radius,
+                                 const int lo, const int hi,
+                                 gaul_niche_visitor visit, void *data )
+  {
+  int		mid=(lo+hi)/2;		/* Position of median. */
+  double	distance;		/* Distance to member. */
+  double	offset;			/* Distance from splitting plane. */
+  int		i;			/* Loop over leaf. */
+
+  if (hi-lo <= GA_NICHE_LEAF)
+    {
+    for (i=lo; i<hi; i++)
+      {
+      distance = gaul_niche_kd_distance(index, rank, index->member[i]);
+      if (distance < radius) visit(data, index->member[i], distance);
+      }
+    return;
+    }
+
+  distance = gaul_niche_kd_distance(index, rank, index->member[mid]);
+  if (distance < radius) visit(data, index->member[mid], distance);
+
+  offset = index->points[(size_t) rank*index->num_dims+index->split[mid]]
+         - index->points[(size_t) index->member[mid]*index->num_dims+index->split[mid]];
+
+  if (offset < radius)
+    gaul_niche_kd_range(index, rank, radius, lo, mid, visit, data);
+  if (-offset < radius)
+    gaul_niche_kd_range(index, rank, radius, mid+1, hi, visit, data);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_kd_nearest()
+  synopsis:	Find the nearest member of a k-d tree node to an
+		entity, if nearer than the best so far.  Ties go to
+		the lower rank.
+  parameters:	const gaul_niche_index_t *index
+		const int rank		Entity queried.
+		const int lo, const int hi	Range of positions.
+		int *best		Nearest member so far.
+		double *best_distance	Its distance.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_kd_nearest( const gaul_niche_index_t *index,
+                                   const int rank, const int lo, const int hi,
+                                   int *best, double *best_distance )
+  {
+  int		mid=(lo+hi)/2;		/* Position of median. */
+  double	distance;		/* Distance to member. */
+  double	offset;			/* Distance from splitting plane. */
+  int		i;			/* Loop over leaf. */
+
+  if (hi-lo <= GA_NICHE_LEAF)
+    {
+    for (i=lo; i<hi; i++)
+      {
+      distance = gaul_niche_kd_distance(index, rank, index->member[i]);
+      if ( distance < *best_distance ||
+           (distance == *best_distance && index->member[i] < *best) )
+        {
+        *best = index->member[i];
+        *best_distance = distance;
+        }
+      }
+    return;
+    }
+
+  distance = gaul_niche_kd_distance(index, rank, index->member[mid]);
+  if ( distance < *best_distance ||
+       (distance == *best_distance && index->member[mid] < *best) )
+    {
+    *best = index->member[mid];
+    *best_distance = distance;
+    }
+
+  offset = index->points[(size_t) rank*index->num_dims+index->split[mid]]
+         - index->points[(size_t) index->member[mid]*index->num_dims+index->split[mid]];
+
+  if (offset <= 0.0)
+    {
+    gaul_niche_kd_nearest(index, rank, lo, mid, best, best_distance);
+    if (-offset <= *best_distance)
+      gaul_niche_kd_nearest(index, rank, mid+1, hi, best, best_distance);
+    }
+  else
+    {
+    gaul_niche_kd_nearest(index, rank, mid+1, hi, best, best_distance);
+    if (offset <= *best_distance)
+      gaul_niche_kd_nearest(index, rank, lo, mid, best, best_distance);
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_allele()
+  synopsis:	Value of an allele of a bitstring, boolean, char or
+		integer genome.
+  parameters:	population *pop
+		GAcompare compare	Identifies the genome type.
+		entity *this_entity
+		const int locus
+  return:	Allele.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static unsigned int gaul_niche_allele( population *pop, GAcompare compare,
+                                       entity *this_entity, const int locus )
+  {
+  vpointer	chromosome=this_entity->chromosome[locus/pop->len_chromosomes];
+  int		allele=locus%pop->len_chromosomes;
+
+  if (compare == ga_compare_bitstring_hamming || compare == ga_compare_bitstring_euclidean)
+    return ga_bit_get((gaulbyte *) chromosome, allele);
+  if (compare == ga_compare_boolean_hamming || compare == ga_compare_boolean_euclidean)
+    return ((boolean *) chromosome)[allele] ? 1 : 0;
+  if (compare == ga_compare_char_hamming || compare == ga_compare_char_euclidean)
+    return (unsigned char) ((char *) chromosome)[allele];
+
+  return (unsigned int) ((int *) chromosome)[allele];
+  }
+
+
+/**********************************************************************
+  gaul_niche_lsh_distance()
+  synopsis:	Distance between two entities in the hash tables,
+		using their packed genomes.
+  parameters:	const gaul_niche_index_t *index
+		const int a, const int b	Ranks of entities.
+  return:	Distance.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static double gaul_niche_lsh_distance(const gaul_niche_index_t *index, const int a, const int b)
+  {
+  double	distance;	/* Distance. */
+
+  gaul_compare_tile(&index->packed, &a, 1, b, b+1, &distance, 1);
+
+  return distance;
+  }
+
+
+/**********************************************************************
+  gaul_niche_bucket_compare()
+  synopsis:	Order of hash table entries.
+  parameters:
+  return:
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_niche_bucket_compare(const void *a, const void *b)
+  {
+  const gaul_niche_bucket_t	*x=a, *y=b;
+
+  if (x->hash != y->hash) return x->hash < y->hash ? -1 : 1;
+
+  return x->rank - y->rank;
+  }
+
+
+/**********************************************************************
+  gaul_niche_lsh_candidates()
+  synopsis:	Visit every member of the hash tables which shares a
+		bucket with an entity, once each, with its distance.
+  parameters:	gaul_niche_index_t *index
+		const int rank		Entity queried.
+		gaul_niche_visitor visit
+		void *data		Passed to visit.
+  return:	Number of members visited.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_niche_lsh_candidates( gaul_niche_index_t *index, const int rank,
+                                      gaul_niche_visitor visit, void *data )
+  {
+  gaul_niche_bucket_t	*table;		/* Current table. */
+  unsigned int		hash;		/* Key of entity. */
+  int			lo, hi, mid;	/* Binary search. */
+  int			t;		/* Loop over tables. */
+  int			num=0;		/* Members visited. */
+
+  index->query++;
+
+  for (t=0; t<GA_NICHE_LSH_TABLES; t++)
+    {
+    table = index->table + (size_t) t*index->num_members;
+    hash = index->hash[(size_t) rank*GA_NICHE_LSH_TABLES+t];
+
+    lo = 0;
+    hi = index->num_members;
+    while (lo < hi)
+      {
+      mid = (lo+hi)/2;
+      if (table[mid].hash < hash) lo = mid+1;
+      else hi = mid;
+      }
+
+    for (; lo<index->num_members && table[lo].hash == hash; lo++)
+      {
+      if (index->stamp[table[lo].rank] == index->query) continue;
+      index->stamp[table[lo].rank] = index->query;
+      num++;
+      visit(data, table[lo].rank, gaul_niche_lsh_distance(index, rank, table[lo].rank));
+      }
+    }
+
+  return num;
+  }
+
+
+/**********************************************************************
+  gaul_niche_index_build()
+  synopsis:	Build a spatial index over a range of ranks.
+  parameters:	population *pop
+		gaul_niche_index_t *index	Returns the index.
+		const int num_members		Ranks 0 to num_members-1
+						are indexed.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_index_build( population *pop, gaul_niche_index_t *index,
+                                    const int num_members )
+  {
+  ga_niche_t	*niche=pop->niche_params;	/* Niching parameters. */
+  GAcompare	compare=niche->compare;		/* Comparison function. */
+  double	radius;				/* Radius, in differing loci. */
+  double	p;				/* Chance of a locus matching. */
+  int		length;				/* Loci per genome. */
+  unsigned int	hash;				/* Key. */
+  int		i, j, t;			/* Loop over entities, chromosomes/loci, tables. */
+
+  memset(index, 0, sizeof(gaul_niche_index_t));
+  index->pop = pop;
+  index->compare = compare;
+  index->num_members = num_members;
+
+  if ( !(index->member = s_malloc(MAX(num_members, 1)*sizeof(int))) )
+    die("Unable to allocate memory");
+  for (i=0; i<num_members; i++)
+    index->member[i] = i;
+
+  length = pop->num_chromosomes*pop->len_chromosomes;
+
+  if (compare == ga_compare_double_euclidean || compare == ga_compare_double_hamming)
+    {
+    index->kind = GAUL_NICHE_KDTREE;
+    index->manhattan = compare == ga_compare_double_hamming;
+    index->num_dims = length;
+
+    if ( !(index->points = s_malloc((size_t) pop->size*length*sizeof(double))) ||
+         !(index->split = s_malloc(MAX(num_members, 1)*sizeof(int))) )
+      die("Unable to allocate memory");
+
+    for (i=0; i<pop->size; i++)
+      for (j=0; j<pop->num_chromosomes; j++)
+        memcpy( index->points+(size_t) i*length+j*pop->len_chromosomes,
+                pop->entity_iarray[i]->chromosome[j],
+                pop->len_chromosomes*sizeof(double) );
+
+    gaul_niche_kd_build(index, 0, num_members);
+    }
+  else if ( compare == ga_compare_bitstring_hamming || compare == ga_compare_bitstring_euclidean ||
+            compare == ga_compare_boolean_hamming || compare == ga_compare_boolean_euclidean ||
+            compare == ga_compare_char_hamming || compare == ga_compare_char_euclidean ||
+            compare == ga_compare_integer_hamming || compare == ga_compare_integer_euclidean )
+    {
+    index->kind = GAUL_NICHE_LSH;
+
+/*
+ * Entities within the radius differ at no more than radius loci, or
+ * radius^2 loci for Euclidean distances.  Each key samples enough loci
+ * that such a pair shares it with probability of at least one half.
+ * Restricted tournament replacement has no radius, so keys separate
+ * random genomes instead.
+ */
+    if (niche->type == GA_NICHE_RTR)
+      {
+      index->num_keys = 1;
+      while ((1 << index->num_keys) < num_members) index->num_keys++;
+      }
+    else
+      {
+      radius = compare == ga_compare_bitstring_hamming || compare == ga_compare_boolean_hamming ||
+               compare == ga_compare_char_hamming || compare == ga_compare_integer_hamming ?
+               niche->radius : niche->radius*niche->radius;
+      p = 1.0 - ceil(radius-1.0)/length;
+      if (p >= 1.0)
+        index->num_keys = GA_NICHE_LSH_KEYS;
+      else if (p <= 0.0)
+        index->num_keys = 1;
+      else
+        index->num_keys = MAX(1, (int) (log(0.5)/log(p)));
+      }
+    index->num_keys = MIN(MIN(index->num_keys, GA_NICHE_LSH_KEYS), length);
+
+    if ( !(index->loci = s_malloc(GA_NICHE_LSH_TABLES*index->num_keys*sizeof(int))) ||
+         !(index->hash = s_malloc((size_t) pop->size*GA_NICHE_LSH_TABLES*sizeof(unsigned int))) ||
+         !(index->table = s_malloc((size_t) MAX(num_members, 1)*GA_NICHE_LSH_TABLES*sizeof(gaul_niche_bucket_t))) ||
+         !(index->stamp = s_malloc(pop->size*sizeof(int))) )
+      die("Unable to allocate memory");
+
+    gaul_compare_pack(pop, compare, &index->packed);
+
+    for (j=0; j<GA_NICHE_LSH_TABLES*index->num_keys; j++)
+      index->loci[j] = gaul_niche_random(niche)%length;
+
+    for (i=0; i<pop->size; i++)
+      {
+      index->stamp[i] = 0;
+      for (t=0; t<GA_NICHE_LSH_TABLES; t++)
+        {
+        hash = 2166136261U;
+        for (j=0; j<index->num_keys; j++)
+          hash = (hash ^ gaul_niche_allele( pop, compare, pop->entity_iarray[i],
+                                            index->loci[t*index->num_keys+j] )) * 16777619U;
+        index->hash[(size_t) i*GA_NICHE_LSH_TABLES+t] = hash;
+        }
+      }
+
+    for (t=0; t<GA_NICHE_LSH_TABLES; t++)
+      {
+      for (i=0; i<num_members; i++)
+        {
+        index->table[(size_t) t*num_members+i].hash = index->hash[(size_t) i*GA_NICHE_LSH_TABLES+t];
+        index->table[(size_t) t*num_members+i].rank = i;
+        }
+      qsort( index->table+(size_t) t*num_members, num_members,
+             sizeof(gaul_niche_bucket_t), gaul_niche_bucket_compare );
+      }
+    }
+  else
+    {
+    index->kind = GAUL_NICHE_MATRIX;
+
+    if ( !(index->matrix = s_malloc((size_t) pop->size*pop->size*sizeof(double))) )
+      die("Unable to allocate memory");
+
+    ga_compare_matrix(pop, compare, index->matrix);
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_index_free()
+  synopsis:	Free a spatial index.
+  parameters:	gaul_niche_index_t *index
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_index_free(gaul_niche_index_t *index)
+  {
+
+  if (index->member) s_free(index->member);
+  if (index->points) s_free(index->points);
+  if (index->split) s_free(index->split);
+  if (index->loci) s_free(index->loci);
+  if (index->hash) s_free(index->hash);
+  if (index->table) s_free(index->table);
+  if (index->stamp) s_free(index->stamp);
+  if (index->matrix) s_free(index->matrix);
+  if (index->packed.rows) s_free(index->packed.rows);
+
+  return;
+  }
+
+
+/*
+ * A range query over locality-sensitive buckets visits candidates
+ * which are then filtered by distance.
+ */
+typedef struct
+  {
+  double		radius;		/* Radius of query. */
+  gaul_niche_visitor	visit;		/* Visitor of neighbours. */
+  void			*data;		/* Passed to visitor. */
+  } gaul_niche_filter_t;
+
+static void gaul_niche_filter(void *data, const int rank, const double distance)
+  {
+  gaul_niche_filter_t	*filter=data;
+
+  if (distance < filter->radius) filter->visit(filter->data, rank, distance);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_index_range()
+  synopsis:	Visit every indexed entity within a radius of an
+		entity, including the entity itself if it is indexed.
+  parameters:	gaul_niche_index_t *index
+		const int rank		Entity queried.
+		const double radius
+		gaul_niche_visitor visit
+		void *data		Passed to visit.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_index_range( gaul_niche_index_t *index,
+                                    const int rank, const double radius,
+                                    gaul_niche_visitor visit, void *data )
+  {
+  gaul_niche_filter_t	filter;		/* Filter of candidates. */
+  double		distance;	/* Distance to member. */
+  int			i;		/* Loop over members. */
+
+  switch (index->kind)
+    {
+    case GAUL_NICHE_KDTREE:
+      gaul_niche_kd_range(index, rank, radius, 0, index->num_members, visit, data);
+      break;
+
+    case GAUL_NICHE_LSH:
+      filter.radius = radius;
+      filter.visit = visit;
+      filter.data = data;
+      gaul_niche_lsh_candidates(index, rank, gaul_niche_filter, &filter);
+      break;
+
+    default:
+      for (i=0; i<index->num_members; i++)
+        {
+        distance = index->matrix[(size_t) rank*index->pop->size+i];
+        if (distance < radius) visit(data, i, distance);
+        }
+    }
+
+  return;
+  }
+
+
+/*
+ * A nearest-neighbour query over locality-sensitive buckets keeps the
+ * nearest candidate.
+ */
+typedef struct
+  {
+  int		best;		/* Nearest member so far. */
+  double	distance;	/* Its distance. */
+  } gaul_niche_nearest_t;
+
+static void gaul_niche_nearer(void *data, const int rank, const double distance)
+  {
+  gaul_niche_nearest_t	*nearest=data;
+
+  if ( distance < nearest->distance ||
+       (distance == nearest->distance && rank < nearest->best) )
+    {
+    nearest->best = rank;
+    nearest->distance = distance;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_index_nearest()
+  synopsis:	Find the nearest indexed entity to an entity which is
+		not indexed.  When locality-sensitive buckets hold no
+		candidate, the nearest of a random window of indexed
+		entities is taken, as in the original restricted
+		tournament replacement.
+  parameters:	gaul_niche_index_t *index
+		const int rank		Entity queried.
+  return:	Rank of the nearest indexed entity.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_niche_index_nearest(gaul_niche_index_t *index, const int rank)
+  {
+  gaul_niche_nearest_t	nearest;	/* Nearest member. */
+  int			i, j;		/* Loop over members. */
+
+  nearest.best = -1;
+  nearest.distance = DBL_MAX;
+
+  switch (index->kind)
+    {
+    case GAUL_NICHE_KDTREE:
+      gaul_niche_kd_nearest(index, rank, 0, index->num_members, &nearest.best, &nearest.distance);
+      break;
+
+    case GAUL_NICHE_LSH:
+      if (gaul_niche_lsh_candidates(index, rank, gaul_niche_nearer, &nearest) == 0)
+        {
+        for (i=0; i<MIN(GA_NICHE_RTR_WINDOW, index->num_members); i++)
+          {
+          j = gaul_niche_random(index->pop->niche_params)%index->num_members;
+          gaul_niche_nearer(&nearest, j, gaul_niche_lsh_distance(index, rank, j));
+          }
+        }
+      break;
+
+    default:
+      for (i=0; i<index->num_members; i++)
+        gaul_niche_nearer(&nearest, i, index->matrix[(size_t) rank*index->pop->size+i]);
+    }
+
+  return nearest.best;
+  }
+
+
+/*
+ * Fitness sharing accumulates the niche count of an entity over itself
+ * and the fitter entities in its niche, ties going to the lower rank.  The count is held in
+ * fixed point, so that it doesn't depend on the order in which the
+ * index finds neighbours.
+ */
+#define GA_NICHE_SHARE_ONE	4294967296.0
+
+typedef struct
+  {
+  population	*pop;		/* Population. */
+  int		rank;		/* Entity. */
+  double	radius;		/* Niche radius. */
+  double	alpha;		/* Shape of sharing function. */
+  unsigned long long	count;	/* Niche count, in units of 1/GA_NICHE_SHARE_ONE. */
+  boolean	peak;		/* Whether no fitter entity is in the niche. */
+  } gaul_niche_share_t;
+
+static void gaul_niche_share(void *data, const int rank, const double distance)
+  {
+  gaul_niche_share_t	*share=data;
+  entity		*neighbour=share->pop->entity_iarray[rank];
+  entity		*this_entity=share->pop->entity_iarray[share->rank];
+
+  if (neighbour->fitness == GA_MIN_FITNESS) return;
+
+  if ( neighbour->fitness > this_entity->fitness ||
+       (neighbour->fitness == this_entity->fitness && rank < share->rank) )
+    share->peak = FALSE;
+  else if (rank != share->rank)
+    return;
+
+  share->count += (unsigned long long) ((1.0 - pow(distance/share->radius, share->alpha))*GA_NICHE_SHARE_ONE + 0.5);
+
+  return;
+  }
+
+
+/*
+ * Clearing collects the entities in a niche which haven't yet been
+ * considered.
+ */
+typedef struct
+  {
+  int		center;		/* Best entity of niche. */
+  const int	*order;		/* Position of each entity in fitness order. */
+  const boolean	*cleared;	/* Whether each entity has been cleared. */
+  int		*found;		/* Entities found. */
+  int		num_found;	/* Number found. */
+  } gaul_niche_clear_t;
+
+static void gaul_niche_clear(void *data, const int rank, const double distance)
+  {
+  gaul_niche_clear_t	*clear=data;
+
+  if ( clear->order[rank] > clear->order[clear->center] && !clear->cleared[rank] )
+    clear->found[clear->num_found++] = clear->order[rank];
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_int_compare()
+  synopsis:	Ascending order of integers.
+  parameters:
+  return:
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_niche_int_compare(const void *a, const void *b)
+  {
+  return *((const int *) a) - *((const int *) b);
+  }
+
+
+/**********************************************************************
+  gaul_niche_fitness_compare()
+  synopsis:	Descending order of ranks by fitness, then ascending
+		rank.  Uses the population being ordered.
+  parameters:
+  return:
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static population *gaul_niche_sort_pop=NULL;
+
+static int gaul_niche_fitness_compare(const void *a, const void *b)
+  {
+  int		x=*((const int *) a), y=*((const int *) b);
+  double	fx=gaul_niche_sort_pop->entity_iarray[x]->fitness;
+  double	fy=gaul_niche_sort_pop->entity_iarray[y]->fitness;
+
+  if (fx != fy) return fx > fy ? -1 : 1;
+
+  return x - y;
+  }
+
+
+/**********************************************************************
+  gaul_niche_entity_compare()
+  synopsis:	Order of raw fitnesses by entity address.
+  parameters:
+  return:
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_niche_entity_compare(const void *a, const void *b)
+  {
+  const ga_niche_fitness_t	*x=a, *y=b;
+
+  if (x->entity == y->entity) return 0;
+
+  return (char *) x->entity < (char *) y->entity ? -1 : 1;
+  }
+
+
+/**********************************************************************
+  gaul_niche_save()
+  synopsis:	Keep the raw fitness of every entity, to be restored
+		after survival.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_save(population *pop)
+  {
+  ga_niche_t	*niche=pop->niche_params;	/* Niching parameters. */
+  int		i;				/* Loop over entities. */
+
+  if ( !(niche->raw = s_realloc(niche->raw, MAX(pop->size, 1)*sizeof(ga_niche_fitness_t))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<pop->size; i++)
+    {
+    niche->raw[i].entity = pop->entity_iarray[i];
+    niche->raw[i].fitness = pop->entity_iarray[i]->fitness;
+    }
+  niche->num_raw = pop->size;
+
+  qsort(niche->raw, niche->num_raw, sizeof(ga_niche_fitness_t), gaul_niche_entity_compare);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_sharing()
+  synopsis:	Fitness sharing.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_sharing(population *pop)
+  {
+  ga_niche_t		*niche=pop->niche_params;	/* Niching parameters. */
+  gaul_niche_index_t	index;				/* Spatial index. */
+  gaul_niche_share_t	share;				/* Niche count. */
+  double		count;				/* Niche count. */
+  double		*shared;			/* Shared fitnesses. */
+  int			i;				/* Loop over entities. */
+
+  gaul_niche_index_build(pop, &index, pop->size);
+
+  if ( !(shared = s_malloc(pop->size*sizeof(double))) )
+    die("Unable to allocate memory");
+
+  niche->num_niches = 0;
+
+  for (i=0; i<pop->size; i++)
+    {
+    shared[i] = pop->entity_iarray[i]->fitness;
+    if (shared[i] == GA_MIN_FITNESS) continue;
+
+    share.pop = pop;
+    share.rank = i;
+    share.radius = niche->radius;
+    share.alpha = niche->alpha;
+    share.count = 0;
+    share.peak = TRUE;
+    gaul_niche_index_range(&index, i, niche->radius, gaul_niche_share, &share);
+
+/* An entity always lies in its own niche. */
+    count = MAX(share.count/GA_NICHE_SHARE_ONE, 1.0);
+
+    shared[i] = shared[i] >= 0.0 ? shared[i]/count : shared[i]*count;
+    if (share.peak) niche->num_niches++;
+    }
+
+  gaul_niche_save(pop);
+
+  for (i=0; i<pop->size; i++)
+    pop->entity_iarray[i]->fitness = shared[i];
+
+  gaul_stats_invalidate(pop);
+
+  s_free(shared);
+  gaul_niche_index_free(&index);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_clearing()
+  synopsis:	Clearing.  Entities are taken in order of fitness.
+		Each which hasn't been cleared is the best of a niche,
+		and keeps its fitness along with the next best
+		capacity-1 entities within the radius; the rest of the
+		niche is cleared.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_clearing(population *pop)
+  {
+  ga_niche_t		*niche=pop->niche_params;	/* Niching parameters. */
+  gaul_niche_index_t	index;				/* Spatial index. */
+  gaul_niche_clear_t	clear;				/* Niche members. */
+  int			*sorted;			/* Ranks in fitness order. */
+  int			*order;				/* Position of each rank in sorted. */
+  boolean		*cleared;			/* Whether each entity is cleared. */
+  boolean		*kept;				/* Whether each entity won a fitter niche. */
+  double		lowest;				/* Fitness of cleared entities. */
+  int			winners;			/* Entities keeping fitness in niche. */
+  int			i, j;				/* Loop over entities. */
+
+  gaul_niche_index_build(pop, &index, pop->size);
+
+  if ( !(sorted = s_malloc(pop->size*sizeof(int))) ||
+       !(order = s_malloc(pop->size*sizeof(int))) ||
+       !(cleared = s_malloc(pop->size*sizeof(boolean))) ||
+       !(kept = s_malloc(pop->size*sizeof(boolean))) ||
+       !(clear.found = s_malloc(pop->size*sizeof(int))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<pop->size; i++)
+    {
+    sorted[i] = i;
+    cleared[i] = pop->entity_iarray[i]->fitness == GA_MIN_FITNESS;
+    kept[i] = FALSE;
+    }
+
+  gaul_niche_sort_pop = pop;
+  qsort(sorted, pop->size, sizeof(int), gaul_niche_fitness_compare);
+
+  lowest = 0.0;
+  for (i=0; i<pop->size; i++)
+    {
+    order[sorted[i]] = i;
+    if (!cleared[sorted[i]]) lowest = pop->entity_iarray[sorted[i]]->fitness - 1.0;
+    }
+
+  clear.order = order;
+  clear.cleared = cleared;
+  niche->num_niches = 0;
+
+  for (i=0; i<pop->size; i++)
+    {
+    if (cleared[sorted[i]]) continue;
+
+    if (!kept[sorted[i]]) niche->num_niches++;
+    clear.center = sorted[i];
+    clear.num_found = 0;
+    gaul_niche_index_range(&index, sorted[i], niche->radius, gaul_niche_clear, &clear);
+
+    qsort(clear.found, clear.num_found, sizeof(int), gaul_niche_int_compare);
+
+    winners = 1;
+    for (j=0; j<clear.num_found; j++)
+      {
+      if (winners < niche->capacity)
+        {
+        winners++;
+        kept[sorted[clear.found[j]]] = TRUE;
+        }
+      else
+        cleared[sorted[clear.found[j]]] = TRUE;
+      }
+    }
+
+  gaul_niche_save(pop);
+
+  for (i=0; i<pop->size; i++)
+    if (cleared[i] && pop->entity_iarray[i]->fitness != GA_MIN_FITNESS)
+      pop->entity_iarray[i]->fitness = lowest;
+
+  gaul_stats_invalidate(pop);
+
+  s_free(sorted);
+  s_free(order);
+  s_free(cleared);
+  s_free(kept);
+  s_free(clear.found);
+  gaul_niche_index_free(&index);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_rtr()
+  synopsis:	Restricted tournament replacement.  Each child, in
+		turn, is compared with the current occupant of the
+		slot of its most similar parent, and replaces it if
+		fitter.  Children which don't replace an occupant are
+		discarded.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_niche_rtr(population *pop)
+  {
+  gaul_niche_index_t	index;		/* Spatial index over parents. */
+  entity		**occupant;	/* Occupant of each parent's slot. */
+  entity		**losers;	/* Entities to discard. */
+  int			num_losers=0;	/* Number to discard. */
+  int			slot;		/* Nearest parent. */
+  int			i;		/* Loop over children. */
+
+  if (pop->elitism != GA_ELITISM_PARENTS_SURVIVE && pop->elitism != GA_ELITISM_RESCORE_PARENTS)
+    die("Restricted tournament replacement requires GA_ELITISM_PARENTS_SURVIVE or GA_ELITISM_RESCORE_PARENTS.");
+
+  if (pop->orig_size < 1 || pop->size <= pop->orig_size) return;
+
+  gaul_niche_index_build(pop, &index, pop->orig_size);
+
+  if ( !(occupant = s_malloc(pop->orig_size*sizeof(entity *))) ||
+       !(losers = s_malloc((pop->size-pop->orig_size)*sizeof(entity *))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<pop->orig_size; i++)
+    occupant[i] = pop->entity_iarray[i];
+
+  for (i=pop->orig_size; i<pop->size; i++)
+    {
+    slot = gaul_niche_index_nearest(&index, i);
+
+    if (pop->entity_iarray[i]->fitness > occupant[slot]->fitness)
+      {
+      losers[num_losers++] = occupant[slot];
+      occupant[slot] = pop->entity_iarray[i];
+      }
+    else
+      {
+      losers[num_losers++] = pop->entity_iarray[i];
+      }
+    }
+
+  gaul_niche_index_free(&index);
+
+  for (i=0; i<num_losers; i++)
+    ga_entity_dereference(pop, losers[i]);
+
+  s_free(occupant);
+  s_free(losers);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_adjust()
+  synopsis:	Apply a population's niching mode, before survival.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_niche_adjust(population *pop)
+  {
+  ga_niche_t	*niche=pop->niche_params;	/* Niching parameters. */
+  int		i;				/* Loop over raw fitnesses. */
+
+  if (!pop->niche_params || pop->size < 1) return;
+
+  gaul_profile_start(pop, GA_PHASE_SURVIVAL);
+
+  plog(LOG_VERBOSE, "*** Niching ***");
+
+  switch (pop->niche_params->type)
+    {
+    case GA_NICHE_SHARING:
+      gaul_niche_sharing(pop);
+      break;
+    case GA_NICHE_CLEARING:
+      gaul_niche_clearing(pop);
+      break;
+    case GA_NICHE_RTR:
+      gaul_niche_rtr(pop);
+      break;
+    default:
+      break;
+    }
+
+/*
+ * Note the adjusted fitnesses, so that restoration can tell which
+ * entities were re-evaluated during survival.
+ */
+  for (i=0; i<niche->num_raw; i++)
+    niche->raw[i].adjusted = niche->raw[i].entity->fitness;
+
+  gaul_profile_stop(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_restore()
+  synopsis:	Restore the raw fitnesses of the entities which
+		survived, and sort them again.  Entities which were
+		re-evaluated during survival (for example, under
+		GA_ELITISM_RESCORE_PARENTS) keep their new fitness.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_niche_restore(population *pop)
+  {
+  ga_niche_t		*niche=pop->niche_params;	/* Niching parameters. */
+  ga_niche_fitness_t	key, *raw;			/* Raw fitness. */
+  int			i;				/* Loop over entities. */
+
+  if (!niche || niche->num_raw == 0) return;
+
+  for (i=0; i<pop->size; i++)
+    {
+    key.entity = pop->entity_iarray[i];
+    raw = bsearch(&key, niche->raw, niche->num_raw, sizeof(ga_niche_fitness_t), gaul_niche_entity_compare);
+    if (raw && key.entity->fitness == raw->adjusted)
+      key.entity->fitness = raw->fitness;
+    }
+
+  niche->num_raw = 0;
+
+  sort_population(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_readjust()
+  synopsis:	Apply fitness sharing or clearing again, after some
+		entities were re-evaluated during survival (under
+		GA_ELITISM_RESCORE_PARENTS).  Their new fitnesses
+		replace the saved raw ones.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_niche_readjust(population *pop)
+  {
+
+  if (!pop->niche_params || pop->niche_params->num_raw == 0) return;
+
+  gaul_niche_restore(pop);
+  gaul_niche_adjust(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_niche_free()
+  synopsis:	Free a population's niching parameters.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_niche_free(population *pop)
+  {
+
+  if (!pop->niche_params) return;
+
+  if (pop->niche_params->raw) s_free(pop->niche_params->raw);
+  s_free(pop->niche_params);
+  pop->niche_params = NULL;
+
+  return;
+  }
@@ -46,6 +46,17 @@
 
 #include "gaul/ga_optim.h"
 
+#if defined(HAVE_PTHREADS) || !defined(W32_CRIPPLED)
+#include <sched.h>
+#endif
+
+#ifndef W32_CRIPPLED
+#include <sys/mman.h>
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS	MAP_ANON
+#endif
+#endif
+
 /*
  * Here is a kludge.
  *
@@ -82,8 +93,10 @@ static char	node_name[MPI_MAX_PROCESSOR_NAME];	/* String containing processor na
 #define GA_TAG_SLAVE_NOTIFICATION	1001
 #define GA_TAG_BUFFER_LEN		1002
 #define GA_TAG_INSTRUCTION		1003
-#define GA_TAG_FITNESS			1004
-#define GA_TAG_CHROMOSOMES		1005
+#define GA_TAG_EVALUATE			1006
+#define GA_TAG_BALDWIN			1007
+#define GA_TAG_LAMARCK			1008
+#define GA_TAG_RESULTS			1009
 
 /**********************************************************************
   mpi_init()
@@ -153,65 +166,24 @@ static int mpi_get_rank(void)
   }
 
 
-/**********************************************************************
-  mpi_get_next_rank()
-  synopsis:	Return the rank of the next node in a circular
-		topology.
-  parameters:
-  return:	int	rank
-  last updated:	03 Feb 2003
- **********************************************************************/
-
-static int mpi_get_next_rank(void)
-  {
-  int	next=rank+1;		/* The rank of the next process */
-
-  if (next==size) next=0;	/* Last process sends to first process */
-
-  return (next);
-  }
-
-
-/**********************************************************************
-  mpi_get_prev_rank()
-  synopsis:	Return the rank of the previous node in a circular
-		topology.
-  parameters:
-  return:	int	rank
-  last updated:	03 Feb 2003
- **********************************************************************/
-
-static int mpi_get_prev_rank(void)
-  {
-  int	prev=rank;		/* The rank of the previous process */
-
-  if (prev==0) prev=size;	/* First process sends to last process */
-
-  return (prev-1);
-  }
-
-
 /**********************************************************************
   gaul_bond_slaves_mpi()
   synopsis:	Register, set up and synchronise slave processes.
   parameters:	population *pop
   return:	none
-  last updated:	10 May 2004
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-static void gaul_bond_slaves_mpi(population *pop, int buffer_len, int buffer_max)
+static void gaul_bond_slaves_mpi(population *pop)
   {
   int		i;			/* Loop variable over slave processes. */
   int		mpi_rank;		/* Rank of slave process. */
   int		mpi_size;		/* Number of slave processes. */
   MPI_Status	status;			/* MPI status structure. */
-  int		two_int[2];		/* Send buffer. */
+  int		two_int[2]={0,0};	/* Send buffer. */
 
   MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
 
-  two_int[0] = buffer_len;
-  two_int[1] = buffer_max;
-
 /*
  * Listen for all slave processes.
  */
@@ -221,7 +193,8 @@ static void gaul_bond_slaves_mpi(population *pop, int buffer_len, int buffer_max
     /* FIXME: Check status here. */
 
 /*
- * Send slave the buffer length that it will require.
+ * Acknowledge.  Batches carry their own lengths, so no buffer length
+ * needs to be agreed in advance.
  */
     MPI_Send(two_int, 2, MPI_INT, status.MPI_SOURCE, GA_TAG_BUFFER_LEN, MPI_COMM_WORLD);
     }
@@ -263,10 +236,15 @@ static void gaul_debond_slaves_mpi(population *pop)
 
 /**********************************************************************
   ga_attach_mpi_slave()
-  synopsis:	Slave MPI process routine.
+  synopsis:	Slave MPI process routine.  Batches of packed
+		entities are received from the master, evaluated or
+		adapted in turn, and the results returned as a single
+		message per batch.  The master keeps several batches
+		in flight, so the next batch is normally waiting by
+		the time the results of the last are sent.
   parameters:	none
   return:	none
-  last updated:	10 May 2004
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 GAULFUNC void ga_attach_mpi_slave( population *pop )
@@ -274,12 +252,20 @@ GAULFUNC void ga_attach_mpi_slave( population *pop )
 #ifdef HAVE_MPI
   MPI_Status	status;			/* MPI status structure. */
   int		single_int;		/* Receive buffer. */
-  gaulbyte		*buffer=NULL;		/* Receive buffer. */
-  gaulbyte		*chromo=NULL;		/* Chromosome. */
+  gaulbyte	*buffer=NULL;		/* Receive buffer. */
+  int		buffer_max=0;		/* Size of receive buffer. */
+  gaulbyte	*results=NULL;		/* Send buffer. */
+  int		results_max=0;		/* Size of send buffer. */
+  int		*ranks=NULL;		/* Ranks of adapted entities. */
+  int		ranks_max=0;		/* Size of ranks array. */
+  int		len;			/* Length of message. */
+  int		tag;			/* Type of batch. */
+  int		first;			/* Rank of first received entity. */
+  int		num;			/* Number of received entities. */
+  int		i;			/* Loop over received entities. */
   boolean	finished=FALSE;		/* Whether this slave is done. */
-  entity	*entity, *adult;	/* Received entity, adapted entity. */
-  int		buffer_len=0;		/* Length of buffer to receive. */
-  int		buffer_max=0;		/* Chromosome byte representation length. */
+  entity	*this_entity, *adult;	/* Received entity, adapted entity. */
+  double	*fitness;		/* Returned fitnesses. */
   int		mpi_rank;		/* Rank of MPI process; should never be 0 here. */
   int		two_int[2];		/* Send buffer. */
 
@@ -293,96 +279,143 @@ GAULFUNC void ga_attach_mpi_slave( population *pop )
 /*
  * Send notification to master.
  */
-/*  printf("DEBUG: Process %d notifying master\n", mpi_rank);*/
   MPI_Send(&mpi_rank, 1, MPI_INT, 0, GA_TAG_SLAVE_NOTIFICATION, MPI_COMM_WORLD);
-
-/*
- * Allocate chromosome transfer buffer.
- */
   MPI_Recv(two_int, 2, MPI_INT, 0, GA_TAG_BUFFER_LEN, MPI_COMM_WORLD, &status);
-  buffer_len = two_int[0];
-  buffer_max = two_int[1];
-  if ( !(buffer = s_malloc(buffer_len*sizeof(gaulbyte))) )
-    die("Unable to allocate memory");
-
-/* printf("DEBUG: slave buffer len %d %d\n", buffer_len, buffer_max);*/
 
 /*
  * Enter task loop.
  */
   do
     {
+    MPI_Probe(0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+    tag = status.MPI_TAG;
+
+    if (tag == GA_TAG_INSTRUCTION)
+      {
+      MPI_Recv(&single_int, 1, MPI_INT, 0, GA_TAG_INSTRUCTION, MPI_COMM_WORLD, &status);
+
+      switch (single_int)
+        {
+        case 0:
+          /* No more jobs. */
+          finished=TRUE;
+          break;
+        case 1:
+          /* Prepare for calculations with a new population. */
+          MPI_Send(&mpi_rank, 1, MPI_INT, 0, GA_TAG_SLAVE_NOTIFICATION, MPI_COMM_WORLD);
+          MPI_Recv(two_int, 2, MPI_INT, 0, GA_TAG_BUFFER_LEN, MPI_COMM_WORLD, &status);
+          break;
+        default:
+          dief("Unknown instruction type packet recieved (%d).", single_int);
+        }
+
+      continue;
+      }
+
+    if (tag != GA_TAG_EVALUATE && tag != GA_TAG_BALDWIN && tag != GA_TAG_LAMARCK)
+      dief("Unknown message tag recieved (%d).", tag);
+
 /*
- * Recieve instruction packet.
+ * Receive a batch of entities.
  */
-    MPI_Recv(&single_int, 1, MPI_INT, 0, GA_TAG_INSTRUCTION, MPI_COMM_WORLD, &status);
+    MPI_Get_count(&status, MPI_BYTE, &len);
+    if (len > buffer_max)
+      {
+      buffer_max = len;
+      if ( !(buffer = s_realloc(buffer, buffer_max*sizeof(gaulbyte))) )
+        die("Unable to allocate memory");
+      }
+    MPI_Recv(buffer, len, MPI_BYTE, 0, tag, MPI_COMM_WORLD, &status);
 
-/*    printf("DEBUG: slave %d recieved instruction %d\n", mpi_rank, single_int);*/
+    first = pop->size;
+    num = ga_entities_unpack(pop, buffer, (unsigned int) len);
 
-    switch (single_int)
+    if (tag == GA_TAG_LAMARCK)
       {
-      case 0:
-        /* No more jobs. */
-/*        printf("DEBUG: slave %d recieved detach instruction.\n", mpi_rank);*/
-        finished=TRUE;
-        break;
-      case 1:
-        /* Prepare for calculations with a new population. */
-/* FIXME: Incomplete. */
-        MPI_Send(&mpi_rank, 1, MPI_INT, 0, GA_TAG_SLAVE_NOTIFICATION, MPI_COMM_WORLD);
-        MPI_Recv(two_int, 2, MPI_INT, 0, GA_TAG_BUFFER_LEN, MPI_COMM_WORLD, &status);
-        break;
-      case 2:
-        /* Evaluation required. */
-        entity = ga_get_free_entity(pop);
-        MPI_Recv(buffer, buffer_len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        pop->chromosome_from_bytes(pop, entity, buffer);
-        if ( pop->evaluate(pop, entity) == FALSE )
-          entity->fitness = GA_MIN_FITNESS;
-        MPI_Send(&(entity->fitness), 1, MPI_DOUBLE, 0, GA_TAG_FITNESS, MPI_COMM_WORLD);
-        ga_entity_dereference(pop, entity);
-        break;
-      case 3:
-        /* Baldwinian adaptation required. */
-        entity = ga_get_free_entity(pop);
-        MPI_Recv(buffer, buffer_len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        pop->chromosome_from_bytes(pop, entity, buffer);
-        adult = pop->adapt(pop, entity);
-        MPI_Send(&(adult->fitness), 1, MPI_DOUBLE, 0, GA_TAG_FITNESS, MPI_COMM_WORLD);
-        ga_entity_dereference(pop, entity);
-        ga_entity_dereference(pop, adult);
-        break;
-      case 4:
-        /* Lamarkian adaptation required. */
-        entity = ga_get_free_entity(pop);
-        MPI_Recv(buffer, buffer_len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        pop->chromosome_from_bytes(pop, entity, buffer);
-        adult = pop->adapt(pop, entity);
-        MPI_Send(&(adult->fitness), 1, MPI_DOUBLE, 0, GA_TAG_FITNESS, MPI_COMM_WORLD);
-        if (buffer_max==0)
+/*
+ * Lamarckian adaptation: return the adults themselves.
+ */
+      if (num > ranks_max)
+        {
+        ranks_max = num;
+        if ( !(ranks = s_realloc(ranks, ranks_max*sizeof(int))) )
+          die("Unable to allocate memory");
+        }
+
+      for (i=0; i<num; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[first+i]);
+        ranks[i] = ga_get_entity_rank(pop, adult);
+        }
+
+      len = (int) ga_entities_packed_size(pop, num);
+      }
+    else
+      {
+      len = num*(1+pop->fitness_dimensions)*sizeof(double);
+      }
+
+    if (len > results_max)
+      {
+      results_max = len;
+      if ( !(results = s_realloc(results, results_max*sizeof(gaulbyte))) )
+        die("Unable to allocate memory");
+      }
+
+    if (tag == GA_TAG_LAMARCK)
+      {
+      ga_entities_pack(pop, num, ranks, results, (unsigned int) len);
+      }
+    else
+      {
+/*
+ * Evaluation or Baldwinian adaptation: return the fitnesses only.
+ */
+      fitness = (double *) results;
+
+      for (i=0; i<num; i++)
+        {
+        this_entity = pop->entity_iarray[first+i];
+
+        if (tag == GA_TAG_EVALUATE)
           {
-          pop->chromosome_to_bytes(pop, adult, &chromo, &buffer_max);
-          MPI_Send(chromo, buffer_len, MPI_CHAR, 0, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
+          if ( gaul_evaluate(pop, this_entity) == FALSE )
+            this_entity->fitness = GA_MIN_FITNESS;
           }
         else
           {
-          pop->chromosome_to_bytes(pop, adult, &buffer, &buffer_len);
-          MPI_Send(buffer, buffer_len, MPI_CHAR, 0, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
+          adult = pop->adapt(pop, this_entity);
+          this_entity->fitness = adult->fitness;
+          gaul_stats_invalidate(pop);
+          if (pop->fitness_dimensions > 0)
+            memcpy(this_entity->fitvector, adult->fitvector,
+                   sizeof(double)*pop->fitness_dimensions);
+          ga_entity_dereference(pop, adult);
           }
-        ga_entity_dereference(pop, entity);
-        ga_entity_dereference(pop, adult);
-        break;
-      default:
-        dief("Unknown instruction type packet recieved (%d).", single_int);
+
+        fitness[i*(1+pop->fitness_dimensions)] = this_entity->fitness;
+        if (pop->fitness_dimensions > 0)
+          memcpy(&(fitness[i*(1+pop->fitness_dimensions)+1]), this_entity->fitvector,
+                 sizeof(double)*pop->fitness_dimensions);
+        }
       }
 
+    MPI_Send(results, len, MPI_BYTE, 0, GA_TAG_RESULTS, MPI_COMM_WORLD);
+
+/*
+ * Discard the batch, and any adults.
+ */
+    while (pop->size > first)
+      ga_entity_dereference_by_rank(pop, pop->size-1);
+
     } while (finished==FALSE);
 
 /*
  * Clean-up and exit.
  */
-  if (buffer != NULL)
-    s_free(buffer);
+  if (buffer != NULL) s_free(buffer);
+  if (results != NULL) s_free(results);
+  if (ranks != NULL) s_free(ranks);
 
 #else
   plog(LOG_WARNING, "Attempt to use parallel function without compiled support.");
@@ -460,1245 +493,1178 @@ static void gaul_entity_swap_rank(population *pop, const int rank1, const int ra
   pop->entity_iarray[rank1] = pop->entity_iarray[rank2];
   pop->entity_iarray[rank2] = tmp;
 
+  gaul_stats_invalidate(pop);
+
   return;
   }
 
 
+#ifdef HAVE_MPI
+/*
+ * A batch of entities in flight to an MPI slave process.  The send
+ * buffer must not be touched until the slave's results have arrived.
+ */
+typedef struct
+  {
+  population	*pop;			/* Population of entities. */
+  int		tag;			/* GA_TAG_EVALUATE, GA_TAG_BALDWIN or GA_TAG_LAMARCK. */
+  int		num;			/* Number of entities. */
+  int		*ranks;			/* Ranks of entities. */
+  int		ranks_max;		/* Size of ranks array. */
+  gaulbyte	*buffer;		/* Packed entities. */
+  unsigned int	buffer_max;		/* Size of buffer. */
+  MPI_Request	request;		/* Pending send. */
+  } mpi_batch_t;
+
+/*
+ * Master's view of the slave processes.  Each slave has a FIFO of
+ * GA_MPI_BATCHES_IN_FLIGHT batches, since it returns results in the
+ * order that batches were sent.
+ */
+typedef struct
+  {
+  int		num_slaves;		/* Number of slave processes. */
+  mpi_batch_t	*batches;		/* Slot s*GA_MPI_BATCHES_IN_FLIGHT+j for slave s+1. */
+  int		*first;			/* Oldest pending slot for each slave. */
+  int		*num_pending;		/* Number of pending slots for each slave. */
+  int		num_in_flight;		/* Total number of pending slots. */
+  gaulbyte	*results;		/* Receive buffer. */
+  int		results_max;		/* Size of receive buffer. */
+  int		*work;			/* Scratch ranks. */
+  int		work_max;		/* Size of scratch ranks. */
+  } mpi_farm_t;
+
+
 /**********************************************************************
-  gaul_migration()
-  synopsis:	Migration cycle.
-  parameters:	population *pop
-  return:	none
-  last updated:	11 Jun 2002
+  gaul_farm_new_mpi()
+  synopsis:	Allocate the master's bookkeeping for the slave
+		processes, which must have been bonded with
+		gaul_bond_slaves_mpi().
+  parameters:	none
+  return:	New farm.
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-static void gaul_migration(const int num_pops, population **pops)
+static mpi_farm_t *gaul_farm_new_mpi(void)
   {
-  int		pop0_osize;		/* Required for correct migration. */
-  int		current_island;			/* Current current_island number. */
-  int		i;			/* Loop over members of population. */
+  mpi_farm_t	*farm;			/* New farm. */
+  int		mpi_size;		/* Number of MPI processes. */
+  int		i;			/* Loop over slots. */
 
-  plog( LOG_VERBOSE, "*** Migration Cycle ***" );
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+
+  if ( !(farm = s_malloc(sizeof(mpi_farm_t))) )
+    die("Unable to allocate memory");
 
-  pop0_osize = pops[0]->size;
-  for(current_island=1; current_island<num_pops; current_island++)
+  farm->num_slaves = mpi_size-1;
+  farm->num_in_flight = 0;
+  farm->results = NULL;
+  farm->results_max = 0;
+  farm->work = NULL;
+  farm->work_max = 0;
+  farm->batches = NULL;
+  farm->first = NULL;
+  farm->num_pending = NULL;
+
+  if (farm->num_slaves > 0)
     {
-    for(i=0; i<pops[current_island]->size; i++)
+    if ( !(farm->batches = s_malloc(farm->num_slaves*GA_MPI_BATCHES_IN_FLIGHT*sizeof(mpi_batch_t))) )
+      die("Unable to allocate memory");
+    if ( !(farm->first = s_malloc(farm->num_slaves*sizeof(int))) )
+      die("Unable to allocate memory");
+    if ( !(farm->num_pending = s_malloc(farm->num_slaves*sizeof(int))) )
+      die("Unable to allocate memory");
+
+    for (i=0; i<farm->num_slaves*GA_MPI_BATCHES_IN_FLIGHT; i++)
       {
-      if (random_boolean_prob(pops[current_island]->migration_ratio))
-        {
-        ga_entity_clone(pops[current_island-1], pops[current_island]->entity_iarray[i]);
-/* printf("%d, %d: Cloned %d %f\n", mpi_get_rank(), current_island, i, pops[current_island]->entity_iarray[i]->fitness);*/
-        }
+      farm->batches[i].pop = NULL;
+      farm->batches[i].ranks = NULL;
+      farm->batches[i].ranks_max = 0;
+      farm->batches[i].buffer = NULL;
+      farm->batches[i].buffer_max = 0;
       }
-    }
 
-  for(i=0; i<pop0_osize; i++)
-    {
-    if (random_boolean_prob(pops[0]->migration_ratio))
-      ga_entity_clone(pops[num_pops-1], pops[0]->entity_iarray[i]);
-/*  printf("%d, 0: Cloned %d %f\n", mpi_get_rank(), i, pops[current_island]->entity_iarray[i]->fitness);*/
-    }
-
-/*
- * Sort the individuals in each population.
- * Need this to ensure that new immigrants are ranked correctly.
- * FIXME: It would be more efficient to insert the immigrants correctly.
- */
-#pragma omp parallel for \
-   shared(pops) private(current_island) \
-   schedule(static)
-  for(current_island=0; current_island<num_pops; current_island++)
-    {
-    sort_population(pops[current_island]);
+    for (i=0; i<farm->num_slaves; i++)
+      {
+      farm->first[i] = 0;
+      farm->num_pending[i] = 0;
+      }
     }
 
-  return;
+  return farm;
   }
 
 
 /**********************************************************************
-  gaul_crossover()
-  synopsis:	Mating cycle. (i.e. Sexual reproduction).
-  parameters:	population *pop
+  gaul_farm_free_mpi()
+  synopsis:	Deallocate the master's bookkeeping.  No batches may
+		be in flight.
+  parameters:	mpi_farm_t *farm
   return:	none
-  last updated:	11 Jun 2002
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-static void gaul_crossover(population *pop)
+static void gaul_farm_free_mpi(mpi_farm_t *farm)
   {
-  entity	*mother, *father;	/* Parent entities. */
-  entity	*son, *daughter;	/* Child entities. */
-
-  plog(LOG_VERBOSE, "*** Mating cycle ***");
-
-  if (pop->crossover_ratio <= 0.0) return;
+  int		i;			/* Loop over slots. */
 
-  pop->select_state = 0;
+  if (farm->num_in_flight > 0) die("Internal error.  Batches still in flight.");
 
-  /* Select pairs of entities to mate via crossover. */
-#pragma intel omp parallel taskq
-  while ( !(pop->select_two(pop, &mother, &father)) )
+  for (i=0; i<farm->num_slaves*GA_MPI_BATCHES_IN_FLIGHT; i++)
     {
-
-    if (mother && father)
-      {
-#pragma intel omp task \
-  private(son,daughter) captureprivate(mother,father)
-        {
-        plog(LOG_VERBOSE, "Crossover between %d (rank %d fitness %f) and %d (rank %d fitness %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness,
-             ga_get_entity_id(pop, father),
-             ga_get_entity_rank(pop, father), father->fitness);
-
-        son = ga_get_free_entity(pop);
-        daughter = ga_get_free_entity(pop);
-        pop->crossover(pop, mother, father, daughter, son);
-        }
-      }
-    else
-      {
-      plog( LOG_VERBOSE, "Crossover not performed." );
-      }
+    if (farm->batches[i].ranks) s_free(farm->batches[i].ranks);
+    if (farm->batches[i].buffer) s_free(farm->batches[i].buffer);
     }
 
+  if (farm->batches) s_free(farm->batches);
+  if (farm->first) s_free(farm->first);
+  if (farm->num_pending) s_free(farm->num_pending);
+  if (farm->results) s_free(farm->results);
+  if (farm->work) s_free(farm->work);
+  s_free(farm);
+
   return;
   }
 
 
 /**********************************************************************
-  gaul_mutation()
-  synopsis:	Mutation cycle.  (i.e. Asexual reproduction)
-  parameters:	population *pop
-  return:	none
-  last updated:	11 Jun 2002
+  gaul_farm_progress_mpi()
+  synopsis:	Collect the results of one batch, if any are ready,
+		and apply them to its population.  Fitnesses are
+		copied into the original entities, while Lamarckian
+		adults replace them.
+  parameters:	mpi_farm_t *farm
+		const boolean wait	Whether to block until a batch
+					completes.
+  return:	TRUE if a batch was completed.
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-static void gaul_mutation(population *pop)
+static boolean gaul_farm_progress_mpi(mpi_farm_t *farm, const boolean wait)
   {
-  entity	*mother;		/* Parent entities. */
-  entity	*daughter;		/* Child entities. */
+  MPI_Status	status;			/* MPI status structure. */
+  int		flag=TRUE;		/* Whether a message is waiting. */
+  int		len;			/* Length of message. */
+  int		slave;			/* Index of slave process. */
+  mpi_batch_t	*batch;			/* Completed batch. */
+  population	*pop;			/* Batch's population. */
+  double	*fitness;		/* Returned fitnesses. */
+  int		base;			/* Rank of first adult. */
+  int		i;			/* Loop over entities. */
+
+  if (farm->num_in_flight == 0) return FALSE;
+
+  if (wait)
+    MPI_Probe(MPI_ANY_SOURCE, GA_TAG_RESULTS, MPI_COMM_WORLD, &status);
+  else
+    MPI_Iprobe(MPI_ANY_SOURCE, GA_TAG_RESULTS, MPI_COMM_WORLD, &flag, &status);
 
-  plog(LOG_VERBOSE, "*** Mutation cycle ***");
+  if (!flag) return FALSE;
 
-  if (pop->mutation_ratio <= 0.0) return;
+  slave = status.MPI_SOURCE-1;
+  if (farm->num_pending[slave] == 0) die("Internal error.  Unexpected results.");
 
-  pop->select_state = 0;
+  MPI_Get_count(&status, MPI_BYTE, &len);
+  if (len > farm->results_max)
+    {
+    farm->results_max = len;
+    if ( !(farm->results = s_realloc(farm->results, farm->results_max*sizeof(gaulbyte))) )
+      die("Unable to allocate memory");
+    }
+  MPI_Recv(farm->results, len, MPI_BYTE, status.MPI_SOURCE, GA_TAG_RESULTS, MPI_COMM_WORLD, &status);
 
-  /*
-   * Select entities to undergo asexual reproduction, in each case the child will
-   * have a genetic mutation of some type.
-   */
-#pragma intel omp parallel taskq
-  while ( !(pop->select_one(pop, &mother)) )
+  batch = &(farm->batches[slave*GA_MPI_BATCHES_IN_FLIGHT+farm->first[slave]]);
+  MPI_Wait(&(batch->request), &status);
+
+  pop = batch->pop;
+
+  if (batch->tag == GA_TAG_LAMARCK)
     {
+    base = pop->size;
+    if (ga_entities_unpack(pop, farm->results, (unsigned int) len) != batch->num)
+      die("Internal error.  Incorrect number of adults.");
 
-    if (mother)
-      {
-#pragma intel omp task \
-  private(daughter) captureprivate(mother)
-        {
-        plog(LOG_VERBOSE, "Mutation of %d (rank %d fitness %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness );
+    for (i=0; i<batch->num; i++)
+      gaul_entity_swap_rank(pop, batch->ranks[i], base+i);
 
-        daughter = ga_get_free_entity(pop);
-        pop->mutate(pop, mother, daughter);
-        }
-      }
-    else
+    while (pop->size > base)
+      ga_entity_dereference_by_rank(pop, pop->size-1);
+    }
+  else
+    {
+    if (len != batch->num*(1+pop->fitness_dimensions)*(int)sizeof(double))
+      die("Internal error.  Incorrect number of fitnesses.");
+
+    fitness = (double *) farm->results;
+
+    for (i=0; i<batch->num; i++)
       {
-      plog( LOG_VERBOSE, "Mutation not performed." );
+      pop->entity_iarray[batch->ranks[i]]->fitness = fitness[i*(1+pop->fitness_dimensions)];
+      if (pop->fitness_dimensions > 0)
+        memcpy(pop->entity_iarray[batch->ranks[i]]->fitvector,
+               &(fitness[i*(1+pop->fitness_dimensions)+1]),
+               sizeof(double)*pop->fitness_dimensions);
       }
+
+    gaul_stats_invalidate(pop);
     }
 
-  return;
+  batch->pop = NULL;
+  farm->first[slave] = (farm->first[slave]+1)%GA_MPI_BATCHES_IN_FLIGHT;
+  farm->num_pending[slave]--;
+  farm->num_in_flight--;
+
+  return TRUE;
   }
 
 
 /**********************************************************************
-  gaul_evaluation_slave_mp()
-  synopsis:	Fitness evaluations and adaptations are performed here.
-  parameters:	population *pop
+  gaul_farm_wait_mpi()
+  synopsis:	Wait for every batch in flight to complete.
+  parameters:	mpi_farm_t *farm
   return:	none
-  last updated:	03 Feb 2003
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef HAVE_MPI
-static void gaul_evaluation_slave_mp(population *pop)
+static void gaul_farm_wait_mpi(mpi_farm_t *farm)
   {
-  MPI_Status	status;			/* MPI status structure. */
-  int		single_int;		/* Receive buffer. */
-  gaulbyte		*buffer;		/* Receive buffer. */
-  boolean	finished=FALSE;		/* Whether this slave is done. */
-  entity	*entity, *adult;	/* Received entity, adapted entity. */
-  int	len=0;			/* Length of buffer to receive. */
 
-/*
- * Allocate receive buffer.
- * FIXME: This length data shouldn't be needed!
- */
-  MPI_Recv(&len, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-  if ( !(buffer = s_malloc(len*sizeof(gaulbyte))) )
-    die("Unable to allocate memory");
-
-/*printf("DEBUG: slave %d recieved %d (len)\n", rank, len);*/
-
-/*
- * Instruction packet.
- */
-  do
-    {
-    MPI_Recv(&single_int, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-
-/*printf("DEBUG: slave %d recieved %d (instruction)\n", rank, len);*/
-
-    switch (single_int)
-      {
-      case 0:
-        /* Evaluation required. */
-        entity = ga_get_free_entity(pop);
-        MPI_Recv(buffer, len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        pop->chromosome_from_bytes(pop, entity, buffer);
-        if ( pop->evaluate(pop, entity) == FALSE )
-          entity->fitness = GA_MIN_FITNESS;
-        MPI_Send(&(entity->fitness), 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-        break;
-      case 1:
-        /* Baldwinian adaptation required. */
-        entity = ga_get_free_entity(pop);
-        MPI_Recv(buffer, len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        pop->chromosome_from_bytes(pop, entity, buffer);
-        adult = pop->adapt(pop, entity);
-        MPI_Send(&(adult->fitness), 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-        break;
-      case 2:
-        /* Lamarkian adaptation required. */
-        entity = ga_get_free_entity(pop);
-        MPI_Recv(buffer, len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
-        pop->chromosome_from_bytes(pop, entity, buffer);
-        adult = pop->adapt(pop, entity);
-        MPI_Send(&(adult->fitness), 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
-        pop->chromosome_to_bytes(pop, adult, &buffer, &len);
-        MPI_Send(buffer, len, MPI_CHAR, 0, 0, MPI_COMM_WORLD);
-        break;
-      case 3:
-        /* No more jobs. */
-        finished=TRUE;
-        break;
-      default:
-        die("Unknown instruction packet recieved");
-      }
-
-    } while (finished==FALSE);
-
-/*
- * Synchronise population on this process with that on the master process.
- */
-  ga_genocide(pop,0);
-  ga_population_append_receive(pop, 0);
-
-  s_free(buffer);
+  while (farm->num_in_flight > 0)
+    gaul_farm_progress_mpi(farm, TRUE);
 
   return;
   }
-#endif
 
 
 /**********************************************************************
-  gaul_ensure_evaluations()
-  synopsis:	Fitness evaluations.
-		Evaluate all previously unevaluated entities.
-		No adaptation.
-  parameters:	population *pop
+  gaul_farm_send_mpi()
+  synopsis:	Pack a batch of entities and start sending it to the
+		least loaded slave process.  If every slave already
+		has GA_MPI_BATCHES_IN_FLIGHT batches, waits for one
+		to complete.  The entities must not be reordered
+		until the batch has completed.
+  parameters:	mpi_farm_t *farm
+		population *pop
+		const int tag		Type of batch.
+		const int *ranks	Ranks of entities.
+		const int num		Number of entities.
   return:	none
-  last updated:	01 Jul 2004
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-static void gaul_ensure_evaluations(population *pop)
+static void gaul_farm_send_mpi( mpi_farm_t *farm, population *pop,
+                                const int tag, const int *ranks, const int num )
   {
-  int		i;			/* Loop variable over entity ranks. */
+  mpi_batch_t	*batch;			/* Batch to send. */
+  unsigned int	len;			/* Length of packed batch. */
+  int		slave=0;		/* Index of slave process. */
+  int		i;			/* Loop over slaves. */
 
-#pragma omp parallel for \
-   shared(pop) private(i) \
-   schedule(static)
-  for (i=0; i<pop->size; i++)
+  if (farm->num_in_flight == farm->num_slaves*GA_MPI_BATCHES_IN_FLIGHT)
+    gaul_farm_progress_mpi(farm, TRUE);
+  while (gaul_farm_progress_mpi(farm, FALSE));
+
+  for (i=1; i<farm->num_slaves; i++)
     {
-/*printf("DEBUG: gaul_ensure_evaluations() parallel for %d on %d/%d.\n", i, omp_get_thread_num(), omp_get_num_threads());*/
-    if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
-      {
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
-        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
-      }
+    if (farm->num_pending[i] < farm->num_pending[slave]) slave = i;
+    }
+
+  batch = &(farm->batches[ slave*GA_MPI_BATCHES_IN_FLIGHT +
+                           (farm->first[slave]+farm->num_pending[slave])%GA_MPI_BATCHES_IN_FLIGHT ]);
+
+  if (num > batch->ranks_max)
+    {
+    batch->ranks_max = num;
+    if ( !(batch->ranks = s_realloc(batch->ranks, batch->ranks_max*sizeof(int))) )
+      die("Unable to allocate memory");
+    }
+
+  len = ga_entities_packed_size(pop, num);
+  if (len > batch->buffer_max)
+    {
+    batch->buffer_max = len;
+    if ( !(batch->buffer = s_realloc(batch->buffer, batch->buffer_max*sizeof(gaulbyte))) )
+      die("Unable to allocate memory");
     }
 
+  batch->pop = pop;
+  batch->tag = tag;
+  batch->num = num;
+  memcpy(batch->ranks, ranks, num*sizeof(int));
+  ga_entities_pack(pop, num, ranks, batch->buffer, len);
+
+  MPI_Isend(batch->buffer, (int) len, MPI_BYTE, slave+1, tag, MPI_COMM_WORLD, &(batch->request));
+
+  farm->num_pending[slave]++;
+  farm->num_in_flight++;
+
   return;
   }
 
 
 /**********************************************************************
-  gaul_ensure_evaluations_mp()
-  synopsis:	Fitness evaluations.
-		Evaluate all previously unevaluated entities.
-		No adaptation.
-  parameters:	population *pop
+  gaul_farm_submit_mpi()
+  synopsis:	Farm out the evaluation, or adaptation, of a range of
+		ranks to the slave processes, in batches sized so that
+		each slave receives several, but no batch exceeds
+		GA_MPI_MAX_BATCH_BYTES.  Returns as soon as the last
+		batch has been sent; gaul_farm_wait_mpi() collects
+		the results.  Without slave processes, the work is
+		done immediately.
+  parameters:	mpi_farm_t *farm
+		population *pop
+		const int tag		Type of work.
+		const int first		First rank.
+		const int last		One past the last rank.
+		const boolean unevaluated_only	Whether to skip entities
+					that already have a fitness.
   return:	none
-  last updated:	03 Feb 2003
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef HAVE_MPI
-static void gaul_ensure_evaluations_mp(population *pop)
+static void gaul_farm_submit_mpi( mpi_farm_t *farm, population *pop, const int tag,
+                                  const int first, const int last,
+                                  const boolean unevaluated_only )
   {
-  int		i;			/* Loop variable over entity ranks. */
+  int		num=0;			/* Number of entities. */
+  int		batch_size;		/* Entities per batch. */
+  int		record_len;		/* Bytes per packed entity. */
+  int		i;			/* Loop over entities. */
+  entity	*adult;			/* Adapted entity. */
+  int		adultrank;		/* Rank of adapted entity. */
 
-  plog(LOG_FIXME, "Need to parallelise this!");
+  if (last-first > farm->work_max)
+    {
+    farm->work_max = last-first;
+    if ( !(farm->work = s_realloc(farm->work, farm->work_max*sizeof(int))) )
+      die("Unable to allocate memory");
+    }
 
-  for (i=0; i<pop->size; i++)
+  for (i=first; i<last; i++)
     {
-    if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
-        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
+    if (!unevaluated_only || pop->entity_iarray[i]->fitness==GA_MIN_FITNESS)
+      farm->work[num++] = i;
+    }
+
+  if (num == 0) return;
+
+  if (farm->num_slaves == 0)
+    {
+    for (i=0; i<num; i++)
+      {
+      if (tag == GA_TAG_EVALUATE)
+        {
+        if ( gaul_evaluate(pop, pop->entity_iarray[farm->work[i]]) == FALSE )
+          pop->entity_iarray[farm->work[i]]->fitness = GA_MIN_FITNESS;
+        }
+      else if (tag == GA_TAG_BALDWIN)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[farm->work[i]]);
+        pop->entity_iarray[farm->work[i]]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
+        }
+      else
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[farm->work[i]]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, farm->work[i], adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
+        }
+      }
+
+    return;
     }
 
+  record_len = ga_entities_packed_size(pop, 1) - ga_entities_packed_size(pop, 0);
+  batch_size = (num + farm->num_slaves*GA_MPI_BATCHES_IN_FLIGHT*2 - 1) /
+               (farm->num_slaves*GA_MPI_BATCHES_IN_FLIGHT*2);
+  batch_size = MIN(batch_size, GA_MPI_MAX_BATCH_BYTES/record_len);
+  batch_size = MAX(batch_size, 1);
+
+  for (i=0; i<num; i+=batch_size)
+    gaul_farm_send_mpi(farm, pop, tag, &(farm->work[i]), MIN(batch_size, num-i));
+
   return;
   }
 #endif
 
 
 /**********************************************************************
-  gaul_ensure_evaluations_mpi()
-  synopsis:	Fitness evaluations.
-		Evaluate all previously unevaluated entities.
-		No adaptation.
-  parameters:	population *pop
-  return:	none
-  last updated:	10 May 2004
+  gaul_migration_graph()
+  synopsis:	Resolve each island's migration destinations into a
+		single, validated, adjacency list.  Islands are
+		numbered first to first+num_pops-1 out of total, so
+		that islands held by other processes may be
+		destinations.  Islands without explicit destinations
+		send to island i-1, which is the classic cyclic
+		topology.
+  parameters:	const int num_pops
+		population **pops
+		const int first		Number of island pops[0].
+		const int total		Number of islands overall.
+		int **offsets	Island i's edges are offsets[i] to offsets[i+1]-1.
+		int **targets	Destination island for each edge.
+  return:	Number of edges.
+  last updated:	17 Oct 2026
  **********************************************************************/
 
-#ifdef HAVE_MPI
-static void gaul_ensure_evaluations_mpi( population *pop, int *eid,
-                        gaulbyte *buffer, int buffer_len, int buffer_max )
+static int gaul_migration_graph( const int num_pops, population **pops,
+                                 const int first, const int total,
+                                 int **offsets, int **targets )
   {
-  MPI_Status	status;			/* MPI status structure. */
-  double	single_double;		/* Recieve buffer. */
-  int		instruction=2;		/* Detach instruction. */
-  int		mpi_size;		/* Number of slave processes. */
-  int		process_num;		/* Number of remote processes running calculations. */
-  int		eval_num;		/* Id of entity being processed. */
-  gaulbyte		*chromo=NULL;		/* Chromosome in byte form. */
+  int			current_island;	/* Current island number. */
+  int			e;		/* Loop over edges. */
+  int			num_edges=0;	/* Total number of edges. */
+  ga_migration_t	*params;	/* Island's migration parameters. */
 
-  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  if ( !(*offsets = s_malloc(sizeof(int)*(num_pops+1))) )
+    die("Unable to allocate memory");
 
-/*
- * A process is notifed to begin each fitness evaluation until
- * all processes are busy, at which point we wait for
- * results before initiating more.
- *
- * Skip evaluations for entities that have been previously evaluated.
- */
-  process_num = 0;
-  eval_num = 0;
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    params = pops[current_island]->migration_params;
+    (*offsets)[current_island] = num_edges;
+    if (params && params->num_destinations>0)
+      num_edges += params->num_destinations;
+    else if (total > 1)
+      num_edges++;
+    }
+  (*offsets)[num_pops] = num_edges;
 
-  /* Skip to the next entity which needs evaluating. */
-  while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+  if ( !(*targets = s_malloc(sizeof(int)*MAX(num_edges, 1))) )
+    die("Unable to allocate memory");
 
-  while (process_num < mpi_size-1 && eval_num < pop->size)
+  for (current_island=0; current_island<num_pops; current_island++)
     {
-    eid[process_num] = eval_num;
+    params = pops[current_island]->migration_params;
+    e = (*offsets)[current_island];
 
-/* Send instruction and required data. */
-    MPI_Send(&instruction, 1, MPI_INT, process_num+1, GA_TAG_INSTRUCTION, MPI_COMM_WORLD);
-    if (buffer_max==0)
+    if (params && params->num_destinations>0)
       {
-      pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &chromo, &buffer_max);
-      MPI_Send(chromo, buffer_len, MPI_CHAR, process_num+1, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
+      memcpy(&((*targets)[e]), params->destinations, sizeof(int)*params->num_destinations);
+      for (; e<(*offsets)[current_island+1]; e++)
+        {
+        if ((*targets)[e] >= total || (*targets)[e] == first+current_island)
+          dief("Island %d has an invalid migration destination %d.", first+current_island, (*targets)[e]);
+        }
       }
-    else
+    else if (total > 1)
       {
-      pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &buffer, &buffer_len);
-      MPI_Send(buffer, buffer_len, MPI_CHAR, process_num+1, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
+      (*targets)[e] = (first+current_island+total-1)%total;
       }
+    }
 
-    process_num++;
-    eval_num++;
+  return num_edges;
+  }
 
-    /* Skip to the next entity which needs evaluating. */
-    while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
-    }
 
-  while (process_num > 0)
-    { /* Wait for a process to finish. */
-    MPI_Recv(&single_double, 1, MPI_DOUBLE, MPI_ANY_SOURCE, GA_TAG_FITNESS, MPI_COMM_WORLD, &status);
-    /* FIXME: Check status here. */
+/**********************************************************************
+  gaul_migration_interval()
+  synopsis:	Number of generations between emigrations.
+  parameters:	population *pop
+  return:	Interval.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static int gaul_migration_interval(population *pop)
+  {
+  return pop->migration_params ? pop->migration_params->interval : 1;
+  }
+
 
-    /* Find which entity this process was evaluating. */
-    if (eid[status.MPI_SOURCE-1] == -1) die("Internal error.  eid is -1");
+/**********************************************************************
+  gaul_migration_max_emigrants()
+  synopsis:	Upper bound on the number of entities that
+		gaul_migration_select() may return for a population
+		of stable size.
+  parameters:	population *pop
+  return:	Maximum number of emigrants.
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-    pop->entity_iarray[eid[status.MPI_SOURCE-1]]->fitness = single_double;
+static int gaul_migration_max_emigrants(population *pop)
+  {
+  if ( !pop->migration_params ||
+       pop->migration_params->emigration == GA_EMIGRATION_PROBABILISTIC )
+    return pop->stable_size;
 
-    if (eval_num < pop->size)
-      {
-      eid[status.MPI_SOURCE-1] = eval_num;
+  return MIN(pop->migration_params->num_emigrants, pop->stable_size);
+  }
+
+
+/**********************************************************************
+  gaul_migration_select()
+  synopsis:	Choose emigrants from the first num_residents ranks
+		of a sorted population, according to the population's
+		emigration policy.  No more than max_emigrants are
+		chosen.
+  parameters:	population *pop
+		const int num_residents
+		const int max_emigrants
+		int *ranks	Returns ranks of emigrants (num_residents long).
+  return:	Number of emigrants.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static int gaul_migration_select( population *pop, const int num_residents,
+                                  const int max_emigrants, int *ranks )
+  {
+  int		i, j;		/* Loop over ranks. */
+  int		num=0;		/* Number of emigrants. */
+  int		tmp;		/* For swapping ranks. */
+  ga_emigration_type	emigration;	/* Selection policy. */
 
-      MPI_Send(&instruction, 1, MPI_INT, status.MPI_SOURCE, GA_TAG_INSTRUCTION, MPI_COMM_WORLD);
-      if (buffer_max==0)
+  emigration = pop->migration_params ? pop->migration_params->emigration : GA_EMIGRATION_PROBABILISTIC;
+
+  switch (emigration)
+    {
+    case GA_EMIGRATION_BEST:
+      num = MIN(MIN(pop->migration_params->num_emigrants, num_residents), max_emigrants);
+      for (i=0; i<num; i++)
+        ranks[i] = i;
+      break;
+
+    case GA_EMIGRATION_RANDOM:
+      num = MIN(MIN(pop->migration_params->num_emigrants, num_residents), max_emigrants);
+      for (i=0; i<num_residents; i++)
+        ranks[i] = i;
+      for (i=0; i<num; i++)
         {
-        pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &chromo, &buffer_max);
-        MPI_Send(chromo, buffer_len, MPI_CHAR, status.MPI_SOURCE, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
+        j = random_int_range(i, num_residents);
+        tmp = ranks[i];
+        ranks[i] = ranks[j];
+        ranks[j] = tmp;
         }
-      else
+      break;
+
+    default:
+      for (i=0; i<num_residents && num<max_emigrants; i++)
         {
-        pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &buffer, &buffer_len);
-        MPI_Send(buffer, buffer_len, MPI_CHAR, status.MPI_SOURCE, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
+        if (random_boolean_prob(pop->migration_ratio))
+          ranks[num++] = i;
         }
+    }
 
-      eval_num++;
+  return num;
+  }
 
-      /* Skip to the next entity which needs evaluating. */
-      while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
-      }
+
+/**********************************************************************
+  gaul_migration_replace()
+  synopsis:	Apply the population's immigration policy.  The
+		immigrants follow the num_residents residents in
+		entity_iarray[]; up to one resident per immigrant is
+		removed, either the worst or at random.
+  parameters:	population *pop
+		const int num_residents
+  return:	Number of surviving residents, i.e. the rank of the
+		first immigrant.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static int gaul_migration_replace(population *pop, const int num_residents)
+  {
+  int			i;		/* Loop over replaced residents. */
+  int			num_replaced;	/* Number of residents to remove. */
+  ga_immigration_type	immigration;	/* Replacement policy. */
+
+  immigration = pop->migration_params ? pop->migration_params->immigration : GA_IMMIGRATION_ADD;
+  if (immigration == GA_IMMIGRATION_ADD) return num_residents;
+
+  num_replaced = MIN(pop->size-num_residents, num_residents);
+
+  for (i=0; i<num_replaced; i++)
+    {
+    if (immigration == GA_IMMIGRATION_REPLACE_WORST)
+      ga_entity_dereference_by_rank(pop, num_residents-1-i);
     else
-      {
-      eid[status.MPI_SOURCE-1] = -1;
-      process_num--;
-      }
+      ga_entity_dereference_by_rank(pop, random_int(num_residents-i));
     }
 
-  return;
+  return num_residents-num_replaced;
   }
-#endif
 
 
 /**********************************************************************
-  gaul_ensure_evaluations_forked()
-  synopsis:	Fitness evaluations.
-		Evaluate all previously unevaluated entities.
-		No adaptation.
-  parameters:	population *pop
+  gaul_migration()
+  synopsis:	Migration cycle.  Each island's emigrants are chosen
+		from its residents before any immigrants arrive, then
+		cloned into every destination island.  Finally, the
+		immigration policy is applied and each island is
+		re-sorted.
+  parameters:	const int num_pops
+		population **pops
+		const int generation
+		const int *offsets	Migration graph from gaul_migration_graph().
+		const int *targets
   return:	none
-  last updated:	30 Jun 2002
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifndef W32_CRIPPLED
-static void gaul_ensure_evaluations_forked(population *pop, const int num_processes,
-			int *eid, pid_t *pid, const int *evalpipe)
+static void gaul_migration( const int num_pops, population **pops,
+                            const int generation,
+                            const int *offsets, const int *targets )
   {
-  int		fork_num;		/* Index of current forked process. */
-  int		num_forks;		/* Number of forked processes. */
-  int		eval_num;		/* Index of current entity. */
-  pid_t		fpid;			/* PID of completed child process. */
+  int		*num_residents;		/* Island sizes prior to migration. */
+  int		*ranks;			/* Ranks of emigrants. */
+  int		max_residents=1;	/* Largest island. */
+  int		current_island;		/* Current current_island number. */
+  int		source;			/* Emigrating island. */
+  int		num;			/* Number of emigrants. */
+  int		i, e;			/* Loop over emigrants, edges. */
 
-/*
- * A forked process is started for each fitness evaluation upto
- * a maximum of max_processes at which point we wait for
- * results before forking more.
- *
- * Skip evaluations for entities that have been previously evaluated.
- */
-  fork_num = 0;
-  eval_num = 0;
+  plog( LOG_VERBOSE, "*** Migration Cycle ***" );
 
-  /* Fork initial processes. */
-  /* Skip to the next entity which needs evaluating. */
-  while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+  for(current_island=0; current_island<num_pops; current_island++)
+    gaul_profile_start(pops[current_island], GA_PHASE_MIGRATION);
 
-  while (fork_num < num_processes && eval_num < pop->size)
+  if ( !(num_residents = s_malloc(sizeof(int)*num_pops)) )
+    die("Unable to allocate memory");
+
+  for(current_island=0; current_island<num_pops; current_island++)
     {
-    eid[fork_num] = eval_num;
-    pid[fork_num] = fork();
+    num_residents[current_island] = pops[current_island]->size;
+    max_residents = MAX(max_residents, num_residents[current_island]);
+    }
 
-    if (pid[fork_num] < 0)
-      {       /* Error in fork. */
-      dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-      }
-    else if (pid[fork_num] == 0)
-      {       /* This is the child process. */
-      if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
-        pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+  if ( !(ranks = s_malloc(sizeof(int)*max_residents)) )
+    die("Unable to allocate memory");
 
-      write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+/*
+ * Islands emigrate in the order 1, 2, ..., num_pops-1, 0.
+ */
+  for(current_island=1; current_island<=num_pops; current_island++)
+    {
+    source = current_island%num_pops;
 
-      fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
-      _exit(1);
-      }
+    if ( offsets[source]==offsets[source+1] ||
+         generation%gaul_migration_interval(pops[source]) != 0 )
+      continue;
 
-    fork_num++;
-    eval_num++;
+    num = gaul_migration_select(pops[source], num_residents[source],
+                                num_residents[source], ranks);
 
-    /* Skip to the next entity which needs evaluating. */
-    while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
-#ifdef NEED_MOSIX_FORK_HACK
-    usleep(10);
-#endif
+    for(e=offsets[source]; e<offsets[source+1]; e++)
+      {
+      for(i=0; i<num; i++)
+        ga_entity_clone(pops[targets[e]], pops[source]->entity_iarray[ranks[i]]);
+      }
     }
-  num_forks = fork_num;
 
-  /* Wait for a forked process to finish and, if needed, fork another. */
-  while (num_forks > 0)
+  for(current_island=0; current_island<num_pops; current_island++)
+    gaul_migration_replace(pops[current_island], num_residents[current_island]);
+
+  s_free(ranks);
+  s_free(num_residents);
+
+/*
+ * Sort the individuals in each population.
+ * Need this to ensure that new immigrants are ranked correctly.
+ * FIXME: It would be more efficient to insert the immigrants correctly.
+ */
+#pragma omp parallel for \
+   shared(pops) private(current_island) \
+   schedule(static)
+  for(current_island=0; current_island<num_pops; current_island++)
     {
-    fpid = wait(NULL);
+    sort_population(pops[current_island]);
+    }
 
-    if (fpid == -1) die("Error in wait().");
+  for(current_island=0; current_island<num_pops; current_island++)
+    gaul_profile_stop(pops[current_island]);
 
-    /* Find which entity this forked process was evaluating. */
-    fork_num = 0;
-    while (fpid != pid[fork_num]) fork_num++;
+  return;
+  }
 
-    if (eid[fork_num] == -1) die("Internal error.  eid is -1");
 
-    read(evalpipe[2*fork_num], &(pop->entity_iarray[eid[fork_num]]->fitness), sizeof(double));
+/**********************************************************************
+  gaul_crossover()
+  synopsis:	Mating cycle. (i.e. Sexual reproduction).
+  parameters:	population *pop
+  return:	none
+  last updated:	11 Jun 2002
+ **********************************************************************/
 
-    if (eval_num < pop->size)
-      {       /* New fork. */
-      eid[fork_num] = eval_num;
-      pid[fork_num] = fork();
+static void gaul_crossover(population *pop)
+  {
+  entity	*mother, *father;	/* Parent entities. */
+  entity	*son, *daughter;	/* Child entities. */
 
-      if (pid[fork_num] < 0)
-        {       /* Error in fork. */
-        dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-        }
-      else if (pid[fork_num] == 0)
-        {       /* This is the child process. */
-        if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
-          pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+  plog(LOG_VERBOSE, "*** Mating cycle ***");
 
-        write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+  if (pop->crossover_ratio <= 0.0) return;
 
-        fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
-        _exit(1);
-        }
+  gaul_profile_start(pop, GA_PHASE_CROSSOVER);
 
-      eval_num++;
+  pop->select_state = 0;
 
-      /* Skip to the next entity which needs evaluating. */
-      while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+  /* Select pairs of entities to mate via crossover. */
+  gaul_profile_start(pop, GA_PHASE_SELECTION);
+#pragma intel omp parallel taskq
+  while ( !(pop->select_two(pop, &mother, &father)) )
+    {
+    gaul_profile_stop(pop);
+
+    if (mother && father)
+      {
+#pragma intel omp task \
+  private(son,daughter) captureprivate(mother,father)
+        {
+        plog(LOG_VERBOSE, "Crossover between %d (rank %d fitness %f) and %d (rank %d fitness %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness,
+             ga_get_entity_id(pop, father),
+             ga_get_entity_rank(pop, father), father->fitness);
+
+        son = ga_get_free_entity(pop);
+        daughter = ga_get_free_entity(pop);
+        pop->crossover(pop, mother, father, daughter, son);
+        }
       }
     else
       {
-      pid[fork_num] = -1;
-      eid[fork_num] = -1;
-      num_forks--;
+      plog( LOG_VERBOSE, "Crossover not performed." );
       }
+
+    gaul_profile_start(pop, GA_PHASE_SELECTION);
     }
+  gaul_profile_stop(pop);
+
+  gaul_profile_stop(pop);
 
   return;
   }
-#endif
 
 
 /**********************************************************************
-  gaul_ensure_evaluations_threaded()
-  synopsis:	Fitness evaluations.
-		Evaluate all previously unevaluated entities.
-		No adaptation.
-		Threaded processing version.
+  gaul_mutation()
+  synopsis:	Mutation cycle.  (i.e. Asexual reproduction)
   parameters:	population *pop
   return:	none
-  last updated:	18 Sep 2002
+  last updated:	11 Jun 2002
  **********************************************************************/
 
-#ifdef HAVE_PTHREADS
-
-typedef struct threaddata_s
-  {
-  int thread_num;
-  int eval_num;
-  population *pop;
-  pthread_t pid;
-  } threaddata_t;
-
-/*
- * This is the child thread code used by gaul_ensure_evaluations_threaded(),
- * gaul_adapt_and_evaluate_threaded() and gaul_survival_threaded() to evaluate entities.
- */
-static void *_evaluation_thread( void *data )
+static void gaul_mutation(population *pop)
   {
-  int		eval_num = ((threaddata_t *)data)->eval_num;
-  population	*pop = ((threaddata_t *)data)->pop;
-
-  if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
-    pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
-
-#if GA_DEBUG>2
-printf("DEBUG: Thread %d has evaluated entity %d\n", ((threaddata_t *)data)->thread_num, eval_num);
-#endif
-
-  ((threaddata_t *)data)->thread_num = -1;	/* Signal that this thread is finished. */
-
-  pthread_exit(NULL);
+  entity	*mother;		/* Parent entities. */
+  entity	*daughter;		/* Child entities. */
 
-  return NULL;	/* Keep Compaq's C/C++ compiler happy. */
-  }
+  plog(LOG_VERBOSE, "*** Mutation cycle ***");
 
-static void gaul_ensure_evaluations_threaded( population *pop, const int max_threads, threaddata_t *threaddata )
-  {
-  int		thread_num;		/* Index of current thread. */
-  int		num_threads;		/* Number of threads currently in use. */
-  int		eval_num;		/* Index of current entity. */
+  if (pop->mutation_ratio <= 0.0) return;
 
-/*
- * A thread is created for each fitness evaluation upto
- * a maximum of max_threads at which point we wait for
- * results before continuing.
- *
- * Skip evaluations for entities that have been previously evaluated.
- */
-  thread_num = 0;
-  eval_num = 0;
+  gaul_profile_start(pop, GA_PHASE_MUTATION);
 
-  /* Skip to the next entity which needs evaluating. */
-  while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+  pop->select_state = 0;
 
-  while (thread_num < max_threads && eval_num < pop->size)
+  /*
+   * Select entities to undergo asexual reproduction, in each case the child will
+   * have a genetic mutation of some type.
+   */
+  gaul_profile_start(pop, GA_PHASE_SELECTION);
+#pragma intel omp parallel taskq
+  while ( !(pop->select_one(pop, &mother)) )
     {
-    threaddata[thread_num].thread_num = thread_num;
-    threaddata[thread_num].eval_num = eval_num;
-
-    if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
-      {       /* Error in thread creation. */
-      dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-      }
-
-    thread_num++;
-    eval_num++;
-
-    /* Skip to the next entity which needs evaluating. */
-    while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS)
-      eval_num++;
-    }
+    gaul_profile_stop(pop);
 
-  num_threads = thread_num;
-
-  /* Wait for a thread to finish and, if needed, create another. */
-  /* Also, find which entity this thread was evaluating. */
-  thread_num=0;
-  while (num_threads > 0)
-    {
-    while (threaddata[thread_num].thread_num >= 0)
+    if (mother)
       {
-      thread_num++;
-      if (thread_num==max_threads)
+#pragma intel omp task \
+  private(daughter) captureprivate(mother)
         {
-        thread_num=0;
-/* FIXME: Insert short sleep here? */
-        }
-      }
-
-#if GA_DEBUG>2
-printf("DEBUG: Thread %d finished.  num_threads=%d eval_num=%d/%d\n", thread_num, num_threads, eval_num, pop->size);
-#endif
-
-    if ( pthread_join(threaddata[thread_num].pid, NULL) < 0 )
-      {
-      dief("Error %d in pthread_join. (%s)", errno, errno==ESRCH?"ESRCH":errno==EINVAL?"EINVAL":errno==EDEADLK?"EDEADLK":"unknown");
-      }
-
-    if (eval_num < pop->size)
-      {       /* New thread. */
-      threaddata[thread_num].thread_num = thread_num;
-      threaddata[thread_num].eval_num = eval_num;
+        plog(LOG_VERBOSE, "Mutation of %d (rank %d fitness %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness );
 
-      if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
-        {       /* Error in thread creation. */
-        dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        daughter = ga_get_free_entity(pop);
+        pop->mutate(pop, mother, daughter);
         }
-
-      eval_num++;
-
-      /* Skip to the next entity which needs evaluating. */
-      while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS)
-        eval_num++;
       }
     else
       {
-      threaddata[thread_num].thread_num = 0;
-      threaddata[thread_num].eval_num = -1;
-      num_threads--;
+      plog( LOG_VERBOSE, "Mutation not performed." );
       }
+
+    gaul_profile_start(pop, GA_PHASE_SELECTION);
     }
+  gaul_profile_stop(pop);
+
+  gaul_profile_stop(pop);
 
   return;
   }
-#endif /* HAVE_PTHREADS */
 
 
 /**********************************************************************
-  gaul_adapt_and_evaluate()
-  synopsis:	Fitness evaluations.
-		Evaluate the new entities produced in the current
-		generation, whilst performing any necessary adaptation.
-		Simple sequential version.
+  gaul_evaluation_slave_mp()
+  synopsis:	Fitness evaluations and adaptations are performed here.
   parameters:	population *pop
   return:	none
-  last updated:	11 Jun 2002
+  last updated:	03 Feb 2003
  **********************************************************************/
 
-static void gaul_adapt_and_evaluate(population *pop)
+#ifdef HAVE_MPI
+static void gaul_evaluation_slave_mp(population *pop)
   {
-  int		i;			/* Loop variable over entity ranks. */
-  entity	*adult=NULL;		/* Adapted entity. */
-  int		adultrank;		/* Rank of adapted entity. */
-
-  if (pop->scheme == GA_SCHEME_DARWIN)
-    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
+  MPI_Status	status;			/* MPI status structure. */
+  int		single_int;		/* Receive buffer. */
+  gaulbyte		*buffer;		/* Receive buffer. */
+  boolean	finished=FALSE;		/* Whether this slave is done. */
+  entity	*entity, *adult;	/* Received entity, adapted entity. */
+  int	len=0;			/* Length of buffer to receive. */
 
-    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+/*
+ * Allocate receive buffer.
+ * FIXME: This length data shouldn't be needed!
+ */
+  MPI_Recv(&len, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+  if ( !(buffer = s_malloc(len*sizeof(gaulbyte))) )
+    die("Unable to allocate memory");
 
-#pragma omp parallel for \
-   shared(pop) private(i) \
-   schedule(static)
-    for (i=pop->orig_size; i<pop->size; i++)
-      {
-/*printf("DEBUG: gaul_adapt_and_evaluate() parallel for %d on %d/%d.\n", i, omp_get_thread_num(), omp_get_num_threads());*/
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
-        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
-      }
+/*printf("DEBUG: slave %d recieved %d (len)\n", rank, len);*/
 
-    return;
-    }
-  else
-    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
+/*
+ * Instruction packet.
+ */
+  do
+    {
+    MPI_Recv(&single_int, 1, MPI_INT, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
 
-    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
+/*printf("DEBUG: slave %d recieved %d (instruction)\n", rank, len);*/
 
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult) \
-   schedule(static)
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-#pragma omp master
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
+    switch (single_int)
       {
-#pragma omp parallel for \
-   shared(pop) private(i,adult,adultrank) \
-   schedule(static)
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-#pragma omp master
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
+      case 0:
+        /* Evaluation required. */
+        entity = ga_get_free_entity(pop);
+        MPI_Recv(buffer, len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        pop->chromosome_from_bytes(pop, entity, buffer);
+        if ( gaul_evaluate(pop, entity) == FALSE )
+          entity->fitness = GA_MIN_FITNESS;
+        MPI_Send(&(entity->fitness), 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
+        break;
+      case 1:
+        /* Baldwinian adaptation required. */
+        entity = ga_get_free_entity(pop);
+        MPI_Recv(buffer, len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        pop->chromosome_from_bytes(pop, entity, buffer);
+        adult = pop->adapt(pop, entity);
+        MPI_Send(&(adult->fitness), 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
+        break;
+      case 2:
+        /* Lamarkian adaptation required. */
+        entity = ga_get_free_entity(pop);
+        MPI_Recv(buffer, len, MPI_CHAR, 0, MPI_ANY_TAG, MPI_COMM_WORLD, &status);
+        pop->chromosome_from_bytes(pop, entity, buffer);
+        adult = pop->adapt(pop, entity);
+        MPI_Send(&(adult->fitness), 1, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD);
+        pop->chromosome_to_bytes(pop, adult, &buffer, &len);
+        MPI_Send(buffer, len, MPI_CHAR, 0, 0, MPI_COMM_WORLD);
+        break;
+      case 3:
+        /* No more jobs. */
+        finished=TRUE;
+        break;
+      default:
+        die("Unknown instruction packet recieved");
       }
 
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
-      { 
-#pragma omp parallel for \
-   shared(pop) private(i,adult) \
-   schedule(static)
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-#pragma omp master
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult,adultrank) \
-   schedule(static)
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-#pragma omp master
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
-    }
+    } while (finished==FALSE);
+
+/*
+ * Synchronise population on this process with that on the master process.
+ */
+  ga_genocide(pop,0);
+  ga_population_append_receive(pop, 0);
+
+  s_free(buffer);
 
   return;
   }
+#endif
 
 
 /**********************************************************************
-  gaul_adapt_and_evaluate_mp()
+  gaul_ensure_evaluations()
   synopsis:	Fitness evaluations.
-		Evaluate the new entities produced in the current
-		generation, whilst performing any necessary adaptation.
-		MPI version.
+		Evaluate all previously unevaluated entities.
+		No adaptation.
   parameters:	population *pop
   return:	none
-  last updated:	03 Feb 2003
+  last updated:	01 Jul 2004
  **********************************************************************/
 
-#ifdef HAVE_MPI
-static void gaul_adapt_and_evaluate_mp(population *pop)
+static void gaul_ensure_evaluations(population *pop)
   {
   int		i;			/* Loop variable over entity ranks. */
-  entity	*adult=NULL;		/* Adapted entity. */
-  int		adultrank;		/* Rank of adapted entity. */
-
-  plog(LOG_FIXME, "Need to parallelise this!");
-
-  if (pop->scheme == GA_SCHEME_DARWIN)
-    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
 
-    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+  gaul_profile_start(pop, GA_PHASE_EVALUATION);
 
 #pragma omp parallel for \
    shared(pop) private(i) \
    schedule(static)
-    for (i=pop->orig_size; i<pop->size; i++)
+  for (i=0; i<pop->size; i++)
+    {
+/*printf("DEBUG: gaul_ensure_evaluations() parallel for %d on %d/%d.\n", i, omp_get_thread_num(), omp_get_num_threads());*/
+    if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
       {
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
         pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
       }
-
-    return;
     }
-  else
-    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
 
-    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
+  gaul_profile_stop(pop);
 
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult) \
-   schedule(static)
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult,adultrank) \
-   schedule(static)
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
+  return;
+  }
 
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
-      { 
-#pragma omp parallel for \
-   shared(pop) private(i,adult) \
-   schedule(static)
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult,adultrank) \
-   schedule(static)
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
+
+/**********************************************************************
+  gaul_ensure_evaluations_mp()
+  synopsis:	Fitness evaluations.
+		Evaluate all previously unevaluated entities.
+		No adaptation.
+  parameters:	population *pop
+  return:	none
+  last updated:	03 Feb 2003
+ **********************************************************************/
+
+#ifdef HAVE_MPI
+static void gaul_ensure_evaluations_mp(population *pop)
+  {
+  int		i;			/* Loop variable over entity ranks. */
+
+  gaul_profile_start(pop, GA_PHASE_EVALUATION);
+
+  plog(LOG_FIXME, "Need to parallelise this!");
+
+  for (i=0; i<pop->size; i++)
+    {
+    if (pop->entity_iarray[i]->fitness == GA_MIN_FITNESS)
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
+        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
     }
 
+  gaul_profile_stop(pop);
+
   return;
   }
 #endif
 
 
 /**********************************************************************
-  gaul_adapt_and_evaluate_mpi()
+  gaul_ensure_evaluations_mpi()
   synopsis:	Fitness evaluations.
-		Evaluate the new entities produced in the current
-		generation, whilst performing any necessary adaptation.
-		MPI version.
+		Evaluate all previously unevaluated entities.
+		No adaptation.
   parameters:	population *pop
+		mpi_farm_t *farm
   return:	none
-  last updated:	24 Jun 2004
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 #ifdef HAVE_MPI
-static void gaul_adapt_and_evaluate_mpi( population *pop, int *eid,
-                        gaulbyte *buffer, int buffer_len, int buffer_max )
+static void gaul_ensure_evaluations_mpi(population *pop, mpi_farm_t *farm)
   {
-  int		i;			/* Loop variable over entity ranks. */
-  entity	*adult=NULL;		/* Adapted entity. */
-  int		adultrank;		/* Rank of adapted entity. */
-  MPI_Status	status;			/* MPI status structure. */
-  double	single_double;		/* Recieve buffer. */
-  int		instruction=2;		/* Detach instruction. */
-  int		mpi_size;		/* Number of slave processes. */
-  int		process_num;		/* Number of remote processes running calculations. */
-  int		eval_num;		/* Id of entity being processed. */
-  gaulbyte		*chromo=NULL;		/* Chromosome in byte form. */
 
-  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  gaul_profile_start(pop, GA_PHASE_EVALUATION);
 
-  if (pop->scheme == GA_SCHEME_DARWIN)
-    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
+  gaul_farm_submit_mpi(farm, pop, GA_TAG_EVALUATE, 0, pop->size, TRUE);
+  gaul_farm_wait_mpi(farm);
 
-    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+  gaul_profile_stop(pop);
 
-/*
- * A process is notifed to begin each fitness evaluation until
- * all processes are busy, at which point we wait for
- * results before initiating more.
- *
- * Skip evaluations for entities that have been previously evaluated.
- */
-    process_num = 0;
-    eval_num = pop->orig_size;	/* These solutions must already be evaluated. */
-
-    /* Skip to the next entity which needs evaluating. */
-    while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
-
-    while (process_num < mpi_size-1 && eval_num < pop->size)
-      {
-      eid[process_num] = eval_num;
-
-/* Send instruction and required data. */
-      MPI_Send(&instruction, 1, MPI_INT, process_num+1, GA_TAG_INSTRUCTION, MPI_COMM_WORLD);
-      if (buffer_max==0)
-        {
-        pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &chromo, &buffer_max);
-        MPI_Send(chromo, buffer_len, MPI_CHAR, process_num+1, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
-        }
-      else
-        {
-        pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &buffer, &buffer_len);
-        MPI_Send(buffer, buffer_len, MPI_CHAR, process_num+1, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
-        }
-
-      process_num++;
-      eval_num++;
-
-      /* Skip to the next entity which needs evaluating. */
-      while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
-      }
-
-    while (process_num > 0)
-      { /* Wait for a process to finish. */
-      MPI_Recv(&single_double, 1, MPI_DOUBLE, MPI_ANY_SOURCE, GA_TAG_FITNESS, MPI_COMM_WORLD, &status);
-      /* FIXME: Check status here. */
-
-      /* Find which entity this process was evaluating. */
-      if (eid[status.MPI_SOURCE-1] == -1) die("Internal error.  eid is -1");
-
-      pop->entity_iarray[eid[status.MPI_SOURCE-1]]->fitness = single_double;
-
-      if (eval_num < pop->size)
-        {
-        eid[status.MPI_SOURCE-1] = eval_num;
-
-        MPI_Send(&instruction, 1, MPI_INT, status.MPI_SOURCE, GA_TAG_INSTRUCTION, MPI_COMM_WORLD);
-        if (buffer_max==0)
-          {
-          pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &chromo, &buffer_max);
-          MPI_Send(chromo, buffer_len, MPI_CHAR, status.MPI_SOURCE, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
-          }
-        else
-          {
-          pop->chromosome_to_bytes(pop, pop->entity_iarray[eval_num], &buffer, &buffer_len);
-          MPI_Send(buffer, buffer_len, MPI_CHAR, status.MPI_SOURCE, GA_TAG_CHROMOSOMES, MPI_COMM_WORLD);
-          }
-
-        eval_num++;
-
-        /* Skip to the next entity which needs evaluating. */
-        while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
-        }
-      else
-        {
-        eid[status.MPI_SOURCE-1] = -1;
-        process_num--;
-        }
-      }
-
-    return;
-    }
-  else
-    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
-
-    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
-    plog(LOG_FIXME, "Need to parallelise this!");
-
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult) \
-   schedule(static)
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult,adultrank) \
-   schedule(static)
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
-
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
-      { 
-#pragma omp parallel for \
-   shared(pop) private(i,adult) \
-   schedule(static)
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
-      {
-#pragma omp parallel for \
-   shared(pop) private(i,adult,adultrank) \
-   schedule(static)
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
-    }
-
-  return;
-  }
-#endif
+  return;
+  }
+#endif
 
 
 /**********************************************************************
-  gaul_adapt_and_evaluate_forked()
+  gaul_ensure_evaluations_forked()
   synopsis:	Fitness evaluations.
-		Evaluate the new entities produced in the current
-		generation, whilst performing any necessary adaptation.
-		Forked processing version.
+		Evaluate all previously unevaluated entities.
+		No adaptation.
   parameters:	population *pop
   return:	none
-  last updated:	11 Jun 2002
+  last updated:	30 Jun 2002
  **********************************************************************/
 
 #ifndef W32_CRIPPLED
-static void gaul_adapt_and_evaluate_forked(population *pop,
-	       		const int num_processes,
+static void gaul_ensure_evaluations_forked(population *pop, const int num_processes,
 			int *eid, pid_t *pid, const int *evalpipe)
   {
-  int		i;			/* Loop variable over entity ranks. */
-  entity	*adult=NULL;		/* Adapted entity. */
-  int		adultrank;		/* Rank of adapted entity. */
   int		fork_num;		/* Index of current forked process. */
   int		num_forks;		/* Number of forked processes. */
   int		eval_num;		/* Index of current entity. */
   pid_t		fpid;			/* PID of completed child process. */
 
-  if (pop->scheme == GA_SCHEME_DARWIN)
-    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
-
-    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+  gaul_profile_start(pop, GA_PHASE_EVALUATION);
 
-/* 
+/*
  * A forked process is started for each fitness evaluation upto
- * a maximum of max_processes at which point we wait for 
+ * a maximum of max_processes at which point we wait for
  * results before forking more.
  *
- * FIXME: This lump of code is almost identical to that in
- * gaul_ensure_evaluations_forked() and shouldn't really be duplicated.
+ * Skip evaluations for entities that have been previously evaluated.
  */
+  fork_num = 0;
+  eval_num = 0;
+
+  /* Fork initial processes. */
+  /* Skip to the next entity which needs evaluating. */
+  while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+
+  while (fork_num < num_processes && eval_num < pop->size)
+    {
+    eid[fork_num] = eval_num;
+    pid[fork_num] = fork();
+    gaul_trace_fork(pid[fork_num]);
+
+    if (pid[fork_num] < 0)
+      {       /* Error in fork. */
+      dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+      }
+    else if (pid[fork_num] == 0)
+      {       /* This is the child process. */
+      if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+        pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+
+      write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+
+      fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
+      log_flush();
+      _exit(1);
+      }
+
+    fork_num++;
+    eval_num++;
+
+    /* Skip to the next entity which needs evaluating. */
+    while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+#ifdef NEED_MOSIX_FORK_HACK
+    usleep(10);
+#endif
+    }
+  num_forks = fork_num;
+
+  /* Wait for a forked process to finish and, if needed, fork another. */
+  while (num_forks > 0)
+    {
+    fpid = wait(NULL);
+
+    if (fpid == -1) die("Error in wait().");
+
+    gaul_trace_reap(fpid);
+
+    /* Find which entity this forked process was evaluating. */
     fork_num = 0;
-    eval_num = pop->orig_size;
+    while (fpid != pid[fork_num]) fork_num++;
 
-    /* Fork initial processes. */
-    while (fork_num < num_processes && eval_num < pop->size)
-      {
+    if (eid[fork_num] == -1) die("Internal error.  eid is -1");
+
+    read(evalpipe[2*fork_num], &(pop->entity_iarray[eid[fork_num]]->fitness), sizeof(double));
+    gaul_stats_invalidate(pop);
+
+    if (eval_num < pop->size)
+      {       /* New fork. */
       eid[fork_num] = eval_num;
       pid[fork_num] = fork();
+      gaul_trace_fork(pid[fork_num]);
 
       if (pid[fork_num] < 0)
-        {	/* Error in fork. */
+        {       /* Error in fork. */
         dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
         }
       else if (pid[fork_num] == 0)
-        {	/* This is the child process. */
-        if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+        {       /* This is the child process. */
+        if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
           pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
 
         write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
 
         fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
+        log_flush();
         _exit(1);
         }
-      fork_num++;
+
       eval_num++;
-#ifdef NEED_MOSIX_FORK_HACK
-      usleep(10);
-#endif
-      }
-    num_forks = fork_num;
 
-    /* Wait for a forked process to finish and, if needed, fork another. */
-    while (num_forks > 0)
+      /* Skip to the next entity which needs evaluating. */
+      while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
+      }
+    else
       {
-      fpid = wait(NULL);
+      pid[fork_num] = -1;
+      eid[fork_num] = -1;
+      num_forks--;
+      }
+    }
 
-      if (fpid == -1) die("Error in wait().");
+  gaul_profile_stop(pop);
 
-      /* Find which entity this forked process was evaluating. */
-      fork_num = 0;
-      while (fpid != pid[fork_num]) fork_num++;
+  return;
+  }
+#endif
 
-      if (eid[fork_num] == -1) die("Internal error.  eid is -1");
 
-      read(evalpipe[2*fork_num], &(pop->entity_iarray[eid[fork_num]]->fitness), sizeof(double));
+/**********************************************************************
+  gaul_ensure_evaluations_threaded()
+  synopsis:	Fitness evaluations.
+		Evaluate all previously unevaluated entities.
+		No adaptation.
+		Threaded processing version.
+  parameters:	population *pop
+  return:	none
+  last updated:	18 Sep 2002
+ **********************************************************************/
 
-      if (eval_num < pop->size)
-        {	/* New fork. */
-        eid[fork_num] = eval_num;
-        pid[fork_num] = fork();
+#ifdef HAVE_PTHREADS
 
-        if (pid[fork_num] < 0)
-          {       /* Error in fork. */
-          dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-          }
-        else if (pid[fork_num] == 0)
-          {       /* This is the child process. */
-          if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
-            pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+typedef struct threaddata_s
+  {
+  int thread_num;
+  int eval_num;
+  population *pop;
+  pthread_t pid;
+  } threaddata_t;
 
-          write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+/*
+ * This is the child thread code used by gaul_ensure_evaluations_threaded(),
+ * gaul_adapt_and_evaluate_threaded() and gaul_survival_threaded() to evaluate entities.
+ */
+static void *_evaluation_thread( void *data )
+  {
+  int		eval_num = ((threaddata_t *)data)->eval_num;
+  population	*pop = ((threaddata_t *)data)->pop;
 
-          fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
-          _exit(1);
-          }
-
-        eval_num++;
-        }
-      else
-        {
-        pid[fork_num] = -1;
-        eid[fork_num] = -1;
-        num_forks--;
-        }
-      }
-
-    return;
-    }
-  else
-    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
+  if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+    pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
 
-    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
+#if GA_DEBUG>2
+printf("DEBUG: Thread %d has evaluated entity %d\n", ((threaddata_t *)data)->thread_num, eval_num);
+#endif
 
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
-      {
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
-      {
-      for (i=0; i<pop->orig_size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
+  ((threaddata_t *)data)->thread_num = -1;	/* Signal that this thread is finished. */
 
-    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
-      { 
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        pop->entity_iarray[i]->fitness=adult->fitness;
-        ga_entity_dereference(pop, adult);
-        }
-      }
-    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
-      {
-      for (i=pop->orig_size; i<pop->size; i++)
-        {
-        adult = pop->adapt(pop, pop->entity_iarray[i]);
-        adultrank = ga_get_entity_rank(pop, adult);
-        gaul_entity_swap_rank(pop, i, adultrank);
-        ga_entity_dereference_by_rank(pop, adultrank);
-        }
-      }
-    }
+  pthread_exit(NULL);
 
-  return;
+  return NULL;	/* Keep Compaq's C/C++ compiler happy. */
   }
-#endif
 
-
-/**********************************************************************
-  gaul_adapt_and_evaluate_threaded()
-  synopsis:	Fitness evaluations.
-		Evaluate the new entities produced in the current
-		generation, whilst performing any necessary adaptation.
-		Threaded processing version.
-  parameters:	population *pop
-  return:	none
-  last updated:	15 Apr 2004
- **********************************************************************/
-
-#ifdef HAVE_PTHREADS
-static void gaul_adapt_and_evaluate_threaded(population *pop,
-	       		const int max_threads,
-			threaddata_t *threaddata)
+static void gaul_ensure_evaluations_threaded( population *pop, const int max_threads, threaddata_t *threaddata )
   {
-  int		i;			/* Loop variable over entity ranks. */
-  entity	*adult=NULL;		/* Adapted entity. */
-  int		adultrank;		/* Rank of adapted entity. */
   int		thread_num;		/* Index of current thread. */
   int		num_threads;		/* Number of threads currently in use. */
   int		eval_num;		/* Index of current entity. */
 
-  if (pop->scheme == GA_SCHEME_DARWIN)
-    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
-
-    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+  gaul_profile_start(pop, GA_PHASE_EVALUATION);
 
-/* 
+/*
  * A thread is created for each fitness evaluation upto
- * a maximum of max_threads at which point we wait for 
- * results before creating more.
+ * a maximum of max_threads at which point we wait for
+ * results before continuing.
  *
  * Skip evaluations for entities that have been previously evaluated.
- *
- * FIXME: This lump of code is almost identical to that in
- * gaul_ensure_evaluations_threaded() and shouldn't really be duplicated.
  */
   thread_num = 0;
   eval_num = 0;
@@ -1774,6 +1740,166 @@ printf("DEBUG: Thread %d finished.  num_threads=%d eval_num=%d/%d\n", thread_num
       }
     }
 
+  gaul_profile_stop(pop);
+
+  return;
+  }
+#endif /* HAVE_PTHREADS */
+
+
+/**********************************************************************
+  ga_evaluate_entities()
+  synopsis:	Fitness evaluations.
+		Evaluate an arbitrary list of entities, irrespective of
+		whether they have previously been evaluated, using upto
+		max_threads concurrent threads.  The calling thread
+		performs evaluations too.  Entities are claimed in
+		order, so slow evaluations do not hold up the others.
+		The population's evaluation callback must be
+		thread-safe if more than one thread is used.
+		Entities for which the evaluation callback returns
+		FALSE are assigned a fitness of GA_MIN_FITNESS.
+  parameters:	population *pop
+		entity **entities	Entities to evaluate.
+		const int num_entities	Number of entities.
+		const int max_threads	Upper limit on the number of
+					threads, or 0 to use the
+					GAUL_NUM_THREADS setting.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+typedef struct
+  {
+  population	*pop;
+  entity	**entities;
+  int		num_entities;
+  int		next;		/* Next unclaimed entity. */
+  THREAD_LOCK_DECLARE(lock);	/* Guards next. */
+  } evalbatch_t;
+
+static void *_evaluate_entities_thread( void *data )
+  {
+  evalbatch_t	*batch = (evalbatch_t *) data;
+  int		eval_num;	/* Index of current entity. */
+
+  while (TRUE)
+    {
+    THREAD_LOCK(batch->lock);
+    eval_num = batch->next++;
+    THREAD_UNLOCK(batch->lock);
+
+    if (eval_num >= batch->num_entities) break;
+
+    if ( gaul_evaluate(batch->pop, batch->entities[eval_num]) == FALSE )
+      batch->entities[eval_num]->fitness = GA_MIN_FITNESS;
+    }
+
+  return NULL;
+  }
+
+GAULFUNC void ga_evaluate_entities( population *pop, entity **entities,
+                                    const int num_entities, const int max_threads )
+  {
+  int		num_threads=max_threads;	/* Number of threads to use. */
+  char		*max_thread_str;	/* Value of environment variable. */
+  int		i;			/* Loop over entities/threads. */
+#ifdef HAVE_PTHREADS
+  evalbatch_t	batch;			/* Shared state. */
+  pthread_t	*tids;			/* Thread ids. */
+  int		err;			/* Error code from pthreads. */
+#endif
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (num_entities > 0 && !entities) die("Null pointer to entity array passed.");
+
+  if (num_threads == 0)
+    {
+    max_thread_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
+    if (max_thread_str) num_threads = atoi(max_thread_str);
+    if (num_threads <= 0) num_threads = GA_DEFAULT_NUM_THREADS;
+    }
+  if (num_threads > num_entities) num_threads = num_entities;
+
+#ifdef HAVE_PTHREADS
+  if (num_threads > 1)
+    {
+    batch.pop = pop;
+    batch.entities = entities;
+    batch.num_entities = num_entities;
+    batch.next = 0;
+    THREAD_LOCK_NEW(batch.lock);
+
+    if ( !(tids = s_malloc(sizeof(pthread_t)*(num_threads-1))) )
+      die("Unable to allocate memory");
+
+    for (i=0; i<num_threads-1; i++)
+      {
+      if ( (err = pthread_create(&(tids[i]), NULL, _evaluate_entities_thread, (void *)&batch)) != 0 )
+        dief("Error %d in pthread_create. (%s)", err, err==EAGAIN?"EAGAIN":err==ENOMEM?"ENOMEM":"unknown");
+      }
+
+    _evaluate_entities_thread((void *)&batch);
+
+    for (i=0; i<num_threads-1; i++)
+      {
+      if ( (err = pthread_join(tids[i], NULL)) != 0 )
+        dief("Error %d in pthread_join. (%s)", err, err==ESRCH?"ESRCH":err==EINVAL?"EINVAL":err==EDEADLK?"EDEADLK":"unknown");
+      }
+
+    s_free(tids);
+    THREAD_LOCK_FREE(batch.lock);
+
+    return;
+    }
+#endif
+
+  for (i=0; i<num_entities; i++)
+    {
+    if ( gaul_evaluate(pop, entities[i]) == FALSE )
+      entities[i]->fitness = GA_MIN_FITNESS;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_adapt_and_evaluate()
+  synopsis:	Fitness evaluations.
+		Evaluate the new entities produced in the current
+		generation, whilst performing any necessary adaptation.
+		Simple sequential version.
+  parameters:	population *pop
+  return:	none
+  last updated:	11 Jun 2002
+ **********************************************************************/
+
+static void gaul_adapt_and_evaluate(population *pop)
+  {
+  int		i;			/* Loop variable over entity ranks. */
+  entity	*adult=NULL;		/* Adapted entity. */
+  int		adultrank;		/* Rank of adapted entity. */
+
+  gaul_profile_start(pop, pop->scheme==GA_SCHEME_DARWIN?GA_PHASE_EVALUATION:GA_PHASE_ADAPTATION);
+
+  if (pop->scheme == GA_SCHEME_DARWIN)
+    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
+
+    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+
+#pragma omp parallel for \
+   shared(pop) private(i) \
+   schedule(static)
+    for (i=pop->orig_size; i<pop->size; i++)
+      {
+/*printf("DEBUG: gaul_adapt_and_evaluate() parallel for %d on %d/%d.\n", i, omp_get_thread_num(), omp_get_num_threads());*/
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
+        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
+      }
+
+    gaul_profile_stop(pop);
     return;
     }
   else
@@ -1783,338 +1909,216 @@ printf("DEBUG: Thread %d finished.  num_threads=%d eval_num=%d/%d\n", thread_num
 
     if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
       {
+#pragma omp parallel for \
+   shared(pop) private(i,adult) \
+   schedule(static)
       for (i=0; i<pop->orig_size; i++)
         {
         adult = pop->adapt(pop, pop->entity_iarray[i]);
         pop->entity_iarray[i]->fitness=adult->fitness;
+#pragma omp master
         ga_entity_dereference(pop, adult);
         }
       }
     else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
       {
+#pragma omp parallel for \
+   shared(pop) private(i,adult,adultrank) \
+   schedule(static)
       for (i=0; i<pop->orig_size; i++)
         {
         adult = pop->adapt(pop, pop->entity_iarray[i]);
         adultrank = ga_get_entity_rank(pop, adult);
         gaul_entity_swap_rank(pop, i, adultrank);
+#pragma omp master
         ga_entity_dereference_by_rank(pop, adultrank);
         }
       }
 
     if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
       { 
+#pragma omp parallel for \
+   shared(pop) private(i,adult) \
+   schedule(static)
       for (i=pop->orig_size; i<pop->size; i++)
         {
         adult = pop->adapt(pop, pop->entity_iarray[i]);
         pop->entity_iarray[i]->fitness=adult->fitness;
+#pragma omp master
         ga_entity_dereference(pop, adult);
         }
       }
     else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
       {
+#pragma omp parallel for \
+   shared(pop) private(i,adult,adultrank) \
+   schedule(static)
       for (i=pop->orig_size; i<pop->size; i++)
         {
         adult = pop->adapt(pop, pop->entity_iarray[i]);
         adultrank = ga_get_entity_rank(pop, adult);
         gaul_entity_swap_rank(pop, i, adultrank);
+#pragma omp master
         ga_entity_dereference_by_rank(pop, adultrank);
         }
       }
     }
 
+  gaul_profile_stop(pop);
+
   return;
   }
-#endif
 
 
 /**********************************************************************
-  gaul_survival()
-  synopsis:	Survival of the fittest.
-		Enforce elitism, reduce
-		population back to its stable size and rerank entities,
-		as required.
+  gaul_adapt_and_evaluate_mp()
+  synopsis:	Fitness evaluations.
+		Evaluate the new entities produced in the current
+		generation, whilst performing any necessary adaptation.
+		MPI version.
   parameters:	population *pop
   return:	none
-  last updated:	25 Apr 2005
+  last updated:	03 Feb 2003
  **********************************************************************/
 
-static void gaul_survival(population *pop)
+#ifdef HAVE_MPI
+static void gaul_adapt_and_evaluate_mp(population *pop)
   {
-  int		i, j, k;	/* Loop variable over entity ranks. */
-  boolean	save_entity;	/* Whether entity should survive. */
-  int		*set;		/* The best entities for each objective. */
-  boolean	*dominated;	/* Whether each entity is Pareto dominated. */
-  int		paretocount;	/* Size of Pareto set. */
-  boolean	dominance;	/* Used in determining dominance. */
+  int		i;			/* Loop variable over entity ranks. */
+  entity	*adult=NULL;		/* Adapted entity. */
+  int		adultrank;		/* Rank of adapted entity. */
 
-  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
+  gaul_profile_start(pop, pop->scheme==GA_SCHEME_DARWIN?GA_PHASE_EVALUATION:GA_PHASE_ADAPTATION);
 
-  if (pop->elitism == GA_ELITISM_PARENTS_SURVIVE)
-    {
-/*
- * Sort all population members by fitness.
- */
-    sort_population(pop);
+  plog(LOG_FIXME, "Need to parallelise this!");
 
-/*
- * Ensure that any very bad solutions are not retained.
- */
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+  if (pop->scheme == GA_SCHEME_DARWIN)
+    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
 
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-    ga_genocide(pop, pop->stable_size);
-    }
-  else if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
-    {
-    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
-      {
-      pop->orig_size--;
-      ga_entity_dereference_by_rank(pop, pop->orig_size);
-      }
-
-/*
- * Sort all population members by fitness.
- */
-    sort_population(pop);
-
-/*
- * Ensure that any very bad solutions are not retained.
- */
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-    ga_genocide(pop, pop->stable_size);
-    }
-  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
-    {
-    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
 
 #pragma omp parallel for \
    shared(pop) private(i) \
    schedule(static)
     for (i=pop->orig_size; i<pop->size; i++)
       {
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
         pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
       }
 
-/*
- * Sort all population members by fitness.
- */
-    sort_population(pop);
-
-/*
- * Ensure that any very bad solutions are not retained.
- */
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-    ga_genocide(pop, pop->stable_size);
+    gaul_profile_stop(pop);
+    return;
     }
-  else if (pop->elitism == GA_ELITISM_BEST_SET_SURVIVE)
-    {
-/* Find the best entities along each dimension of the fitness vector. */
-    if ( !(set = s_malloc(sizeof(int)*pop->fitness_dimensions)) )
-      die("Unable to allocate memory");
-
-/*
- * Sort all population members by fitness.
- */
-    sort_population(pop);
-
-/*
- * Ensure that any very bad solutions are not retained.
- */
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+  else
+    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
 
-    for (i=0; i<pop->fitness_dimensions; i++)
-      set[i]=0;
+    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
 
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
+      {
 #pragma omp parallel for \
-   shared(pop,set) private(i,j) \
+   shared(pop) private(i,adult) \
    schedule(static)
-    for (j=1; j<pop->size; j++)
-      {
-      for (i=0; i<pop->fitness_dimensions && set[i]==pop->orig_size; i++)
+      for (i=0; i<pop->orig_size; i++)
         {
-        if ( pop->entity_iarray[j]->fitvector[i] >
-             pop->entity_iarray[set[i]]->fitvector[i] )
-          set[i]=j;
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        pop->entity_iarray[i]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
         }
       }
-
-/* Allow all parents in the best set to survive.  Make up to
- * population's stable size with the fittest of the remainder.
- */
-    k=pop->size;
-    while (k > 0 && pop->size > pop->stable_size)
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
       {
-      k--;
-      save_entity = FALSE;
-      for (i=0; i<pop->fitness_dimensions; i++)
+#pragma omp parallel for \
+   shared(pop) private(i,adult,adultrank) \
+   schedule(static)
+      for (i=0; i<pop->orig_size; i++)
         {
-        if (set[i] == k)
-          save_entity = TRUE;
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, i, adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
         }
-      if ( save_entity == FALSE )
-        ga_entity_dereference_by_rank(pop, k);
       }
 
-    s_free(set);
-    }
-  else if (pop->elitism == GA_ELITISM_PARETO_SET_SURVIVE)
-    {
-/* 
- * Find the Pareto set (i.e., all non-dominated entities) according
- * to the fitness vector.  An entity is dominated if at least one other
- * entity is better in all objectives.
- */
-    if ( !(dominated = s_malloc(sizeof(int)*pop->size)) )
-      die("Unable to allocate memory");
-
-/*
- * Sort all population members by fitness.
- */
-    sort_population(pop);
-
-/*
- * Ensure that any very bad solutions are not retained.
- */
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-    paretocount=pop->size;
-
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
+      { 
 #pragma omp parallel for \
-   shared(pop,dominated) private(j) \
+   shared(pop) private(i,adult) \
    schedule(static)
-    for (j=0; j<pop->size; j++)
-      {
-      dominated[j] = FALSE;
+      for (i=pop->orig_size; i<pop->size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        pop->entity_iarray[i]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
+        }
       }
-
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
+      {
 #pragma omp parallel for \
-   shared(pop,paretocount,dominated) private(i,j,k,dominance) \
+   shared(pop) private(i,adult,adultrank) \
    schedule(static)
-    for (j=0; j<pop->size; j++)
-      {
-      for (k=0; k<pop->size && dominated[j] == FALSE; k++)
+      for (i=pop->orig_size; i<pop->size; i++)
         {
-        if ( k!=j )
-          {
-/* Is k better than j in all dimensions? */
-          dominance = TRUE;
-          for (i=0; i<pop->fitness_dimensions && dominance == TRUE; i++)
-            {
-            if ( pop->entity_iarray[j]->fitvector[i] >
-                 pop->entity_iarray[k]->fitvector[i] )
-              {
-              dominance = FALSE;
-              }
-            }
-          if (dominance == TRUE)
-            {
-            dominated[j] = TRUE;
-            paretocount--;
-            }
-          }
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, i, adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
         }
       }
-
-/* Debug message: */
-/*
-    printf("Pareto set contains %d entities: ", paretocount);
-    for (j=0; j<pop->size; j++)
-      {
-      if (dominated[j] == FALSE)
-        printf(" %d", j);
-      }
-    printf("\n");
-*/
-
-/*
- * Allow all entities in the Pareto set to survive.  Make up to
- * population's stable size with the fittest of the remainder.
- */
-    i = pop->size;
-    while ( i > 0 && pop->size > pop->stable_size )
-      {
-      i--;
-      if ( dominated[i] )
-        ga_entity_dereference_by_rank(pop, i);
-      }
-
-    s_free(dominated);
     }
 
+  gaul_profile_stop(pop);
+
   return;
   }
+#endif
 
 
 /**********************************************************************
-  gaul_survival_mp()
-  synopsis:	Survival of the fittest.
-		Enforce elitism, reduce
-		population back to its stable size and rerank entities,
-		as required.
+  gaul_adapt_and_evaluate_mpi()
+  synopsis:	Fitness evaluations.
+		Evaluate the new entities produced in the current
+		generation, whilst performing any necessary adaptation.
+		MPI version.  The work is only submitted; the caller
+		must use gaul_farm_wait_mpi() before the population is
+		sorted, so that evaluations may overlap with other
+		work.
   parameters:	population *pop
+		mpi_farm_t *farm
   return:	none
-  last updated:	18 Mar 2003
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 #ifdef HAVE_MPI
-static void gaul_survival_mp(population *pop)
+static void gaul_adapt_and_evaluate_mpi(population *pop, mpi_farm_t *farm)
   {
-  int		i;			/* Loop variable over entity ranks. */
 
-  plog(LOG_FIXME, "Need to parallelise this!");
+  gaul_profile_start(pop, pop->scheme==GA_SCHEME_DARWIN?GA_PHASE_EVALUATION:GA_PHASE_ADAPTATION);
 
-  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
+  if (pop->scheme == GA_SCHEME_DARWIN)
+    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
 
-/*
- * Need to kill parents, or rescore parents?
- */
-  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
-    {
-    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
-      {
-      pop->orig_size--;
-      ga_entity_dereference_by_rank(pop, pop->orig_size);
-      }
-    }
-  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
-    {
-    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
 
-#pragma omp parallel for \
-   shared(pop) private(i) \
-   schedule(static)
-    for (i=pop->orig_size; i<pop->size; i++)
-      {
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
-        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
-      }
+    gaul_farm_submit_mpi(farm, pop, GA_TAG_EVALUATE, pop->orig_size, pop->size, TRUE);
     }
+  else
+    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
 
-/*
- * Sort all population members by fitness.
- */
-  sort_population(pop);
+    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
 
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-  ga_genocide(pop, pop->stable_size);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
+      gaul_farm_submit_mpi(farm, pop, GA_TAG_BALDWIN, 0, pop->orig_size, FALSE);
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
+      gaul_farm_submit_mpi(farm, pop, GA_TAG_LAMARCK, 0, pop->orig_size, FALSE);
+
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
+      gaul_farm_submit_mpi(farm, pop, GA_TAG_BALDWIN, pop->orig_size, pop->size, FALSE);
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
+      gaul_farm_submit_mpi(farm, pop, GA_TAG_LAMARCK, pop->orig_size, pop->size, FALSE);
+    }
+
+  gaul_profile_stop(pop);
 
   return;
   }
@@ -2122,201 +2126,177 @@ static void gaul_survival_mp(population *pop)
 
 
 /**********************************************************************
-  gaul_survival_mpi()
-  synopsis:	Survival of the fittest.
-		Enforce elitism, reduce
-		population back to its stable size and rerank entities,
-		as required.
+  gaul_adapt_and_evaluate_forked()
+  synopsis:	Fitness evaluations.
+		Evaluate the new entities produced in the current
+		generation, whilst performing any necessary adaptation.
+		Forked processing version.
   parameters:	population *pop
   return:	none
-  last updated:	10 May 2004
- **********************************************************************/
-
-#ifdef HAVE_MPI
-static void gaul_survival_mpi(population *pop)
-  {
-  int		i;			/* Loop variable over entity ranks. */
-
-  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
-
-/*
- * Need to kill parents, or rescore parents?
- */
-  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
-    {
-    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
-      {
-      pop->orig_size--;
-      ga_entity_dereference_by_rank(pop, pop->orig_size);
-      }
-    }
-  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
-    {
-    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
-    plog(LOG_FIXME, "Need to parallelise this!");
-
-#pragma omp parallel for \
-   shared(pop) private(i) \
-   schedule(static)
-    for (i=pop->orig_size; i<pop->size; i++)
-      {
-      if ( pop->evaluate(pop, pop->entity_iarray[i]) == FALSE )
-        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
-      }
-    }
-
-/*
- * Sort all population members by fitness.
- */
-  sort_population(pop);
-
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-  ga_genocide(pop, pop->stable_size);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-  return;
-  }
-#endif
-
-
-/**********************************************************************
-  gaul_survival_forked()
-  synopsis:	Survival of the fittest.
-		Enforce elitism, reduce
-		population back to its stable size and rerank entities,
-		as required.
-		This is the forked processing version.
-  parameters:	population *pop
-  return:	none
-  last updated:	18 Mar 2003
+  last updated:	11 Jun 2002
  **********************************************************************/
 
 #ifndef W32_CRIPPLED
-static void gaul_survival_forked(population *pop,
-			const int num_processes,
+static void gaul_adapt_and_evaluate_forked(population *pop,
+	       		const int num_processes,
 			int *eid, pid_t *pid, const int *evalpipe)
   {
+  int		i;			/* Loop variable over entity ranks. */
+  entity	*adult=NULL;		/* Adapted entity. */
+  int		adultrank;		/* Rank of adapted entity. */
   int		fork_num;		/* Index of current forked process. */
   int		num_forks;		/* Number of forked processes. */
   int		eval_num;		/* Index of current entity. */
   pid_t		fpid;			/* PID of completed child process. */
 
-  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
+  gaul_profile_start(pop, pop->scheme==GA_SCHEME_DARWIN?GA_PHASE_EVALUATION:GA_PHASE_ADAPTATION);
 
-/*
- * Need to kill parents, or rescore parents?
- */
-  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
-    {
-    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
-      {
-      pop->orig_size--;
-      ga_entity_dereference_by_rank(pop, pop->orig_size);
-      }
-    }
-  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
-    {
-    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+  if (pop->scheme == GA_SCHEME_DARWIN)
+    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
 
-/*
+    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
+
+/* 
  * A forked process is started for each fitness evaluation upto
- * a maximum of max_processes at which point we wait for
+ * a maximum of max_processes at which point we wait for 
  * results before forking more.
+ *
+ * FIXME: This lump of code is almost identical to that in
+ * gaul_ensure_evaluations_forked() and shouldn't really be duplicated.
  */
-  fork_num = 0;
-  eval_num = 0;
+    fork_num = 0;
+    eval_num = pop->orig_size;
 
-  /* Fork initial processes. */
+    /* Fork initial processes. */
+    while (fork_num < num_processes && eval_num < pop->size)
+      {
+      eid[fork_num] = eval_num;
+      pid[fork_num] = fork();
+      gaul_trace_fork(pid[fork_num]);
 
-  while (fork_num < num_processes && eval_num < pop->orig_size)
-    {
-    eid[fork_num] = eval_num;
-    pid[fork_num] = fork();
+      if (pid[fork_num] < 0)
+        {	/* Error in fork. */
+        dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        }
+      else if (pid[fork_num] == 0)
+        {	/* This is the child process. */
+        if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+          pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
 
-    if (pid[fork_num] < 0)
-      {       /* Error in fork. */
-      dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+
+        fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
+        log_flush();
+        _exit(1);
+        }
+      fork_num++;
+      eval_num++;
+#ifdef NEED_MOSIX_FORK_HACK
+      usleep(10);
+#endif
       }
-    else if (pid[fork_num] == 0)
-      {       /* This is the child process. */
-      if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
-        pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+    num_forks = fork_num;
 
-      write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+    /* Wait for a forked process to finish and, if needed, fork another. */
+    while (num_forks > 0)
+      {
+      fpid = wait(NULL);
 
-      fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
-      _exit(1);
-      }
+      if (fpid == -1) die("Error in wait().");
 
-    fork_num++;
-    eval_num++;
+      gaul_trace_reap(fpid);
 
-#ifdef NEED_MOSIX_FORK_HACK
-    usleep(10);
-#endif
-    }
-  num_forks = fork_num;
+      /* Find which entity this forked process was evaluating. */
+      fork_num = 0;
+      while (fpid != pid[fork_num]) fork_num++;
 
-  /* Wait for a forked process to finish and, if needed, fork another. */
-  while (num_forks > 0)
-    {
-    fpid = wait(NULL);
+      if (eid[fork_num] == -1) die("Internal error.  eid is -1");
 
-    if (fpid == -1) die("Error in wait().");
+      read(evalpipe[2*fork_num], &(pop->entity_iarray[eid[fork_num]]->fitness), sizeof(double));
+      gaul_stats_invalidate(pop);
 
-    /* Find which entity this forked process was evaluating. */
-    fork_num = 0;
-    while (fpid != pid[fork_num]) fork_num++;
+      if (eval_num < pop->size)
+        {	/* New fork. */
+        eid[fork_num] = eval_num;
+        pid[fork_num] = fork();
+        gaul_trace_fork(pid[fork_num]);
 
-    if (eid[fork_num] == -1) die("Internal error.  eid is -1");
+        if (pid[fork_num] < 0)
+          {       /* Error in fork. */
+          dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+          }
+        else if (pid[fork_num] == 0)
+          {       /* This is the child process. */
+          if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+            pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
 
-    read(evalpipe[2*fork_num], &(pop->entity_iarray[eid[fork_num]]->fitness), sizeof(double));
+          write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
 
-    if (eval_num < pop->size)
-      {       /* New fork. */
-      eid[fork_num] = eval_num;
-      pid[fork_num] = fork();
+          fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
+          log_flush();
+          _exit(1);
+          }
 
-      if (pid[fork_num] < 0)
-        {       /* Error in fork. */
-        dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        eval_num++;
         }
-      else if (pid[fork_num] == 0)
-        {       /* This is the child process. */
-        if ( pop->evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
-          pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+      else
+        {
+        pid[fork_num] = -1;
+        eid[fork_num] = -1;
+        num_forks--;
+        }
+      }
 
-        write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+    gaul_profile_stop(pop);
+    return;
+    }
+  else
+    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
 
-        fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
-        _exit(1);
+    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
+
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
+      {
+      for (i=0; i<pop->orig_size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        pop->entity_iarray[i]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
+        }
+      }
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
+      {
+      for (i=0; i<pop->orig_size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, i, adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
         }
+      }
 
-      eval_num++;
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
+      { 
+      for (i=pop->orig_size; i<pop->size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        pop->entity_iarray[i]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
+        }
       }
-    else
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
       {
-      pid[fork_num] = -1;
-      eid[fork_num] = -1;
-      num_forks--;
+      for (i=pop->orig_size; i<pop->size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, i, adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
+        }
       }
     }
-    }
-
-/*
- * Sort all population members by fitness.
- */
-  sort_population(pop);
 
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-  ga_genocide(pop, pop->stable_size);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+  gaul_profile_stop(pop);
 
   return;
   }
@@ -2324,733 +2304,873 @@ static void gaul_survival_forked(population *pop,
 
 
 /**********************************************************************
-  gaul_survival_threaded()
-  synopsis:	Survival of the fittest.
-		Enforce elitism, reduce
-		population back to its stable size and rerank entities,
-		as required.
-		This is the threaded processing version.
+  gaul_adapt_and_evaluate_threaded()
+  synopsis:	Fitness evaluations.
+		Evaluate the new entities produced in the current
+		generation, whilst performing any necessary adaptation.
+		Threaded processing version.
   parameters:	population *pop
   return:	none
-  last updated:	18 Mar 2003
+  last updated:	15 Apr 2004
  **********************************************************************/
 
 #ifdef HAVE_PTHREADS
-static void gaul_survival_threaded(population *pop,
-			const int max_threads,
+static void gaul_adapt_and_evaluate_threaded(population *pop,
+	       		const int max_threads,
 			threaddata_t *threaddata)
   {
+  int		i;			/* Loop variable over entity ranks. */
+  entity	*adult=NULL;		/* Adapted entity. */
+  int		adultrank;		/* Rank of adapted entity. */
   int		thread_num;		/* Index of current thread. */
   int		num_threads;		/* Number of threads currently in use. */
   int		eval_num;		/* Index of current entity. */
 
-  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
+  gaul_profile_start(pop, pop->scheme==GA_SCHEME_DARWIN?GA_PHASE_EVALUATION:GA_PHASE_ADAPTATION);
 
-/*
- * Need to kill parents, or rescore parents?
- */
-  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
-    {
-    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
-      {
-      pop->orig_size--;
-      ga_entity_dereference_by_rank(pop, pop->orig_size);
-      }
-    }
-  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
-    {
+  if (pop->scheme == GA_SCHEME_DARWIN)
+    {	/* This is pure Darwinian evolution.  Simply assess fitness of all children.  */
 
-    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+    plog(LOG_VERBOSE, "*** Fitness Evaluations ***");
 
-/*
+/* 
  * A thread is created for each fitness evaluation upto
- * a maximum of max_threads at which point we wait for
- * results before continuing.
+ * a maximum of max_threads at which point we wait for 
+ * results before creating more.
  *
  * Skip evaluations for entities that have been previously evaluated.
+ *
+ * FIXME: This lump of code is almost identical to that in
+ * gaul_ensure_evaluations_threaded() and shouldn't really be duplicated.
  */
-    thread_num = 0;
-    eval_num = 0;
+  thread_num = 0;
+  eval_num = 0;
 
-    while (thread_num < max_threads && eval_num < pop->orig_size)
-      {
-      threaddata[thread_num].thread_num = thread_num;
-      threaddata[thread_num].eval_num = eval_num;
+  /* Skip to the next entity which needs evaluating. */
+  while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS) eval_num++;
 
-      if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
-        {       /* Error in thread creation. */
-        dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-        }
+  while (thread_num < max_threads && eval_num < pop->size)
+    {
+    threaddata[thread_num].thread_num = thread_num;
+    threaddata[thread_num].eval_num = eval_num;
 
-      thread_num++;
-      eval_num++;
+    if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
+      {       /* Error in thread creation. */
+      dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
       }
 
-    num_threads = thread_num;
+    thread_num++;
+    eval_num++;
+
+    /* Skip to the next entity which needs evaluating. */
+    while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS)
+      eval_num++;
+    }
+
+  num_threads = thread_num;
 
   /* Wait for a thread to finish and, if needed, create another. */
   /* Also, find which entity this thread was evaluating. */
-    thread_num=0;
-    while (num_threads > 0)
+  thread_num=0;
+  while (num_threads > 0)
+    {
+    while (threaddata[thread_num].thread_num >= 0)
       {
-      while (threaddata[thread_num].thread_num >= 0)
+      thread_num++;
+      if (thread_num==max_threads)
         {
-        thread_num++;
-        if (thread_num==max_threads)
-          {
-          thread_num=0;
+        thread_num=0;
 /* FIXME: Insert short sleep here? */
-          }
         }
+      }
 
 #if GA_DEBUG>2
 printf("DEBUG: Thread %d finished.  num_threads=%d eval_num=%d/%d\n", thread_num, num_threads, eval_num, pop->size);
 #endif
 
-      if ( pthread_join(threaddata[thread_num].pid, NULL) < 0 )
-        {
-        dief("Error %d in pthread_join. (%s)", errno, errno==ESRCH?"ESRCH":errno==EINVAL?"EINVAL":errno==EDEADLK?"EDEADLK":"unknown");
-        }
+    if ( pthread_join(threaddata[thread_num].pid, NULL) < 0 )
+      {
+      dief("Error %d in pthread_join. (%s)", errno, errno==ESRCH?"ESRCH":errno==EINVAL?"EINVAL":errno==EDEADLK?"EDEADLK":"unknown");
+      }
 
-      if (eval_num < pop->orig_size)
-        {       /* New thread. */
-        threaddata[thread_num].thread_num = thread_num;
-        threaddata[thread_num].eval_num = eval_num;
+    if (eval_num < pop->size)
+      {       /* New thread. */
+      threaddata[thread_num].thread_num = thread_num;
+      threaddata[thread_num].eval_num = eval_num;
 
-        if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
-          {       /* Error in thread creation. */
-          dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-          }
+      if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
+        {       /* Error in thread creation. */
+        dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        }
+
+      eval_num++;
 
+      /* Skip to the next entity which needs evaluating. */
+      while (eval_num < pop->size && pop->entity_iarray[eval_num]->fitness!=GA_MIN_FITNESS)
         eval_num++;
+      }
+    else
+      {
+      threaddata[thread_num].thread_num = 0;
+      threaddata[thread_num].eval_num = -1;
+      num_threads--;
+      }
+    }
+
+    gaul_profile_stop(pop);
+    return;
+    }
+  else
+    {	/* Some kind of adaptation is required.  First reevaluate parents, as needed, then children. */
+
+    plog(LOG_VERBOSE, "*** Adaptation and Fitness Evaluations ***");
+
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_PARENTS)!=0 )
+      {
+      for (i=0; i<pop->orig_size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        pop->entity_iarray[i]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
         }
-      else
+      }
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_PARENTS)!=0 )
+      {
+      for (i=0; i<pop->orig_size; i++)
         {
-        threaddata[thread_num].thread_num = 0;
-        threaddata[thread_num].eval_num = -1;
-        num_threads--;
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, i, adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
         }
       }
 
+    if ( (pop->scheme & GA_SCHEME_BALDWIN_CHILDREN)!=0 )
+      { 
+      for (i=pop->orig_size; i<pop->size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        pop->entity_iarray[i]->fitness=adult->fitness;
+        ga_entity_dereference(pop, adult);
+        }
+      }
+    else if ( (pop->scheme & GA_SCHEME_LAMARCK_CHILDREN)!=0 )
+      {
+      for (i=pop->orig_size; i<pop->size; i++)
+        {
+        adult = pop->adapt(pop, pop->entity_iarray[i]);
+        adultrank = ga_get_entity_rank(pop, adult);
+        gaul_entity_swap_rank(pop, i, adultrank);
+        ga_entity_dereference_by_rank(pop, adultrank);
+        }
+      }
     }
 
-/*
- * Sort all population members by fitness.
- */
-  sort_population(pop);
-
-/*
- * Least fit population members die to restore the
- * population size to its stable size.
- */
-  ga_genocide(pop, pop->stable_size);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+  gaul_profile_stop(pop);
 
   return;
   }
-#endif /* HAVE_PTHREADS */
+#endif
 
 
 /**********************************************************************
-  ga_evolution()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.
-		This is a generation-based GA.
-		ga_genesis(), or equivalent, must be called prior to
-		this function.
-  parameters:
-  return:
-  last updated:	17 Feb 2005
+  gaul_survival()
+  synopsis:	Survival of the fittest.
+		Enforce elitism, reduce
+		population back to its stable size and rerank entities,
+		as required.
+  parameters:	population *pop
+  return:	none
+  last updated:	25 Apr 2005
  **********************************************************************/
 
-GAULFUNC int ga_evolution(	population		*pop,
-			const int		max_generations )
+static void gaul_survival(population *pop)
   {
-  int		generation=0;		/* Current generation number. */
-
-/* Checks. */
-  if (!pop) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
-  if (!pop->crossover) die("Population's crossover callback is undefined.");
-  if (!pop->rank) die("Population's ranking callback is undefined.");
-  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+  int		i, j, k;	/* Loop variable over entity ranks. */
+  boolean	save_entity;	/* Whether entity should survive. */
+  int		*set;		/* The best entities for each objective. */
+  boolean	*dominated;	/* Whether each entity is Pareto dominated. */
+  int		paretocount;	/* Size of Pareto set. */
+  boolean	dominance;	/* Used in determining dominance. */
 
-  plog(LOG_VERBOSE, "The evolution has begun!");
+  gaul_profile_start(pop, GA_PHASE_SURVIVAL);
 
-  pop->generation = 0;
+  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
 
+  if (pop->elitism == GA_ELITISM_PARENTS_SURVIVE)
+    {
 /*
- * Score and sort the initial population members.
+ * Sort all population members by fitness.
  */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations(pop);
-  sort_population(pop);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-  plog( LOG_VERBOSE,
-        "Prior to the first generation, population has fitness scores between %f and %f",
-        pop->entity_iarray[0]->fitness,
-        pop->entity_iarray[pop->size-1]->fitness );
+    sort_population(pop);
 
 /*
- * Do all the generations:
- *
- * Stop when (a) max_generations reached, or
- *           (b) "pop->generation_hook" returns FALSE.
+ * Ensure that any very bad solutions are not retained.
  */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
-           generation<max_generations )
-    {
-    generation++;
-    pop->generation = generation;
-    pop->orig_size = pop->size;
-
-    plog(LOG_DEBUG,
-              "Population size is %d at start of generation %d",
-              pop->orig_size, generation );
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
 /*
- * Crossover step.
+ * Least fit population members die to restore the
+ * population size to its stable size.
  */
-    gaul_crossover(pop);
+    ga_genocide(pop, pop->stable_size);
+    }
+  else if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
+    {
+    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
+      {
+      pop->orig_size--;
+      ga_entity_dereference_by_rank(pop, pop->orig_size);
+      }
 
 /*
- * Mutation step.
+ * Sort all population members by fitness.
  */
-    gaul_mutation(pop);
+    sort_population(pop);
 
 /*
- * Apply environmental adaptations, score entities, sort entities, etc.
+ * Ensure that any very bad solutions are not retained.
  */
-    gaul_adapt_and_evaluate(pop);
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
 /*
- * Survival of the fittest.
+ * Least fit population members die to restore the
+ * population size to its stable size.
  */
-    gaul_survival(pop);
+    ga_genocide(pop, pop->stable_size);
+    }
+  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
+    {
+    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+
+#pragma omp parallel for \
+   shared(pop) private(i) \
+   schedule(static)
+    for (i=pop->orig_size; i<pop->size; i++)
+      {
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
+        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
+      }
 
 /*
- * End of generation.
+ * Niching must see the new fitnesses.
  */
-    plog(LOG_VERBOSE,
-          "After generation %d, population has fitness scores between %f and %f",
-          generation,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
-
-    }	/* Generation loop. */
-
-  return generation;
-  }
-
-
-/**********************************************************************
-  ga_evolution_forked()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.  This is a
-		generation-based GA.  ga_genesis(), or equivalent,
-		must be called prior to this function.
-
-		This function is like ga_evolution(), except that all
-		fitness evaluations will be performed in forked
-		processes which is ideal for use on multiprocessor
-		machines or Beowulf-style clusters with process
-		migration e.g. Mosix ( http://www.mosix.org/ ) or
-		openMosix ( http://openmosix.sourceforge.net/ )
-
-		Thanks go to Syrrx, Inc. who, in essence, funded
-		development of this function.
-
-  parameters:
-  return:	Number of generations performed.
-  last updated:	17 Feb 2005
- **********************************************************************/
-
-#ifndef W32_CRIPPLED
-GAULFUNC int ga_evolution_forked(	population		*pop,
-				const int		max_generations )
-  {
-  int		generation=0;		/* Current generation number. */
-  int		i;			/* Loop over members of population or pipes. */
-  int		*evalpipe;		/* Pipes for returning fitnesses. */
-  pid_t		*pid;			/* Child PIDs. */
-  int		*eid;			/* Entity which forked process is evaluating. */
-  int		max_processes=0;	/* Maximum number of processes to fork at one time. */
-  char		*max_proc_str;		/* Value of enviroment variable. */
+    gaul_niche_readjust(pop);
 
-/* Checks. */
-  if (!pop) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
-  if (!pop->crossover) die("Population's crossover callback is undefined.");
-  if (!pop->rank) die("Population's ranking callback is undefined.");
-  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
-  
 /*
- * Look at environment to find number of processes to fork.
+ * Sort all population members by fitness.
  */
-  max_proc_str = getenv(GA_NUM_PROCESSES_ENVVAR_STRING);
-  if (max_proc_str) max_processes = atoi(max_proc_str);
-  if (max_processes == 0) max_processes = GA_DEFAULT_NUM_PROCESSES;
-
-  plog(LOG_VERBOSE, "The evolution has begun!  Upto %d processes will be fork'ed", max_processes);
-
-  pop->generation = 0;
+    sort_population(pop);
 
 /*
- * Allocate memory required for handling the forked processes.
- * Open pipes for reporting fitnesses.
- * Clear pid and eid arrays.
+ * Ensure that any very bad solutions are not retained.
  */
-  if ( !(pid = s_malloc(max_processes*sizeof(pid_t))) )
-    die("Unable to allocate memory");
-  if ( !(eid = s_malloc(max_processes*sizeof(int))) )
-    die("Unable to allocate memory");
-  if ( !(evalpipe = s_malloc(2*max_processes*sizeof(int))) )
-    die("Unable to allocate memory");
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-  for (i=0; i<max_processes; i++)
-    {
-    if (pipe(&evalpipe[2*i])==-1) die("Unable to open pipe");
-    pid[i] = -1;
-    eid[i] = -1;
+/*
+ * Least fit population members die to restore the
+ * population size to its stable size.
+ */
+    ga_genocide(pop, pop->stable_size);
     }
+  else if (pop->elitism == GA_ELITISM_BEST_SET_SURVIVE)
+    {
+/* Find the best entities along each dimension of the fitness vector. */
+    if ( !(set = s_malloc(sizeof(int)*pop->fitness_dimensions)) )
+      die("Unable to allocate memory");
 
 /*
- * Score and sort the initial population members.
+ * Sort all population members by fitness.
  */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations_forked(pop, max_processes, eid, pid, evalpipe);
-  sort_population(pop);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-  plog( LOG_VERBOSE,
-        "Prior to the first generation, population has fitness scores between %f and %f",
-        pop->entity_iarray[0]->fitness,
-        pop->entity_iarray[pop->size-1]->fitness );
+    sort_population(pop);
 
 /*
- * Do all the generations:
- *
- * Stop when (a) max_generations reached, or
- *           (b) "pop->generation_hook" returns FALSE.
+ * Ensure that any very bad solutions are not retained.
  */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
-           generation<max_generations )
-    {
-    generation++;
-    pop->generation = generation;
-    pop->orig_size = pop->size;
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-    plog(LOG_DEBUG,
-              "Population size is %d at start of generation %d",
-              pop->orig_size, generation );
+    for (i=0; i<pop->fitness_dimensions; i++)
+      set[i]=0;
 
-/*
- * Crossover step.
- */
-    gaul_crossover(pop);
+#pragma omp parallel for \
+   shared(pop,set) private(i,j) \
+   schedule(static)
+    for (j=1; j<pop->size; j++)
+      {
+      for (i=0; i<pop->fitness_dimensions && set[i]==pop->orig_size; i++)
+        {
+        if ( pop->entity_iarray[j]->fitvector[i] >
+             pop->entity_iarray[set[i]]->fitvector[i] )
+          set[i]=j;
+        }
+      }
 
-/*
- * Mutation step.
+/* Allow all parents in the best set to survive.  Make up to
+ * population's stable size with the fittest of the remainder.
  */
-    gaul_mutation(pop);
+    k=pop->size;
+    while (k > 0 && pop->size > pop->stable_size)
+      {
+      k--;
+      save_entity = FALSE;
+      for (i=0; i<pop->fitness_dimensions; i++)
+        {
+        if (set[i] == k)
+          save_entity = TRUE;
+        }
+      if ( save_entity == FALSE )
+        ga_entity_dereference_by_rank(pop, k);
+      }
 
-/*
- * Score all child entities from this generation.
+    s_free(set);
+    }
+  else if (pop->elitism == GA_ELITISM_PARETO_SET_SURVIVE)
+    {
+/* 
+ * Find the Pareto set (i.e., all non-dominated entities) according
+ * to the fitness vector.  An entity is dominated if at least one other
+ * entity is better in all objectives.
  */
-    gaul_adapt_and_evaluate_forked(pop, max_processes, eid, pid, evalpipe);
+    if ( !(dominated = s_malloc(sizeof(int)*pop->size)) )
+      die("Unable to allocate memory");
 
 /*
- * Apply survival pressure.
+ * Sort all population members by fitness.
  */
-    gaul_survival_forked(pop, max_processes, eid, pid, evalpipe);
-
-    plog(LOG_VERBOSE,
-          "After generation %d, population has fitness scores between %f and %f",
-          generation,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
-
-    }	/* Main generation loop. */
+    sort_population(pop);
 
 /*
- * Close the pipes and free memory.
+ * Ensure that any very bad solutions are not retained.
  */
-  for (i=0; i<max_processes; i++)
-    {
-    close(evalpipe[2*i]);
-    close(evalpipe[2*i+1]);
-    }
-
-  s_free(pid);
-  s_free(eid);
-  s_free(evalpipe);
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-  return generation;
-  }
-#else
-GAULFUNC int ga_evolution_forked(	population		*pop,
-				const int		max_generations )
-  {
-  die("Sorry, the ga_evolution_forked() function isn't available for Windows.");
-  return 0;
-  }
-#endif
+    paretocount=pop->size;
 
+#pragma omp parallel for \
+   shared(pop,dominated) private(j) \
+   schedule(static)
+    for (j=0; j<pop->size; j++)
+      {
+      dominated[j] = FALSE;
+      }
 
-/**********************************************************************
-  ga_evolution_threaded()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.  This is a
-		generation-based GA.  ga_genesis(), or equivalent,
-		must be called prior to this function.
+#pragma omp parallel for \
+   shared(pop,paretocount,dominated) private(i,j,k,dominance) \
+   schedule(static)
+    for (j=0; j<pop->size; j++)
+      {
+      for (k=0; k<pop->size && dominated[j] == FALSE; k++)
+        {
+        if ( k!=j )
+          {
+/* Is k better than j in all dimensions? */
+          dominance = TRUE;
+          for (i=0; i<pop->fitness_dimensions && dominance == TRUE; i++)
+            {
+            if ( pop->entity_iarray[j]->fitvector[i] >
+                 pop->entity_iarray[k]->fitvector[i] )
+              {
+              dominance = FALSE;
+              }
+            }
+          if (dominance == TRUE)
+            {
+            dominated[j] = TRUE;
+            paretocount--;
+            }
+          }
+        }
+      }
 
-		This function is like ga_evolution(), except that all
-		fitness evaluations will be performed in threads
-		and is therefore ideal for use on SMP multiprocessor
-		machines or multipipelined processors (e.g. the new
-		Intel Xeons).
+/* Debug message: */
+/*
+    printf("Pareto set contains %d entities: ", paretocount);
+    for (j=0; j<pop->size; j++)
+      {
+      if (dominated[j] == FALSE)
+        printf(" %d", j);
+      }
+    printf("\n");
+*/
 
-  parameters:
-  return:	Number of generations performed.
-  last updated:	17 Feb 2005
+/*
+ * Allow all entities in the Pareto set to survive.  Make up to
+ * population's stable size with the fittest of the remainder.
+ */
+    i = pop->size;
+    while ( i > 0 && pop->size > pop->stable_size )
+      {
+      i--;
+      if ( dominated[i] )
+        ga_entity_dereference_by_rank(pop, i);
+      }
+
+    s_free(dominated);
+    }
+
+  gaul_profile_stop(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_survival_mp()
+  synopsis:	Survival of the fittest.
+		Enforce elitism, reduce
+		population back to its stable size and rerank entities,
+		as required.
+  parameters:	population *pop
+  return:	none
+  last updated:	18 Mar 2003
  **********************************************************************/
 
-#ifdef HAVE_PTHREADS
-GAULFUNC int ga_evolution_threaded(	population		*pop,
-				const int		max_generations )
+#ifdef HAVE_MPI
+static void gaul_survival_mp(population *pop)
   {
-  int		generation=0;		/* Current generation number. */
-  int		max_threads=0;		/* Maximum number of threads to use at one time. */
-  char		*max_thread_str;	/* Value of enviroment variable. */
-  threaddata_t	*threaddata;		/* Used for passing data to threads. */
-  int		i;			/* Loop over threaddata elements. */
+  int		i;			/* Loop variable over entity ranks. */
 
-/* Checks. */
-  if (!pop) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
-  if (!pop->crossover) die("Population's crossover callback is undefined.");
-  if (!pop->rank) die("Population's ranking callback is undefined.");
-  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
-  
-/*
- * Look at environment to find number of threads to use.
- */
-  max_thread_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
-  if (max_thread_str) max_threads = atoi(max_thread_str);
-  if (max_threads == 0) max_threads = GA_DEFAULT_NUM_THREADS;
+  gaul_profile_start(pop, GA_PHASE_SURVIVAL);
 
-  plog(LOG_VERBOSE, "The evolution has begun!  Upto %d threads will be created", max_threads);
+  plog(LOG_FIXME, "Need to parallelise this!");
+
+  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
 
 /*
- * Allocate memory required for handling the threads.
+ * Need to kill parents, or rescore parents?
  */
-  if ( !(threaddata = s_malloc(sizeof(threaddata_t)*max_threads)) )
-    die("Unable to allocate memory");
+  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
+    {
+    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
+      {
+      pop->orig_size--;
+      ga_entity_dereference_by_rank(pop, pop->orig_size);
+      }
+    }
+  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
+    {
+    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
 
-  for (i=0; i<max_threads; i++)
-    threaddata[i].pop = pop;
+#pragma omp parallel for \
+   shared(pop) private(i) \
+   schedule(static)
+    for (i=pop->orig_size; i<pop->size; i++)
+      {
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
+        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
+      }
 
-  pop->generation = 0;
+/*
+ * Niching must see the new fitnesses.
+ */
+    gaul_niche_readjust(pop);
+    }
 
 /*
- * Score and sort the initial population members.
+ * Sort all population members by fitness.
  */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations_threaded(pop, max_threads, threaddata);
   sort_population(pop);
+
+/*
+ * Least fit population members die to restore the
+ * population size to its stable size.
+ */
+  ga_genocide(pop, pop->stable_size);
   ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-  plog( LOG_VERBOSE,
-        "Prior to the first generation, population has fitness scores between %f and %f",
-        pop->entity_iarray[0]->fitness,
-        pop->entity_iarray[pop->size-1]->fitness );
+  gaul_profile_stop(pop);
+
+  return;
+  }
+#endif
+
+
+/**********************************************************************
+  gaul_survival_mpi()
+  synopsis:	Survival of the fittest.
+		Enforce elitism, reduce
+		population back to its stable size and rerank entities,
+		as required.
+  parameters:	population *pop
+  return:	none
+  last updated:	10 May 2004
+ **********************************************************************/
+
+#ifdef HAVE_MPI
+static void gaul_survival_mpi(population *pop)
+  {
+  int		i;			/* Loop variable over entity ranks. */
+
+  gaul_profile_start(pop, GA_PHASE_SURVIVAL);
+
+  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
 
 /*
- * Do all the generations:
- *
- * Stop when (a) max_generations reached, or
- *           (b) "pop->generation_hook" returns FALSE.
+ * Need to kill parents, or rescore parents?
  */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
-           generation<max_generations )
+  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
     {
-    generation++;
-    pop->generation = generation;
-    pop->orig_size = pop->size;
+    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
+      {
+      pop->orig_size--;
+      ga_entity_dereference_by_rank(pop, pop->orig_size);
+      }
+    }
+  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
+    {
+    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+    plog(LOG_FIXME, "Need to parallelise this!");
 
-    plog(LOG_DEBUG,
-              "Population size is %d at start of generation %d",
-              pop->orig_size, generation );
+#pragma omp parallel for \
+   shared(pop) private(i) \
+   schedule(static)
+    for (i=pop->orig_size; i<pop->size; i++)
+      {
+      if ( gaul_evaluate(pop, pop->entity_iarray[i]) == FALSE )
+        pop->entity_iarray[i]->fitness = GA_MIN_FITNESS;
+      }
 
 /*
- * Crossover step.
+ * Niching must see the new fitnesses.
  */
-    gaul_crossover(pop);
+    gaul_niche_readjust(pop);
+    }
 
 /*
- * Mutation step.
+ * Sort all population members by fitness.
  */
-    gaul_mutation(pop);
+  sort_population(pop);
 
 /*
- * Score all child entities from this generation.
+ * Least fit population members die to restore the
+ * population size to its stable size.
  */
-    gaul_adapt_and_evaluate_threaded(pop, max_threads, threaddata);
+  ga_genocide(pop, pop->stable_size);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-/*
- * Apply survival pressure.
- */
-    gaul_survival_threaded(pop, max_threads, threaddata);
+  gaul_profile_stop(pop);
 
-    plog(LOG_VERBOSE,
-          "After generation %d, population has fitness scores between %f and %f",
-          generation,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+  return;
+  }
+#endif
 
-    }	/* Main generation loop. */
 
-/* Free memory used for storing thread information. */
-  s_free(threaddata);
+/**********************************************************************
+  gaul_survival_forked()
+  synopsis:	Survival of the fittest.
+		Enforce elitism, reduce
+		population back to its stable size and rerank entities,
+		as required.
+		This is the forked processing version.
+  parameters:	population *pop
+  return:	none
+  last updated:	18 Mar 2003
+ **********************************************************************/
 
-  return generation;
-  }
-#else
-GAULFUNC int ga_evolution_threaded(	population		*pop,
-				const int		max_generations )
+#ifndef W32_CRIPPLED
+static void gaul_survival_forked(population *pop,
+			const int num_processes,
+			int *eid, pid_t *pid, const int *evalpipe)
   {
+  int		fork_num;		/* Index of current forked process. */
+  int		num_forks;		/* Number of forked processes. */
+  int		eval_num;		/* Index of current entity. */
+  pid_t		fpid;			/* PID of completed child process. */
 
-  die("Support for ga_evolution_threaded() not compiled.");
-
-  return 0;
-  }
-#endif /* HAVE_PTHREADS */
-
-
-/**********************************************************************
-  ga_evolution_threaded()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.  This is a
-		generation-based GA.  ga_genesis(), or equivalent,
-		must be called prior to this function.
-
-		This function is like ga_evolution(), except that all
-		fitness evaluations will be performed in threads
-		and is therefore ideal for use on SMP multiprocessor
-		machines or multipipelined processors (e.g. the new
-		Intel Xeons).
-
-  parameters:
-  return:	Number of generations performed.
-  last updated:	17 Feb 2005
- **********************************************************************/
+  gaul_profile_start(pop, GA_PHASE_SURVIVAL);
 
-#if defined(HAVE_PTHREADS) && HAVE_PTHREADS == -2
-/* Old version of code. */
-GAULFUNC void ga_evolution_threaded(	population		*pop,
-				const int		max_generations )
-  {
-  int			generation=0;		/* Current generation number. */
-  int			i;			/* Loop over members of population. */
-  pthread_t		*tid;			/* Child thread IDs. */
-  pthread_mutex_t	*mid;			/* Child mutex IDs. */
-  pthread_cond_t	*cid;			/* Child condition variable IDs. */
-  int			*eid;			/* Entity which forked process is evaluating. */
-  int			max_threads=0;		/* Maximum number of evaluation threads to use at one time. */
-  char			*max_thread_str;	/* Value of enviroment variable. */
+  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
 
-/* Checks. */
-  if (!pop) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
-  if (!pop->crossover) die("Population's crossover callback is undefined.");
-  if (!pop->rank) die("Population's ranking callback is undefined.");
-  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
-  
 /*
- * Look at environment to find number of threads to create.
+ * Need to kill parents, or rescore parents?
  */
-  max_thread_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
-  if (max_thread_str) max_threads = atoi(max_thread_str);
-  if (max_threads == 0) max_threads = GA_DEFAULT_NUM_THREADS;
-
-  plog(LOG_VERBOSE, "The evolution has begun!  Upto %d threads will be created", max_threads);
-
-  pop->generation = 0;
+  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
+    {
+    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
+      {
+      pop->orig_size--;
+      ga_entity_dereference_by_rank(pop, pop->orig_size);
+      }
+    }
+  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
+    {
+    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
 
 /*
- * Start with all threads locked.
+ * A forked process is started for each fitness evaluation upto
+ * a maximum of max_processes at which point we wait for
+ * results before forking more.
  */
-  THREAD_LOCK(global_thread_lock);
+  fork_num = 0;
+  eval_num = 0;
 
-/*
- * Allocate memory required for handling the threads.
- * Initially use eid array to pass thread enumerations.
- */
-  if ( !(tid = s_malloc(max_threads*sizeof(pthread_t))) )
-    die("Unable to allocate memory");
-  if ( !(mid = s_malloc(max_threads*sizeof(pthread_mutex_t))) )
-    die("Unable to allocate memory");
-  if ( !(cid = s_malloc(max_threads*sizeof(pthread_cond_t))) )
-    die("Unable to allocate memory");
-  if ( !(eid = s_malloc(max_threads*sizeof(int))) )
-    die("Unable to allocate memory");
+  /* Fork initial processes. */
 
-  for (i=0; i<max_threads; i++)
+  while (fork_num < num_processes && eval_num < pop->orig_size)
     {
-    eid[i] = i;
-    if ( !pthread_mutex_init(&(mid[i]), NULL) )
-      die("Unable to initialize mutex variable.");
-    if ( !pthread_cond_init(&(cid[i]), NULL) )
-      die("Unable to initialize condition variable.");
-    if ( !pthread_create(&(tid[i]), NULL, (void *(*)(void *)) worker_thread, (void *) &(eid[i])) )
-      die("Unable to create thread.");
+    eid[fork_num] = eval_num;
+    pid[fork_num] = fork();
+    gaul_trace_fork(pid[fork_num]);
+
+    if (pid[fork_num] < 0)
+      {       /* Error in fork. */
+      dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+      }
+    else if (pid[fork_num] == 0)
+      {       /* This is the child process. */
+      if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+        pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
+
+      write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
+
+      fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
+      log_flush();
+      _exit(1);
+      }
+
+    fork_num++;
+    eval_num++;
+
+#ifdef NEED_MOSIX_FORK_HACK
+    usleep(10);
+#endif
     }
+  num_forks = fork_num;
 
-/*
- * Clear eid array.
- */
-  for (i=0; i<max_threads; i++)
+  /* Wait for a forked process to finish and, if needed, fork another. */
+  while (num_forks > 0)
     {
-    pthread_mutex_lock(&(mid[i]));
-    pthread_cond_wait(&(cid[i]), &(mid[i]));
-    pthread_mutex_unlock(&(mid[i]));
-    eid[i] = -1;
-    }
+    fpid = wait(NULL);
 
-/*
- * Score and sort the initial population members.
- */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations_threaded(pop, max_threads, eid, tid);
-  sort_population(pop);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+    if (fpid == -1) die("Error in wait().");
 
-  plog( LOG_VERBOSE,
-        "Prior to the first generation, population has fitness scores between %f and %f",
-        pop->entity_iarray[0]->fitness,
-        pop->entity_iarray[pop->size-1]->fitness );
+    gaul_trace_reap(fpid);
 
-/*
- * Do all the generations:
- *
- * Stop when (a) max_generations reached, or
- *           (b) "pop->generation_hook" returns FALSE.
- */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
-           generation<max_generations )
-    {
-    generation++;
-    pop->generation = generation;
-    pop->orig_size = pop->size;
+    /* Find which entity this forked process was evaluating. */
+    fork_num = 0;
+    while (fpid != pid[fork_num]) fork_num++;
 
-    plog(LOG_DEBUG,
-              "Population size is %d at start of generation %d",
-              pop->orig_size, generation );
+    if (eid[fork_num] == -1) die("Internal error.  eid is -1");
 
-/*
- * Crossover step.
- */
-    gaul_crossover(pop);
+    read(evalpipe[2*fork_num], &(pop->entity_iarray[eid[fork_num]]->fitness), sizeof(double));
+    gaul_stats_invalidate(pop);
 
-/*
- * Mutation step.
- */
-    gaul_mutation(pop);
+    if (eval_num < pop->size)
+      {       /* New fork. */
+      eid[fork_num] = eval_num;
+      pid[fork_num] = fork();
+      gaul_trace_fork(pid[fork_num]);
 
-/*
- * Score all child entities from this generation.
- */
-    gaul_adapt_and_evaluate_threaded(pop, max_threads, eid, tid);
+      if (pid[fork_num] < 0)
+        {       /* Error in fork. */
+        dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        }
+      else if (pid[fork_num] == 0)
+        {       /* This is the child process. */
+        if ( gaul_evaluate(pop, pop->entity_iarray[eval_num]) == FALSE )
+          pop->entity_iarray[eval_num]->fitness = GA_MIN_FITNESS;
 
-/*
- * Apply survival pressure.
- */
-    gaul_survival_threaded(pop, max_threads, eid, tid);
+        write(evalpipe[2*fork_num+1], &(pop->entity_iarray[eval_num]->fitness), sizeof(double));
 
-    plog(LOG_VERBOSE,
-          "After generation %d, population has fitness scores between %f and %f",
-          generation,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+        fsync(evalpipe[2*fork_num+1]);	/* Ensure data is written to pipe. */
+        log_flush();
+        _exit(1);
+        }
 
-    }	/* Main generation loop. */
+      eval_num++;
+      }
+    else
+      {
+      pid[fork_num] = -1;
+      eid[fork_num] = -1;
+      num_forks--;
+      }
+    }
 
 /*
- * Clean-up threads.
+ * Niching must see the new fitnesses.
  */
-  for (i=0; i<max_threads; i++)
-    {
-    pthread_cancel(&(tid[i]));
-    pthread_join(&(tid[i]));
-    pthread_mutex_destroy(&(mid[i]));
-    pthread_cond_destroy(&(cid[i]));
+    gaul_niche_readjust(pop);
     }
-  
+
 /*
- * Free memory.
+ * Sort all population members by fitness.
  */
-  s_free(tid);
-  s_free(mid);
-  s_free(cid);
-  s_free(eid);
+  sort_population(pop);
 
-  return generation;
+/*
+ * Least fit population members die to restore the
+ * population size to its stable size.
+ */
+  ga_genocide(pop, pop->stable_size);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+
+  gaul_profile_stop(pop);
+
+  return;
   }
 #endif
 
 
 /**********************************************************************
-  ga_evolution_with_stats()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.
-		This is a generation-based GA.
-		ga_genesis(), or equivalent, must be called prior to
-		this function.
-		This is almost identical to ga_evolution() except is
-		modified to facilitate the collection of certain
-		statistics.
+  gaul_survival_threaded()
+  synopsis:	Survival of the fittest.
+		Enforce elitism, reduce
+		population back to its stable size and rerank entities,
+		as required.
+		This is the threaded processing version.
+  parameters:	population *pop
+  return:	none
+  last updated:	18 Mar 2003
+ **********************************************************************/
 
-		*** Should be deprecated. ***
+#ifdef HAVE_PTHREADS
+static void gaul_survival_threaded(population *pop,
+			const int max_threads,
+			threaddata_t *threaddata)
+  {
+  int		thread_num;		/* Index of current thread. */
+  int		num_threads;		/* Number of threads currently in use. */
+  int		eval_num;		/* Index of current entity. */
+
+  gaul_profile_start(pop, GA_PHASE_SURVIVAL);
+
+  plog(LOG_VERBOSE, "*** Survival of the fittest ***");
+
+/*
+ * Need to kill parents, or rescore parents?
+ */
+  if (pop->elitism == GA_ELITISM_PARENTS_DIE || pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES)
+    {
+    while (pop->orig_size>(pop->elitism == GA_ELITISM_ONE_PARENT_SURVIVES))
+      {
+      pop->orig_size--;
+      ga_entity_dereference_by_rank(pop, pop->orig_size);
+      }
+    }
+  else if (pop->elitism == GA_ELITISM_RESCORE_PARENTS)
+    {
+
+    plog(LOG_VERBOSE, "*** Fitness Re-evaluations ***");
+
+/*
+ * A thread is created for each fitness evaluation upto
+ * a maximum of max_threads at which point we wait for
+ * results before continuing.
+ *
+ * Skip evaluations for entities that have been previously evaluated.
+ */
+    thread_num = 0;
+    eval_num = 0;
+
+    while (thread_num < max_threads && eval_num < pop->orig_size)
+      {
+      threaddata[thread_num].thread_num = thread_num;
+      threaddata[thread_num].eval_num = eval_num;
+
+      if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
+        {       /* Error in thread creation. */
+        dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+        }
+
+      thread_num++;
+      eval_num++;
+      }
+
+    num_threads = thread_num;
+
+  /* Wait for a thread to finish and, if needed, create another. */
+  /* Also, find which entity this thread was evaluating. */
+    thread_num=0;
+    while (num_threads > 0)
+      {
+      while (threaddata[thread_num].thread_num >= 0)
+        {
+        thread_num++;
+        if (thread_num==max_threads)
+          {
+          thread_num=0;
+/* FIXME: Insert short sleep here? */
+          }
+        }
+
+#if GA_DEBUG>2
+printf("DEBUG: Thread %d finished.  num_threads=%d eval_num=%d/%d\n", thread_num, num_threads, eval_num, pop->size);
+#endif
+
+      if ( pthread_join(threaddata[thread_num].pid, NULL) < 0 )
+        {
+        dief("Error %d in pthread_join. (%s)", errno, errno==ESRCH?"ESRCH":errno==EINVAL?"EINVAL":errno==EDEADLK?"EDEADLK":"unknown");
+        }
+
+      if (eval_num < pop->orig_size)
+        {       /* New thread. */
+        threaddata[thread_num].thread_num = thread_num;
+        threaddata[thread_num].eval_num = eval_num;
+
+        if (pthread_create(&(threaddata[thread_num].pid), NULL, _evaluation_thread, (void *)&(threaddata[thread_num])) < 0)
+          {       /* Error in thread creation. */
+          dief("Error %d in pthread_create. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+          }
+
+        eval_num++;
+        }
+      else
+        {
+        threaddata[thread_num].thread_num = 0;
+        threaddata[thread_num].eval_num = -1;
+        num_threads--;
+        }
+      }
+
+
+/*
+ * Niching must see the new fitnesses.
+ */
+    gaul_niche_readjust(pop);
+    }
+
+/*
+ * Sort all population members by fitness.
+ */
+  sort_population(pop);
+
+/*
+ * Least fit population members die to restore the
+ * population size to its stable size.
+ */
+  ga_genocide(pop, pop->stable_size);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+
+  gaul_profile_stop(pop);
+
+  return;
+  }
+#endif /* HAVE_PTHREADS */
+
+
+/**********************************************************************
+  ga_evolution()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.
+		This is a generation-based GA.
+		ga_genesis(), or equivalent, must be called prior to
+		this function.
+		If the population has been restored by
+		ga_population_checkpoint_restore(), the evolution
+		continues from the restored generation.  The
+		population is checkpointed as set by
+		ga_population_set_checkpoint_parameters().
   parameters:
-  return:
-  last updated:	17 Feb 2005
+  return:	Number of generations performed, including any
+		before a restored checkpoint.
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef COMPILE_DEPRECATED_FUNCTIONS
-
-GAULFUNC void ga_evolution_with_stats(	population		*pop,
-					const ga_elitism_type	elitism,
-					const int		max_generations )
+GAULFUNC int ga_evolution(	population		*pop,
+			const int		max_generations )
   {
   int		generation=0;		/* Current generation number. */
-  int		i;			/* Loop over members of population. */
-  entity	*mother, *father;	/* Parent entities. */
-  entity	*son, *daughter;	/* Child entities. */
-  entity	*adult;			/* Temporary copy for gene optimisation. */
-  boolean	finished;		/* Whether crossover/mutation rounds are complete. */
-  int		new_pop_size;		/* Population size prior to adaptation. */
-  FILE		*STATS_OUT;		/* Filehandle for stats log. */
-  char		stats_fname[80];	/* Filename for stats log. */
-  int		crossover_good, crossover_poor;	/* Fornication statistics. */
-  int		mutation_good, mutation_poor;	/*  - " -  */
-  double	crossover_gain, mutation_gain;	/*  - " -  */
 
 /* Checks. */
   if (!pop) die("NULL pointer to population structure passed.");
@@ -3062,37 +3182,42 @@ GAULFUNC void ga_evolution_with_stats(	population		*pop,
   if (!pop->rank) die("Population's ranking callback is undefined.");
   if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
 
-  plog(LOG_WARNING, "This is a deprecated function!");
-
   plog(LOG_VERBOSE, "The evolution has begun!");
 
-  pop->generation = 0;
-
 /*
- * Create name for statistics log file.
- * Write a simple header to that file.
+ * A population restored from a checkpoint continues where it stopped.
  */
-  sprintf(stats_fname, "ga_stats_%d.dat", (int) getpid());
-  STATS_OUT = fopen(stats_fname, "a");
-  fprintf(STATS_OUT, "gen crossover mutation\n");
-  fclose(STATS_OUT);
+  if (gaul_checkpoint_resume(pop, 0, NULL))
+    {
+    generation = pop->generation;
+    }
+  else
+    {
+    pop->generation = 0;
 
 /*
  * Score and sort the initial population members.
  */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations(pop);
-  sort_population(pop);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+    if (pop->size < pop->stable_size)
+      gaul_population_fill(pop, pop->stable_size - pop->size);
+    gaul_ensure_evaluations(pop);
+    sort_population(pop);
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+    }
 
   plog( LOG_VERBOSE,
-        "Prior to the first generation, population has fitness scores between %f and %f",
+        "Prior to generation %d, population has fitness scores between %f and %f",
+        generation+1,
         pop->entity_iarray[0]->fitness,
         pop->entity_iarray[pop->size-1]->fitness );
 
-/* Do all the generations: */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
+/*
+ * Do all the generations:
+ *
+ * Stop when (a) max_generations reached, or
+ *           (b) "pop->generation_hook" returns FALSE.
+ */
+  while ( gaul_generation_hook(pop, generation) &&
            generation<max_generations )
     {
     generation++;
@@ -3104,195 +3229,172 @@ GAULFUNC void ga_evolution_with_stats(	population		*pop,
               pop->orig_size, generation );
 
 /*
- * Zero statistics.
+ * Crossover step.
  */
-    crossover_good=0;
-    crossover_poor=0;
-    mutation_good=0;
-    mutation_poor=0;
+    gaul_crossover(pop);
 
-    crossover_gain=0.0;
-    mutation_gain=0.0;
+/*
+ * Mutation step.
+ */
+    gaul_mutation(pop);
 
 /*
- * Mating cycle.
- *
- * Select pairs of entities to mate via crossover. (Sexual reproduction).
- *
- * Score the new entities as we go.
+ * Apply environmental adaptations, score entities, sort entities, etc.
  */
-    plog(LOG_VERBOSE, "*** Mating cycle ***");
+    gaul_adapt_and_evaluate(pop);
 
-    pop->select_state = 0;
+/*
+ * Survival of the fittest.
+ */
+    gaul_niche_adjust(pop);
+    gaul_survival(pop);
+    gaul_niche_restore(pop);
 
-    finished = FALSE;
-    while (!finished)
-      {
-      finished = pop->select_two(pop, &mother, &father);
+/*
+ * End of generation.
+ */
+    plog(LOG_VERBOSE,
+          "After generation %d, population has fitness scores between %f and %f",
+          generation,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
 
-      if (mother && father)
-        {
-        plog(LOG_VERBOSE, "Crossover between %d (%d = %f) and %d (%d = %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness,
-             ga_get_entity_id(pop, father),
-             ga_get_entity_rank(pop, father), father->fitness);
+    gaul_checkpoint_generation(pop, 0, NULL);
 
-        son = ga_get_free_entity(pop);
-        daughter = ga_get_free_entity(pop);
-        pop->crossover(pop, mother, father, daughter, son);
-        if ( pop->evaluate(pop, daughter) == FALSE )
-          daughter->fitness = GA_MIN_FITNESS;
-        if ( pop->evaluate(pop, son) == FALSE )
-          son->fitness = GA_MIN_FITNESS;
+    }	/* Generation loop. */
 
-/*
- * Collate stats.
- */
-        if (son->fitness > father->fitness)
-          crossover_good++;
-        else
-          crossover_poor++;
-        if (daughter->fitness > father->fitness)
-          crossover_good++;
-        else
-          crossover_poor++;
-        if (son->fitness > mother->fitness)
-          crossover_good++;
-        else
-          crossover_poor++;
-        if (daughter->fitness > mother->fitness)
-          crossover_good++;
-        else
-          crossover_poor++;
+  ga_population_checkpoint_wait(pop);
 
-        if (son->fitness > MAX(mother->fitness,father->fitness))
-          crossover_gain += son->fitness-MAX(mother->fitness,father->fitness);
-        if (daughter->fitness > MAX(mother->fitness,father->fitness))
-          crossover_gain += daughter->fitness-MAX(mother->fitness,father->fitness);
-        }
-      else
-        {
-        plog( LOG_VERBOSE, "Crossover not performed." );
-        }
-      }
+  return generation;
+  }
+
+
+/**********************************************************************
+  ga_evolution_forked()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.  This is a
+		generation-based GA.  ga_genesis(), or equivalent,
+		must be called prior to this function.
+
+		This function is like ga_evolution(), except that all
+		fitness evaluations will be performed in forked
+		processes which is ideal for use on multiprocessor
+		machines or Beowulf-style clusters with process
+		migration e.g. Mosix ( http://www.mosix.org/ ) or
+		openMosix ( http://openmosix.sourceforge.net/ )
+
+		Thanks go to Syrrx, Inc. who, in essence, funded
+		development of this function.
+
+  parameters:
+  return:	Number of generations performed.
+  last updated:	17 Feb 2005
+ **********************************************************************/
+
+#ifndef W32_CRIPPLED
+GAULFUNC int ga_evolution_forked(	population		*pop,
+				const int		max_generations )
+  {
+  int		generation=0;		/* Current generation number. */
+  int		i;			/* Loop over members of population or pipes. */
+  int		*evalpipe;		/* Pipes for returning fitnesses. */
+  pid_t		*pid;			/* Child PIDs. */
+  int		*eid;			/* Entity which forked process is evaluating. */
+  int		max_processes=0;	/* Maximum number of processes to fork at one time. */
+  char		*max_proc_str;		/* Value of enviroment variable. */
 
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pop->crossover) die("Population's crossover callback is undefined.");
+  if (!pop->rank) die("Population's ranking callback is undefined.");
+  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+  
 /*
- * Mutation cycle.
- *
- * Select entities to undergo asexual reproduction, in which case the child will
- * have a genetic mutation of some type.
- *
- * Score the new entities as we go.
+ * Look at environment to find number of processes to fork.
  */
-    plog(LOG_VERBOSE, "*** Mutation cycle ***");
+  max_proc_str = getenv(GA_NUM_PROCESSES_ENVVAR_STRING);
+  if (max_proc_str) max_processes = atoi(max_proc_str);
+  if (max_processes == 0) max_processes = GA_DEFAULT_NUM_PROCESSES;
 
-    pop->select_state = 0;
+  plog(LOG_VERBOSE, "The evolution has begun!  Upto %d processes will be fork'ed", max_processes);
 
-    finished = FALSE;
-    while (!finished)
-      {
-      finished = pop->select_one(pop, &mother);
+  pop->generation = 0;
 
-      if (mother)
-        {
-        plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness );
+/*
+ * Allocate memory required for handling the forked processes.
+ * Open pipes for reporting fitnesses.
+ * Clear pid and eid arrays.
+ */
+  if ( !(pid = s_malloc(max_processes*sizeof(pid_t))) )
+    die("Unable to allocate memory");
+  if ( !(eid = s_malloc(max_processes*sizeof(int))) )
+    die("Unable to allocate memory");
+  if ( !(evalpipe = s_malloc(2*max_processes*sizeof(int))) )
+    die("Unable to allocate memory");
 
-        daughter = ga_get_free_entity(pop);
-        pop->mutate(pop, mother, daughter);
-        if ( pop->evaluate(pop, daughter) == FALSE )
-          daughter->fitness = GA_MIN_FITNESS;
+  for (i=0; i<max_processes; i++)
+    {
+    if (pipe(&evalpipe[2*i])==-1) die("Unable to open pipe");
+    pid[i] = -1;
+    eid[i] = -1;
+    }
 
 /*
- * Collate stats.
+ * Score and sort the initial population members.
  */
-        if (daughter->fitness > mother->fitness)
-          {
-          mutation_good++;
-          mutation_gain += daughter->fitness-mother->fitness;
-          }
-        else
-          {
-          mutation_poor++;
-          }
+  if (pop->size < pop->stable_size)
+    gaul_population_fill(pop, pop->stable_size - pop->size);
+  gaul_ensure_evaluations_forked(pop, max_processes, eid, pid, evalpipe);
+  sort_population(pop);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-        }
-      else
-        {
-        plog( LOG_VERBOSE, "Mutation not performed." );
-        }
-      }
+  plog( LOG_VERBOSE,
+        "Prior to the first generation, population has fitness scores between %f and %f",
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
 
 /*
- * Environmental adaptation.
- *
- * Skipped in the case of Darwinian evolution.
- * Performed in the case of Baldwinian evolution.
- * Performed, and genes are modified, in the case of Lamarckian evolution.
+ * Do all the generations:
  *
- * Maybe, could reoptimise all solutions at each generation.  This would allow
- * a reduced optimisation protocol and only those solutions which are
- * reasonable would survive for further optimisation.
+ * Stop when (a) max_generations reached, or
+ *           (b) "pop->generation_hook" returns FALSE.
  */
-  if (pop->scheme != GA_SCHEME_DARWIN)
+  while ( gaul_generation_hook(pop, generation) &&
+           generation<max_generations )
     {
-    plog(LOG_VERBOSE, "*** Adaptation round ***");
+    generation++;
+    pop->generation = generation;
+    pop->orig_size = pop->size;
 
-    new_pop_size = pop->size;
+    plog(LOG_DEBUG,
+              "Population size is %d at start of generation %d",
+              pop->orig_size, generation );
 
-    switch (pop->scheme)
-      {
-      case (GA_SCHEME_BALDWIN_CHILDREN):
-        /* Baldwinian evolution for children only. */
-        for (i=pop->orig_size; i<new_pop_size; i++)
-          {
-          adult = pop->adapt(pop, pop->entity_iarray[i]);
-          pop->entity_iarray[i]->fitness=adult->fitness;
-/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      case (GA_SCHEME_BALDWIN_ALL):
-        /* Baldwinian evolution for entire population. */
-        /* I don't recommend this, but it is here for completeness. */
-        for (i=0; i<new_pop_size; i++)
-          {
-          adult = pop->adapt(pop, pop->entity_iarray[i]);
-          pop->entity_iarray[i]->fitness=adult->fitness;
-/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      case (GA_SCHEME_LAMARCK_CHILDREN):
-        /* Lamarckian evolution for children only. */
-        while (new_pop_size>pop->orig_size)
-          {
-          new_pop_size--;
-          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      case (GA_SCHEME_LAMARCK_ALL):
-        /* Lamarckian evolution for entire population. */
-        while (new_pop_size>0)
-          {
-          new_pop_size--;
-          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      default:
-        dief("Unknown evolutionary scheme %d.\n", pop->scheme);
-      }
-    }
+/*
+ * Crossover step.
+ */
+    gaul_crossover(pop);
 
 /*
- * Least fit population members die to restore the
- * population size to the stable size.
+ * Mutation step.
  */
-    gaul_survival(pop);
+    gaul_mutation(pop);
+
+/*
+ * Score all child entities from this generation.
+ */
+    gaul_adapt_and_evaluate_forked(pop, max_processes, eid, pid, evalpipe);
+
+/*
+ * Apply survival pressure.
+ */
+    gaul_niche_adjust(pop);
+    gaul_survival_forked(pop, max_processes, eid, pid, evalpipe);
+    gaul_niche_restore(pop);
 
     plog(LOG_VERBOSE,
           "After generation %d, population has fitness scores between %f and %f",
@@ -3300,1163 +3402,2767 @@ GAULFUNC void ga_evolution_with_stats(	population		*pop,
           pop->entity_iarray[0]->fitness,
           pop->entity_iarray[pop->size-1]->fitness );
 
+    }	/* Main generation loop. */
+
 /*
- * Write statistics.
+ * Close the pipes and free memory.
  */
-    STATS_OUT = fopen(stats_fname, "a");
-    fprintf(STATS_OUT, "%d: %d-%d %f %d-%d %f\n", generation,
-            crossover_good, crossover_poor, crossover_gain,
-            mutation_good, mutation_poor, mutation_gain);
-    fclose(STATS_OUT);
-    }	/* Generation loop. */
+  for (i=0; i<max_processes; i++)
+    {
+    close(evalpipe[2*i]);
+    close(evalpipe[2*i+1]);
+    }
+
+  s_free(pid);
+  s_free(eid);
+  s_free(evalpipe);
 
   return generation;
   }
+#else
+GAULFUNC int ga_evolution_forked(	population		*pop,
+				const int		max_generations )
+  {
+  die("Sorry, the ga_evolution_forked() function isn't available for Windows.");
+  return 0;
+  }
 #endif
 
 
-/**********************************************************************
-  ga_evolution_steady_state()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.
-		This is a steady-state GA.
-		ga_genesis(), or equivalent, must be called prior to
-		this function.
-  parameters:
-  return:
-  last updated:	17 Feb 2005
- **********************************************************************/
+/**********************************************************************
+  ga_evolution_threaded()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.  This is a
+		generation-based GA.  ga_genesis(), or equivalent,
+		must be called prior to this function.
+
+		This function is like ga_evolution(), except that all
+		fitness evaluations will be performed in threads
+		and is therefore ideal for use on SMP multiprocessor
+		machines or multipipelined processors (e.g. the new
+		Intel Xeons).
+
+  parameters:
+  return:	Number of generations performed.
+  last updated:	17 Feb 2005
+ **********************************************************************/
+
+#ifdef HAVE_PTHREADS
+GAULFUNC int ga_evolution_threaded(	population		*pop,
+				const int		max_generations )
+  {
+  int		generation=0;		/* Current generation number. */
+  int		max_threads=0;		/* Maximum number of threads to use at one time. */
+  char		*max_thread_str;	/* Value of enviroment variable. */
+  threaddata_t	*threaddata;		/* Used for passing data to threads. */
+  int		i;			/* Loop over threaddata elements. */
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pop->crossover) die("Population's crossover callback is undefined.");
+  if (!pop->rank) die("Population's ranking callback is undefined.");
+  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+  
+/*
+ * Look at environment to find number of threads to use.
+ */
+  max_thread_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
+  if (max_thread_str) max_threads = atoi(max_thread_str);
+  if (max_threads == 0) max_threads = GA_DEFAULT_NUM_THREADS;
+
+  plog(LOG_VERBOSE, "The evolution has begun!  Upto %d threads will be created", max_threads);
+
+/*
+ * Allocate memory required for handling the threads.
+ */
+  if ( !(threaddata = s_malloc(sizeof(threaddata_t)*max_threads)) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<max_threads; i++)
+    threaddata[i].pop = pop;
+
+  pop->generation = 0;
+
+/*
+ * Score and sort the initial population members.
+ */
+  if (pop->size < pop->stable_size)
+    gaul_population_fill(pop, pop->stable_size - pop->size);
+  gaul_ensure_evaluations_threaded(pop, max_threads, threaddata);
+  sort_population(pop);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+
+  plog( LOG_VERBOSE,
+        "Prior to the first generation, population has fitness scores between %f and %f",
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
+
+/*
+ * Do all the generations:
+ *
+ * Stop when (a) max_generations reached, or
+ *           (b) "pop->generation_hook" returns FALSE.
+ */
+  while ( gaul_generation_hook(pop, generation) &&
+           generation<max_generations )
+    {
+    generation++;
+    pop->generation = generation;
+    pop->orig_size = pop->size;
+
+    plog(LOG_DEBUG,
+              "Population size is %d at start of generation %d",
+              pop->orig_size, generation );
+
+/*
+ * Crossover step.
+ */
+    gaul_crossover(pop);
+
+/*
+ * Mutation step.
+ */
+    gaul_mutation(pop);
+
+/*
+ * Score all child entities from this generation.
+ */
+    gaul_adapt_and_evaluate_threaded(pop, max_threads, threaddata);
+
+/*
+ * Apply survival pressure.
+ */
+    gaul_niche_adjust(pop);
+    gaul_survival_threaded(pop, max_threads, threaddata);
+    gaul_niche_restore(pop);
+
+    plog(LOG_VERBOSE,
+          "After generation %d, population has fitness scores between %f and %f",
+          generation,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
+
+    }	/* Main generation loop. */
+
+/* Free memory used for storing thread information. */
+  s_free(threaddata);
+
+  return generation;
+  }
+#else
+GAULFUNC int ga_evolution_threaded(	population		*pop,
+				const int		max_generations )
+  {
+
+  die("Support for ga_evolution_threaded() not compiled.");
+
+  return 0;
+  }
+#endif /* HAVE_PTHREADS */
+
+
+/**********************************************************************
+  ga_evolution_threaded()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.  This is a
+		generation-based GA.  ga_genesis(), or equivalent,
+		must be called prior to this function.
+
+		This function is like ga_evolution(), except that all
+		fitness evaluations will be performed in threads
+		and is therefore ideal for use on SMP multiprocessor
+		machines or multipipelined processors (e.g. the new
+		Intel Xeons).
+
+  parameters:
+  return:	Number of generations performed.
+  last updated:	17 Feb 2005
+ **********************************************************************/
+
+#if defined(HAVE_PTHREADS) && HAVE_PTHREADS == -2
+/* Old version of code. */
+GAULFUNC void ga_evolution_threaded(	population		*pop,
+				const int		max_generations )
+  {
+  int			generation=0;		/* Current generation number. */
+  int			i;			/* Loop over members of population. */
+  pthread_t		*tid;			/* Child thread IDs. */
+  pthread_mutex_t	*mid;			/* Child mutex IDs. */
+  pthread_cond_t	*cid;			/* Child condition variable IDs. */
+  int			*eid;			/* Entity which forked process is evaluating. */
+  int			max_threads=0;		/* Maximum number of evaluation threads to use at one time. */
+  char			*max_thread_str;	/* Value of enviroment variable. */
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pop->crossover) die("Population's crossover callback is undefined.");
+  if (!pop->rank) die("Population's ranking callback is undefined.");
+  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+  
+/*
+ * Look at environment to find number of threads to create.
+ */
+  max_thread_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
+  if (max_thread_str) max_threads = atoi(max_thread_str);
+  if (max_threads == 0) max_threads = GA_DEFAULT_NUM_THREADS;
+
+  plog(LOG_VERBOSE, "The evolution has begun!  Upto %d threads will be created", max_threads);
+
+  pop->generation = 0;
+
+/*
+ * Start with all threads locked.
+ */
+  THREAD_LOCK(global_thread_lock);
+
+/*
+ * Allocate memory required for handling the threads.
+ * Initially use eid array to pass thread enumerations.
+ */
+  if ( !(tid = s_malloc(max_threads*sizeof(pthread_t))) )
+    die("Unable to allocate memory");
+  if ( !(mid = s_malloc(max_threads*sizeof(pthread_mutex_t))) )
+    die("Unable to allocate memory");
+  if ( !(cid = s_malloc(max_threads*sizeof(pthread_cond_t))) )
+    die("Unable to allocate memory");
+  if ( !(eid = s_malloc(max_threads*sizeof(int))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<max_threads; i++)
+    {
+    eid[i] = i;
+    if ( !pthread_mutex_init(&(mid[i]), NULL) )
+      die("Unable to initialize mutex variable.");
+    if ( !pthread_cond_init(&(cid[i]), NULL) )
+      die("Unable to initialize condition variable.");
+    if ( !pthread_create(&(tid[i]), NULL, (void *(*)(void *)) worker_thread, (void *) &(eid[i])) )
+      die("Unable to create thread.");
+    }
+
+/*
+ * Clear eid array.
+ */
+  for (i=0; i<max_threads; i++)
+    {
+    pthread_mutex_lock(&(mid[i]));
+    pthread_cond_wait(&(cid[i]), &(mid[i]));
+    pthread_mutex_unlock(&(mid[i]));
+    eid[i] = -1;
+    }
+
+/*
+ * Score and sort the initial population members.
+ */
+  if (pop->size < pop->stable_size)
+    gaul_population_fill(pop, pop->stable_size - pop->size);
+  gaul_ensure_evaluations_threaded(pop, max_threads, eid, tid);
+  sort_population(pop);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+
+  plog( LOG_VERBOSE,
+        "Prior to the first generation, population has fitness scores between %f and %f",
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
+
+/*
+ * Do all the generations:
+ *
+ * Stop when (a) max_generations reached, or
+ *           (b) "pop->generation_hook" returns FALSE.
+ */
+  while ( gaul_generation_hook(pop, generation) &&
+           generation<max_generations )
+    {
+    generation++;
+    pop->generation = generation;
+    pop->orig_size = pop->size;
+
+    plog(LOG_DEBUG,
+              "Population size is %d at start of generation %d",
+              pop->orig_size, generation );
+
+/*
+ * Crossover step.
+ */
+    gaul_crossover(pop);
+
+/*
+ * Mutation step.
+ */
+    gaul_mutation(pop);
+
+/*
+ * Score all child entities from this generation.
+ */
+    gaul_adapt_and_evaluate_threaded(pop, max_threads, eid, tid);
+
+/*
+ * Apply survival pressure.
+ */
+    gaul_niche_adjust(pop);
+    gaul_survival_threaded(pop, max_threads, eid, tid);
+    gaul_niche_restore(pop);
+
+    plog(LOG_VERBOSE,
+          "After generation %d, population has fitness scores between %f and %f",
+          generation,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
+
+    }	/* Main generation loop. */
+
+/*
+ * Clean-up threads.
+ */
+  for (i=0; i<max_threads; i++)
+    {
+    pthread_cancel(&(tid[i]));
+    pthread_join(&(tid[i]));
+    pthread_mutex_destroy(&(mid[i]));
+    pthread_cond_destroy(&(cid[i]));
+    }
+  
+/*
+ * Free memory.
+ */
+  s_free(tid);
+  s_free(mid);
+  s_free(cid);
+  s_free(eid);
+
+  return generation;
+  }
+#endif
+
+
+/**********************************************************************
+  ga_evolution_with_stats()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.
+		This is a generation-based GA.
+		ga_genesis(), or equivalent, must be called prior to
+		this function.
+		This is almost identical to ga_evolution() except is
+		modified to facilitate the collection of certain
+		statistics.
+
+		*** Should be deprecated. ***
+  parameters:
+  return:
+  last updated:	17 Feb 2005
+ **********************************************************************/
+
+#ifdef COMPILE_DEPRECATED_FUNCTIONS
+
+GAULFUNC void ga_evolution_with_stats(	population		*pop,
+					const ga_elitism_type	elitism,
+					const int		max_generations )
+  {
+  int		generation=0;		/* Current generation number. */
+  int		i;			/* Loop over members of population. */
+  entity	*mother, *father;	/* Parent entities. */
+  entity	*son, *daughter;	/* Child entities. */
+  entity	*adult;			/* Temporary copy for gene optimisation. */
+  boolean	finished;		/* Whether crossover/mutation rounds are complete. */
+  int		new_pop_size;		/* Population size prior to adaptation. */
+  FILE		*STATS_OUT;		/* Filehandle for stats log. */
+  char		stats_fname[80];	/* Filename for stats log. */
+  int		crossover_good, crossover_poor;	/* Fornication statistics. */
+  int		mutation_good, mutation_poor;	/*  - " -  */
+  double	crossover_gain, mutation_gain;	/*  - " -  */
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pop->crossover) die("Population's crossover callback is undefined.");
+  if (!pop->rank) die("Population's ranking callback is undefined.");
+  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+
+  plog(LOG_WARNING, "This is a deprecated function!");
+
+  plog(LOG_VERBOSE, "The evolution has begun!");
+
+  pop->generation = 0;
+
+/*
+ * Create name for statistics log file.
+ * Write a simple header to that file.
+ */
+  sprintf(stats_fname, "ga_stats_%d.dat", (int) getpid());
+  STATS_OUT = fopen(stats_fname, "a");
+  fprintf(STATS_OUT, "gen crossover mutation\n");
+  fclose(STATS_OUT);
+
+/*
+ * Score and sort the initial population members.
+ */
+  if (pop->size < pop->stable_size)
+    gaul_population_fill(pop, pop->stable_size - pop->size);
+  gaul_ensure_evaluations(pop);
+  sort_population(pop);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+
+  plog( LOG_VERBOSE,
+        "Prior to the first generation, population has fitness scores between %f and %f",
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
+
+/* Do all the generations: */
+  while ( gaul_generation_hook(pop, generation) &&
+           generation<max_generations )
+    {
+    generation++;
+    pop->generation = generation;
+    pop->orig_size = pop->size;
+
+    plog(LOG_DEBUG,
+              "Population size is %d at start of generation %d",
+              pop->orig_size, generation );
+
+/*
+ * Zero statistics.
+ */
+    crossover_good=0;
+    crossover_poor=0;
+    mutation_good=0;
+    mutation_poor=0;
+
+    crossover_gain=0.0;
+    mutation_gain=0.0;
+
+/*
+ * Mating cycle.
+ *
+ * Select pairs of entities to mate via crossover. (Sexual reproduction).
+ *
+ * Score the new entities as we go.
+ */
+    plog(LOG_VERBOSE, "*** Mating cycle ***");
+
+    pop->select_state = 0;
+
+    finished = FALSE;
+    while (!finished)
+      {
+      finished = pop->select_two(pop, &mother, &father);
+
+      if (mother && father)
+        {
+        plog(LOG_VERBOSE, "Crossover between %d (%d = %f) and %d (%d = %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness,
+             ga_get_entity_id(pop, father),
+             ga_get_entity_rank(pop, father), father->fitness);
+
+        son = ga_get_free_entity(pop);
+        daughter = ga_get_free_entity(pop);
+        pop->crossover(pop, mother, father, daughter, son);
+        if ( gaul_evaluate(pop, daughter) == FALSE )
+          daughter->fitness = GA_MIN_FITNESS;
+        if ( gaul_evaluate(pop, son) == FALSE )
+          son->fitness = GA_MIN_FITNESS;
+
+/*
+ * Collate stats.
+ */
+        if (son->fitness > father->fitness)
+          crossover_good++;
+        else
+          crossover_poor++;
+        if (daughter->fitness > father->fitness)
+          crossover_good++;
+        else
+          crossover_poor++;
+        if (son->fitness > mother->fitness)
+          crossover_good++;
+        else
+          crossover_poor++;
+        if (daughter->fitness > mother->fitness)
+          crossover_good++;
+        else
+          crossover_poor++;
+
+        if (son->fitness > MAX(mother->fitness,father->fitness))
+          crossover_gain += son->fitness-MAX(mother->fitness,father->fitness);
+        if (daughter->fitness > MAX(mother->fitness,father->fitness))
+          crossover_gain += daughter->fitness-MAX(mother->fitness,father->fitness);
+        }
+      else
+        {
+        plog( LOG_VERBOSE, "Crossover not performed." );
+        }
+      }
+
+/*
+ * Mutation cycle.
+ *
+ * Select entities to undergo asexual reproduction, in which case the child will
+ * have a genetic mutation of some type.
+ *
+ * Score the new entities as we go.
+ */
+    plog(LOG_VERBOSE, "*** Mutation cycle ***");
+
+    pop->select_state = 0;
+
+    finished = FALSE;
+    while (!finished)
+      {
+      finished = pop->select_one(pop, &mother);
+
+      if (mother)
+        {
+        plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness );
+
+        daughter = ga_get_free_entity(pop);
+        pop->mutate(pop, mother, daughter);
+        if ( gaul_evaluate(pop, daughter) == FALSE )
+          daughter->fitness = GA_MIN_FITNESS;
+
+/*
+ * Collate stats.
+ */
+        if (daughter->fitness > mother->fitness)
+          {
+          mutation_good++;
+          mutation_gain += daughter->fitness-mother->fitness;
+          }
+        else
+          {
+          mutation_poor++;
+          }
+
+        }
+      else
+        {
+        plog( LOG_VERBOSE, "Mutation not performed." );
+        }
+      }
+
+/*
+ * Environmental adaptation.
+ *
+ * Skipped in the case of Darwinian evolution.
+ * Performed in the case of Baldwinian evolution.
+ * Performed, and genes are modified, in the case of Lamarckian evolution.
+ *
+ * Maybe, could reoptimise all solutions at each generation.  This would allow
+ * a reduced optimisation protocol and only those solutions which are
+ * reasonable would survive for further optimisation.
+ */
+  if (pop->scheme != GA_SCHEME_DARWIN)
+    {
+    plog(LOG_VERBOSE, "*** Adaptation round ***");
+
+    new_pop_size = pop->size;
+
+    switch (pop->scheme)
+      {
+      case (GA_SCHEME_BALDWIN_CHILDREN):
+        /* Baldwinian evolution for children only. */
+        for (i=pop->orig_size; i<new_pop_size; i++)
+          {
+          adult = pop->adapt(pop, pop->entity_iarray[i]);
+          pop->entity_iarray[i]->fitness=adult->fitness;
+/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_BALDWIN_ALL):
+        /* Baldwinian evolution for entire population. */
+        /* I don't recommend this, but it is here for completeness. */
+        for (i=0; i<new_pop_size; i++)
+          {
+          adult = pop->adapt(pop, pop->entity_iarray[i]);
+          pop->entity_iarray[i]->fitness=adult->fitness;
+/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_LAMARCK_CHILDREN):
+        /* Lamarckian evolution for children only. */
+        while (new_pop_size>pop->orig_size)
+          {
+          new_pop_size--;
+          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_LAMARCK_ALL):
+        /* Lamarckian evolution for entire population. */
+        while (new_pop_size>0)
+          {
+          new_pop_size--;
+          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      default:
+        dief("Unknown evolutionary scheme %d.\n", pop->scheme);
+      }
+    }
+
+/*
+ * Least fit population members die to restore the
+ * population size to the stable size.
+ */
+    gaul_niche_adjust(pop);
+    gaul_survival(pop);
+    gaul_niche_restore(pop);
+
+    plog(LOG_VERBOSE,
+          "After generation %d, population has fitness scores between %f and %f",
+          generation,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
+
+/*
+ * Write statistics.
+ */
+    STATS_OUT = fopen(stats_fname, "a");
+    fprintf(STATS_OUT, "%d: %d-%d %f %d-%d %f\n", generation,
+            crossover_good, crossover_poor, crossover_gain,
+            mutation_good, mutation_poor, mutation_gain);
+    fclose(STATS_OUT);
+    }	/* Generation loop. */
+
+  return generation;
+  }
+#endif
+
+
+/**********************************************************************
+  ga_evolution_steady_state()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.
+		This is a steady-state GA.
+		ga_genesis(), or equivalent, must be called prior to
+		this function.
+		If the population has been restored by
+		ga_population_checkpoint_restore(), the evolution
+		continues from the restored iteration.  The population
+		is checkpointed as set by
+		ga_population_set_checkpoint_parameters(), with the
+		interval counted in iterations.
+  parameters:
+  return:
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_evolution_steady_state(	population		*pop,
+				const int		max_iterations )
+  {
+  int		iteration=0;		/* Current iteration count. */
+  int		i;			/* Loop over members of population. */
+  entity	*mother, *father;	/* Parent entities. */
+  entity	*son, *daughter, *child;	/* Child entities. */
+  entity	*adult;			/* Temporary copy for gene optimisation. */
+  int		new_pop_size;		/* Population size prior to adaptation. */
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pop->crossover) die("Population's crossover callback is undefined.");
+  if (!pop->replace) die("Population's replacement callback is undefined.");
+  if (!pop->rank) die("Population's ranking callback is undefined.");
+  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+
+  plog(LOG_VERBOSE, "The evolution has begun!");
+
+/*
+ * A population restored from a checkpoint continues where it stopped.
+ */
+  if (gaul_checkpoint_resume(pop, 0, NULL))
+    {
+    iteration = pop->generation;
+    }
+  else
+    {
+    pop->generation = 0;
+
+/*
+ * Score and sort the initial population members.
+ */
+    if (pop->size < pop->stable_size)
+      gaul_population_fill(pop, pop->stable_size - pop->size);
+    gaul_ensure_evaluations(pop);
+    sort_population(pop);
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+    }
+
+  plog( LOG_VERBOSE,
+        "Prior to iteration %d, population has fitness scores between %f and %f",
+        iteration+1,
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
+
+/* Do all the iterations: */
+  while ( gaul_generation_hook(pop, iteration) &&
+           iteration<max_iterations )
+    {
+    iteration++;
+    pop->generation = iteration;
+    pop->orig_size = pop->size;
+
+    son = NULL;
+    daughter = NULL;
+    child = NULL;
+
+    plog(LOG_DEBUG,
+              "Population size is %d at start of iteration %d",
+              pop->orig_size, iteration );
+
+    gaul_profile_iteration_start(pop);
+
+/*
+ * Mating cycle.
+ *
+ * Select pairs of entities to mate via crossover. (Sexual reproduction).
+ *
+ * Score the new entities as we go.
+ */
+    plog(LOG_VERBOSE, "*** Mating ***");
+
+    pop->select_state = 0;
+
+    gaul_profile_start(pop, GA_PHASE_SELECTION);
+    pop->select_two(pop, &mother, &father);
+    gaul_profile_stop(pop);
+
+    if (mother && father)
+      {
+      plog(LOG_VERBOSE, "Crossover between %d (%d = %f) and %d (%d = %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness,
+             ga_get_entity_id(pop, father),
+             ga_get_entity_rank(pop, father), father->fitness);
+
+      gaul_profile_start(pop, GA_PHASE_CROSSOVER);
+      son = ga_get_free_entity(pop);
+      daughter = ga_get_free_entity(pop);
+      pop->crossover(pop, mother, father, daughter, son);
+      gaul_profile_stop(pop);
+
+      gaul_profile_start(pop, GA_PHASE_EVALUATION);
+      if ( gaul_evaluate(pop, daughter) == FALSE )
+        {
+        ga_entity_dereference(pop, daughter);
+        daughter = NULL;
+        }
+      if ( gaul_evaluate(pop, son) == FALSE )
+        {
+        ga_entity_dereference(pop, son);
+        son = NULL;
+        }
+      gaul_profile_stop(pop);
+      }
+    else
+      {
+      plog( LOG_VERBOSE, "Crossover not performed." );
+      }
+
+/*
+ * Mutation cycle.
+ *
+ * Select entities to undergo asexual reproduction, in which case the child will
+ * have a genetic mutation of some type.
+ *
+ * Score the new entities as we go.
+ */
+    plog(LOG_VERBOSE, "*** Mutation ***");
+
+    pop->select_state = 0;
+
+    gaul_profile_start(pop, GA_PHASE_SELECTION);
+    pop->select_one(pop, &mother);
+    gaul_profile_stop(pop);
+
+    if (mother)
+      {
+      plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness );
+
+      gaul_profile_start(pop, GA_PHASE_MUTATION);
+      child = ga_get_free_entity(pop);
+      pop->mutate(pop, mother, child);
+      gaul_profile_stop(pop);
+
+      gaul_profile_start(pop, GA_PHASE_EVALUATION);
+      if ( gaul_evaluate(pop, child) == FALSE )
+        {
+        ga_entity_dereference(pop, child);
+        child = NULL;
+        }
+      gaul_profile_stop(pop);
+      }
+    else
+      {
+      plog( LOG_VERBOSE, "Mutation not performed." );
+      }
+
+/*
+ * Environmental adaptation.
+ *
+ * Skipped in the case of Darwinian evolution.
+ * Performed in the case of Baldwinian evolution.
+ * Performed, and genes are modified, in the case of Lamarckian evolution.
+ *
+ * Maybe, could reoptimise all solutions at each generation.  This would allow
+ * a reduced optimisation protocol and only those solutions which are
+ * reasonable would survive for further optimisation.
+ *
+ * FIXME: This is wrong for GA_SCHEME_BALDWIN, GA_SCHEME_LAMARCK and may be
+ * optimised for GA_SCHEME_BALDWIN_ALL, GA_SCHEME_LAMARCK_ALL. 
+ */
+  if (pop->scheme != GA_SCHEME_DARWIN)
+    {
+    plog(LOG_VERBOSE, "*** Adaptation ***");
+
+    gaul_profile_start(pop, GA_PHASE_ADAPTATION);
+
+    new_pop_size = pop->size;
+
+    switch (pop->scheme)
+      {
+      case (GA_SCHEME_BALDWIN_CHILDREN):
+        /* Baldwinian evolution for children only. */
+        for (i=pop->orig_size; i<new_pop_size; i++)
+          {
+          adult = pop->adapt(pop, pop->entity_iarray[i]);
+          pop->entity_iarray[i]->fitness=adult->fitness;
+/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_BALDWIN_ALL):
+        /* Baldwinian evolution for entire population. */
+        /* I don't recommend this, but it is here for completeness. */
+        for (i=0; i<new_pop_size; i++)
+          {
+          adult = pop->adapt(pop, pop->entity_iarray[i]);
+          pop->entity_iarray[i]->fitness=adult->fitness;
+/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_LAMARCK_CHILDREN):
+        /* Lamarckian evolution for children only. */
+        while (new_pop_size>pop->orig_size)
+          {
+          new_pop_size--;
+          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_LAMARCK_ALL):
+        /* Lamarckian evolution for entire population. */
+        while (new_pop_size>0)
+          {
+          new_pop_size--;
+          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      default:
+        dief("Unknown evolutionary scheme %d.\n", pop->scheme);
+      }
+
+    gaul_profile_stop(pop);
+    }
+
+/*
+ * Insert new entities into population.
+ */
+    gaul_profile_start(pop, GA_PHASE_SURVIVAL);
+    if (son) pop->replace(pop, son);
+    if (daughter) pop->replace(pop, daughter);
+    if (child) pop->replace(pop, child);
+    gaul_profile_stop(pop);
+
+    gaul_profile_iteration_stop(pop);
+
+/*
+ * End of generation.
+ */
+    plog(LOG_VERBOSE, "*** Analysis ***");
+
+    plog(LOG_VERBOSE,
+          "After iteration %d, population has fitness scores between %f and %f",
+          iteration,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
+
+    gaul_checkpoint_generation(pop, 0, NULL);
+
+    }	/* Iteration loop. */
+
+  ga_population_checkpoint_wait(pop);
+
+  return (iteration<max_iterations);
+  }
+
+
+/**********************************************************************
+  ga_evolution_steady_state_with_stats()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given population.
+		This is a steady-state GA.
+		ga_genesis(), or equivalent, must be called prior to
+		this function.
+  parameters:
+  return:
+  last updated:	17 Feb 2005
+ **********************************************************************/
+
+#ifdef COMPILE_DEPRECATED_FUNCTIONS
+
+GAULFUNC void ga_evolution_steady_state_with_stats(	population	*pop,
+						const int	max_iterations )
+  {
+  int		iteration=0;		/* Current iteration count. */
+  int		i;			/* Loop over members of population. */
+  entity	*mother, *father;	/* Parent entities. */
+  entity	*son, *daughter, *child;	/* Child entities. */
+  entity	*adult;			/* Temporary copy for gene optimisation. */
+  int		new_pop_size;		/* Population size prior to adaptation. */
+  FILE		*STATS_OUT;		/* Filehandle for stats log. */
+  char		stats_fname[80];	/* Filename for stats log. */
+  int		crossover_good, crossover_poor;	/* Fornication statistics. */
+  int		mutation_good, mutation_poor;	/*  - " -  */
+  double	crossover_gain, mutation_gain;	/*  - " -  */
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pop->crossover) die("Population's crossover callback is undefined.");
+  if (!pop->replace) die("Population's replacement callback is undefined.");
+  if (!pop->rank) die("Population's ranking callback is undefined.");
+  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+
+  plog(LOG_WARNING, "This is a deprecated function!");
+
+  plog(LOG_VERBOSE, "The evolution has begun!");
+
+  pop->generation = 0;
+
+/*
+ * Create name for statistics log file.
+ * Write a simple header to that file.
+ */
+  sprintf(stats_fname, "ga_stats_%d.dat", (int) getpid());
+  STATS_OUT = fopen(stats_fname, "a");
+  fprintf(STATS_OUT, "gen crossover mutation\n");
+  fclose(STATS_OUT);
+
+/*
+ * Score and sort the initial population members.
+ */
+  if (pop->size < pop->stable_size)
+    gaul_population_fill(pop, pop->stable_size - pop->size);
+  gaul_ensure_evaluations(pop);
+  sort_population(pop);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+
+  plog( LOG_VERBOSE,
+        "Prior to the first iteration, population has fitness scores between %f and %f",
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
+
+/* Do all the iterations: */
+  while ( gaul_generation_hook(pop, iteration) &&
+           iteration<max_iterations )
+    {
+    iteration++;
+    pop->orig_size = pop->size;
+
+    son = NULL;
+    daughter = NULL;
+    child = NULL;
+
+    plog(LOG_DEBUG,
+              "Population size is %d at start of iteration %d",
+              pop->orig_size, iteration );
+
+/*
+ * Zero statistics.
+ */
+    crossover_good=0;
+    crossover_poor=0;
+    mutation_good=0;
+    mutation_poor=0;
+
+    crossover_gain=0.0;
+    mutation_gain=0.0;
+
+/*
+ * Mating cycle.
+ *
+ * Select pairs of entities to mate via crossover. (Sexual reproduction).
+ *
+ * Score the new entities as we go.
+ */
+    plog(LOG_VERBOSE, "*** Mating ***");
+
+    pop->select_state = 0;
+
+    pop->select_two(pop, &mother, &father);
+
+    if (mother && father)
+      {
+      plog(LOG_VERBOSE, "Crossover between %d (%d = %f) and %d (%d = %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness,
+             ga_get_entity_id(pop, father),
+             ga_get_entity_rank(pop, father), father->fitness);
+
+      son = ga_get_free_entity(pop);
+      daughter = ga_get_free_entity(pop);
+      pop->crossover(pop, mother, father, daughter, son);
+      if ( gaul_evaluate(pop, daughter) == FALSE )
+        daughter->fitness = GA_MIN_FITNESS;
+      if ( gaul_evaluate(pop, son) == FALSE )
+        son->fitness = GA_MIN_FITNESS;
+
+/*
+ * Collate stats.
+ */
+      if (son->fitness > father->fitness)
+        crossover_good++;
+      else
+        crossover_poor++;
+      if (daughter->fitness > father->fitness)
+        crossover_good++;
+      else
+        crossover_poor++;
+      if (son->fitness > mother->fitness)
+        crossover_good++;
+      else
+        crossover_poor++;
+      if (daughter->fitness > mother->fitness)
+        crossover_good++;
+      else
+        crossover_poor++;
+
+      if (son->fitness > MAX(mother->fitness,father->fitness))
+        crossover_gain += son->fitness-MAX(mother->fitness,father->fitness);
+      if (daughter->fitness > MAX(mother->fitness,father->fitness))
+        crossover_gain += daughter->fitness-MAX(mother->fitness,father->fitness);
+
+      }
+    else
+      {
+      plog( LOG_VERBOSE, "Crossover not performed." );
+      }
+
+/*
+ * Mutation cycle.
+ *
+ * Select entities to undergo asexual reproduction, in which case the child will
+ * have a genetic mutation of some type.
+ *
+ * Score the new entities as we go.
+ */
+    plog(LOG_VERBOSE, "*** Mutation ***");
+
+    pop->select_state = 0;
+
+    pop->select_one(pop, &mother);
+
+    if (mother)
+      {
+      plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
+             ga_get_entity_id(pop, mother),
+             ga_get_entity_rank(pop, mother), mother->fitness );
+
+      child = ga_get_free_entity(pop);
+      pop->mutate(pop, mother, child);
+      if ( gaul_evaluate(pop, child) == FALSE )
+        child->fitness = GA_MIN_FITNESS;
+
+/*
+ * Collate stats.
+ */
+      if (child->fitness > mother->fitness)
+        {
+        mutation_good++;
+        mutation_gain += child->fitness-mother->fitness;
+        }
+      else
+        {
+        mutation_poor++;
+        }
+
+      }
+    else
+      {
+      plog( LOG_VERBOSE, "Mutation not performed." );
+      }
+
+/*
+ * Environmental adaptation.
+ *
+ * Skipped in the case of Darwinian evolution.
+ * Performed in the case of Baldwinian evolution.
+ * Performed, and genes are modified, in the case of Lamarckian evolution.
+ *
+ * Maybe, could reoptimise all solutions at each generation.  This would allow
+ * a reduced optimisation protocol and only those solutions which are
+ * reasonable would survive for further optimisation.
+ *
+ * FIXME: This is wrong for GA_SCHEME_BALDWIN, GA_SCHEME_LAMARCK and may be
+ * optimised for GA_SCHEME_BALDWIN_ALL, GA_SCHEME_LAMARCK_ALL. 
+ */
+  if (pop->scheme != GA_SCHEME_DARWIN)
+    {
+    plog(LOG_VERBOSE, "*** Adaptation ***");
+
+    new_pop_size = pop->size;
+
+    switch (pop->scheme)
+      {
+      case (GA_SCHEME_BALDWIN_CHILDREN):
+        /* Baldwinian evolution for children only. */
+        for (i=pop->orig_size; i<new_pop_size; i++)
+          {
+          adult = pop->adapt(pop, pop->entity_iarray[i]);
+          pop->entity_iarray[i]->fitness=adult->fitness;
+/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_BALDWIN_ALL):
+        /* Baldwinian evolution for entire population. */
+        /* I don't recommend this, but it is here for completeness. */
+        for (i=0; i<new_pop_size; i++)
+          {
+          adult = pop->adapt(pop, pop->entity_iarray[i]);
+          pop->entity_iarray[i]->fitness=adult->fitness;
+/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_LAMARCK_CHILDREN):
+        /* Lamarckian evolution for children only. */
+        while (new_pop_size>pop->orig_size)
+          {
+          new_pop_size--;
+          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      case (GA_SCHEME_LAMARCK_ALL):
+        /* Lamarckian evolution for entire population. */
+        while (new_pop_size>0)
+          {
+          new_pop_size--;
+          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
+          ga_entity_dereference_by_rank(pop, new_pop_size);
+          }
+        break;
+      default:
+        dief("Unknown evolutionary scheme %d.\n", pop->scheme);
+      }
+    }
+
+/*
+ * Insert new entities into population.
+ */
+    if (son) pop->replace(pop, son);
+    if (daughter) pop->replace(pop, daughter);
+    if (child) pop->replace(pop, child);
+
+/*
+ * End of generation.
+ */
+    plog(LOG_VERBOSE, "*** Analysis ***");
+
+    plog(LOG_VERBOSE,
+          "After iteration %d, population has fitness scores between %f and %f",
+          iteration,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
+
+/*
+ * Write statistics.
+ */
+    STATS_OUT = fopen(stats_fname, "a");
+    fprintf(STATS_OUT, "%d: %d-%d %f %d-%d %f\n", iteration,
+            crossover_good, crossover_poor, crossover_gain,
+            mutation_good, mutation_poor, mutation_gain);
+    fclose(STATS_OUT);
+
+    }	/* Iteration loop. */
+
+  return (iteration<max_iterations);
+  }
+#endif
+
+
+/**********************************************************************
+  ga_random_mutation_hill_climbing()
+  synopsis:	Perform equivalent to zero temperature metropolis
+		optimisation.  If initial solution is NULL, then a
+		random initial solution is generated.
+		The original entity will not be munged.
+
+		-- This function is deprecated! --
+  parameters:
+  return:	Best solution found.
+  last updated:	18/12/00
+ **********************************************************************/
+
+#ifdef COMPILE_DEPRECATED_FUNCTIONS
+
+GAULFUNC entity *ga_random_mutation_hill_climbing(	population	*pop,
+						entity		*initial,
+						const int	max_iterations)
+  {
+  int		iteration=0;			/* Current iteration number. */
+  entity	*current, *best, *new, *temp;	/* The solutions. */
+#if GA_WRITE_STATS==TRUE
+  FILE		*STATS_OUT;			/* Filehandle for stats log. */
+  char		stats_fname[80];		/* Filename for stats log. */
+#endif
+
+/* Checks. */
+  if ( !pop ) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->mutate) die("Population's mutation callback is undefined.");
+
+  plog(LOG_WARNING, "This is a deprecated function!");
+
+  current = ga_get_free_entity(pop);	/* The 'working' solution. */
+  best = ga_get_free_entity(pop);	/* The best solution so far. */
+
+/* Do we need to generate a random starting solution? */
+  if (!initial)
+    {
+    plog(LOG_VERBOSE, "Will perform RMHC optimisation with random starting solution.");
+
+    ga_entity_seed(pop, best);
+    }
+  else
+    {
+    plog(LOG_VERBOSE, "Will perform RMHC optimisation with specified starting solution.");
+    ga_entity_copy(pop, best, initial);
+    }
+
+/*
+ * Create name for statistics log file.
+ * Write a simple header to that file.
+ */
+#if GA_WRITE_STATS==TRUE
+  sprintf(stats_fname, "rmhc_stats_%d.dat", (int) getpid());
+  STATS_OUT = fopen(stats_fname, "a");
+  fprintf(STATS_OUT, "Random Mutation Hill Climbing\n");
+  fclose(STATS_OUT);
+#endif
+
+/*
+ * Score the initial solution.
+ */
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
+  plog(LOG_DEBUG,
+       "Prior to the scoring, the solution has fitness score of %f",
+       best->fitness );
+
+/*
+ * Copy best solution found over current solution.
+ */
+  ga_entity_copy(pop, current, best);
+  new = ga_get_free_entity(pop);
+
+/* Do all the iterations: */
+  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
+           iteration<max_iterations )
+    {
+    iteration++;
+
+    plog( LOG_VERBOSE,
+          "Prior to the iteration %d, the solution has fitness score of %f",
+          iteration, current->fitness );
+
+/*
+ * Perform random mutation.
+ */
+    plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
+         ga_get_entity_id(pop, current),
+         ga_get_entity_rank(pop, current), current->fitness );
+
+    pop->mutate(pop, current, new);
+
+    temp = current;
+    current = new;
+    new = temp;
+
+    gaul_evaluate(pop, current);
+
+    if (best->fitness < current->fitness)
+      {
+/*        plog(LOG_DEBUG, "Selecting new solution.");*/
+      ga_entity_blank(pop, best);
+      ga_entity_copy(pop, best, current);
+      }
+    else
+      {
+      ga_entity_blank(pop, current);
+      ga_entity_copy(pop, current, best);
+      }
+
+    ga_entity_blank(pop, new);
+
+/*
+ * Write statistics.
+ */
+#if GA_WRITE_STATS==TRUE
+    STATS_OUT = fopen(stats_fname, "a");
+    fprintf(STATS_OUT, "%d: %f\n", iteration, best->fitness);
+    fclose(STATS_OUT);
+#endif
+    }
+
+  plog( LOG_VERBOSE,
+        "After final iteration, the solution has fitness score of %f",
+        current->fitness );
+
+/*
+ * Current no longer needed.  It is upto the caller to dereference the
+ * optimum solution found.
+ */
+  ga_entity_dereference(pop, current);
+
+  return best;
+  }
+#endif
+
+
+/**********************************************************************
+  ga_next_ascent_hill_climbing()
+  synopsis:	Perform systematic ascent hill climbing optimisation.
+		(Needn't nessecarily use next allele each time, but
+	       	this was the simplist to implement.)
+		If initial solution is NULL, then a randomly generated
+		initial solution is generated.
+		The original entity will not be munged.
+		NOTE: Needs to be passed an 'extended' mutation
+		function.
+		max_iterations refers to the number of _complete_
+		cycles.
+  parameters:
+  return:	Best solution found.
+  last updated:	21/12/00
+ **********************************************************************/
+
+#ifdef COMPILE_DEPRECATED_FUNCTIONS
+
+entity *old_ga_next_ascent_hill_climbing(	population		*pop,
+					entity			*initial,
+					const int		max_iterations,
+					GAspecificmutate	mutationfunc)
+  {
+  int		iteration=0;		/* Current iteration number. */
+  entity	*current, *best;	/* The solutions. */
+  int		chromo=0, point=0;	/* Mutation locus. */
+#if GA_WRITE_STATS==TRUE
+  FILE		*STATS_OUT;		/* Filehandle for stats log. */
+  char		stats_fname[80];	/* Filename for stats log. */
+#endif
+
+  plog(LOG_WARNING, "This is a deprecated function!");
+
+/* Checks. */
+  if ( !pop ) die("NULL pointer to population structure passed.");
+  if ( !pop->evaluate ) die("Population's evaluation callback is undefined.");
+  if ( !mutationfunc ) die("Mutation callback is undefined.");
+
+  current = ga_get_free_entity(pop);	/* The 'working' solution. */
+  best = ga_get_free_entity(pop);	/* The best solution so far. */
+
+  plog(LOG_FIXME, "NAHC algorithm is not parallelised.");
+
+/* Do we need to generate a random starting solution? */
+  if (!initial)
+    {
+    plog(LOG_VERBOSE, "Will perform NAHC optimisation with random starting solution.");
+
+    ga_entity_seed(pop, best);
+    }
+  else
+    {
+    plog(LOG_VERBOSE, "Will perform NAHC optimisation with specified starting solution.");
+    ga_entity_copy(pop, best, initial);
+    }
+
+/*
+ * Create name for statistics log file.
+ * Write a simple header to that file.
+ */
+#if GA_WRITE_STATS==TRUE
+  sprintf(stats_fname, "nahc_stats_%d.dat", (int) getpid());
+  STATS_OUT = fopen(stats_fname, "a");
+  fprintf(STATS_OUT, "Next Ascent Hill Climbing\n");
+  fclose(STATS_OUT);
+#endif
+
+/*
+ * Score the initial solution.
+ */
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
+  plog(LOG_DEBUG, "Prior to the scoring, the solution has fitness score of %f", best->fitness );
+
+/*
+ * Copy best solution found over current solution.
+ */
+  ga_entity_copy(pop, current, best);
+
+/* Do all the iterations: */
+  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
+           iteration<max_iterations )
+    {
+
+    plog( LOG_VERBOSE,
+          "Iteration %d chromosome %d, point %d, solution has fitness score of %f",
+          iteration, chromo, point,
+          current->fitness );
+
+    mutationfunc(chromo, point, current->chromosome[chromo]);
+
+    ga_entity_clear_data(pop, current, chromo);	/* Required to force regeneration of structural data. */
+    gaul_evaluate(pop, current);
+
+/*
+ * Is current better than best?
+ */
+    if (best->fitness < current->fitness)
+      {
+/*        plog(LOG_DEBUG, "Selecting new solution.");*/
+      ga_entity_blank(pop, best);
+      ga_entity_copy(pop, best, current);
+      }
+    else
+      {
+      ga_entity_blank(pop, current);
+      ga_entity_copy(pop, current, best);
+      }
+
+/*
+ * Write statistics.
+ */
+#if GA_WRITE_STATS==TRUE
+    STATS_OUT = fopen(stats_fname, "a");
+    fprintf(STATS_OUT, "%d: %f (%d %d)\n", iteration, best->fitness, chromo, point);
+    fclose(STATS_OUT);
+#endif
+
+/*
+ * Choose next nucleotide to mutate/optimise.
+ */
+    point++;
+    if (point == pop->len_chromosomes)
+      {
+      point = 0;
+      chromo++;
+      if (chromo == pop->num_chromosomes)
+        {
+        chromo=0;
+        iteration++;
+        }
+      }
+    }
+
+  plog( LOG_VERBOSE,
+        "After final iteration, the solution has fitness score of %f",
+        current->fitness );
+
+/*
+ * Current no longer needed.  It is upto the caller to dereference the
+ * optimum solution found.
+ */
+  ga_entity_dereference(pop, current);
+
+  return best;
+  }
+#endif
+
+
+/**********************************************************************
+  ga_metropolis_mutation()
+  synopsis:	Perform arbitrary temperature metropolis optimisation.
+		If initial solution is NULL, then random solution is
+		generated.  Syncs with other processors every iteration
+		and grabs the overall best solution if better than
+		this processors current solution is worse than the best
+		plus the temperature. 
+		The original entity will not be munged.
+  parameters:
+  return:	Best solution found.
+  last updated:	19/01/01
+ **********************************************************************/
+
+#ifdef COMPILE_DEPRECATED_FUNCTIONS
+
+GAULFUNC entity *ga_metropolis_mutation(	population		*pop,
+				entity			*initial,
+				const int		max_iterations,
+				const int 		temperature)
+  {
+  int		iteration=0;			/* Current iteration number. */
+  entity	*current, *best, *fresh;	/* The solutions. */
+  entity	*temp=NULL;			/* Used for swapping current and new. */
+#if GA_WRITE_STATS==TRUE
+  FILE		*STATS_OUT;			/* Filehandle for stats log. */
+  char		stats_fname[80];		/* Filename for stats log. */
+#endif
+
+  plog(LOG_NORMAL, "This function is deprecated!");
+
+/* Checks. */
+  if ( !pop ) die("NULL pointer to population structure passed.");
+  if ( !pop->evaluate ) die("Population's evaluation callback is undefined.");
+  if ( !pop->mutate ) die("Population's mutation callback is undefined.");
+
+  current = ga_get_free_entity(pop);	/* The 'working' solution. */
+  best = ga_get_free_entity(pop);	/* The best solution so far. */
+
+  plog(LOG_FIXME, "Metropolis algorithm is not parallelised.");
+
+/* Do we need to generate a random starting solution? */
+  if (!initial)
+    {
+    plog(LOG_VERBOSE, "Will perform metropolis optimisation at %d degrees with random starting solution.", temperature);
+
+    ga_entity_seed(pop, best);
+    }
+  else
+    {
+    plog(LOG_VERBOSE, "Will perform metropolis optimisation at %d degrees.");
+    ga_entity_copy(pop, best, initial);
+    }
+
+/*
+ * Create name for statistics log file.
+ * Write a simple header to that file.
+ */
+#if GA_WRITE_STATS==TRUE
+  sprintf(stats_fname, "mstats_%d.dat", (int) getpid());
+  STATS_OUT = fopen(stats_fname, "a");
+  fprintf(STATS_OUT, "Metropolis optimisation at %d degrees.\n", temperature);
+  fclose(STATS_OUT);
+#endif
+
+/*
+ * Score the initial solution.
+ */
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
+  plog(LOG_DEBUG, "Prior to the scoring, the solution has fitness score of %f", best->fitness );
+
+/*
+ * Copy best solution found over current solution.
+ */
+  ga_entity_copy(pop, current, best);
+  fresh = ga_get_free_entity(pop);
+
+/* Do all the iterations: */
+  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
+           iteration<max_iterations )
+    {
+    iteration++;
+
+    plog(LOG_VERBOSE,
+              "Prior to iteration %d, solution has fitness score of %f",
+              iteration, current->fitness );
+
+/*
+ * Perform random mutation.
+ */
+    plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
+         ga_get_entity_id(pop, current),
+         ga_get_entity_rank(pop, current), current->fitness );
+
+    pop->mutate(pop, current, fresh);
+
+    temp = current;
+    current = fresh;
+    fresh = temp;
+
+    gaul_evaluate(pop, current);
+
+/*
+ * Should we keep this solution?
+ */
+    if ( best->fitness < current->fitness ||
+         random_boolean_prob(exp((current->fitness-best->fitness)
+                                   /(GA_BOLTZMANN_FACTOR*temperature))) )
+      {
+/*        plog(LOG_DEBUG, "Selecting fresh solution."); */
+      ga_entity_blank(pop, best);
+      ga_entity_copy(pop, best, current);
+      }
+    else
+      {
+/*        plog(LOG_DEBUG, "Rejecting fresh solution."); */
+      ga_entity_blank(pop, current);
+      ga_entity_copy(pop, current, best);
+      }  
+
+    ga_entity_blank(pop, fresh);
+
+/*
+ * Write statistics.
+ */
+#if GA_WRITE_STATS==TRUE
+    STATS_OUT = fopen(stats_fname, "a");
+    fprintf(STATS_OUT, "%d: %f\n", iteration, best->fitness);
+    fclose(STATS_OUT);
+#endif
+    }
+
+  plog( LOG_VERBOSE,
+        "After final iteration, solution has fitness score of %f",
+        best->fitness );
+
+/*
+ * Current no longer needed.  It is upto the caller to dereference the
+ * optimum solution found.
+ */
+  ga_entity_dereference(pop, current);
+  ga_entity_dereference(pop, temp);
+
+  return best;
+  }
+#endif
+
+
+/**********************************************************************
+  ga_simulated_annealling_mutation()
+  synopsis:	Perform mutation/SA (GA mutation/Simulated Annealling).
+		If initial solution is NULL, then random solution is
+		generated.  Syncs with other processors every iteration
+		and grabs the overall best solution if better than
+		this processors current solution is worse than the best
+		plus the temperature. 
+		The original entity will not be munged.
+  parameters:
+  return:	Best solution found.
+  last updated:	21/02/01
+ **********************************************************************/
+
+#ifdef COMPILE_DEPRECATED_FUNCTIONS
+
+GAULFUNC entity *ga_simulated_annealling_mutation(population	*pop,
+					entity		*initial,
+					const int	max_iterations,
+					const int 	initial_temperature,
+					const int 	final_temperature)
+  {
+  int		iteration=0;			/* Current iteration number. */
+  entity	*current, *best, *fresh;	/* The solutions. */
+  entity	*temp=NULL;			/* Used for swapping current and new solutions. */
+  int		temperature;			/* Current temperature. */
+#if GA_WRITE_STATS==TRUE
+  FILE		*STATS_OUT;			/* Filehandle for stats log. */
+  char		stats_fname[80];		/* Filename for stats log. */
+#endif
+
+  plog(LOG_NORMAL, "This function is deprecated!");
+
+/* Checks. */
+  if ( !pop ) die("NULL pointer to population structure passed.");
+  if ( !pop->evaluate ) die("Population's evaluation callback is undefined.");
+  if ( !pop->mutate ) die("Population's mutation callback is undefined.");
+
+  current = ga_get_free_entity(pop);	/* The 'working' solution. */
+  best = ga_get_free_entity(pop);	/* The best solution so far. */
 
-GAULFUNC int ga_evolution_steady_state(	population		*pop,
-				const int		max_iterations )
-  {
-  int		iteration=0;		/* Current iteration count. */
-  int		i;			/* Loop over members of population. */
-  entity	*mother, *father;	/* Parent entities. */
-  entity	*son, *daughter, *child;	/* Child entities. */
-  entity	*adult;			/* Temporary copy for gene optimisation. */
-  int		new_pop_size;		/* Population size prior to adaptation. */
+  plog(LOG_FIXME, "Simulated annealling algorithm is not parallelised.");
 
-/* Checks. */
-  if (!pop) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
-  if (!pop->crossover) die("Population's crossover callback is undefined.");
-  if (!pop->replace) die("Population's replacement callback is undefined.");
-  if (!pop->rank) die("Population's ranking callback is undefined.");
-  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+/* Do we need to generate a random starting solution? */
+  if (!initial)
+    {
+    plog(LOG_VERBOSE, "Will perform %d steps of MC/SA optimisation between %d and %d degrees with random starting solution.", max_iterations, initial_temperature, final_temperature);
 
-  plog(LOG_VERBOSE, "The evolution has begun!");
+    ga_entity_seed(pop, best);
+    }
+  else
+    {
+    plog(LOG_VERBOSE, "Will perform %d steps of MC/SA optimisation between %d and %d degrees.", max_iterations, initial_temperature, final_temperature);
 
-  pop->generation = 0;
+    ga_entity_copy(pop, best, initial);
+    }
 
 /*
- * Score and sort the initial population members.
+ * Create name for statistics log file.
+ * Write a simple header to that file.
  */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations(pop);
-  sort_population(pop);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+#if GA_WRITE_STATS==TRUE
+  sprintf(stats_fname, "sastats_%d.dat", (int) getpid());
+  STATS_OUT = fopen(stats_fname, "a");
+  fprintf(STATS_OUT, "MC/SA optimisation at %d to %d degrees.\n",
+                     initial_temperature, final_temperature);
+  fclose(STATS_OUT);
+#endif
 
-  plog( LOG_VERBOSE,
-        "Prior to the first iteration, population has fitness scores between %f and %f",
-        pop->entity_iarray[0]->fitness,
-        pop->entity_iarray[pop->size-1]->fitness );
+/*
+ * Score the initial solution.
+ */
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
+  plog(LOG_DEBUG, "Prior to the scoring, the solution has fitness score of %f", best->fitness );
+
+/*
+ * Copy best solution over current solution.
+ */
+  ga_entity_copy(pop, current, best);
+  fresh = ga_get_free_entity(pop);
 
 /* Do all the iterations: */
-  while ( (pop->generation_hook?pop->generation_hook(iteration, pop):TRUE) &&
+  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
            iteration<max_iterations )
     {
+    temperature = initial_temperature + ((double)iteration/max_iterations)*(final_temperature-initial_temperature);
     iteration++;
-    pop->orig_size = pop->size;
-
-    son = NULL;
-    daughter = NULL;
-    child = NULL;
 
-    plog(LOG_DEBUG,
-              "Population size is %d at start of iteration %d",
-              pop->orig_size, iteration );
+    plog( LOG_VERBOSE,
+          "Prior to iteration %d temperature %d, solution has fitness score of %f",
+          iteration, temperature, current->fitness );
 
 /*
- * Mating cycle.
- *
- * Select pairs of entities to mate via crossover. (Sexual reproduction).
- *
- * Score the new entities as we go.
+ * Perform random mutation.
  */
-    plog(LOG_VERBOSE, "*** Mating ***");
+    plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
+       ga_get_entity_id(pop, current),
+       ga_get_entity_rank(pop, current), current->fitness );
 
-    pop->select_state = 0;
+    pop->mutate(pop, current, fresh);
 
-    pop->select_two(pop, &mother, &father);
+    temp = current;
+    current = fresh;
+    fresh = temp;
 
-    if (mother && father)
-      {
-      plog(LOG_VERBOSE, "Crossover between %d (%d = %f) and %d (%d = %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness,
-             ga_get_entity_id(pop, father),
-             ga_get_entity_rank(pop, father), father->fitness);
+    gaul_evaluate(pop, current);
 
-      son = ga_get_free_entity(pop);
-      daughter = ga_get_free_entity(pop);
-      pop->crossover(pop, mother, father, daughter, son);
-      if ( pop->evaluate(pop, daughter) == FALSE )
-        {
-        ga_entity_dereference(pop, daughter);
-        daughter = NULL;
-        }
-      if ( pop->evaluate(pop, son) == FALSE )
-        {
-        ga_entity_dereference(pop, son);
-        son = NULL;
-        }
+/*
+ * Should we keep this solution?
+      if ( best->fitness < current->fitness ||
+           random_boolean_prob(exp((current->fitness-best->fitness)
+                                   /(GA_BOLTZMANN_FACTOR*temperature))) )
+ */
+    if ( best->fitness < current->fitness+temperature )
+      { /* Copy this solution best solution. */
+/*        plog(LOG_DEBUG, "Selecting fresh solution.");*/
+      ga_entity_blank(pop, best);
+      ga_entity_copy(pop, best, current);
       }
     else
-      {
-      plog( LOG_VERBOSE, "Crossover not performed." );
+      { /* Copy best solution over current solution. */
+/*        plog(LOG_DEBUG, "Rejecting fresh solution.");*/
+      ga_entity_blank(pop, current);
+      ga_entity_copy(pop, current, best);
       }
 
+    ga_entity_blank(pop, fresh);
+
 /*
- * Mutation cycle.
- *
- * Select entities to undergo asexual reproduction, in which case the child will
- * have a genetic mutation of some type.
- *
- * Score the new entities as we go.
+ * Write statistics.
  */
-    plog(LOG_VERBOSE, "*** Mutation ***");
+#if GA_WRITE_STATS==TRUE
+    STATS_OUT = fopen(stats_fname, "a");
+    fprintf(STATS_OUT, "%d: (%d degrees) %f\n",
+            iteration, temperature, best->fitness);
+    fclose(STATS_OUT);
+#endif
+    }
 
-    pop->select_state = 0;
+  plog(LOG_VERBOSE,
+            "After final iteration, the solution has fitness score of %f",
+            best->fitness );
 
-    pop->select_one(pop, &mother);
+/*
+ * Current no longer needed.  It is upto the caller to dereference the
+ * optimum solution found.
+ */
+  ga_entity_dereference(pop, current);
+  ga_entity_dereference(pop, temp);
 
-    if (mother)
-      {
-      plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness );
+  return best;
+  }
+#endif
 
-      child = ga_get_free_entity(pop);
-      pop->mutate(pop, mother, child);
-      if ( pop->evaluate(pop, child) == FALSE )
-        {
-        ga_entity_dereference(pop, child);
-        child = NULL;
-        }
-      }
-    else
-      {
-      plog( LOG_VERBOSE, "Mutation not performed." );
-      }
 
-/*
- * Environmental adaptation.
- *
- * Skipped in the case of Darwinian evolution.
- * Performed in the case of Baldwinian evolution.
- * Performed, and genes are modified, in the case of Lamarckian evolution.
- *
- * Maybe, could reoptimise all solutions at each generation.  This would allow
- * a reduced optimisation protocol and only those solutions which are
- * reasonable would survive for further optimisation.
- *
- * FIXME: This is wrong for GA_SCHEME_BALDWIN, GA_SCHEME_LAMARCK and may be
- * optimised for GA_SCHEME_BALDWIN_ALL, GA_SCHEME_LAMARCK_ALL. 
- */
-  if (pop->scheme != GA_SCHEME_DARWIN)
-    {
-    plog(LOG_VERBOSE, "*** Adaptation ***");
+/**********************************************************************
+  gaul_topology_add()
+  synopsis:	Append a destination island, unless it is the source
+		island or is already present.
+  parameters:	int *destinations
+		int num_destinations
+		const int source
+		const int destination
+  return:	New number of destinations.
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-    new_pop_size = pop->size;
+static int gaul_topology_add( int *destinations, int num_destinations,
+                              const int source, const int destination )
+  {
+  int		i;		/* Loop over existing destinations. */
 
-    switch (pop->scheme)
+  if (destination == source) return num_destinations;
+
+  for (i=0; i<num_destinations; i++)
+    if (destinations[i] == destination) return num_destinations;
+
+  destinations[num_destinations] = destination;
+
+  return num_destinations+1;
+  }
+
+
+/**********************************************************************
+  ga_archipelago_set_topology()
+  synopsis:	Set the migration destinations of every island in an
+		archipelago to form a standard topology:
+		GA_TOPOLOGY_RING	Island i sends to island i-1.
+					(The default.)
+		GA_TOPOLOGY_BIRING	Island i sends to i-1 and i+1.
+		GA_TOPOLOGY_TORUS	Islands form the most nearly
+					square 2-D grid, with wrap-around,
+					and send to their 4 neighbours.
+		GA_TOPOLOGY_HYPERCUBE	Island i sends to each island
+					whose index differs in one bit.
+		GA_TOPOLOGY_FULL	Every island sends to every other.
+		GA_TOPOLOGY_RANDOM	Each island sends to degree
+					distinct islands, drawn once here.
+		Arbitrary graphs may be defined instead with
+		ga_population_set_migration_destinations().
+  parameters:	const int num_pops
+		population **pops
+		const ga_topology_type topology
+		const int degree	Out-degree for GA_TOPOLOGY_RANDOM.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_archipelago_set_topology( const int num_pops,
+                        population              **pops,
+                        const ga_topology_type  topology,
+                        const int               degree )
+  {
+  int		*destinations;	/* Destinations for current island. */
+  int		num;		/* Number of destinations. */
+  int		current_island;	/* Current island number. */
+  int		rows=1, cols;	/* Torus dimensions. */
+  int		row, col;	/* Position in torus. */
+  int		bit;		/* Hypercube dimension. */
+  int		i, j, tmp;	/* Loop and swap variables. */
+
+/* Checks. */
+  if (!pops)
+    die("NULL pointer to array of population structures passed.");
+  if (num_pops<2)
+    die("Need at least two populations for the island model.");
+  if (topology == GA_TOPOLOGY_RANDOM && (degree<1 || degree>=num_pops))
+    die("Invalid degree for random topology.");
+
+  if ( !(destinations = s_malloc(sizeof(int)*num_pops)) )
+    die("Unable to allocate memory");
+
+  for (i=1; i*i<=num_pops; i++)
+    if (num_pops%i == 0) rows = i;
+  cols = num_pops/rows;
+
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    num = 0;
+
+    switch (topology)
       {
-      case (GA_SCHEME_BALDWIN_CHILDREN):
-        /* Baldwinian evolution for children only. */
-        for (i=pop->orig_size; i<new_pop_size; i++)
-          {
-          adult = pop->adapt(pop, pop->entity_iarray[i]);
-          pop->entity_iarray[i]->fitness=adult->fitness;
-/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
+      case GA_TOPOLOGY_RING:
+        num = gaul_topology_add(destinations, num, current_island, (current_island+num_pops-1)%num_pops);
         break;
-      case (GA_SCHEME_BALDWIN_ALL):
-        /* Baldwinian evolution for entire population. */
-        /* I don't recommend this, but it is here for completeness. */
-        for (i=0; i<new_pop_size; i++)
-          {
-          adult = pop->adapt(pop, pop->entity_iarray[i]);
-          pop->entity_iarray[i]->fitness=adult->fitness;
-/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
+
+      case GA_TOPOLOGY_BIRING:
+        num = gaul_topology_add(destinations, num, current_island, (current_island+num_pops-1)%num_pops);
+        num = gaul_topology_add(destinations, num, current_island, (current_island+1)%num_pops);
         break;
-      case (GA_SCHEME_LAMARCK_CHILDREN):
-        /* Lamarckian evolution for children only. */
-        while (new_pop_size>pop->orig_size)
+
+      case GA_TOPOLOGY_TORUS:
+        row = current_island/cols;
+        col = current_island%cols;
+        num = gaul_topology_add(destinations, num, current_island, ((row+rows-1)%rows)*cols+col);
+        num = gaul_topology_add(destinations, num, current_island, ((row+1)%rows)*cols+col);
+        num = gaul_topology_add(destinations, num, current_island, row*cols+(col+cols-1)%cols);
+        num = gaul_topology_add(destinations, num, current_island, row*cols+(col+1)%cols);
+        break;
+
+      case GA_TOPOLOGY_HYPERCUBE:
+        for (bit=1; bit<num_pops; bit<<=1)
           {
-          new_pop_size--;
-          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
+          if ((current_island^bit) < num_pops)
+            num = gaul_topology_add(destinations, num, current_island, current_island^bit);
           }
         break;
-      case (GA_SCHEME_LAMARCK_ALL):
-        /* Lamarckian evolution for entire population. */
-        while (new_pop_size>0)
+
+      case GA_TOPOLOGY_FULL:
+        for (i=0; i<num_pops; i++)
+          num = gaul_topology_add(destinations, num, current_island, i);
+        break;
+
+      case GA_TOPOLOGY_RANDOM:
+        for (i=0; i<num_pops; i++)
+          num = gaul_topology_add(destinations, num, current_island, i);
+        for (i=0; i<degree; i++)
           {
-          new_pop_size--;
-          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
+          j = random_int_range(i, num);
+          tmp = destinations[i];
+          destinations[i] = destinations[j];
+          destinations[j] = tmp;
           }
+        num = degree;
         break;
+
       default:
-        dief("Unknown evolutionary scheme %d.\n", pop->scheme);
+        die("Unknown migration topology.");
       }
-    }
-
-/*
- * Insert new entities into population.
- */
-    if (son) pop->replace(pop, son);
-    if (daughter) pop->replace(pop, daughter);
-    if (child) pop->replace(pop, child);
-
-/*
- * End of generation.
- */
-    plog(LOG_VERBOSE, "*** Analysis ***");
 
-    plog(LOG_VERBOSE,
-          "After iteration %d, population has fitness scores between %f and %f",
-          iteration,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+    ga_population_set_migration_destinations(pops[current_island], num, destinations);
+    }
 
-    }	/* Iteration loop. */
+  s_free(destinations);
 
-  return (iteration<max_iterations);
+  return;
   }
 
 
 /**********************************************************************
-  ga_evolution_steady_state_with_stats()
+  ga_evolution_archipelago()
   synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given population.
-		This is a steady-state GA.
+		optimisation on the given populations using an
+		island model.  Migration follows each population's
+		migration parameters and destinations (cyclic by
+		default).  Migration causes a duplication of the
+		respective entities.  This is a generation-based GA.
 		ga_genesis(), or equivalent, must be called prior to
 		this function.
-  parameters:
-  return:
-  last updated:	17 Feb 2005
+  parameters:	const int	num_pops
+		population	**pops
+		const int	max_generations
+  return:	number of generation performed
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef COMPILE_DEPRECATED_FUNCTIONS
-
-GAULFUNC void ga_evolution_steady_state_with_stats(	population	*pop,
-						const int	max_iterations )
+GAULFUNC int ga_evolution_archipelago( const int num_pops,
+			population		**pops,
+			const int		max_generations )
   {
-  int		iteration=0;		/* Current iteration count. */
-  int		i;			/* Loop over members of population. */
-  entity	*mother, *father;	/* Parent entities. */
-  entity	*son, *daughter, *child;	/* Child entities. */
-  entity	*adult;			/* Temporary copy for gene optimisation. */
-  int		new_pop_size;		/* Population size prior to adaptation. */
-  FILE		*STATS_OUT;		/* Filehandle for stats log. */
-  char		stats_fname[80];	/* Filename for stats log. */
-  int		crossover_good, crossover_poor;	/* Fornication statistics. */
-  int		mutation_good, mutation_poor;	/*  - " -  */
-  double	crossover_gain, mutation_gain;	/*  - " -  */
+  int		generation=0;		/* Current generation number. */
+  int		current_island;		/* Current current_island number. */
+  population	*pop=NULL;		/* Current population. */
+  boolean	complete=FALSE;		/* Whether evolution is terminated. */
+  int		*offsets, *targets;	/* Migration graph. */
 
 /* Checks. */
-  if (!pop) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-  if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
-  if (!pop->crossover) die("Population's crossover callback is undefined.");
-  if (!pop->replace) die("Population's replacement callback is undefined.");
-  if (!pop->rank) die("Population's ranking callback is undefined.");
-  if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
-
-  plog(LOG_WARNING, "This is a deprecated function!");
-
-  plog(LOG_VERBOSE, "The evolution has begun!");
-
-  pop->generation = 0;
-
-/*
- * Create name for statistics log file.
- * Write a simple header to that file.
- */
-  sprintf(stats_fname, "ga_stats_%d.dat", (int) getpid());
-  STATS_OUT = fopen(stats_fname, "a");
-  fprintf(STATS_OUT, "gen crossover mutation\n");
-  fclose(STATS_OUT);
-
-/*
- * Score and sort the initial population members.
- */
-  if (pop->size < pop->stable_size)
-    gaul_population_fill(pop, pop->stable_size - pop->size);
-  gaul_ensure_evaluations(pop);
-  sort_population(pop);
-  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-
-  plog( LOG_VERBOSE,
-        "Prior to the first iteration, population has fitness scores between %f and %f",
-        pop->entity_iarray[0]->fitness,
-        pop->entity_iarray[pop->size-1]->fitness );
+  if (!pops)
+    die("NULL pointer to array of population structures passed.");
+  if (num_pops<2)
+    die("Need at least two populations for the island model.");
 
-/* Do all the iterations: */
-  while ( (pop->generation_hook?pop->generation_hook(iteration, pop):TRUE) &&
-           iteration<max_iterations )
+  for (current_island=0; current_island<num_pops; current_island++)
     {
-    iteration++;
-    pop->orig_size = pop->size;
-
-    son = NULL;
-    daughter = NULL;
-    child = NULL;
-
-    plog(LOG_DEBUG,
-              "Population size is %d at start of iteration %d",
-              pop->orig_size, iteration );
-
-/*
- * Zero statistics.
- */
-    crossover_good=0;
-    crossover_poor=0;
-    mutation_good=0;
-    mutation_poor=0;
+    pop = pops[current_island];
 
-    crossover_gain=0.0;
-    mutation_gain=0.0;
+    if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+    if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+    if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+    if (!pop->mutate) die("Population's mutation callback is undefined.");
+    if (!pop->crossover) die("Population's crossover callback is undefined.");
+    if (!pop->rank) die("Population's ranking callback is undefined.");
+    if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
 
-/*
- * Mating cycle.
- *
- * Select pairs of entities to mate via crossover. (Sexual reproduction).
- *
- * Score the new entities as we go.
- */
-    plog(LOG_VERBOSE, "*** Mating ***");
+/* Set current_island property. */
+    pop->island = current_island;
+    }
 
-    pop->select_state = 0;
+  gaul_migration_graph(num_pops, pops, 0, num_pops, &offsets, &targets);
 
-    pop->select_two(pop, &mother, &father);
+  plog(LOG_VERBOSE, "The evolution has begun on %d islands!", num_pops);
 
-    if (mother && father)
-      {
-      plog(LOG_VERBOSE, "Crossover between %d (%d = %f) and %d (%d = %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness,
-             ga_get_entity_id(pop, father),
-             ga_get_entity_rank(pop, father), father->fitness);
+  pop->generation = 0;
 
-      son = ga_get_free_entity(pop);
-      daughter = ga_get_free_entity(pop);
-      pop->crossover(pop, mother, father, daughter, son);
-      if ( pop->evaluate(pop, daughter) == FALSE )
-        daughter->fitness = GA_MIN_FITNESS;
-      if ( pop->evaluate(pop, son) == FALSE )
-        son->fitness = GA_MIN_FITNESS;
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    pop = pops[current_island];
 
 /*
- * Collate stats.
+ * Score and sort the initial population members.
  */
-      if (son->fitness > father->fitness)
-        crossover_good++;
-      else
-        crossover_poor++;
-      if (daughter->fitness > father->fitness)
-        crossover_good++;
-      else
-        crossover_poor++;
-      if (son->fitness > mother->fitness)
-        crossover_good++;
-      else
-        crossover_poor++;
-      if (daughter->fitness > mother->fitness)
-        crossover_good++;
-      else
-        crossover_poor++;
-
-      if (son->fitness > MAX(mother->fitness,father->fitness))
-        crossover_gain += son->fitness-MAX(mother->fitness,father->fitness);
-      if (daughter->fitness > MAX(mother->fitness,father->fitness))
-        crossover_gain += daughter->fitness-MAX(mother->fitness,father->fitness);
+    if (pop->size < pop->stable_size)
+      gaul_population_fill(pop, pop->stable_size - pop->size);
+    gaul_ensure_evaluations(pop);
+    sort_population(pop);
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+  
+    plog( LOG_VERBOSE,
+          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
+          current_island,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
+    }
 
-      }
-    else
-      {
-      plog( LOG_VERBOSE, "Crossover not performed." );
-      }
+/* Do all the generations: */
+  while ( generation<max_generations && complete==FALSE)
+    {
+    generation++;
+    pop->generation = generation;
 
 /*
- * Mutation cycle.
- *
- * Select entities to undergo asexual reproduction, in which case the child will
- * have a genetic mutation of some type.
- *
- * Score the new entities as we go.
+ * Migration step.
  */
-    plog(LOG_VERBOSE, "*** Mutation ***");
+    gaul_migration(num_pops, pops, generation, offsets, targets);
 
-    pop->select_state = 0;
-
-    pop->select_one(pop, &mother);
-
-    if (mother)
+    for(current_island=0; current_island<num_pops; current_island++)
       {
-      plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
-             ga_get_entity_id(pop, mother),
-             ga_get_entity_rank(pop, mother), mother->fitness );
-
-      child = ga_get_free_entity(pop);
-      pop->mutate(pop, mother, child);
-      if ( pop->evaluate(pop, child) == FALSE )
-        child->fitness = GA_MIN_FITNESS;
+      pop = pops[current_island];
 
-/*
- * Collate stats.
- */
-      if (child->fitness > mother->fitness)
-        {
-        mutation_good++;
-        mutation_gain += child->fitness-mother->fitness;
-        }
-      else
+      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+
+      if (gaul_generation_hook(pop, generation))
         {
-        mutation_poor++;
-        }
+        pop->orig_size = pop->size;
 
-      }
-    else
-      {
-      plog( LOG_VERBOSE, "Mutation not performed." );
-      }
+        plog( LOG_DEBUG,
+              "Population %d size is %d at start of generation %d",
+              current_island, pop->orig_size, generation );
 
 /*
- * Environmental adaptation.
- *
- * Skipped in the case of Darwinian evolution.
- * Performed in the case of Baldwinian evolution.
- * Performed, and genes are modified, in the case of Lamarckian evolution.
- *
- * Maybe, could reoptimise all solutions at each generation.  This would allow
- * a reduced optimisation protocol and only those solutions which are
- * reasonable would survive for further optimisation.
- *
- * FIXME: This is wrong for GA_SCHEME_BALDWIN, GA_SCHEME_LAMARCK and may be
- * optimised for GA_SCHEME_BALDWIN_ALL, GA_SCHEME_LAMARCK_ALL. 
+ * Crossover step.
  */
-  if (pop->scheme != GA_SCHEME_DARWIN)
-    {
-    plog(LOG_VERBOSE, "*** Adaptation ***");
-
-    new_pop_size = pop->size;
+        gaul_crossover(pop);	/* FIXME: Need to pass current_island for messages. */
 
-    switch (pop->scheme)
-      {
-      case (GA_SCHEME_BALDWIN_CHILDREN):
-        /* Baldwinian evolution for children only. */
-        for (i=pop->orig_size; i<new_pop_size; i++)
-          {
-          adult = pop->adapt(pop, pop->entity_iarray[i]);
-          pop->entity_iarray[i]->fitness=adult->fitness;
-/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      case (GA_SCHEME_BALDWIN_ALL):
-        /* Baldwinian evolution for entire population. */
-        /* I don't recommend this, but it is here for completeness. */
-        for (i=0; i<new_pop_size; i++)
-          {
-          adult = pop->adapt(pop, pop->entity_iarray[i]);
-          pop->entity_iarray[i]->fitness=adult->fitness;
-/* check. */ s_assert(ga_get_entity_rank(pop, adult) == new_pop_size);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      case (GA_SCHEME_LAMARCK_CHILDREN):
-        /* Lamarckian evolution for children only. */
-        while (new_pop_size>pop->orig_size)
-          {
-          new_pop_size--;
-          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      case (GA_SCHEME_LAMARCK_ALL):
-        /* Lamarckian evolution for entire population. */
-        while (new_pop_size>0)
-          {
-          new_pop_size--;
-          adult = pop->adapt(pop, pop->entity_iarray[new_pop_size]);
-          ga_entity_dereference_by_rank(pop, new_pop_size);
-          }
-        break;
-      default:
-        dief("Unknown evolutionary scheme %d.\n", pop->scheme);
-      }
-    }
+/*
+ * Mutation step.
+ */
+        gaul_mutation(pop);	/* FIXME: Need to pass current_island for messages. */
 
 /*
- * Insert new entities into population.
+ * Apply environmental adaptations, score entities, sort entities, etc.
  */
-    if (son) pop->replace(pop, son);
-    if (daughter) pop->replace(pop, daughter);
-    if (child) pop->replace(pop, child);
+        gaul_adapt_and_evaluate(pop);
 
 /*
- * End of generation.
+ * Survival of the fittest.
  */
-    plog(LOG_VERBOSE, "*** Analysis ***");
+        gaul_niche_adjust(pop);
+        gaul_survival(pop);
+        gaul_niche_restore(pop);
+
+        }
+      else
+        {
+        complete = TRUE;
+        }
+      }
 
     plog(LOG_VERBOSE,
-          "After iteration %d, population has fitness scores between %f and %f",
-          iteration,
+          "After generation %d, population %d has fitness scores between %f and %f",
+          generation,
+          current_island,
           pop->entity_iarray[0]->fitness,
           pop->entity_iarray[pop->size-1]->fitness );
 
-/*
- * Write statistics.
- */
-    STATS_OUT = fopen(stats_fname, "a");
-    fprintf(STATS_OUT, "%d: %d-%d %f %d-%d %f\n", iteration,
-            crossover_good, crossover_poor, crossover_gain,
-            mutation_good, mutation_poor, mutation_gain);
-    fclose(STATS_OUT);
+    }	/* Generation loop. */
 
-    }	/* Iteration loop. */
+  s_free(offsets);
+  s_free(targets);
 
-  return (iteration<max_iterations);
+  return generation;
   }
-#endif
 
 
 /**********************************************************************
-  ga_random_mutation_hill_climbing()
-  synopsis:	Perform equivalent to zero temperature metropolis
-		optimisation.  If initial solution is NULL, then a
-		random initial solution is generated.
-		The original entity will not be munged.
-
-		-- This function is deprecated! --
-  parameters:
-  return:	Best solution found.
-  last updated:	18/12/00
+  ga_evolution_archipelago_mpi()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given populations using an
+		island model.  Migration follows each population's
+		migration parameters and destinations (cyclic by
+		default).  Migration causes a duplication of the
+		respective entities.  This is a generation-based GA.
+		ga_genesis(), or equivalent, must be called prior to
+		this function.
+		All islands are held by the rank 0 process, and
+		evaluations are farmed out to the slave processes as
+		for ga_evolution_mpi().  Each island's offspring are
+		submitted as soon as they have been bred, so that
+		their evaluation overlaps breeding on the remaining
+		islands.
+  parameters:	const int	num_pops
+		population	**pops
+		const int	max_generations
+  return:	number of generation performed
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef COMPILE_DEPRECATED_FUNCTIONS
-
-GAULFUNC entity *ga_random_mutation_hill_climbing(	population	*pop,
-						entity		*initial,
-						const int	max_iterations)
+GAULFUNC int ga_evolution_archipelago_mpi( const int num_pops,
+			population		**pops,
+			const int		max_generations )
   {
-  int		iteration=0;			/* Current iteration number. */
-  entity	*current, *best, *new, *temp;	/* The solutions. */
-#if GA_WRITE_STATS==TRUE
-  FILE		*STATS_OUT;			/* Filehandle for stats log. */
-  char		stats_fname[80];		/* Filename for stats log. */
-#endif
+#ifdef HAVE_MPI
+  int		current_island;		/* Current current_island number. */
+  population	*pop=NULL;		/* Current population. */
+  boolean	complete=FALSE;		/* Whether evolution is terminated. */
+  int		generation=0;		/* Current generation number. */
+  int		mpi_rank;		/* Rank of MPI process; should always by 0 here. */
+  int		mpi_size;		/* Number of MPI processes. */
+  mpi_farm_t	*farm;			/* Slave processes. */
+  boolean	*evolved;		/* Whether each island is awaiting survival. */
+  int		*offsets, *targets;	/* Migration graph. */
 
 /* Checks. */
-  if ( !pop ) die("NULL pointer to population structure passed.");
-  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-  if (!pop->mutate) die("Population's mutation callback is undefined.");
+  if (!pops)
+    die("NULL pointer to array of population structures passed.");
+  if (num_pops<2)
+    die("Need at least two populations for the island model.");
 
-  plog(LOG_WARNING, "This is a deprecated function!");
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    pop = pops[current_island];
 
-  current = ga_get_free_entity(pop);	/* The 'working' solution. */
-  best = ga_get_free_entity(pop);	/* The best solution so far. */
+    if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+    if (!pop->select_one) die("Population's asexual selection callback is undefined.");
+    if (!pop->select_two) die("Population's sexual selection callback is undefined.");
+    if (!pop->mutate) die("Population's mutation callback is undefined.");
+    if (!pop->crossover) die("Population's crossover callback is undefined.");
+    if (!pop->rank) die("Population's ranking callback is undefined.");
+    if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
 
-/* Do we need to generate a random starting solution? */
-  if (!initial)
+/* Set current_island property. */
+    pop->island = current_island;
+    }
+
+  for (current_island=0; current_island<num_pops; current_island++)
     {
-    plog(LOG_VERBOSE, "Will perform RMHC optimisation with random starting solution.");
+    pop = pops[current_island];
 
-    ga_entity_seed(pop, best);
+/*
+ * Seed initial entities.
+ * This is required prior to determining the size of the send buffer.
+ */
+    if (pop->size < pop->stable_size)
+      gaul_population_fill(pop, pop->stable_size - pop->size);
     }
-  else
+
+/*
+ * Rank zero process is master.  This handles evolution.  Other processes are slaves
+ * which simply evaluate entities, and should be attached using ga_attach_slave().
+ */
+  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
+  if (mpi_rank != 0)
+    die("ga_evolution_archipelago_mpi() called by process other than rank=0.");
+
+  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
+  if ( !(evolved = s_malloc(num_pops*sizeof(boolean))) )
+    die("Unable to allocate memory");
+
+/*
+ * Register, set up and synchronise slave processes.
+ */
+  gaul_bond_slaves_mpi(pop);
+  farm = gaul_farm_new_mpi();
+
+  gaul_migration_graph(num_pops, pops, 0, num_pops, &offsets, &targets);
+
+  plog(LOG_VERBOSE, "The evolution has begun on %d islands (on %d processors)!", num_pops, mpi_size);
+
+  pop->generation = 0;
+
+/*
+ * Score and sort the initial population members.  All islands are
+ * submitted together, so that the slaves are kept busy.
+ */
+  for (current_island=0; current_island<num_pops; current_island++)
+    gaul_farm_submit_mpi(farm, pops[current_island], GA_TAG_EVALUATE,
+                         0, pops[current_island]->size, TRUE);
+  gaul_farm_wait_mpi(farm);
+
+  for (current_island=0; current_island<num_pops; current_island++)
     {
-    plog(LOG_VERBOSE, "Will perform RMHC optimisation with specified starting solution.");
-    ga_entity_copy(pop, best, initial);
+    pop = pops[current_island];
+
+    sort_population(pop);
+    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
+  
+    plog( LOG_VERBOSE,
+          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
+          current_island,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
     }
 
+/* Do all the generations: */
+  while ( generation<max_generations && complete==FALSE)
+    {
+    generation++;
+    pop->generation = generation;
+
+/*
+ * Migration step.
+ */
+    gaul_migration(num_pops, pops, generation, offsets, targets);
+
+/*
+ * Each island's evaluations are submitted as soon as its offspring
+ * have been bred, so the slaves evaluate one island while the
+ * master breeds the next.
+ */
+    for(current_island=0; current_island<num_pops; current_island++)
+      {
+      pop = pops[current_island];
+
+      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+
+      evolved[current_island] = gaul_generation_hook(pop, generation);
+
+      if (evolved[current_island])
+        {
+        pop->orig_size = pop->size;
+
+        plog( LOG_DEBUG,
+              "Population %d size is %d at start of generation %d",
+              current_island, pop->orig_size, generation );
+
 /*
- * Create name for statistics log file.
- * Write a simple header to that file.
+ * Crossover step.
  */
-#if GA_WRITE_STATS==TRUE
-  sprintf(stats_fname, "rmhc_stats_%d.dat", (int) getpid());
-  STATS_OUT = fopen(stats_fname, "a");
-  fprintf(STATS_OUT, "Random Mutation Hill Climbing\n");
-  fclose(STATS_OUT);
-#endif
+        gaul_crossover(pop);	/* FIXME: Need to pass current_island for messages. */
 
 /*
- * Score the initial solution.
+ * Mutation step.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
-  plog(LOG_DEBUG,
-       "Prior to the scoring, the solution has fitness score of %f",
-       best->fitness );
+        gaul_mutation(pop);	/* FIXME: Need to pass current_island for messages. */
 
 /*
- * Copy best solution found over current solution.
+ * Apply environmental adaptations, score entities, sort entities, etc.
  */
-  ga_entity_copy(pop, current, best);
-  new = ga_get_free_entity(pop);
-
-/* Do all the iterations: */
-  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
-           iteration<max_iterations )
-    {
-    iteration++;
+        gaul_adapt_and_evaluate_mpi(pop, farm);
+        }
+      else
+        {
+        complete = TRUE;
+        }
+      }
 
-    plog( LOG_VERBOSE,
-          "Prior to the iteration %d, the solution has fitness score of %f",
-          iteration, current->fitness );
+    gaul_farm_wait_mpi(farm);
 
 /*
- * Perform random mutation.
+ * Survival of the fittest.
  */
-    plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
-         ga_get_entity_id(pop, current),
-         ga_get_entity_rank(pop, current), current->fitness );
-
-    pop->mutate(pop, current, new);
-
-    temp = current;
-    current = new;
-    new = temp;
-
-    pop->evaluate(pop, current);
-
-    if (best->fitness < current->fitness)
-      {
-/*        plog(LOG_DEBUG, "Selecting new solution.");*/
-      ga_entity_blank(pop, best);
-      ga_entity_copy(pop, best, current);
-      }
-    else
+    for(current_island=0; current_island<num_pops; current_island++)
       {
-      ga_entity_blank(pop, current);
-      ga_entity_copy(pop, current, best);
+      if (evolved[current_island])
+        {
+        gaul_niche_adjust(pops[current_island]);
+        gaul_survival_mpi(pops[current_island]);
+        gaul_niche_restore(pops[current_island]);
+        }
       }
 
-    ga_entity_blank(pop, new);
+    plog(LOG_VERBOSE,
+          "After generation %d, population %d has fitness scores between %f and %f",
+          generation,
+          current_island,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
 
 /*
- * Write statistics.
+ * End of generation.
  */
-#if GA_WRITE_STATS==TRUE
-    STATS_OUT = fopen(stats_fname, "a");
-    fprintf(STATS_OUT, "%d: %f\n", iteration, best->fitness);
-    fclose(STATS_OUT);
-#endif
-    }
+    plog( LOG_VERBOSE,
+          "After generation %d, population has fitness scores between %f and %f",
+          generation,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
 
-  plog( LOG_VERBOSE,
-        "After final iteration, the solution has fitness score of %f",
-        current->fitness );
+    }	/* Generation loop. */
 
 /*
- * Current no longer needed.  It is upto the caller to dereference the
- * optimum solution found.
+ * Register, set up and synchronise slave processes.
  */
-  ga_entity_dereference(pop, current);
+  gaul_farm_free_mpi(farm);
+  gaul_debond_slaves_mpi(pop);
 
-  return best;
-  }
-#endif
+  s_free(evolved);
+  s_free(offsets);
+  s_free(targets);
 
+  return generation;
+#else
+  plog(LOG_WARNING, "Attempt to use parallel function without compiled support.");
 
-/**********************************************************************
-  ga_next_ascent_hill_climbing()
-  synopsis:	Perform systematic ascent hill climbing optimisation.
-		(Needn't nessecarily use next allele each time, but
-	       	this was the simplist to implement.)
-		If initial solution is NULL, then a randomly generated
-		initial solution is generated.
-		The original entity will not be munged.
-		NOTE: Needs to be passed an 'extended' mutation
-		function.
-		max_iterations refers to the number of _complete_
-		cycles.
-  parameters:
-  return:	Best solution found.
-  last updated:	21/12/00
- **********************************************************************/
+  return 0;
+#endif
+  }
 
-#ifdef COMPILE_DEPRECATED_FUNCTIONS
 
-entity *old_ga_next_ascent_hill_climbing(	population		*pop,
-					entity			*initial,
-					const int		max_iterations,
-					GAspecificmutate	mutationfunc)
+#if defined(HAVE_PTHREADS) || !defined(W32_CRIPPLED)
+/*
+ * Bounded, lock-free, single-producer single-consumer queue of
+ * migrant batches along one edge of the migration graph.  Migrants
+ * are packed with ga_entities_pack(), so neither island touches the
+ * other's population.  Each counter is written by one side only.
+ */
+#define MIGRATION_QUEUE_BATCHES	4
+
+typedef struct
   {
-  int		iteration=0;		/* Current iteration number. */
-  entity	*current, *best;	/* The solutions. */
-  int		chromo=0, point=0;	/* Mutation locus. */
-#if GA_WRITE_STATS==TRUE
-  FILE		*STATS_OUT;		/* Filehandle for stats log. */
-  char		stats_fname[80];	/* Filename for stats log. */
-#endif
+  int		max_migrants;	/* Migrants per batch. */
+  int		interval;	/* Sender's migration interval. */
+  unsigned int	batch_len;	/* Bytes per packed batch. */
+  gaulbyte	*batches;	/* Packed batches of migrants. */
+  int		head;		/* Batches published, by the sender. */
+  int		tail;		/* Batches consumed, by the receiver. */
+  int		sender_done;	/* Sender will publish no more. */
+  int		receiver_done;	/* Receiver will consume no more. */
+  } migration_queue_t;
 
-  plog(LOG_WARNING, "This is a deprecated function!");
+/**********************************************************************
+  gaul_migration_wait()
+  synopsis:	Yield the processor while waiting on a neighbouring
+		island.
+  parameters:	none
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/* Checks. */
-  if ( !pop ) die("NULL pointer to population structure passed.");
-  if ( !pop->evaluate ) die("Population's evaluation callback is undefined.");
-  if ( !mutationfunc ) die("Mutation callback is undefined.");
+static void gaul_migration_wait(void)
+  {
+  sched_yield();
+  return;
+  }
 
-  current = ga_get_free_entity(pop);	/* The 'working' solution. */
-  best = ga_get_free_entity(pop);	/* The best solution so far. */
 
-  plog(LOG_FIXME, "NAHC algorithm is not parallelised.");
+/**********************************************************************
+  gaul_migration_send()
+  synopsis:	Publish a batch of emigrants, previously chosen with
+		gaul_migration_select(), on a queue.  If the queue is
+		full, either waits for the receiver, unless it has
+		finished, or drops the batch.
+  parameters:	population *pop
+		migration_queue_t *queue
+		const int num		Number of emigrants.
+		const int *ranks	Ranks of emigrants.
+		const boolean wait	Whether to wait for space.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/* Do we need to generate a random starting solution? */
-  if (!initial)
-    {
-    plog(LOG_VERBOSE, "Will perform NAHC optimisation with random starting solution.");
+static void gaul_migration_send( population *pop, migration_queue_t *queue,
+                                 const int num, const int *ranks,
+                                 const boolean wait )
+  {
+  int		slot;			/* Queue slot to fill. */
 
-    ga_entity_seed(pop, best);
-    }
-  else
+  while (queue->head - ATOMIC_LOAD_ACQUIRE(queue->tail) >= MIGRATION_QUEUE_BATCHES)
     {
-    plog(LOG_VERBOSE, "Will perform NAHC optimisation with specified starting solution.");
-    ga_entity_copy(pop, best, initial);
+    if (!wait || ATOMIC_LOAD_ACQUIRE(queue->receiver_done)) return;
+    gaul_migration_wait();
     }
 
-/*
- * Create name for statistics log file.
- * Write a simple header to that file.
- */
-#if GA_WRITE_STATS==TRUE
-  sprintf(stats_fname, "nahc_stats_%d.dat", (int) getpid());
-  STATS_OUT = fopen(stats_fname, "a");
-  fprintf(STATS_OUT, "Next Ascent Hill Climbing\n");
-  fclose(STATS_OUT);
-#endif
-
-/*
- * Score the initial solution.
- */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
-  plog(LOG_DEBUG, "Prior to the scoring, the solution has fitness score of %f", best->fitness );
-
-/*
- * Copy best solution found over current solution.
- */
-  ga_entity_copy(pop, current, best);
+  slot = queue->head % MIGRATION_QUEUE_BATCHES;
 
-/* Do all the iterations: */
-  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
-           iteration<max_iterations )
-    {
+  ga_entities_pack( pop, num, ranks,
+                    &(queue->batches[slot*queue->batch_len]), queue->batch_len );
 
-    plog( LOG_VERBOSE,
-          "Iteration %d chromosome %d, point %d, solution has fitness score of %f",
-          iteration, chromo, point,
-          current->fitness );
+  ATOMIC_STORE_RELEASE(queue->head, queue->head+1);
 
-    mutationfunc(chromo, point, current->chromosome[chromo]);
+  return;
+  }
 
-    ga_entity_clear_data(pop, current, chromo);	/* Required to force regeneration of structural data. */
-    pop->evaluate(pop, current);
 
-/*
- * Is current better than best?
- */
-    if (best->fitness < current->fitness)
-      {
-/*        plog(LOG_DEBUG, "Selecting new solution.");*/
-      ga_entity_blank(pop, best);
-      ga_entity_copy(pop, best, current);
-      }
-    else
-      {
-      ga_entity_blank(pop, current);
-      ga_entity_copy(pop, current, best);
-      }
+/**********************************************************************
+  gaul_migration_consume()
+  synopsis:	Append the oldest published batch of immigrants to
+		the population.  The caller must have checked that a
+		batch is available.
+  parameters:	population *pop
+		migration_queue_t *queue
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/*
- * Write statistics.
- */
-#if GA_WRITE_STATS==TRUE
-    STATS_OUT = fopen(stats_fname, "a");
-    fprintf(STATS_OUT, "%d: %f (%d %d)\n", iteration, best->fitness, chromo, point);
-    fclose(STATS_OUT);
-#endif
+static void gaul_migration_consume(population *pop, migration_queue_t *queue)
+  {
+  int		slot;			/* Queue slot to consume. */
 
-/*
- * Choose next nucleotide to mutate/optimise.
- */
-    point++;
-    if (point == pop->len_chromosomes)
-      {
-      point = 0;
-      chromo++;
-      if (chromo == pop->num_chromosomes)
-        {
-        chromo=0;
-        iteration++;
-        }
-      }
-    }
+  slot = queue->tail % MIGRATION_QUEUE_BATCHES;
 
-  plog( LOG_VERBOSE,
-        "After final iteration, the solution has fitness score of %f",
-        current->fitness );
+  ga_entities_unpack( pop, &(queue->batches[slot*queue->batch_len]),
+                      queue->batch_len );
 
-/*
- * Current no longer needed.  It is upto the caller to dereference the
- * optimum solution found.
- */
-  ga_entity_dereference(pop, current);
+  ATOMIC_STORE_RELEASE(queue->tail, queue->tail+1);
 
-  return best;
+  return;
   }
-#endif
 
 
 /**********************************************************************
-  ga_metropolis_mutation()
-  synopsis:	Perform arbitrary temperature metropolis optimisation.
-		If initial solution is NULL, then random solution is
-		generated.  Syncs with other processors every iteration
-		and grabs the overall best solution if better than
-		this processors current solution is worse than the best
-		plus the temperature. 
-		The original entity will not be munged.
-  parameters:
-  return:	Best solution found.
-  last updated:	19/01/01
+  gaul_migration_poll()
+  synopsis:	Append every batch of immigrants that is already
+		waiting, without blocking.
+  parameters:	population *pop
+		migration_queue_t *queue
+  return:	none
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef COMPILE_DEPRECATED_FUNCTIONS
-
-GAULFUNC entity *ga_metropolis_mutation(	population		*pop,
-				entity			*initial,
-				const int		max_iterations,
-				const int 		temperature)
+static void gaul_migration_poll(population *pop, migration_queue_t *queue)
   {
-  int		iteration=0;			/* Current iteration number. */
-  entity	*current, *best, *fresh;	/* The solutions. */
-  entity	*temp=NULL;			/* Used for swapping current and new. */
-#if GA_WRITE_STATS==TRUE
-  FILE		*STATS_OUT;			/* Filehandle for stats log. */
-  char		stats_fname[80];		/* Filename for stats log. */
-#endif
 
-  plog(LOG_NORMAL, "This function is deprecated!");
+  while (ATOMIC_LOAD_ACQUIRE(queue->head) != queue->tail)
+    gaul_migration_consume(pop, queue);
 
-/* Checks. */
-  if ( !pop ) die("NULL pointer to population structure passed.");
-  if ( !pop->evaluate ) die("Population's evaluation callback is undefined.");
-  if ( !pop->mutate ) die("Population's mutation callback is undefined.");
+  return;
+  }
 
-  current = ga_get_free_entity(pop);	/* The 'working' solution. */
-  best = ga_get_free_entity(pop);	/* The best solution so far. */
 
-  plog(LOG_FIXME, "Metropolis algorithm is not parallelised.");
+/**********************************************************************
+  gaul_migration_insert()
+  synopsis:	Move the immigrants, which follow the residents in
+		entity_iarray[], into rank order, so no re-sort is
+		needed.
+  parameters:	population *pop
+		const int first		Rank of first immigrant.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/* Do we need to generate a random starting solution? */
-  if (!initial)
-    {
-    plog(LOG_VERBOSE, "Will perform metropolis optimisation at %d degrees with random starting solution.", temperature);
+static void gaul_migration_insert(population *pop, const int first)
+  {
+  int		i, j;			/* Loop over immigrants, ranks. */
+  entity	*immigrant;		/* Entity being inserted. */
 
-    ga_entity_seed(pop, best);
-    }
-  else
+  for (i=first; i<pop->size; i++)
     {
-    plog(LOG_VERBOSE, "Will perform metropolis optimisation at %d degrees.");
-    ga_entity_copy(pop, best, initial);
+    immigrant = pop->entity_iarray[i];
+
+    j = i;
+    while (j>0 && pop->rank(pop, immigrant, pop, pop->entity_iarray[j-1]) > 0)
+      {
+      pop->entity_iarray[j] = pop->entity_iarray[j-1];
+      j--;
+      }
+    pop->entity_iarray[j] = immigrant;
     }
 
-/*
- * Create name for statistics log file.
- * Write a simple header to that file.
- */
-#if GA_WRITE_STATS==TRUE
-  sprintf(stats_fname, "mstats_%d.dat", (int) getpid());
-  STATS_OUT = fopen(stats_fname, "a");
-  fprintf(STATS_OUT, "Metropolis optimisation at %d degrees.\n", temperature);
-  fclose(STATS_OUT);
+  gaul_stats_invalidate(pop);
+
+  return;
+  }
+
+
 #endif
 
+
+#ifdef HAVE_PTHREADS
 /*
- * Score the initial solution.
+ * Global termination state for the asynchronous island model.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
-  plog(LOG_DEBUG, "Prior to the scoring, the solution has fitness score of %f", best->fitness );
+typedef struct
+  {
+  int			max_generations;	/* Total island generations, or 0. */
+  int			max_evaluations;	/* Total offspring evaluations, or 0. */
+  double		target_fitness;		/* Stop once reached by any island. */
+  int			num_generations;	/* Island generations claimed. */
+  int			num_evaluations;	/* Offspring evaluated. */
+  THREAD_LOCK_DECLARE(lock);			/* Guards the counters. */
+  } archipelago_budget_t;
 
 /*
- * Copy best solution found over current solution.
+ * Per-island thread state.
  */
-  ga_entity_copy(pop, current, best);
-  fresh = ga_get_free_entity(pop);
+typedef struct
+  {
+  population		*pop;
+  archipelago_budget_t	*budget;	/* Global budget, or NULL if synchronous. */
+  int			num_inbound;	/* Number of inbound edges. */
+  migration_queue_t	**inbound;	/* Immigrants from neighbours. */
+  int			num_outbound;	/* Number of outbound edges. */
+  migration_queue_t	*outbound;	/* Emigrants to neighbours. */
+  int			*ranks;		/* Ranks of emigrants. */
+  int			max_ranks;	/* Length of ranks array. */
+  int			max_generations;
+  int			generation;	/* Generations completed. */
+  int			*stop;		/* Shared termination flag. */
+  random_state		rstate;		/* Island's PRNG stream. */
+  } island_thread_t;
 
-/* Do all the iterations: */
-  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
-           iteration<max_iterations )
-    {
-    iteration++;
 
-    plog(LOG_VERBOSE,
-              "Prior to iteration %d, solution has fitness score of %f",
-              iteration, current->fitness );
+/**********************************************************************
+  gaul_migration_receive()
+  synopsis:	Wait for the next batch of immigrants and append
+		them to the population.
+  parameters:	population *pop
+		migration_queue_t *queue
+  return:	FALSE if the sender finished without a further batch.
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/*
- * Perform random mutation.
- */
-    plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
-         ga_get_entity_id(pop, current),
-         ga_get_entity_rank(pop, current), current->fitness );
+static boolean gaul_migration_receive(population *pop, migration_queue_t *queue)
+  {
 
-    pop->mutate(pop, current, fresh);
+  while (ATOMIC_LOAD_ACQUIRE(queue->head) == queue->tail)
+    {
+    if ( ATOMIC_LOAD_ACQUIRE(queue->sender_done) &&
+         ATOMIC_LOAD_ACQUIRE(queue->head) == queue->tail )
+      return FALSE;
+    gaul_migration_wait();
+    }
 
-    temp = current;
-    current = fresh;
-    fresh = temp;
+  gaul_migration_consume(pop, queue);
 
-    pop->evaluate(pop, current);
+  return TRUE;
+  }
 
-/*
- * Should we keep this solution?
- */
-    if ( best->fitness < current->fitness ||
-         random_boolean_prob(exp((current->fitness-best->fitness)
-                                   /(GA_BOLTZMANN_FACTOR*temperature))) )
-      {
-/*        plog(LOG_DEBUG, "Selecting fresh solution."); */
-      ga_entity_blank(pop, best);
-      ga_entity_copy(pop, best, current);
-      }
-    else
-      {
-/*        plog(LOG_DEBUG, "Rejecting fresh solution."); */
-      ga_entity_blank(pop, current);
-      ga_entity_copy(pop, current, best);
-      }  
 
-    ga_entity_blank(pop, fresh);
+/**********************************************************************
+  gaul_budget_claim()
+  synopsis:	Claim one island generation from the global budget of
+		the asynchronous island model.
+  parameters:	archipelago_budget_t *budget
+		int *stop	Shared termination flag.
+  return:	FALSE if the budget is exhausted.
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/*
- * Write statistics.
- */
-#if GA_WRITE_STATS==TRUE
-    STATS_OUT = fopen(stats_fname, "a");
-    fprintf(STATS_OUT, "%d: %f\n", iteration, best->fitness);
-    fclose(STATS_OUT);
-#endif
-    }
+static boolean gaul_budget_claim(archipelago_budget_t *budget, int *stop)
+  {
+  boolean	claimed;		/* Whether a generation remains. */
 
-  plog( LOG_VERBOSE,
-        "After final iteration, solution has fitness score of %f",
-        best->fitness );
+  THREAD_LOCK(budget->lock);
+  claimed = budget->max_generations==0 || budget->num_generations < budget->max_generations;
+  if (claimed) budget->num_generations++;
+  THREAD_UNLOCK(budget->lock);
 
-/*
- * Current no longer needed.  It is upto the caller to dereference the
- * optimum solution found.
- */
-  ga_entity_dereference(pop, current);
-  ga_entity_dereference(pop, temp);
+  if (!claimed) ATOMIC_STORE_RELEASE(*stop, TRUE);
 
-  return best;
+  return claimed;
   }
-#endif
 
 
 /**********************************************************************
-  ga_simulated_annealling_mutation()
-  synopsis:	Perform mutation/SA (GA mutation/Simulated Annealling).
-		If initial solution is NULL, then random solution is
-		generated.  Syncs with other processors every iteration
-		and grabs the overall best solution if better than
-		this processors current solution is worse than the best
-		plus the temperature. 
-		The original entity will not be munged.
-  parameters:
-  return:	Best solution found.
-  last updated:	21/02/01
+  gaul_budget_account()
+  synopsis:	Record an island generation's offspring evaluations,
+		and stop all islands once the evaluation budget is
+		spent or the target fitness has been reached.
+  parameters:	archipelago_budget_t *budget
+		int *stop	Shared termination flag.
+		const int num_evaluations
+		const double best_fitness
+  return:	none
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef COMPILE_DEPRECATED_FUNCTIONS
-
-GAULFUNC entity *ga_simulated_annealling_mutation(population	*pop,
-					entity		*initial,
-					const int	max_iterations,
-					const int 	initial_temperature,
-					const int 	final_temperature)
+static void gaul_budget_account( archipelago_budget_t *budget, int *stop,
+                                 const int num_evaluations,
+                                 const double best_fitness )
   {
-  int		iteration=0;			/* Current iteration number. */
-  entity	*current, *best, *fresh;	/* The solutions. */
-  entity	*temp=NULL;			/* Used for swapping current and new solutions. */
-  int		temperature;			/* Current temperature. */
-#if GA_WRITE_STATS==TRUE
-  FILE		*STATS_OUT;			/* Filehandle for stats log. */
-  char		stats_fname[80];		/* Filename for stats log. */
-#endif
+  boolean	exhausted;		/* Whether to stop. */
 
-  plog(LOG_NORMAL, "This function is deprecated!");
-
-/* Checks. */
-  if ( !pop ) die("NULL pointer to population structure passed.");
-  if ( !pop->evaluate ) die("Population's evaluation callback is undefined.");
-  if ( !pop->mutate ) die("Population's mutation callback is undefined.");
+  THREAD_LOCK(budget->lock);
+  budget->num_evaluations += num_evaluations;
+  exhausted = budget->max_evaluations>0 && budget->num_evaluations >= budget->max_evaluations;
+  THREAD_UNLOCK(budget->lock);
 
-  current = ga_get_free_entity(pop);	/* The 'working' solution. */
-  best = ga_get_free_entity(pop);	/* The best solution so far. */
+  if (exhausted || best_fitness >= budget->target_fitness)
+    ATOMIC_STORE_RELEASE(*stop, TRUE);
 
-  plog(LOG_FIXME, "Simulated annealling algorithm is not parallelised.");
+  return;
+  }
 
-/* Do we need to generate a random starting solution? */
-  if (!initial)
-    {
-    plog(LOG_VERBOSE, "Will perform %d steps of MC/SA optimisation between %d and %d degrees with random starting solution.", max_iterations, initial_temperature, final_temperature);
 
-    ga_entity_seed(pop, best);
-    }
-  else
-    {
-    plog(LOG_VERBOSE, "Will perform %d steps of MC/SA optimisation between %d and %d degrees.", max_iterations, initial_temperature, final_temperature);
+/**********************************************************************
+  _island_thread()
+  synopsis:	Complete generation loop for one island.  In
+		asynchronous mode, emigrants are published without
+		waiting and immigrants are taken only if already
+		waiting, and the island stops once the global budget
+		is exhausted.
+  parameters:	void *data	island_thread_t for this island.
+  return:	NULL
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-    ga_entity_copy(pop, best, initial);
-    }
+static void *_island_thread(void *data)
+  {
+  island_thread_t	*self = (island_thread_t *) data;
+  population		*pop = self->pop;
+  int			generation=0;	/* Current generation number. */
+  int			num_residents;	/* Population size prior to migration. */
+  int			num;		/* Number of emigrants. */
+  int			e;		/* Loop over edges. */
+  int			num_offspring;	/* Entities to be evaluated. */
+  boolean		orphaned=FALSE;	/* Whether a neighbour has finished. */
 
-/*
- * Create name for statistics log file.
- * Write a simple header to that file.
- */
-#if GA_WRITE_STATS==TRUE
-  sprintf(stats_fname, "sastats_%d.dat", (int) getpid());
-  STATS_OUT = fopen(stats_fname, "a");
-  fprintf(STATS_OUT, "MC/SA optimisation at %d to %d degrees.\n",
-                     initial_temperature, final_temperature);
-  fclose(STATS_OUT);
-#endif
+  random_set_thread_state(&(self->rstate));
 
 /*
- * Score the initial solution.
+ * Score and sort the initial population members.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
-  plog(LOG_DEBUG, "Prior to the scoring, the solution has fitness score of %f", best->fitness );
+  gaul_ensure_evaluations(pop);
+  sort_population(pop);
+  ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-/*
- * Copy best solution over current solution.
- */
-  ga_entity_copy(pop, current, best);
-  fresh = ga_get_free_entity(pop);
+  plog( LOG_VERBOSE,
+        "Prior to the first generation, population on island %d has fitness scores between %f and %f",
+        pop->island,
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
 
-/* Do all the iterations: */
-  while ( (pop->iteration_hook?pop->iteration_hook(iteration, current):TRUE) &&
-           iteration<max_iterations )
+  while ( generation<self->max_generations && !ATOMIC_LOAD_ACQUIRE(*(self->stop)) )
     {
-    temperature = initial_temperature + ((double)iteration/max_iterations)*(final_temperature-initial_temperature);
-    iteration++;
+    if (self->budget && !gaul_budget_claim(self->budget, self->stop)) break;
 
-    plog( LOG_VERBOSE,
-          "Prior to iteration %d temperature %d, solution has fitness score of %f",
-          iteration, temperature, current->fitness );
+    generation++;
+    pop->generation = generation;
 
 /*
- * Perform random mutation.
+ * Migration step.  Emigrants are sent before immigrants are
+ * received, so they are always drawn from the previous generation.
+ * Each neighbour is only waited on in generations in which it emigrates.
  */
-    plog(LOG_VERBOSE, "Mutation of %d (%d = %f)",
-       ga_get_entity_id(pop, current),
-       ga_get_entity_rank(pop, current), current->fitness );
+    num_residents = pop->size;
 
-    pop->mutate(pop, current, fresh);
-
-    temp = current;
-    current = fresh;
-    fresh = temp;
+    gaul_profile_start(pop, GA_PHASE_MIGRATION);
 
-    pop->evaluate(pop, current);
+    if (self->num_outbound > 0 && generation%gaul_migration_interval(pop) == 0)
+      {
+      if (num_residents > self->max_ranks)
+        {
+        self->max_ranks = num_residents;
+        if ( !(self->ranks = s_realloc(self->ranks, sizeof(int)*self->max_ranks)) )
+          die("Unable to allocate memory");
+        }
+      num = gaul_migration_select(pop, num_residents, self->outbound[0].max_migrants, self->ranks);
+      for (e=0; e<self->num_outbound; e++)
+        gaul_migration_send(pop, &(self->outbound[e]), num, self->ranks, !self->budget);
+      }
 
-/*
- * Should we keep this solution?
-      if ( best->fitness < current->fitness ||
-           random_boolean_prob(exp((current->fitness-best->fitness)
-                                   /(GA_BOLTZMANN_FACTOR*temperature))) )
- */
-    if ( best->fitness < current->fitness+temperature )
-      { /* Copy this solution best solution. */
-/*        plog(LOG_DEBUG, "Selecting fresh solution.");*/
-      ga_entity_blank(pop, best);
-      ga_entity_copy(pop, best, current);
+    for (e=0; e<self->num_inbound && !orphaned; e++)
+      {
+      if (self->budget)
+        gaul_migration_poll(pop, self->inbound[e]);
+      else if (generation%self->inbound[e]->interval == 0)
+        orphaned = !gaul_migration_receive(pop, self->inbound[e]);
       }
-    else
-      { /* Copy best solution over current solution. */
-/*        plog(LOG_DEBUG, "Rejecting fresh solution.");*/
-      ga_entity_blank(pop, current);
-      ga_entity_copy(pop, current, best);
+
+    gaul_migration_insert(pop, gaul_migration_replace(pop, num_residents));
+
+    gaul_profile_stop(pop);
+
+    if (orphaned) break;
+
+    if ( !gaul_generation_hook(pop, generation) )
+      {
+      ATOMIC_STORE_RELEASE(*(self->stop), TRUE);
+      break;
       }
 
-    ga_entity_blank(pop, fresh);
+    pop->orig_size = pop->size;
+
+    plog( LOG_DEBUG,
+          "Population %d size is %d at start of generation %d",
+          pop->island, pop->orig_size, generation );
+
+    gaul_crossover(pop);
+    gaul_mutation(pop);
+    num_offspring = pop->size - pop->orig_size;
+    gaul_adapt_and_evaluate(pop);
+    gaul_niche_adjust(pop);
+    gaul_survival(pop);
+    gaul_niche_restore(pop);
+
+    self->generation = generation;
 
-/*
- * Write statistics.
- */
-#if GA_WRITE_STATS==TRUE
-    STATS_OUT = fopen(stats_fname, "a");
-    fprintf(STATS_OUT, "%d: (%d degrees) %f\n",
-            iteration, temperature, best->fitness);
-    fclose(STATS_OUT);
-#endif
+    if (self->budget)
+      gaul_budget_account(self->budget, self->stop, num_offspring,
+                          pop->entity_iarray[0]->fitness);
+
+    plog( LOG_VERBOSE,
+          "After generation %d, population %d has fitness scores between %f and %f",
+          generation,
+          pop->island,
+          pop->entity_iarray[0]->fitness,
+          pop->entity_iarray[pop->size-1]->fitness );
     }
 
-  plog(LOG_VERBOSE,
-            "After final iteration, the solution has fitness score of %f",
-            best->fitness );
+  for (e=0; e<self->num_outbound; e++)
+    ATOMIC_STORE_RELEASE(self->outbound[e].sender_done, TRUE);
+  for (e=0; e<self->num_inbound; e++)
+    ATOMIC_STORE_RELEASE(self->inbound[e]->receiver_done, TRUE);
 
-/*
- * Current no longer needed.  It is upto the caller to dereference the
- * optimum solution found.
- */
-  ga_entity_dereference(pop, current);
-  ga_entity_dereference(pop, temp);
+  random_set_thread_state(NULL);
 
-  return best;
+  return NULL;
   }
-#endif
 
 
 /**********************************************************************
-  ga_evolution_archipelago()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given populations using a simple
-		island model.  Migration occurs around a cyclic
-		topology only.  Migration causes a duplication of the
-		respective entities.  This is a generation-based GA.
-		ga_genesis(), or equivalent, must be called prior to
-		this function.
+  gaul_archipelago_threaded()
+  synopsis:	Run each island's generation loop in its own thread,
+		passing migrants along each edge of the migration
+		graph through a bounded lock-free queue, using the
+		chromosome_to_bytes and chromosome_from_bytes
+		callbacks.  Immigrants are inserted in rank order on
+		arrival.  If any island's generation hook returns
+		FALSE, all islands stop.
   parameters:	const int	num_pops
 		population	**pops
-		const int	max_generations
-  return:	number of generation performed
-  last updated:	17 Feb 2005
+		const int	max_generations	Per island.
+		archipelago_budget_t *budget	Global budget for the
+					asynchronous model, or NULL.
+		int *total_generations	Incremented by the number of
+					island generations performed.
+  return:	Largest number of generations performed by an island.
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-GAULFUNC int ga_evolution_archipelago( const int num_pops,
-			population		**pops,
-			const int		max_generations )
+static int gaul_archipelago_threaded( const int num_pops,
+                                      population **pops,
+                                      const int max_generations,
+                                      archipelago_budget_t *budget,
+                                      int *total_generations )
   {
-  int		generation=0;		/* Current generation number. */
-  int		current_island;		/* Current current_island number. */
-  population	*pop=NULL;		/* Current population. */
-  boolean	complete=FALSE;		/* Whether evolution is terminated. */
+  int			generation=0;	/* Generations performed. */
+  int			current_island;	/* Current island number. */
+  population		*pop=NULL;	/* Current population. */
+  island_thread_t	*islands;	/* Per-island thread data. */
+  migration_queue_t	*queues;	/* Queue for each edge. */
+  migration_queue_t	**inbound;	/* Queues, grouped by destination. */
+  migration_queue_t	*queue;		/* Current queue. */
+  int			*offsets, *targets;	/* Migration graph. */
+  int			num_edges;	/* Number of edges. */
+  int			e;		/* Loop over edges. */
+  int			num_inbound=0;	/* Inbound queues assigned so far. */
+  pthread_t		*tids;		/* Thread ids. */
+  int			stop=FALSE;	/* Shared termination flag. */
+  int			err;		/* Error code from pthreads. */
 
 /* Checks. */
   if (!pops)
@@ -4475,218 +6181,392 @@ GAULFUNC int ga_evolution_archipelago( const int num_pops,
     if (!pop->crossover) die("Population's crossover callback is undefined.");
     if (!pop->rank) die("Population's ranking callback is undefined.");
     if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+    if (!pop->chromosome_to_bytes) die("Population's chromosome to bytes callback is undefined.");
+    if (!pop->chromosome_from_bytes) die("Population's chromosome from bytes callback is undefined.");
 
 /* Set current_island property. */
     pop->island = current_island;
-    }
-
-  plog(LOG_VERBOSE, "The evolution has begun on %d islands!", num_pops);
-
-  pop->generation = 0;
-
-  for (current_island=0; current_island<num_pops; current_island++)
-    {
-    pop = pops[current_island];
 
 /*
- * Score and sort the initial population members.
+ * Seed initial entities.
+ * This is required prior to determining the size of the migration buffers.
  */
     if (pop->size < pop->stable_size)
       gaul_population_fill(pop, pop->stable_size - pop->size);
-    gaul_ensure_evaluations(pop);
-    sort_population(pop);
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-  
-    plog( LOG_VERBOSE,
-          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
     }
 
-/* Do all the generations: */
-  while ( generation<max_generations && complete==FALSE)
-    {
-    generation++;
-    pop->generation = generation;
+  num_edges = gaul_migration_graph(num_pops, pops, 0, num_pops, &offsets, &targets);
+
+  plog( LOG_VERBOSE, "The %s evolution has begun on %d islands, using a thread for each!",
+        budget?"asynchronous":"synchronised", num_pops );
+
+  if ( !(islands = s_malloc(sizeof(island_thread_t)*num_pops)) )
+    die("Unable to allocate memory");
+  if ( !(queues = s_malloc(sizeof(migration_queue_t)*num_edges)) )
+    die("Unable to allocate memory");
+  if ( !(inbound = s_malloc(sizeof(migration_queue_t *)*num_edges)) )
+    die("Unable to allocate memory");
+  if ( !(tids = s_malloc(sizeof(pthread_t)*num_pops)) )
+    die("Unable to allocate memory");
 
 /*
- * Migration step.
+ * One queue for each edge of the migration graph.
+ * Migration buffers are allocated here, so that no island thread
+ * needs to allocate memory on another's behalf.
  */
-    gaul_migration(num_pops, pops);
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    pop = pops[current_island];
 
-    for(current_island=0; current_island<num_pops; current_island++)
+    for (e=offsets[current_island]; e<offsets[current_island+1]; e++)
       {
-      pop = pops[current_island];
-
-      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+      queue = &(queues[e]);
+
+      queue->max_migrants = gaul_migration_max_emigrants(pop);
+      queue->interval = gaul_migration_interval(pop);
+      queue->batch_len = ga_entities_packed_size(pop, queue->max_migrants);
+      queue->head = 0;
+      queue->tail = 0;
+      queue->sender_done = FALSE;
+      queue->receiver_done = FALSE;
+
+      if ( !(queue->batches = s_malloc(sizeof(gaulbyte)*MIGRATION_QUEUE_BATCHES*queue->batch_len)) )
+        die("Unable to allocate memory");
+      }
+    }
 
-      if (pop->generation_hook?pop->generation_hook(generation, pop):TRUE)
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    islands[current_island].pop = pops[current_island];
+    islands[current_island].budget = budget;
+    islands[current_island].num_outbound = offsets[current_island+1]-offsets[current_island];
+    islands[current_island].outbound = &(queues[offsets[current_island]]);
+    islands[current_island].inbound = &(inbound[num_inbound]);
+    islands[current_island].num_inbound = 0;
+    for (e=0; e<num_edges; e++)
+      {
+      if (targets[e] == current_island)
         {
-        pop->orig_size = pop->size;
-
-        plog( LOG_DEBUG,
-              "Population %d size is %d at start of generation %d",
-              current_island, pop->orig_size, generation );
-
-/*
- * Crossover step.
- */
-        gaul_crossover(pop);	/* FIXME: Need to pass current_island for messages. */
+        inbound[num_inbound++] = &(queues[e]);
+        islands[current_island].num_inbound++;
+        }
+      }
+    islands[current_island].max_ranks = MAX(pops[current_island]->size,1);
+    if ( !(islands[current_island].ranks = s_malloc(sizeof(int)*islands[current_island].max_ranks)) )
+      die("Unable to allocate memory");
+    islands[current_island].max_generations = max_generations;
+    islands[current_island].generation = 0;
+    islands[current_island].stop = &stop;
+    random_seed_state(&(islands[current_island].rstate), random_rand());
+    }
 
-/*
- * Mutation step.
- */
-        gaul_mutation(pop);	/* FIXME: Need to pass current_island for messages. */
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    if ( (err = pthread_create(&(tids[current_island]), NULL, _island_thread, (void *)&(islands[current_island]))) != 0 )
+      dief("Error %d in pthread_create. (%s)", err, err==EAGAIN?"EAGAIN":err==ENOMEM?"ENOMEM":"unknown");
+    }
 
-/*
- * Apply environmental adaptations, score entities, sort entities, etc.
- */
-        gaul_adapt_and_evaluate(pop);
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    if ( (err = pthread_join(tids[current_island], NULL)) != 0 )
+      dief("Error %d in pthread_join. (%s)", err, err==ESRCH?"ESRCH":err==EINVAL?"EINVAL":err==EDEADLK?"EDEADLK":"unknown");
 
-/*
- * Survival of the fittest.
- */
-        gaul_survival(pop);
+    if (islands[current_island].generation > generation)
+      generation = islands[current_island].generation;
+    *total_generations += islands[current_island].generation;
 
-        }
-      else
-        {
-        complete = TRUE;
-        }
-      }
+    s_free(islands[current_island].ranks);
+    }
 
-    plog(LOG_VERBOSE,
-          "After generation %d, population %d has fitness scores between %f and %f",
-          generation,
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+  for (e=0; e<num_edges; e++)
+    s_free(queues[e].batches);
 
-    }	/* Generation loop. */
+  s_free(tids);
+  s_free(inbound);
+  s_free(queues);
+  s_free(islands);
+  s_free(offsets);
+  s_free(targets);
 
   return generation;
   }
 
 
 /**********************************************************************
-  ga_evolution_archipelago_mpi()
+  ga_evolution_archipelago_threaded()
   synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given populations using a simple
-		island model.  Migration occurs around a cyclic
-		topology only.  Migration causes a duplication of the
+		optimisation on the given populations using an
+		island model.  Migration follows each population's
+		migration parameters and destinations (cyclic by
+		default).  Migration causes a duplication of the
 		respective entities.  This is a generation-based GA.
 		ga_genesis(), or equivalent, must be called prior to
 		this function.
+		This is a multiprocess version, using a thread
+		for each island.  Each thread runs the whole of its
+		island's generation loop, with its own random number
+		stream, so all of the callbacks must be thread-safe.
+		There is no global barrier; an island only waits for
+		its neighbours' emigrants from the previous generation.
+		If any island's generation hook returns FALSE, all
+		islands stop.
   parameters:	const int	num_pops
 		population	**pops
 		const int	max_generations
   return:	number of generation performed
-  last updated:	21 Feb 2005
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-GAULFUNC int ga_evolution_archipelago_mpi( const int num_pops,
+GAULFUNC int ga_evolution_archipelago_threaded( const int num_pops,
 			population		**pops,
 			const int		max_generations )
   {
-#ifdef HAVE_MPI
-  int		current_island;		/* Current current_island number. */
-  population	*pop=NULL;		/* Current population. */
-  boolean	complete=FALSE;		/* Whether evolution is terminated. */
-  int		generation=0;		/* Current generation number. */
-  int		mpi_rank;		/* Rank of MPI process; should always by 0 here. */
-  int		mpi_size;		/* Number of MPI processes. */
-  gaulbyte		*buffer=NULL;		/* Send buffer. */
-  int		buffer_len=0;		/* Length of send buffer. */
-  int		buffer_max=0;		/* Length of send buffer. */
-  int		*eid;			/* Sorage of entity ids being processed. */
+  int		total_generations=0;	/* Island generations performed. */
 
-/* Checks. */
-  if (!pops)
-    die("NULL pointer to array of population structures passed.");
-  if (num_pops<2)
-    die("Need at least two populations for the island model.");
+  return gaul_archipelago_threaded(num_pops, pops, max_generations, NULL, &total_generations);
+  }
 
-  for (current_island=0; current_island<num_pops; current_island++)
-    {
-    pop = pops[current_island];
 
-    if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-    if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-    if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-    if (!pop->mutate) die("Population's mutation callback is undefined.");
-    if (!pop->crossover) die("Population's crossover callback is undefined.");
-    if (!pop->rank) die("Population's ranking callback is undefined.");
-    if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+/**********************************************************************
+  ga_evolution_archipelago_async()
+  synopsis:	Main genetic algorithm routine.  Performs GA-based
+		optimisation on the given populations using an
+		asynchronous island model.  Each island evolves in
+		its own thread at its own rate, as for
+		ga_evolution_archipelago_threaded(), but islands never
+		wait for each other: emigrants are published whenever
+		the island's own migration interval elapses, and are
+		dropped if the neighbour still has a full queue, and
+		immigrants are taken only if they are already waiting.
+		Islands with expensive fitness evaluations therefore
+		do not hold up the others.
+		Termination is global.  All islands stop once
+		max_generations island generations, in total, have
+		been performed, once max_evaluations offspring have
+		been evaluated, once any island's best fitness reaches
+		target_fitness, or once any island's generation hook
+		returns FALSE.  Results are not reproducible between
+		runs, since migration depends on thread timing.
+		ga_genesis(), or equivalent, must be called prior to
+		this function.
+  parameters:	const int	num_pops
+		population	**pops
+		const int	max_generations	Total over all islands, or 0
+					for no limit.
+		const int	max_evaluations	Total offspring evaluations,
+					or 0 for no limit.
+		const double	target_fitness	Stop once this fitness is
+					reached, or DBL_MAX for no target.
+  return:	Total number of island generations performed.
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/* Set current_island property. */
-    pop->island = current_island;
-    }
+GAULFUNC int ga_evolution_archipelago_async( const int num_pops,
+			population		**pops,
+			const int		max_generations,
+			const int		max_evaluations,
+			const double		target_fitness )
+  {
+  archipelago_budget_t	budget;		/* Global termination state. */
+  int			total_generations=0;	/* Island generations performed. */
 
-  for (current_island=0; current_island<num_pops; current_island++)
-    {
-    pop = pops[current_island];
+  if (max_generations<0) die("Negative generation budget requested.");
+  if (max_evaluations<0) die("Negative evaluation budget requested.");
+
+  budget.max_generations = max_generations;
+  budget.max_evaluations = max_evaluations;
+  budget.target_fitness = target_fitness;
+  budget.num_generations = 0;
+  budget.num_evaluations = 0;
+  THREAD_LOCK_NEW(budget.lock);
+
+  gaul_archipelago_threaded(num_pops, pops, INT_MAX, &budget, &total_generations);
+
+  plog( LOG_VERBOSE, "Asynchronous islands performed %d generations and %d offspring evaluations.",
+        total_generations, budget.num_evaluations );
+
+  THREAD_LOCK_FREE(budget.lock);
+
+  return total_generations;
+  }
+#else
+GAULFUNC int ga_evolution_archipelago_threaded( const int num_pops,
+			population		**pops,
+			const int		max_generations )
+  {
+  die("Support for ga_evolution_archipelago_threaded() not compiled.");
+  return 0;
+  }
 
-/*
- * Seed initial entities.
- * This is required prior to determining the size of the send buffer.
- */
-    if (pop->size < pop->stable_size)
-      gaul_population_fill(pop, pop->stable_size - pop->size);
-    }
 
+GAULFUNC int ga_evolution_archipelago_async( const int num_pops,
+			population		**pops,
+			const int		max_generations,
+			const int		max_evaluations,
+			const double		target_fitness )
+  {
+  die("Support for ga_evolution_archipelago_async() not compiled.");
+  return 0;
+  }
+#endif
+
+
+#ifndef W32_CRIPPLED
 /*
- * Rank zero process is master.  This handles evolution.  Other processes are slaves
- * which simply evaluate entities, and should be attached using ga_attach_slave().
+ * Per-island record in the forked archipelago's shared memory
+ * segment.  Each island process publishes a double-buffered snapshot
+ * of its population, from which a replacement process resumes if it
+ * dies, and from which the parent collects the final population.
  */
-  MPI_Comm_rank(MPI_COMM_WORLD, &mpi_rank);
-  if (mpi_rank != 0)
-    die("ga_evolution_archipelago_mpi() called by process other than rank=0.");
+typedef struct
+  {
+  int		generation;		/* Generations completed. */
+  int		done;			/* Island finished normally. */
+  int		current;		/* Last complete snapshot, or -1. */
+  int		max_entities;		/* Entities per snapshot. */
+  unsigned int	snapshot_len;		/* Bytes per snapshot. */
+  int		snapshot_generation[2];	/* Generation of each snapshot. */
+  gaulbyte	*snapshot[2];		/* Packed entities. */
+  } island_shm_t;
 
 /*
- * Allocate a send buffer of the required length and an array to store
- * entity ids.
+ * Everything an island process needs.  Pointers either refer to the
+ * shared segment, or to parent memory that is only read.
  */
-  buffer_len = pop->chromosome_to_bytes(pop, pop->entity_iarray[0], &buffer, &buffer_max);
-  if (buffer_max == 0)
-    {
-    if ( !(buffer = s_malloc(buffer_len*sizeof(gaulbyte))) )
-      die("Unable to allocate memory");
-    }
+typedef struct
+  {
+  population		*pop;
+  island_shm_t		*shm;		/* Island's shared record. */
+  int			*stop;		/* Shared termination flag. */
+  int			num_inbound;	/* Number of inbound edges. */
+  migration_queue_t	**inbound;	/* Immigrants from neighbours. */
+  int			num_outbound;	/* Number of outbound edges. */
+  migration_queue_t	*outbound;	/* Emigrants to neighbours. */
+  int			max_generations;
+  } island_process_t;
 
-  MPI_Comm_size(MPI_COMM_WORLD, &mpi_size);
-  if ( !(eid = s_malloc(mpi_size*sizeof(int))) )
-    die("Unable to allocate memory");
+#define SHM_ALIGN(len)	((((len)+sizeof(double)-1)/sizeof(double))*sizeof(double))
 
-/*
- * Register, set up and synchronise slave processes.
- */
-  gaul_bond_slaves_mpi(pop, buffer_len, buffer_max);
 
-  plog(LOG_VERBOSE, "The evolution has begun on %d islands (on %d processors)!", num_pops, mpi_size);
+/**********************************************************************
+  gaul_shm_carve()
+  synopsis:	Take the next, suitably aligned, block from the shared
+		memory segment.
+  parameters:	gaulbyte **cursor	Next free byte.
+		const size_t len
+  return:	Start of block.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void *gaul_shm_carve(gaulbyte **cursor, const size_t len)
+  {
+  void		*block = (void *) *cursor;
+
+  *cursor += SHM_ALIGN(len);
+
+  return block;
+  }
+
+
+/**********************************************************************
+  gaul_island_snapshot()
+  synopsis:	Publish the island's best entities in whichever
+		snapshot buffer is not current, then make it current.
+  parameters:	population *pop
+		island_shm_t *shm
+		const int generation
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void gaul_island_snapshot(population *pop, island_shm_t *shm, const int generation)
+  {
+  int		next;			/* Buffer to fill. */
+
+  next = shm->current==0 ? 1 : 0;
+
+  ga_entities_pack( pop, MIN(pop->size, shm->max_entities), NULL,
+                    shm->snapshot[next], shm->snapshot_len );
+
+  shm->snapshot_generation[next] = generation;
+  ATOMIC_STORE_RELEASE(shm->current, next);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_island_restore()
+  synopsis:	Replace the population with the island's current
+		snapshot, if there is one.
+  parameters:	population *pop
+		island_shm_t *shm
+  return:	Generation of snapshot, or 0 if none.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static int gaul_island_restore(population *pop, island_shm_t *shm)
+  {
+  int		current;		/* Snapshot buffer. */
+
+  current = ATOMIC_LOAD_ACQUIRE(shm->current);
+  if (current < 0) return 0;
+
+  ga_genocide(pop, 0);
+  ga_entities_unpack(pop, shm->snapshot[current], shm->snapshot_len);
+
+  sort_population(pop);
+
+  return shm->snapshot_generation[current];
+  }
 
-  pop->generation = 0;
 
-  for (current_island=0; current_island<num_pops; current_island++)
-    {
-    pop = pops[current_island];
+/**********************************************************************
+  gaul_island_process()
+  synopsis:	Complete generation loop for one island, in its own
+		process.  Migration is asynchronous: emigrants are
+		dropped if a neighbour's queue is full and only
+		immigrants that are already waiting are taken, so an
+		island never waits for a neighbour, which may have
+		died.  A snapshot of the population is published
+		every migration interval.  Never returns.
+  parameters:	island_process_t *self
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-/*
- * Score and sort the initial population members.
- */
-    gaul_ensure_evaluations_mpi(pop, eid, buffer, buffer_len, buffer_max);
+static void gaul_island_process(island_process_t *self)
+  {
+  population	*pop = self->pop;
+  int		generation;		/* Current generation number. */
+  int		interval;		/* Migration interval. */
+  int		num_residents;		/* Population size prior to migration. */
+  int		num;			/* Number of emigrants. */
+  int		e;			/* Loop over edges. */
+  int		*ranks;			/* Ranks of emigrants. */
+  int		max_ranks;		/* Length of ranks array. */
+
+  generation = gaul_island_restore(pop, self->shm);
+
+  if (generation == 0)
+    {
+    gaul_ensure_evaluations(pop);
     sort_population(pop);
     ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-  
-    plog( LOG_VERBOSE,
-          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
     }
 
-/* Do all the generations: */
-  while ( generation<max_generations && complete==FALSE)
+  plog( LOG_VERBOSE,
+        "Island %d process %d starting at generation %d with fitness scores between %f and %f",
+        pop->island, (int) getpid(), generation,
+        pop->entity_iarray[0]->fitness,
+        pop->entity_iarray[pop->size-1]->fitness );
+
+  interval = gaul_migration_interval(pop);
+  max_ranks = MAX(pop->size, 1);
+  if ( !(ranks = s_malloc(sizeof(int)*max_ranks)) )
+    die("Unable to allocate memory");
+
+  while ( generation<self->max_generations && !ATOMIC_LOAD_ACQUIRE(*(self->stop)) )
     {
     generation++;
     pop->generation = generation;
@@ -4694,119 +6574,152 @@ GAULFUNC int ga_evolution_archipelago_mpi( const int num_pops,
 /*
  * Migration step.
  */
-    gaul_migration(num_pops, pops);
+    num_residents = pop->size;
 
-    for(current_island=0; current_island<num_pops; current_island++)
+    if (self->num_outbound > 0 && generation%interval == 0)
       {
-      pop = pops[current_island];
+      if (num_residents > max_ranks)
+        {
+        max_ranks = num_residents;
+        if ( !(ranks = s_realloc(ranks, sizeof(int)*max_ranks)) )
+          die("Unable to allocate memory");
+        }
+      num = gaul_migration_select(pop, num_residents, self->outbound[0].max_migrants, ranks);
+      for (e=0; e<self->num_outbound; e++)
+        gaul_migration_send(pop, &(self->outbound[e]), num, ranks, FALSE);
+      }
 
-      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+    for (e=0; e<self->num_inbound; e++)
+      gaul_migration_poll(pop, self->inbound[e]);
 
-      if (pop->generation_hook?pop->generation_hook(generation, pop):TRUE)
-        {
-        pop->orig_size = pop->size;
+    gaul_migration_insert(pop, gaul_migration_replace(pop, num_residents));
 
-        plog( LOG_DEBUG,
-              "Population %d size is %d at start of generation %d",
-              current_island, pop->orig_size, generation );
+    if ( !gaul_generation_hook(pop, generation) )
+      {
+      ATOMIC_STORE_RELEASE(*(self->stop), TRUE);
+      break;
+      }
 
-/*
- * Crossover step.
- */
-        gaul_crossover(pop);	/* FIXME: Need to pass current_island for messages. */
+    pop->orig_size = pop->size;
 
-/*
- * Mutation step.
- */
-        gaul_mutation(pop);	/* FIXME: Need to pass current_island for messages. */
+    plog( LOG_DEBUG,
+          "Population %d size is %d at start of generation %d",
+          pop->island, pop->orig_size, generation );
 
-/*
- * Apply environmental adaptations, score entities, sort entities, etc.
- */
-        gaul_adapt_and_evaluate_mpi(pop, eid, buffer, buffer_len, buffer_max);
+    gaul_crossover(pop);
+    gaul_mutation(pop);
+    gaul_adapt_and_evaluate(pop);
+    gaul_niche_adjust(pop);
+    gaul_survival(pop);
+    gaul_niche_restore(pop);
 
-/*
- * Survival of the fittest.
- */
-        gaul_survival_mpi(pop);
+    ATOMIC_STORE_RELEASE(self->shm->generation, generation);
 
-        }
-      else
-        {
-        complete = TRUE;
-        }
-      }
+    if (generation%interval == 0)
+      gaul_island_snapshot(pop, self->shm, generation);
 
-    plog(LOG_VERBOSE,
+    plog( LOG_VERBOSE,
           "After generation %d, population %d has fitness scores between %f and %f",
           generation,
-          current_island,
+          pop->island,
           pop->entity_iarray[0]->fitness,
           pop->entity_iarray[pop->size-1]->fitness );
+    }
 
-/*
- * End of generation.
- */
-    plog( LOG_VERBOSE,
-          "After generation %d, population has fitness scores between %f and %f",
-          generation,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+  gaul_island_snapshot(pop, self->shm, generation);
+  ATOMIC_STORE_RELEASE(self->shm->done, TRUE);
 
-    }	/* Generation loop. */
+  log_flush();
+  _exit(EXIT_SUCCESS);
+  }
 
-/*
- * Register, set up and synchronise slave processes.
- */
-  gaul_debond_slaves_mpi(pop);
 
-/*
- * Deallocate send buffer and entity id array.
- */
-  s_free(buffer);
-  s_free(eid);
+/**********************************************************************
+  gaul_island_fork()
+  synopsis:	Start a process for an island.  Each process gets its
+		own random number seed, drawn from the parent's stream.
+  parameters:	island_process_t *island
+  return:	Child's PID.
+  last updated:	16 Oct 2026
+ **********************************************************************/
 
-  return generation;
-#else
-  plog(LOG_WARNING, "Attempt to use parallel function without compiled support.");
+static pid_t gaul_island_fork(island_process_t *island)
+  {
+  unsigned int	seed = random_rand();	/* Child's PRNG seed. */
+  pid_t		pid;			/* Child's PID. */
 
-  return 0;
-#endif
+  pid = fork();
+  gaul_trace_fork(pid);
+
+  if (pid < 0)
+    {       /* Error in fork. */
+    dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
+    }
+  else if (pid == 0)
+    {       /* This is the child process. */
+    random_seed(seed);
+    gaul_island_process(island);
+    }
+
+  return pid;
   }
 
 
 /**********************************************************************
-  ga_evolution_archipelago_threaded()
+  ga_evolution_archipelago_forked()
   synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given populations using a simple
-		island model.  Migration occurs around a cyclic
-		topology only.  Migration causes a duplication of the
+		optimisation on the given populations using an
+		island model.  Migration follows each population's
+		migration parameters and destinations (cyclic by
+		default).  Migration causes a duplication of the
 		respective entities.  This is a generation-based GA.
 		ga_genesis(), or equivalent, must be called prior to
 		this function.
-		This is a multiprocess version, using a thread
-		for each current_island.
-		FIXME: There is scope for further optimisation in here.
+		This is a multiprocess version, using a forked process
+		for each island, so breeding as well as evaluation
+		runs in parallel, and no thread-safety is required of
+		the callbacks.  Migrants are exchanged through fixed
+		size slots in a shared memory segment, using the
+		chromosome_to_bytes and chromosome_from_bytes
+		callbacks.  As for ga_evolution_archipelago_async(),
+		islands never wait for each other.
+		If an island's process dies, for example due to a
+		crash in the fitness function, the parent restarts
+		it from the island's latest snapshot, up to
+		GA_MAX_ISLAND_RESTARTS times.  The final populations
+		are copied back into pops.  If any island's generation
+		hook returns FALSE, all islands stop.
   parameters:	const int	num_pops
 		population	**pops
-		const int	max_generations
+		const int	max_generations	Per island.
   return:	number of generation performed
-  last updated:	18 Feb 2005
+  last updated:	16 Oct 2026
  **********************************************************************/
 
-#ifdef HAVE_PTHREADS
-GAULFUNC int ga_evolution_archipelago_threaded( const int num_pops,
+GAULFUNC int ga_evolution_archipelago_forked( const int num_pops,
 			population		**pops,
 			const int		max_generations )
   {
-  int		generation=0;		/* Current generation number. */
-  int		current_island;		/* Current current_island number. */
-  population	*pop=NULL;		/* Current population. */
-  boolean	complete=FALSE;		/* Whether evolution is terminated. */
-  int		max_threads=0;		/* Maximum number of threads to use at one time. */
-  char		*max_thread_str;	/* Value of enviroment variable. */
-  threaddata_t	*threaddata;		/* Used for passing data to threads. */
-  int		i;			/* Loop over threaddata elements. */
+  int			generation=0;	/* Generations performed. */
+  int			current_island;	/* Current island number. */
+  population		*pop=NULL;	/* Current population. */
+  island_process_t	*islands;	/* Per-island process data. */
+  island_shm_t		*records;	/* Shared per-island records. */
+  migration_queue_t	*queues;	/* Queue for each edge. */
+  migration_queue_t	**inbound;	/* Queues, grouped by destination. */
+  migration_queue_t	*queue;		/* Current queue. */
+  int			*offsets, *targets;	/* Migration graph. */
+  int			num_edges;	/* Number of edges. */
+  int			e;		/* Loop over edges. */
+  int			num_inbound=0;	/* Inbound queues assigned so far. */
+  size_t		shm_size;	/* Size of shared segment. */
+  gaulbyte		*shm;		/* Shared segment. */
+  gaulbyte		*cursor;	/* Next free byte in segment. */
+  int			*stop;		/* Shared termination flag. */
+  pid_t			*pid;		/* Island PIDs. */
+  int			*restarts;	/* Times each island was restarted. */
+  int			num_running;	/* Live island processes. */
+  pid_t			fpid;		/* PID of completed child process. */
 
 /* Checks. */
   if (!pops)
@@ -4825,340 +6738,485 @@ GAULFUNC int ga_evolution_archipelago_threaded( const int num_pops,
     if (!pop->crossover) die("Population's crossover callback is undefined.");
     if (!pop->rank) die("Population's ranking callback is undefined.");
     if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+    if (!pop->chromosome_to_bytes) die("Population's chromosome to bytes callback is undefined.");
+    if (!pop->chromosome_from_bytes) die("Population's chromosome from bytes callback is undefined.");
 
 /* Set current_island property. */
     pop->island = current_island;
-    }
-
-  plog(LOG_VERBOSE, "The evolution has begun on %d islands!", num_pops);
 
 /*
- * Look at environment to find number of threads to use.
+ * Seed initial entities.
+ * This is required prior to determining the size of the migration buffers.
  */
-  max_thread_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
-  if (max_thread_str) max_threads = atoi(max_thread_str);
-  if (max_threads == 0) max_threads = GA_DEFAULT_NUM_THREADS;
+    if (pop->size < pop->stable_size)
+      gaul_population_fill(pop, pop->stable_size - pop->size);
+    }
 
-  plog(LOG_VERBOSE, "During evolution upto %d threads will be created", max_threads);
+  num_edges = gaul_migration_graph(num_pops, pops, 0, num_pops, &offsets, &targets);
 
-/*
- * Allocate memory required for handling the threads.
- */
-  if ( !(threaddata = s_malloc(sizeof(threaddata_t)*max_threads)) )
+  if ( !(islands = s_malloc(sizeof(island_process_t)*num_pops)) )
+    die("Unable to allocate memory");
+  if ( !(inbound = s_malloc(sizeof(migration_queue_t *)*num_edges)) )
+    die("Unable to allocate memory");
+  if ( !(pid = s_malloc(sizeof(pid_t)*num_pops)) )
+    die("Unable to allocate memory");
+  if ( !(restarts = s_malloc(sizeof(int)*num_pops)) )
     die("Unable to allocate memory");
 
-  pop->generation = 0;
+/*
+ * Determine the size of the shared segment: a termination flag, a
+ * record for each island with two population snapshots, and a queue
+ * for each edge of the migration graph.
+ */
+  shm_size = SHM_ALIGN(sizeof(int))
+           + SHM_ALIGN(sizeof(island_shm_t)*num_pops)
+           + SHM_ALIGN(sizeof(migration_queue_t)*num_edges);
 
   for (current_island=0; current_island<num_pops; current_island++)
     {
     pop = pops[current_island];
 
-    for (i=0; i<max_threads; i++)
-      threaddata[i].pop = pop;
-
-/*
- * Score and sort the initial population members.
- */
-    if (pop->size < pop->stable_size)
-      gaul_population_fill(pop, pop->stable_size - pop->size);
-    gaul_ensure_evaluations_threaded(pop, max_threads, threaddata);
-    sort_population(pop);
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
-  
-    plog( LOG_VERBOSE,
-          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+    shm_size += 2*SHM_ALIGN(ga_entities_packed_size(pop, MAX(pop->stable_size, pop->size)))
+              + (offsets[current_island+1]-offsets[current_island])
+                *SHM_ALIGN(MIGRATION_QUEUE_BATCHES*ga_entities_packed_size(pop, gaul_migration_max_emigrants(pop)));
     }
 
-/* Do all the generations: */
-  while ( generation<max_generations && complete==FALSE)
+  shm = mmap(NULL, shm_size, PROT_READ|PROT_WRITE, MAP_SHARED|MAP_ANONYMOUS, -1, 0);
+  if (shm == MAP_FAILED)
+    dief("Error %d in mmap. (%s)", errno, errno==ENOMEM?"ENOMEM":"unknown");
+
+  cursor = shm;
+  stop = gaul_shm_carve(&cursor, sizeof(int));
+  records = gaul_shm_carve(&cursor, sizeof(island_shm_t)*num_pops);
+  queues = gaul_shm_carve(&cursor, sizeof(migration_queue_t)*num_edges);
+
+  *stop = FALSE;
+
+  for (current_island=0; current_island<num_pops; current_island++)
     {
-    generation++;
-    pop->generation = generation;
+    pop = pops[current_island];
 
-/*
- * Migration step.
- */
-    gaul_migration(num_pops, pops);
+    records[current_island].generation = 0;
+    records[current_island].done = FALSE;
+    records[current_island].current = -1;
+    records[current_island].max_entities = MAX(pop->stable_size, pop->size);
+    records[current_island].snapshot_len = ga_entities_packed_size(pop, records[current_island].max_entities);
+    for (e=0; e<2; e++)
+      {
+      records[current_island].snapshot_generation[e] = 0;
+      records[current_island].snapshot[e] = gaul_shm_carve(&cursor, records[current_island].snapshot_len);
+      }
 
-    for(current_island=0; current_island<num_pops; current_island++)
+    for (e=offsets[current_island]; e<offsets[current_island+1]; e++)
       {
-      pop = pops[current_island];
+      queue = &(queues[e]);
+
+      queue->max_migrants = gaul_migration_max_emigrants(pop);
+      queue->interval = gaul_migration_interval(pop);
+      queue->batch_len = ga_entities_packed_size(pop, queue->max_migrants);
+      queue->head = 0;
+      queue->tail = 0;
+      queue->sender_done = FALSE;
+      queue->receiver_done = FALSE;
+      queue->batches = gaul_shm_carve(&cursor, MIGRATION_QUEUE_BATCHES*queue->batch_len);
+      }
+    }
 
-      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    islands[current_island].pop = pops[current_island];
+    islands[current_island].shm = &(records[current_island]);
+    islands[current_island].stop = stop;
+    islands[current_island].num_outbound = offsets[current_island+1]-offsets[current_island];
+    islands[current_island].outbound = &(queues[offsets[current_island]]);
+    islands[current_island].inbound = &(inbound[num_inbound]);
+    islands[current_island].num_inbound = 0;
+    for (e=0; e<num_edges; e++)
+      {
+      if (targets[e] == current_island)
+        {
+        inbound[num_inbound++] = &(queues[e]);
+        islands[current_island].num_inbound++;
+        }
+      }
+    islands[current_island].max_generations = max_generations;
+    restarts[current_island] = 0;
+    }
 
-      for (i=0; i<max_threads; i++)
-        threaddata[i].pop = pop;
+  plog(LOG_VERBOSE, "The evolution has begun on %d islands, using a process for each!", num_pops);
 
-      if (pop->generation_hook?pop->generation_hook(generation, pop):TRUE)
-        {
-        pop->orig_size = pop->size;
+  fflush(NULL);		/* So buffered output isn't duplicated. */
 
-        plog( LOG_DEBUG,
-              "Population %d size is %d at start of generation %d",
-              current_island, pop->orig_size, generation );
+  for (current_island=0; current_island<num_pops; current_island++)
+    pid[current_island] = gaul_island_fork(&(islands[current_island]));
+  num_running = num_pops;
 
 /*
- * Crossover step.
+ * Wait for the island processes, restarting any that die.
  */
-        gaul_crossover(pop);	/* FIXME: Need to pass current_island for messages. */
+  while (num_running > 0)
+    {
+    fpid = wait(NULL);
 
-/*
- * Mutation step.
- */
-        gaul_mutation(pop);	/* FIXME: Need to pass current_island for messages. */
+    if (fpid == -1)
+      {
+      if (errno == EINTR) continue;
+      die("Error in wait().");
+      }
 
-/*
- * Apply environmental adaptations, score entities, sort entities, etc.
- */
-        gaul_adapt_and_evaluate_threaded(pop, max_threads, threaddata);
+    gaul_trace_reap(fpid);
 
-/*
- * Survival of the fittest.
- */
-        gaul_survival_threaded(pop, max_threads, threaddata);
+    current_island = 0;
+    while (current_island < num_pops && fpid != pid[current_island]) current_island++;
+    if (current_island == num_pops) continue;	/* Not an island process. */
 
-        }
-      else
-        {
-        complete = TRUE;
-        }
+    if (ATOMIC_LOAD_ACQUIRE(records[current_island].done))
+      {
+      pid[current_island] = -1;
+      num_running--;
+      }
+    else if ( restarts[current_island] < GA_MAX_ISLAND_RESTARTS &&
+              !ATOMIC_LOAD_ACQUIRE(*stop) )
+      {
+      restarts[current_island]++;
+      plog( LOG_WARNING, "Island %d process died.  Restarting from generation %d.",
+            current_island,
+            records[current_island].current<0?0:records[current_island].snapshot_generation[records[current_island].current] );
+      pid[current_island] = gaul_island_fork(&(islands[current_island]));
+      }
+    else
+      {
+      plog( LOG_WARNING, "Island %d process died.  Abandoning island after %d restarts.",
+            current_island, restarts[current_island] );
+      pid[current_island] = -1;
+      num_running--;
       }
+    }
 
-    plog(LOG_VERBOSE,
-          "After generation %d, population %d has fitness scores between %f and %f",
-          generation,
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
+/*
+ * Collate final entities.
+ */
+  for (current_island=0; current_island<num_pops; current_island++)
+    {
+    pops[current_island]->generation = gaul_island_restore(pops[current_island], &(records[current_island]));
 
-    }	/* Generation loop. */
+    if (pops[current_island]->generation > generation)
+      generation = pops[current_island]->generation;
+    }
 
-/* Free memory used for storing thread information. */
-  s_free(threaddata);
+  munmap(shm, shm_size);
+
+  s_free(restarts);
+  s_free(pid);
+  s_free(inbound);
+  s_free(islands);
+  s_free(offsets);
+  s_free(targets);
 
   return generation;
   }
 #else
-GAULFUNC int ga_evolution_archipelago_threaded( const int num_pops,
+GAULFUNC int ga_evolution_archipelago_forked( const int num_pops,
 			population		**pops,
 			const int		max_generations )
   {
-  die("Support for ga_evolution_archipelago_threaded() not compiled.");
+  die("Sorry, the ga_evolution_archipelago_forked() function isn't available for Windows.");
   return 0;
   }
 #endif
 
 
+#ifdef HAVE_MPI
+/*
+ * Migration graph spanning every process, for
+ * ga_evolution_archipelago_mp().  Islands are numbered in order of
+ * process rank, then of their position in each process's array.
+ */
+typedef struct
+  {
+  int		first;		/* Number of this process's first island. */
+  int		total;		/* Number of islands overall. */
+  int		*island_rank;	/* Process holding each island. */
+  int		*offsets;	/* Island i's edges are offsets[i] to offsets[i+1]-1. */
+  int		*targets;	/* Destination island for each edge. */
+  gaulbyte	**buffers;	/* Packed emigrants of each local island. */
+  unsigned int	*buffer_max;	/* Size of each buffer. */
+  unsigned int	*buffer_len;	/* Bytes packed in each buffer. */
+  MPI_Request	*requests;	/* Pending sends. */
+  } migration_mp_t;
+
+
 /**********************************************************************
-  ga_evolution_archipelago_forked()
-  synopsis:	Main genetic algorithm routine.  Performs GA-based
-		optimisation on the given populations using a simple
-		island model.  Migration occurs around a cyclic
-		topology only.  Migration causes a duplication of the
-		respective entities.  This is a generation-based GA.
-		ga_genesis(), or equivalent, must be called prior to
-		this function.
-		This is a multiprocess version, using a forked process
-		for each current_island.
-  parameters:	const int	num_pops
-		population	**pops
-		const int	max_generations
-  return:	number of generation performed
-  last updated:	17 Feb 2005
+  gaul_migration_mp_new()
+  synopsis:	Gather the migration destinations of the islands on
+		every process into a single graph, which every
+		process holds.
+  parameters:	const int num_pops
+		population **pops
+  return:	Migration graph.
+  last updated:	17 Oct 2026
  **********************************************************************/
 
-#ifndef W32_CRIPPLED
-GAULFUNC int ga_evolution_archipelago_forked( const int num_pops,
-			population		**pops,
-			const int		max_generations )
+static migration_mp_t *gaul_migration_mp_new(const int num_pops, population **pops)
   {
-  int		generation=0;		/* Current generation number. */
+  migration_mp_t	*graph;		/* Migration graph. */
+  int		*num_islands;	/* Islands on each process. */
+  int		*island_displs;	/* First island of each process. */
+  int		*num_edges;	/* Edges from each process. */
+  int		*edge_displs;	/* First edge of each process. */
+  int		*degree;	/* Edges from each island. */
+  int		*offsets, *targets;	/* Local migration graph. */
+  int		num_processes=mpi_get_num_processes();
+  int		num_requests=0;	/* Edges to other processes. */
+  int		i, r, e;	/* Loop over islands, processes, edges. */
+
+  if ( !(graph = s_malloc(sizeof(migration_mp_t))) ||
+       !(num_islands = s_malloc(sizeof(int)*num_processes)) ||
+       !(island_displs = s_malloc(sizeof(int)*num_processes)) ||
+       !(num_edges = s_malloc(sizeof(int)*num_processes)) ||
+       !(edge_displs = s_malloc(sizeof(int)*num_processes)) )
+    die("Unable to allocate memory");
 
-  plog(LOG_FIXME, "Code incomplete.");
+  MPI_Allgather((void *) &num_pops, 1, MPI_INT, num_islands, 1, MPI_INT, MPI_COMM_WORLD);
 
-#if 0
-  int		current_island;		/* Current current_island number. */
-  population	*pop=NULL;		/* Current population. */
-  boolean	complete=FALSE;		/* Whether evolution is terminated. */
-  int		i;			/* Loop over members of population. */
-  int		*evalpipe;		/* Pipes for returning fitnesses. */
-  pid_t		*pid;			/* Child PIDs. */
-  int		*eid;			/* Entity which forked process is evaluating. */
-  int		fork_num;		/* Index of current forked process. */
-  int		num_forks;		/* Number of forked processes. */
-  int		eval_num;		/* Index of current entity. */
-  pid_t		fpid;			/* PID of completed child process. */
+  graph->total = 0;
+  for (r=0; r<num_processes; r++)
+    {
+    island_displs[r] = graph->total;
+    graph->total += num_islands[r];
+    }
+  graph->first = island_displs[mpi_get_rank()];
 
-/* Checks. */
-  if (!pops)
-    die("NULL pointer to array of population structures passed.");
-  if (num_pops<2)
-    die("Need at least two populations for the island model.");
+  if ( !(graph->island_rank = s_malloc(sizeof(int)*graph->total)) ||
+       !(graph->offsets = s_malloc(sizeof(int)*(graph->total+1))) ||
+       !(degree = s_malloc(sizeof(int)*graph->total)) )
+    die("Unable to allocate memory");
 
-  pop->generation = 0;
+  for (r=0; r<num_processes; r++)
+    for (i=island_displs[r]; i<island_displs[r]+num_islands[r]; i++)
+      graph->island_rank[i] = r;
 
-  for (current_island=0; current_island<num_pops; current_island++)
-    {
-    pop = pops[current_island];
+/*
+ * Each process validates its own islands' destinations, then the
+ * edges are exchanged.
+ */
+  gaul_migration_graph(num_pops, pops, graph->first, graph->total, &offsets, &targets);
 
-    if (!pop->evaluate) die("Population's evaluation callback is undefined.");
-    if (!pop->select_one) die("Population's asexual selection callback is undefined.");
-    if (!pop->select_two) die("Population's sexual selection callback is undefined.");
-    if (!pop->mutate) die("Population's mutation callback is undefined.");
-    if (!pop->crossover) die("Population's crossover callback is undefined.");
-    if (!pop->rank) die("Population's ranking callback is undefined.");
-    if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
+  for (i=0; i<num_pops; i++)
+    degree[graph->first+i] = offsets[i+1]-offsets[i];
 
-/* Set current_island property. */
-    pop->island = current_island;
+  MPI_Allgatherv(&(degree[graph->first]), num_pops, MPI_INT,
+                 degree, num_islands, island_displs, MPI_INT, MPI_COMM_WORLD);
+
+  graph->offsets[0] = 0;
+  for (i=0; i<graph->total; i++)
+    graph->offsets[i+1] = graph->offsets[i]+degree[i];
+
+  for (r=0; r<num_processes; r++)
+    {
+    edge_displs[r] = graph->offsets[island_displs[r]];
+    num_edges[r] = graph->offsets[island_displs[r]+num_islands[r]]-edge_displs[r];
     }
 
-  plog(LOG_VERBOSE, "The evolution has begun on %d islands!", num_pops);
-  
-/*
- * Allocate memory.
- * Open pipes for reporting fitnesses.
- * Clear pid and eid arrays.
- */
-  if ( !(pid = s_malloc(max_processes*sizeof(pid_t))) )
-    die("Unable to allocate memory");
-  if ( !(eid = s_malloc(max_processes*sizeof(int))) )
+  if ( !(graph->targets = s_malloc(sizeof(int)*MAX(graph->offsets[graph->total], 1))) )
     die("Unable to allocate memory");
-  if ( !(evalpipe = s_malloc(2*max_processes*sizeof(int))) )
+
+  MPI_Allgatherv(targets, offsets[num_pops], MPI_INT,
+                 graph->targets, num_edges, edge_displs, MPI_INT, MPI_COMM_WORLD);
+
+  for (e=graph->offsets[graph->first]; e<graph->offsets[graph->first+num_pops]; e++)
+    if (graph->island_rank[graph->targets[e]] != mpi_get_rank()) num_requests++;
+
+  if ( !(graph->buffers = s_malloc(sizeof(gaulbyte *)*num_pops)) ||
+       !(graph->buffer_max = s_malloc(sizeof(unsigned int)*num_pops)) ||
+       !(graph->buffer_len = s_malloc(sizeof(unsigned int)*num_pops)) ||
+       !(graph->requests = s_malloc(sizeof(MPI_Request)*MAX(num_requests, 1))) )
     die("Unable to allocate memory");
 
-  for (i=0; i<max_processes; i++)
+  for (i=0; i<num_pops; i++)
     {
-    if (pipe(&evalpipe[2*i])==-1) die("Unable to open pipe");
-    pid[i] = -1;
-    eid[i] = -1;
+    graph->buffers[i] = NULL;
+    graph->buffer_max[i] = 0;
     }
 
-  for (current_island=0; current_island<num_pops; current_island++)
-    {
-    pop = pops[current_island];
+  s_free(offsets);
+  s_free(targets);
+  s_free(degree);
+  s_free(num_islands);
+  s_free(island_displs);
+  s_free(num_edges);
+  s_free(edge_displs);
 
-    if (pid[fork_num] < 0)
-      {       /* Error in fork. */
-      dief("Error %d in fork. (%s)", errno, errno==EAGAIN?"EAGAIN":errno==ENOMEM?"ENOMEM":"unknown");
-      }
-    else if (pid[fork_num] == 0)
-      {       /* This is the child process. */
+  return graph;
+  }
 
-/*
- * Score and sort the initial population members.
- */
-    if (pop->size < pop->stable_size)
-      gaul_population_fill(pop, pop->stable_size - pop->size);
-    gaul_ensure_evaluations(pop);
-    sort_population(pop);
-    ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-    plog( LOG_VERBOSE,
-          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
-    }
+/**********************************************************************
+  gaul_migration_mp_free()
+  synopsis:	Free a migration graph from gaul_migration_mp_new().
+  parameters:	migration_mp_t *graph
+		const int num_pops
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
 
-/* Do all the generations: */
-    while ( generation<max_generations && complete==FALSE)
-      {
-      generation++;
-      pop->generation = generation;
+static void gaul_migration_mp_free(migration_mp_t *graph, const int num_pops)
+  {
+  int		i;		/* Loop over islands. */
 
-/*
- * Migration and synchronisation step.
- */
-      FIXME.
+  for (i=0; i<num_pops; i++)
+    if (graph->buffers[i]) s_free(graph->buffers[i]);
 
-      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+  s_free(graph->buffers);
+  s_free(graph->buffer_max);
+  s_free(graph->buffer_len);
+  s_free(graph->requests);
+  s_free(graph->island_rank);
+  s_free(graph->offsets);
+  s_free(graph->targets);
+  s_free(graph);
 
-      if ( pop->generation_hook?pop->generation_hook(generation, pop):TRUE &&
-           complete == FALSE )
-        {
-        pop->orig_size = pop->size;
+  return;
+  }
 
-        plog( LOG_DEBUG,
-              "Population %d size is %d at start of generation %d",
-              current_island, pop->orig_size, generation );
 
-/*
- * Crossover step.
- */
-        gaul_crossover(pop);	/* FIXME: Need to pass current_island for messages. */
+/**********************************************************************
+  gaul_migration_mp()
+  synopsis:	Migration along a graph spanning several processes.
+		As gaul_migration(), emigrants are chosen from each
+		island's residents and cloned into every destination
+		island on this process.  Each edge to another process
+		carries one batch of packed emigrants per generation,
+		which is empty if the island doesn't emigrate, so
+		that every process can tell which batches to expect.
+		Batches are sent in order of source island, and
+		received in the same order.
+  parameters:	migration_mp_t *graph
+		const int num_pops
+		population **pops
+		const int generation
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
 
-/*
- * Mutation step.
- */
-        gaul_mutation(pop);	/* FIXME: Need to pass current_island for messages. */
+static void gaul_migration_mp( migration_mp_t *graph,
+                               const int num_pops, population **pops,
+                               const int generation )
+  {
+  int		*num_residents;		/* Island sizes prior to migration. */
+  int		*ranks;			/* Ranks of emigrants. */
+  int		max_residents=1;	/* Largest island. */
+  int		current_island;		/* Current island number. */
+  int		source;			/* Emigrating island. */
+  int		island;			/* Island number across all processes. */
+  int		destination;		/* Immigrating island. */
+  int		num;			/* Number of emigrants. */
+  int		num_requests=0;		/* Pending sends. */
+  boolean	remote;			/* Whether any destination is on another process. */
+  int		i, e;			/* Loop over emigrants, edges. */
 
-/*
- * Apply environmental adaptations, score entities, sort entities, etc.
- */
-        gaul_adapt_and_evaluate(pop);
+  plog( LOG_VERBOSE, "*** Migration Cycle ***" );
+
+  for(current_island=0; current_island<num_pops; current_island++)
+    gaul_profile_start(pops[current_island], GA_PHASE_MIGRATION);
+
+  if ( !(num_residents = s_malloc(sizeof(int)*num_pops)) )
+    die("Unable to allocate memory");
+
+  for(current_island=0; current_island<num_pops; current_island++)
+    {
+    num_residents[current_island] = pops[current_island]->size;
+    max_residents = MAX(max_residents, num_residents[current_island]);
+    }
+
+  if ( !(ranks = s_malloc(sizeof(int)*max_residents)) )
+    die("Unable to allocate memory");
 
 /*
- * Survival of the fittest.
+ * Islands emigrate in the order 1, 2, ..., num_pops-1, 0.
  */
-        gaul_survival(pop);
+  for(current_island=1; current_island<=num_pops; current_island++)
+    {
+    source = current_island%num_pops;
+    island = graph->first+source;
 
+    num = 0;
+    if ( graph->offsets[island]<graph->offsets[island+1] &&
+         generation%gaul_migration_interval(pops[source]) == 0 )
+      num = gaul_migration_select(pops[source], num_residents[source],
+                                  num_residents[source], ranks);
+
+    remote = FALSE;
+    for(e=graph->offsets[island]; e<graph->offsets[island+1]; e++)
+      {
+      destination = graph->targets[e];
+
+      if (graph->island_rank[destination] != mpi_get_rank())
+        {
+        remote = TRUE;
         }
       else
         {
-        complete = TRUE;
+        for(i=0; i<num; i++)
+          ga_entity_clone(pops[destination-graph->first], pops[source]->entity_iarray[ranks[i]]);
         }
+      }
 
-      plog(LOG_VERBOSE,
-          "After generation %d, population %d has fitness scores between %f and %f",
-          generation,
-          current_island,
-          pop->entity_iarray[0]->fitness,
-          pop->entity_iarray[pop->size-1]->fitness );
-
-      }	/* Generation loop. */
-
-    _exit((int) complete);
+    if (remote)
+      {
+      graph->buffer_len[source] = ga_entities_packed_size(pops[source], num);
+      if (graph->buffer_len[source] > graph->buffer_max[source])
+        {
+        graph->buffer_max[source] = graph->buffer_len[source];
+        if ( !(graph->buffers[source] = s_realloc(graph->buffers[source], graph->buffer_max[source])) )
+          die("Unable to allocate memory");
+        }
+      ga_entities_pack(pops[source], num, ranks, graph->buffers[source], graph->buffer_max[source]);
+      }
     }
 
 /*
- * Parent waits for children.
- * Synchronise children at the beginning of each generation, and
- * tell them to die if necessary.
- */
-  FIXME.
-  
-/*
- * Collate final entities.
+ * Since the sends don't block, no ordering between processes is
+ * required.
  */
-  FIXME.
+  for(source=0; source<num_pops; source++)
+    {
+    island = graph->first+source;
 
-/*
- * Close the pipes and free memory.
- */
-  for (i=0; i<max_processes; i++)
+    for(e=graph->offsets[island]; e<graph->offsets[island+1]; e++)
+      {
+      destination = graph->targets[e];
+      if (graph->island_rank[destination] != mpi_get_rank())
+        MPI_Isend(graph->buffers[source], (int) graph->buffer_len[source], MPI_BYTE,
+                  graph->island_rank[destination], GA_TAG_ENTITYBATCH,
+                  MPI_COMM_WORLD, &(graph->requests[num_requests++]));
+      }
+    }
+
+  for(island=0; island<graph->total; island++)
     {
-    close(evalpipe[2*i]);
-    close(evalpipe[2*i+1]);
+    if (graph->island_rank[island] == mpi_get_rank()) continue;
+
+    for(e=graph->offsets[island]; e<graph->offsets[island+1]; e++)
+      {
+      destination = graph->targets[e];
+      if (graph->island_rank[destination] == mpi_get_rank())
+        ga_population_append_receive(pops[destination-graph->first], graph->island_rank[island]);
+      }
     }
 
-  s_free(pid);
-  s_free(eid);
-  s_free(evalpipe);
-#endif
+  MPI_Waitall(num_requests, graph->requests, MPI_STATUSES_IGNORE);
 
-  return generation;
-  }
-#else
-GAULFUNC int ga_evolution_archipelago_forked( const int num_pops,
-			population		**pops,
-			const int		max_generations )
-  {
-  die("Sorry, the ga_evolution_archipelago_forked() function isn't available for Windows.");
-  return 0;
+  for(current_island=0; current_island<num_pops; current_island++)
+    gaul_migration_replace(pops[current_island], num_residents[current_island]);
+
+  s_free(ranks);
+  s_free(num_residents);
+
+  for(current_island=0; current_island<num_pops; current_island++)
+    gaul_profile_stop(pops[current_island]);
+
+  return;
   }
 #endif
 
@@ -5167,8 +7225,17 @@ GAULFUNC int ga_evolution_archipelago_forked( const int num_pops,
   ga_evolution_archipelago_mp()
   synopsis:	Main genetic algorithm routine.  Performs GA-based
 		optimisation on the given populations using a simple
-		island model.  Migration occurs around a cyclic
-		topology only.  Migration causes a duplication of the
+		island model.  The islands on all processors are
+		numbered in order of processor rank, then of their
+		position in each processor's array, and migration
+		follows the destinations set with
+		ga_population_set_migration_destinations() or
+		ga_archipelago_set_topology() in that numbering.  By
+		default, island i sends to island i-1, which is a
+		cyclic topology spanning the processors.  The
+		migration interval, emigration and immigration
+		policies from ga_population_set_migration_parameters()
+		are honoured.  Migration causes a duplication of the
 		respective entities.  This is a generation-based GA.
 		This is a multi-processor version with uses one
 	       	processor for one or more current_islands.  Note that the
@@ -5176,36 +7243,57 @@ GAULFUNC int ga_evolution_archipelago_forked( const int num_pops,
 		populations on each processor and the properties (e.g.
 		size) of those populations need not be equal - but be
 		careful of load-balancing issues in this case.  Safe
-		to call (but slightly inefficient) in single processor
-		case.
+		to call in the single processor case, or without
+		MPI support, when it is equivalent to
+		ga_evolution_archipelago().
 		ga_genesis(), or equivalent, must be called prior to
 		this function.
   parameters:	const int	num_pops
 		population	**pops
 		const int	max_generations
   return:	number of generation performed
-  last updated:	11 Jun 2002
+  last updated:	17 Oct 2026
  **********************************************************************/
 
 GAULFUNC int ga_evolution_archipelago_mp( const int num_pops,
 			population		**pops,
 			const int		max_generations )
   {
-#ifdef HAVE_MPI
   int		generation=0;		/* Current generation number. */
   int		current_island;			/* Current current_island number. */
-  int		i;			/* Loop over members of population. */
   population	*pop=NULL;		/* Current population. */
   boolean	complete=FALSE;		/* Whether evolution is terminated. */
-  int		pop0_osize;		/* Required for correct migration. */
-  boolean	*send_mask;		/* Whether particular entities need to be sent. */
-  int		send_count;		/* Number of entities to send. */
-  int		max_size=0;		/* Largest maximum size of populations. */
+  int		num_processes=1;	/* Number of processes. */
+  int		first=0;		/* Number of this process's first island. */
+  int		*offsets=NULL, *targets=NULL;	/* Migration graph within this process. */
+#ifdef HAVE_MPI
+  int		initialised;		/* Whether MPI is initialised. */
+  migration_mp_t	*graph=NULL;	/* Migration graph spanning the processes. */
+#endif
 
 /* Checks. */
   if (!pops)
     die("NULL pointer to array of population structures passed.");
 
+#ifdef HAVE_MPI
+  MPI_Initialized(&initialised);
+  if (initialised)
+    {
+    mpi_init();
+    num_processes = mpi_get_num_processes();
+    }
+
+  if (num_processes > 1)
+    {
+    graph = gaul_migration_mp_new(num_pops, pops);
+    first = graph->first;
+    }
+  else
+#endif
+    {
+    gaul_migration_graph(num_pops, pops, 0, num_pops, &offsets, &targets);
+    }
+
   for (current_island=0; current_island<num_pops; current_island++)
     {
     pop = pops[current_island];
@@ -5219,12 +7307,10 @@ GAULFUNC int ga_evolution_archipelago_mp( const int num_pops,
     if (pop->scheme != GA_SCHEME_DARWIN && !pop->adapt) die("Population's adaption callback is undefined.");
 
 /* Set current_island property. */
-    pop->island = current_island;
+    pop->island = first+current_island;
     }
 
-  plog(LOG_VERBOSE, "The evolution has begun on %d current_islands on node %d!", num_pops, mpi_get_rank());
-
-  mpi_init();
+  plog(LOG_VERBOSE, "The evolution has begun on %d current_islands on %d processes!", num_pops, num_processes);
 
   for (current_island=0; current_island<num_pops; current_island++)
     {
@@ -5240,95 +7326,29 @@ GAULFUNC int ga_evolution_archipelago_mp( const int num_pops,
     ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
     plog( LOG_VERBOSE,
-          "Prior to the first generation, population on current_island %d (process %d) has fitness scores between %f and %f",
-          current_island, mpi_get_rank(),
+          "Prior to the first generation, population on current_island %d has fitness scores between %f and %f",
+          first+current_island,
           pop->entity_iarray[0]->fitness,
           pop->entity_iarray[pop->size-1]->fitness );
-
-    max_size = max(max_size, pop->max_size);
     }
 
-  /* Allocate send_mask array. */
-  if ( !(send_mask = s_malloc(max_size*sizeof(boolean))) )
-    die("Unable to allocate memory");
-
 /* Do all the generations: */
   while ( generation<max_generations && complete==FALSE)
     {
     generation++;
 
-/*
- * Migration Cycle.
- * 1) Migration that doesn't require inter-process communication.
- * 2) Migration that requires migration from 'even' processes.
- * 3) Migration that requires migration from 'odd' processes.
- * (Special case due to odd number of nodes is okay)
- */
-    plog( LOG_VERBOSE, "*** Migration Cycle ***" );
-    pop0_osize = pops[0]->size;
-    for(current_island=1; current_island<num_pops; current_island++)
-      {
-      for(i=0; i<pops[current_island]->size; i++)
-        {
-        if (random_boolean_prob(pops[current_island]->migration_ratio))
-	  {
-          ga_entity_clone(pops[current_island-1], pops[current_island]->entity_iarray[i]);
-/*	  printf("%d, %d: Cloned %d %f\n", mpi_get_rank(), current_island, i, pops[current_island]->entity_iarray[i]->fitness);*/
-	  }
-        }
-      }
-
-    if (mpi_get_num_processes()<2)
-      {	/* No parallel stuff initialized, or only 1 processor. */
-      if (num_pops>1)
-        { /* There is more than one current_island. */
-        for(i=0; i<pop0_osize; i++)
-          {
-          if (random_boolean_prob(pops[0]->migration_ratio))
-            {
-            ga_entity_clone(pops[num_pops-1], pops[0]->entity_iarray[i]);
-/*	    printf("%d, %d: Cloned %d %f\n", mpi_get_rank(), 0, i, pops[0]->entity_iarray[i]->fitness);*/
-            }
-	  }
-	}
-      }
+#ifdef HAVE_MPI
+    if (graph)
+      gaul_migration_mp(graph, num_pops, pops, generation);
     else
-      {
-      if (ISEVEN(mpi_get_rank()))
-	{ /* Send then Recieve. */
-	send_count = 0;
-        for(i=0; i<pop0_osize; i++)
-          {
-          send_mask[i] = random_boolean_prob(pops[0]->migration_ratio);
-	  send_count += send_mask[i];
-/*	  if (send_mask[i]) printf("%d, 0: Cloned %d %f\n", mpi_get_rank(), i, pops[num_pops-1]->entity_iarray[i]->fitness);*/
-          }
-
-        ga_population_send_by_mask(pops[0], mpi_get_prev_rank(), send_count, send_mask);
-
-        ga_population_append_receive(pops[num_pops-1], mpi_get_next_rank());
-	}
-      else
-	{ /* Recieve then Send. */
-        ga_population_append_receive(pops[num_pops-1], mpi_get_next_rank());
-
-	send_count = 0;
-	for(i=0; i<pop0_osize; i++)
-          {
-          send_mask[i] = random_boolean_prob(pops[0]->migration_ratio);
-	  send_count += send_mask[i];
-/*	  if (send_mask[i]) printf("%d, 0: Cloned %d %f\n", mpi_get_rank(), i, pops[num_pops-1]->entity_iarray[i]->fitness);*/
-          }
-
-        ga_population_send_by_mask(pops[0], mpi_get_prev_rank(), send_count, send_mask);
-	}
-      }
+#endif
+      gaul_migration(num_pops, pops, generation, offsets, targets);
 
     for(current_island=0; current_island<num_pops; current_island++)
       {
       pop = pops[current_island];
 
-      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", current_island );
+      plog( LOG_VERBOSE, "*** Evolution on current_island %d ***", first+current_island );
 
 /*
  * Sort the individuals in each population.
@@ -5338,13 +7358,13 @@ GAULFUNC int ga_evolution_archipelago_mp( const int num_pops,
       sort_population(pop);
       ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
-      if (pop->generation_hook?pop->generation_hook(generation, pop):TRUE)
+      if (gaul_generation_hook(pop, generation))
         {
         pop->orig_size = pop->size;
 
         plog( LOG_DEBUG,
               "Population %d size is %d at start of generation %d",
-              current_island, pop->orig_size, generation );
+              first+current_island, pop->orig_size, generation );
 
 /*
  * Crossover step.
@@ -5364,7 +7384,9 @@ GAULFUNC int ga_evolution_archipelago_mp( const int num_pops,
 /*
  * Survival of the fittest.
  */
+        gaul_niche_adjust(pop);
         gaul_survival(pop);
+        gaul_niche_restore(pop);
 
         }
       else
@@ -5382,15 +7404,15 @@ GAULFUNC int ga_evolution_archipelago_mp( const int num_pops,
 
     }	/* Generation loop. */
 
-  /* Free the send_mask array. */
-  s_free(send_mask);
+#ifdef HAVE_MPI
+  if (graph)
+    gaul_migration_mp_free(graph, num_pops);
+#endif
 
-  return generation;
-#else
-  plog(LOG_WARNING, "Attempt to use parallel function without compiled support.");
+  if (offsets) s_free(offsets);
+  if (targets) s_free(targets);
 
-  return 0;
-#endif
+  return generation;
   }
 
 
@@ -5455,7 +7477,7 @@ GAULFUNC int ga_evolution_mp(	population		*pop,
  * Stop when (a) max_generations reached, or
  *           (b) "pop->generation_hook" returns FALSE.
  */
-    while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
+    while ( gaul_generation_hook(pop, generation) &&
              generation<max_generations )
       {
       generation++;
@@ -5484,7 +7506,9 @@ GAULFUNC int ga_evolution_mp(	population		*pop,
 /*
  * Survival of the fittest.
  */
+      gaul_niche_adjust(pop);
       gaul_survival_mp(pop);
+      gaul_niche_restore(pop);
 
 /*
  * End of generation.
@@ -5522,10 +7546,14 @@ GAULFUNC int ga_evolution_mp(	population		*pop,
   synopsis:	Main genetic algorithm routine.  Performs GA-based
 		optimisation on the given population.
 		This is a generation-based GA which utilizes MPI
-		processes.
+		processes.  Offspring are sent to the slave processes,
+		which must be attached with ga_attach_mpi_slave(), in
+		batches, with several batches in flight per slave.
+		The rank 0 process falls back to evaluating locally
+		if there are no slaves.
   parameters:
   return:
-  last updated:	17 Feb 2005
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 GAULFUNC int ga_evolution_mpi(	population		*pop,
@@ -5535,10 +7563,7 @@ GAULFUNC int ga_evolution_mpi(	population		*pop,
   int	generation=0;		/* Current generation number. */
   int	mpi_rank;		/* Rank of MPI process; should always by 0 here. */
   int	mpi_size;		/* Number of MPI processes. */
-  gaulbyte	*buffer=NULL;		/* Send buffer. */
-  int	buffer_len=0;		/* Length of send buffer. */
-  int	buffer_max=0;		/* Length of send buffer. */
-  int	*eid;			/* Sorage of entity ids being processed. */
+  mpi_farm_t	*farm;		/* Slave processes. */
 
 /* Checks. */
   if (!pop) die("NULL pointer to population structure passed.");
@@ -5563,36 +7588,22 @@ GAULFUNC int ga_evolution_mpi(	population		*pop,
 
 /*
  * Seed initial entities.
- * This is required prior to determining the size of the send buffer.
  */
   if (pop->size < pop->stable_size)
     gaul_population_fill(pop, pop->stable_size - pop->size);
 
-/*
- * Allocate a send buffer of the required length and an array to store
- * entity ids.
- */
-  buffer_len = pop->chromosome_to_bytes(pop, pop->entity_iarray[0], &buffer, &buffer_max);
-  if (buffer_max == 0)
-    {
-    if ( !(buffer = s_malloc(buffer_len*sizeof(gaulbyte))) )
-      die("Unable to allocate memory");
-    }
-
-  if ( !(eid = s_malloc(mpi_size*sizeof(int))) )
-    die("Unable to allocate memory");
-
 /*
  * Register, set up and synchronise slave processes.
  */
-  gaul_bond_slaves_mpi(pop, buffer_len, buffer_max);
+  gaul_bond_slaves_mpi(pop);
+  farm = gaul_farm_new_mpi();
 
   pop->generation = 0;
 
 /*
  * Score and sort the initial population members.
  */
-  gaul_ensure_evaluations_mpi(pop, eid, buffer, buffer_len, buffer_max);
+  gaul_ensure_evaluations_mpi(pop, farm);
   sort_population(pop);
   ga_genocide_by_fitness(pop, GA_MIN_FITNESS);
 
@@ -5607,7 +7618,7 @@ GAULFUNC int ga_evolution_mpi(	population		*pop,
  * Stop when (a) max_generations reached, or
  *           (b) "pop->generation_hook" returns FALSE.
  */
-  while ( (pop->generation_hook?pop->generation_hook(generation, pop):TRUE) &&
+  while ( gaul_generation_hook(pop, generation) &&
            generation<max_generations )
     {
     generation++;
@@ -5631,12 +7642,15 @@ GAULFUNC int ga_evolution_mpi(	population		*pop,
 /*
  * Apply environmental adaptations, score entities, sort entities, etc.
  */
-    gaul_adapt_and_evaluate_mpi(pop, eid, buffer, buffer_len, buffer_max);
+    gaul_adapt_and_evaluate_mpi(pop, farm);
+    gaul_farm_wait_mpi(farm);
 
 /*
  * Survival of the fittest.
  */
+    gaul_niche_adjust(pop);
     gaul_survival_mpi(pop);
+    gaul_niche_restore(pop);
 
 /*
  * End of generation.
@@ -5652,14 +7666,9 @@ GAULFUNC int ga_evolution_mpi(	population		*pop,
 /*
  * Register, set up and synchronise slave processes.
  */
+  gaul_farm_free_mpi(farm);
   gaul_debond_slaves_mpi(pop);
 
-/*
- * Deallocate send buffer and entity id array.
- */
-  s_free(buffer);
-  s_free(eid);
-
   return generation;
 #else
   plog(LOG_WARNING, "Attempt to use parallel function without compiled support.");
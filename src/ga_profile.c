@@ -0,0 +1,863 @@
+/**********************************************************************
+  ga_profile.c
+ **********************************************************************
+
+  ga_profile - Profiling of evolutions.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Built-in profiling of evolutions.
+
+		Once enabled with ga_population_set_profiling(), the
+		evolutionary drivers record, for each phase of their
+		generations, the cumulative wall-clock time, CPU time
+		and number of calls.  Phases may nest, for example
+		sorting within survival, and each phase's time
+		excludes that of the phases nested within it.  Each
+		fitness evaluation is also timed, giving a latency
+		histogram and the time each evaluation thread was busy.
+
+		The wall-clock time of each phase boundary is read from
+		timer_monotonic().  Reading CPU time needs a system
+		call, so it is only sampled when at least
+		GA_PROFILE_CPU_INTERVAL seconds have passed since the
+		last sample.  The CPU time consumed in between is
+		shared among the phases in proportion to their
+		wall-clock time.  CPU time is that of the thread which
+		drives the population, so evaluations by other threads
+		are only reflected in those threads' busy times.
+
+		Even a cheap clock read costs tens of nanoseconds,
+		which is significant next to a selection or a trivial
+		fitness evaluation.  So evaluations, and phases which
+		contain no other phases, that take less than
+		GA_PROFILE_SAMPLE_LATENCY seconds on average are only
+		timed one call in GA_PROFILE_SAMPLE_STRIDE.  Each timed
+		call stands for the untimed calls since the previous
+		one.  The time of an untimed phase falls to the
+		enclosing phase, from which it is moved back when the
+		phase is next timed.  The cost of reading the clock,
+		measured when profiling is enabled, is deducted from
+		the timed calls first.  Calls and evaluations are
+		always counted exactly.
+
+		Drivers whose iterations each produce only a few
+		offspring, like ga_evolution_steady_state(), would
+		still pay for the bookkeeping of about ten phase
+		boundaries per offspring.  They bracket each iteration
+		with gaul_profile_iteration_start() and
+		gaul_profile_iteration_stop().  Unless iterations take
+		GA_PROFILE_SAMPLE_ITERATION seconds on average, only
+		one in GA_PROFILE_ITERATION_STRIDE of them is sampled,
+		and all of its phases are timed.  The phases of the
+		other iterations are only counted, and their time is
+		moved from outside any phase as above.  Their
+		evaluations are timed one in
+		GA_PROFILE_ITERATION_STRIDE instead.
+
+		Evaluations performed by forked processes or by MPI
+		slaves are not timed individually.
+
+ **********************************************************************/
+
+#include "gaul/ga_profile.h"
+
+/*
+ * Minimum wall-clock seconds between samples of the CPU time.
+ */
+#define GA_PROFILE_CPU_INTERVAL	1.0e-3
+
+/*
+ * Phases and evaluations with a shorter mean duration, in seconds,
+ * are timed once per stride of calls.
+ */
+#define GA_PROFILE_SAMPLE_LATENCY	2.0e-5
+#define GA_PROFILE_SAMPLE_STRIDE	16
+
+/*
+ * Iterations with a shorter mean duration, in seconds, are sampled
+ * once per stride of iterations.
+ */
+#define GA_PROFILE_SAMPLE_ITERATION	1.0e-4
+#define GA_PROFILE_ITERATION_STRIDE	64
+
+/*
+ * Clock reads, in each of several batches, used to measure the cost
+ * of one read.
+ */
+#define GA_PROFILE_CALIBRATION	16
+#define GA_PROFILE_CALIBRATION_BATCHES	8
+
+/*
+ * Phase names.
+ */
+static const char *ga_profile_phase_names[GA_NUM_PHASES] =
+  { "selection", "crossover", "mutation", "adaptation",
+    "evaluation", "sort", "survival", "migration" };
+
+/*
+ * Evaluation thread numbers are small integers, reused once a thread
+ * exits, so that each thread updates its own statistics.
+ */
+#ifdef HAVE_PTHREADS
+static pthread_key_t	profile_thread_key;
+static pthread_once_t	profile_thread_once=PTHREAD_ONCE_INIT;
+static boolean		profile_thread_used[GA_PROFILE_MAX_THREADS];
+THREAD_LOCK_DEFINE_STATIC(gaul_profile_thread_lock);
+#endif
+
+/**********************************************************************
+  gaul_profile_thread_release()
+  synopsis:	pthread key destructor.  Release a thread number.
+  parameters:	void *data	Thread number plus one.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+#ifdef HAVE_PTHREADS
+static void gaul_profile_thread_release(void *data)
+  {
+
+  THREAD_LOCK(gaul_profile_thread_lock);
+  profile_thread_used[(size_t) data - 1] = FALSE;
+  THREAD_UNLOCK(gaul_profile_thread_lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_profile_thread_key_create()
+  synopsis:	One-time initialisation of thread numbering.
+  parameters:	none
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_profile_thread_key_create(void)
+  {
+  pthread_key_create(&profile_thread_key, gaul_profile_thread_release);
+  return;
+  }
+#endif
+
+
+/**********************************************************************
+  gaul_profile_thread()
+  synopsis:	Return the calling thread's number.  If more than
+		GA_PROFILE_MAX_THREADS threads are evaluating at once,
+		the extra threads share the final number.
+  parameters:	none
+  return:	Thread number.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+int gaul_profile_thread(void)
+  {
+#ifdef HAVE_PTHREADS
+  size_t	id;		/* Thread number plus one. */
+
+  pthread_once(&profile_thread_once, gaul_profile_thread_key_create);
+
+  if ( (id = (size_t) pthread_getspecific(profile_thread_key)) != 0 )
+    return (int) id - 1;
+
+  THREAD_LOCK(gaul_profile_thread_lock);
+  for (id=0; id<GA_PROFILE_MAX_THREADS-1 && profile_thread_used[id]; id++);
+  profile_thread_used[id] = TRUE;
+  THREAD_UNLOCK(gaul_profile_thread_lock);
+
+  pthread_setspecific(profile_thread_key, (void *) (id+1));
+
+  return (int) id;
+#else
+# ifdef USE_OPENMP
+  return omp_get_thread_num()%GA_PROFILE_MAX_THREADS;
+# else
+  return 0;
+# endif
+#endif
+  }
+
+
+/**********************************************************************
+  gaul_profile_sample_cpu()
+  synopsis:	Share the CPU time consumed since the last sample
+		among the phases, in proportion to their wall-clock
+		time.
+  parameters:	ga_profile_t *profile
+		const double now	Current wall-clock time.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_profile_sample_cpu(ga_profile_t *profile, const double now)
+  {
+  double	cpu;		/* Current CPU time. */
+  double	total=0.0;	/* Wall-clock time since last sample. */
+  int		phase;		/* Loop over phases. */
+
+  cpu = timer_cpu();
+
+/* Moving sampled time between phases may leave a small negative remainder. */
+  for (phase=0; phase<=GA_NUM_PHASES; phase++)
+    total += MAX(0.0, profile->pending[phase]);
+
+  if (total > 0.0 && cpu > profile->cpu_mark)
+    {
+    for (phase=0; phase<GA_NUM_PHASES; phase++)
+      profile->cpu[phase] += (cpu-profile->cpu_mark)*MAX(0.0, profile->pending[phase])/total;
+    }
+
+  for (phase=0; phase<=GA_NUM_PHASES; phase++)
+    profile->pending[phase] = 0.0;
+
+  profile->cpu_mark = cpu;
+  profile->cpu_sampled = now;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_profile_timed()
+  synopsis:	Find the innermost timed phase.
+  parameters:	ga_profile_t *profile
+  return:	Stack level, or -1 if outside any timed phase.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static int gaul_profile_timed(ga_profile_t *profile)
+  {
+  int		level;		/* Stack level. */
+
+  for (level=MIN(profile->depth, GA_PROFILE_MAX_DEPTH)-1;
+       level>=0 && profile->weight[level]==0; level--);
+
+  return level;
+  }
+
+
+/**********************************************************************
+  gaul_profile_account()
+  synopsis:	Charge the time since the last phase boundary to the
+		innermost timed phase.
+  parameters:	ga_profile_t *profile
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_profile_account(ga_profile_t *profile)
+  {
+  double	now;		/* Current wall-clock time. */
+  double	elapsed;	/* Time since last boundary. */
+  ga_phase_type	phase;		/* Current phase. */
+  int		level;		/* Stack level of current phase. */
+
+  now = timer_monotonic();
+  elapsed = now - profile->mark;
+  profile->mark = now;
+
+  if ( (level = gaul_profile_timed(profile)) >= 0 )
+    {
+    phase = profile->stack[level];
+    profile->wall[phase] += elapsed;
+    profile->pending[phase] += elapsed;
+    profile->exclusive[level] += elapsed;
+    }
+  else
+    {
+    profile->outside += elapsed;
+    profile->pending[GA_NUM_PHASES] += elapsed;
+    }
+
+/* The sample's own cost would be scaled up with a sampled phase. */
+  if (now - profile->cpu_sampled >= GA_PROFILE_CPU_INTERVAL)
+    {
+    gaul_profile_sample_cpu(profile, now);
+    profile->mark = timer_monotonic();
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_profile_start()
+  synopsis:	Enter a phase.  Does nothing unless profiling or
+		tracing is enabled.  Short phases which contain no
+		other phases are only timed once per
+		GA_PROFILE_SAMPLE_STRIDE calls.
+  parameters:	population *pop
+		const ga_phase_type phase
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_profile_start(population *pop, const ga_phase_type phase)
+  {
+  ga_profile_t	*profile=pop->profile;	/* Profiling statistics. */
+  unsigned long	calls;			/* Calls including this one. */
+  boolean	timed;			/* Whether to time this call. */
+
+  gaul_trace_begin(phase, NULL);
+
+  if (!profile) return;
+
+  if (profile->skip)
+    {
+    profile->calls[phase]++;
+    return;
+    }
+
+  if (profile->depth > 0 && profile->depth <= GA_PROFILE_MAX_DEPTH)
+    profile->nests[profile->stack[profile->depth-1]] = TRUE;
+
+  calls = ++profile->calls[phase];
+  timed = profile->sampled || profile->nests[phase] ||
+          calls - profile->timed[phase] >= GA_PROFILE_SAMPLE_STRIDE ||
+          profile->wall[phase] >= GA_PROFILE_SAMPLE_LATENCY*profile->timed[phase];
+
+  if (timed) gaul_profile_account(profile);
+
+  if (profile->depth < GA_PROFILE_MAX_DEPTH)
+    {
+    profile->stack[profile->depth] = phase;
+    profile->weight[profile->depth] = timed ? calls - profile->timed[phase] : 0;
+    profile->exclusive[profile->depth] = 0.0;
+    }
+  profile->depth++;
+
+  if (timed) profile->timed[phase] = calls;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_profile_stop()
+  synopsis:	Leave the current phase.  Does nothing unless profiling
+		or tracing is enabled.  When a timed call stands for
+		untimed calls too, their estimated time is moved from
+		the enclosing phase.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_profile_stop(population *pop)
+  {
+  ga_profile_t	*profile=pop->profile;	/* Profiling statistics. */
+  int		level;			/* Stack level of this phase. */
+  int		parent;			/* Stack level of enclosing phase. */
+  double	extra;			/* Time of untimed calls. */
+  double	available;		/* Time charged to enclosing phase. */
+  ga_phase_type	phase;			/* This phase. */
+
+  gaul_trace_end();
+
+  if (!profile || profile->skip || profile->depth == 0) return;
+
+  level = profile->depth-1;
+
+  if (level < GA_PROFILE_MAX_DEPTH && profile->weight[level] > 0)
+    {
+    gaul_profile_account(profile);
+
+    if (profile->weight[level] > 1)
+      {
+      phase = profile->stack[level];
+      extra = (profile->weight[level]-1)*MAX(0.0, profile->exclusive[level]-profile->clock_cost);
+
+      profile->depth--;
+      parent = gaul_profile_timed(profile);
+
+/* An unlucky sample mustn't take more than the untimed calls were charged. */
+      available = parent >= 0 ? profile->wall[profile->stack[parent]] : profile->outside;
+      extra = MIN(extra, MAX(0.0, available));
+
+      profile->wall[phase] += extra;
+      profile->pending[phase] += extra;
+      if (parent >= 0)
+        {
+        profile->wall[profile->stack[parent]] -= extra;
+        profile->pending[profile->stack[parent]] -= extra;
+        }
+      else
+        {
+        profile->outside -= extra;
+        profile->pending[GA_NUM_PHASES] -= extra;
+        }
+      return;
+      }
+    }
+  profile->depth--;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_profile_iteration_start()
+  synopsis:	Begin an iteration of a driver, deciding whether its
+		phases are all timed or only counted.  Does nothing
+		unless profiling is enabled.  Must be called outside
+		any phase.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_profile_iteration_start(population *pop)
+  {
+  ga_profile_t	*profile=pop->profile;	/* Profiling statistics. */
+
+  if (!profile) return;
+
+  if ( profile->iterations++ > 0 &&
+       profile->unsampled < GA_PROFILE_ITERATION_STRIDE-1 &&
+       profile->iteration_latency < GA_PROFILE_SAMPLE_ITERATION )
+    {
+    profile->unsampled++;
+    profile->skip = TRUE;
+    return;
+    }
+
+  gaul_profile_account(profile);
+  if (profile->iterations > 1)
+    profile->iteration_latency = (profile->mark-profile->iteration_mark)/(profile->unsampled+1);
+  profile->iteration_mark = profile->mark;
+  profile->unsampled = 0;
+  profile->sampled = TRUE;
+  profile->driver = gaul_profile_thread();
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_profile_iteration_stop()
+  synopsis:	End an iteration begun by
+		gaul_profile_iteration_start().
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_profile_iteration_stop(population *pop)
+  {
+  ga_profile_t	*profile=pop->profile;	/* Profiling statistics. */
+
+  if (!profile) return;
+
+  profile->skip = FALSE;
+  profile->sampled = FALSE;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_evaluate()
+  synopsis:	Call the population's evaluation callback, timing it if
+		profiling or tracing is enabled, note the telemetry
+		interval in which it was evaluated and discard any
+		cached fitness statistics.  May be called by any
+		thread.
+  parameters:	population *pop
+		entity *this_entity
+  return:	Return value of the evaluation callback.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+boolean gaul_evaluate(population *pop, entity *this_entity)
+  {
+  ga_profile_thread_t	*self;		/* Calling thread's statistics. */
+  double		start;		/* Start time. */
+  double		latency;	/* Time taken. */
+  boolean		success;	/* Return value of callback. */
+  int			bin;		/* Histogram bin. */
+  unsigned long		stride;		/* Evaluations per timed evaluation. */
+
+  this_entity->epoch = pop->epoch;
+  gaul_stats_invalidate(pop);
+
+  gaul_trace_begin(GAUL_TRACE_EVALUATE, NULL);
+
+  if (!pop->profile)
+    {
+    success = pop->evaluate(pop, this_entity);
+    gaul_trace_end();
+    return success;
+    }
+
+/*
+ * Only the driving thread evaluates within an iteration.  Evaluations
+ * within a sampled iteration aren't timed, as the extra clock reads
+ * would be scaled up with its phases.
+ */
+  if (pop->profile->skip || pop->profile->sampled)
+    {
+    self = &(pop->profile->thread[pop->profile->driver]);
+    stride = GA_PROFILE_ITERATION_STRIDE;
+    }
+  else
+    {
+    self = &(pop->profile->thread[gaul_profile_thread()]);
+    stride = GA_PROFILE_SAMPLE_STRIDE;
+    }
+  self->evaluations++;
+
+  if ( pop->profile->sampled ||
+       ( self->evaluations > 1 && self->latency < GA_PROFILE_SAMPLE_LATENCY &&
+         self->untimed < stride-1 ) )
+    {
+    self->untimed++;
+    success = pop->evaluate(pop, this_entity);
+    gaul_trace_end();
+    return success;
+    }
+
+  start = timer_monotonic();
+  success = pop->evaluate(pop, this_entity);
+  latency = MAX(0.0, timer_monotonic() - start - pop->profile->clock_cost);
+
+  gaul_trace_end();
+
+  if (latency < 1.0e-6)
+    bin = 0;
+  else
+    frexp(latency*1.0e6, &bin);
+  if (bin >= GA_PROFILE_HISTOGRAM_BINS) bin = GA_PROFILE_HISTOGRAM_BINS-1;
+
+/* This evaluation stands for the untimed ones since the last. */
+  self->busy += latency*(self->untimed+1);
+  self->histogram[bin] += self->untimed+1;
+  self->untimed = 0;
+  self->latency = latency;
+  self->bin = bin;
+
+  return success;
+  }
+
+
+/**********************************************************************
+  ga_population_set_profiling()
+  synopsis:	Enable or disable profiling of a population.  Enabling
+		profiling clears any previous statistics.  The
+		statistics are kept until profiling is disabled or the
+		population is destroyed, and may be displayed by
+		ga_population_dump().
+  parameters:	population *pop
+		const boolean enabled
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_profiling(population *pop, const boolean enabled)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  if (!enabled)
+    {
+    if (pop->profile) s_free(pop->profile);
+    pop->profile = NULL;
+    return;
+    }
+
+  if ( !pop->profile && !(pop->profile = s_malloc(sizeof(ga_profile_t))) )
+    die("Unable to allocate memory");
+
+  ga_population_profile_reset(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_get_profiling()
+  synopsis:	Whether a population is being profiled.
+  parameters:	population *pop
+  return:	TRUE if profiling is enabled.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_get_profiling(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return pop->profile != NULL;
+  }
+
+
+/**********************************************************************
+  ga_population_profile_reset()
+  synopsis:	Clear a population's profiling statistics.  Should not
+		be called during an evolution.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_profile_reset(population *pop)
+  {
+  ga_profile_t	*profile;	/* Profiling statistics. */
+  double	start;		/* Start of clock calibration. */
+  int		i, j;		/* Loop over clock reads, batches. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !(profile = pop->profile) ) return;
+
+  memset(profile, 0, sizeof(ga_profile_t));
+
+/* The quickest of several batches, in case one is interrupted. */
+  profile->clock_cost = DBL_MAX;
+  for (j=0; j<GA_PROFILE_CALIBRATION_BATCHES; j++)
+    {
+    start = timer_monotonic();
+    for (i=0; i<GA_PROFILE_CALIBRATION; i++)
+      profile->mark = timer_monotonic();
+    profile->clock_cost = MIN(profile->clock_cost, (profile->mark-start)/GA_PROFILE_CALIBRATION);
+    }
+
+  profile->start = profile->mark = profile->cpu_sampled = timer_monotonic();
+  profile->cpu_mark = timer_cpu();
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_profile_get_phase()
+  synopsis:	Retrieve the cumulative time spent in a phase.  Any
+		NULL pointers are ignored.
+  parameters:	population *pop
+		const ga_phase_type phase
+		double *wall		Wall-clock seconds.
+		double *cpu		CPU seconds.
+		unsigned long *calls	Times phase was entered.
+  return:	FALSE if profiling is not enabled.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_profile_get_phase( population *pop,
+                                        const ga_phase_type	phase,
+                                        double		*wall,
+                                        double		*cpu,
+                                        unsigned long	*calls )
+  {
+  ga_profile_t	*profile;	/* Profiling statistics. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( phase < 0 || phase >= GA_NUM_PHASES ) die("Invalid phase.");
+
+  if (wall) *wall = 0.0;
+  if (cpu) *cpu = 0.0;
+  if (calls) *calls = 0;
+
+  if ( !(profile = pop->profile) ) return FALSE;
+
+  if (profile->depth == 0)
+    {
+    gaul_profile_account(profile);
+    gaul_profile_sample_cpu(profile, profile->mark);
+    }
+
+  if (wall) *wall = MAX(0.0, profile->wall[phase]);
+  if (cpu) *cpu = profile->cpu[phase];
+  if (calls) *calls = profile->calls[phase];
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  ga_population_profile_get_histogram()
+  synopsis:	Retrieve the histogram of evaluation latencies, summed
+		over all threads.  Untimed evaluations since a thread's
+		last timed one are counted in the same bin.
+  parameters:	population *pop
+		unsigned long *counts	Array of GA_PROFILE_HISTOGRAM_BINS
+					counts to fill, or NULL.
+  return:	Total number of evaluations.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC unsigned long ga_population_profile_get_histogram( population *pop,
+                                        unsigned long	*counts )
+  {
+  unsigned long	total=0;	/* Total evaluations. */
+  int		i, bin;		/* Loop over threads, bins. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  if (counts)
+    for (bin=0; bin<GA_PROFILE_HISTOGRAM_BINS; bin++) counts[bin] = 0;
+
+  if ( !pop->profile ) return 0;
+
+  for (i=0; i<GA_PROFILE_MAX_THREADS; i++)
+    {
+    total += pop->profile->thread[i].evaluations;
+    if (counts)
+      {
+      for (bin=0; bin<GA_PROFILE_HISTOGRAM_BINS; bin++)
+        counts[bin] += pop->profile->thread[i].histogram[bin];
+      counts[pop->profile->thread[i].bin] += pop->profile->thread[i].untimed;
+      }
+    }
+
+  return total;
+  }
+
+
+/**********************************************************************
+  ga_population_profile_get_thread()
+  synopsis:	Retrieve the evaluation statistics of one thread.  The
+		idle time is the remainder of the time since profiling
+		was enabled or reset.  Any NULL pointers are ignored.
+  parameters:	population *pop
+		const int thread	Thread number.
+		unsigned long *evaluations
+		double *busy		Seconds spent evaluating.
+		double *idle		Seconds not spent evaluating.
+  return:	FALSE if the thread performed no evaluations.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_profile_get_thread( population *pop,
+                                        const int	thread,
+                                        unsigned long	*evaluations,
+                                        double		*busy,
+                                        double		*idle )
+  {
+  ga_profile_thread_t	*this;		/* Thread's statistics. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( thread < 0 || thread >= GA_PROFILE_MAX_THREADS ) die("Invalid thread number.");
+
+  if (evaluations) *evaluations = 0;
+  if (busy) *busy = 0.0;
+  if (idle) *idle = 0.0;
+
+  if ( !pop->profile ) return FALSE;
+
+  this = &(pop->profile->thread[thread]);
+
+  if (evaluations) *evaluations = this->evaluations;
+  if (busy) *busy = this->busy + this->latency*this->untimed;
+  if (idle) *idle = MAX(0.0, timer_monotonic()-pop->profile->start-this->busy-this->latency*this->untimed);
+
+  return this->evaluations > 0;
+  }
+
+
+/**********************************************************************
+  ga_profile_histogram_bin_limit()
+  synopsis:	Upper limit of an evaluation latency histogram bin.
+  parameters:	const int bin
+  return:	Upper limit in seconds, or DBL_MAX for the final bin.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double ga_profile_histogram_bin_limit(const int bin)
+  {
+
+  if ( bin < 0 || bin >= GA_PROFILE_HISTOGRAM_BINS ) die("Invalid bin.");
+
+  if (bin == GA_PROFILE_HISTOGRAM_BINS-1) return DBL_MAX;
+
+  return ldexp(1.0e-6, bin);
+  }
+
+
+/**********************************************************************
+  ga_profile_phase_name()
+  synopsis:	Name of a phase.
+  parameters:	const ga_phase_type phase
+  return:	Static string.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC const char *ga_profile_phase_name(const ga_phase_type phase)
+  {
+
+  if ( phase < 0 || phase >= GA_NUM_PHASES ) die("Invalid phase.");
+
+  return ga_profile_phase_names[phase];
+  }
+
+
+/**********************************************************************
+  gaul_profile_dump()
+  synopsis:	Display a population's profiling statistics, for
+		ga_population_dump().
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_profile_dump(population *pop)
+  {
+  unsigned long	counts[GA_PROFILE_HISTOGRAM_BINS];	/* Latency histogram. */
+  unsigned long	calls, evaluations;	/* Counts. */
+  double	wall, cpu;		/* Phase times. */
+  double	busy, idle;		/* Thread times. */
+  int		i;			/* Loop over phases, bins, threads. */
+
+  if (!pop->profile) return;
+
+  printf("Profile over %f seconds\n", timer_monotonic()-pop->profile->start);
+
+  for (i=0; i<GA_NUM_PHASES; i++)
+    {
+    ga_population_profile_get_phase(pop, (ga_phase_type) i, &wall, &cpu, &calls);
+    if (calls > 0)
+      printf( "Phase %-10s calls %lu wall %f cpu %f\n",
+              ga_profile_phase_name((ga_phase_type) i), calls, wall, cpu );
+    }
+
+  evaluations = ga_population_profile_get_histogram(pop, counts);
+  printf("Evaluations %lu\n", evaluations);
+  for (i=0; i<GA_PROFILE_HISTOGRAM_BINS; i++)
+    {
+    if (counts[i] > 0)
+      {
+      if (i == GA_PROFILE_HISTOGRAM_BINS-1)
+        printf("Latency >= %g s: %lu\n", ga_profile_histogram_bin_limit(i-1), counts[i]);
+      else
+        printf("Latency < %g s: %lu\n", ga_profile_histogram_bin_limit(i), counts[i]);
+      }
+    }
+
+  for (i=0; i<GA_PROFILE_MAX_THREADS; i++)
+    {
+    if (ga_population_profile_get_thread(pop, i, &evaluations, &busy, &idle))
+      printf( "Thread %d evaluations %lu busy %f idle %f (%.1f%% busy)\n",
+              i, evaluations, busy, idle, 100.0*busy/MAX(busy+idle, DBL_MIN) );
+    }
+
+  return;
+  }
+
@@ -173,10 +173,6 @@ void quicksort_population(population *pop)
 
   plog(LOG_VERBOSE, "Sorting population with %d members.", pop->size);
 
-#ifdef GA_QSORT_TIME
-  timer_start();
-#endif
-
 #if GA_QSORT_DEBUG>2
   printf("Unsorted:\n");
   for (i=0; i<pop->size; i++)
@@ -244,10 +240,6 @@ void quicksort_population(population *pop)
     }
 #endif
 
-#ifdef GA_QSORT_TIME
-  timer_check();
-#endif
-
   return;
   }
 #endif
@@ -266,9 +258,9 @@ void sort_population(population *pop)
 
   plog(LOG_VERBOSE, "Sorting population with %d members.", pop->size);
 
-#ifdef GA_QSORT_TIME
-  timer_start();
-#endif
+  gaul_profile_start(pop, GA_PHASE_SORT);
+
+  gaul_stats_invalidate(pop);
 
   if (pop->rank == ga_rank_fitness)
     {
@@ -384,16 +376,14 @@ void sort_population(population *pop)
     }
 #endif
 
-#ifdef GA_QSORT_TIME
-  timer_check();
-#endif
+  gaul_profile_stop(pop);
 
   return;
   }
 
 
-/* To test+time these functions, compile with something like:
-   gcc ga_qsort.c -DGA_QSORT_TIME -DGA_QSORT_COMPILE_MAIN ga_core.o \
+/* To test these functions, compile with something like:
+   gcc ga_qsort.c -DGA_QSORT_COMPILE_MAIN ga_core.o \
      -o qsort `gtk-config --cflags` \
      -DNO_TRACE -DMEMORY_ALLOC_DEBUG \
      -DQSORT_DEBUG=3
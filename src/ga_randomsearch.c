@@ -63,6 +63,8 @@ GAULFUNC int ga_random_search(	population		*pop,
   if (!pop->evaluate) die("Population's evaluation callback is undefined.");
   if (!pop->seed) die("Population's seed callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_random_search");
+
 /* Prepare working entity. */
   putative = ga_get_free_entity(pop);
 
@@ -82,7 +84,7 @@ GAULFUNC int ga_random_search(	population		*pop,
 /*
  * Ensure that initial solution is scored.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
 
   plog( LOG_VERBOSE,
         "Prior to the first iteration, the current solution has fitness score of %f",
@@ -104,7 +106,7 @@ GAULFUNC int ga_random_search(	population		*pop,
  */
     ga_entity_blank(pop, putative);
     pop->seed(pop, putative);
-    pop->evaluate(pop, putative);
+    gaul_evaluate(pop, putative);
 
 /*
  * Decide whether this new solution should be selected or discarded based
@@ -132,6 +134,8 @@ GAULFUNC int ga_random_search(	population		*pop,
  */
   ga_entity_dereference(pop, putative);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
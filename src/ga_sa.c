@@ -189,6 +189,8 @@ GAULFUNC int ga_sa(	population		*pop,
   if (!pop->mutate) die("Population's mutation callback is undefined.");
   if (!pop->sa_params) die("ga_population_set_sa_params(), or similar, must be used prior to ga_sa().");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_sa");
+
 /* Prepare working entities. */
   putative = ga_get_free_entity(pop);
   best = ga_get_free_entity(pop);
@@ -210,7 +212,7 @@ GAULFUNC int ga_sa(	population		*pop,
 /*
  * Ensure that initial solution is scored.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
 
   plog( LOG_VERBOSE,
         "Prior to the first iteration, the current solution has fitness score of %f",
@@ -248,7 +250,7 @@ GAULFUNC int ga_sa(	population		*pop,
  * Generate and score a new solution.
  */
   pop->mutate(pop, best, putative);
-  pop->evaluate(pop, putative);
+  gaul_evaluate(pop, putative);
 
 /*
  * Use the acceptance criterion to decide whether this new solution should
@@ -287,6 +289,8 @@ GAULFUNC int ga_sa(	population		*pop,
   ga_entity_dereference(pop, best);
   ga_entity_dereference(pop, putative);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -67,17 +67,17 @@
 /**********************************************************************
   gaul_select_stats()
   synopsis:     Determine mean and standard deviation (and some other
-                potentially useful junk) of the fitness scores.
+                potentially useful junk) of the fitness scores of the
+		parents, using the population's cached statistics.
   parameters:	population *pop
   return:	TRUE
-  last updated: 30/04/01
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 static boolean gaul_select_stats( population *pop,
                              double *average, double *stddev, double *sum )
   {
-  int           i;                      /* Loop over all entities. */
-  double        fsum=0.0, fsumsq=0.0;   /* Sum and sum squared. */
+  const ga_stats_t	*stats;		/* Fitness statistics. */
 
 #if 0
 /*
@@ -88,15 +88,11 @@ static boolean gaul_select_stats( population *pop,
   if (pop->size < 1) die("Pointer to empty population structure passed.");
 #endif
 
-  for (i=0; i<pop->orig_size; i++)
-    {
-    fsum += pop->entity_iarray[i]->fitness;
-    fsumsq += SQU(pop->entity_iarray[i]->fitness);
-    }
+  stats = gaul_stats_moments(pop, pop->orig_size);
 
-  *sum = fsum;
-  *average = fsum / pop->orig_size;
-  *stddev = (fsumsq - fsum*fsum/pop->orig_size)/pop->orig_size;
+  *sum = stats->sum;
+  *average = stats->sum / pop->orig_size;
+  *stddev = sqrt(stats->m2 / pop->orig_size);
 
   return TRUE;
   }
@@ -104,23 +100,17 @@ static boolean gaul_select_stats( population *pop,
 
 /**********************************************************************
   gaul_select_sum_fitness()
-  synopsis:	Determine sum of entity fitnesses.
+  synopsis:	Determine sum of entity fitnesses, using the
+		population's cached statistics.
   parameters:	population *pop
   return:	double sum
-  last updated: 11 Jun 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 static double gaul_select_sum_fitness( population *pop )
   {
-  int           i;		/* Loop over all entities. */
-  double        sum=0.0;	/* Sum and sum squared. */
 
-  for (i=0; i<pop->orig_size; i++)
-    {
-    sum += pop->entity_iarray[i]->fitness;
-    }
-
-  return sum;
+  return gaul_stats_moments(pop, pop->orig_size)->sum;
   }
 
 
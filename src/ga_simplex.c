@@ -35,6 +35,11 @@
 		You might want to think carefully about your convergence
 		criteria.
 
+		A parallel variant, in which several of the least fit
+		vertices are updated each iteration and the trial
+		points are evaluated concurrently, is enabled with
+		ga_population_set_simplex_parallel().
+
   References:	Press, Flannery, Teukolsky, and Vetterling, 
 		"Numerical Recipes in C:  The Art of Scientific Computing"
 		Cambridge University Press, 2nd edition (1992) pp. 408-412.
@@ -44,6 +49,9 @@
 		Yarbro, L.A., and Deming, S.N. Analytica Chim. Acta,
 		73:391-398 (1974)
 
+		Lee, D., and Wiswall, M. Computational Economics,
+		30:171-187 (2007)
+
   To do:	Make alpha, beta and gamma parameters.
 
  **********************************************************************/
@@ -93,10 +101,599 @@ GAULFUNC void ga_population_set_simplex_parameters( population		*pop,
   pop->simplex_params->beta = 0.75;	/* range: 0=no contraction, 1=full contraction. */
   pop->simplex_params->gamma = 0.25;	/* range: 0=no contraction, 1=full contraction. */
 
+  pop->simplex_params->num_parallel = 1;
+  pop->simplex_params->num_threads = 1;
+  pop->simplex_params->num_simplices = 1;
+
   return;
   }
 
 
+/**********************************************************************
+  ga_population_set_simplex_parallel()
+  synopsis:     Sets the parallel simplex-search parameters for a
+		population.  ga_population_set_simplex_parameters()
+		must have been called first.
+		When num_parallel > 1, each iteration of ga_simplex()
+		and ga_simplex_double() generates trial points for the
+		num_parallel least fit vertices, reflecting each
+		through the centroid of the remaining vertices, and
+		evaluates them together (Lee and Wiswall's parallel
+		Nelder-Mead variant).  Expansions and contractions, and
+		any shrinking of the simplex, are also evaluated
+		together.  These evaluations are spread over upto
+		num_threads threads, so the evaluation callback must be
+		thread-safe if num_threads is not 1.
+		When num_simplices > 1, ga_simplex_double() runs that
+		many independently randomised simplices concurrently,
+		each on its own thread and in its own clone of the
+		population, and returns the best result.
+  parameters:	population *pop		Population to set parameters of.
+		const int num_parallel	Vertices to update per iteration.
+		const int num_threads	Evaluation threads, or 0 to use
+					the GAUL_NUM_THREADS setting.
+		const int num_simplices	Number of concurrent simplices.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_simplex_parallel( population	*pop,
+					const int		num_parallel,
+					const int		num_threads,
+					const int		num_simplices)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->simplex_params ) die("ga_population_set_simplex_parameters() must be called first.");
+  if ( num_parallel < 1 ) die("At least one vertex must be updated per iteration.");
+  if ( num_threads < 0 ) die("Negative number of threads requested.");
+  if ( num_simplices < 1 ) die("At least one simplex is required.");
+
+  plog( LOG_VERBOSE,
+        "Population's parallel simplex-search parameters set: num_parallel = %d num_threads = %d num_simplices = %d",
+        num_parallel, num_threads, num_simplices );
+
+  pop->simplex_params->num_parallel = num_parallel;
+  pop->simplex_params->num_threads = num_threads;
+  pop->simplex_params->num_simplices = num_simplices;
+
+  return;
+  }
+
+
+/*
+ * Converters used when the parallel algorithm is applied directly
+ * to double-array chromosomes.
+ */
+static boolean _simplex_chromosome_to_double(population *pop, entity *joe, double *darray)
+  {
+  memcpy(darray, joe->chromosome[0], pop->len_chromosomes*sizeof(double));
+
+  return TRUE;
+  }
+
+static boolean _simplex_chromosome_from_double(population *pop, entity *joe, double *darray)
+  {
+  memcpy(joe->chromosome[0], darray, pop->len_chromosomes*sizeof(double));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  _simplex_sort()
+  synopsis:	Sort vertices, and their associated double arrays, in
+		order of decreasing fitness.  An insertion sort is used
+		since, after the first iteration, only a few vertices
+		are out of place.
+  parameters:	entity **vertex
+		double **vertex_d
+		const int num_points
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void _simplex_sort(entity **vertex, double **vertex_d, const int num_points)
+  {
+  int		i, j;		/* Loop variables over vertices. */
+  entity	*tmpentity;	/* Vertex being inserted. */
+  double	*tmpdoubleptr;	/* Vertex being inserted. */
+
+  for (i = 1; i < num_points; i++)
+    {
+    tmpentity = vertex[i];
+    tmpdoubleptr = vertex_d[i];
+
+    for (j = i; j > 0 && vertex[j-1]->fitness < tmpentity->fitness; j--)
+      {
+      vertex[j] = vertex[j-1];
+      vertex_d[j] = vertex_d[j-1];
+      }
+
+    vertex[j] = tmpentity;
+    vertex_d[j] = tmpdoubleptr;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  _simplex_parallel()
+  synopsis:	The parallel simplex-search used by ga_simplex() and
+		ga_simplex_double() when num_parallel or num_threads
+		have been set.  See ga_population_set_simplex_parallel().
+		Unlike the serial code, step, alpha, beta and gamma
+		are copied so that restarts do not alter the
+		population's parameters.
+  parameters:	population *pop
+		entity *initial
+		const int max_iterations
+		const boolean use_chromosome	Work on double chromosome
+					directly, ignoring to_double()
+					and from_double().
+  return:	Number of iterations performed.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+/* Actions for each updated vertex. */
+#define SIMPLEX_ACCEPT		0
+#define SIMPLEX_EXPAND		1
+#define SIMPLEX_CONTRACT	2
+
+static int _simplex_parallel(	population		*pop,
+				entity			*initial,
+				const int		max_iterations,
+				const boolean		use_chromosome )
+  {
+  int		iteration=0;		/* Current iteration number. */
+  int		i, j, k;		/* Loop variables. */
+  int		dimensions;		/* Size of double arrays. */
+  int		num_points;		/* Number of vertices. */
+  int		num_parallel;		/* Vertices updated per iteration. */
+  int		num_kept;		/* Vertices defining the centroid. */
+  int		num_threads;		/* Threads for evaluations. */
+  int		num_batch;		/* Number of entities in batch. */
+  GAto_double	to_double;		/* Genome to double array. */
+  GAfrom_double	from_double;		/* Double array to genome. */
+  double	step, alpha, beta, gamma;	/* Local copies of parameters. */
+  entity	**vertex;		/* Simplex vertices. */
+  double	**vertex_d;		/* Vertices as double arrays. */
+  entity	**trial1, **trial2;	/* Reflected, and expanded or contracted, points. */
+  double	**trial1_d, **trial2_d;	/* Trial points as double arrays. */
+  entity	**batch;		/* Entities for concurrent evaluation. */
+  int		*action;		/* Action for each updated vertex. */
+  double	*buffer;		/* Storage for all double arrays. */
+  double	*centroid;		/* Centroid of the retained vertices. */
+  entity	*tmpentity;		/* Used to swap solutions. */
+  double	*tmpdoubleptr;		/* Used to swap solutions. */
+  entity	*chosen;		/* Replacement for a vertex. */
+  boolean	improved;		/* Whether any vertex was improved. */
+  boolean	restart_needed;		/* Whether the search needs restarting. */
+
+  if (use_chromosome)
+    {
+    dimensions = pop->len_chromosomes;
+    to_double = _simplex_chromosome_to_double;
+    from_double = _simplex_chromosome_from_double;
+    }
+  else
+    {
+    dimensions = pop->simplex_params->dimensions;
+    to_double = pop->simplex_params->to_double;
+    from_double = pop->simplex_params->from_double;
+    }
+
+  num_points = dimensions+1;
+  num_parallel = pop->simplex_params->num_parallel;
+  if (num_parallel > dimensions) num_parallel = dimensions;
+  if (num_parallel < 1) num_parallel = 1;
+  num_kept = num_points-num_parallel;
+  num_threads = pop->simplex_params->num_threads;
+
+  step = pop->simplex_params->step;
+  alpha = pop->simplex_params->alpha;
+  beta = pop->simplex_params->beta;
+  gamma = pop->simplex_params->gamma;
+
+/*
+ * Prepare working entities and double arrays.
+ */
+  if ( !(vertex = s_malloc(sizeof(entity *)*(num_points+3*num_parallel))) )
+    die("Unable to allocate memory");
+  trial1 = &(vertex[num_points]);
+  trial2 = &(vertex[num_points+num_parallel]);
+  batch = &(vertex[num_points+2*num_parallel]);
+
+  gaul_trace_begin(GAUL_TRACE_SEARCH, use_chromosome?"ga_simplex_double":"ga_simplex");
+
+  if ( !(vertex_d = s_malloc(sizeof(double *)*(num_points+2*num_parallel))) )
+    die("Unable to allocate memory");
+  trial1_d = &(vertex_d[num_points]);
+  trial2_d = &(vertex_d[num_points+num_parallel]);
+
+  if ( !(buffer = s_malloc(sizeof(double)*dimensions*(num_points+2*num_parallel+1))) )
+    die("Unable to allocate memory");
+  for (i = 0; i < num_points+2*num_parallel; i++)
+    vertex_d[i] = &(buffer[i*dimensions]);
+  centroid = &(buffer[(num_points+2*num_parallel)*dimensions]);
+
+  if ( !(action = s_malloc(sizeof(int)*num_parallel)) )
+    die("Unable to allocate memory");
+
+  for (i = 0; i < num_points+2*num_parallel; i++)
+    vertex[i] = ga_get_free_entity(pop);
+
+/* Do we need to generate a random starting solution? */
+  if (!initial)
+    {
+    plog(LOG_VERBOSE, "Will perform parallel simplex search with random starting solution.");
+
+    ga_entity_seed(pop, vertex[0]);
+    initial = ga_get_free_entity(pop);
+    }
+  else
+    {   
+    plog(LOG_VERBOSE, "Will perform parallel simplex search with specified starting solution.");
+
+    ga_entity_copy(pop, vertex[0], initial);
+    }
+
+/*
+ * Generate and score the initial simplex.
+ */
+  to_double(pop, vertex[0], vertex_d[0]);
+
+  for (i = 1; i < num_points; i++)
+    {
+    for (j = 0; j < dimensions; j++)
+      vertex_d[i][j] = vertex_d[0][j] + random_double_range(-step,step);
+
+    from_double(pop, vertex[i], vertex_d[i]);
+    }
+
+  if (vertex[0]->fitness == GA_MIN_FITNESS)
+    ga_evaluate_entities(pop, vertex, num_points, num_threads);
+  else
+    ga_evaluate_entities(pop, &(vertex[1]), num_points-1, num_threads);
+
+  _simplex_sort(vertex, vertex_d, num_points);
+
+  plog( LOG_VERBOSE,
+        "Prior to the first iteration, the current solution has fitness score of %f",
+         vertex[0]->fitness );
+
+/*
+ * Do all the iterations:
+ *
+ * Stop when (a) max_iterations reached, or
+ *           (b) "pop->iteration_hook" returns FALSE.
+ */
+  while ( (pop->iteration_hook?pop->iteration_hook(iteration, vertex[0]):TRUE) &&
+           iteration<max_iterations )
+    {
+    iteration++;
+
+/*
+ * Centroid of the vertices which will not be updated.
+ */
+    for (j = 0; j < dimensions; j++)
+      {
+      centroid[j] = 0.0;
+      for (i = 0; i < num_kept; i++)
+        centroid[j] += vertex_d[i][j];
+      centroid[j] /= num_kept;
+      }
+
+/*
+ * Check for convergence and restart if needed.
+ * Reduce step, alpha, beta and gamma each time this happens.
+ */
+    restart_needed = TRUE;
+    for (j = 0; j < dimensions && restart_needed; j++)
+      {
+      if ( centroid[j]-TINY > vertex_d[num_points-1][j] ||
+           centroid[j]+TINY < vertex_d[num_points-1][j] )
+        restart_needed = FALSE;
+      }
+
+    if (restart_needed != FALSE)
+      {
+      step *= 0.50;
+      alpha *= 0.75;
+      beta *= 0.75;
+      gamma *= 0.75;
+
+      for (i = 1; i < num_points; i++)
+        {
+        for (j = 0; j < dimensions; j++)
+          vertex_d[i][j] = vertex_d[0][j] + random_double_range(-step,step);
+
+        from_double(pop, vertex[i], vertex_d[i]);
+        }
+
+      ga_evaluate_entities(pop, &(vertex[1]), num_points-1, num_threads);
+      _simplex_sort(vertex, vertex_d, num_points);
+
+      continue;
+      }
+
+/*
+ * Reflect each of the least fit vertices through the centroid,
+ * and evaluate all of the reflected points together.
+ */
+    for (k = 0; k < num_parallel; k++)
+      {
+      i = num_kept+k;
+
+      for (j = 0; j < dimensions; j++)
+        trial1_d[k][j] = (1.0 + alpha) * centroid[j] - alpha * vertex_d[i][j];
+
+      from_double(pop, trial1[k], trial1_d[k]);
+      }
+
+    ga_evaluate_entities(pop, trial1, num_parallel, num_threads);
+
+/*
+ * Decide upon the follow-up for each reflected point, and
+ * evaluate all of the expansions and contractions together.
+ */
+    num_batch = 0;
+
+    for (k = 0; k < num_parallel; k++)
+      {
+      i = num_kept+k;
+
+      if (trial1[k]->fitness > vertex[0]->fitness)
+        {	/* Fitter than the fittest, so try extrapolating further. */
+        action[k] = SIMPLEX_EXPAND;
+
+        for (j = 0; j < dimensions; j++)
+          trial2_d[k][j] = (1.0 + alpha) * trial1_d[k][j] - alpha * vertex_d[i][j];
+        }
+      else if (trial1[k]->fitness > vertex[num_kept-1]->fitness)
+        {	/* Fitter than all remaining vertices, so accept. */
+        action[k] = SIMPLEX_ACCEPT;
+        }
+      else
+        {	/* Contract away from the lesser of the vertex and its reflection. */
+        action[k] = SIMPLEX_CONTRACT;
+
+        tmpdoubleptr = trial1[k]->fitness > vertex[i]->fitness ? trial1_d[k] : vertex_d[i];
+
+        for (j = 0; j < dimensions; j++)
+          trial2_d[k][j] = (1.0 - beta) * centroid[j] + beta * tmpdoubleptr[j];
+        }
+
+      if (action[k] != SIMPLEX_ACCEPT)
+        {
+        from_double(pop, trial2[k], trial2_d[k]);
+        batch[num_batch++] = trial2[k];
+        }
+      }
+
+    ga_evaluate_entities(pop, batch, num_batch, num_threads);
+
+/*
+ * Update the vertices.
+ */
+    improved = FALSE;
+
+    for (k = 0; k < num_parallel; k++)
+      {
+      i = num_kept+k;
+      chosen = NULL;
+
+      switch (action[k])
+        {
+        case SIMPLEX_EXPAND:
+          chosen = trial2[k]->fitness > trial1[k]->fitness ? trial2[k] : trial1[k];
+          break;
+        case SIMPLEX_ACCEPT:
+          chosen = trial1[k];
+          break;
+        case SIMPLEX_CONTRACT:
+          if (trial2[k]->fitness > vertex[i]->fitness && trial2[k]->fitness > trial1[k]->fitness)
+            chosen = trial2[k];
+          else if (trial1[k]->fitness > vertex[i]->fitness)
+            chosen = trial1[k];
+          break;
+        }
+
+      if (chosen == trial1[k])
+        {
+        tmpentity = vertex[i]; vertex[i] = trial1[k]; trial1[k] = tmpentity;
+        tmpdoubleptr = vertex_d[i]; vertex_d[i] = trial1_d[k]; trial1_d[k] = tmpdoubleptr;
+        improved = TRUE;
+        }
+      else if (chosen == trial2[k])
+        {
+        tmpentity = vertex[i]; vertex[i] = trial2[k]; trial2[k] = tmpentity;
+        tmpdoubleptr = vertex_d[i]; vertex_d[i] = trial2_d[k]; trial2_d[k] = tmpdoubleptr;
+        improved = TRUE;
+        }
+      }
+
+/*
+ * If no vertex was improved, contract the whole simplex toward
+ * the centroid, evaluating all of the new vertices together.
+ */
+    if (improved == FALSE)
+      {
+      for (i = 1; i < num_points; i++)
+        {
+        for (j = 0; j < dimensions; j++)
+          vertex_d[i][j] = centroid[j] + gamma * (vertex_d[i][j] - centroid[j]);
+
+        from_double(pop, vertex[i], vertex_d[i]);
+        }
+
+      ga_evaluate_entities(pop, &(vertex[1]), num_points-1, num_threads);
+      }
+
+    _simplex_sort(vertex, vertex_d, num_points);
+
+/*
+ * Use the iteration callback.
+ */
+    plog( LOG_VERBOSE,
+          "After iteration %d, the current solution has fitness score of %f",
+          iteration,
+          vertex[0]->fitness );
+
+    }	/* Iteration loop. */
+
+/*
+ * Store best solution.
+ */
+  ga_entity_blank(pop, initial);
+  ga_entity_copy(pop, initial, vertex[0]);
+
+/*
+ * Cleanup.
+ */
+  for (i = 0; i < num_points+2*num_parallel; i++)
+    ga_entity_dereference(pop, vertex[i]);
+
+  s_free(vertex);
+  s_free(vertex_d);
+  s_free(buffer);
+  s_free(action);
+
+  gaul_trace_end();
+
+  return iteration;
+  }
+
+
+/**********************************************************************
+  _simplex_double_multi()
+  synopsis:	Runs several independently randomised simplex searches
+		concurrently for ga_simplex_double().  Each search
+		works in a private clone of the population, starting
+		from a copy of the initial solution, with a private
+		random number stream seeded from the caller's stream.
+  parameters:	population *pop
+		entity *initial
+		const int max_iterations
+  return:	Largest number of iterations performed by a simplex.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+typedef struct
+  {
+  population	*pop;		/* Private clone of population. */
+  entity	*solution;	/* Starting, and then best, solution. */
+  random_state	rstate;		/* Private PRNG stream. */
+  int		max_iterations;
+  int		iterations;	/* Iterations performed. */
+#ifdef HAVE_PTHREADS
+  pthread_t	tid;
+#endif
+  } simplexthread_t;
+
+static void *_simplex_double_thread(void *data)
+  {
+  simplexthread_t	*st = (simplexthread_t *) data;
+  random_state		*old_rstate;	/* Caller's PRNG stream, if any. */
+
+  old_rstate = random_get_thread_state();
+  random_set_thread_state(&(st->rstate));
+
+  st->iterations = ga_simplex_double(st->pop, st->solution, st->max_iterations);
+
+  random_set_thread_state(old_rstate);
+
+  return NULL;
+  }
+
+static int _simplex_double_multi(	population		*pop,
+					entity			*initial,
+					const int		max_iterations )
+  {
+  int			num_simplices = pop->simplex_params->num_simplices;
+  simplexthread_t	*st;		/* Per-simplex data. */
+  entity		*start;		/* Starting solution. */
+  int			best=0;		/* Index of best simplex. */
+  int			iterations=0;	/* Return value. */
+  int			i;		/* Loop over simplices. */
+#ifdef HAVE_PTHREADS
+  int			err;		/* Error code from pthreads. */
+#endif
+
+  if ( !(st = s_malloc(sizeof(simplexthread_t)*num_simplices)) )
+    die("Unable to allocate memory");
+
+  if (initial)
+    {
+    start = initial;
+    }
+  else
+    {
+    start = ga_get_free_entity(pop);
+    ga_entity_seed(pop, start);
+    }
+
+  for (i = 0; i < num_simplices; i++)
+    {
+    st[i].pop = ga_population_clone_empty(pop);
+    st[i].pop->simplex_params->num_simplices = 1;
+    st[i].solution = ga_entity_clone(st[i].pop, start);
+    st[i].max_iterations = max_iterations;
+    st[i].iterations = 0;
+    random_seed_state(&(st[i].rstate), random_rand());
+    }
+
+#ifdef HAVE_PTHREADS
+  for (i = 0; i < num_simplices; i++)
+    {
+    if ( (err = pthread_create(&(st[i].tid), NULL, _simplex_double_thread, (void *)&(st[i]))) != 0 )
+      dief("Error %d in pthread_create. (%s)", err, err==EAGAIN?"EAGAIN":err==ENOMEM?"ENOMEM":"unknown");
+    }
+
+  for (i = 0; i < num_simplices; i++)
+    {
+    if ( (err = pthread_join(st[i].tid, NULL)) != 0 )
+      dief("Error %d in pthread_join. (%s)", err, err==ESRCH?"ESRCH":err==EINVAL?"EINVAL":err==EDEADLK?"EDEADLK":"unknown");
+    }
+#else
+  for (i = 0; i < num_simplices; i++)
+    _simplex_double_thread((void *)&(st[i]));
+#endif
+
+  for (i = 0; i < num_simplices; i++)
+    {
+    if (st[i].solution->fitness > st[best].solution->fitness) best = i;
+    if (st[i].iterations > iterations) iterations = st[i].iterations;
+    }
+
+  plog( LOG_VERBOSE, "Best of %d simplices has fitness score of %f",
+        num_simplices, st[best].solution->fitness );
+
+/*
+ * Store best solution.
+ */
+  ga_entity_blank(pop, start);
+  ga_entity_copy(pop, start, st[best].solution);
+
+/*
+ * Cleanup.  Population data is only owned by the clones if it
+ * was copied.
+ */
+  for (i = 0; i < num_simplices; i++)
+    {
+    if (!pop->population_data_copy) st[i].pop->data = NULL;
+    ga_extinction(st[i].pop);
+    }
+
+  if (!initial) ga_entity_dereference(pop, start);
+
+  s_free(st);
+
+  return iterations;
+  }
+
+
 /**********************************************************************
   ga_simplex()
   synopsis:	Performs optimisation on the passed entity by using a
@@ -142,6 +739,11 @@ GAULFUNC int ga_simplex(	population		*pop,
   if (!pop->simplex_params->to_double) die("Population's genome to double callback is undefined.");
   if (!pop->simplex_params->from_double) die("Population's genome from double callback is undefined.");
 
+  if (pop->simplex_params->num_parallel > 1 || pop->simplex_params->num_threads != 1)
+    return _simplex_parallel(pop, initial, max_iterations, FALSE);
+
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_simplex");
+
 /* 
  * Prepare working entities and double arrays.
  * The space for the average and new arrays are allocated simultaneously.
@@ -200,7 +802,7 @@ GAULFUNC int ga_simplex(	population		*pop,
 #pragma omp single \
    nowait
     pop->simplex_params->to_double(pop, putative[0], putative_d[0]);
-    pop->evaluate(pop, putative[0]);
+    gaul_evaluate(pop, putative[0]);
 
 #pragma omp for \
    schedule(static) nowait
@@ -211,7 +813,7 @@ GAULFUNC int ga_simplex(	population		*pop,
                 random_double_range(-pop->simplex_params->step,pop->simplex_params->step);
 
       pop->simplex_params->from_double(pop, putative[i], putative_d[i]);
-      pop->evaluate(pop, putative[i]);
+      gaul_evaluate(pop, putative[i]);
       }
     }	/* End of parallel block. */
 
@@ -318,7 +920,7 @@ GAULFUNC int ga_simplex(	population		*pop,
                  random_double_range(-pop->simplex_params->step,pop->simplex_params->step);
 
       pop->simplex_params->from_double(pop, putative[i], putative_d[i]);
-      pop->evaluate(pop, putative[i]);
+      gaul_evaluate(pop, putative[i]);
       }
     }
 
@@ -335,7 +937,7 @@ GAULFUNC int ga_simplex(	population		*pop,
  * Evaluate the function at this reflected point.  
  */
     pop->simplex_params->from_double(pop, new1, new1_d);
-    pop->evaluate(pop, new1);
+    gaul_evaluate(pop, new1);
 
     if (new1->fitness > putative[0]->fitness)
       {
@@ -350,7 +952,7 @@ GAULFUNC int ga_simplex(	population		*pop,
                     pop->simplex_params->alpha * putative_d[num_points-1][j];
 
       pop->simplex_params->from_double(pop, new2, new2_d);
-      pop->evaluate(pop, new2);
+      gaul_evaluate(pop, new2);
 
       if (new2->fitness > putative[0]->fitness)
         {
@@ -432,7 +1034,7 @@ GAULFUNC int ga_simplex(	population		*pop,
                    pop->simplex_params->beta * putative_d[num_points-1][j];
 
       pop->simplex_params->from_double(pop, new1, new1_d);
-      pop->evaluate(pop, new1);
+      gaul_evaluate(pop, new1);
 
       if (new1->fitness > putative[pop->simplex_params->dimensions]->fitness)
         {
@@ -478,7 +1080,7 @@ GAULFUNC int ga_simplex(	population		*pop,
                                pop->simplex_params->gamma * (putative_d[i][j] - average[j]);
 
           pop->simplex_params->from_double(pop, putative[i], putative_d[i]);
-          pop->evaluate(pop, putative[i]);
+          gaul_evaluate(pop, putative[i]);
           }
 
 /*
@@ -490,7 +1092,7 @@ GAULFUNC int ga_simplex(	population		*pop,
                                pop->simplex_params->gamma * (putative_d[i][j] - putative_d[0][j]);
 
           pop->simplex_params->from_double(pop, putative[i], putative_d[i]);
-          pop->evaluate(pop, putative[i]);
+          gaul_evaluate(pop, putative[i]);
           }
 */
 
@@ -544,6 +1146,7 @@ GAULFUNC int ga_simplex(	population		*pop,
 /*
  * Store best solution.
  */
+  ga_entity_blank(pop, initial);
   ga_entity_copy(pop, initial, putative[0]);
 
 /*
@@ -561,6 +1164,8 @@ GAULFUNC int ga_simplex(	population		*pop,
   s_free(putative_d);
   s_free(putative_d_buffer);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -608,6 +1213,14 @@ GAULFUNC int ga_simplex_double(	population		*pop,
   if (!pop->evaluate) die("Population's evaluation callback is undefined.");
   if (!pop->simplex_params) die("ga_population_set_simplex_params(), or similar, must be used prior to ga_simplex().");
 
+  if (pop->simplex_params->num_simplices > 1)
+    return _simplex_double_multi(pop, initial, max_iterations);
+
+  if (pop->simplex_params->num_parallel > 1 || pop->simplex_params->num_threads != 1)
+    return _simplex_parallel(pop, initial, max_iterations, TRUE);
+
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_simplex_double");
+
 /* 
  * Prepare working entities and double arrays.
  * The space for the average and new arrays are allocated simultaneously.
@@ -657,7 +1270,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
     {
 #pragma omp single \
    nowait
-    pop->evaluate(pop, putative[0]);
+    gaul_evaluate(pop, putative[0]);
 
 #pragma omp for \
    schedule(static) nowait
@@ -668,7 +1281,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
             = ((double *)putative[0]->chromosome[0])[j] +
               random_double_range(-pop->simplex_params->step,pop->simplex_params->step);
 
-      pop->evaluate(pop, putative[i]);
+      gaul_evaluate(pop, putative[i]);
       }
     }	/* End of parallel block. */
 
@@ -768,7 +1381,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
            = ((double *)putative[0]->chromosome[0])[j] +
               random_double_range(-pop->simplex_params->step,pop->simplex_params->step);
 
-      pop->evaluate(pop, putative[i]);
+      gaul_evaluate(pop, putative[i]);
       }
     }
 
@@ -783,7 +1396,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
 /*
  * Evaluate the function at this reflected point.  
  */
-    pop->evaluate(pop, new1);
+    gaul_evaluate(pop, new1);
 
     if (new1->fitness > putative[0]->fitness)
       {
@@ -798,7 +1411,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
             = (1.0 + pop->simplex_params->alpha) * ((double *)new1->chromosome[0])[j] -
               pop->simplex_params->alpha * ((double *)putative[num_points-1]->chromosome[0])[j];
 
-      pop->evaluate(pop, new2);
+      gaul_evaluate(pop, new2);
 
       if (new2->fitness > putative[0]->fitness)
         {
@@ -868,7 +1481,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
                 = (1.0 - pop->simplex_params->beta) * average[j] +
                   pop->simplex_params->beta * ((double *)putative[num_points-1]->chromosome[0])[j];
 
-      pop->evaluate(pop, new1);
+      gaul_evaluate(pop, new1);
 
       if (new1->fitness > putative[pop->len_chromosomes]->fitness)
         {
@@ -909,7 +1522,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
                   pop->simplex_params->gamma
                     * (((double *)putative[i]->chromosome[0])[j] - average[j]);
 
-          pop->evaluate(pop, putative[i]);
+          gaul_evaluate(pop, putative[i]);
           }
 
 /*
@@ -922,7 +1535,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
                   pop->simplex_params->gamma
                     * (((double *)putative[i]->chromosome[0])[j] - ((double *)putative[0]->chromosome[0])[j]);
 
-          pop->evaluate(pop, putative[i]);
+          gaul_evaluate(pop, putative[i]);
           }
 */
 
@@ -970,6 +1583,7 @@ GAULFUNC int ga_simplex_double(	population		*pop,
 /*
  * Store best solution.
  */
+  ga_entity_blank(pop, initial);
   ga_entity_copy(pop, initial, putative[0]);
 
 /*
@@ -989,6 +1603,8 @@ GAULFUNC int ga_simplex_double(	population		*pop,
   s_free(putative);
   s_free(average);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -27,11 +27,357 @@
 
   Synopsis:     Convenience statistics functions.
 
+		The moments of the fitnesses are found in a single
+		pass, using Welford's updates.  Large populations are
+		divided into fixed-size blocks, which are summarised
+		concurrently and then merged in order, so the results
+		don't depend on the number of threads.  Quantiles,
+		including the median, are exact and are found by
+		selection rather than by sorting.
+
+		The statistics are cached in the population, so the
+		statistics functions, the built-in selection operators
+		and generation hooks share a single pass.  The cache
+		is discarded whenever fitnesses are evaluated or the
+		population is reordered, and whenever a fitness is set
+		through ga_entity_set_fitness().  Code which assigns
+		fitnesses directly should call
+		ga_population_stats_invalidate() afterwards.
+
   To do:	On-line and off-line performance summaries.
 
  **********************************************************************/
 
-#include "gaul.h"
+#include "gaul/ga_core.h"
+
+/*
+ * Entities summarised by each concurrent block.
+ */
+#define GA_STATS_BLOCK	4096
+
+/*
+ * Partial moments of one block.
+ */
+typedef struct
+  {
+  int		n;			/* Number of fitnesses. */
+  double	sum;			/* Sum of fitnesses. */
+  double	mean;			/* Running mean. */
+  double	minimum, maximum;	/* Range of fitnesses. */
+  double	m2, m3, m4;		/* Sums of powers of deviations from the mean. */
+  } gaul_moments_t;
+
+/*
+ * Advanced whenever an entity's fitness is set without reference to
+ * its population, which discards every population's cached
+ * statistics.
+ */
+unsigned int	gaul_fitness_epoch=0;
+
+/**********************************************************************
+  gaul_stats_block()
+  synopsis:	Summarise a block of fitnesses in one pass, updating
+		the central moments after each fitness.
+  parameters:	entity **entities	First entity of block.
+		const int num		Number of entities.
+		gaul_moments_t *moments	Returns the partial moments.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void gaul_stats_block( entity **entities, const int num,
+                              gaul_moments_t *moments )
+  {
+  int		i;			/* Loop over entities. */
+  double	x;			/* Fitness. */
+  double	n, n1;			/* Counts, as doubles. */
+  double	delta, delta_n, delta_n2, term;	/* Update terms. */
+  double	sum=0.0, mean=0.0, m2=0.0, m3=0.0, m4=0.0;
+  double	minimum=entities[0]->fitness, maximum=entities[0]->fitness;
+
+  for (i=0; i<num; i++)
+    {
+    x = entities[i]->fitness;
+    sum += x;
+    if (x < minimum) minimum = x;
+    if (x > maximum) maximum = x;
+
+    n1 = i;
+    n = i+1;
+    delta = x - mean;
+    delta_n = delta / n;
+    delta_n2 = delta_n * delta_n;
+    term = delta * delta_n * n1;
+    mean += delta_n;
+    m4 += term * delta_n2 * (n*n - 3*n + 3) + 6 * delta_n2 * m2 - 4 * delta_n * m3;
+    m3 += term * delta_n * (n - 2) - 3 * delta_n * m2;
+    m2 += term;
+    }
+
+  moments->n = num;
+  moments->sum = sum;
+  moments->mean = mean;
+  moments->minimum = minimum;
+  moments->maximum = maximum;
+  moments->m2 = m2;
+  moments->m3 = m3;
+  moments->m4 = m4;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_stats_merge()
+  synopsis:	Merge the partial moments of a following block into
+		those of the preceding blocks.
+  parameters:	gaul_moments_t *a	Preceding blocks, updated.
+		gaul_moments_t *b	Following block.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void gaul_stats_merge( gaul_moments_t *a, gaul_moments_t *b )
+  {
+  double	na=a->n, nb=b->n, n=na+nb;	/* Counts, as doubles. */
+  double	delta=b->mean-a->mean;	/* Difference of means. */
+  double	delta2=delta*delta;	/* Squared difference. */
+  double	m2, m3, m4;		/* Merged moments. */
+
+  m2 = a->m2 + b->m2 + delta2 * na * nb / n;
+  m3 = a->m3 + b->m3 + delta2 * delta * na * nb * (na - nb) / (n*n)
+     + 3 * delta * (na * b->m2 - nb * a->m2) / n;
+  m4 = a->m4 + b->m4 + delta2 * delta2 * na * nb * (na*na - na*nb + nb*nb) / (n*n*n)
+     + 6 * delta2 * (na*na * b->m2 + nb*nb * a->m2) / (n*n)
+     + 4 * delta * (na * b->m3 - nb * a->m3) / n;
+
+  a->n += b->n;
+  a->sum += b->sum;
+  a->mean += delta * nb / n;
+  a->minimum = MIN(a->minimum, b->minimum);
+  a->maximum = MAX(a->maximum, b->maximum);
+  a->m2 = m2;
+  a->m3 = m3;
+  a->m4 = m4;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_stats_moments()
+  synopsis:	Return the moments of the fitnesses of the 'num' best
+		ranked entities, from the cache if possible.
+  parameters:	population *pop
+		const int num		Number of entities (at least 1).
+  return:	Cached statistics.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+const ga_stats_t *gaul_stats_moments(population *pop, const int num)
+  {
+  ga_stats_t		*stats=&(pop->stats);	/* The cache. */
+  gaul_moments_t	moments;		/* Merged moments. */
+  gaul_moments_t	*partial;		/* Moments of each block. */
+  int			num_blocks;		/* Number of blocks. */
+  int			i;			/* Loop over blocks. */
+  unsigned int		epoch;			/* Fitness epoch summarised. */
+
+  epoch = ATOMIC_LOAD_ACQUIRE(gaul_fitness_epoch);
+  if (stats->num == num && stats->epoch == epoch) return stats;
+
+  num_blocks = (num+GA_STATS_BLOCK-1)/GA_STATS_BLOCK;
+
+  if (num_blocks == 1)
+    {
+    gaul_stats_block(pop->entity_iarray, num, &moments);
+    }
+  else
+    {
+    if ( !(partial = s_malloc(num_blocks*sizeof(gaul_moments_t))) )
+      die("Unable to allocate memory");
+
+#pragma omp parallel for \
+   shared(pop,partial,num_blocks) private(i) \
+   schedule(static)
+    for (i=0; i<num_blocks; i++)
+      gaul_stats_block( &(pop->entity_iarray[i*GA_STATS_BLOCK]),
+                        MIN(GA_STATS_BLOCK, num-i*GA_STATS_BLOCK),
+                        &(partial[i]) );
+
+    moments = partial[0];
+    for (i=1; i<num_blocks; i++)
+      gaul_stats_merge(&moments, &(partial[i]));
+
+    s_free(partial);
+    }
+
+  stats->sum = moments.sum;
+  stats->minimum = moments.minimum;
+  stats->maximum = moments.maximum;
+  stats->m2 = moments.m2;
+  stats->m3 = moments.m3;
+  stats->m4 = moments.m4;
+  stats->copied = FALSE;
+  stats->epoch = epoch;
+  stats->num = num;
+
+  return stats;
+  }
+
+
+/**********************************************************************
+  gaul_stats_select()
+  synopsis:	Partially order an array so that the k-th smallest
+		value is at index k, with no larger values before it
+		and no smaller values after it.
+  parameters:	double *x		Array.
+		const int num		Length of array.
+		const int k		Index to select.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void gaul_stats_select(double *x, const int num, const int k)
+  {
+  int		left=0, right=num-1;	/* Range containing k. */
+  int		i, j;			/* Partition indices. */
+  double	pivot, tmp;		/* Pivot value, swap space. */
+
+  while (right > left)
+    {
+/* Median of three pivot, which also places sentinels at each end. */
+    i = left + (right-left)/2;
+    if (x[i] < x[left]) { tmp = x[i]; x[i] = x[left]; x[left] = tmp; }
+    if (x[right] < x[left]) { tmp = x[right]; x[right] = x[left]; x[left] = tmp; }
+    if (x[right] < x[i]) { tmp = x[right]; x[right] = x[i]; x[i] = tmp; }
+    pivot = x[i];
+
+    i = left;
+    j = right;
+    while (i <= j)
+      {
+      while (x[i] < pivot) i++;
+      while (x[j] > pivot) j--;
+      if (i <= j)
+        {
+        tmp = x[i]; x[i] = x[j]; x[j] = tmp;
+        i++;
+        j--;
+        }
+      }
+
+    if (k <= j)
+      right = j;
+    else if (k >= i)
+      left = i;
+    else
+      return;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_stats_quantile()
+  synopsis:	Determine a quantile of the fitnesses of the 'num'
+		best ranked entities, interpolating linearly between
+		order statistics.
+  parameters:	population *pop
+		const int num		Number of entities (at least 1).
+		const double q		Quantile, 0 to 1.
+  return:	Quantile.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static double gaul_stats_quantile(population *pop, const int num, const double q)
+  {
+  ga_stats_t	*stats=&(pop->stats);	/* The cache. */
+  double	h;			/* Fractional index. */
+  double	lower, upper;		/* Bracketing order statistics. */
+  int		k;			/* Lower index. */
+  int		i;			/* Loop over entities. */
+
+  gaul_stats_moments(pop, num);
+
+  if (q <= 0.0) return stats->minimum;
+  if (q >= 1.0) return stats->maximum;
+
+  if (!stats->copied)
+    {
+    if (stats->max_fitness < num)
+      {
+      stats->max_fitness = num;
+      if ( !(stats->fitness = s_realloc(stats->fitness, num*sizeof(double))) )
+        die("Unable to allocate memory");
+      }
+
+    for (i=0; i<num; i++)
+      stats->fitness[i] = pop->entity_iarray[i]->fitness;
+
+    stats->copied = TRUE;
+    }
+
+/*
+ * Previous selections leave the array partially ordered, which only
+ * makes this one quicker.
+ */
+  h = q*(num-1);
+  k = (int) h;
+  gaul_stats_select(stats->fitness, num, k);
+  lower = stats->fitness[k];
+
+  if (k == num-1 || h == k) return lower;
+
+  upper = stats->fitness[k+1];
+  for (i=k+2; i<num; i++)
+    if (stats->fitness[i] < upper) upper = stats->fitness[i];
+
+  return lower + (h-k)*(upper-lower);
+  }
+
+
+/**********************************************************************
+  gaul_stats_free()
+  synopsis:	Free the statistics cache of a population.
+  parameters:	population *pop
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+void gaul_stats_free(population *pop)
+  {
+
+  if (pop->stats.fitness) s_free(pop->stats.fitness);
+  pop->stats.fitness = NULL;
+  pop->stats.max_fitness = 0;
+  pop->stats.num = 0;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_stats_invalidate()
+  synopsis:     Discard cached fitness statistics.  This is only
+		needed after fitnesses have been assigned without
+		using the population's evaluation callback.
+  parameters:	population *pop
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_stats_invalidate( population *pop )
+  {
+
+  if (!pop) die("Null pointer to population structure passed.");
+
+  gaul_stats_invalidate(pop);
+
+  return;
+  }
+
 
 /**********************************************************************
   ga_fitness_mean()
@@ -39,24 +385,17 @@
   parameters:	population *pop		The population to evaluate.
   		double *mean		Returns the mean fitness.
   return:	TRUE on success.
-  last updated: 07 Jul 2004
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 GAULFUNC boolean ga_fitness_mean( population *pop, double *mean )
   {
-  int           i;           /* Loop over all entities. */
-  double        sum=0.0;     /* Sum of fitnesses. */
 
   if (!pop) die("Null pointer to population structure passed.");
   if (pop->size < 1) die("Pointer to empty population structure passed.");
   if (!mean) die("Null pointer to double passed.");
 
-  for (i=0; i<pop->size; i++)
-    {
-    sum += pop->entity_iarray[i]->fitness;
-    }
-
-  *mean = sum / pop->size;
+  *mean = gaul_stats_moments(pop, pop->size)->sum / pop->size;
 
   return TRUE;
   }
@@ -70,34 +409,22 @@ GAULFUNC boolean ga_fitness_mean( population *pop, double *mean )
   		double *mean		Returns the mean fitness.
 		double *stddev		Returns the standard deviation of the fitnesses.
   return:	TRUE on success.
-  last updated: 07 Jul 2004
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 GAULFUNC boolean ga_fitness_mean_stddev( population *pop,
                              double *mean, double *stddev )
   {
-  int           i;                      /* Loop over all entities. */
-  double        sum=0.0, sumsq=0.0;     /* Sum and sum squared. */
-  double	deviation;		/* Distance to mean. */
+  const ga_stats_t	*stats;		/* Fitness statistics. */
 
   if (!pop) die("Null pointer to population structure passed.");
   if (pop->size < 1) die("Pointer to empty population structure passed.");
   if (!stddev || !mean) die("Null pointer to double passed.");
 
-  for (i=0; i<pop->size; i++)
-    {
-    sum += pop->entity_iarray[i]->fitness;
-    }
-
-  *mean = sum / pop->size;
-
-  for (i=0; i<pop->size; i++)
-    {
-    deviation = pop->entity_iarray[i]->fitness - *mean;
-    sumsq += deviation*deviation;
-    }
+  stats = gaul_stats_moments(pop, pop->size);
 
-  *stddev = sqrt(sumsq/pop->size);
+  *mean = stats->sum / pop->size;
+  *stddev = sqrt(stats->m2/pop->size);
 
   return TRUE;
   }
@@ -106,15 +433,18 @@ GAULFUNC boolean ga_fitness_mean_stddev( population *pop,
 /**********************************************************************
   ga_fitness_stats()
   synopsis:     Determine some stats about the fitness scores.
+		Skew and kurtosis are zero if all fitnesses are equal.
   parameters:	population *pop		The population to evaluate.
+		double *maximum		Returns the maximum fitness.
+		double *minimum		Returns the minimum fitness.
   		double *mean		Returns the average fitness.
-  		double *median		Returns the median fitness.
+  		double *median		Returns the median fitness, or NULL.
 		double *variance	Returns the variance of the fitnesses.
 		double *stddev		Returns the standard deviation of the fitnesses.
 		double *kurtosis	Returns the kurtosis of the fitnesses.
 		double *skew		Returns the skew of the fitnesses.
   return:	TRUE on success.
-  last updated: 17 Jul 2004
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 GAULFUNC boolean ga_fitness_stats( population *pop,
@@ -123,38 +453,60 @@ GAULFUNC boolean ga_fitness_stats( population *pop,
                           double *variance, double *stddev,
                           double *kurtosis, double *skew )
   {
-  int           i;                      /* Loop over all entities. */
-  double	sum2=0.0,sum3=0.0,sum4=0.0;	/* Distribution moments (x pop->size). */
-  double	tmp=0.0;		/* Used to save some lookups. */
+  const ga_stats_t	*stats;		/* Fitness statistics. */
 
   if (!pop) die("Null pointer to population structure passed.");
   if (pop->size < 1) die("Pointer to empty population structure passed.");
   if (!maximum || !minimum || !mean || !variance || !stddev || !kurtosis || !skew)
     die("Null pointer to double passed.");
 
-  *minimum = pop->entity_iarray[0]->fitness;
-  *maximum = pop->entity_iarray[pop->size-1]->fitness;
-  *median = *minimum + (*maximum - *minimum)/2;
+  stats = gaul_stats_moments(pop, pop->size);
+
+  *minimum = stats->minimum;
+  *maximum = stats->maximum;
+  *mean = stats->sum / pop->size;
+  *variance = stats->m2 / pop->size;
+  *stddev = sqrt(*variance);
 
-  for (i=0; i<pop->size; i++)
+  if (*variance > 0.0)
     {
-    tmp += pop->entity_iarray[i]->fitness;
+    *skew = (stats->m3/pop->size) / (*variance * *stddev);
+    *kurtosis = (stats->m4/pop->size) / (*variance * *variance);
     }
-
-  *mean = tmp / pop->size;
-
-  for (i=0; i<pop->size; i++)
+  else
     {
-    tmp = pop->entity_iarray[i]->fitness - *mean;
-    sum2 += tmp*tmp;
-    sum3 += tmp*tmp*tmp;	/* I hope my compiler optimises this... */
-    sum4 += tmp*tmp*tmp*tmp;
+    *skew = 0.0;
+    *kurtosis = 0.0;
     }
 
-  *variance = sum2/pop->size;
-  *skew = (sum3/pop->size)/pow(*variance,3.0/2.0);
-  *kurtosis = (sum4/pop->size)/(*variance * *variance);
-  *stddev = sqrt(*variance);
+  if (median) *median = gaul_stats_quantile(pop, pop->size, 0.5);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  ga_fitness_quantile()
+  synopsis:     Determine a quantile of the fitness scores, by linear
+		interpolation between the nearest ranks.  0 gives the
+		minimum, 0.5 the median and 1 the maximum.
+  parameters:	population *pop		The population to evaluate.
+		const double q		Quantile, from 0 to 1.
+		double *quantile	Returns the quantile.
+  return:	TRUE on success.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_fitness_quantile( population *pop,
+                          const double q, double *quantile )
+  {
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (pop->size < 1) die("Pointer to empty population structure passed.");
+  if (!quantile) die("Null pointer to double passed.");
+  if (q < 0.0 || q > 1.0) die("Quantile must be between 0 and 1.");
+
+  *quantile = gaul_stats_quantile(pop, pop->size, q);
 
   return TRUE;
   }
@@ -28,6 +28,13 @@
   Synopsis:     A systematic search algorithm for comparison and local
 		search.
 
+		ga_search_parallel() splits a range of enumeration
+		indices into contiguous chunks which are claimed
+		dynamically by worker threads.  The position reached is
+		periodically written to a checkpoint file, so that an
+		interrupted search may be resumed.  Independent
+		processes may search disjoint ranges.
+
  **********************************************************************/
 
 #include "gaul/ga_systematicsearch.h"
@@ -52,10 +59,18 @@ GAULFUNC void ga_population_set_search_parameters( population              *pop,
     if ( !(pop->search_params = s_malloc(sizeof(ga_search_t))) )
       die("Unable to allocate memory");
     }
+  else if (pop->search_params->checkpoint_fname)
+    {
+    s_free(pop->search_params->checkpoint_fname);
+    }
 
   pop->search_params->scan_chromosome = scan_chromosome;
   pop->search_params->chromosome_state = 0;
   pop->search_params->allele_state = 0;
+  pop->search_params->num_threads = 0;
+  pop->search_params->chunk_size = 1024;
+  pop->search_params->checkpoint_fname = NULL;
+  pop->search_params->checkpoint_interval = 60;
 
   return;
   }
@@ -89,6 +104,8 @@ GAULFUNC int ga_search(	population		*pop,
   if (!pop->search_params) die("ga_population_set_search_params(), or similar, must be used prior to ga_search().");
   if (!pop->search_params->scan_chromosome) die("Population's chromosome scan callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_search");
+
 /* Prepare working entity. */
   putative = ga_get_free_entity(pop);
 
@@ -104,7 +121,7 @@ GAULFUNC int ga_search(	population		*pop,
 /*
  * Ensure that initial solution is scored.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
 
 /*
  * Prepare internal data for the enumeration algorithm.
@@ -128,7 +145,7 @@ GAULFUNC int ga_search(	population		*pop,
  */
     ga_entity_blank(pop, putative);
     finished = pop->search_params->scan_chromosome(pop, putative, enumeration);
-    pop->evaluate(pop, putative);
+    gaul_evaluate(pop, putative);
 
 /*
  * Decide whether this new solution should be selected or discarded based
@@ -156,7 +173,532 @@ GAULFUNC int ga_search(	population		*pop,
  */
   ga_entity_dereference(pop, putative);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
 
+
+/**********************************************************************
+  ga_population_set_search_parallel()
+  synopsis:     Sets the parameters for ga_search_parallel().
+		ga_population_set_search_parameters() must have been
+		called first, which sets the defaults of the
+		GAUL_NUM_THREADS number of threads, chunks of 1024
+		enumerations and no checkpointing.
+  parameters:	population *pop
+		const int num_threads	Number of worker threads, or 0 to
+					use the GAUL_NUM_THREADS setting.
+		const int chunk_size	Number of enumerations claimed
+					by a worker at a time.
+		const char *checkpoint_fname	Checkpoint file, or NULL.
+		const int checkpoint_interval	Minimum number of seconds
+					between checkpoints.  0 writes a
+					checkpoint after every chunk.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_set_search_parallel( population	*pop,
+                                        const int	num_threads,
+                                        const int	chunk_size,
+                                        const char	*checkpoint_fname,
+                                        const int	checkpoint_interval)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+  if ( !pop->search_params ) die("ga_population_set_search_parameters() must be called first.");
+  if ( num_threads < 0 ) die("Negative number of threads requested.");
+  if ( chunk_size < 1 ) die("Chunk size must be at least 1.");
+  if ( checkpoint_interval < 0 ) die("Negative checkpoint interval.");
+
+  plog( LOG_VERBOSE,
+        "Population's parallel search parameters set: num_threads = %d chunk_size = %d checkpoint = \"%s\" every %d s",
+        num_threads, chunk_size, checkpoint_fname?checkpoint_fname:"(none)", checkpoint_interval );
+
+  pop->search_params->num_threads = num_threads;
+  pop->search_params->chunk_size = chunk_size;
+  if (pop->search_params->checkpoint_fname)
+    s_free(pop->search_params->checkpoint_fname);
+  pop->search_params->checkpoint_fname = checkpoint_fname?s_strdup(checkpoint_fname):NULL;
+  pop->search_params->checkpoint_interval = checkpoint_interval;
+
+  return;
+  }
+
+
+/*
+ * Checkpoint file header.
+ */
+#define SEARCH_CHECKPOINT_HEADER	"GAUL systematic search checkpoint 1"
+
+/*
+ * State shared by the ga_search_parallel() workers.
+ */
+typedef struct
+  {
+  population	*pop;
+  int		first, last;	/* Enumeration range. */
+  int		next;		/* Next unclaimed enumeration. */
+  int		*in_progress;	/* Chunk start for each worker, or last. */
+  int		best_index;	/* Best enumeration completed, or -1. */
+  double	best_fitness;	/* Its fitness. */
+  int		num_evaluated;	/* Enumerations evaluated by this call. */
+  boolean	finished;	/* Scan callback reported the end. */
+  boolean	stop;		/* Iteration hook requested termination. */
+  time_t	last_checkpoint;	/* Time of last checkpoint. */
+  boolean	checkpointing;	/* A worker is writing a checkpoint. */
+  THREAD_LOCK_DECLARE(lock);	/* Guards all of the above. */
+  THREAD_LOCK_DECLARE(hook_lock);	/* Serialises the iteration hook. */
+  } search_shared_t;
+
+typedef struct
+  {
+  search_shared_t	*shared;
+  int		id;		/* Worker number. */
+  entity	*putative;	/* Working solution. */
+  entity	*best;		/* Best solution found by this worker. */
+  int		best_index;	/* Its enumeration, or -1. */
+  } search_worker_t;
+
+
+/**********************************************************************
+  _search_cursor()
+  synopsis:	Every enumeration below the cursor has been evaluated.
+		Must be called with the lock held.
+  parameters:	search_shared_t *shared
+		const int num_workers
+  return:	Cursor position.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static int _search_cursor(search_shared_t *shared, const int num_workers)
+  {
+  int	cursor = shared->next;	/* Lowest unfinished enumeration. */
+  int	i;			/* Loop over workers. */
+
+  for (i=0; i<num_workers; i++)
+    if (shared->in_progress[i] < cursor) cursor = shared->in_progress[i];
+
+  return cursor;
+  }
+
+
+/**********************************************************************
+  _search_write_checkpoint()
+  synopsis:	Write the search cursor and best enumeration found.
+		The file is written under a temporary name and then
+		renamed, so that an interruption never leaves a
+		truncated checkpoint.  Should be called without the
+		lock held, by one thread at a time.
+  parameters:	search_shared_t *shared
+		const int cursor
+		const int best_index
+		const double best_fitness
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void _search_write_checkpoint( search_shared_t *shared,
+                                      const int cursor,
+                                      const int best_index,
+                                      const double best_fitness )
+  {
+  const char	*fname = shared->pop->search_params->checkpoint_fname;
+  char		*tmpname;		/* Temporary file name. */
+  FILE		*fp;			/* Checkpoint file. */
+
+  if ( !(tmpname = s_malloc(strlen(fname)+5)) )
+    die("Unable to allocate memory");
+  sprintf(tmpname, "%s.tmp", fname);
+
+  if ( !(fp=fopen(tmpname, "w")) )
+    dief("Unable to open checkpoint file \"%s\" for output.", tmpname);
+
+  fprintf(fp, "%s\n%d %d %d %d %.17g\n", SEARCH_CHECKPOINT_HEADER,
+          shared->first, shared->last, cursor,
+          best_index, best_fitness);
+
+  if ( fclose(fp) != 0 )
+    dief("Error writing checkpoint file \"%s\".", tmpname);
+
+  if ( rename(tmpname, fname) != 0 )
+    dief("Unable to rename checkpoint file \"%s\" to \"%s\".", tmpname, fname);
+
+  s_free(tmpname);
+
+  return;
+  }
+
+
+/**********************************************************************
+  _search_read_checkpoint()
+  synopsis:	Restore the search cursor and best enumeration from a
+		checkpoint file, if one exists.
+  parameters:	search_shared_t *shared
+  return:	TRUE if a checkpoint was read.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean _search_read_checkpoint(search_shared_t *shared)
+  {
+  const char	*fname = shared->pop->search_params->checkpoint_fname;
+  FILE		*fp;			/* Checkpoint file. */
+  char		header[64];		/* File header. */
+  int		first, last, cursor, best_index;	/* Stored state. */
+  double	best_fitness;		/* Stored fitness. */
+
+  if ( !(fp=fopen(fname, "r")) ) return FALSE;
+
+  if ( !fgets(header, 64, fp) ||
+       strncmp(header, SEARCH_CHECKPOINT_HEADER, strlen(SEARCH_CHECKPOINT_HEADER)) != 0 ||
+       fscanf(fp, "%d %d %d %d %lf", &first, &last, &cursor, &best_index, &best_fitness) != 5 )
+    {
+    fclose(fp);
+    dief("Invalid checkpoint file \"%s\".", fname);
+    }
+
+  fclose(fp);
+
+  if ( first != shared->first || last != shared->last )
+    dief("Checkpoint file \"%s\" is for enumerations %d to %d, not %d to %d.",
+         fname, first, last, shared->first, shared->last);
+
+  plog( LOG_NORMAL, "Resuming systematic search from enumeration %d.", cursor );
+
+  shared->next = cursor;
+  shared->best_index = best_index;
+  shared->best_fitness = best_fitness;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  _search_worker()
+  synopsis:	Claim and evaluate chunks of enumerations until none
+		remain.  The lock is only held to claim a chunk and to
+		merge its results, not while writing a checkpoint or
+		calling the iteration hook.
+  parameters:	void *data	search_worker_t for this worker.
+  return:	NULL
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void *_search_worker( void *data )
+  {
+  search_worker_t	*self = (search_worker_t *) data;
+  search_shared_t	*shared = self->shared;
+  population		*pop = shared->pop;
+  int			num_workers = pop->search_params->num_threads;
+  int			start, end;	/* Current chunk. */
+  int			enumeration;	/* Current enumeration. */
+  int			cursor;		/* Checkpoint position. */
+  int			best_index;	/* Checkpointed best enumeration. */
+  double		best_fitness;	/* Its fitness. */
+  int			num_evaluated;	/* Enumerations evaluated so far. */
+  boolean		checkpoint;	/* Whether to write a checkpoint. */
+  boolean		finished=FALSE;	/* Scan callback reported the end. */
+  boolean		keep_going;	/* Result of iteration hook. */
+  entity		*tmp;		/* Used to swap entities. */
+
+  while (TRUE)
+    {
+    THREAD_LOCK(shared->lock);
+    if (shared->stop || shared->finished || shared->next >= shared->last)
+      {
+      shared->in_progress[self->id] = shared->last;
+      THREAD_UNLOCK(shared->lock);
+      break;
+      }
+    start = shared->next;
+    end = MIN(start + pop->search_params->chunk_size, shared->last);
+    shared->next = end;
+    shared->in_progress[self->id] = start;
+    THREAD_UNLOCK(shared->lock);
+
+    for (enumeration=start; enumeration<end && !finished; enumeration++)
+      {
+      ga_entity_blank(pop, self->putative);
+      finished = pop->search_params->scan_chromosome(pop, self->putative, enumeration);
+      if ( gaul_evaluate(pop, self->putative) == FALSE )
+        self->putative->fitness = GA_MIN_FITNESS;
+
+/*
+ * Ties are resolved in favour of the lowest enumeration, so the
+ * result does not depend on the number of workers.
+ */
+      if ( self->best_index < 0 || self->putative->fitness > self->best->fitness )
+        {
+        tmp = self->best;
+        self->best = self->putative;
+        self->putative = tmp;
+        self->best_index = enumeration;
+        }
+      }
+
+    THREAD_LOCK(shared->lock);
+    shared->num_evaluated += enumeration-start;
+    if (finished)
+      {
+      shared->finished = TRUE;
+      if (enumeration < shared->next) shared->next = enumeration;
+      }
+    shared->in_progress[self->id] = shared->last;
+
+    if ( self->best_index >= 0 &&
+         ( shared->best_index < 0 ||
+           self->best->fitness > shared->best_fitness ||
+           (self->best->fitness == shared->best_fitness && self->best_index < shared->best_index) ) )
+      {
+      shared->best_index = self->best_index;
+      shared->best_fitness = self->best->fitness;
+      }
+
+/*
+ * Only one worker writes a checkpoint at a time, from a snapshot
+ * taken here.
+ */
+    checkpoint = pop->search_params->checkpoint_fname && !shared->checkpointing &&
+         time(NULL) - shared->last_checkpoint >= pop->search_params->checkpoint_interval;
+    if (checkpoint)
+      {
+      shared->checkpointing = TRUE;
+      cursor = _search_cursor(shared, num_workers);
+      best_index = shared->best_index;
+      best_fitness = shared->best_fitness;
+      }
+    num_evaluated = shared->num_evaluated;
+    THREAD_UNLOCK(shared->lock);
+
+    if (checkpoint)
+      {
+      _search_write_checkpoint(shared, cursor, best_index, best_fitness);
+
+      THREAD_LOCK(shared->lock);
+      shared->last_checkpoint = time(NULL);
+      shared->checkpointing = FALSE;
+      THREAD_UNLOCK(shared->lock);
+      }
+
+    if (pop->iteration_hook && self->best_index >= 0)
+      {
+      THREAD_LOCK(shared->hook_lock);
+      keep_going = pop->iteration_hook(num_evaluated, self->best);
+      THREAD_UNLOCK(shared->hook_lock);
+
+      if (!keep_going)
+        {
+        THREAD_LOCK(shared->lock);
+        shared->stop = TRUE;
+        THREAD_UNLOCK(shared->lock);
+        }
+      }
+    }
+
+  return NULL;
+  }
+
+
+/**********************************************************************
+  ga_search_parallel()
+  synopsis:	Performs a systematic search over the enumeration
+		indices first to last-1 using several worker threads.
+		Unlike ga_search(), the scan_chromosome callback is
+		called with every enumeration index in turn and must
+		generate that enumeration directly, rather than
+		incrementing the previous one, since workers claim
+		chunks of indices in any order.  It should return TRUE
+		if the index is the final enumeration.  The scan and
+		evaluation callbacks must be thread-safe when more than
+		one thread is used.  The iteration hook is called after
+		each chunk, by one worker at a time, with the number of
+		enumerations evaluated so far and that worker's best
+		solution, which need not be the best found by all
+		workers so far; returning FALSE stops all workers.
+
+		If a checkpoint file was set by
+		ga_population_set_search_parallel(), it is read at the
+		start, so an interrupted search continues from where it
+		stopped, and it is updated as the search proceeds and
+		at the end.  The best solution found is copied into
+		best, unless that is NULL.
+  parameters:	population *pop
+		entity *best		Returned best solution, or NULL.
+		const int first		First enumeration index.
+		const int last		One past the final index.
+  return:	Number of enumerations evaluated by this call.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_search_parallel( population	*pop,
+                                 entity		*best,
+                                 const int	first,
+                                 const int	last )
+  {
+  search_shared_t	shared;		/* State shared by workers. */
+  search_worker_t	*workers;	/* Per-worker state. */
+  search_worker_t	*winner=NULL;	/* Worker with best solution. */
+  int			num_threads;	/* Number of workers. */
+  int			saved_threads;	/* Requested number of threads. */
+  char			*num_threads_str;	/* Environment value. */
+  int			i;		/* Loop over workers. */
+  entity		*restored=NULL;	/* Best solution from checkpoint. */
+#ifdef HAVE_PTHREADS
+  pthread_t		*tids;		/* Thread ids. */
+  int			err;		/* Error code from pthreads. */
+#endif
+
+/* Checks. */
+  if (!pop) die("NULL pointer to population structure passed.");
+  if (!pop->evaluate) die("Population's evaluation callback is undefined.");
+  if (!pop->search_params) die("ga_population_set_search_params(), or similar, must be used prior to ga_search_parallel().");
+  if (!pop->search_params->scan_chromosome) die("Population's chromosome scan callback is undefined.");
+  if (first < 0 || last < first) die("Invalid enumeration range.");
+
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_search_parallel");
+
+  saved_threads = pop->search_params->num_threads;
+  num_threads = saved_threads;
+  if (num_threads == 0)
+    {
+    num_threads_str = getenv(GA_NUM_THREADS_ENVVAR_STRING);
+    if (num_threads_str) num_threads = atoi(num_threads_str);
+    if (num_threads <= 0) num_threads = GA_DEFAULT_NUM_THREADS;
+    }
+#ifndef HAVE_PTHREADS
+  num_threads = 1;
+#endif
+
+  shared.pop = pop;
+  shared.first = first;
+  shared.last = last;
+  shared.next = first;
+  shared.best_index = -1;
+  shared.best_fitness = GA_MIN_FITNESS;
+  shared.num_evaluated = 0;
+  shared.finished = FALSE;
+  shared.stop = FALSE;
+  shared.last_checkpoint = time(NULL);
+  shared.checkpointing = FALSE;
+  THREAD_LOCK_NEW(shared.lock);
+  THREAD_LOCK_NEW(shared.hook_lock);
+
+  if (pop->search_params->checkpoint_fname)
+    _search_read_checkpoint(&shared);
+
+  plog( LOG_VERBOSE, "Will perform systematic search of enumerations %d to %d with %d threads.",
+        shared.next, last-1, num_threads );
+
+/*
+ * The workers read the number of threads from the parameters, so
+ * the resolved value is stored there for the duration.
+ */
+  pop->search_params->num_threads = num_threads;
+
+  if ( !(workers = s_malloc(sizeof(search_worker_t)*num_threads)) )
+    die("Unable to allocate memory");
+  if ( !(shared.in_progress = s_malloc(sizeof(int)*num_threads)) )
+    die("Unable to allocate memory");
+
+/*
+ * Working entities are allocated here, since ga_get_free_entity()
+ * is not thread-safe.
+ */
+  for (i=0; i<num_threads; i++)
+    {
+    workers[i].shared = &shared;
+    workers[i].id = i;
+    workers[i].putative = ga_get_free_entity(pop);
+    workers[i].best = ga_get_free_entity(pop);
+    workers[i].best_index = -1;
+    shared.in_progress[i] = last;
+    }
+
+#ifdef HAVE_PTHREADS
+  if (num_threads > 1)
+    {
+    if ( !(tids = s_malloc(sizeof(pthread_t)*(num_threads-1))) )
+      die("Unable to allocate memory");
+
+    for (i=1; i<num_threads; i++)
+      {
+      if ( (err = pthread_create(&(tids[i-1]), NULL, _search_worker, (void *)&(workers[i]))) != 0 )
+        dief("Error %d in pthread_create. (%s)", err, err==EAGAIN?"EAGAIN":err==ENOMEM?"ENOMEM":"unknown");
+      }
+
+    _search_worker((void *)&(workers[0]));
+
+    for (i=1; i<num_threads; i++)
+      {
+      if ( (err = pthread_join(tids[i-1], NULL)) != 0 )
+        dief("Error %d in pthread_join. (%s)", err, err==ESRCH?"ESRCH":err==EINVAL?"EINVAL":err==EDEADLK?"EDEADLK":"unknown");
+      }
+
+    s_free(tids);
+    }
+  else
+#endif
+    {
+    _search_worker((void *)&(workers[0]));
+    }
+
+  pop->search_params->num_threads = saved_threads;
+
+/*
+ * Final checkpoint.  A stopped search records the position
+ * reached, otherwise the whole range has been covered.
+ */
+  if (pop->search_params->checkpoint_fname)
+    _search_write_checkpoint( &shared,
+                              shared.stop?_search_cursor(&shared, num_threads):shared.next,
+                              shared.best_index, shared.best_fitness );
+
+/*
+ * Identify the best solution.  It may have been found before a
+ * resumed search started, in which case it is regenerated.
+ */
+  for (i=0; i<num_threads; i++)
+    {
+    if (workers[i].best_index == shared.best_index)
+      winner = &(workers[i]);
+    }
+
+  if (best && shared.best_index >= 0)
+    {
+    if (!winner)
+      {
+      restored = ga_get_free_entity(pop);
+      pop->search_params->scan_chromosome(pop, restored, shared.best_index);
+      gaul_evaluate(pop, restored);
+      }
+
+    ga_entity_blank(pop, best);
+    ga_entity_copy(pop, best, winner?winner->best:restored);
+
+    if (restored) ga_entity_dereference(pop, restored);
+    }
+
+  plog( LOG_VERBOSE,
+        "Systematic search evaluated %d enumerations; best is enumeration %d with fitness score of %f",
+        shared.num_evaluated, shared.best_index, shared.best_fitness );
+
+/*
+ * Cleanup.
+ */
+  for (i=0; i<num_threads; i++)
+    {
+    ga_entity_dereference(pop, workers[i].putative);
+    ga_entity_dereference(pop, workers[i].best);
+    }
+
+  s_free(shared.in_progress);
+  s_free(workers);
+  THREAD_LOCK_FREE(shared.lock);
+  THREAD_LOCK_FREE(shared.hook_lock);
+
+  gaul_trace_end();
+
+  return shared.num_evaluated;
+  }
@@ -317,6 +317,8 @@ GAULFUNC int ga_tabu(	population		*pop,
   if (!pop->tabu_params) die("ga_population_set_tabu_params(), or similar, must be used prior to ga_tabu().");
   if (!pop->tabu_params->tabu_accept) die("Population's tabu acceptance callback is undefined.");
 
+  gaul_trace_begin(GAUL_TRACE_SEARCH, "ga_tabu");
+
 /* Prepare working entities. */
   best = ga_get_free_entity(pop);	/* The best solution so far. */
   if ( !(putative = s_malloc(sizeof(entity *)*pop->tabu_params->search_count)) )
@@ -353,7 +355,7 @@ GAULFUNC int ga_tabu(	population		*pop,
 /*
  * Ensure that initial solution is scored.
  */
-  if (best->fitness==GA_MIN_FITNESS) pop->evaluate(pop, best);
+  if (best->fitness==GA_MIN_FITNESS) gaul_evaluate(pop, best);
 
   plog( LOG_VERBOSE,
         "Prior to the first iteration, the current solution has fitness score of %f",
@@ -376,7 +378,7 @@ GAULFUNC int ga_tabu(	population		*pop,
     for (i=0; i<pop->tabu_params->search_count; i++)
       {
       pop->mutate(pop, best, putative[i]);
-      pop->evaluate(pop, putative[i]);
+      gaul_evaluate(pop, putative[i]);
       }
 
 /*
@@ -481,6 +483,8 @@ GAULFUNC int ga_tabu(	population		*pop,
   s_free(putative);
   s_free(tabu_list);
 
+  gaul_trace_end();
+
   return iteration;
   }
 
@@ -0,0 +1,720 @@
+/**********************************************************************
+  ga_telemetry.c
+ **********************************************************************
+
+  ga_telemetry - Streaming per-generation telemetry.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Streaming per-generation telemetry of evolutions.
+
+		Once a telemetry sink has been attached to a population
+		with ga_population_set_telemetry(), one compact record
+		is taken every 'interval' generations (or iterations,
+		for the steady-state algorithm) of any of the
+		evolutionary drivers, just before the generation hook
+		is called.  Each record holds the best, mean and
+		standard deviation of the fitnesses, an estimate of the
+		genotypic diversity, the number of fitness evaluations,
+		the number of stored fitnesses which were reused rather
+		than evaluated, and the wall-clock time spent in each
+		phase since the previous record.  The phase times and
+		evaluation counts are taken from the profiler, which is
+		enabled along with the telemetry if necessary.
+
+		Taking a record costs a single pass over the
+		population, plus a comparison of a few pairs of
+		chromosomes.  Records are queued in a ring buffer and,
+		if pthreads are available, written by a background
+		thread, so the evolution never waits for the disk.  If
+		the writer falls behind, further records are dropped
+		until there is room; the counts and times of a dropped
+		record are carried into the next one that is queued,
+		but fitnesses computed before the dropped record count
+		as reused in the next one.
+
+		Records may be written as CSV with a header line, as a
+		binary stream of ga_telemetry_record structures in host
+		byte order after a short header, which can be read back
+		with ga_telemetry_read(), or as an OpenMetrics text
+		exposition of the latest record, with running totals,
+		which is replaced atomically each time it is refreshed.
+
+ **********************************************************************/
+
+#include "gaul/ga_telemetry.h"
+
+/*
+ * Records queued per sink, which must be a power of two, the
+ * writer's polling interval in milliseconds, and the number of pairs
+ * of entities compared to estimate diversity.
+ */
+#define TELEMETRY_RING_SIZE		1024
+#define TELEMETRY_WRITER_INTERVAL	100
+#define TELEMETRY_DIVERSITY_PAIRS	16
+
+/*
+ * Header of a binary telemetry stream.
+ */
+#define TELEMETRY_MAGIC		"GAULTLM"
+#define TELEMETRY_VERSION	1
+
+typedef struct
+  {
+  char		magic[8];		/* TELEMETRY_MAGIC. */
+  int		version;		/* TELEMETRY_VERSION. */
+  int		num_phases;		/* GA_NUM_PHASES. */
+  int		record_len;		/* sizeof(ga_telemetry_record). */
+  } telemetry_header_t;
+
+/*
+ * A telemetry sink.  Records between tail and head are queued.  Only
+ * the evolving thread advances head, and only the holder of lock
+ * advances tail.
+ */
+struct ga_telemetry_s
+  {
+  char			*fname;		/* Output file. */
+  ga_telemetry_format	format;		/* Output format. */
+  int			interval;	/* Generations between records. */
+  FILE			*fp;		/* Open stream, except for OpenMetrics. */
+  boolean		profiling;	/* Whether the profiler was enabled for telemetry. */
+  double		start;		/* When telemetry was enabled. */
+  unsigned long		evaluations;	/* Profiled evaluations at the last record. */
+  double		phase[GA_NUM_PHASES];	/* Profiled phase times at the last record. */
+  gaulbyte		*bytes;		/* Chromosome copy, for diversity. */
+  unsigned int		max_bytes;	/* Size of bytes. */
+  unsigned long		total_evaluations;	/* Running totals, for OpenMetrics. */
+  unsigned long		total_reused;
+  double		total_phase[GA_NUM_PHASES];
+  unsigned long		head;		/* Records queued. */
+  unsigned long		tail;		/* Records written. */
+  unsigned long		dropped;	/* Records dropped. */
+  ga_telemetry_record	ring[TELEMETRY_RING_SIZE];	/* Queued records. */
+  THREAD_LOCK_DECLARE(lock);		/* Held while writing. */
+#ifdef HAVE_PTHREADS
+  THREAD_LOCK_DECLARE(wake_lock);	/* Protects stop. */
+  pthread_cond_t	wake;		/* Wakes the writer. */
+  boolean		stop;		/* Whether the writer should exit. */
+  boolean		started;	/* Whether the writer is running. */
+  pthread_t		tid;		/* Writer thread. */
+#endif
+  };
+
+/**********************************************************************
+  gaul_telemetry_write_openmetrics()
+  synopsis:	Replace the OpenMetrics file with the latest record.
+		The file is written under a temporary name and then
+		renamed, so readers never see a partial file.
+  parameters:	ga_telemetry_t *telemetry
+		ga_telemetry_record *record	Latest record.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_telemetry_write_openmetrics( ga_telemetry_t *telemetry,
+                                              ga_telemetry_record *record )
+  {
+  char		*tmpname;	/* Temporary file name. */
+  FILE		*fp;		/* Temporary file. */
+  int		i;		/* Loop over phases. */
+
+  if ( !(tmpname = s_malloc(strlen(telemetry->fname)+5)) )
+    die("Unable to allocate memory");
+  sprintf(tmpname, "%s.tmp", telemetry->fname);
+
+  if ( !(fp = fopen(tmpname, "w")) )
+    {
+    plog(LOG_WARNING, "Unable to open telemetry file \"%s\".", tmpname);
+    s_free(tmpname);
+    return;
+    }
+
+  fprintf(fp, "# TYPE gaul_generation gauge\n");
+  fprintf(fp, "# HELP gaul_generation Generation of the latest record.\n");
+  fprintf(fp, "gaul_generation %d\n", record->generation);
+  fprintf(fp, "# TYPE gaul_population_size gauge\n");
+  fprintf(fp, "gaul_population_size %d\n", record->size);
+  fprintf(fp, "# TYPE gaul_elapsed_seconds gauge\n");
+  fprintf(fp, "gaul_elapsed_seconds %.6f\n", record->elapsed);
+  fprintf(fp, "# TYPE gaul_fitness gauge\n");
+  fprintf(fp, "gaul_fitness{statistic=\"best\"} %.17g\n", record->best);
+  fprintf(fp, "gaul_fitness{statistic=\"mean\"} %.17g\n", record->mean);
+  fprintf(fp, "gaul_fitness{statistic=\"stddev\"} %.17g\n", record->stddev);
+  fprintf(fp, "# TYPE gaul_diversity gauge\n");
+  fprintf(fp, "# HELP gaul_diversity Estimated fraction of chromosome bytes which differ between entities.\n");
+  fprintf(fp, "gaul_diversity %.6f\n", record->diversity);
+  fprintf(fp, "# TYPE gaul_evaluations counter\n");
+  fprintf(fp, "gaul_evaluations_total %lu\n", telemetry->total_evaluations);
+  fprintf(fp, "# TYPE gaul_reused_fitnesses counter\n");
+  fprintf(fp, "# HELP gaul_reused_fitnesses Stored fitnesses used without evaluation.\n");
+  fprintf(fp, "gaul_reused_fitnesses_total %lu\n", telemetry->total_reused);
+  fprintf(fp, "# TYPE gaul_phase_seconds counter\n");
+  for (i=0; i<GA_NUM_PHASES; i++)
+    fprintf( fp, "gaul_phase_seconds_total{phase=\"%s\"} %.6f\n",
+             ga_profile_phase_name((ga_phase_type) i), telemetry->total_phase[i] );
+  fprintf(fp, "# TYPE gaul_telemetry_dropped counter\n");
+  fprintf(fp, "gaul_telemetry_dropped_total %lu\n", telemetry->dropped);
+  fprintf(fp, "# EOF\n");
+
+  fclose(fp);
+
+  if (rename(tmpname, telemetry->fname) != 0)
+    plog(LOG_WARNING, "Unable to rename \"%s\" to \"%s\".", tmpname, telemetry->fname);
+
+  s_free(tmpname);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_telemetry_drain()
+  synopsis:	Write all queued records.  The caller must hold the
+		sink's lock.
+  parameters:	ga_telemetry_t *telemetry
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_telemetry_drain(ga_telemetry_t *telemetry)
+  {
+  unsigned long		tail=telemetry->tail;	/* Next record to write. */
+  unsigned long		head;			/* Records queued. */
+  ga_telemetry_record	*record=NULL;		/* Current record. */
+  int			i;			/* Loop over phases. */
+
+  head = ATOMIC_LOAD_ACQUIRE(telemetry->head);
+
+  if (tail == head) return;
+
+  for (; tail != head; tail++)
+    {
+    record = &(telemetry->ring[tail&(TELEMETRY_RING_SIZE-1)]);
+
+    switch (telemetry->format)
+      {
+      case GA_TELEMETRY_CSV:
+        fprintf( telemetry->fp, "%d,%.6f,%d,%.17g,%.17g,%.17g,%.6f,%lu,%lu",
+                 record->generation, record->elapsed, record->size,
+                 record->best, record->mean, record->stddev, record->diversity,
+                 record->evaluations, record->reused );
+        for (i=0; i<GA_NUM_PHASES; i++)
+          fprintf(telemetry->fp, ",%.6f", record->phase[i]);
+        fprintf(telemetry->fp, "\n");
+        break;
+
+      case GA_TELEMETRY_BINARY:
+        if (fwrite(record, sizeof(ga_telemetry_record), 1, telemetry->fp) != 1)
+          plog(LOG_WARNING, "Unable to write to telemetry file \"%s\".", telemetry->fname);
+        break;
+
+      default:
+        telemetry->total_evaluations += record->evaluations;
+        telemetry->total_reused += record->reused;
+        for (i=0; i<GA_NUM_PHASES; i++)
+          telemetry->total_phase[i] += record->phase[i];
+        break;
+      }
+    }
+
+  if (telemetry->format == GA_TELEMETRY_OPENMETRICS)
+    gaul_telemetry_write_openmetrics(telemetry, record);
+  else
+    fflush(telemetry->fp);
+
+  ATOMIC_STORE_RELEASE(telemetry->tail, head);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_telemetry_writer()
+  synopsis:	Background thread which periodically writes queued
+		records.  It is woken early when the ring is half full
+		or the sink is closed.
+  parameters:	void *data	The sink.
+  return:	NULL
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+#ifdef HAVE_PTHREADS
+static void *gaul_telemetry_writer(void *data)
+  {
+  ga_telemetry_t	*telemetry=(ga_telemetry_t *)data;
+  struct timeval	now;		/* Current time. */
+  struct timespec	until;		/* Time to wake up. */
+  boolean		stop=FALSE;	/* Whether to exit. */
+
+  while (!stop)
+    {
+    gettimeofday(&now, NULL);
+    until.tv_sec = now.tv_sec;
+    until.tv_nsec = now.tv_usec*1000L + TELEMETRY_WRITER_INTERVAL*1000000L;
+    if (until.tv_nsec >= 1000000000L)
+      {
+      until.tv_sec++;
+      until.tv_nsec -= 1000000000L;
+      }
+
+    THREAD_LOCK(telemetry->wake_lock);
+    if (!telemetry->stop)
+      pthread_cond_timedwait(&(telemetry->wake), &(telemetry->wake_lock), &until);
+    stop = telemetry->stop;
+    THREAD_UNLOCK(telemetry->wake_lock);
+
+    THREAD_LOCK(telemetry->lock);
+    gaul_telemetry_drain(telemetry);
+    THREAD_UNLOCK(telemetry->lock);
+    }
+
+  return NULL;
+  }
+#endif
+
+
+/**********************************************************************
+  gaul_telemetry_diversity()
+  synopsis:	Estimate the genotypic diversity of a population as
+		the fraction of chromosome bytes which differ between
+		entities, over up to TELEMETRY_DIVERSITY_PAIRS pairs
+		chosen by rank.  No random numbers are used, so that
+		telemetry can't perturb an evolution.
+  parameters:	population *pop
+		ga_telemetry_t *telemetry
+  return:	Diversity estimate, from 0 to 1.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static double gaul_telemetry_diversity(population *pop, ga_telemetry_t *telemetry)
+  {
+  int		num_pairs;		/* Pairs compared. */
+  int		half=pop->size/2;	/* Distance in rank between a pair. */
+  gaulbyte	*bytes;			/* Packed chromosomes. */
+  unsigned int	max_bytes;		/* Buffer size, if allocated. */
+  unsigned int	len, len2;		/* Lengths of packed chromosomes. */
+  unsigned long	differ=0, total=0;	/* Bytes which differ, bytes compared. */
+  unsigned int	k;			/* Loop over bytes. */
+  int		i, a;			/* Loop over pairs, first of pair. */
+
+  if (!pop->chromosome_to_bytes) return 0.0;
+
+  num_pairs = MIN(TELEMETRY_DIVERSITY_PAIRS, half);
+
+  for (i=0; i<num_pairs; i++)
+    {
+    a = i*half/num_pairs;
+
+    max_bytes = 0;
+    len = pop->chromosome_to_bytes(pop, pop->entity_iarray[a], &bytes, &max_bytes);
+    if (len > telemetry->max_bytes)
+      {
+      telemetry->max_bytes = len;
+      if ( !(telemetry->bytes = s_realloc(telemetry->bytes, len)) )
+        die("Unable to allocate memory");
+      }
+    memcpy(telemetry->bytes, bytes, len);
+    if (max_bytes != 0) s_free(bytes);
+
+    max_bytes = 0;
+    len2 = pop->chromosome_to_bytes(pop, pop->entity_iarray[a+half], &bytes, &max_bytes);
+    len = MIN(len, len2);
+    for (k=0; k<len; k++)
+      if (telemetry->bytes[k] != bytes[k]) differ++;
+    total += len;
+    if (max_bytes != 0) s_free(bytes);
+    }
+
+  return total>0 ? (double) differ/total : 0.0;
+  }
+
+
+/**********************************************************************
+  gaul_telemetry_record()
+  synopsis:	Queue a telemetry record for a population.  Only the
+		thread driving the population calls this.
+  parameters:	population *pop
+		const int generation
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_telemetry_record(population *pop, const int generation)
+  {
+  ga_telemetry_t	*telemetry=pop->telemetry;	/* Sink. */
+  ga_telemetry_record	*record;	/* New record. */
+  unsigned long		head=telemetry->head;	/* Records queued. */
+  unsigned long		evaluations;	/* Profiled evaluations. */
+  double		wall;		/* Profiled phase time. */
+  double		fitness, delta;	/* Fitness, difference from mean. */
+  double		sumsq=0.0;	/* Sum of squared differences. */
+  int			num=0;		/* Evaluated entities. */
+  int			i;		/* Loop over entities, phases. */
+
+  if (head - ATOMIC_LOAD_ACQUIRE(telemetry->tail) >= TELEMETRY_RING_SIZE)
+    {	/* The writer has fallen behind. */
+    telemetry->dropped++;
+    pop->epoch++;	/* Fitnesses computed from now on belong to the next interval. */
+    return;
+    }
+
+  record = &(telemetry->ring[head&(TELEMETRY_RING_SIZE-1)]);
+
+  record->generation = generation;
+  record->size = pop->size;
+  record->elapsed = timer_monotonic()-telemetry->start;
+  record->best = GA_MIN_FITNESS;
+  record->mean = 0.0;
+  record->reused = 0;
+
+  for (i=0; i<pop->size; i++)
+    {
+    fitness = pop->entity_iarray[i]->fitness;
+    if (fitness == GA_MIN_FITNESS) continue;
+
+    num++;
+    delta = fitness-record->mean;
+    record->mean += delta/num;
+    sumsq += delta*(fitness-record->mean);
+    if (fitness > record->best) record->best = fitness;
+    if (pop->entity_iarray[i]->epoch != pop->epoch) record->reused++;
+    }
+
+  record->stddev = num>1 ? sqrt(sumsq/(num-1)) : 0.0;
+  record->diversity = gaul_telemetry_diversity(pop, telemetry);
+
+  evaluations = ga_population_profile_get_histogram(pop, NULL);
+  record->evaluations = evaluations>=telemetry->evaluations ? evaluations-telemetry->evaluations : evaluations;
+  telemetry->evaluations = evaluations;
+
+  for (i=0; i<GA_NUM_PHASES; i++)
+    {
+    ga_population_profile_get_phase(pop, (ga_phase_type) i, &wall, NULL, NULL);
+    record->phase[i] = wall>=telemetry->phase[i] ? wall-telemetry->phase[i] : wall;
+    telemetry->phase[i] = wall;
+    }
+
+/*
+ * Fitnesses computed from now on belong to the next interval.
+ */
+  pop->epoch++;
+
+  ATOMIC_STORE_RELEASE(telemetry->head, head+1);
+
+#ifdef HAVE_PTHREADS
+  if (telemetry->started)
+    {
+    if (head+1 - ATOMIC_LOAD_ACQUIRE(telemetry->tail) >= TELEMETRY_RING_SIZE/2)
+      {
+      THREAD_LOCK(telemetry->wake_lock);
+      pthread_cond_signal(&(telemetry->wake));
+      THREAD_UNLOCK(telemetry->wake_lock);
+      }
+    return;
+    }
+#endif
+
+  THREAD_LOCK(telemetry->lock);
+  gaul_telemetry_drain(telemetry);
+  THREAD_UNLOCK(telemetry->lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_generation_hook()
+  synopsis:	Called by every evolutionary driver at the start of
+		each generation or iteration.  Takes a telemetry
+		record, if due, checks any diversity stopping
+		criterion, then calls the population's generation
+		hook.
+  parameters:	population *pop
+		const int generation
+  return:	FALSE if the diversity has fallen too low or the
+		generation hook asks for the evolution to stop,
+		otherwise TRUE.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+boolean gaul_generation_hook(population *pop, const int generation)
+  {
+
+  if (pop->telemetry && generation%pop->telemetry->interval == 0)
+    gaul_telemetry_record(pop, generation);
+
+  if (pop->diversity && gaul_diversity_stop(pop)) return FALSE;
+
+  return pop->generation_hook ? pop->generation_hook(generation, pop) : TRUE;
+  }
+
+
+/**********************************************************************
+  gaul_telemetry_free()
+  synopsis:	Write any queued records and close a population's
+		telemetry sink.  If the profiler was enabled for the
+		telemetry, it is disabled again.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_telemetry_free(population *pop)
+  {
+  ga_telemetry_t	*telemetry=pop->telemetry;	/* Sink. */
+
+  if (!telemetry) return;
+
+#ifdef HAVE_PTHREADS
+  if (telemetry->started)
+    {
+    THREAD_LOCK(telemetry->wake_lock);
+    telemetry->stop = TRUE;
+    pthread_cond_signal(&(telemetry->wake));
+    THREAD_UNLOCK(telemetry->wake_lock);
+
+    if ( pthread_join(telemetry->tid, NULL) != 0 )
+      dief("Error %d in pthread_join. (%s)", errno, errno==ESRCH?"ESRCH":errno==EINVAL?"EINVAL":errno==EDEADLK?"EDEADLK":"unknown");
+    }
+#endif
+
+  gaul_telemetry_drain(telemetry);
+
+  if (telemetry->fp) fclose(telemetry->fp);
+
+  THREAD_LOCK_FREE(telemetry->lock);
+#ifdef HAVE_PTHREADS
+  THREAD_LOCK_FREE(telemetry->wake_lock);
+  pthread_cond_destroy(&(telemetry->wake));
+#endif
+
+  if (telemetry->profiling) ga_population_set_profiling(pop, FALSE);
+
+  if (telemetry->bytes) s_free(telemetry->bytes);
+  s_free(telemetry->fname);
+  s_free(telemetry);
+  pop->telemetry = NULL;
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_set_telemetry()
+  synopsis:	Attach a telemetry sink to a population, replacing any
+		existing sink.  A record is taken every 'interval'
+		generations of any subsequent evolution.  The file is
+		created, or truncated, immediately.  Passing a NULL
+		filename closes the existing sink.  Sinks are also
+		closed by ga_extinction(), and are not inherited by
+		cloned populations.
+  parameters:	population *pop
+		const char *fname	Output file, or NULL.
+		const ga_telemetry_format format
+		const int interval	Generations between records.
+  return:	TRUE on success, FALSE if the file can't be created.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_population_set_telemetry( population *pop,
+                                        const char		*fname,
+                                        const ga_telemetry_format	format,
+                                        const int		interval )
+  {
+  ga_telemetry_t	*telemetry;	/* New sink. */
+  telemetry_header_t	header;		/* Binary stream header. */
+  int			i;		/* Loop over phases. */
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  gaul_telemetry_free(pop);
+
+  if (!fname) return TRUE;
+
+  if ( !(telemetry = s_malloc(sizeof(ga_telemetry_t))) )
+    die("Unable to allocate memory");
+  memset(telemetry, 0, sizeof(ga_telemetry_t));
+
+  telemetry->fname = s_strdup(fname);
+  telemetry->format = format;
+  telemetry->interval = MAX(interval, 1);
+
+  switch (format)
+    {
+    case GA_TELEMETRY_CSV:
+      if ( !(telemetry->fp = fopen(fname, "w")) ) break;
+      fprintf(telemetry->fp, "generation,elapsed,size,best,mean,stddev,diversity,evaluations,reused");
+      for (i=0; i<GA_NUM_PHASES; i++)
+        fprintf(telemetry->fp, ",%s", ga_profile_phase_name((ga_phase_type) i));
+      fprintf(telemetry->fp, "\n");
+      break;
+
+    case GA_TELEMETRY_BINARY:
+      if ( !(telemetry->fp = fopen(fname, "wb")) ) break;
+      memset(&header, 0, sizeof(telemetry_header_t));
+      strcpy(header.magic, TELEMETRY_MAGIC);
+      header.version = TELEMETRY_VERSION;
+      header.num_phases = GA_NUM_PHASES;
+      header.record_len = sizeof(ga_telemetry_record);
+      fwrite(&header, sizeof(telemetry_header_t), 1, telemetry->fp);
+      break;
+
+    case GA_TELEMETRY_OPENMETRICS:
+      if ( !(telemetry->fp = fopen(fname, "w")) ) break;
+      fclose(telemetry->fp);
+      telemetry->fp = NULL;
+      telemetry->profiling = TRUE;	/* Marks success. */
+      break;
+
+    default:
+      die("Unknown telemetry format.");
+    }
+
+  if (!telemetry->fp && !telemetry->profiling)
+    {
+    plog(LOG_WARNING, "Unable to open telemetry file \"%s\".", fname);
+    s_free(telemetry->fname);
+    s_free(telemetry);
+    return FALSE;
+    }
+
+/*
+ * The phase times and evaluation counts come from the profiler.
+ */
+  telemetry->profiling = !pop->profile;
+  if (telemetry->profiling) ga_population_set_profiling(pop, TRUE);
+
+  telemetry->start = timer_monotonic();
+  telemetry->evaluations = ga_population_profile_get_histogram(pop, NULL);
+  for (i=0; i<GA_NUM_PHASES; i++)
+    ga_population_profile_get_phase(pop, (ga_phase_type) i, &(telemetry->phase[i]), NULL, NULL);
+
+  pop->telemetry = telemetry;
+
+  THREAD_LOCK_NEW(telemetry->lock);
+#ifdef HAVE_PTHREADS
+  THREAD_LOCK_NEW(telemetry->wake_lock);
+  pthread_cond_init(&(telemetry->wake), NULL);
+  telemetry->started = pthread_create(&(telemetry->tid), NULL, gaul_telemetry_writer, (void *)telemetry) == 0;
+  if (!telemetry->started)
+    plog(LOG_VERBOSE, "Unable to start telemetry writer; records will be written synchronously.");
+#endif
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  ga_population_telemetry_flush()
+  synopsis:	Write all queued telemetry records now.
+  parameters:	population *pop
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_population_telemetry_flush(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  if (!pop->telemetry) return;
+
+  THREAD_LOCK(pop->telemetry->lock);
+  gaul_telemetry_drain(pop->telemetry);
+  THREAD_UNLOCK(pop->telemetry->lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_population_telemetry_get_dropped()
+  synopsis:	Number of telemetry records dropped because the
+		writer fell behind.
+  parameters:	population *pop
+  return:	Number of records dropped.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC unsigned long ga_population_telemetry_get_dropped(population *pop)
+  {
+
+  if ( !pop ) die("Null pointer to population structure passed.");
+
+  return pop->telemetry ? pop->telemetry->dropped : 0;
+  }
+
+
+/**********************************************************************
+  ga_telemetry_read()
+  synopsis:	Read a binary telemetry stream.  A truncated final
+		record, from a stream which is still being written, is
+		ignored.
+  parameters:	const char *fname
+		ga_telemetry_record **records	Returns an array, which
+						the caller must s_free().
+  return:	Number of records, or -1 if the file can't be read or
+		was written by an incompatible build.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC int ga_telemetry_read( const char *fname, ga_telemetry_record **records )
+  {
+  FILE			*fp;		/* Telemetry stream. */
+  telemetry_header_t	header;		/* Stream header. */
+  int			num=0, max=0;	/* Records read, allocated. */
+
+  if ( !fname ) die("Null pointer to filename passed.");
+  if ( !records ) die("Null pointer to record array passed.");
+
+  *records = NULL;
+
+  if ( !(fp = fopen(fname, "rb")) ) return -1;
+
+  if ( fread(&header, sizeof(telemetry_header_t), 1, fp) != 1 ||
+       strncmp(header.magic, TELEMETRY_MAGIC, 8) != 0 ||
+       header.version != TELEMETRY_VERSION ||
+       header.num_phases != GA_NUM_PHASES ||
+       header.record_len != sizeof(ga_telemetry_record) )
+    {
+    fclose(fp);
+    return -1;
+    }
+
+  while (TRUE)
+    {
+    if (num == max)
+      {
+      max += 256;
+      if ( !(*records = s_realloc(*records, sizeof(ga_telemetry_record)*max)) )
+        die("Unable to allocate memory");
+      }
+
+    if (fread(&((*records)[num]), sizeof(ga_telemetry_record), 1, fp) != 1) break;
+    num++;
+    }
+
+  fclose(fp);
+
+  return num;
+  }
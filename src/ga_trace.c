@@ -0,0 +1,500 @@
+/**********************************************************************
+  ga_trace.c
+ **********************************************************************
+
+  ga_trace - Timeline tracing of evolutions.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Timeline tracing of evolutions and local searches.
+
+		Once enabled with ga_trace_enable(), the start and end
+		of each phase of each generation (as timed by the
+		profiler), each fitness evaluation, each forked process
+		and each local search are recorded, together with the
+		thread responsible.  ga_trace_write() saves these as a
+		trace file in the Chrome JSON format, which may be
+		viewed by chrome://tracing or https://ui.perfetto.dev/
+		to see when each thread was busy.
+
+		Tracing is global, rather than per-population, so that
+		the threads of island models and of multiple local
+		searches appear on a single timeline.  Each thread
+		records into its own buffer, so no locks are taken
+		while tracing.  Buffers are indexed by the thread
+		numbers of the profiler, and so are reused once a
+		thread exits.  Each buffer holds a fixed number of
+		events and later events are dropped, which bounds the
+		memory used.  For long runs, only one event in every
+		'sampling' of each kind need be recorded.
+
+		Forked processes are shown as processes of their own,
+		each spanning the time from fork() until the process
+		was reaped.  Events recorded by forked processes
+		themselves, and by MPI slaves, are lost.
+
+ **********************************************************************/
+
+#include "gaul/ga_trace.h"
+
+/*
+ * Maximum depth of nested events, and maximum number of forked
+ * processes awaited by each thread, which are traced.
+ */
+#define GAUL_TRACE_MAX_DEPTH	16
+#define GAUL_TRACE_MAX_FORKS	64
+
+/*
+ * Event names, following the phase names.
+ */
+static const char *gaul_trace_kind_names[GAUL_TRACE_NUM_KINDS-GA_NUM_PHASES] =
+  { "evaluate", "fork", "search" };
+
+/*
+ * A recorded event.
+ */
+typedef struct
+  {
+  double	start;		/* Start time. */
+  double	duration;	/* Duration. */
+  int		kind;		/* Phase or gaul_trace_kind. */
+  pid_t		process;	/* Forked process, or zero. */
+  const char	*detail;	/* Static string, or NULL. */
+  } gaul_trace_event_t;
+
+/*
+ * An open event.
+ */
+typedef struct
+  {
+  double	start;		/* Start time. */
+  int		kind;		/* Phase or gaul_trace_kind. */
+  boolean	recorded;	/* Whether the event is sampled. */
+  const char	*detail;	/* Static string, or NULL. */
+  } gaul_trace_frame_t;
+
+/*
+ * Per-thread buffer.  Only the owning thread writes to it, publishing
+ * each event by incrementing num_events.
+ */
+typedef struct
+  {
+  int			num_events;		/* Events recorded. */
+  unsigned long		dropped;		/* Events dropped when full. */
+  unsigned long		seen[GAUL_TRACE_NUM_KINDS];	/* Events of each kind, for sampling. */
+  int			depth;			/* Number of open events. */
+  gaul_trace_frame_t	stack[GAUL_TRACE_MAX_DEPTH];	/* Open events. */
+  pid_t			fork_pid[GAUL_TRACE_MAX_FORKS];	/* Forked processes awaited, or zero. */
+  double		fork_start[GAUL_TRACE_MAX_FORKS];	/* When they were forked. */
+  gaul_trace_event_t	event[1];		/* Recorded events. */
+  } gaul_trace_buffer_t;
+
+/*
+ * Global state.
+ */
+static boolean			gaul_trace_enabled=FALSE;
+static int			gaul_trace_max_events=0;
+static int			gaul_trace_sampling=1;
+static double			gaul_trace_start=0.0;
+static gaul_trace_buffer_t	*gaul_trace_buffers[GA_PROFILE_MAX_THREADS];
+
+/**********************************************************************
+  gaul_trace_buffer()
+  synopsis:	Return the calling thread's buffer, allocating it if
+		need be.  Threads which share the final thread number
+		are not traced.
+  parameters:	none
+  return:	Buffer, or NULL.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static gaul_trace_buffer_t *gaul_trace_buffer(void)
+  {
+  gaul_trace_buffer_t	*buffer;	/* Calling thread's buffer. */
+  int			id;		/* Calling thread's number. */
+
+  id = gaul_profile_thread();
+  if (id == GA_PROFILE_MAX_THREADS-1) return NULL;
+
+  if ( (buffer = gaul_trace_buffers[id]) != NULL ) return buffer;
+
+  if ( !(buffer = s_malloc( sizeof(gaul_trace_buffer_t)
+                          + (gaul_trace_max_events-1)*sizeof(gaul_trace_event_t) )) )
+    die("Unable to allocate memory");
+
+  memset(buffer, 0, sizeof(gaul_trace_buffer_t));
+
+  ATOMIC_STORE_RELEASE(gaul_trace_buffers[id], buffer);
+
+  return buffer;
+  }
+
+
+/**********************************************************************
+  gaul_trace_record()
+  synopsis:	Record a completed event, unless the buffer is full.
+  parameters:	gaul_trace_buffer_t *buffer
+		const int kind
+		const char *detail
+		const double start
+		const pid_t process
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+static void gaul_trace_record( gaul_trace_buffer_t *buffer,
+                               const int kind, const char *detail,
+                               const double start, const pid_t process )
+  {
+  gaul_trace_event_t	*event;		/* New event. */
+
+  if (buffer->num_events >= gaul_trace_max_events)
+    {
+    buffer->dropped++;
+    return;
+    }
+
+  event = &(buffer->event[buffer->num_events]);
+  event->start = start;
+  event->duration = timer_monotonic() - start;
+  event->kind = kind;
+  event->process = process;
+  event->detail = detail;
+
+  ATOMIC_STORE_RELEASE(buffer->num_events, buffer->num_events+1);
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_trace_begin()
+  synopsis:	Open an event on the calling thread.  Does nothing
+		unless tracing is enabled.
+  parameters:	const int kind		Phase or gaul_trace_kind.
+		const char *detail	Static string, or NULL.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_trace_begin(const int kind, const char *detail)
+  {
+  gaul_trace_buffer_t	*buffer;	/* Calling thread's buffer. */
+  gaul_trace_frame_t	*frame;		/* New event. */
+
+  if ( !ATOMIC_LOAD_ACQUIRE(gaul_trace_enabled) ) return;
+  if ( !(buffer = gaul_trace_buffer()) ) return;
+
+  if (buffer->depth < GAUL_TRACE_MAX_DEPTH)
+    {
+    frame = &(buffer->stack[buffer->depth]);
+    frame->kind = kind;
+    frame->detail = detail;
+    frame->recorded = buffer->seen[kind]++ % gaul_trace_sampling == 0;
+    if (frame->recorded) frame->start = timer_monotonic();
+    }
+  buffer->depth++;
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_trace_end()
+  synopsis:	Close the calling thread's innermost event.  Does
+		nothing unless tracing is enabled.
+  parameters:	none
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_trace_end(void)
+  {
+  gaul_trace_buffer_t	*buffer;	/* Calling thread's buffer. */
+  gaul_trace_frame_t	*frame;		/* Closed event. */
+
+  if ( !ATOMIC_LOAD_ACQUIRE(gaul_trace_enabled) ) return;
+  if ( !(buffer = gaul_trace_buffer()) || buffer->depth == 0 ) return;
+
+  buffer->depth--;
+
+  if (buffer->depth < GAUL_TRACE_MAX_DEPTH)
+    {
+    frame = &(buffer->stack[buffer->depth]);
+    if (frame->recorded)
+      gaul_trace_record(buffer, frame->kind, frame->detail, frame->start, 0);
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_trace_fork()
+  synopsis:	Note that the calling thread has forked a process.
+		Does nothing unless tracing is enabled.
+  parameters:	const pid_t pid		Forked process.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_trace_fork(const pid_t pid)
+  {
+  gaul_trace_buffer_t	*buffer;	/* Calling thread's buffer. */
+  int			i;		/* Loop over awaited processes. */
+
+  if ( !ATOMIC_LOAD_ACQUIRE(gaul_trace_enabled) || pid <= 0 ) return;
+  if ( !(buffer = gaul_trace_buffer()) ) return;
+
+  if (buffer->seen[GAUL_TRACE_FORK]++ % gaul_trace_sampling != 0) return;
+
+  for (i=0; i<GAUL_TRACE_MAX_FORKS; i++)
+    {
+    if (buffer->fork_pid[i] == 0)
+      {
+      buffer->fork_pid[i] = pid;
+      buffer->fork_start[i] = timer_monotonic();
+      return;
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  gaul_trace_reap()
+  synopsis:	Note that a process forked by the calling thread has
+		been reaped.  Does nothing unless tracing is enabled.
+  parameters:	const pid_t pid		Reaped process.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void gaul_trace_reap(const pid_t pid)
+  {
+  gaul_trace_buffer_t	*buffer;	/* Calling thread's buffer. */
+  int			i;		/* Loop over awaited processes. */
+
+  if ( !ATOMIC_LOAD_ACQUIRE(gaul_trace_enabled) || pid <= 0 ) return;
+  if ( !(buffer = gaul_trace_buffer()) ) return;
+
+  for (i=0; i<GAUL_TRACE_MAX_FORKS; i++)
+    {
+    if (buffer->fork_pid[i] == pid)
+      {
+      buffer->fork_pid[i] = 0;
+      gaul_trace_record(buffer, GAUL_TRACE_FORK, NULL, buffer->fork_start[i], pid);
+      return;
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_trace_enable()
+  synopsis:	Start tracing, discarding any previous trace.  Must not
+		be called while other threads are running evolutions
+		or local searches.
+  parameters:	const int max_events	Events recorded per thread.
+		const int sampling	Record one event in every
+					'sampling' of each kind.
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_trace_enable(const int max_events, const int sampling)
+  {
+
+  if ( max_events < 1 ) die("Invalid maximum number of events.");
+  if ( sampling < 1 ) die("Invalid sampling interval.");
+
+  ga_trace_disable();
+
+  gaul_trace_max_events = max_events;
+  gaul_trace_sampling = sampling;
+  gaul_trace_start = timer_monotonic();
+
+  ATOMIC_STORE_RELEASE(gaul_trace_enabled, TRUE);
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_trace_disable()
+  synopsis:	Stop tracing and discard the trace.  Must not be called
+		while other threads are running evolutions or local
+		searches.
+  parameters:	none
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_trace_disable(void)
+  {
+  int		i;		/* Loop over threads. */
+
+  ATOMIC_STORE_RELEASE(gaul_trace_enabled, FALSE);
+
+  for (i=0; i<GA_PROFILE_MAX_THREADS; i++)
+    {
+    if (gaul_trace_buffers[i])
+      {
+      s_free(gaul_trace_buffers[i]);
+      gaul_trace_buffers[i] = NULL;
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_trace_get_enabled()
+  synopsis:	Whether tracing is enabled.
+  parameters:	none
+  return:	TRUE if tracing is enabled.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_trace_get_enabled(void)
+  {
+  return ATOMIC_LOAD_ACQUIRE(gaul_trace_enabled);
+  }
+
+
+/**********************************************************************
+  ga_trace_get_counts()
+  synopsis:	Retrieve the number of events recorded, and the number
+		dropped because a buffer was full.  Events skipped by
+		sampling are not counted.  Any NULL pointers are
+		ignored.
+  parameters:	unsigned long *recorded
+		unsigned long *dropped
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void ga_trace_get_counts(unsigned long *recorded, unsigned long *dropped)
+  {
+  gaul_trace_buffer_t	*buffer;	/* A thread's buffer. */
+  int			i;		/* Loop over threads. */
+
+  if (recorded) *recorded = 0;
+  if (dropped) *dropped = 0;
+
+  for (i=0; i<GA_PROFILE_MAX_THREADS; i++)
+    {
+    if ( (buffer = ATOMIC_LOAD_ACQUIRE(gaul_trace_buffers[i])) != NULL )
+      {
+      if (recorded) *recorded += ATOMIC_LOAD_ACQUIRE(buffer->num_events);
+      if (dropped) *dropped += buffer->dropped;
+      }
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  ga_trace_write()
+  synopsis:	Write the events recorded so far to a file in the
+		Chrome JSON trace format.  Times are in microseconds
+		since tracing was enabled.  Tracing continues.
+  parameters:	const char *fname
+  return:	TRUE on success.
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+GAULFUNC boolean ga_trace_write(const char *fname)
+  {
+  FILE			*fp;			/* File handle. */
+  gaul_trace_buffer_t	*buffer;		/* A thread's buffer. */
+  gaul_trace_event_t	*event;			/* An event. */
+  int			i, j;			/* Loop over threads, events. */
+  int			num_events;		/* Events in a buffer. */
+  long			pid;			/* This process. */
+  unsigned long		recorded, dropped;	/* Totals. */
+  const char		*name;			/* Event name. */
+
+  if ( !fname ) die("Null pointer to filename passed.");
+
+  if ( !(fp = fopen(fname, "w")) )
+    {
+    plog(LOG_WARNING, "Unable to open trace file \"%s\".", fname);
+    return FALSE;
+    }
+
+  pid = (long) getpid();
+
+  fprintf(fp, "{\"traceEvents\":[\n");
+  fprintf(fp, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":0,\"args\":{\"name\":\"GAUL\"}}", pid);
+
+  for (i=0; i<GA_PROFILE_MAX_THREADS; i++)
+    {
+    if ( !(buffer = ATOMIC_LOAD_ACQUIRE(gaul_trace_buffers[i])) ) continue;
+
+    fprintf( fp, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%ld,\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+             pid, i, i );
+
+    num_events = ATOMIC_LOAD_ACQUIRE(buffer->num_events);
+    for (j=0; j<num_events; j++)
+      {
+      event = &(buffer->event[j]);
+
+      if (event->kind < GA_NUM_PHASES)
+        name = ga_profile_phase_name((ga_phase_type) event->kind);
+      else
+        name = gaul_trace_kind_names[event->kind-GA_NUM_PHASES];
+
+      fprintf( fp, ",\n{\"name\":\"%s\",\"cat\":\"gaul\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,",
+               name, (event->start-gaul_trace_start)*1.0e6, event->duration*1.0e6 );
+
+      if (event->process)
+        fprintf(fp, "\"pid\":%ld,\"tid\":%ld", (long) event->process, (long) event->process);
+      else
+        fprintf(fp, "\"pid\":%ld,\"tid\":%d", pid, i);
+
+      if (event->detail)
+        fprintf(fp, ",\"args\":{\"function\":\"%s\"}", event->detail);
+
+      fprintf(fp, "}");
+      }
+    }
+
+  ga_trace_get_counts(&recorded, &dropped);
+
+  fprintf( fp, "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"sampling\":%d,\"recorded\":%lu,\"dropped\":%lu}}\n",
+           gaul_trace_sampling, recorded, dropped );
+
+  if (fclose(fp) != 0)
+    {
+    plog(LOG_WARNING, "Unable to write trace file \"%s\".", fname);
+    return FALSE;
+    }
+
+  return TRUE;
+  }
+
@@ -730,7 +730,7 @@ GAULFUNC entity *ga_allele_search(	population	*pop,
     ((int *)current->chromosome[chromosomeid])[point] = val;
     ga_entity_clear_data(pop, current, chromosomeid);
 
-    pop->evaluate(pop, current);
+    gaul_evaluate(pop, current);
 
 /*
  * Should we keep this solution?
@@ -765,10 +765,11 @@ GAULFUNC entity *ga_allele_search(	population	*pop,
 
 /**********************************************************************
   ga_population_dump()
-  synopsis:	Dump some statistics about a population.
+  synopsis:	Dump some statistics about a population, including
+		any profiling statistics.
   parameters:	population	*pop
   return:	none
-  last updated:	17 Feb 2005
+  last updated:	17 Oct 2026
  **********************************************************************/
 
 GAULFUNC void ga_population_dump(population	*pop)
@@ -781,6 +782,8 @@ GAULFUNC void ga_population_dump(population	*pop)
   printf("Chromosome length %d count %d\n", pop->len_chromosomes, pop->num_chromosomes);
   printf("Best fitness %f\n", pop->entity_iarray[0]->fitness);
 
+  gaul_profile_dump(pop);
+
   return;
   }
 
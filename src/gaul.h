@@ -53,6 +53,7 @@
 #include "gaul/memory_util.h"        /* Memory handling. */
 #include "gaul/random_util.h"        /* For PRNGs. */
 #include "gaul/table_util.h"         /* Handling unique integer ids. */
+#include "gaul/timer_util.h"         /* Profiling clocks. */
 
 
 /**********************************************************************
@@ -64,6 +65,8 @@
 typedef struct entity_t entity;
 /* The population datatype stores single populations. */
 typedef struct population_t population;
+/* An open GAUL POPULATION 005 file.  (Declared privately in src/ga_io.c) */
+typedef struct ga_population_file_t ga_population_file;
 
 /**********************************************************************
  * Enumerated types, used to define varients of the GA algorithms.
@@ -116,6 +119,91 @@ typedef enum de_crossover_t
   GA_DE_CROSSOVER_EXPONENTIAL = 2
   } ga_de_crossover_type;
 
+typedef enum ga_gradient_difference_t
+  {
+  GA_GRADIENT_DIFFERENCE_UNKNOWN = 0,
+  GA_GRADIENT_DIFFERENCE_FORWARD = 1,
+  GA_GRADIENT_DIFFERENCE_CENTRAL = 2,
+  GA_GRADIENT_DIFFERENCE_RICHARDSON = 3
+  } ga_gradient_difference_type;
+
+/*
+ * Island model migration topologies and policies.
+ */
+typedef enum ga_topology_t
+  {
+  GA_TOPOLOGY_UNKNOWN = 0,
+  GA_TOPOLOGY_RING = 1,
+  GA_TOPOLOGY_BIRING = 2,
+  GA_TOPOLOGY_TORUS = 3,
+  GA_TOPOLOGY_HYPERCUBE = 4,
+  GA_TOPOLOGY_FULL = 5,
+  GA_TOPOLOGY_RANDOM = 6
+  } ga_topology_type;
+
+typedef enum ga_emigration_t
+  {
+  GA_EMIGRATION_UNKNOWN = 0,
+  GA_EMIGRATION_PROBABILISTIC = 1,
+  GA_EMIGRATION_BEST = 2,
+  GA_EMIGRATION_RANDOM = 3
+  } ga_emigration_type;
+
+typedef enum ga_immigration_t
+  {
+  GA_IMMIGRATION_UNKNOWN = 0,
+  GA_IMMIGRATION_ADD = 1,
+  GA_IMMIGRATION_REPLACE_WORST = 2,
+  GA_IMMIGRATION_REPLACE_RANDOM = 3
+  } ga_immigration_type;
+
+/*
+ * Niching modes.
+ */
+typedef enum ga_niche_t
+  {
+  GA_NICHE_NONE = 0,
+  GA_NICHE_SHARING = 1,
+  GA_NICHE_CLEARING = 2,
+  GA_NICHE_RTR = 3
+  } ga_niche_type;
+
+/*
+ * Phases of an evolution which are timed.
+ */
+typedef enum ga_phase_type_t
+  {
+  GA_PHASE_SELECTION=0,
+  GA_PHASE_CROSSOVER,
+  GA_PHASE_MUTATION,
+  GA_PHASE_ADAPTATION,
+  GA_PHASE_EVALUATION,
+  GA_PHASE_SORT,
+  GA_PHASE_SURVIVAL,
+  GA_PHASE_MIGRATION,
+  GA_NUM_PHASES
+  } ga_phase_type;
+
+/*
+ * Number of evaluation threads which are distinguished, and number of
+ * bins in the evaluation latency histogram.  Bin 0 counts evaluations
+ * which took less than a microsecond and bin i counts those which took
+ * between 2^(i-1) and 2^i microseconds.  The final bin also counts
+ * anything longer.
+ */
+#define GA_PROFILE_MAX_THREADS		64
+#define GA_PROFILE_HISTOGRAM_BINS	32
+
+/*
+ * Formats of telemetry streams.
+ */
+typedef enum ga_telemetry_format_t
+  {
+  GA_TELEMETRY_CSV=0,
+  GA_TELEMETRY_BINARY=1,
+  GA_TELEMETRY_OPENMETRICS=2
+  } ga_telemetry_format;
+
 /**********************************************************************
  * Callback function typedefs.
  **********************************************************************/
@@ -197,6 +285,8 @@ typedef int	(*GArank)(population *alphapop, entity *alpha, population *betapop,
  * GAgradient        - Return array of gradients.
  * GAscan_chromosome - Produce next permutation of genome.
  * GAcompare         - Compare two entities and return distance.
+ * GAdiversity       - Measure the diversity of a population.
+ * GAlocal_search    - Any of the built-in local search engines.
  */
 typedef boolean	(*GAtabu_accept)(population *pop, entity *putative, entity *tabu);
 typedef boolean	(*GAsa_accept)(population *pop, entity *current, entity *trial);
@@ -206,6 +296,8 @@ typedef boolean	(*GAfrom_double)(population *pop, entity *entity, double *darray
 typedef double	(*GAgradient)(population *pop, entity *entity, double *darray, double *varray);
 typedef boolean	(*GAscan_chromosome)(population *pop, entity *entity, int enumeration_num);
 typedef double	(*GAcompare)(population *pop, entity *alpha, entity *beta);
+typedef double	(*GAdiversity)(population *pop);
+typedef int	(*GAlocal_search)(population *pop, entity *initial, const int max_iterations);
 
 /**********************************************************************
  * Public prototypes.
@@ -248,6 +340,11 @@ GAULFUNC boolean ga_entity_copy_chromosome(population *pop, entity *dest, entity
 GAULFUNC boolean ga_entity_copy(population *pop, entity *dest, entity *src);
 GAULFUNC entity	*ga_entity_clone(population *pop, entity *parent);
 
+GAULFUNC unsigned int ga_entities_packed_size( population *pop, const int num );
+GAULFUNC unsigned int ga_entities_pack( population *pop, const int num, const int *ranks,
+                                        gaulbyte *buffer, const unsigned int max_bytes );
+GAULFUNC int ga_entities_unpack( population *pop, gaulbyte *buffer, const unsigned int len );
+
 GAULFUNC void ga_population_send_by_mask( population *pop, int dest_node, int num_to_send, boolean *send_mask );
 GAULFUNC void ga_population_send_every( population *pop, int dest_node );
 GAULFUNC void ga_population_append_receive( population *pop, int src_node );
@@ -273,6 +370,14 @@ GAULFUNC void	ga_population_set_mutation(    population            *pop,
 		                       const double          mutation);
 GAULFUNC void	ga_population_set_migration(   population            *pop,
 		                       const double          migration);
+GAULFUNC void	ga_population_set_migration_parameters( population *pop,
+		                       const int             interval,
+		                       const ga_emigration_type emigration,
+		                       const int             num_emigrants,
+		                       const ga_immigration_type immigration);
+GAULFUNC void	ga_population_set_migration_destinations( population *pop,
+		                       const int             num_destinations,
+		                       const int             *destinations);
 GAULFUNC void	ga_population_set_allele_mutation_prob(   population            *pop,
 		                       const double          prob);
 GAULFUNC void	ga_population_set_allele_min_integer(   population            *pop,
@@ -331,6 +436,15 @@ GAULFUNC void	ga_init_openmp( void );
  */
 GAULFUNC boolean ga_population_write(population *pop, char *fname);
 GAULFUNC population *ga_population_read(char *fname);
+GAULFUNC population *ga_population_read_best(char *fname, const int num);
+GAULFUNC ga_population_file *ga_population_file_create(population *pop, char *fname);
+GAULFUNC boolean ga_population_file_append(ga_population_file *file, population *pop, entity *entity);
+GAULFUNC ga_population_file *ga_population_file_open(char *fname);
+GAULFUNC boolean ga_population_file_close(ga_population_file *file);
+GAULFUNC int ga_population_file_get_size(ga_population_file *file);
+GAULFUNC double ga_population_file_get_fitness(ga_population_file *file, const int rank);
+GAULFUNC entity *ga_population_file_get_entity(ga_population_file *file, population *pop, const int rank);
+GAULFUNC population *ga_population_file_get_population(ga_population_file *file, const int num);
 GAULFUNC boolean ga_entity_write(population *pop, entity *entity, char *fname);
 GAULFUNC entity *ga_entity_read(population *pop, char *fname);
 
@@ -601,6 +715,9 @@ GAULFUNC boolean ga_fitness_stats( population *pop,
                           double *mean, double *median,
                           double *variance, double *stddev,
                           double *kurtosis, double *skew );
+GAULFUNC boolean ga_fitness_quantile( population *pop,
+                          const double q, double *quantile );
+GAULFUNC void ga_population_stats_invalidate( population *pop );
 
 /*
  * Functions located in ga_compare.c:
@@ -616,6 +733,13 @@ GAULFUNC double ga_compare_boolean_hamming(population *pop, entity *alpha, entit
 GAULFUNC double ga_compare_boolean_euclidean(population *pop, entity *alpha, entity *beta);
 GAULFUNC double ga_compare_bitstring_hamming(population *pop, entity *alpha, entity *beta);
 GAULFUNC double ga_compare_bitstring_euclidean(population *pop, entity *alpha, entity *beta);
+GAULFUNC boolean ga_compare_matrix( population *pop, GAcompare compare,
+                          double *matrix );
+GAULFUNC boolean ga_compare_matrix_rows( population *pop, GAcompare compare,
+                          const int num_rows, const int *rows,
+                          double *matrix );
+GAULFUNC boolean ga_compare_neighbours( population *pop, GAcompare compare,
+                          const int k, int *neighbours, double *distances );
 
 /*
  * Functions located in ga_rank.c:
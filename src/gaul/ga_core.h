@@ -70,6 +70,26 @@
 #define GA_DEFAULT_NUM_PROCESSES        8
 #endif
 
+/*
+ * Number of times ga_evolution_archipelago_forked() restarts an
+ * island whose process has died.
+ */
+#ifndef GA_MAX_ISLAND_RESTARTS
+#define GA_MAX_ISLAND_RESTARTS		3
+#endif
+
+/*
+ * Batches of entities that the MPI master keeps in flight to each
+ * slave process, and the largest batch it will send.
+ */
+#ifndef GA_MPI_BATCHES_IN_FLIGHT
+#define GA_MPI_BATCHES_IN_FLIGHT	2
+#endif
+
+#ifndef GA_MPI_MAX_BATCH_BYTES
+#define GA_MPI_MAX_BATCH_BYTES		65536
+#endif
+
 /*
  * Specification of number of threads used in
  * multithreaded functions.
@@ -97,12 +117,17 @@
  * Include remainder of this library's headers.
  */
 #include "gaul/ga_bitstring.h"
+#include "gaul/ga_checkpoint.h"
 #include "gaul/ga_chromo.h"
 #include "gaul/ga_climbing.h"
 #include "gaul/ga_de.h"
 #include "gaul/ga_deterministiccrowding.h"
+#include "gaul/ga_diversity.h"
 #include "gaul/ga_gradient.h"
+#include "gaul/ga_multistart.h"
+#include "gaul/ga_niche.h"
 #include "gaul/ga_optim.h"
+#include "gaul/ga_profile.h"
 #include "gaul/ga_qsort.h"
 #include "gaul/ga_randomsearch.h"
 #include "gaul/ga_sa.h"
@@ -110,6 +135,8 @@
 #include "gaul/ga_systematicsearch.h"
 #include "gaul/ga_simplex.h"
 #include "gaul/ga_tabu.h"
+#include "gaul/ga_telemetry.h"
+#include "gaul/ga_trace.h"
 
 /*
  * Compilation constants.
@@ -126,6 +153,7 @@
 #define GA_TAG_ENTITYLEN		102
 #define GA_TAG_ENTITYFITNESS		103
 #define GA_TAG_ENTITYCHROMOSOME		104
+#define GA_TAG_ENTITYBATCH		105
 
 #define GA_TAG_POPSTABLESIZE		201
 #define GA_TAG_POPCROSSOVER		202
@@ -152,6 +180,9 @@ struct entity_t
 
 /* Additional stuff for multiobjective optimisation: */
   double	*fitvector;	/* Fitness vector. */
+
+/* For telemetry: */
+  unsigned int	epoch;		/* Telemetry interval in which the fitness was computed. */
   };
 
 /*
@@ -198,6 +229,9 @@ typedef struct
   double	step;		/* Initial randomisation step (range: >0, 1=unit step randomisation, higher OK.) */
   GAto_double	to_double;	/* Convert chromosome to double array. */
   GAfrom_double	from_double;	/* Convert chromosome from double array. */
+  int		num_parallel;	/* Number of worst vertices updated concurrently (1=classic algorithm.) */
+  int		num_threads;	/* Threads used for concurrent evaluations (0=GAUL_NUM_THREADS.) */
+  int		num_simplices;	/* Number of concurrent, independently restarted, simplices. */
   } ga_simplex_t;
 
 /*
@@ -206,8 +240,56 @@ typedef struct
 typedef struct
   {
   GAcompare	compare;	/* Compare two entities (either genomic or phenomic space). */
+  int		num_threads;	/* Threads used for offspring generation (0=GAUL_NUM_THREADS.) */
   } ga_dc_t;
 
+/*
+ * Genomes of a population packed into contiguous rows for comparison.
+ * Kind is GAUL_COMPARE_CALLBACK, and rows is NULL, when the comparison
+ * function isn't a built-in one.
+ */
+#define GAUL_COMPARE_CALLBACK	0
+#define GAUL_COMPARE_BITS	1
+#define GAUL_COMPARE_CHAR	2
+#define GAUL_COMPARE_INTEGER	3
+#define GAUL_COMPARE_DOUBLE	4
+
+typedef struct
+  {
+  population	*pop;		/* Population compared. */
+  GAcompare	compare;	/* Comparison function. */
+  int		kind;		/* Kind of packed genome. */
+  boolean	euclidean;	/* Euclidean, rather than Hamming, distance. */
+  int		stride;		/* Elements per packed row. */
+  int		tile;		/* Rows per tile. */
+  void		*rows;		/* Packed genomes, in rank order. */
+  } gaul_compare_t;
+
+/*
+ * Niching parameter structure.  The raw fitnesses of entities whose
+ * fitness is adjusted for survival are held, ordered by address, until
+ * they are restored.
+ */
+typedef struct
+  {
+  entity	*entity;	/* Entity with adjusted fitness. */
+  double	fitness;	/* Its raw fitness. */
+  double	adjusted;	/* Its adjusted fitness. */
+  } ga_niche_fitness_t;
+
+typedef struct
+  {
+  ga_niche_type	type;		/* Niching mode. */
+  GAcompare	compare;	/* Compare two entities. */
+  double	radius;		/* Niche radius. */
+  double	alpha;		/* Shape of sharing function. */
+  int		capacity;	/* Entities which keep their fitness in each niche when clearing. */
+  int		num_niches;	/* Niches found in the latest generation. */
+  int		num_raw;	/* Entities with adjusted fitness. */
+  ga_niche_fitness_t	*raw;	/* Their raw fitnesses. */
+  unsigned int	rng;		/* Private random number generator state. */
+  } ga_niche_t;
+
 /*
  * Differential evolution parameter structure.
  */
@@ -230,6 +312,13 @@ typedef struct
   double	step_size;	/* Step size, (or initial step size). */
   double	alpha;		/* Step size scale-down factor. */
   double	beta;		/* Step size scale-up factor. */
+  int		memory;		/* Stored corrections for L-BFGS. */
+  double	wolfe_c1;	/* Sufficient increase constant for line search. */
+  double	wolfe_c2;	/* Curvature constant for line search. */
+  ga_gradient_difference_type	difference_type;	/* Scheme for ga_gradient_finite_difference(). */
+  double	difference_step;	/* Finite difference step, or 0.0 for automatic. */
+  double	*difference_scale;	/* Per-dimension step scaling, or NULL. */
+  int		difference_threads;	/* Threads for finite difference evaluations. */
   GAto_double	to_double;	/* Convert chromosome to double array. */
   GAfrom_double	from_double;	/* Convert chromosome from double array. */
   GAgradient	gradient;	/* Return gradients array. */
@@ -243,8 +332,118 @@ typedef struct
   GAscan_chromosome	scan_chromosome;	/* Allele searching function. */
   int			chromosome_state;	/* Permutation counter. */
   int			allele_state;		/* Permutation counter. */
+  int			num_threads;		/* Worker threads for ga_search_parallel(). */
+  int			chunk_size;		/* Enumerations claimed at a time. */
+  char			*checkpoint_fname;	/* Cursor checkpoint file, or NULL. */
+  int			checkpoint_interval;	/* Seconds between checkpoints. */
   } ga_search_t;
 
+/*
+ * Multi-start local search parameter structure.
+ */
+typedef struct
+  {
+  GAlocal_search	search;			/* Local search engine. */
+  int			num_threads;		/* Number of concurrent searches. */
+  int			max_evaluations;	/* Total evaluation budget, or 0 for unlimited. */
+  double		target_fitness;		/* Stop once this fitness is reached. */
+  } ga_multistart_t;
+
+/*
+ * Island model migration parameter structure.
+ */
+typedef struct
+  {
+  int			interval;		/* Generations between emigrations. */
+  ga_emigration_type	emigration;		/* Emigrant selection policy. */
+  int			num_emigrants;		/* Emigrants per migration, for best-k and random-k. */
+  ga_immigration_type	immigration;		/* Immigrant replacement policy. */
+  int			num_destinations;	/* Number of neighbouring islands. */
+  int			*destinations;		/* Neighbouring islands, or NULL for the ring. */
+  } ga_migration_t;
+
+/*
+ * Checkpointing parameter structure.
+ */
+typedef struct
+  {
+  char			*fname;			/* Checkpoint file. */
+  int			interval;		/* Generations between checkpoints. */
+  int			full_interval;		/* Checkpoints between full snapshots. */
+  int			count;			/* Checkpoints since the last full snapshot. */
+  boolean		resume;			/* Whether the next evolution continues a restored run. */
+  int			num_state;		/* Length of restored engine state. */
+  int			*state;			/* Restored engine state. */
+  vpointer		writer;			/* Background writer (private to ga_checkpoint.c). */
+  } ga_checkpoint_t;
+
+/*
+ * Profiling structures.  Each evaluation thread only updates its own
+ * ga_profile_thread_t.  The phases are only timed by the thread
+ * driving the population.
+ */
+#define GA_PROFILE_MAX_DEPTH	8
+
+typedef struct
+  {
+  unsigned long		evaluations;		/* Evaluations performed. */
+  unsigned long		untimed;		/* Evaluations since the last timed one. */
+  double		latency;		/* Latency of the last timed evaluation. */
+  int			bin;			/* Histogram bin of the last timed evaluation. */
+  double		busy;			/* Seconds spent evaluating. */
+  unsigned long		histogram[GA_PROFILE_HISTOGRAM_BINS];	/* Evaluation latencies. */
+  } ga_profile_thread_t;
+
+typedef struct
+  {
+  double		wall[GA_NUM_PHASES];	/* Exclusive wall-clock seconds. */
+  double		cpu[GA_NUM_PHASES];	/* Exclusive CPU seconds. */
+  unsigned long		calls[GA_NUM_PHASES];	/* Times each phase was entered. */
+  unsigned long		timed[GA_NUM_PHASES];	/* Calls up to the last timed call. */
+  boolean		nests[GA_NUM_PHASES];	/* Whether other phases were entered within each. */
+  double		pending[GA_NUM_PHASES+1];	/* Wall-clock seconds since last CPU sample, including outside any phase. */
+  double		outside;		/* Wall-clock seconds outside any timed phase. */
+  double		start;			/* When profiling was enabled or reset. */
+  double		mark;			/* Last phase boundary. */
+  double		cpu_mark;		/* CPU time at last CPU sample. */
+  double		cpu_sampled;		/* Wall-clock time of last CPU sample. */
+  double		clock_cost;		/* Seconds per read of the wall clock. */
+  unsigned long		iterations;		/* Iterations begun with gaul_profile_iteration_start(). */
+  unsigned long		unsampled;		/* Iterations since the last sampled one. */
+  double		iteration_mark;		/* Start of the last sampled iteration. */
+  double		iteration_latency;	/* Mean duration of the iterations up to it. */
+  boolean		skip;			/* Whether this iteration's phases are only counted. */
+  boolean		sampled;		/* Whether this iteration's phases are all timed. */
+  int			driver;			/* Thread number of the driving thread. */
+  int			depth;			/* Number of nested phases. */
+  ga_phase_type		stack[GA_PROFILE_MAX_DEPTH];	/* Nested phases. */
+  unsigned long		weight[GA_PROFILE_MAX_DEPTH];	/* Calls represented by each, or 0 if untimed. */
+  double		exclusive[GA_PROFILE_MAX_DEPTH];	/* Time in each, excluding nested phases. */
+  ga_profile_thread_t	thread[GA_PROFILE_MAX_THREADS];	/* Evaluation statistics. */
+  } ga_profile_t;
+
+/*
+ * Telemetry sink (private to ga_telemetry.c).
+ */
+typedef struct ga_telemetry_s ga_telemetry_t;
+
+/*
+ * Diversity tracker (private to ga_diversity.c).
+ */
+typedef struct ga_diversity_s ga_diversity_t;
+
+/*
+ * Kinds of traced event.  The phases of ga_phase_type are also traced,
+ * so these follow them.
+ */
+typedef enum gaul_trace_kind_t
+  {
+  GAUL_TRACE_EVALUATE=GA_NUM_PHASES,	/* A single fitness evaluation. */
+  GAUL_TRACE_FORK,			/* A forked process. */
+  GAUL_TRACE_SEARCH,			/* A local search. */
+  GAUL_TRACE_NUM_KINDS
+  } gaul_trace_kind;
+
 /*
  * Probabilistic sampling parameter structure.
  */
@@ -270,6 +469,23 @@ typedef struct
   int		*permutation;		/* Randomly ordered indices. */
   } ga_selectdata_t;
 
+/*
+ * Cached fitness statistics of the 'num' best ranked entities, shared
+ * by the statistics functions and the built-in selection operators.
+ * 'num' is zero when the cache is invalid.
+ */
+typedef struct
+  {
+  int		num;			/* Number of entities summarised. */
+  unsigned int	epoch;			/* gaul_fitness_epoch when summarised. */
+  double	sum;			/* Sum of fitnesses. */
+  double	minimum, maximum;	/* Range of fitnesses. */
+  double	m2, m3, m4;		/* Sums of powers of deviations from the mean. */
+  double	*fitness;		/* Copy of fitnesses, partially ordered by quantile selection. */
+  int		max_fitness;		/* Size of fitness array. */
+  boolean	copied;			/* Whether fitness array is current. */
+  } ga_stats_t;
+
 
 /*
  * Population Structure.
@@ -301,6 +517,7 @@ struct population_t
 
   int		select_state;		/* Available to selection algorithms. */
   ga_selectdata_t	selectdata;	/* State values for built-in selection operators. */
+  ga_stats_t	stats;			/* Cached fitness statistics. */
 
 /*
  * Special parameters for particular built-in GA operators.
@@ -332,10 +549,18 @@ struct population_t
   ga_climbing_t		*climbing_params;	/* Parameters for hill climbing. */
   ga_simplex_t		*simplex_params;	/* Parameters for simplex search. */
   ga_dc_t		*dc_params;		/* Parameters for deterministic crowding. */
+  ga_niche_t		*niche_params;		/* Parameters for niching. */
   ga_de_t		*de_params;		/* Parameters for differential evolution. */
   ga_gradient_t		*gradient_params;	/* Parameters for gradient methods. */
   ga_search_t		*search_params;		/* Parameters for systematic search. */
   ga_sampling_t		*sampling_params;	/* Parameters for probabilistic sampling. */
+  ga_multistart_t	*multistart_params;	/* Parameters for multi-start local search. */
+  ga_migration_t	*migration_params;	/* Parameters for island model migration. */
+  ga_checkpoint_t	*checkpoint_params;	/* Parameters for checkpointing. */
+  ga_profile_t		*profile;		/* Profiling statistics, or NULL. */
+  ga_telemetry_t	*telemetry;		/* Telemetry sink, or NULL. */
+  unsigned int		epoch;			/* Telemetry interval counter. */
+  ga_diversity_t	*diversity;		/* Diversity tracker, or NULL. */
 
 /*
  * The scoring function and the other callbacks are defined here.
@@ -404,9 +629,49 @@ struct population_t
 #define GA_DEFAULT_ALLELE_MUTATION_PROB	0.02
 
 /*
- * A private prototype.
+ * Discard cached fitness statistics.  This may be used from
+ * evaluation threads.
+ */
+#define gaul_stats_invalidate(pop)	ATOMIC_STORE_RELEASE((pop)->stats.num, 0)
+
+/*
+ * Discard the cached fitness statistics of every population.  This
+ * is for changes to an entity's fitness made without reference to the
+ * entity's population.
+ */
+#define gaul_stats_invalidate_all()	ATOMIC_STORE_RELEASE(gaul_fitness_epoch, ATOMIC_LOAD_ACQUIRE(gaul_fitness_epoch)+1)
+
+/*
+ * Private prototypes.
  */
 boolean gaul_population_fill(population *pop, int num);
+boolean gaul_checkpoint_resume(population *pop, const int num_state, int *state);
+void gaul_checkpoint_generation(population *pop, const int num_state, const int *state);
+void gaul_checkpoint_free(population *pop);
+boolean gaul_evaluate(population *pop, entity *this_entity);
+void gaul_profile_start(population *pop, const ga_phase_type phase);
+void gaul_profile_stop(population *pop);
+void gaul_profile_iteration_start(population *pop);
+void gaul_profile_iteration_stop(population *pop);
+void gaul_profile_dump(population *pop);
+int gaul_profile_thread(void);
+boolean gaul_generation_hook(population *pop, const int generation);
+void gaul_telemetry_free(population *pop);
+boolean gaul_diversity_stop(population *pop);
+void gaul_diversity_free(population *pop);
+void gaul_compare_pack(population *pop, GAcompare compare, gaul_compare_t *packed);
+void gaul_compare_tile(const gaul_compare_t *packed, const int *rows, const int num_rows, const int first, const int last, double *out, const size_t ld);
+void gaul_niche_adjust(population *pop);
+void gaul_niche_readjust(population *pop);
+void gaul_niche_restore(population *pop);
+void gaul_niche_free(population *pop);
+extern unsigned int gaul_fitness_epoch;
+const ga_stats_t *gaul_stats_moments(population *pop, const int num);
+void gaul_stats_free(population *pop);
+void gaul_trace_begin(const int kind, const char *detail);
+void gaul_trace_end(void);
+void gaul_trace_fork(const pid_t pid);
+void gaul_trace_reap(const pid_t pid);
 
 #endif	/* GA_CORE_H_INCLUDED */
 
@@ -42,6 +42,8 @@
  */
 GAULFUNC void ga_population_set_deterministiccrowding_parameters( population		*pop,
                                                          const GAcompare	compare );
+GAULFUNC void ga_population_set_deterministiccrowding_threads( population	*pop,
+                                                         const int	num_threads );
 GAULFUNC int ga_deterministiccrowding(    population              *pop,
 	        const int               max_generations );
 
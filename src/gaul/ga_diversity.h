@@ -0,0 +1,69 @@
+/**********************************************************************
+  ga_diversity.h
+ **********************************************************************
+
+  ga_diversity - Population diversity measures.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Population diversity measures which scale to large
+		populations.
+
+ **********************************************************************/
+
+#ifndef GA_DIVERSITY_H_INCLUDED
+#define GA_DIVERSITY_H_INCLUDED
+
+/*
+ * Includes.
+ */
+#include "gaul.h"
+
+/*
+ * Prototypes.
+ */
+GAULFUNC double ga_diversity_boolean_entropy( population *pop );
+GAULFUNC double ga_diversity_char_entropy( population *pop );
+GAULFUNC double ga_diversity_integer_entropy( population *pop );
+GAULFUNC double ga_diversity_bitstring_entropy( population *pop );
+GAULFUNC boolean ga_diversity_get_entropy( population *pop,
+                                        double		*locus_entropy,
+                                        double		*hamming );
+GAULFUNC double ga_diversity_bitstring_simhash( population *pop );
+GAULFUNC double ga_diversity_integer_minhash( population *pop );
+GAULFUNC double ga_diversity_char_minhash( population *pop );
+GAULFUNC double ga_diversity_double_spread( population *pop );
+GAULFUNC boolean ga_diversity_get_centroid( population *pop,
+                                        double		*centroid,
+                                        double		*variance );
+GAULFUNC double ga_diversity_sampled( population *pop,
+                                        GAcompare	compare,
+                                        const int	num_pairs,
+                                        double		*lower,
+                                        double		*upper );
+GAULFUNC void ga_population_set_diversity_pairs( population *pop,
+                                        const int	num_pairs );
+GAULFUNC void ga_population_set_diversity_stop( population *pop,
+                                        GAdiversity	measure,
+                                        const double	threshold );
+
+#endif	/* GA_DIVERSITY_H_INCLUDED */
@@ -52,6 +52,25 @@ GAULFUNC int ga_steepestascent(    population              *pop,
 GAULFUNC int ga_steepestascent_double(    population              *pop,
 		entity                  *initial,
 	        const int               max_iterations );
+GAULFUNC void ga_population_set_gradient_linesearch_parameters( population	*pop,
+					const int		memory,
+					const double		c1,
+					const double		c2);
+GAULFUNC int ga_lbfgs(    population              *pop,
+		entity                  *initial,
+	        const int               max_iterations );
+GAULFUNC int ga_conjugategradient(    population              *pop,
+		entity                  *initial,
+	        const int               max_iterations );
+GAULFUNC void ga_population_set_gradient_difference_parameters( population	*pop,
+					const ga_gradient_difference_type	type,
+					const double		step,
+					const double		*scale,
+					const int		num_threads);
+GAULFUNC double ga_gradient_finite_difference( population	*pop,
+					entity		*this_entity,
+					double		*params,
+					double		*grad );
 
 #endif	/* GA_GRADIENT_H_INCLUDED */
 
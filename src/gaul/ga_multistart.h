@@ -0,0 +1,47 @@
+/**********************************************************************
+  ga_multistart.h
+ **********************************************************************
+
+  ga_multistart - Concurrent multi-start local search.
+  Copyright ©2002-2009, Stewart Adcock (http://saa.dyndns.org/)
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Concurrent multi-start driver for the local search
+		algorithms.
+
+ **********************************************************************/
+
+#ifndef GA_MULTISTART_H_INCLUDED
+#define GA_MULTISTART_H_INCLUDED
+
+/*
+ * Includes.
+ */
+#include "gaul.h"
+
+/*
+ * Prototypes.
+ */
+GAULFUNC void ga_population_set_multistart_parameters(population *pop, GAlocal_search search, const int num_threads, const int max_evaluations, const double target_fitness);
+GAULFUNC entity *ga_multistart(population *pop, entity **initial, const int num_starts, const int max_iterations);
+
+#endif	/* GA_MULTISTART_H_INCLUDED */
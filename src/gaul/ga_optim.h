@@ -53,6 +53,9 @@ typedef void    (*GAspecificmutate)(int chromo, int point, int *data);
 GAULFUNC void	 ga_attach_mpi_slave( population *pop );
 GAULFUNC void	 ga_detach_mpi_slaves(void);
 
+GAULFUNC void	ga_evaluate_entities( population *pop, entity **entities,
+			const int num_entities, const int max_threads );
+
 GAULFUNC int	ga_evolution(	population		*pop,
 			const int		max_generations );
 GAULFUNC int	ga_evolution_mp(	population		*pop,
@@ -74,11 +77,20 @@ GAULFUNC int	ga_evolution_archipelago_forked( const int num_pops,
 GAULFUNC int	ga_evolution_archipelago_threaded( const int num_pops,
                         population              **pops,
                         const int               max_generations );
+GAULFUNC int	ga_evolution_archipelago_async( const int num_pops,
+                        population              **pops,
+                        const int               max_generations,
+                        const int               max_evaluations,
+                        const double            target_fitness );
 GAULFUNC int	ga_evolution_archipelago_mp( const int num_pops,
                         population              **pops,
                         const int               max_generations );
 GAULFUNC int	ga_evolution_archipelago_mpi( const int num_pops,
                         population              **pops,
                         const int               max_generations );
+GAULFUNC void	ga_archipelago_set_topology( const int num_pops,
+                        population              **pops,
+                        const ga_topology_type  topology,
+                        const int               degree );
 
 #endif	/* GA_OPTIM_H */
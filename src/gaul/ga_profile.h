@@ -0,0 +1,61 @@
+/**********************************************************************
+  ga_profile.h
+ **********************************************************************
+
+  ga_profile - Profiling of evolutions.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Built-in profiling of evolutions.
+
+ **********************************************************************/
+
+#ifndef GA_PROFILE_H_INCLUDED
+#define GA_PROFILE_H_INCLUDED
+
+/*
+ * Includes.
+ */
+#include "gaul.h"
+
+/*
+ * Prototypes.
+ */
+GAULFUNC void ga_population_set_profiling( population *pop, const boolean enabled );
+GAULFUNC boolean ga_population_get_profiling( population *pop );
+GAULFUNC void ga_population_profile_reset( population *pop );
+GAULFUNC boolean ga_population_profile_get_phase( population *pop,
+                                        const ga_phase_type	phase,
+                                        double		*wall,
+                                        double		*cpu,
+                                        unsigned long	*calls );
+GAULFUNC unsigned long ga_population_profile_get_histogram( population *pop,
+                                        unsigned long	*counts );
+GAULFUNC boolean ga_population_profile_get_thread( population *pop,
+                                        const int	thread,
+                                        unsigned long	*evaluations,
+                                        double		*busy,
+                                        double		*idle );
+GAULFUNC double ga_profile_histogram_bin_limit( const int bin );
+GAULFUNC const char *ga_profile_phase_name( const ga_phase_type phase );
+
+#endif	/* GA_PROFILE_H_INCLUDED */
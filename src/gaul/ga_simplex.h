@@ -45,6 +45,10 @@ GAULFUNC void ga_population_set_simplex_parameters( population		*pop,
 					const double		step,
                                         const GAto_double	to_double,
                                         const GAfrom_double	from_double);
+GAULFUNC void ga_population_set_simplex_parallel( population	*pop,
+					const int		num_parallel,
+					const int		num_threads,
+					const int		num_simplices);
 GAULFUNC int ga_simplex( population              *pop,
 		entity                  *initial,
 	        const int               max_iterations );
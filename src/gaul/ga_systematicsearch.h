@@ -43,6 +43,15 @@
 GAULFUNC void ga_population_set_search_parameters( population              *pop,
                                         GAscan_chromosome	scan_chromosome);
 GAULFUNC int ga_search(population *pop, entity *initial);
+GAULFUNC void ga_population_set_search_parallel( population	*pop,
+                                        const int	num_threads,
+                                        const int	chunk_size,
+                                        const char	*checkpoint_fname,
+                                        const int	checkpoint_interval);
+GAULFUNC int ga_search_parallel( population	*pop,
+                                 entity		*best,
+                                 const int	first,
+                                 const int	last );
 
 #endif	/* GA_SYSTEMATICSEARCH_H_INCLUDED */
 
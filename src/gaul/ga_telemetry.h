@@ -0,0 +1,70 @@
+/**********************************************************************
+  ga_telemetry.h
+ **********************************************************************
+
+  ga_telemetry - Streaming per-generation telemetry.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Streaming per-generation telemetry of evolutions.
+
+ **********************************************************************/
+
+#ifndef GA_TELEMETRY_H_INCLUDED
+#define GA_TELEMETRY_H_INCLUDED
+
+/*
+ * Includes.
+ */
+#include "gaul.h"
+
+/*
+ * One telemetry record.  This is also the layout of the records in a
+ * binary telemetry stream.  Counts and phase times cover the interval
+ * since the previous record.
+ */
+typedef struct
+  {
+  int		generation;		/* Generation or iteration number. */
+  int		size;			/* Population size. */
+  double	elapsed;		/* Seconds since telemetry was enabled. */
+  double	best;			/* Best fitness. */
+  double	mean;			/* Mean fitness. */
+  double	stddev;			/* Standard deviation of fitness. */
+  double	diversity;		/* Estimated genotypic diversity, 0 to 1. */
+  unsigned long	evaluations;		/* Fitness evaluations. */
+  unsigned long	reused;			/* Stored fitnesses used without evaluation. */
+  double	phase[GA_NUM_PHASES];	/* Wall-clock seconds in each phase. */
+  } ga_telemetry_record;
+
+/*
+ * Prototypes.
+ */
+GAULFUNC boolean ga_population_set_telemetry( population *pop,
+                                        const char		*fname,
+                                        const ga_telemetry_format	format,
+                                        const int		interval );
+GAULFUNC void ga_population_telemetry_flush( population *pop );
+GAULFUNC unsigned long ga_population_telemetry_get_dropped( population *pop );
+GAULFUNC int ga_telemetry_read( const char *fname, ga_telemetry_record **records );
+
+#endif	/* GA_TELEMETRY_H_INCLUDED */
@@ -0,0 +1,49 @@
+/**********************************************************************
+  ga_trace.h
+ **********************************************************************
+
+  ga_trace - Timeline tracing of evolutions.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Timeline tracing of evolutions and local searches.
+
+ **********************************************************************/
+
+#ifndef GA_TRACE_H_INCLUDED
+#define GA_TRACE_H_INCLUDED
+
+/*
+ * Includes.
+ */
+#include "gaul.h"
+
+/*
+ * Prototypes.
+ */
+GAULFUNC void ga_trace_enable( const int max_events, const int sampling );
+GAULFUNC void ga_trace_disable( void );
+GAULFUNC boolean ga_trace_get_enabled( void );
+GAULFUNC void ga_trace_get_counts( unsigned long *recorded, unsigned long *dropped );
+GAULFUNC boolean ga_trace_write( const char *fname );
+
+#endif	/* GA_TRACE_H_INCLUDED */
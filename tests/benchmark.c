@@ -0,0 +1,1053 @@
+/**********************************************************************
+  benchmark.c
+ **********************************************************************
+
+  benchmark - Standard optimisation benchmarks for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Performance benchmarks for GAUL.
+
+		Each of GAUL's optimisation engines is run, for a fixed
+		budget of fitness evaluations, on a set of standard
+		problems: onemax, royal road, Rastrigin, Rosenbrock,
+		Ackley, a travelling salesman problem using random keys
+		and the ZDT1 multiobjective problem.  Runs are repeated
+		over a range of population sizes, chromosome lengths
+		and thread counts.
+
+		For each run, the evaluations per second, generations
+		(or iterations) per second, peak resident set size,
+		final solution quality and time taken to reach a target
+		quality are reported.  Each run is performed in a
+		forked process, so that its peak memory use may be
+		measured.  Results are written as JSON and may be
+		compared with a previously stored baseline, in which
+		case the exit status is non-zero if throughput has
+		dropped by more than a tolerance or if a target which
+		was reached is no longer reached.
+
+		Usage: gaul_benchmark [-q|-f] [-o results.json]
+		       [-b baseline.json] [-t tolerance]
+		       [-p problem] [-e engine]
+
+		-q runs a quick subset and -f runs the full set.  The
+		quick subset leaves out ga_evolution_threaded(), which
+		starts a thread for each evaluation and would take
+		several minutes.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/*
+ * Problems and engines.
+ */
+typedef enum
+  {
+  BENCH_ONEMAX, BENCH_ROYALROAD, BENCH_RASTRIGIN, BENCH_ROSENBROCK,
+  BENCH_ACKLEY, BENCH_TSP, BENCH_ZDT1, BENCH_NUM_PROBLEMS
+  } bench_problem_t;
+
+typedef enum
+  {
+  BENCH_EVOLUTION, BENCH_THREADED, BENCH_STEADY_STATE, BENCH_DE,
+  BENCH_SA, BENCH_TABU, BENCH_SIMPLEX, BENCH_LBFGS, BENCH_ARCHIPELAGO,
+  BENCH_NUM_ENGINES
+  } bench_engine_t;
+
+static const char *bench_problem_names[BENCH_NUM_PROBLEMS] =
+  { "onemax", "royalroad", "rastrigin", "rosenbrock", "ackley", "tsp", "zdt1" };
+
+static const char *bench_engine_names[BENCH_NUM_ENGINES] =
+  { "ga_evolution", "ga_evolution_threaded", "ga_evolution_steady_state",
+    "ga_differentialevolution", "ga_sa", "ga_tabu", "ga_simplex_double",
+    "ga_lbfgs", "ga_evolution_archipelago_threaded" };
+
+/*
+ * Run sizes.  Lists are terminated by zero.
+ */
+#define BENCH_MAX_SIZES		4
+#define BENCH_MAX_CITIES	1024
+#define BENCH_ROYALROAD_BLOCK	8
+#define BENCH_ISLAND_SIZE	50	/* Archipelago population per island. */
+#define BENCH_LOCAL_SIZE	10	/* Population size for local searches. */
+
+typedef struct
+  {
+  int		budget;				/* Nominal evaluations per run. */
+  int		population[BENCH_MAX_SIZES];	/* Population sizes. */
+  int		bits[BENCH_MAX_SIZES];		/* Bit-string lengths. */
+  int		dims[BENCH_MAX_SIZES];		/* Continuous dimensions. */
+  int		cities[BENCH_MAX_SIZES];	/* TSP cities. */
+  int		zdt[BENCH_MAX_SIZES];		/* ZDT1 dimensions. */
+  int		threads[BENCH_MAX_SIZES];	/* Thread counts. */
+  boolean	threaded;			/* Whether to run ga_evolution_threaded(). */
+  } bench_sizes_t;
+
+static bench_sizes_t bench_quick =
+  { 20000, {100}, {64}, {10}, {30}, {30}, {1, 4}, FALSE };
+static bench_sizes_t bench_standard =
+  { 50000, {50, 200}, {64, 256}, {10, 30}, {20, 50}, {30}, {1, 2, 4}, TRUE };
+static bench_sizes_t bench_full =
+  { 200000, {50, 200, 1000}, {64, 256, 1024}, {10, 30, 100}, {20, 50, 100}, {30, 100}, {1, 2, 4, 8}, TRUE };
+
+/*
+ * Result of one run.
+ */
+typedef struct
+  {
+  bench_problem_t	problem;
+  bench_engine_t	engine;
+  int			population;
+  int			length;
+  int			threads;
+  boolean		success;	/* Whether the run completed. */
+  unsigned long		evaluations;
+  int			generations;	/* Or iterations, for local searches. */
+  double		seconds;
+  double		quality;	/* Best fitness, or hypervolume for ZDT1. */
+  double		target;		/* Target quality. */
+  double		time_to_target;	/* Seconds, or negative if not reached. */
+  long			peak_rss;	/* Kilobytes. */
+  } bench_result_t;
+
+/*
+ * State of the current run, shared with the callbacks.
+ */
+static bench_problem_t	bench_problem;
+static double		bench_target;
+static double		bench_start;
+static double		bench_reached;
+static int		bench_iterations;
+static double		bench_cities[BENCH_MAX_CITIES][2];
+THREAD_LOCK_DEFINE_STATIC(bench_lock);
+
+/**********************************************************************
+  bench_hypervolume()
+  synopsis:	Hypervolume dominated by a population's ZDT1
+		objectives, relative to the reference point (1,1).
+		The optimum is 2/3.
+  parameters:	population *pop
+  return:	Hypervolume.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int bench_compare_points(const void *a, const void *b)
+  {
+  const double	*p=(const double *)a, *q=(const double *)b;
+
+  return p[0]<q[0] ? -1 : p[0]>q[0] ? 1 : 0;
+  }
+
+static double bench_hypervolume(population *pop)
+  {
+  double	*points;		/* Objective pairs. */
+  double	hv=0.0, last=1.0;	/* Hypervolume, previous f2. */
+  int		i, num=0;		/* Loop over entities, points. */
+  entity	*this_entity;		/* Current entity. */
+
+  if ( !(points = s_malloc(sizeof(double)*2*ga_population_get_size(pop))) )
+    die("Unable to allocate memory");
+
+  for (i=0; i<ga_population_get_size(pop); i++)
+    {
+    this_entity = ga_get_entity_from_rank(pop, i);
+    if (this_entity->fitness == GA_MIN_FITNESS) continue;
+    points[2*num] = -this_entity->fitvector[0];
+    points[2*num+1] = -this_entity->fitvector[1];
+    num++;
+    }
+
+  qsort(points, num, 2*sizeof(double), bench_compare_points);
+
+  for (i=0; i<num; i++)
+    {
+    if (points[2*i] < 1.0 && points[2*i+1] < last)
+      {
+      hv += (1.0-points[2*i])*(last-points[2*i+1]);
+      last = points[2*i+1];
+      }
+    }
+
+  s_free(points);
+
+  return hv;
+  }
+
+
+/**********************************************************************
+  bench_tour_length()
+  synopsis:	Length of the tour given by sorting random keys.
+  parameters:	const double *keys
+		const int n		Number of cities.
+  return:	Tour length.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static double bench_tour_length(const double *keys, const int n)
+  {
+  double	order[BENCH_MAX_CITIES][2];	/* Keys and cities. */
+  double	length=0.0;			/* Tour length. */
+  int		i, a, b;			/* Loop over cities. */
+
+  for (i=0; i<n; i++)
+    {
+    order[i][0] = keys[i];
+    order[i][1] = i;
+    }
+
+  qsort(order, n, 2*sizeof(double), bench_compare_points);
+
+  for (i=0; i<n; i++)
+    {
+    a = (int) order[i][1];
+    b = (int) order[(i+1)%n][1];
+    length += sqrt( SQU(bench_cities[a][0]-bench_cities[b][0])
+                  + SQU(bench_cities[a][1]-bench_cities[b][1]) );
+    }
+
+  return length;
+  }
+
+
+/**********************************************************************
+  bench_score()
+  synopsis:	Fitness function for all problems.  Larger is better.
+  parameters:	population *pop
+		entity *this_entity
+  return:	TRUE
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean bench_score(population *pop, entity *this_entity)
+  {
+  int		n=pop->len_chromosomes;	/* Chromosome length. */
+  boolean	*bits=(boolean *)this_entity->chromosome[0];
+  double	*x=(double *)this_entity->chromosome[0];
+  double	sum=0.0, sum2=0.0;	/* Partial sums. */
+  double	f1, g, xi;		/* ZDT1 terms. */
+  int		i, j;			/* Loop over alleles. */
+
+  switch (bench_problem)
+    {
+    case BENCH_ONEMAX:
+      for (i=0; i<n; i++)
+        if (bits[i]) sum += 1.0;
+      break;
+
+    case BENCH_ROYALROAD:
+      for (i=0; i+BENCH_ROYALROAD_BLOCK<=n; i+=BENCH_ROYALROAD_BLOCK)
+        {
+        for (j=0; j<BENCH_ROYALROAD_BLOCK && bits[i+j]; j++);
+        if (j == BENCH_ROYALROAD_BLOCK) sum += BENCH_ROYALROAD_BLOCK;
+        }
+      break;
+
+    case BENCH_RASTRIGIN:
+      for (i=0; i<n; i++)
+        sum -= x[i]*x[i] - 10.0*cos(2.0*PI*x[i]) + 10.0;
+      break;
+
+    case BENCH_ROSENBROCK:
+      for (i=0; i<n-1; i++)
+        sum -= 100.0*SQU(x[i+1]-x[i]*x[i]) + SQU(1.0-x[i]);
+      break;
+
+    case BENCH_ACKLEY:
+      for (i=0; i<n; i++)
+        {
+        sum += x[i]*x[i];
+        sum2 += cos(2.0*PI*x[i]);
+        }
+      sum = 20.0*exp(-0.2*sqrt(sum/n)) + exp(sum2/n) - 20.0 - exp(1.0);
+      break;
+
+    case BENCH_TSP:
+      sum = -bench_tour_length(x, n);
+      break;
+
+    case BENCH_ZDT1:
+      f1 = MIN(MAX(x[0], 0.0), 1.0);
+      for (i=1; i<n; i++)
+        {
+        xi = MIN(MAX(x[i], 0.0), 1.0);
+        sum2 += xi;
+        }
+      g = 1.0 + 9.0*sum2/(n-1);
+      this_entity->fitvector[0] = -f1;
+      this_entity->fitvector[1] = -g*(1.0-sqrt(f1/g));
+      sum = this_entity->fitvector[0] + this_entity->fitvector[1];
+      break;
+
+    default:
+      die("Unknown problem.");
+    }
+
+  ga_entity_set_fitness(this_entity, sum);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  bench_reach()
+  synopsis:	Note the time at which the target is first reached.
+  parameters:	const double quality
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void bench_reach(const double quality)
+  {
+
+  if (quality < bench_target || bench_reached >= 0.0) return;
+
+  THREAD_LOCK(bench_lock);
+  if (bench_reached < 0.0) bench_reached = timer_monotonic()-bench_start;
+  THREAD_UNLOCK(bench_lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  bench_generation_hook()
+  bench_iteration_hook()
+  synopsis:	Track the time at which the target is reached.
+  parameters:
+  return:	TRUE
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean bench_generation_hook(const int generation, population *pop)
+  {
+
+  bench_iterations = generation;
+
+  if (ga_population_get_size(pop) == 0) return TRUE;
+
+  if (bench_problem == BENCH_ZDT1)
+    bench_reach(bench_hypervolume(pop));
+  else
+    bench_reach(ga_get_entity_from_rank(pop, 0)->fitness);
+
+  return TRUE;
+  }
+
+static boolean bench_iteration_hook(const int iteration, entity *this_entity)
+  {
+
+  bench_reach(this_entity->fitness);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  bench_to_double()
+  bench_from_double()
+  synopsis:	Convert between chromosomes and double arrays, for
+		the gradient and simplex searches.
+  parameters:
+  return:	TRUE
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean bench_to_double(population *pop, entity *this_entity, double *array)
+  {
+  memcpy(array, this_entity->chromosome[0], pop->len_chromosomes*sizeof(double));
+  return TRUE;
+  }
+
+static boolean bench_from_double(population *pop, entity *this_entity, double *array)
+  {
+  memcpy(this_entity->chromosome[0], array, pop->len_chromosomes*sizeof(double));
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  bench_applicable()
+  synopsis:	Whether an engine may be run on a problem.
+  parameters:	const bench_problem_t problem
+		const bench_engine_t engine
+  return:	TRUE if applicable.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean bench_applicable(const bench_problem_t problem, const bench_engine_t engine)
+  {
+  boolean	binary = problem==BENCH_ONEMAX || problem==BENCH_ROYALROAD;
+  boolean	smooth = problem==BENCH_RASTRIGIN || problem==BENCH_ROSENBROCK || problem==BENCH_ACKLEY;
+
+  switch (engine)
+    {
+    case BENCH_EVOLUTION:
+    case BENCH_THREADED:
+    case BENCH_ARCHIPELAGO:
+      return TRUE;
+    case BENCH_STEADY_STATE:
+    case BENCH_SA:
+    case BENCH_TABU:
+      return problem != BENCH_ZDT1;
+    case BENCH_DE:
+    case BENCH_SIMPLEX:
+      return !binary && problem != BENCH_ZDT1;
+    case BENCH_LBFGS:
+      return smooth;
+    default:
+      return FALSE;
+    }
+  }
+
+
+/**********************************************************************
+  bench_population()
+  synopsis:	Create a population for a problem and engine.
+  parameters:	const bench_problem_t problem
+		const bench_engine_t engine
+		const int size		Population size.
+		const int length	Chromosome length.
+		const int budget	Evaluations per run.
+  return:	New population.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static population *bench_population( const bench_problem_t problem,
+                                     const bench_engine_t engine,
+                                     const int size, const int length,
+                                     const int budget )
+  {
+  population	*pop;		/* New population. */
+  double	range;		/* Allele range. */
+
+  if (problem == BENCH_ONEMAX || problem == BENCH_ROYALROAD)
+    {
+    pop = ga_genesis_boolean( size, 1, length,
+                              bench_generation_hook, bench_iteration_hook,
+                              NULL, NULL, bench_score, ga_seed_boolean_random, NULL,
+                              ga_select_one_bestof2, ga_select_two_bestof2,
+                              ga_mutate_boolean_singlepoint,
+                              ga_crossover_boolean_doublepoints,
+                              ga_replace_by_fitness, NULL );
+    }
+  else
+    {
+    pop = ga_genesis_double( size, 1, length,
+                             bench_generation_hook, bench_iteration_hook,
+                             NULL, NULL, bench_score, ga_seed_double_random, NULL,
+                             ga_select_one_bestof2, ga_select_two_bestof2,
+                             ga_mutate_double_singlepoint_drift,
+                             ga_crossover_double_doublepoints,
+                             ga_replace_by_fitness, NULL );
+
+    switch (problem)
+      {
+      case BENCH_RASTRIGIN:  range = 5.12; break;
+      case BENCH_ROSENBROCK: range = 2.048; break;
+      case BENCH_ACKLEY:     range = 32.768; break;
+      default:               range = 0.0; break;
+      }
+
+    ga_population_set_allele_min_double(pop, problem==BENCH_TSP||problem==BENCH_ZDT1?0.0:-range);
+    ga_population_set_allele_max_double(pop, problem==BENCH_TSP||problem==BENCH_ZDT1?1.0:range);
+    }
+
+  ga_population_set_parameters( pop, GA_SCHEME_DARWIN,
+                                problem==BENCH_ZDT1?GA_ELITISM_PARETO_SET_SURVIVE:GA_ELITISM_PARENTS_SURVIVE,
+                                0.9, 0.2, engine==BENCH_ARCHIPELAGO?0.1:0.0 );
+
+  if (problem == BENCH_ZDT1)
+    ga_population_set_fitness_dimensions(pop, 2);
+
+  switch (engine)
+    {
+    case BENCH_DE:
+      ga_population_set_differentialevolution_parameters(
+          pop, GA_DE_STRATEGY_RAND, GA_DE_CROSSOVER_BINOMIAL, 1, 0.5, 1.0, 0.8 );
+      break;
+    case BENCH_SA:
+      ga_population_set_sa_parameters(pop, ga_sa_linear_acceptance, 1.0, 0.0, 0.0, -1);
+      break;
+    case BENCH_TABU:
+      ga_population_set_tabu_parameters( pop,
+          problem==BENCH_ONEMAX||problem==BENCH_ROYALROAD?ga_tabu_check_boolean:ga_tabu_check_double,
+          50, 10 );
+      break;
+    case BENCH_SIMPLEX:
+      ga_population_set_simplex_parameters(pop, length, 0.5, bench_to_double, bench_from_double);
+      break;
+    case BENCH_LBFGS:
+      ga_population_set_gradient_parameters( pop, bench_to_double, bench_from_double,
+                                             ga_gradient_finite_difference, length, 0.1 );
+      break;
+    default:
+      break;
+    }
+
+  plog(LOG_DEBUG, "Population for budget of %d evaluations created.", budget);
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  bench_run()
+  synopsis:	Perform one run.  This is called in a forked process.
+  parameters:	bench_result_t *result	Run to perform.
+		const int budget	Evaluations per run.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void bench_run(bench_result_t *result, const int budget)
+  {
+  population	*pops[BENCH_MAX_CITIES];	/* Populations. */
+  int		num_pops=1;			/* Number of populations. */
+  entity	*solution=NULL;			/* Local search solution. */
+  char		threads[16];			/* GAUL_NUM_THREADS setting. */
+  int		size;				/* Population size. */
+  int		i;				/* Loop over populations. */
+
+  bench_problem = result->problem;
+  bench_reached = -1.0;
+
+  switch (bench_problem)
+    {
+    case BENCH_ONEMAX:
+    case BENCH_ROYALROAD:
+      bench_target = result->length;
+      break;
+    case BENCH_RASTRIGIN:
+    case BENCH_ROSENBROCK:
+      bench_target = -1.0;
+      break;
+    case BENCH_ACKLEY:
+      bench_target = -0.1;
+      break;
+    case BENCH_TSP:
+      for (i=0; i<result->length; i++)
+        {	/* Cities on a unit circle, so the optimum is known. */
+        bench_cities[i][0] = cos(2.0*PI*i/result->length);
+        bench_cities[i][1] = sin(2.0*PI*i/result->length);
+        }
+      bench_target = -1.1*2.0*result->length*sin(PI/result->length);
+      break;
+    case BENCH_ZDT1:
+      bench_target = 0.6;
+      break;
+    default:
+      die("Unknown problem.");
+    }
+  result->target = bench_target;
+
+  snprintf(threads, 16, "%d", result->threads);
+  setenv("GAUL_NUM_THREADS", threads, 1);
+
+  random_seed(42);
+
+  if (result->engine == BENCH_ARCHIPELAGO)
+    {
+    num_pops = result->threads;
+    size = result->population/num_pops;
+    }
+  else if (result->engine >= BENCH_SA && result->engine <= BENCH_LBFGS)
+    {
+    size = BENCH_LOCAL_SIZE;
+    }
+  else
+    {
+    size = result->population;
+    }
+
+  for (i=0; i<num_pops; i++)
+    {
+    pops[i] = bench_population(result->problem, result->engine, size, result->length, budget);
+    ga_population_set_profiling(pops[i], TRUE);
+    }
+
+  if (result->engine >= BENCH_SA && result->engine <= BENCH_LBFGS)
+    {
+    solution = ga_get_free_entity(pops[0]);
+    ga_entity_seed(pops[0], solution);
+    }
+
+  bench_start = timer_monotonic();
+
+  switch (result->engine)
+    {
+    case BENCH_EVOLUTION:
+      result->generations = ga_evolution(pops[0], budget/size);
+      break;
+    case BENCH_THREADED:
+      result->generations = ga_evolution_threaded(pops[0], budget/size);
+      break;
+    case BENCH_STEADY_STATE:
+      ga_evolution_steady_state(pops[0], budget/2);
+      result->generations = bench_iterations;
+      break;
+    case BENCH_DE:
+      result->generations = ga_differentialevolution(pops[0], budget/size);
+      break;
+    case BENCH_SA:
+      result->generations = ga_sa(pops[0], solution, budget);
+      break;
+    case BENCH_TABU:
+      result->generations = ga_tabu(pops[0], solution, budget/10);
+      break;
+    case BENCH_SIMPLEX:
+      result->generations = ga_simplex_double(pops[0], solution, budget/2);
+      break;
+    case BENCH_LBFGS:
+      result->generations = ga_lbfgs(pops[0], solution, budget/(result->length+5));
+      break;
+    case BENCH_ARCHIPELAGO:
+      result->generations = ga_evolution_archipelago_threaded(num_pops, pops, budget/result->population);
+      break;
+    default:
+      die("Unknown engine.");
+    }
+
+  result->seconds = timer_monotonic()-bench_start;
+
+/*
+ * The final solution may not have been seen by a hook.
+ */
+  if (solution)
+    {
+    result->quality = solution->fitness;
+    }
+  else if (bench_problem == BENCH_ZDT1)
+    {
+    result->quality = 0.0;
+    for (i=0; i<num_pops; i++)
+      result->quality = MAX(result->quality, bench_hypervolume(pops[i]));
+    }
+  else
+    {
+    result->quality = GA_MIN_FITNESS;
+    for (i=0; i<num_pops; i++)
+      result->quality = MAX(result->quality, ga_get_entity_from_rank(pops[i], 0)->fitness);
+    }
+  bench_reach(result->quality);
+  result->time_to_target = bench_reached;
+
+  result->evaluations = 0;
+  for (i=0; i<num_pops; i++)
+    result->evaluations += ga_population_profile_get_histogram(pops[i], NULL);
+
+  result->success = TRUE;
+
+  return;
+  }
+
+
+/**********************************************************************
+  bench_fork()
+  synopsis:	Perform one run in a forked process, measuring its
+		peak memory use.
+  parameters:	bench_result_t *result	Run to perform.
+		const int budget	Evaluations per run.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void bench_fork(bench_result_t *result, const int budget)
+  {
+  int		fd[2];		/* Pipe from child. */
+  pid_t		pid;		/* Child process. */
+  int		status;		/* Child's exit status. */
+  struct rusage	usage;		/* Child's resource usage. */
+  ssize_t	len;		/* Bytes read. */
+
+  result->success = FALSE;
+  result->peak_rss = 0;
+
+  if (pipe(fd) != 0) dief("Unable to create pipe (%s).", strerror(errno));
+
+  fflush(NULL);
+
+  if ( (pid = fork()) < 0 ) dief("Unable to fork (%s).", strerror(errno));
+
+  if (pid == 0)
+    {
+    close(fd[0]);
+    bench_run(result, budget);
+    if (write(fd[1], result, sizeof(bench_result_t)) != sizeof(bench_result_t))
+      _exit(EXIT_FAILURE);
+    _exit(EXIT_SUCCESS);
+    }
+
+  close(fd[1]);
+  len = read(fd[0], result, sizeof(bench_result_t));
+  close(fd[0]);
+
+  if (wait4(pid, &status, 0, &usage) == pid)
+    result->peak_rss = usage.ru_maxrss;
+
+  if (len != sizeof(bench_result_t) || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS)
+    result->success = FALSE;
+
+  return;
+  }
+
+
+/**********************************************************************
+  bench_write()
+  synopsis:	Write one result as a line of JSON.
+  parameters:	FILE *fp
+		bench_result_t *result
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void bench_write(FILE *fp, bench_result_t *result)
+  {
+
+  fprintf( fp, "{\"problem\":\"%s\",\"engine\":\"%s\",\"population\":%d,\"length\":%d,\"threads\":%d,",
+           bench_problem_names[result->problem], bench_engine_names[result->engine],
+           result->population, result->length, result->threads );
+
+  if (!result->success)
+    {
+    fprintf(fp, "\"success\":false}");
+    return;
+    }
+
+  fprintf( fp, "\"success\":true,\"evaluations\":%lu,\"generations\":%d,\"seconds\":%.6f,"
+               "\"evaluations_per_second\":%.1f,\"generations_per_second\":%.1f,"
+               "\"peak_rss_kb\":%ld,\"quality\":%.6g,\"target\":%.6g,\"time_to_target\":",
+           result->evaluations, result->generations, result->seconds,
+           result->evaluations/MAX(result->seconds, 1.0e-9),
+           result->generations/MAX(result->seconds, 1.0e-9),
+           result->peak_rss, result->quality, result->target );
+
+  if (result->time_to_target < 0.0)
+    fprintf(fp, "null}");
+  else
+    fprintf(fp, "%.6f}", result->time_to_target);
+
+  return;
+  }
+
+
+/**********************************************************************
+  bench_json_string()
+  bench_json_number()
+  synopsis:	Extract a field from a line of JSON written by
+		bench_write().
+  parameters:	const char *line
+		const char *key
+		char *value / double *value
+  return:	TRUE if found.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean bench_json_string(const char *line, const char *key, char *value, const int len)
+  {
+  char		pattern[64];	/* Key with quotes. */
+  const char	*p;		/* Position in line. */
+  int		i=0;		/* Position in value. */
+
+  snprintf(pattern, 64, "\"%s\":\"", key);
+  if ( !(p = strstr(line, pattern)) ) return FALSE;
+
+  for (p+=strlen(pattern); *p && *p!='"' && i<len-1; p++)
+    value[i++] = *p;
+  value[i] = '\0';
+
+  return TRUE;
+  }
+
+static boolean bench_json_number(const char *line, const char *key, double *value)
+  {
+  char		pattern[64];	/* Key with quotes. */
+  const char	*p;		/* Position in line. */
+
+  snprintf(pattern, 64, "\"%s\":", key);
+  if ( !(p = strstr(line, pattern)) ) return FALSE;
+  p += strlen(pattern);
+
+  if (strncmp(p, "null", 4) == 0)
+    *value = -1.0;
+  else
+    *value = atof(p);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  bench_compare()
+  synopsis:	Compare results with a baseline.
+  parameters:	const char *fname	Baseline JSON file.
+		bench_result_t *results
+		const int num_results
+		const double tolerance	Fractional throughput drop allowed.
+  return:	Number of regressions.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int bench_compare( const char *fname, bench_result_t *results,
+                          const int num_results, const double tolerance )
+  {
+  FILE		*fp;			/* Baseline file. */
+  char		line[1024];		/* Line of baseline. */
+  char		problem[64], engine[64];	/* Run names. */
+  double	population, length, threads;	/* Run sizes. */
+  double	success, eps, ttt;	/* Baseline results. */
+  double	current;		/* Current evaluations per second. */
+  bench_result_t	*result;	/* Current result. */
+  int		i;			/* Loop over results. */
+  int		num_compared=0, num_regressions=0;
+
+  if ( !(fp = fopen(fname, "r")) )
+    {
+    printf("No baseline \"%s\" to compare with.\n", fname);
+    return 0;
+    }
+
+  while (fgets(line, 1024, fp))
+    {
+    if ( !bench_json_string(line, "problem", problem, 64) ||
+         !bench_json_string(line, "engine", engine, 64) ||
+         !bench_json_number(line, "population", &population) ||
+         !bench_json_number(line, "length", &length) ||
+         !bench_json_number(line, "threads", &threads) )
+      continue;
+
+    success = strstr(line, "\"success\":true") != NULL;
+    if (!success) continue;
+    bench_json_number(line, "evaluations_per_second", &eps);
+    bench_json_number(line, "time_to_target", &ttt);
+
+    for (i=0; i<num_results; i++)
+      {
+      result = &(results[i]);
+      if ( strcmp(problem, bench_problem_names[result->problem]) != 0 ||
+           strcmp(engine, bench_engine_names[result->engine]) != 0 ||
+           (int) population != result->population ||
+           (int) length != result->length ||
+           (int) threads != result->threads )
+        continue;
+
+      num_compared++;
+
+      if (!result->success)
+        {
+        printf( "REGRESSION: %s %s population %d length %d threads %d: run failed.\n",
+                problem, engine, result->population, result->length, result->threads );
+        num_regressions++;
+        continue;
+        }
+
+      current = result->evaluations/MAX(result->seconds, 1.0e-9);
+      if (current < (1.0-tolerance)*eps)
+        {
+        printf( "REGRESSION: %s %s population %d length %d threads %d: %.0f evaluations/s, baseline %.0f.\n",
+                problem, engine, result->population, result->length, result->threads, current, eps );
+        num_regressions++;
+        }
+
+      if (ttt >= 0.0 && result->time_to_target < 0.0)
+        {
+        printf( "REGRESSION: %s %s population %d length %d threads %d: target no longer reached.\n",
+                problem, engine, result->population, result->length, result->threads );
+        num_regressions++;
+        }
+      }
+    }
+
+  fclose(fp);
+
+  printf( "Compared %d runs with baseline \"%s\": %d regressions.\n",
+          num_compared, fname, num_regressions );
+
+  return num_regressions;
+  }
+
+
+/**********************************************************************
+  bench_lookup()
+  synopsis:	Find a name in a list.
+  parameters:	const char *name
+		const char **names
+		const int num
+  return:	Index.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int bench_lookup(const char *name, const char **names, const int num)
+  {
+  int		i;		/* Loop over names. */
+
+  for (i=0; i<num; i++)
+    if (strcmp(name, names[i]) == 0) return i;
+
+  dief("Unknown name \"%s\".", name);
+
+  return -1;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  bench_sizes_t		*sizes=&bench_standard;	/* Run sizes. */
+  char			*output="benchmark.json";	/* Results file. */
+  char			*baseline=NULL;		/* Baseline file. */
+  double		tolerance=0.2;		/* Throughput drop allowed. */
+  int			only_problem=-1, only_engine=-1;
+  bench_result_t	*results=NULL;		/* All results. */
+  int			num_results=0, max_results=0;
+  int			*lengths;		/* Chromosome lengths. */
+  int			problem, engine;	/* Loop over problems, engines. */
+  int			p, l, t;		/* Loop over sizes. */
+  int			i;			/* Loop over arguments, results. */
+  FILE			*fp;			/* Results file. */
+
+  for (i=1; i<argc; i++)
+    {
+    if (strcmp(argv[i], "-q") == 0) sizes = &bench_quick;
+    else if (strcmp(argv[i], "-f") == 0) sizes = &bench_full;
+    else if (strcmp(argv[i], "-o") == 0 && i+1 < argc) output = argv[++i];
+    else if (strcmp(argv[i], "-b") == 0 && i+1 < argc) baseline = argv[++i];
+    else if (strcmp(argv[i], "-t") == 0 && i+1 < argc) tolerance = atof(argv[++i]);
+    else if (strcmp(argv[i], "-p") == 0 && i+1 < argc)
+      only_problem = bench_lookup(argv[++i], bench_problem_names, BENCH_NUM_PROBLEMS);
+    else if (strcmp(argv[i], "-e") == 0 && i+1 < argc)
+      only_engine = bench_lookup(argv[++i], bench_engine_names, BENCH_NUM_ENGINES);
+    else
+      {
+      printf("Usage: %s [-q|-f] [-o results.json] [-b baseline.json] [-t tolerance] [-p problem] [-e engine]\n", argv[0]);
+      exit(EXIT_FAILURE);
+      }
+    }
+
+  printf( "%-10s %-34s %5s %5s %3s %12s %10s %8s %12s %10s\n",
+          "problem", "engine", "pop", "len", "thr", "evals/s", "gens/s", "rss/kB", "quality", "to target" );
+
+  for (problem=0; problem<BENCH_NUM_PROBLEMS; problem++)
+    {
+    if (only_problem >= 0 && problem != only_problem) continue;
+
+    switch (problem)
+      {
+      case BENCH_ONEMAX:
+      case BENCH_ROYALROAD: lengths = sizes->bits; break;
+      case BENCH_TSP:       lengths = sizes->cities; break;
+      case BENCH_ZDT1:      lengths = sizes->zdt; break;
+      default:              lengths = sizes->dims; break;
+      }
+
+    for (engine=0; engine<BENCH_NUM_ENGINES; engine++)
+      {
+      if (only_engine >= 0 && engine != only_engine) continue;
+      if (!bench_applicable(problem, engine)) continue;
+      if (engine == BENCH_THREADED && !sizes->threaded) continue;
+
+      for (p=0; p<BENCH_MAX_SIZES && sizes->population[p]; p++)
+        {
+        if (engine >= BENCH_SA && engine <= BENCH_LBFGS && p > 0) continue;
+
+        for (l=0; l<BENCH_MAX_SIZES && lengths[l]; l++)
+          {
+          for (t=0; t<BENCH_MAX_SIZES && sizes->threads[t]; t++)
+            {
+            if (engine != BENCH_THREADED && engine != BENCH_ARCHIPELAGO && t > 0) continue;
+            if (engine == BENCH_ARCHIPELAGO && sizes->threads[t] < 2) continue;
+
+            if (num_results == max_results)
+              {
+              max_results += 64;
+              if ( !(results = s_realloc(results, sizeof(bench_result_t)*max_results)) )
+                die("Unable to allocate memory");
+              }
+
+            results[num_results].problem = (bench_problem_t) problem;
+            results[num_results].engine = (bench_engine_t) engine;
+            results[num_results].population = engine>=BENCH_SA&&engine<=BENCH_LBFGS ? 1 :
+                                               engine==BENCH_ARCHIPELAGO ?
+                                               MAX(sizes->population[p], 6*sizes->threads[t]) :
+                                               sizes->population[p];
+            results[num_results].length = lengths[l];
+            results[num_results].threads = engine==BENCH_THREADED||engine==BENCH_ARCHIPELAGO ? sizes->threads[t] : 1;
+
+            bench_fork(&(results[num_results]), sizes->budget);
+
+            if (results[num_results].success)
+              printf( "%-10s %-34s %5d %5d %3d %12.0f %10.1f %8ld %12.6g %10s\n",
+                      bench_problem_names[problem], bench_engine_names[engine],
+                      results[num_results].population, results[num_results].length,
+                      results[num_results].threads,
+                      results[num_results].evaluations/MAX(results[num_results].seconds, 1.0e-9),
+                      results[num_results].generations/MAX(results[num_results].seconds, 1.0e-9),
+                      results[num_results].peak_rss, results[num_results].quality,
+                      results[num_results].time_to_target<0.0?"-":"reached" );
+            else
+              printf( "%-10s %-34s %5d %5d %3d FAILED\n",
+                      bench_problem_names[problem], bench_engine_names[engine],
+                      results[num_results].population, results[num_results].length,
+                      results[num_results].threads );
+
+            num_results++;
+            }
+          }
+        }
+      }
+    }
+
+/*
+ * Write results.
+ */
+  if ( !(fp = fopen(output, "w")) ) dief("Unable to open \"%s\".", output);
+
+  fprintf( fp, "{\"benchmark\":\"gaul\",\"version\":\"%d.%d-%d\",\"budget\":%d,\"results\":[\n",
+           GA_MAJOR_VERSION, GA_MINOR_VERSION, GA_PATCH_VERSION, sizes->budget );
+  for (i=0; i<num_results; i++)
+    {
+    bench_write(fp, &(results[i]));
+    fprintf(fp, i<num_results-1?",\n":"\n");
+    }
+  fprintf(fp, "]}\n");
+  fclose(fp);
+
+  printf("%d runs written to \"%s\".\n", num_results, output);
+
+  if (baseline && bench_compare(baseline, results, num_results, tolerance) > 0)
+    exit(EXIT_FAILURE);
+
+  s_free(results);
+
+  exit(EXIT_SUCCESS);
+  }
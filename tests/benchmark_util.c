@@ -0,0 +1,859 @@
+/**********************************************************************
+  benchmark_util.c
+ **********************************************************************
+
+  benchmark_util - Microbenchmarks for GAUL's utility library.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Microbenchmarks for the primitives in util/.
+
+		The time per operation is measured for allocation and
+		deallocation with malloc(), s_malloc_safe(),
+		s_alloc_debug() and both memory chunk implementations,
+		using several allocation patterns; for random number
+		draws from the shared and from a thread's private
+		stream; for AVL tree insertion and lookup; for singly
+		linked list appends and indexing; and for table
+		additions and lookups.
+
+		Each benchmark is calibrated so that one repetition
+		takes a minimum time, is run once to warm up, and is
+		then repeated.  The median, minimum, mean and relative
+		standard deviation of the time per operation are
+		reported.  Each benchmark is repeated with several
+		threads, each using its own data structures, so that
+		the cost of any shared locks may be seen.  The
+		aggregate throughput, and the scaling relative to a
+		single thread, are also reported.
+
+		Usage: gaul_benchmark_util [-r repetitions]
+		       [-m min_seconds] [-t max_threads]
+		       [-k name] [-o results.json]
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#ifdef HAVE_PTHREADS
+# include <pthread.h>
+#endif
+
+#define BENCH_MAX_CASES		40
+#define BENCH_MAX_THREADS	8
+#define BENCH_MAX_REPETITIONS	100
+#define BENCH_ATOM_SIZE		64	/* Bytes per allocation. */
+#define BENCH_BATCH		1024	/* Allocations per batch; a power of two. */
+#define BENCH_LIST_SIZE		1024	/* Length of lists and linear tables. */
+#define BENCH_MIN_OPS		1024	/* Initial calibration, a multiple of the above. */
+#define BENCH_SCRAMBLE		2654435761UL	/* Odd, so i*BENCH_SCRAMBLE permutes. */
+
+typedef struct bench_thread_s bench_thread_t;
+
+/*
+ * One benchmark.
+ */
+typedef struct
+  {
+  char		name[64];		/* Benchmark name. */
+  int		variant;		/* Allocator and pattern. */
+  boolean	threadsafe;		/* Whether it may be run by several threads. */
+  void		(*setup)(bench_thread_t *thread);	/* Untimed preparation. */
+  void		(*run)(bench_thread_t *thread);		/* Timed operations. */
+  void		(*teardown)(bench_thread_t *thread);	/* Untimed clean-up. */
+  } bench_case_t;
+
+/*
+ * State for one benchmarking thread.
+ */
+struct bench_thread_s
+  {
+  bench_case_t	*bench;			/* Benchmark. */
+  int		num_ops;		/* Operations to time. */
+  random_state	state;			/* Private random number stream. */
+  unsigned long	*keys;			/* Distinct keys in scrambled order. */
+  vpointer	*ptrs;			/* Allocated memory. */
+  MemChunk	*chunk;			/* Memory chunk. */
+  AVLTree	*tree;			/* AVL tree. */
+  SLList	**lists;		/* Linked lists. */
+  TableStruct	*table;			/* Table. */
+  unsigned long	checksum;		/* Defeats optimisation. */
+  double	elapsed;		/* Seconds. */
+#ifdef HAVE_PTHREADS
+  pthread_t	pid;			/* Thread. */
+#endif
+  };
+
+/*
+ * Allocators.
+ */
+typedef enum
+  {
+  BENCH_MALLOC, BENCH_SAFE, BENCH_DEBUG, BENCH_CHUNK, BENCH_MIMIC,
+  BENCH_NUM_ALLOCATORS
+  } bench_allocator_t;
+
+static const char *bench_allocator_names[BENCH_NUM_ALLOCATORS] =
+  { "malloc", "s_malloc_safe", "s_alloc_debug", "mem_chunk", "mem_chunk_mimic" };
+
+/*
+ * Allocation patterns.
+ */
+typedef enum
+  {
+  BENCH_PAIR, BENCH_FIFO, BENCH_LIFO, BENCH_RANDOM, BENCH_NUM_PATTERNS
+  } bench_pattern_t;
+
+static const char *bench_pattern_names[BENCH_NUM_PATTERNS] =
+  { "pair", "fifo", "lifo", "random" };
+
+static bench_case_t	bench_cases[BENCH_MAX_CASES];
+static int		bench_num_cases=0;
+
+/*
+ * Start barrier.
+ */
+#ifdef HAVE_PTHREADS
+static pthread_mutex_t	bench_start_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	bench_start_cond = PTHREAD_COND_INITIALIZER;
+static int		bench_waiting=0;
+static int		bench_generation=0;
+#endif
+
+/**********************************************************************
+  bench_key()
+  synopsis:	AVL tree key generator.  Data items are pointers to
+		keys.
+  parameters:	constvpointer data
+  return:	Key.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static AVLKey bench_key(constvpointer data)
+  {
+  return (AVLKey) *((const unsigned long *)data);
+  }
+
+
+/**********************************************************************
+  bench_alloc()
+  bench_free()
+  synopsis:	Allocate and free one atom with a given allocator.
+  parameters:	bench_thread_t *thread
+		const bench_allocator_t allocator
+  return:	Allocated memory.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static vpointer bench_alloc(bench_thread_t *thread, const bench_allocator_t allocator)
+  {
+  vpointer	mem=NULL;	/* Allocated memory. */
+
+  switch (allocator)
+    {
+    case BENCH_MALLOC:
+      mem = malloc(BENCH_ATOM_SIZE);
+      break;
+    case BENCH_SAFE:
+      mem = s_malloc_safe(BENCH_ATOM_SIZE, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+      break;
+    case BENCH_DEBUG:
+      mem = s_alloc_debug( MEMORY_MALLOC, BENCH_ATOM_SIZE, 1, NULL,
+                           __PRETTY_FUNCTION__, __FILE__, __LINE__, "benchmark" );
+      break;
+    case BENCH_CHUNK:
+      mem = mem_chunk_alloc_real(thread->chunk);
+      break;
+    case BENCH_MIMIC:
+      mem = mem_chunk_alloc_mimic(thread->chunk);
+      break;
+    default:
+      die("Unknown allocator.");
+    }
+
+  *((unsigned long *)mem) = thread->checksum;
+
+  return mem;
+  }
+
+static void bench_free(bench_thread_t *thread, const bench_allocator_t allocator, vpointer mem)
+  {
+
+  thread->checksum += *((unsigned long *)mem);
+
+  switch (allocator)
+    {
+    case BENCH_MALLOC:
+      free(mem);
+      break;
+    case BENCH_SAFE:
+      s_free_safe(mem, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+      break;
+    case BENCH_DEBUG:
+      s_free_debug(mem, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+      break;
+    case BENCH_CHUNK:
+      mem_chunk_free_real(thread->chunk, mem);
+      break;
+    case BENCH_MIMIC:
+      mem_chunk_free_mimic(thread->chunk, mem);
+      break;
+    default:
+      die("Unknown allocator.");
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  Allocation benchmarks.
+  One operation is one allocation and its deallocation.
+ **********************************************************************/
+
+static void bench_alloc_setup(bench_thread_t *thread)
+  {
+  bench_allocator_t	allocator=(bench_allocator_t) (thread->bench->variant/BENCH_NUM_PATTERNS);
+
+  if (allocator == BENCH_CHUNK)
+    thread->chunk = mem_chunk_new_real(BENCH_ATOM_SIZE, BENCH_BATCH);
+  else if (allocator == BENCH_MIMIC)
+    thread->chunk = mem_chunk_new_mimic(BENCH_ATOM_SIZE, BENCH_BATCH);
+
+  return;
+  }
+
+static void bench_alloc_run(bench_thread_t *thread)
+  {
+  bench_allocator_t	allocator=(bench_allocator_t) (thread->bench->variant/BENCH_NUM_PATTERNS);
+  bench_pattern_t	pattern=(bench_pattern_t) (thread->bench->variant%BENCH_NUM_PATTERNS);
+  vpointer		*ptrs=thread->ptrs;	/* Batch of allocations. */
+  int			i, j;			/* Loop over operations. */
+
+  if (pattern == BENCH_PAIR)
+    {
+    for (i=0; i<thread->num_ops; i++)
+      bench_free(thread, allocator, bench_alloc(thread, allocator));
+    return;
+    }
+
+  for (i=0; i<thread->num_ops; i+=BENCH_BATCH)
+    {
+    for (j=0; j<BENCH_BATCH; j++)
+      ptrs[j] = bench_alloc(thread, allocator);
+
+    switch (pattern)
+      {
+      case BENCH_FIFO:
+        for (j=0; j<BENCH_BATCH; j++)
+          bench_free(thread, allocator, ptrs[j]);
+        break;
+      case BENCH_LIFO:
+        for (j=BENCH_BATCH-1; j>=0; j--)
+          bench_free(thread, allocator, ptrs[j]);
+        break;
+      default:
+        for (j=0; j<BENCH_BATCH; j++)
+          bench_free(thread, allocator, ptrs[(j*BENCH_SCRAMBLE)&(BENCH_BATCH-1)]);
+        break;
+      }
+    }
+
+  return;
+  }
+
+static void bench_alloc_teardown(bench_thread_t *thread)
+  {
+  bench_allocator_t	allocator=(bench_allocator_t) (thread->bench->variant/BENCH_NUM_PATTERNS);
+
+  if (allocator == BENCH_CHUNK)
+    mem_chunk_destroy_real(thread->chunk);
+  else if (allocator == BENCH_MIMIC)
+    mem_chunk_destroy_mimic(thread->chunk);
+  thread->chunk = NULL;
+
+  return;
+  }
+
+
+/**********************************************************************
+  Random number benchmarks.
+  All but random_rand_shared use the thread's private stream.
+ **********************************************************************/
+
+static void bench_random_setup(bench_thread_t *thread)
+  {
+  random_seed_state(&(thread->state), 42);
+  random_set_thread_state(&(thread->state));
+  return;
+  }
+
+static void bench_random_teardown(bench_thread_t *thread)
+  {
+  random_set_thread_state(NULL);
+  return;
+  }
+
+static void bench_rand_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += random_rand();
+
+  return;
+  }
+
+static void bench_int_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += random_int(1000);
+
+  return;
+  }
+
+static void bench_double_run(bench_thread_t *thread)
+  {
+  double	sum=0.0;
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    sum += random_double(1.0);
+  thread->checksum += (unsigned long) sum;
+
+  return;
+  }
+
+static void bench_gaussian_run(bench_thread_t *thread)
+  {
+  double	sum=0.0;
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    sum += random_unit_gaussian();
+  thread->checksum += (unsigned long) fabs(sum);
+
+  return;
+  }
+
+
+/**********************************************************************
+  AVL tree benchmarks.
+  Keys are inserted, and looked up, in scrambled order.
+ **********************************************************************/
+
+static void bench_avltree_setup(bench_thread_t *thread)
+  {
+  thread->tree = avltree_new(bench_key);
+  return;
+  }
+
+static void bench_avltree_insert_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += avltree_insert(thread->tree, &(thread->keys[i]));
+
+  return;
+  }
+
+static void bench_avltree_lookup_setup(bench_thread_t *thread)
+  {
+  bench_avltree_setup(thread);
+  bench_avltree_insert_run(thread);
+  return;
+  }
+
+static void bench_avltree_lookup_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += *((unsigned long *)avltree_lookup_key(
+                            thread->tree, thread->keys[thread->keys[i]%thread->num_ops]));
+
+  return;
+  }
+
+static void bench_avltree_teardown(bench_thread_t *thread)
+  {
+  avltree_delete(thread->tree);
+  thread->tree = NULL;
+  return;
+  }
+
+
+/**********************************************************************
+  Linked list benchmarks.
+  Lists hold BENCH_LIST_SIZE items, so one append walks, on
+  average, half that many links.
+ **********************************************************************/
+
+static void bench_slink_append_run(bench_thread_t *thread)
+  {
+  int		i, j;		/* Loop over lists, items. */
+
+  for (i=0; i<thread->num_ops/BENCH_LIST_SIZE; i++)
+    {
+    thread->lists[i] = NULL;
+    for (j=0; j<BENCH_LIST_SIZE; j++)
+      thread->lists[i] = slink_append(thread->lists[i], &(thread->keys[j]));
+    }
+
+  return;
+  }
+
+static void bench_slink_nth_setup(bench_thread_t *thread)
+  {
+  int		j;		/* Loop over items. */
+
+  thread->lists[0] = NULL;
+  for (j=0; j<BENCH_LIST_SIZE; j++)
+    thread->lists[0] = slink_prepend(thread->lists[0], &(thread->keys[j]));
+
+  return;
+  }
+
+static void bench_slink_nth_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += *((unsigned long *)slink_nth_data(thread->lists[0], thread->keys[i]%BENCH_LIST_SIZE));
+
+  return;
+  }
+
+static void bench_slink_teardown(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops/BENCH_LIST_SIZE; i++)
+    slink_free_all(thread->lists[i]);
+
+  return;
+  }
+
+static void bench_slink_nth_teardown(bench_thread_t *thread)
+  {
+  slink_free_all(thread->lists[0]);
+  return;
+  }
+
+
+/**********************************************************************
+  Table benchmarks.
+  table_lookup_index() searches a table of BENCH_LIST_SIZE items.
+ **********************************************************************/
+
+static void bench_table_setup(bench_thread_t *thread)
+  {
+  thread->table = table_new();
+  return;
+  }
+
+static void bench_table_add_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += table_add(thread->table, &(thread->keys[i]));
+
+  return;
+  }
+
+static void bench_table_get_setup(bench_thread_t *thread)
+  {
+  bench_table_setup(thread);
+  bench_table_add_run(thread);
+  return;
+  }
+
+static void bench_table_get_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += *((unsigned long *)table_get_data(thread->table, thread->keys[i]%thread->num_ops));
+
+  return;
+  }
+
+static void bench_table_lookup_setup(bench_thread_t *thread)
+  {
+  int		i;
+
+  thread->table = table_new();
+  for (i=0; i<BENCH_LIST_SIZE; i++)
+    table_add(thread->table, &(thread->keys[i]));
+
+  return;
+  }
+
+static void bench_table_lookup_run(bench_thread_t *thread)
+  {
+  int		i;
+
+  for (i=0; i<thread->num_ops; i++)
+    thread->checksum += table_lookup_index(thread->table, &(thread->keys[thread->keys[i]%BENCH_LIST_SIZE]));
+
+  return;
+  }
+
+static void bench_table_teardown(bench_thread_t *thread)
+  {
+  table_destroy(thread->table);
+  thread->table = NULL;
+  return;
+  }
+
+
+/**********************************************************************
+  bench_add()
+  synopsis:	Add a benchmark to the list.
+  parameters:
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void bench_add( const char *name, const int variant, const boolean threadsafe,
+                       void (*setup)(bench_thread_t *thread),
+                       void (*run)(bench_thread_t *thread),
+                       void (*teardown)(bench_thread_t *thread) )
+  {
+  bench_case_t	*bench;		/* New benchmark. */
+
+  if (bench_num_cases == BENCH_MAX_CASES) die("Too many benchmarks.");
+
+  bench = &(bench_cases[bench_num_cases++]);
+  strncpy(bench->name, name, 63);
+  bench->name[63] = '\0';
+  bench->variant = variant;
+  bench->threadsafe = threadsafe;
+  bench->setup = setup;
+  bench->run = run;
+  bench->teardown = teardown;
+
+  return;
+  }
+
+
+/**********************************************************************
+  bench_define()
+  synopsis:	Define all benchmarks.  s_alloc_debug() keeps an
+		unlocked record of allocations, so may only be used
+		by one thread.
+  parameters:
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void bench_define(void)
+  {
+  char		name[64];	/* Benchmark name. */
+  int		a, p;		/* Loop over allocators, patterns. */
+
+  for (a=0; a<BENCH_NUM_ALLOCATORS; a++)
+    {
+    for (p=0; p<BENCH_NUM_PATTERNS; p++)
+      {
+      snprintf(name, 64, "alloc/%s/%s", bench_allocator_names[a], bench_pattern_names[p]);
+      bench_add( name, a*BENCH_NUM_PATTERNS+p, a!=BENCH_DEBUG,
+                 bench_alloc_setup, bench_alloc_run, bench_alloc_teardown );
+      }
+    }
+
+  bench_add("random/rand_shared", 0, TRUE, NULL, bench_rand_run, NULL);
+  bench_add("random/rand", 0, TRUE, bench_random_setup, bench_rand_run, bench_random_teardown);
+  bench_add("random/int", 0, TRUE, bench_random_setup, bench_int_run, bench_random_teardown);
+  bench_add("random/double", 0, TRUE, bench_random_setup, bench_double_run, bench_random_teardown);
+  bench_add("random/unit_gaussian", 0, TRUE, bench_random_setup, bench_gaussian_run, bench_random_teardown);
+
+  bench_add("avltree/insert", 0, TRUE, bench_avltree_setup, bench_avltree_insert_run, bench_avltree_teardown);
+  bench_add("avltree/lookup", 0, TRUE, bench_avltree_lookup_setup, bench_avltree_lookup_run, bench_avltree_teardown);
+
+  bench_add("slink/append", 0, TRUE, NULL, bench_slink_append_run, bench_slink_teardown);
+  bench_add("slink/nth", 0, TRUE, bench_slink_nth_setup, bench_slink_nth_run, bench_slink_nth_teardown);
+
+  bench_add("table/add", 0, TRUE, bench_table_setup, bench_table_add_run, bench_table_teardown);
+  bench_add("table/get_data", 0, TRUE, bench_table_get_setup, bench_table_get_run, bench_table_teardown);
+  bench_add("table/lookup_index", 0, TRUE, bench_table_lookup_setup, bench_table_lookup_run, bench_table_teardown);
+
+  return;
+  }
+
+
+/**********************************************************************
+  bench_thread()
+  synopsis:	Prepare, wait for all threads, then time one
+		repetition of a benchmark.
+  parameters:	void *data	The thread's bench_thread_t.
+  return:	NULL
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void *bench_thread(void *data)
+  {
+  bench_thread_t	*thread=(bench_thread_t *)data;
+  double		start;		/* Start time. */
+
+  if (thread->bench->setup) thread->bench->setup(thread);
+
+#ifdef HAVE_PTHREADS
+  pthread_mutex_lock(&bench_start_lock);
+  {
+  int	generation=bench_generation;
+
+  bench_waiting--;
+  if (bench_waiting == 0)
+    {
+    bench_generation++;
+    pthread_cond_broadcast(&bench_start_cond);
+    }
+  else
+    {
+    while (generation == bench_generation)
+      pthread_cond_wait(&bench_start_cond, &bench_start_lock);
+    }
+  }
+  pthread_mutex_unlock(&bench_start_lock);
+#endif
+
+  start = timer_monotonic();
+  thread->bench->run(thread);
+  thread->elapsed = timer_monotonic()-start;
+
+  if (thread->bench->teardown) thread->bench->teardown(thread);
+
+  return NULL;
+  }
+
+
+/**********************************************************************
+  bench_repetition()
+  synopsis:	Time one repetition of a benchmark on several
+		threads.
+  parameters:	bench_thread_t *threads
+		const int num_threads
+  return:	Longest time taken by any thread, in seconds.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static double bench_repetition(bench_thread_t *threads, const int num_threads)
+  {
+  double	elapsed=0.0;	/* Longest time. */
+  int		i;		/* Loop over threads. */
+
+#ifdef HAVE_PTHREADS
+  bench_waiting = num_threads;
+
+  for (i=0; i<num_threads; i++)
+    if (pthread_create(&(threads[i].pid), NULL, bench_thread, &(threads[i])) != 0)
+      die("Unable to create thread.");
+
+  for (i=0; i<num_threads; i++)
+    pthread_join(threads[i].pid, NULL);
+#else
+  bench_thread(&(threads[0]));
+#endif
+
+  for (i=0; i<num_threads; i++)
+    elapsed = MAX(elapsed, threads[i].elapsed);
+
+  return elapsed;
+  }
+
+
+/**********************************************************************
+  bench_compare_doubles()
+  synopsis:	Comparison for qsort().
+  parameters:
+  return:
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int bench_compare_doubles(const void *a, const void *b)
+  {
+  double	x=*((const double *)a), y=*((const double *)b);
+
+  return x<y ? -1 : x>y ? 1 : 0;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  int		repetitions=15;		/* Timed repetitions. */
+  double	min_seconds=0.02;	/* Minimum time for one repetition. */
+  int		max_threads=BENCH_MAX_THREADS;	/* Largest thread count. */
+  char		*only=NULL;		/* Benchmark name filter. */
+  char		*output=NULL;		/* Results file. */
+  FILE		*fp=NULL;		/* Results file handle. */
+  bench_thread_t	threads[BENCH_MAX_THREADS];	/* Thread states. */
+  double	times[BENCH_MAX_REPETITIONS];	/* ns per operation. */
+  double	median, mean, sd, rate, single=0.0;	/* Statistics. */
+  int		num_ops;		/* Operations per thread. */
+  int		num_threads;		/* Thread count. */
+  int		b, i, r;		/* Loop over benchmarks, threads, repetitions. */
+  boolean	first=TRUE;		/* First JSON record. */
+  boolean	calibrated=FALSE;	/* Whether num_ops is large enough. */
+
+  for (i=1; i<argc; i++)
+    {
+    if (strcmp(argv[i], "-r") == 0 && i+1 < argc) repetitions = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-m") == 0 && i+1 < argc) min_seconds = atof(argv[++i]);
+    else if (strcmp(argv[i], "-t") == 0 && i+1 < argc) max_threads = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-k") == 0 && i+1 < argc) only = argv[++i];
+    else if (strcmp(argv[i], "-o") == 0 && i+1 < argc) output = argv[++i];
+    else
+      {
+      printf("Usage: %s [-r repetitions] [-m min_seconds] [-t max_threads] [-k name] [-o results.json]\n", argv[0]);
+      exit(EXIT_FAILURE);
+      }
+    }
+
+  repetitions = MIN(MAX(repetitions, 1), BENCH_MAX_REPETITIONS);
+  max_threads = MIN(MAX(max_threads, 1), BENCH_MAX_THREADS);
+#ifndef HAVE_PTHREADS
+  max_threads = 1;
+#endif
+
+  random_seed(42);
+  bench_define();
+
+  if (output)
+    {
+    if ( !(fp = fopen(output, "w")) ) dief("Unable to open \"%s\".", output);
+    fprintf( fp, "{\"benchmark\":\"gaul_util\",\"version\":\"%d.%d-%d\",\"repetitions\":%d,\"results\":[\n",
+             GA_MAJOR_VERSION, GA_MINOR_VERSION, GA_PATCH_VERSION, repetitions );
+    }
+
+  printf( "%-34s %3s %10s %10s %10s %7s %10s %7s\n",
+          "benchmark", "thr", "median/ns", "min/ns", "mean/ns", "rsd/%", "Mops/s", "scaling" );
+
+  for (b=0; b<bench_num_cases; b++)
+    {
+    if (only && !strstr(bench_cases[b].name, only)) continue;
+
+/*
+ * Calibrate on one thread, so that a repetition takes at least
+ * min_seconds, then use the same number of operations per thread
+ * for every thread count.
+ */
+    num_ops = BENCH_MIN_OPS;
+    calibrated = FALSE;
+    while (!calibrated)
+      {
+      threads[0].bench = &(bench_cases[b]);
+      threads[0].num_ops = num_ops;
+      threads[0].checksum = 0;
+      if ( !(threads[0].keys = s_malloc(sizeof(unsigned long)*num_ops)) ||
+           !(threads[0].ptrs = s_malloc(sizeof(vpointer)*BENCH_BATCH)) ||
+           !(threads[0].lists = s_malloc(sizeof(SLList *)*(num_ops/BENCH_LIST_SIZE+1))) )
+        die("Unable to allocate memory");
+      for (i=0; i<num_ops; i++)
+        threads[0].keys[i] = (i*BENCH_SCRAMBLE) & 0xffffffffUL;
+      calibrated = bench_repetition(threads, 1) >= min_seconds || num_ops > INT_MAX/4;
+      s_free(threads[0].keys);
+      s_free(threads[0].ptrs);
+      s_free(threads[0].lists);
+      if (!calibrated) num_ops *= 2;
+      }
+
+    for (num_threads=1; num_threads<=max_threads; num_threads*=2)
+      {
+      if (num_threads > 1 && !bench_cases[b].threadsafe) break;
+
+      for (i=0; i<num_threads; i++)
+        {
+        threads[i].bench = &(bench_cases[b]);
+        threads[i].num_ops = num_ops;
+        threads[i].checksum = 0;
+        if ( !(threads[i].keys = s_malloc(sizeof(unsigned long)*num_ops)) ||
+             !(threads[i].ptrs = s_malloc(sizeof(vpointer)*BENCH_BATCH)) ||
+             !(threads[i].lists = s_malloc(sizeof(SLList *)*(num_ops/BENCH_LIST_SIZE+1))) )
+          die("Unable to allocate memory");
+        for (r=0; r<num_ops; r++)
+          threads[i].keys[r] = ((r+i)*BENCH_SCRAMBLE) & 0xffffffffUL;
+        }
+
+      bench_repetition(threads, num_threads);	/* Warm up. */
+
+      for (r=0; r<repetitions; r++)
+        times[r] = 1.0e9*bench_repetition(threads, num_threads)/num_ops;
+
+      for (i=0; i<num_threads; i++)
+        {
+        s_free(threads[i].keys);
+        s_free(threads[i].ptrs);
+        s_free(threads[i].lists);
+        }
+
+      mean = 0.0;
+      for (r=0; r<repetitions; r++)
+        mean += times[r];
+      mean /= repetitions;
+      sd = 0.0;
+      for (r=0; r<repetitions; r++)
+        sd += SQU(times[r]-mean);
+      sd = repetitions>1 ? sqrt(sd/(repetitions-1)) : 0.0;
+
+      qsort(times, repetitions, sizeof(double), bench_compare_doubles);
+      median = repetitions%2 ? times[repetitions/2] : 0.5*(times[repetitions/2-1]+times[repetitions/2]);
+
+      rate = 1.0e3*num_threads/median;		/* Millions of operations per second. */
+      if (num_threads == 1) single = rate;
+
+      printf( "%-34s %3d %10.2f %10.2f %10.2f %7.2f %10.2f %7.2f\n",
+              bench_cases[b].name, num_threads, median, times[0], mean,
+              100.0*sd/mean, rate, rate/(num_threads*single) );
+
+      if (fp)
+        {
+        fprintf( fp, "%s{\"benchmark\":\"%s\",\"threads\":%d,\"operations\":%d,"
+                     "\"median_ns\":%.3f,\"min_ns\":%.3f,\"mean_ns\":%.3f,\"stddev_ns\":%.3f,"
+                     "\"mops_per_second\":%.3f,\"scaling\":%.3f}",
+                 first?"":",\n", bench_cases[b].name, num_threads, num_ops,
+                 median, times[0], mean, sd, rate, rate/(num_threads*single) );
+        first = FALSE;
+        }
+      }
+    }
+
+  if (fp)
+    {
+    fprintf(fp, "\n]}\n");
+    fclose(fp);
+    }
+
+  exit(EXIT_SUCCESS);
+  }
@@ -75,5 +75,22 @@ else
   echo "PASSED"
 fi
 
+#
+# MPI test special case.  This needs several processes, so it is run
+# with $MPIRUN (default "mpirun -np 4"), and only if GAUL was compiled
+# with MPI support.
+#
+
+echo -n "test_mpi... "
+if grep -q "define HAVE_MPI 1" ../config.h; then
+  if [ `${MPIRUN:-mpirun -np 4} ./test_mpi | grep -c "identical to serial run\|destinations honoured"` -ne 5 ]; then
+    echo "FAILED - please check on the output of '${MPIRUN:-mpirun -np 4} ./test_mpi'."
+  else
+    echo "PASSED"
+  fi
+else
+  echo "SKIPPED - MPI support not compiled."
+fi
+
 
 
@@ -0,0 +1,226 @@
+/**********************************************************************
+  test_archipelago_forked.c
+ **********************************************************************
+
+  test_archipelago_forked - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's multi-process island model.
+
+		This program aims to solve a function of the form
+		(0.75-A)+(0.95-B)^2+(0.23-C)^3+(0.71-D)^4 = 0
+		using four islands, each evolving in its own process.
+		The second island's process kills itself part way
+		through the run, and should be restarted from its
+		latest snapshot.  Since migration depends on process
+		timing, only the outcome is checked.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#include <signal.h>
+#include <sys/mman.h>
+
+#define NUM_ISLANDS		4
+#define MAX_GENERATIONS		200
+#define CRASH_GENERATION	30
+
+/*
+ * Shared with the island processes, so that the crash only happens
+ * once, and so that the restarted island's progress can be seen.
+ */
+typedef struct
+  {
+  int	crashed;		/* Whether the island has crashed. */
+  int	resumed;		/* First generation after the crash. */
+  } crash_t;
+
+static crash_t	*crash=NULL;
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		A, B, C, D;	/* Parameters. */
+
+  A = ((double *)this_entity->chromosome[0])[0];
+  B = ((double *)this_entity->chromosome[0])[1];
+  C = ((double *)this_entity->chromosome[0])[2];
+  D = ((double *)this_entity->chromosome[0])[3];
+
+  ga_entity_set_fitness(this_entity, -(fabs(0.75-A)+SQU(0.95-B)+fabs(CUBE(0.23-C))+FOURTH_POW(0.71-D)));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_seed()
+  synopsis:	Seed genetic data.
+  parameters:	population *pop
+		entity *adam
+  return:	success
+  last updated: 25 Nov 2002
+ **********************************************************************/
+
+static boolean test_seed(population *pop, entity *adam)
+  {
+
+/* Checks. */
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!adam) die("Null pointer to entity structure passed.");
+
+/* Seeding. */
+  ((double *)adam->chromosome[0])[0] = random_double(2.0);
+  ((double *)adam->chromosome[0])[1] = random_double(2.0);
+  ((double *)adam->chromosome[0])[2] = random_double(2.0);
+  ((double *)adam->chromosome[0])[3] = random_double(2.0);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_generation_hook()
+  synopsis:	Kill the second island's process once, and note where
+		its replacement resumes.
+  parameters:	const int generation
+		population *pop
+  return:	TRUE
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_generation_hook(const int generation, population *pop)
+  {
+
+  if (pop->island == 1)
+    {
+    if (!crash->crashed && generation == CRASH_GENERATION)
+      {
+      crash->crashed = TRUE;
+      kill(getpid(), SIGKILL);
+      }
+    else if (crash->crashed && crash->resumed == 0)
+      {
+      crash->resumed = generation;
+      }
+    }
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population		*pops[NUM_ISLANDS];	/* Populations of solutions. */
+  int			i;			/* Loop over islands. */
+  int			generations;		/* Generations performed. */
+  double		best;			/* Best fitness. */
+
+  crash = mmap(NULL, sizeof(crash_t), PROT_READ|PROT_WRITE,
+               MAP_SHARED|MAP_ANON, -1, 0);
+  if (crash == MAP_FAILED) die("Unable to map shared memory.");
+  crash->crashed = FALSE;
+  crash->resumed = 0;
+
+  random_seed(23091975);
+
+  for (i=0; i<NUM_ISLANDS; i++)
+    {
+    pops[i] = ga_genesis_double(
+       50,			/* const int              population_size */
+       1,			/* const int              num_chromo */
+       4,			/* const int              len_chromo */
+       test_generation_hook,	/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       test_seed,		/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+    ga_population_set_parameters(
+       pops[i],				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.05      		        /* double  migration */
+                              );
+
+    ga_population_set_migration_parameters(
+       pops[i],				/* population      *pop */
+       5,				/* const int       interval */
+       GA_EMIGRATION_BEST,		/* const ga_emigration_type emigration */
+       3,				/* const int       num_emigrants */
+       GA_IMMIGRATION_REPLACE_WORST	/* const ga_immigration_type immigration */
+                              );
+    }
+
+  ga_archipelago_set_topology(NUM_ISLANDS, pops, GA_TOPOLOGY_BIRING, 0);
+
+  generations = ga_evolution_archipelago_forked(NUM_ISLANDS, pops, MAX_GENERATIONS);
+
+  printf("%d generations performed.\n", generations);
+  printf("Island 1 %s, and resumed at generation %d.\n",
+         crash->crashed?"crashed":"did NOT crash", crash->resumed);
+
+  best = GA_MIN_FITNESS;
+  for (i=0; i<NUM_ISLANDS; i++)
+    {
+    printf( "Island %d: %d entities after %d generations.\n",
+            i, ga_population_get_size(pops[i]),
+            ga_population_get_generation(pops[i]) );
+
+    best = MAX(best, ga_entity_get_fitness(ga_get_entity_from_rank(pops[i], 0)));
+    ga_extinction(pops[i]);
+    }
+
+  printf("Fitness %s.\n", best>-0.01?"converged":"NOT converged");
+
+  munmap(crash, sizeof(crash_t));
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,307 @@
+/**********************************************************************
+  test_checkpoint.c
+ **********************************************************************
+
+  test_checkpoint - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's checkpointing.
+
+		Generational, steady-state and differential evolution
+		runs are checkpointed, stopped half way, restored into
+		fresh populations and continued.  Each result must be
+		identical to an uninterrupted run.  The generational
+		run is also restored from a checkpoint file whose
+		final frame has been truncated.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIMS	8
+#define POP_SIZE	50
+#define FILENAME	"test_checkpoint.ckpt"
+
+/*
+ * The evolutionary drivers under test.
+ */
+typedef enum
+  {
+  TEST_GENERATIONAL, TEST_STEADY_STATE, TEST_DE
+  } test_driver_t;
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Sphere function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Sphere function. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += x*x;
+    }
+
+  ga_entity_set_fitness(this_entity, -sum);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_population()
+  synopsis:	Create a population.
+  parameters:	const test_driver_t driver
+  return:	New population.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static population *test_population(const test_driver_t driver)
+  {
+  population	*pop;		/* New population. */
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       ga_replace_by_fitness,	/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, -5.0);
+  ga_population_set_allele_max_double(pop, 5.0);
+
+  ga_population_set_parameters(
+       pop,				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+  if (driver == TEST_DE)
+    ga_population_set_differentialevolution_parameters(
+        pop, GA_DE_STRATEGY_RAND, GA_DE_CROSSOVER_BINOMIAL, 1, 0.5, 1.0, 0.8 );
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  test_run()
+  synopsis:	Run the evolutionary driver under test.
+  parameters:	population *pop
+		const test_driver_t driver
+		const int max_generations
+  return:	Generations performed.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static int test_run(population *pop, const test_driver_t driver, const int max_generations)
+  {
+
+  switch (driver)
+    {
+    case TEST_GENERATIONAL:
+      return ga_evolution(pop, max_generations);
+    case TEST_STEADY_STATE:
+      ga_evolution_steady_state(pop, max_generations);
+      return ga_population_get_generation(pop);
+    case TEST_DE:
+      return ga_differentialevolution(pop, max_generations);
+    }
+
+  return 0;
+  }
+
+
+/**********************************************************************
+  test_identical()
+  synopsis:	Compare the entities of two populations.
+  parameters:	population *pop1
+		population *pop2
+  return:	TRUE if identical.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_identical(population *pop1, population *pop2)
+  {
+  int		i;		/* Loop over ranks. */
+  entity	*e1, *e2;	/* Entities to compare. */
+
+  if (ga_population_get_size(pop1) != ga_population_get_size(pop2))
+    return FALSE;
+
+  for (i=0; i<ga_population_get_size(pop1); i++)
+    {
+    e1 = ga_get_entity_from_rank(pop1, i);
+    e2 = ga_get_entity_from_rank(pop2, i);
+
+    if ( e1->fitness != e2->fitness ||
+         memcmp(e1->chromosome[0], e2->chromosome[0], NUM_DIMS*sizeof(double)) != 0 )
+      return FALSE;
+    }
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_truncate()
+  synopsis:	Remove the final bytes of a file, as if it had been
+		interrupted while being written.
+  parameters:	char *fname
+		const long num
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void test_truncate(char *fname, const long num)
+  {
+  FILE		*fp;		/* File handle. */
+  long		len;		/* File length. */
+
+  fp = fopen(fname, "rb");
+  fseek(fp, 0, SEEK_END);
+  len = ftell(fp);
+  fclose(fp);
+
+  if ( truncate(fname, len-num) != 0 )
+    dief("Unable to truncate \"%s\".", fname);
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_driver()
+  synopsis:	Compare an interrupted, checkpointed, run with an
+		uninterrupted run.
+  parameters:	const test_driver_t driver
+		char *name
+		const int max_generations
+		const int interval	Checkpoint interval.
+		const boolean truncated	Whether to truncate the file.
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void test_driver( const test_driver_t driver, char *name,
+                         const int max_generations, const int interval,
+                         const boolean truncated )
+  {
+  population	*reference, *pop;	/* Populations. */
+  int		generations;		/* Generations performed. */
+  int		restored;		/* Generation restored. */
+
+  random_seed(42);
+  reference = test_population(driver);
+  test_run(reference, driver, max_generations);
+
+/*
+ * Stop half way.
+ */
+  random_seed(42);
+  pop = test_population(driver);
+  ga_population_set_checkpoint_parameters(pop, FILENAME, interval, 4);
+  test_run(pop, driver, max_generations/2);
+  ga_extinction(pop);
+
+  if (truncated) test_truncate(FILENAME, 10);
+
+/*
+ * Restore, with a different random number generator state, and
+ * continue.
+ */
+  random_seed(7);
+  pop = test_population(driver);
+  ga_population_set_checkpoint_parameters(pop, FILENAME, interval, 4);
+  if ( !ga_population_checkpoint_restore(pop, FILENAME) )
+    {
+    printf("%s: checkpoint not found.\n", name);
+    }
+  else
+    {
+    restored = ga_population_get_generation(pop);
+    generations = test_run(pop, driver, max_generations);
+
+    printf( "%s: restored generation %d, continued to %d, %s.\n",
+            name, restored, generations,
+            test_identical(reference, pop)?"identical to uninterrupted run":"FAILED to match uninterrupted run" );
+    }
+
+  ga_extinction(reference);
+  ga_extinction(pop);
+  remove(FILENAME);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population	*pop;		/* Population. */
+
+  test_driver(TEST_GENERATIONAL, "ga_evolution()", 40, 1, FALSE);
+  test_driver(TEST_GENERATIONAL, "ga_evolution(), truncated", 40, 2, TRUE);
+  test_driver(TEST_STEADY_STATE, "ga_evolution_steady_state()", 400, 10, FALSE);
+  test_driver(TEST_DE, "ga_differentialevolution()", 30, 3, FALSE);
+
+  remove(FILENAME);
+  pop = test_population(TEST_GENERATIONAL);
+  ga_population_seed(pop);
+  printf( "Missing checkpoint file %s, %d entities retained.\n",
+          ga_population_checkpoint_restore(pop, FILENAME)?"FAILED to be detected":"detected",
+          ga_population_get_size(pop) );
+  ga_extinction(pop);
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,227 @@
+/**********************************************************************
+  test_compare.c
+ **********************************************************************
+
+  test_compare - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's all-pairs distance functions.
+
+		Distance matrices, rows of distance matrices and
+		nearest neighbours are compared with the pairwise
+		ga_compare_*() functions, for every built-in genome
+		type and for a user-supplied comparison function.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define POP_SIZE	150
+#define NUM_CHROMO	2
+#define LEN_CHROMO	67
+#define NUM_NEIGHBOURS	5
+#define NUM_ROWS	7
+#define TOLERANCE	1e-9
+
+/**********************************************************************
+  test_distance()
+  synopsis:	A comparison function which isn't built in.  The
+		difference in the sums of the alleles.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_distance(population *pop, entity *alpha, entity *beta)
+  {
+  double	sum=0.0;	/* Difference of sums. */
+  int		i, j;		/* Loop over chromosomes, alleles. */
+
+  for (i=0; i<pop->num_chromosomes; i++)
+    for (j=0; j<pop->len_chromosomes; j++)
+      sum += ((double *)alpha->chromosome[i])[j] - ((double *)beta->chromosome[i])[j];
+
+  return fabs(sum);
+  }
+
+
+/**********************************************************************
+  test_genesis()
+  synopsis:	Create a randomly seeded population.
+  parameters:	char *type	Genome type.
+  return:	New population.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static population *test_genesis(char *type)
+  {
+  population	*pop=NULL;	/* New population. */
+
+  if (!strcmp(type, "bitstring"))
+    pop = ga_genesis_bitstring(POP_SIZE, NUM_CHROMO, LEN_CHROMO,
+            NULL, NULL, NULL, NULL, NULL, ga_seed_bitstring_random,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+  else if (!strcmp(type, "boolean"))
+    pop = ga_genesis_boolean(POP_SIZE, NUM_CHROMO, LEN_CHROMO,
+            NULL, NULL, NULL, NULL, NULL, ga_seed_boolean_random,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+  else if (!strcmp(type, "char"))
+    pop = ga_genesis_char(POP_SIZE, NUM_CHROMO, LEN_CHROMO,
+            NULL, NULL, NULL, NULL, NULL, ga_seed_char_random,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+  else if (!strcmp(type, "integer"))
+    pop = ga_genesis_integer(POP_SIZE, NUM_CHROMO, LEN_CHROMO,
+            NULL, NULL, NULL, NULL, NULL, ga_seed_integer_random,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+  else
+    pop = ga_genesis_double(POP_SIZE, NUM_CHROMO, LEN_CHROMO,
+            NULL, NULL, NULL, NULL, NULL, ga_seed_double_random,
+            NULL, NULL, NULL, NULL, NULL, NULL, NULL);
+
+  ga_population_set_allele_min_integer(pop, -1000);
+  ga_population_set_allele_max_integer(pop, 1000);
+  ga_population_set_allele_min_double(pop, -10.0);
+  ga_population_set_allele_max_double(pop, 10.0);
+  ga_population_seed(pop);
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  test_compare()
+  synopsis:	Check the all-pairs functions against a pairwise
+		comparison function.
+  parameters:	population *pop
+		GAcompare compare
+		char *name	Name of comparison function.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_compare(population *pop, GAcompare compare, char *name)
+  {
+  double	*matrix, *rows, *distances;	/* Results. */
+  int		*neighbours;			/* Nearest neighbours. */
+  int		ranks[NUM_ROWS]={149, 0, 64, 63, 65, 128, 1};
+  double	expected, furthest;		/* Pairwise distances. */
+  boolean	ok_matrix=TRUE, ok_rows=TRUE, ok_neighbours=TRUE;
+  int		i, j, n;			/* Loop over entities, neighbours. */
+
+  matrix = s_malloc(POP_SIZE*POP_SIZE*sizeof(double));
+  rows = s_malloc(NUM_ROWS*POP_SIZE*sizeof(double));
+  distances = s_malloc(POP_SIZE*NUM_NEIGHBOURS*sizeof(double));
+  neighbours = s_malloc(POP_SIZE*NUM_NEIGHBOURS*sizeof(int));
+
+  ga_compare_matrix(pop, compare, matrix);
+  ga_compare_matrix_rows(pop, compare, NUM_ROWS, ranks, rows);
+  ga_compare_neighbours(pop, compare, NUM_NEIGHBOURS, neighbours, distances);
+
+  for (i=0; i<POP_SIZE; i++)
+    for (j=0; j<POP_SIZE; j++)
+      if ( fabs(matrix[i*POP_SIZE+j] -
+                compare(pop, ga_get_entity_from_rank(pop, i), ga_get_entity_from_rank(pop, j)))
+           > TOLERANCE*MAX(1.0, matrix[i*POP_SIZE+j]) )
+        ok_matrix = FALSE;
+
+  for (i=0; i<NUM_ROWS; i++)
+    for (j=0; j<POP_SIZE; j++)
+      if (rows[i*POP_SIZE+j] != matrix[ranks[i]*POP_SIZE+j]) ok_rows = FALSE;
+
+/*
+ * The neighbours must be in order, distinct from the entity, and no
+ * other entity may be nearer than the furthest of them.
+ */
+  for (i=0; i<POP_SIZE; i++)
+    {
+    furthest = distances[i*NUM_NEIGHBOURS+NUM_NEIGHBOURS-1];
+    for (n=0; n<NUM_NEIGHBOURS; n++)
+      {
+      j = neighbours[i*NUM_NEIGHBOURS+n];
+      expected = matrix[i*POP_SIZE+j];
+      if ( j == i || distances[i*NUM_NEIGHBOURS+n] != expected ||
+           (n > 0 && expected < distances[i*NUM_NEIGHBOURS+n-1]) )
+        ok_neighbours = FALSE;
+      }
+    n = 0;
+    for (j=0; j<POP_SIZE; j++)
+      if (j != i && matrix[i*POP_SIZE+j] < furthest) n++;
+    if (n >= NUM_NEIGHBOURS) ok_neighbours = FALSE;
+    }
+
+  printf( "%s: matrix %s, rows %s, neighbours %s.\n", name,
+          ok_matrix ? "correct" : "FAILED",
+          ok_rows ? "correct" : "FAILED",
+          ok_neighbours ? "correct" : "FAILED" );
+
+  s_free(matrix);
+  s_free(rows);
+  s_free(distances);
+  s_free(neighbours);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population	*pop;		/* Population. */
+
+  random_seed(42);
+
+  pop = test_genesis("bitstring");
+  test_compare(pop, ga_compare_bitstring_hamming, "ga_compare_bitstring_hamming");
+  test_compare(pop, ga_compare_bitstring_euclidean, "ga_compare_bitstring_euclidean");
+  ga_extinction(pop);
+
+  pop = test_genesis("boolean");
+  test_compare(pop, ga_compare_boolean_hamming, "ga_compare_boolean_hamming");
+  test_compare(pop, ga_compare_boolean_euclidean, "ga_compare_boolean_euclidean");
+  ga_extinction(pop);
+
+  pop = test_genesis("char");
+  test_compare(pop, ga_compare_char_hamming, "ga_compare_char_hamming");
+  test_compare(pop, ga_compare_char_euclidean, "ga_compare_char_euclidean");
+  ga_extinction(pop);
+
+  pop = test_genesis("integer");
+  test_compare(pop, ga_compare_integer_hamming, "ga_compare_integer_hamming");
+  test_compare(pop, ga_compare_integer_euclidean, "ga_compare_integer_euclidean");
+  ga_extinction(pop);
+
+  pop = test_genesis("double");
+  test_compare(pop, ga_compare_double_hamming, "ga_compare_double_hamming");
+  test_compare(pop, ga_compare_double_euclidean, "ga_compare_double_euclidean");
+  test_compare(pop, test_distance, "user function");
+  ga_extinction(pop);
+
+  exit(EXIT_SUCCESS);
+  }
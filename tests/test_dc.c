@@ -0,0 +1,336 @@
+/**********************************************************************
+  test_dc.c
+ **********************************************************************
+
+  test_dc - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's deterministic crowding.
+
+		A function of one real variable with five equal
+		peaks, sin^6(5 pi x), and "two-max" on bitstrings, are
+		optimised by deterministic crowding.  Every peak, or
+		both basins of two-max, should be held, and the mean
+		fitness should improve.
+
+		The final populations are required to be identical
+		when the offspring are generated by four threads
+		rather than one, and when the comparison function
+		isn't built in, so that each parent-child distance
+		is computed by the callback.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define POP_SIZE	100
+#define LEN_BITS	40
+#define NUM_PEAKS	5
+#define NUM_GENERATIONS	50
+
+/**********************************************************************
+  test_peaks()
+  synopsis:	Fitness function.  Five equal peaks, at x = 0.1,
+		0.3, 0.5, 0.7 and 0.9.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_peaks(population *pop, entity *this_entity)
+  {
+  double	*x=this_entity->chromosome[0];	/* Position. */
+
+  ga_entity_set_fitness(this_entity, pow(sin(5.0*M_PI*x[0]), 6.0));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_twomax()
+  synopsis:	Fitness function.  The larger of the number of bits
+		set and the number clear.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_twomax(population *pop, entity *this_entity)
+  {
+  int		j;		/* Loop over bits. */
+  int		count=0;	/* Bits set. */
+
+  for (j=0; j<pop->len_chromosomes; j++)
+    if (ga_bit_get(this_entity->chromosome[0], j)) count++;
+
+  ga_entity_set_fitness(this_entity, MAX(count, pop->len_chromosomes-count));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_euclidean()
+  synopsis:	A comparison function which isn't built in.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_euclidean(population *pop, entity *alpha, entity *beta)
+  {
+  return ga_compare_double_euclidean(pop, alpha, beta);
+  }
+
+
+/**********************************************************************
+  test_hamming()
+  synopsis:	A comparison function which isn't built in.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_hamming(population *pop, entity *alpha, entity *beta)
+  {
+  return ga_compare_bitstring_hamming(pop, alpha, beta);
+  }
+
+
+/**********************************************************************
+  test_mean()
+  synopsis:	Mean fitness of a population.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_mean(population *pop)
+  {
+  double	sum=0.0;	/* Sum of fitnesses. */
+  int		i;		/* Loop over entities. */
+
+  for (i=0; i<pop->size; i++)
+    sum += ga_get_entity_from_rank(pop, i)->fitness;
+
+  return sum/pop->size;
+  }
+
+
+/**********************************************************************
+  test_evolve_peaks()
+  synopsis:	Optimise the five peaks by deterministic crowding.
+  parameters:	GAcompare compare
+		const int num_threads
+		double *fitness		Returns final fitnesses, by rank.
+		boolean *improved	Returns whether the mean fitness
+					improved.
+  return:	Number of peaks held.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int test_evolve_peaks(GAcompare compare, const int num_threads,
+                             double *fitness, boolean *improved)
+  {
+  population	*pop;		/* Population. */
+  double	*x;		/* Position. */
+  double	mean;		/* Initial mean fitness. */
+  boolean	held[NUM_PEAKS];	/* Whether each peak is held. */
+  int		num_held=0;	/* Number of peaks held. */
+  int		i, j;		/* Loop over entities, peaks. */
+
+  random_seed(42);
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       1,			/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_peaks,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_allele_mixing,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, 0.0);
+  ga_population_set_allele_max_double(pop, 1.0);
+  ga_population_set_parameters(pop, GA_SCHEME_DARWIN, GA_ELITISM_PARENTS_SURVIVE, 1.0, 0.2, 0.0);
+  ga_population_set_deterministiccrowding_parameters(pop, compare);
+  ga_population_set_deterministiccrowding_threads(pop, num_threads);
+
+  ga_deterministiccrowding(pop, 0);
+  mean = test_mean(pop);
+
+  ga_deterministiccrowding(pop, NUM_GENERATIONS);
+  *improved = test_mean(pop) > mean;
+
+  for (j=0; j<NUM_PEAKS; j++)
+    held[j] = FALSE;
+
+  for (i=0; i<pop->size; i++)
+    {
+    x = ga_get_entity_from_rank(pop, i)->chromosome[0];
+    fitness[i] = ga_get_entity_from_rank(pop, i)->fitness;
+    for (j=0; j<NUM_PEAKS; j++)
+      if (fabs(x[0]-0.1-0.2*j) < 0.02) held[j] = TRUE;
+    }
+
+  for (j=0; j<NUM_PEAKS; j++)
+    if (held[j]) num_held++;
+
+  ga_extinction(pop);
+
+  return num_held;
+  }
+
+
+/**********************************************************************
+  test_evolve_twomax()
+  synopsis:	Optimise two-max by deterministic crowding.
+  parameters:	GAcompare compare
+		const int num_threads
+		double *fitness		Returns final fitnesses, by rank.
+		boolean *improved	Returns whether the mean fitness
+					improved.
+  return:	Number of basins held.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int test_evolve_twomax(GAcompare compare, const int num_threads,
+                              double *fitness, boolean *improved)
+  {
+  population	*pop;		/* Population. */
+  double	mean;		/* Initial mean fitness. */
+  int		count;		/* Bits set. */
+  boolean	ones=FALSE, zeros=FALSE;	/* Whether each basin is held. */
+  int		i, j;		/* Loop over entities, bits. */
+
+  random_seed(42);
+
+  pop = ga_genesis_bitstring(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       LEN_BITS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_twomax,		/* GAevaluate             evaluate */
+       ga_seed_bitstring_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       ga_mutate_bitstring_singlepoint,	/* GAmutate               mutate */
+       ga_crossover_bitstring_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_parameters(pop, GA_SCHEME_DARWIN, GA_ELITISM_PARENTS_SURVIVE, 1.0, 0.2, 0.0);
+  ga_population_set_deterministiccrowding_parameters(pop, compare);
+  ga_population_set_deterministiccrowding_threads(pop, num_threads);
+
+  ga_deterministiccrowding(pop, 0);
+  mean = test_mean(pop);
+
+  ga_deterministiccrowding(pop, NUM_GENERATIONS);
+  *improved = test_mean(pop) > mean;
+
+  for (i=0; i<pop->size; i++)
+    {
+    fitness[i] = ga_get_entity_from_rank(pop, i)->fitness;
+    count = 0;
+    for (j=0; j<LEN_BITS; j++)
+      if (ga_bit_get(ga_get_entity_from_rank(pop, i)->chromosome[0], j)) count++;
+    if (count > LEN_BITS/2) ones = TRUE;
+    if (count < LEN_BITS/2) zeros = TRUE;
+    }
+
+  ga_extinction(pop);
+
+  return ones + zeros;
+  }
+
+
+/**********************************************************************
+  test_same()
+  synopsis:	Whether two final populations agree.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_same(double *a, double *b)
+  {
+  int		i;		/* Loop over ranks. */
+
+  for (i=0; i<POP_SIZE; i++)
+    if (a[i] != b[i]) return FALSE;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  double	serial[POP_SIZE], threaded[POP_SIZE], direct[POP_SIZE];
+  boolean	improved, dummy;	/* Whether mean fitness improved. */
+  int		held;		/* Peaks held. */
+
+  held = test_evolve_peaks(ga_compare_double_euclidean, 1, serial, &improved);
+  test_evolve_peaks(ga_compare_double_euclidean, 4, threaded, &dummy);
+  test_evolve_peaks(test_euclidean, 1, direct, &dummy);
+  printf( "Five peaks: %s, %s, threads %s, callback %s.\n",
+          held == NUM_PEAKS ? "all held" : "FAILED",
+          improved ? "improved" : "FAILED",
+          test_same(serial, threaded) ? "exact" : "FAILED",
+          test_same(serial, direct) ? "exact" : "FAILED" );
+
+  held = test_evolve_twomax(ga_compare_bitstring_hamming, 1, serial, &improved);
+  test_evolve_twomax(ga_compare_bitstring_hamming, 4, threaded, &dummy);
+  test_evolve_twomax(test_hamming, 1, direct, &dummy);
+  printf( "Two-max: %s, %s, threads %s, callback %s.\n",
+          held == 2 ? "both held" : "FAILED",
+          improved ? "improved" : "FAILED",
+          test_same(serial, threaded) ? "exact" : "FAILED",
+          test_same(serial, direct) ? "exact" : "FAILED" );
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,420 @@
+/**********************************************************************
+  test_diversity.c
+ **********************************************************************
+
+  test_diversity - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's population diversity measures.
+
+		The measures are compared with direct computations
+		over every pair of entities, before and after parts of
+		the population change, and a diversity stopping
+		criterion is applied to an evolution.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define POP_SIZE	200
+#define LEN_BITS	61
+#define LEN_INTEGERS	32
+#define NUM_DIMS	5
+#define TOLERANCE	1e-9
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Number of bits set.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  int		i, j;		/* Loop over chromosomes, bits. */
+  int		count=0;	/* Bits set. */
+
+  for (i=0; i<pop->num_chromosomes; i++)
+    for (j=0; j<pop->len_chromosomes; j++)
+      if (ga_bit_get(this_entity->chromosome[i], j)) count++;
+
+  ga_entity_set_fitness(this_entity, count);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_close()
+  synopsis:	Whether two values agree to within a tolerance.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_close(double a, double b, double tolerance)
+  {
+  return fabs(a-b) <= tolerance;
+  }
+
+
+/**********************************************************************
+  test_bitstring_direct()
+  synopsis:	Mean normalised per-locus entropy and mean pairwise
+		Hamming distance of a bitstring population, computed
+		directly.
+  parameters:	population *pop
+		double *hamming		Returns the mean Hamming distance,
+					as a fraction of the loci.
+  return:	Mean entropy.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static double test_bitstring_direct(population *pop, double *hamming)
+  {
+  double	p, sum=0.0;	/* Frequency of set bit, sum of entropies. */
+  double	distance=0.0;	/* Sum of pairwise distances. */
+  int		count;		/* Bits set at locus. */
+  int		i, j, k;	/* Loop over chromosomes, loci, entities. */
+
+  for (i=0; i<pop->num_chromosomes; i++)
+    {
+    for (j=0; j<pop->len_chromosomes; j++)
+      {
+      count = 0;
+      for (k=0; k<pop->size; k++)
+        if (ga_bit_get(pop->entity_iarray[k]->chromosome[i], j)) count++;
+      p = (double) count/pop->size;
+      if (p > 0.0 && p < 1.0)
+        sum += -(p*log(p) + (1.0-p)*log(1.0-p))/log(2.0);
+      }
+    }
+
+  for (j=0; j<pop->size; j++)
+    for (k=j+1; k<pop->size; k++)
+      distance += ga_compare_bitstring_hamming(pop, pop->entity_iarray[j], pop->entity_iarray[k]);
+
+  *hamming = distance/(pop->size*(pop->size-1)/2.0)/(pop->num_chromosomes*pop->len_chromosomes);
+
+  return sum/(pop->num_chromosomes*pop->len_chromosomes);
+  }
+
+
+/**********************************************************************
+  test_bitstrings()
+  synopsis:	Check the bitstring measures.
+  parameters:
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_bitstrings(void)
+  {
+  population	*pop;		/* Population. */
+  double	entropy, hamming, direct, direct_hamming, simhash;
+  int		i, j;		/* Loop over entities, bits. */
+
+  pop = ga_genesis_bitstring(
+       POP_SIZE,		/* const int              population_size */
+       2,			/* const int              num_chromo */
+       LEN_BITS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_bitstring_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_seed(pop);
+
+  entropy = ga_diversity_bitstring_entropy(pop);
+  ga_diversity_get_entropy(pop, NULL, &hamming);
+  simhash = ga_diversity_bitstring_simhash(pop);
+  direct = test_bitstring_direct(pop, &direct_hamming);
+
+  printf( "Random bitstrings: entropy %s, Hamming distance %s, SimHash %s.\n",
+          test_close(entropy, direct, TOLERANCE) ? "exact" : "FAILED",
+          test_close(hamming, direct_hamming, TOLERANCE) ? "exact" : "FAILED",
+          test_close(simhash, 0.5, 0.05) ? "near 0.5" : "FAILED" );
+
+/*
+ * Change a quarter of the population, so that only those entities are
+ * recounted.
+ */
+  for (i=0; i<POP_SIZE/4; i++)
+    for (j=0; j<LEN_BITS; j++)
+      ga_bit_clear(pop->entity_iarray[i*4]->chromosome[0], j);
+
+  entropy = ga_diversity_bitstring_entropy(pop);
+  ga_diversity_get_entropy(pop, NULL, &hamming);
+  direct = test_bitstring_direct(pop, &direct_hamming);
+
+  printf( "Changed bitstrings: entropy %s, Hamming distance %s.\n",
+          test_close(entropy, direct, TOLERANCE) ? "exact" : "FAILED",
+          test_close(hamming, direct_hamming, TOLERANCE) ? "exact" : "FAILED" );
+
+/*
+ * Converge the population.
+ */
+  for (i=1; i<POP_SIZE; i++)
+    ga_entity_copy(pop, pop->entity_iarray[i], pop->entity_iarray[0]);
+
+  entropy = ga_diversity_bitstring_entropy(pop);
+  ga_diversity_get_entropy(pop, NULL, &hamming);
+  simhash = ga_diversity_bitstring_simhash(pop);
+
+  printf( "Converged bitstrings: entropy %s, Hamming distance %s, SimHash %s.\n",
+          entropy==0.0 ? "zero" : "FAILED",
+          hamming==0.0 ? "zero" : "FAILED",
+          simhash==0.0 ? "zero" : "FAILED" );
+
+  ga_extinction(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_integers()
+  synopsis:	Check the integer measures.
+  parameters:
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_integers(void)
+  {
+  population	*pop;		/* Population. */
+  int		*a, *b;		/* Chromosomes. */
+  double	jaccard=0.0;	/* Exact mean Jaccard distance. */
+  double	hamming=0.0;	/* Exact mean distance. */
+  double	minhash, sampled, lower, upper, exact;
+  int		same;		/* Matching alleles. */
+  int		i, j, k;	/* Loop over entities, alleles. */
+
+  pop = ga_genesis_integer(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       LEN_INTEGERS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_integer_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_integer(pop, 0);
+  ga_population_set_allele_max_integer(pop, 2);
+  ga_population_seed(pop);
+
+  for (i=0; i<POP_SIZE; i++)
+    {
+    for (j=i+1; j<POP_SIZE; j++)
+      {
+      a = (int *) pop->entity_iarray[i]->chromosome[0];
+      b = (int *) pop->entity_iarray[j]->chromosome[0];
+      same = 0;
+      for (k=0; k<LEN_INTEGERS; k++)
+        if (a[k] == b[k]) same++;
+      jaccard += 1.0 - (double) same/(2*LEN_INTEGERS-same);
+      hamming += ga_compare_integer_hamming(pop, pop->entity_iarray[i], pop->entity_iarray[j]);
+      }
+    }
+  jaccard /= POP_SIZE*(POP_SIZE-1)/2.0;
+  hamming /= POP_SIZE*(POP_SIZE-1)/2.0;
+
+  ga_population_set_diversity_pairs(pop, 5000);
+  minhash = ga_diversity_integer_minhash(pop);
+
+  printf( "Integers: MinHash %s.\n",
+          test_close(minhash, jaccard, 0.02) ? "near Jaccard distance" : "FAILED" );
+
+  sampled = ga_diversity_sampled(pop, ga_compare_integer_hamming, 2000, &lower, &upper);
+  exact = ga_diversity_sampled(pop, ga_compare_integer_hamming, POP_SIZE*POP_SIZE, NULL, NULL);
+
+  printf( "Integers: sampled interval %s, all pairs %s.\n",
+          lower<=hamming&&hamming<=upper&&lower<sampled&&sampled<upper ? "contains mean" : "FAILED",
+          test_close(exact, hamming, TOLERANCE*hamming) ? "exact" : "FAILED" );
+
+  ga_extinction(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_doubles()
+  synopsis:	Check the double measures.
+  parameters:
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_doubles(void)
+  {
+  population	*pop;		/* Population. */
+  double	centroid[NUM_DIMS], variance[NUM_DIMS];
+  double	mean, sum=0.0;	/* Direct values. */
+  double	spread;		/* Measured spread. */
+  boolean	ok=TRUE;	/* Whether centroid agrees. */
+  int		i, j;		/* Loop over dimensions, entities. */
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       NULL,			/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, 100.0);
+  ga_population_set_allele_max_double(pop, 110.0);
+  ga_population_seed(pop);
+
+  spread = ga_diversity_double_spread(pop);
+  ga_diversity_get_centroid(pop, centroid, variance);
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    mean = 0.0;
+    for (j=0; j<POP_SIZE; j++)
+      mean += ((double *)pop->entity_iarray[j]->chromosome[0])[i];
+    mean /= POP_SIZE;
+    if (!test_close(centroid[i], mean, TOLERANCE*mean)) ok = FALSE;
+    for (j=0; j<POP_SIZE; j++)
+      sum += SQU(((double *)pop->entity_iarray[j]->chromosome[0])[i] - mean);
+    }
+
+  printf( "Doubles: centroid %s, spread %s.\n",
+          ok ? "exact" : "FAILED",
+          test_close(spread, sqrt(sum/POP_SIZE), TOLERANCE) ? "exact" : "FAILED" );
+
+  ga_extinction(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_stop()
+  synopsis:	Check that a diversity stopping criterion halts an
+		evolution.
+  parameters:
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_stop(void)
+  {
+  population	*pop;		/* Population. */
+  int		generations;	/* Generations performed. */
+
+  pop = ga_genesis_bitstring(
+       50,			/* const int              population_size */
+       1,			/* const int              num_chromo */
+       LEN_BITS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_bitstring_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_bitstring_singlepoint,	/* GAmutate               mutate */
+       ga_crossover_bitstring_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_parameters(
+       pop,				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.05,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+  ga_population_set_diversity_stop(pop, ga_diversity_bitstring_entropy, 0.2);
+
+  generations = ga_evolution(pop, 1000);
+
+  printf( "Evolution %s.\n",
+          generations<1000&&ga_diversity_bitstring_entropy(pop)<0.2 ? "stopped at low diversity" : "FAILED to stop" );
+
+  ga_extinction(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+
+  random_seed(42);
+
+  test_bitstrings();
+  test_integers();
+  test_doubles();
+  test_stop();
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,261 @@
+/**********************************************************************
+  test_gradient_fd.c
+ **********************************************************************
+
+  test_gradient_fd - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's finite difference gradients.
+
+		The gradient of the negated, 4-dimensional, extended
+		Rosenbrock function is approximated by forward, central
+		and Richardson extrapolated differences, using several
+		threads, and compared with the analytical gradient.
+		The function is then maximised with ga_lbfgs() using
+		the finite difference gradient.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+/**********************************************************************
+  test_to_double()
+  synopsis:     Convert to double array.
+  parameters:
+  return:
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_to_double(population *pop, entity *this_entity, double *array)
+  {
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!this_entity) die("Null pointer to entity structure passed.");
+
+  array[0] = ((double *)this_entity->chromosome[0])[0];
+  array[1] = ((double *)this_entity->chromosome[0])[1];
+  array[2] = ((double *)this_entity->chromosome[0])[2];
+  array[3] = ((double *)this_entity->chromosome[0])[3];
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_from_double()
+  synopsis:     Convert from double array.
+  parameters:
+  return:
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_from_double(population *pop, entity *this_entity, double *array)
+  {
+
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!this_entity) die("Null pointer to entity structure passed.");
+
+  if (!this_entity->chromosome) die("Entity has no chromsomes.");
+
+  ((double *)this_entity->chromosome[0])[0] = array[0];
+  ((double *)this_entity->chromosome[0])[1] = array[1];
+  ((double *)this_entity->chromosome[0])[2] = array[2];
+  ((double *)this_entity->chromosome[0])[3] = array[3];
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		*x;		/* Parameters. */
+
+  x = (double *)this_entity->chromosome[0];
+
+  this_entity->fitness = -( 100.0*SQU(x[1]-SQU(x[0])) + SQU(1.0-x[0])
+                          + 100.0*SQU(x[3]-SQU(x[2])) + SQU(1.0-x[2]) );
+
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_gradient()
+  synopsis:	Analytical gradient of the fitness function.
+  parameters:
+  return:	RMS gradient.
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static double test_gradient(population *pop, entity *this_entity, double *x, double *grad)
+  {
+
+  grad[0] = 400.0*x[0]*(x[1]-SQU(x[0])) + 2.0*(1.0-x[0]);
+  grad[1] = -200.0*(x[1]-SQU(x[0]));
+  grad[2] = 400.0*x[2]*(x[3]-SQU(x[2])) + 2.0*(1.0-x[2]);
+  grad[3] = -200.0*(x[3]-SQU(x[2]));
+
+  return sqrt((SQU(grad[0])+SQU(grad[1])+SQU(grad[2])+SQU(grad[3]))/4.0);
+  }
+
+
+/**********************************************************************
+  test_seed()
+  synopsis:	Seed genetic data with the standard starting point.
+  parameters:	population *pop
+		entity *adam
+  return:	success
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_seed(population *pop, entity *adam)
+  {
+
+/* Checks. */
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!adam) die("Null pointer to entity structure passed.");
+
+/* Seeding. */
+  ((double *)adam->chromosome[0])[0] = -1.2;
+  ((double *)adam->chromosome[0])[1] = 1.0;
+  ((double *)adam->chromosome[0])[2] = -1.2;
+  ((double *)adam->chromosome[0])[3] = 1.0;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  compare_gradient()
+  synopsis:	Compare a finite difference gradient with the
+		analytical gradient.
+  parameters:
+  return:	none
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static void compare_gradient(population *pop, entity *solution,
+                             const char *label, const ga_gradient_difference_type type,
+                             const double *scale, const int num_threads)
+  {
+  double	x[4], analytical[4], numerical[4];	/* Double arrays. */
+  double	error=0.0;	/* Largest relative error. */
+  int		i;		/* Loop over dimensions. */
+
+  ga_population_set_gradient_difference_parameters(pop, type, 0.0, scale, num_threads);
+
+  test_to_double(pop, solution, x);
+  test_gradient(pop, solution, x, analytical);
+  ga_gradient_finite_difference(pop, solution, x, numerical);
+
+  for (i=0; i<4; i++)
+    error = MAX(error, fabs(numerical[i]-analytical[i])/MAX(1.0,fabs(analytical[i])));
+
+  printf( "%s: gradient = %.3f %.3f %.3f %.3f error %s\n",
+          label, numerical[0], numerical[1], numerical[2], numerical[3],
+          error<1.0e-5?"< 1e-5":">= 1e-5" );
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population		*pop;			/* Population of solutions. */
+  entity		*solution;		/* Optimised solution. */
+  double		scale[4]={1.0, 0.5, 1.0, 0.5};	/* Step scaling. */
+
+  random_seed(23091975);
+
+  pop = ga_genesis_double(
+       1,				/* const int              population_size */
+       1,				/* const int              num_chromo */
+       4,				/* const int              len_chromo */
+       NULL,				/* GAgeneration_hook      generation_hook */
+       NULL,				/* GAiteration_hook       iteration_hook */
+       NULL,				/* GAdata_destructor      data_destructor */
+       NULL,				/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,			/* GAevaluate             evaluate */
+       test_seed,			/* GAseed                 seed */
+       NULL,				/* GAadapt                adapt */
+       NULL,				/* GAselect_one           select_one */
+       NULL,				/* GAselect_two           select_two */
+       NULL,				/* GAmutate               mutate */
+       NULL,				/* GAcrossover            crossover */
+       NULL,				/* GAreplace              replace */
+       NULL				/* vpointer		User data */
+            );
+
+  ga_population_set_gradient_parameters(
+       pop,				/* population		*pop */
+       test_to_double,			/* const GAto_double	to_double */
+       test_from_double,		/* const GAfrom_double	from_double */
+       ga_gradient_finite_difference,	/* const GAgradient	gradient */
+       4,				/* const int		num_dimensions */
+       0.001				/* const double		step_size */
+                       );
+
+  solution = ga_get_free_entity(pop);
+  ga_entity_seed(pop, solution);
+  pop->evaluate(pop, solution);
+
+  compare_gradient(pop, solution, "Forward", GA_GRADIENT_DIFFERENCE_FORWARD, NULL, 1);
+  compare_gradient(pop, solution, "Central", GA_GRADIENT_DIFFERENCE_CENTRAL, NULL, 3);
+  compare_gradient(pop, solution, "Richardson", GA_GRADIENT_DIFFERENCE_RICHARDSON, scale, 0);
+
+/*
+ * Optimise using the finite difference gradient.
+ */
+  ga_lbfgs(pop, solution, 500);
+
+  printf( "L-BFGS: A = %f B = %f C = %f D = %f (fitness = %f)\n",
+          ((double *)solution->chromosome[0])[0],
+          ((double *)solution->chromosome[0])[1],
+          ((double *)solution->chromosome[0])[2],
+          ((double *)solution->chromosome[0])[3],
+          solution->fitness );
+
+  ga_entity_dereference(pop, solution);
+
+  ga_extinction(pop);
+
+  exit(EXIT_SUCCESS);
+  }
+
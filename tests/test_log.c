@@ -0,0 +1,167 @@
+/**********************************************************************
+  test_log.c
+ **********************************************************************
+
+  test_log - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's logging.
+
+		Several threads log many messages to a file, which
+		must contain every message, in order for each thread,
+		once the log is flushed.  Changing the log file must
+		write the queued messages to the previous file.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_THREADS	4
+#define NUM_MESSAGES	5000
+#define FILENAME	"test_log.log"
+#define FILENAME2	"test_log2.log"
+
+/**********************************************************************
+  test_messages()
+  synopsis:	Log a sequence of numbered messages.
+  parameters:	void *data	Thread number.
+  return:	NULL
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void *test_messages(void *data)
+  {
+  int		thread=*((int *)data);	/* Thread number. */
+  int		i;			/* Loop over messages. */
+
+  for (i=0; i<NUM_MESSAGES; i++)
+    plog(LOG_NORMAL, "thread %d message %d", thread, i);
+
+  return NULL;
+  }
+
+
+/**********************************************************************
+  test_check()
+  synopsis:	Check that a log file contains every message of each
+		thread, in order.
+  parameters:	char *fname
+		const int num_threads
+  return:	Number of messages found, or -1 if out of order.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static int test_check(char *fname, const int num_threads)
+  {
+  FILE		*fp;				/* File handle. */
+  char		line[LOG_MAX_LEN];		/* Line from file. */
+  int		next[NUM_THREADS+1];		/* Next message expected. */
+  int		thread, message;		/* Parsed message. */
+  int		i;				/* Loop over threads. */
+  int		num=0;				/* Messages found. */
+  boolean	ordered=TRUE;			/* Whether messages are in order. */
+
+  if ( !(fp = fopen(fname, "r")) ) return 0;
+
+  for (i=0; i<=NUM_THREADS; i++) next[i] = 0;
+
+  while (fgets(line, LOG_MAX_LEN, fp))
+    {
+    if (sscanf(line, "thread %d message %d", &thread, &message) != 2) continue;
+    if (thread < 0 || thread >= num_threads || message != next[thread])
+      ordered = FALSE;
+    else
+      next[thread]++;
+    num++;
+    }
+
+  fclose(fp);
+
+  return ordered?num:-1;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  int		id[NUM_THREADS+1];	/* Thread numbers. */
+  int		i;			/* Loop over threads. */
+  int		num_threads;		/* Threads used. */
+#ifdef HAVE_PTHREADS
+  pthread_t	thread[NUM_THREADS];	/* Threads. */
+#endif
+
+  remove(FILENAME);
+  remove(FILENAME2);
+
+  log_init(LOG_NORMAL, FILENAME, NULL, TRUE);
+
+  for (i=0; i<=NUM_THREADS; i++) id[i] = i;
+
+#ifdef HAVE_PTHREADS
+  num_threads = NUM_THREADS;
+  for (i=1; i<num_threads; i++)
+    {
+    if (pthread_create(&(thread[i]), NULL, test_messages, &(id[i])) != 0)
+      die("Unable to create thread.");
+    }
+  test_messages(&(id[0]));
+  for (i=1; i<num_threads; i++)
+    pthread_join(thread[i], NULL);
+#else
+  num_threads = 1;
+  test_messages(&(id[0]));
+#endif
+
+  log_flush();
+
+  i = test_check(FILENAME, num_threads);
+  printf( "Logged %d messages from each thread: %s.\n", NUM_MESSAGES,
+          i==num_threads*NUM_MESSAGES?"all present and in order":"FAILED" );
+
+/*
+ * Queued messages are written before the log file changes.
+ */
+  test_messages(&(id[num_threads]));
+  log_set_file(FILENAME2);
+  i = test_check(FILENAME, num_threads+1);
+  printf( "Changed log file: %s.\n",
+          i==(num_threads+1)*NUM_MESSAGES?"queued messages written to previous file":"FAILED" );
+
+  test_messages(&(id[0]));
+  log_flush();
+  printf( "New log file: %s.\n",
+          test_check(FILENAME2, 1)==NUM_MESSAGES?"all present and in order":"FAILED" );
+
+  remove(FILENAME);
+  remove(FILENAME2);
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,381 @@
+/**********************************************************************
+  test_migration.c
+ **********************************************************************
+
+  test_migration - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's island model migration
+		topologies and policies.
+
+		Sixteen small islands minimise the Rastrigin function
+		in RASTRIGIN_DIMS dimensions, using each of the
+		standard migration topologies in turn, and the
+		number of generations and evaluations required to
+		reach a target fitness are compared.  The threaded
+		island model is then run with the same policies.
+
+		Finally, each topology is used for a single migration
+		with ga_evolution_archipelago_mp(), between islands
+		whose entities are tagged with their island's number,
+		and every island must receive emigrants from exactly
+		the islands which send to it.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_ISLANDS	16
+#define ISLAND_SIZE	20
+#define RASTRIGIN_DIMS	8
+#define TARGET_FITNESS	-0.1
+#define MAX_GENERATIONS	2000
+
+static int	num_evaluations=0;	/* Evaluation counter. */
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Rastrigin function. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<RASTRIGIN_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += 10.0 + x*x - 10.0*cos(2.0*PI*x);
+    }
+
+  ga_entity_set_fitness(this_entity, -sum);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_score_counted()
+  synopsis:	Fitness function, which also counts evaluations.
+		Not thread-safe.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score_counted(population *pop, entity *this_entity)
+  {
+  num_evaluations++;
+
+  return test_score(pop, this_entity);
+  }
+
+
+/**********************************************************************
+  test_seed()
+  synopsis:	Seed genetic data.
+  parameters:	population *pop
+		entity *adam
+  return:	success
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_seed(population *pop, entity *adam)
+  {
+  int		i;		/* Loop over dimensions. */
+
+/* Checks. */
+  if (!pop) die("Null pointer to population structure passed.");
+  if (!adam) die("Null pointer to entity structure passed.");
+
+/* Seeding. */
+  for (i=0; i<RASTRIGIN_DIMS; i++)
+    ((double *)adam->chromosome[0])[i] = random_double_range(-5.12, 5.12);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_seed_tagged()
+  synopsis:	Seed genetic data, tagged with the island's number.
+  parameters:	population *pop
+		entity *adam
+  return:	success
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean test_seed_tagged(population *pop, entity *adam)
+  {
+  int		i;		/* Loop over dimensions. */
+
+  for (i=0; i<RASTRIGIN_DIMS; i++)
+    ((double *)adam->chromosome[0])[i] = pop->island;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_generation_hook()
+  synopsis:	Stop once the target fitness has been reached.
+  parameters:	const int generation
+		population *pop
+  return:	FALSE to stop.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_generation_hook(const int generation, population *pop)
+  {
+  return ga_get_entity_from_rank(pop, 0)->fitness < TARGET_FITNESS;
+  }
+
+
+/**********************************************************************
+  test_stop_hook()
+  synopsis:	Stop after the first migration.
+  parameters:	const int generation
+		population *pop
+  return:	FALSE to stop.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean test_stop_hook(const int generation, population *pop)
+  {
+  return FALSE;
+  }
+
+
+/**********************************************************************
+  test_archipelago()
+  synopsis:	Create an archipelago with the given topology.
+  parameters:	population **pops
+		const ga_topology_type topology
+		const int degree
+		GAgeneration_hook hook
+		GAevaluate evaluate
+		GAseed seed
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void test_archipelago( population **pops,
+                              const ga_topology_type topology,
+                              const int degree,
+                              GAgeneration_hook hook,
+                              GAevaluate evaluate,
+                              GAseed seed )
+  {
+  int		i;		/* Loop over islands. */
+
+  random_seed(23091975);
+
+  for (i=0; i<NUM_ISLANDS; i++)
+    {
+    pops[i] = ga_genesis_double(
+       ISLAND_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       RASTRIGIN_DIMS,		/* const int              len_chromo */
+       hook,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       evaluate,		/* GAevaluate             evaluate */
+       seed,			/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+    ga_population_set_parameters(
+       pops[i],				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+    ga_population_set_migration_parameters(
+       pops[i],				/* population      *pop */
+       5,				/* const int       interval */
+       GA_EMIGRATION_BEST,		/* const ga_emigration_type emigration */
+       2,				/* const int       num_emigrants */
+       GA_IMMIGRATION_REPLACE_WORST	/* const ga_immigration_type immigration */
+                              );
+    }
+
+  ga_archipelago_set_topology(NUM_ISLANDS, pops, topology, degree);
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_destinations()
+  synopsis:	Perform a single migration with
+		ga_evolution_archipelago_mp(), and check that every
+		island received emigrants from exactly the islands
+		which send to it.
+  parameters:	const ga_topology_type topology
+		const int degree
+		int *num_migrations	Returns number of source and
+					destination pairs found.
+  return:	TRUE if the destinations were honoured.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean test_destinations( const ga_topology_type topology,
+                                  const int degree, int *num_migrations )
+  {
+  population	*pops[NUM_ISLANDS];	/* Populations of solutions. */
+  boolean	received[NUM_ISLANDS][NUM_ISLANDS];	/* Whether source reached destination. */
+  boolean	sent;			/* Whether source sends to destination. */
+  boolean	honoured=TRUE;		/* Whether destinations were honoured. */
+  ga_migration_t	*params;	/* Source's migration parameters. */
+  int		d, s, i;		/* Loop over islands, entities. */
+
+  test_archipelago(pops, topology, degree, test_stop_hook, test_score, test_seed_tagged);
+
+  for (i=0; i<NUM_ISLANDS; i++)
+    ga_population_set_migration_parameters(pops[i], 1, GA_EMIGRATION_BEST, 1, GA_IMMIGRATION_ADD);
+
+  ga_evolution_archipelago_mp(NUM_ISLANDS, pops, 1);
+
+  *num_migrations = 0;
+  for (d=0; d<NUM_ISLANDS; d++)
+    {
+    for (s=0; s<NUM_ISLANDS; s++)
+      received[d][s] = FALSE;
+
+    for (i=0; i<pops[d]->size; i++)
+      received[d][(int) ((double *)pops[d]->entity_iarray[i]->chromosome[0])[0]] = TRUE;
+    }
+
+  for (s=0; s<NUM_ISLANDS; s++)
+    {
+    params = pops[s]->migration_params;
+
+    for (d=0; d<NUM_ISLANDS; d++)
+      {
+      if (d == s) continue;
+
+      sent = FALSE;
+      for (i=0; i<params->num_destinations; i++)
+        if (params->destinations[i] == d) sent = TRUE;
+
+      if (received[d][s]) (*num_migrations)++;
+      if (received[d][s] != sent) honoured = FALSE;
+      }
+    }
+
+  for (i=0; i<NUM_ISLANDS; i++)
+    ga_extinction(pops[i]);
+
+  return honoured;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population		*pops[NUM_ISLANDS];	/* Populations of solutions. */
+  entity		*best;			/* Fittest entity. */
+  int			i, t;			/* Loop over islands, topologies. */
+  int			generations;		/* Generations performed. */
+  int			num_migrations;		/* Source and destination pairs. */
+  boolean		honoured;		/* Whether destinations were honoured. */
+  ga_topology_type	topologies[] = { GA_TOPOLOGY_RING, GA_TOPOLOGY_BIRING,
+                                         GA_TOPOLOGY_TORUS, GA_TOPOLOGY_HYPERCUBE,
+                                         GA_TOPOLOGY_FULL, GA_TOPOLOGY_RANDOM };
+  char			*names[] = { "ring", "bi-directional ring", "torus",
+                                     "hypercube", "fully connected", "random-3" };
+
+  for (t=0; t<6; t++)
+    {
+    test_archipelago(pops, topologies[t], 3, test_generation_hook, test_score_counted, test_seed);
+
+    num_evaluations = 0;
+    generations = ga_evolution_archipelago(NUM_ISLANDS, pops, MAX_GENERATIONS);
+
+    best = ga_get_entity_from_rank(pops[0], 0);
+    for (i=1; i<NUM_ISLANDS; i++)
+      {
+      if (ga_get_entity_from_rank(pops[i], 0)->fitness > best->fitness)
+        best = ga_get_entity_from_rank(pops[i], 0);
+      }
+
+    printf( "%-20s %4d generations %7d evaluations (best fitness = %f)\n",
+            names[t], generations, num_evaluations, ga_entity_get_fitness(best) );
+
+    for (i=0; i<NUM_ISLANDS; i++)
+      ga_extinction(pops[i]);
+    }
+
+/*
+ * The threaded island model, with a fixed number of generations, as
+ * the generation hook would stop the islands asynchronously.
+ */
+  test_archipelago(pops, GA_TOPOLOGY_HYPERCUBE, 0, NULL, test_score, test_seed);
+
+  generations = ga_evolution_archipelago_threaded(NUM_ISLANDS, pops, 200);
+
+  printf("Threaded hypercube: %d generations performed.\n", generations);
+
+  for (i=0; i<NUM_ISLANDS; i++)
+    {
+    printf( "Island %2d: fitness = %f size = %d\n",
+            i, ga_entity_get_fitness(ga_get_entity_from_rank(pops[i], 0)),
+            ga_population_get_size(pops[i]) );
+
+    ga_extinction(pops[i]);
+    }
+
+/*
+ * ga_evolution_archipelago_mp(), within this process.
+ */
+  for (t=0; t<6; t++)
+    {
+    honoured = test_destinations(topologies[t], 3, &num_migrations);
+    printf( "%-20s %3d migrations, %s\n", names[t], num_migrations,
+            honoured ? "destinations honoured" : "FAILED" );
+    }
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,418 @@
+/**********************************************************************
+  test_mpi.c
+ **********************************************************************
+
+  test_mpi - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's MPI evaluation farm.
+
+		Run this with, for example, "mpirun -np 4 test_mpi".
+		The rank 0 process evolves populations with
+		ga_evolution_mpi() and ga_evolution_archipelago_mpi(),
+		under Darwinian, Lamarckian and Baldwinian schemes,
+		while the other processes evaluate entities.  Each
+		result is compared with the equivalent serial run,
+		which must be identical.  Finally, every process
+		takes part in ga_evolution_archipelago_mp(), first
+		with the default cyclic topology, then with a single
+		migration along a graph which crosses the processes
+		in both directions, checking that each island
+		receives emigrants from exactly the islands which
+		send to it.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIMS	6
+#define POP_SIZE	60
+#define NUM_ISLANDS	4
+#define NUM_GENERATIONS	40
+
+#if HAVE_MPI != 1
+
+int main(int argc, char **argv)
+  {
+  printf("MPI support not compiled; nothing tested.\n");
+
+  exit(EXIT_SUCCESS);
+  }
+
+#else
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Sphere function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Sphere function. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += x*x;
+    }
+
+  ga_entity_set_fitness(this_entity, -sum);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_adapt()
+  synopsis:	Adaptation function.  Moves every parameter a little
+		towards the origin.  This must not use the random
+		number generator, since it runs on any process.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static entity *test_adapt(population *pop, entity *child)
+  {
+  entity		*adult;		/* Adapted entity. */
+  int			i;		/* Loop over dimensions. */
+
+  adult = ga_entity_clone(pop, child);
+
+  for (i=0; i<NUM_DIMS; i++)
+    ((double *)adult->chromosome[0])[i] *= 0.9;
+
+  test_score(pop, adult);
+
+  return adult;
+  }
+
+
+/**********************************************************************
+  test_seed()
+  synopsis:	Seed genetic data.
+  parameters:	population *pop
+		entity *adam
+  return:	success
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_seed(population *pop, entity *adam)
+  {
+  int		i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    ((double *)adam->chromosome[0])[i] = random_double_range(-5.0, 5.0);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_seed_tagged()
+  synopsis:	Seed genetic data, tagged with the island's number.
+  parameters:	population *pop
+		entity *adam
+  return:	success
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean test_seed_tagged(population *pop, entity *adam)
+  {
+  int		i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    ((double *)adam->chromosome[0])[i] = pop->island;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_stop()
+  synopsis:	Generation hook.  Stop after the first migration.
+  parameters:
+  return:	FALSE to stop.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static boolean test_stop(const int generation, population *pop)
+  {
+  return FALSE;
+  }
+
+
+/**********************************************************************
+  test_population()
+  synopsis:	Create a population.
+  parameters:	const int size
+		const ga_scheme_type scheme
+  return:	New population.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static population *test_population(const int size, const ga_scheme_type scheme)
+  {
+  population	*pop;		/* New population. */
+
+  pop = ga_genesis_double(
+       size,			/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       test_seed,		/* GAseed                 seed */
+       test_adapt,		/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_parameters(
+       pop,				/* population      *pop */
+       scheme,				/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  test_identical()
+  synopsis:	Compare the entities of two populations.
+  parameters:	population *pop1
+		population *pop2
+  return:	TRUE if identical.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_identical(population *pop1, population *pop2)
+  {
+  int		i;		/* Loop over ranks. */
+  entity	*e1, *e2;	/* Entities to compare. */
+
+  if (ga_population_get_size(pop1) != ga_population_get_size(pop2))
+    return FALSE;
+
+  for (i=0; i<ga_population_get_size(pop1); i++)
+    {
+    e1 = ga_get_entity_from_rank(pop1, i);
+    e2 = ga_get_entity_from_rank(pop2, i);
+
+    if ( e1->fitness != e2->fitness ||
+         memcmp(e1->chromosome[0], e2->chromosome[0], NUM_DIMS*sizeof(double)) != 0 )
+      return FALSE;
+    }
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_master()
+  synopsis:	Compare each MPI driver with its serial equivalent.
+  parameters:	none
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void test_master(void)
+  {
+  population		*serial, *parallel;	/* Populations. */
+  population		*serial_islands[NUM_ISLANDS];	/* Archipelagos. */
+  population		*parallel_islands[NUM_ISLANDS];
+  int			i, s;			/* Loop over islands, schemes. */
+  int			generations;		/* Generations performed. */
+  boolean		identical;		/* Whether runs agree. */
+  ga_scheme_type	schemes[] = { GA_SCHEME_DARWIN, GA_SCHEME_LAMARCK_CHILDREN,
+                                      GA_SCHEME_BALDWIN_ALL };
+  char			*names[] = { "Darwinian", "Lamarckian", "Baldwinian" };
+
+  for (s=0; s<3; s++)
+    {
+    random_seed(42);
+    serial = test_population(POP_SIZE, schemes[s]);
+    ga_evolution(serial, NUM_GENERATIONS);
+
+    random_seed(42);
+    parallel = test_population(POP_SIZE, schemes[s]);
+    generations = ga_evolution_mpi(parallel, NUM_GENERATIONS);
+
+    printf( "ga_evolution_mpi(), %s: %d generations, %s.\n",
+            names[s], generations,
+            test_identical(serial, parallel)?"identical to serial run":"FAILED to match serial run" );
+
+    ga_extinction(serial);
+    ga_extinction(parallel);
+    }
+
+  random_seed(42);
+  for (i=0; i<NUM_ISLANDS; i++)
+    serial_islands[i] = test_population(POP_SIZE/NUM_ISLANDS, GA_SCHEME_DARWIN);
+  ga_evolution_archipelago(NUM_ISLANDS, serial_islands, NUM_GENERATIONS);
+
+  random_seed(42);
+  for (i=0; i<NUM_ISLANDS; i++)
+    parallel_islands[i] = test_population(POP_SIZE/NUM_ISLANDS, GA_SCHEME_DARWIN);
+  generations = ga_evolution_archipelago_mpi(NUM_ISLANDS, parallel_islands, NUM_GENERATIONS);
+
+  identical = TRUE;
+  for (i=0; i<NUM_ISLANDS; i++)
+    {
+    identical = identical && test_identical(serial_islands[i], parallel_islands[i]);
+    ga_extinction(serial_islands[i]);
+    ga_extinction(parallel_islands[i]);
+    }
+
+  printf( "ga_evolution_archipelago_mpi(): %d generations, %s.\n",
+          generations, identical?"identical to serial run":"FAILED to match serial run" );
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population	*pop;				/* Slave's population. */
+  population	*islands[2];			/* Islands on this process. */
+  int		i;				/* Loop over islands. */
+  int		rank;				/* MPI rank. */
+  int		num_processes;			/* Number of MPI processes. */
+  int		generations;			/* Generations performed. */
+  int		total;				/* Islands on all processes. */
+  int		destinations[2];		/* Migration destinations. */
+  int		island, source, j;		/* Islands across all processes, entity. */
+  int		honoured, all_honoured;		/* Whether destinations were honoured. */
+
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_processes);
+
+  if (rank == 0)
+    {
+    test_master();
+    ga_detach_mpi_slaves();
+    }
+  else
+    {
+    pop = test_population(0, GA_SCHEME_DARWIN);
+    ga_attach_mpi_slave(pop);
+    ga_extinction(pop);
+    }
+
+/*
+ * Every process holds two islands, and passes emigrants to its
+ * neighbour.
+ */
+  random_seed(rank+1);
+  for (i=0; i<2; i++)
+    islands[i] = test_population(POP_SIZE/NUM_ISLANDS, GA_SCHEME_DARWIN);
+
+  generations = ga_evolution_archipelago_mp(2, islands, NUM_GENERATIONS);
+
+  if (rank == 0)
+    printf( "ga_evolution_archipelago_mp(): %d generations, %d entities on island 0.\n",
+            generations, ga_population_get_size(islands[0]) );
+
+  for (i=0; i<2; i++)
+    ga_extinction(islands[i]);
+
+/*
+ * Island n sends to islands n+2 and n-3, so that emigrants skip a
+ * process in one direction and cross one or two in the other.  This
+ * needs at least four islands.
+ */
+  if (num_processes > 1)
+    {
+    total = 2*num_processes;
+    honoured = TRUE;
+
+    for (i=0; i<2; i++)
+      {
+      island = 2*rank+i;
+      islands[i] = test_population(POP_SIZE/NUM_ISLANDS, GA_SCHEME_DARWIN);
+      islands[i]->seed = test_seed_tagged;
+      islands[i]->generation_hook = test_stop;
+      ga_population_set_migration_parameters(islands[i], 1, GA_EMIGRATION_BEST, 1, GA_IMMIGRATION_ADD);
+      destinations[0] = (island+2)%total;
+      destinations[1] = (island+total-3)%total;
+      ga_population_set_migration_destinations(islands[i], 2, destinations);
+      }
+
+    ga_evolution_archipelago_mp(2, islands, 1);
+
+    for (i=0; i<2; i++)
+      {
+      island = 2*rank+i;
+
+      for (source=0; source<total; source++)
+        {
+        if (source == island) continue;
+
+        for (j=0; j<islands[i]->size; j++)
+          if (((double *)islands[i]->entity_iarray[j]->chromosome[0])[0] == source) break;
+
+        if ( (j<islands[i]->size) !=
+             (island==(source+2)%total || island==(source+total-3)%total) )
+          honoured = FALSE;
+        }
+
+      ga_extinction(islands[i]);
+      }
+
+    MPI_Allreduce(&honoured, &all_honoured, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+
+    if (rank == 0)
+      printf( "ga_evolution_archipelago_mp() across %d islands: destinations %s.\n",
+              total, all_honoured ? "honoured" : "FAILED" );
+    }
+
+  MPI_Finalize();
+
+  exit(EXIT_SUCCESS);
+  }
+
+#endif
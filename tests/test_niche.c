@@ -0,0 +1,455 @@
+/**********************************************************************
+  test_niche.c
+ **********************************************************************
+
+  test_niche - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's niching.
+
+		A function of two real variables with four peaks of
+		differing heights, and "two-max" on bitstrings, are
+		optimised with and without fitness sharing, clearing
+		and restricted tournament replacement.  Niching should
+		hold every peak, or both basins of two-max, whereas the
+		plain GA converges on one.
+
+		The spatial indices are checked by repeating each
+		evolution with a comparison function which isn't built
+		in, so that every pair of entities is compared, and
+		requiring the same niches in every generation.
+
+		Sharing and clearing are also run with
+		GA_ELITISM_RESCORE_PARENTS and a fitness which changes
+		on every evaluation, requiring every entity to keep
+		its latest score.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define POP_SIZE	200
+#define LEN_BITS	40
+#define NUM_PEAKS	4
+#define NUM_GENERATIONS	50
+
+static double	peak[NUM_PEAKS][3]={ {0.25, 0.25, 1.00}, {0.25, 0.75, 0.95},
+                                     {0.75, 0.25, 0.90}, {0.75, 0.75, 0.85} };
+
+static int	niches[NUM_GENERATIONS+1];	/* Niches in each generation. */
+
+static struct
+  {
+  entity	*entity;	/* Entity evaluated. */
+  int		count;		/* Times evaluated. */
+  double	fitness;	/* Its latest score. */
+  } scores[4*POP_SIZE];
+static int	num_scores=0;	/* Entities evaluated. */
+
+/**********************************************************************
+  test_peaks()
+  synopsis:	Fitness function.  Four Gaussian peaks.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_peaks(population *pop, entity *this_entity)
+  {
+  double	*x=this_entity->chromosome[0];	/* Position. */
+  double	fitness=0.0;			/* Sum of peaks. */
+  int		i;				/* Loop over peaks. */
+
+  for (i=0; i<NUM_PEAKS; i++)
+    fitness += peak[i][2]*exp(-(SQU(x[0]-peak[i][0])+SQU(x[1]-peak[i][1]))/0.01);
+
+  ga_entity_set_fitness(this_entity, fitness);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_peaks_rescored()
+  synopsis:	Fitness function.  Four Gaussian peaks, with a small
+		offset which grows on every evaluation of an entity.
+		The latest score of every entity is recorded.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_peaks_rescored(population *pop, entity *this_entity)
+  {
+  int		i;		/* Loop over scores. */
+
+  test_peaks(pop, this_entity);
+
+  for (i=0; i<num_scores && scores[i].entity != this_entity; i++);
+
+  if (i == num_scores)
+    {
+    if (num_scores == 4*POP_SIZE) die("Too many entities");
+    scores[num_scores].entity = this_entity;
+    scores[num_scores].count = 0;
+    num_scores++;
+    }
+
+  scores[i].count++;
+  scores[i].fitness = this_entity->fitness + 1.0e-3*scores[i].count;
+  ga_entity_set_fitness(this_entity, scores[i].fitness);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_current()
+  synopsis:	Whether every entity has its latest score.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_current(population *pop)
+  {
+  int		i, j;		/* Loop over entities, scores. */
+
+  for (i=0; i<pop->size; i++)
+    {
+    for (j=0; j<num_scores && scores[j].entity != pop->entity_iarray[i]; j++);
+    if (j == num_scores || scores[j].fitness != pop->entity_iarray[i]->fitness)
+      return FALSE;
+    }
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_twomax()
+  synopsis:	Fitness function.  The larger of the number of bits
+		set and the number clear.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_twomax(population *pop, entity *this_entity)
+  {
+  int		j;		/* Loop over bits. */
+  int		count=0;	/* Bits set. */
+
+  for (j=0; j<pop->len_chromosomes; j++)
+    if (ga_bit_get(this_entity->chromosome[0], j)) count++;
+
+  ga_entity_set_fitness(this_entity, MAX(count, pop->len_chromosomes-count));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_generation()
+  synopsis:	Generation hook.  Records the niches found.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_generation(const int generation, population *pop)
+  {
+
+  if (generation <= NUM_GENERATIONS)
+    niches[generation] = ga_population_get_niches(pop);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_euclidean()
+  synopsis:	A comparison function which isn't built in, so that
+		niching compares every pair of entities.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_euclidean(population *pop, entity *alpha, entity *beta)
+  {
+  return ga_compare_double_euclidean(pop, alpha, beta);
+  }
+
+
+/**********************************************************************
+  test_hamming()
+  synopsis:	A comparison function which isn't built in, so that
+		niching compares every pair of entities.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_hamming(population *pop, entity *alpha, entity *beta)
+  {
+  return ga_compare_bitstring_hamming(pop, alpha, beta);
+  }
+
+
+/**********************************************************************
+  test_evolve_peaks()
+  synopsis:	Optimise the four peaks.
+  parameters:	const ga_niche_type type	Niching mode.
+		GAcompare compare
+		const ga_elitism_type elitism	Elitism mode.  Under
+						GA_ELITISM_RESCORE_PARENTS,
+						the fitness changes on every
+						evaluation.
+		int *history			Returns niches in each
+						generation.
+		boolean *current		Returns whether every
+						entity has its latest score.
+  return:	Number of peaks held.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int test_evolve_peaks(const ga_niche_type type, GAcompare compare, const ga_elitism_type elitism, int *history, boolean *current)
+  {
+  population	*pop;		/* Population. */
+  GAevaluate	evaluate=test_peaks;	/* Fitness function. */
+  double	*x;		/* Position. */
+  boolean	held[NUM_PEAKS];	/* Whether each peak is held. */
+  int		num_held=0;	/* Number of peaks held. */
+  int		i, j;		/* Loop over entities, peaks. */
+
+  random_seed(42);
+
+  num_scores = 0;
+  if (elitism == GA_ELITISM_RESCORE_PARENTS)
+    evaluate = test_peaks_rescored;
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       2,			/* const int              len_chromo */
+       test_generation,		/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       evaluate,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_allele_mixing,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, 0.0);
+  ga_population_set_allele_max_double(pop, 1.0);
+  ga_population_set_parameters(pop, GA_SCHEME_DARWIN, elitism, 0.8, 0.2, 0.0);
+  ga_population_set_niching_parameters(pop, type, compare, 0.2, 1.0, 1);
+
+  for (i=0; i<=NUM_GENERATIONS; i++)
+    niches[i] = -1;
+
+  ga_evolution(pop, NUM_GENERATIONS);
+
+  for (j=0; j<NUM_PEAKS; j++)
+    held[j] = FALSE;
+
+  for (i=0; i<pop->size; i++)
+    {
+    x = ga_get_entity_from_rank(pop, i)->chromosome[0];
+    for (j=0; j<NUM_PEAKS; j++)
+      if (SQU(x[0]-peak[j][0])+SQU(x[1]-peak[j][1]) < 0.01) held[j] = TRUE;
+    }
+
+  for (j=0; j<NUM_PEAKS; j++)
+    if (held[j]) num_held++;
+
+  if (history)
+    for (i=0; i<=NUM_GENERATIONS; i++)
+      history[i] = niches[i];
+
+  if (current)
+    *current = test_current(pop);
+
+  ga_extinction(pop);
+
+  return num_held;
+  }
+
+
+/**********************************************************************
+  test_evolve_twomax()
+  synopsis:	Optimise two-max.
+  parameters:	const ga_niche_type type	Niching mode.
+		GAcompare compare
+		int *history			Returns niches in each
+						generation.
+  return:	Number of basins held.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int test_evolve_twomax(const ga_niche_type type, GAcompare compare, int *history)
+  {
+  population	*pop;		/* Population. */
+  int		count;		/* Bits set. */
+  boolean	ones=FALSE, zeros=FALSE;	/* Whether each basin is held. */
+  int		i, j;		/* Loop over entities, bits. */
+
+  random_seed(42);
+
+  pop = ga_genesis_bitstring(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       LEN_BITS,		/* const int              len_chromo */
+       test_generation,		/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_twomax,		/* GAevaluate             evaluate */
+       ga_seed_bitstring_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_bitstring_singlepoint,	/* GAmutate               mutate */
+       ga_crossover_bitstring_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_parameters(pop, GA_SCHEME_DARWIN, GA_ELITISM_PARENTS_SURVIVE, 0.8, 0.2, 0.0);
+  ga_population_set_niching_parameters(pop, type, compare, LEN_BITS/4, 1.0, 1);
+
+  for (i=0; i<=NUM_GENERATIONS; i++)
+    niches[i] = -1;
+
+  ga_evolution(pop, NUM_GENERATIONS);
+
+  for (i=0; i<pop->size; i++)
+    {
+    count = 0;
+    for (j=0; j<LEN_BITS; j++)
+      if (ga_bit_get(ga_get_entity_from_rank(pop, i)->chromosome[0], j)) count++;
+    if (count > LEN_BITS/2) ones = TRUE;
+    if (count < LEN_BITS/2) zeros = TRUE;
+    }
+
+  if (history)
+    for (i=0; i<=NUM_GENERATIONS; i++)
+      history[i] = niches[i];
+
+  ga_extinction(pop);
+
+  return ones + zeros;
+  }
+
+
+/**********************************************************************
+  test_same()
+  synopsis:	Whether two histories of niches agree.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_same(int *a, int *b)
+  {
+  int		i;		/* Loop over generations. */
+
+  for (i=0; i<=NUM_GENERATIONS; i++)
+    if (a[i] != b[i]) return FALSE;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  static int	indexed[NUM_GENERATIONS+1], direct[NUM_GENERATIONS+1];
+  int		held;		/* Peaks held. */
+  boolean	current;	/* Whether scores are current. */
+
+  held = test_evolve_peaks(GA_NICHE_NONE, NULL, GA_ELITISM_PARENTS_SURVIVE, NULL, NULL);
+  printf("Four peaks, no niching: %s.\n", held < NUM_PEAKS ? "converged" : "FAILED");
+
+  held = test_evolve_peaks(GA_NICHE_SHARING, ga_compare_double_euclidean, GA_ELITISM_PARENTS_SURVIVE, indexed, NULL);
+  test_evolve_peaks(GA_NICHE_SHARING, test_euclidean, GA_ELITISM_PARENTS_SURVIVE, direct, NULL);
+  printf( "Four peaks, sharing: %s, k-d tree %s.\n",
+          held == NUM_PEAKS ? "all held" : "FAILED",
+          test_same(indexed, direct) ? "exact" : "FAILED" );
+
+  held = test_evolve_peaks(GA_NICHE_CLEARING, ga_compare_double_euclidean, GA_ELITISM_PARENTS_SURVIVE, indexed, NULL);
+  test_evolve_peaks(GA_NICHE_CLEARING, test_euclidean, GA_ELITISM_PARENTS_SURVIVE, direct, NULL);
+  printf( "Four peaks, clearing: %s, k-d tree %s.\n",
+          held == NUM_PEAKS ? "all held" : "FAILED",
+          test_same(indexed, direct) ? "exact" : "FAILED" );
+
+  held = test_evolve_peaks(GA_NICHE_RTR, ga_compare_double_euclidean, GA_ELITISM_PARENTS_SURVIVE, NULL, NULL);
+  printf( "Four peaks, restricted tournament replacement: %s.\n",
+          held == NUM_PEAKS ? "all held" : "FAILED" );
+
+  held = test_evolve_peaks(GA_NICHE_SHARING, ga_compare_double_euclidean, GA_ELITISM_RESCORE_PARENTS, NULL, &current);
+  printf( "Four peaks, sharing with rescoring: %s, scores %s.\n",
+          held == NUM_PEAKS ? "all held" : "FAILED",
+          current ? "current" : "FAILED" );
+
+  held = test_evolve_peaks(GA_NICHE_CLEARING, ga_compare_double_euclidean, GA_ELITISM_RESCORE_PARENTS, NULL, &current);
+  printf( "Four peaks, clearing with rescoring: %s, scores %s.\n",
+          held == NUM_PEAKS ? "all held" : "FAILED",
+          current ? "current" : "FAILED" );
+
+  held = test_evolve_twomax(GA_NICHE_NONE, NULL, NULL);
+  printf("Two-max, no niching: %s.\n", held < 2 ? "converged" : "FAILED");
+
+  held = test_evolve_twomax(GA_NICHE_SHARING, ga_compare_bitstring_hamming, indexed);
+  test_evolve_twomax(GA_NICHE_SHARING, test_hamming, direct);
+  printf( "Two-max, sharing: %s, hashing %s.\n",
+          held == 2 ? "both held" : "FAILED",
+          test_same(indexed, direct) ? "exact" : "FAILED" );
+
+  held = test_evolve_twomax(GA_NICHE_CLEARING, ga_compare_bitstring_hamming, indexed);
+  test_evolve_twomax(GA_NICHE_CLEARING, test_hamming, direct);
+  printf( "Two-max, clearing: %s, hashing %s.\n",
+          held == 2 ? "both held" : "FAILED",
+          test_same(indexed, direct) ? "exact" : "FAILED" );
+
+  held = test_evolve_twomax(GA_NICHE_RTR, ga_compare_bitstring_hamming, NULL);
+  printf( "Two-max, restricted tournament replacement: %s.\n",
+          held == 2 ? "both held" : "FAILED" );
+
+  exit(EXIT_SUCCESS);
+  }
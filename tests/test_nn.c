@@ -0,0 +1,192 @@
+/**********************************************************************
+  test_nn.c
+ **********************************************************************
+
+  test_nn - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for the neural network forward pass.
+
+		Networks of several shapes, including layers which
+		aren't a multiple of the padding, are run on random
+		inputs.  The outputs must match a straightforward
+		double precision forward pass to within 1e-5.  Clones,
+		copies and networks written to disk and read back must
+		give identical outputs.
+
+ **********************************************************************/
+
+#include "gaul.h"
+#include "gaul/nn_util.h"
+
+#define NUM_SHAPES	4
+#define NUM_INPUTS	100
+#define MAX_LAYERS	5
+#define MAX_NEURONS	64
+#define TOLERANCE	1.0e-5
+#define FILENAME	"test_nn.nn"
+
+static int	shape[NUM_SHAPES][MAX_LAYERS+1]={ {3, 2, 3, 1, 0, 0},
+                                                  {4, 7, 5, 3, 2, 0},
+                                                  {3, 8, 16, 4, 0, 0},
+                                                  {3, 37, 61, 9, 0, 0} };
+
+/**********************************************************************
+  test_reference()
+  synopsis:	The forward pass, one neuron at a time, in double
+		precision.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static void test_reference(network_t *network, float *input, double *output)
+  {
+  double	value[MAX_LAYERS][MAX_NEURONS+1];	/* Outputs of each layer. */
+  double	sum;		/* Weighted input. */
+  int		l, i, j;	/* Loop over layers, neurons, inputs. */
+
+  value[0][0] = network->layer[0].output[0];
+  for (i=1; i<=network->layer[0].neurons; i++)
+    value[0][i] = input[i-1];
+
+  for (l=1; l<network->num_layers; l++)
+    {
+    value[l][0] = network->layer[l].output[0];
+    for (i=1; i<=network->layer[l].neurons; i++)
+      {
+      sum = 0.0;
+      for (j=0; j<=network->layer[l-1].neurons; j++)
+        sum += network->layer[l].weight[i][j] * value[l-1][j];
+      value[l][i] = 1.0/(1.0+exp(-network->gain*sum));
+      }
+    }
+
+  for (i=1; i<=network->layer[network->num_layers-1].neurons; i++)
+    output[i-1] = value[network->num_layers-1][i];
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_shape()
+  synopsis:	Run a network, and its clone, copy and a version read
+		back from disk, on random inputs.
+  parameters:	int num_layers
+		int *neurons
+		boolean *same	Returns whether the clone, copy and
+				read back network gave identical
+				outputs.
+  return:	Largest difference from the reference.
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static double test_shape(int num_layers, int *neurons, boolean *same)
+  {
+  network_t	*network, *clone, *copy, *read;	/* Networks. */
+  float		input[MAX_NEURONS];		/* Input vector. */
+  float		output[MAX_NEURONS], output2[MAX_NEURONS];	/* Output vectors. */
+  double	expected[MAX_NEURONS];		/* Reference outputs. */
+  double	worst=0.0;			/* Largest difference. */
+  int		n, i;				/* Loop over inputs, neurons. */
+
+  network = NN_new(num_layers, neurons);
+  NN_randomize_weights(network, -2.0, 2.0);
+  NN_set_gain(network, 1.5);
+  NN_set_decay(network, 0.25);
+
+  clone = NN_clone(network);
+  copy = NN_new(num_layers, neurons);
+  NN_copy(network, copy);
+
+  NN_write(network, FILENAME);
+  read = NN_read(FILENAME);
+  remove(FILENAME);
+
+  *same = read->num_layers==network->num_layers && read->momentum==network->momentum &&
+          read->gain==network->gain && read->rate==network->rate &&
+          read->bias==network->bias && read->decay==network->decay;
+
+  for (n=0; n<NUM_INPUTS; n++)
+    {
+    for (i=0; i<neurons[0]; i++)
+      input[i] = random_float_range(-1.0, 1.0);
+
+    NN_run(network, input, output);
+    test_reference(network, input, expected);
+
+    for (i=0; i<neurons[num_layers-1]; i++)
+      worst = MAX(worst, fabs(output[i]-expected[i]));
+
+    NN_run(clone, input, output2);
+    for (i=0; i<neurons[num_layers-1]; i++)
+      if (output2[i] != output[i]) *same = FALSE;
+
+    NN_run(copy, input, output2);
+    for (i=0; i<neurons[num_layers-1]; i++)
+      if (output2[i] != output[i]) *same = FALSE;
+
+    NN_run(read, input, output2);
+    for (i=0; i<neurons[num_layers-1]; i++)
+      if (output2[i] != output[i]) *same = FALSE;
+    }
+
+  NN_destroy(network);
+  NN_destroy(clone);
+  NN_destroy(copy);
+  NN_destroy(read);
+
+  return worst;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  int		s;		/* Loop over shapes. */
+  int		num_layers;	/* Number of layers. */
+  boolean	same;		/* Whether clones agree. */
+  double	worst;		/* Largest difference from reference. */
+
+  random_seed(42);
+
+  for (s=0; s<NUM_SHAPES; s++)
+    {
+    for (num_layers=0; shape[s][num_layers]>0; num_layers++);
+
+    worst = test_shape(num_layers, shape[s], &same);
+    printf( "Shape %d: forward pass %s, clone, copy and file %s.\n", s,
+            worst < TOLERANCE ? "matches" : "FAILED",
+            same ? "identical" : "FAILED" );
+    }
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,234 @@
+/**********************************************************************
+  test_pack.c
+ **********************************************************************
+
+  test_pack - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's packed entity batches.
+
+		Selected entities from a multiobjective double-valued
+		population, and all entities from a bitstring-valued
+		population, are packed into contiguous buffers and
+		unpacked into empty copies of their populations, and
+		the results are compared with the originals.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Any values will do, so long as
+		the fitness vector is filled.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+
+  this_entity->fitvector[0] = random_double(1.0);
+  this_entity->fitvector[1] = random_double(1.0);
+  ga_entity_set_fitness(this_entity, this_entity->fitvector[0]+this_entity->fitvector[1]);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_score_bitstring()
+  synopsis:	Fitness function.  Counts set bits.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score_bitstring(population *pop, entity *this_entity)
+  {
+  int		i, j;		/* Loop over chromosomes, bits. */
+  int		count=0;	/* Number of set bits. */
+
+  for (i=0; i<pop->num_chromosomes; i++)
+    for (j=0; j<pop->len_chromosomes; j++)
+      if (ga_bit_get(this_entity->chromosome[i], j)) count++;
+
+  ga_entity_set_fitness(this_entity, (double) count);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_identical()
+  synopsis:	Compare two entities' fitnesses and serialised
+		chromosomes.
+  parameters:	population *pop
+		entity *a
+		population *copy
+		entity *b
+  return:	TRUE if identical.
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_identical(population *pop, entity *a, population *copy, entity *b)
+  {
+  gaulbyte	*bytes_a=NULL, *bytes_b=NULL;	/* Serialised chromosomes. */
+  unsigned int	max_a=0, max_b=0;		/* Serialisation buffer sizes. */
+  unsigned int	len_a, len_b;			/* Serialised lengths. */
+  boolean	identical;			/* Result. */
+  int		i;				/* Loop over fitness dimensions. */
+
+  identical = a->fitness == b->fitness;
+  for (i=0; i<pop->fitness_dimensions; i++)
+    identical = identical && a->fitvector[i] == b->fitvector[i];
+
+  len_a = pop->chromosome_to_bytes(pop, a, &bytes_a, &max_a);
+  len_b = copy->chromosome_to_bytes(copy, b, &bytes_b, &max_b);
+  identical = identical && len_a == len_b && memcmp(bytes_a, bytes_b, len_a) == 0;
+
+  if (max_a > 0) s_free(bytes_a);
+  if (max_b > 0) s_free(bytes_b);
+
+  return identical;
+  }
+
+
+/**********************************************************************
+  test_round_trip()
+  synopsis:	Pack entities, unpack them into an empty copy of the
+		population and compare.
+  parameters:	population *pop
+		const char *name
+		const int num
+		const int *ranks
+  return:	none
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static void test_round_trip(population *pop, const char *name, const int num, const int *ranks)
+  {
+  population	*copy;		/* Destination population. */
+  gaulbyte	*buffer;	/* Packed entities. */
+  unsigned int	len;		/* Size of buffer. */
+  unsigned int	used;		/* Bytes packed. */
+  int		num_unpacked;	/* Entities unpacked. */
+  boolean	identical=TRUE;	/* Whether the entities survived. */
+  int		i;		/* Loop over entities. */
+
+  len = ga_entities_packed_size(pop, num);
+  buffer = s_malloc(len);
+
+  used = ga_entities_pack(pop, num, ranks, buffer, len);
+
+  copy = ga_population_clone_empty(pop);
+  num_unpacked = ga_entities_unpack(copy, buffer, used);
+
+  printf( "Packed %d %s entities into %u of %u bytes, and unpacked %d.\n",
+          num, name, used, len, num_unpacked );
+
+  for (i=0; i<num_unpacked; i++)
+    identical = identical && test_identical(pop, pop->entity_iarray[ranks?ranks[i]:i],
+                                            copy, copy->entity_iarray[i]);
+
+  printf("%s entities %s.\n", name, identical?"restored exactly":"NOT restored");
+
+  ga_extinction(copy);
+  s_free(buffer);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population		*pop;			/* Population of solutions. */
+  int			ranks[] = { 3, 0, 7, 12 };	/* Entities to pack. */
+
+  random_seed(23091975);
+
+  pop = ga_genesis_double(
+       20,			/* const int              population_size */
+       1,			/* const int              num_chromo */
+       6,			/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_fitness_dimensions(pop, 2);
+  ga_population_seed(pop);
+  ga_population_score_and_sort(pop);
+
+  test_round_trip(pop, "double", 4, ranks);
+  test_round_trip(pop, "double", 0, NULL);
+
+  ga_extinction(pop);
+
+  pop = ga_genesis_bitstring(
+       10,			/* const int              population_size */
+       2,			/* const int              num_chromo */
+       37,			/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score_bitstring,	/* GAevaluate             evaluate */
+       ga_seed_bitstring_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_seed(pop);
+  ga_population_score_and_sort(pop);
+
+  test_round_trip(pop, "bitstring", ga_population_get_size(pop), NULL);
+
+  ga_extinction(pop);
+
+  exit(EXIT_SUCCESS);
+  }
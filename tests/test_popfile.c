@@ -0,0 +1,308 @@
+/**********************************************************************
+  test_popfile.c
+ **********************************************************************
+
+  test_popfile - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's population files.
+
+		A multiobjective double-valued population is written
+		in format 005 and read back in full, as its fittest
+		entities only, and by random access to individual
+		entities.  The same entities are then streamed to a
+		file in reverse order, which must be indexed in rank
+		order.  Finally, a file in the legacy format 004 is
+		read.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define POP_SIZE	200
+#define NUM_DIMS	5
+#define NUM_BEST	10
+#define FILENAME	"test_popfile.pop"
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double	*x=(double *)this_entity->chromosome[0];	/* Parameters. */
+
+  this_entity->fitvector[0] = x[0];
+  this_entity->fitvector[1] = x[1]*x[2];
+  ga_entity_set_fitness(this_entity, x[0]+x[1]+x[2]+x[3]+x[4]);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_identical()
+  synopsis:	Compare two entities.
+  parameters:	population *pop
+		entity *e1
+		entity *e2
+		const boolean fitvector	Whether to compare fitness vectors.
+  return:	TRUE if identical.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_identical(population *pop, entity *e1, entity *e2, const boolean fitvector)
+  {
+
+  if (e1->fitness != e2->fitness) return FALSE;
+  if ( fitvector &&
+       memcmp(e1->fitvector, e2->fitvector, pop->fitness_dimensions*sizeof(double)) != 0 )
+    return FALSE;
+
+  return memcmp(e1->chromosome[0], e2->chromosome[0], NUM_DIMS*sizeof(double)) == 0;
+  }
+
+
+/**********************************************************************
+  test_compare()
+  synopsis:	Compare the entities of a population with the
+		fittest entities of another.
+  parameters:	population *pop	Reference population.
+		population *in	Population read from disk.
+		const boolean fitvector	Whether to compare fitness vectors.
+  return:	TRUE if identical.
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static boolean test_compare(population *pop, population *in, const boolean fitvector)
+  {
+  int		i;		/* Loop over ranks. */
+
+  if (ga_population_get_size(in) > ga_population_get_size(pop)) return FALSE;
+
+  for (i=0; i<ga_population_get_size(in); i++)
+    {
+    if ( !test_identical(pop, ga_get_entity_from_rank(pop, i),
+                         ga_get_entity_from_rank(in, i), fitvector) )
+      return FALSE;
+    }
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_write_004()
+  synopsis:	Write a population in the legacy format 004, as
+		written by earlier versions of ga_population_write().
+  parameters:	population *pop
+		char *fname
+  return:	none
+  last updated: 16 Oct 2026
+ **********************************************************************/
+
+static void test_write_004(population *pop, char *fname)
+  {
+  FILE		*fp;			/* File handle. */
+  char		version[64];		/* Version string. */
+  int		id[21];			/* Callback ids. */
+  int		i;			/* Loop over entities. */
+  unsigned int	len;			/* Chromosome length. */
+  entity	*this_entity;		/* Entity to write. */
+
+  fp = fopen(fname, "w");
+
+  fwrite("FORMAT: GAUL POPULATION 004", sizeof(char), 27, fp);
+  memset(version, 0, 64);
+  fwrite(version, sizeof(char), 64, fp);
+
+  fwrite(&(pop->size), sizeof(int), 1, fp);
+  fwrite(&(pop->stable_size), sizeof(int), 1, fp);
+  fwrite(&(pop->num_chromosomes), sizeof(int), 1, fp);
+  fwrite(&(pop->len_chromosomes), sizeof(int), 1, fp);
+  fwrite(&(pop->crossover_ratio), sizeof(double), 1, fp);
+  fwrite(&(pop->mutation_ratio), sizeof(double), 1, fp);
+  fwrite(&(pop->migration_ratio), sizeof(double), 1, fp);
+  fwrite(&(pop->allele_mutation_prob), sizeof(double), 1, fp);
+  fwrite(&(pop->allele_min_integer), sizeof(int), 1, fp);
+  fwrite(&(pop->allele_max_integer), sizeof(int), 1, fp);
+  fwrite(&(pop->allele_min_double), sizeof(double), 1, fp);
+  fwrite(&(pop->allele_max_double), sizeof(double), 1, fp);
+  fwrite(&(pop->scheme), sizeof(int), 1, fp);
+  fwrite(&(pop->elitism), sizeof(int), 1, fp);
+  fwrite(&(pop->island), sizeof(int), 1, fp);
+
+/*
+ * Only the chromosome callbacks, in slots 6 to 11, are needed.
+ */
+  memset(id, 0, 21*sizeof(int));
+  id[6] = ga_funclookup_ptr_to_id((void *)ga_chromosome_double_allocate);
+  id[7] = ga_funclookup_ptr_to_id((void *)ga_chromosome_double_deallocate);
+  id[8] = ga_funclookup_ptr_to_id((void *)ga_chromosome_double_replicate);
+  id[9] = ga_funclookup_ptr_to_id((void *)ga_chromosome_double_to_bytes);
+  id[10] = ga_funclookup_ptr_to_id((void *)ga_chromosome_double_from_bytes);
+  id[11] = ga_funclookup_ptr_to_id((void *)ga_chromosome_double_to_string);
+  fwrite(id, sizeof(int), 21, fp);
+
+  len = NUM_DIMS*sizeof(double);
+  for (i=0; i<pop->size; i++)
+    {
+    this_entity = ga_get_entity_from_rank(pop, i);
+    fwrite(&(this_entity->fitness), sizeof(double), 1, fp);
+    fwrite(&len, sizeof(unsigned int), 1, fp);
+    fwrite(this_entity->chromosome[0], sizeof(gaulbyte), len, fp);
+    }
+
+  fwrite("END", sizeof(char), 4, fp);
+
+  fclose(fp);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population		*pop, *in, *empty;	/* Populations. */
+  ga_population_file	*file;			/* Population file. */
+  entity		*this_entity;		/* Entity read by rank. */
+  int			i;			/* Loop over entities. */
+  boolean		identical;		/* Whether entities match. */
+
+  random_seed(42);
+
+  pop = ga_genesis_double(
+       POP_SIZE,			/* const int              population_size */
+       1,				/* const int              num_chromo */
+       NUM_DIMS,			/* const int              len_chromo */
+       NULL,				/* GAgeneration_hook      generation_hook */
+       NULL,				/* GAiteration_hook       iteration_hook */
+       NULL,				/* GAdata_destructor      data_destructor */
+       NULL,				/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,			/* GAevaluate             evaluate */
+       ga_seed_double_random,		/* GAseed                 seed */
+       NULL,				/* GAadapt                adapt */
+       ga_select_one_bestof2,		/* GAselect_one           select_one */
+       ga_select_two_bestof2,		/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       NULL,				/* GAreplace              replace */
+       NULL				/* vpointer	User data */
+            );
+
+  ga_population_set_fitness_dimensions(pop, 2);
+  ga_population_set_allele_min_double(pop, -1.0);
+  ga_population_set_allele_max_double(pop, 1.0);
+  ga_population_seed(pop);
+  ga_population_score_and_sort(pop);
+
+/*
+ * Whole population.
+ */
+  ga_population_write(pop, FILENAME);
+  in = ga_population_read(FILENAME);
+  printf( "Read %d of %d entities: %s.\n",
+          ga_population_get_size(in), ga_population_get_size(pop),
+          test_compare(pop, in, TRUE)&&ga_population_get_size(in)==POP_SIZE?"identical":"FAILED" );
+  printf( "Fitness dimensions %d, allele range %.1f to %.1f.\n",
+          ga_population_get_fitness_dimensions(in),
+          ga_population_get_allele_min_double(in),
+          ga_population_get_allele_max_double(in) );
+  ga_extinction(in);
+
+/*
+ * Fittest entities only.
+ */
+  in = ga_population_read_best(FILENAME, NUM_BEST);
+  printf( "Read best %d entities: %s.\n",
+          ga_population_get_size(in),
+          test_compare(pop, in, TRUE)?"identical":"FAILED" );
+  ga_extinction(in);
+
+/*
+ * Random access.
+ */
+  file = ga_population_file_open(FILENAME);
+  empty = ga_population_clone_empty(pop);
+
+  identical = ga_population_file_get_size(file) == POP_SIZE;
+  for (i=POP_SIZE-1; i>=0; i-=7)
+    {
+    identical = identical &&
+                ga_population_file_get_fitness(file, i) == ga_get_entity_from_rank(pop, i)->fitness;
+    this_entity = ga_population_file_get_entity(file, empty, i);
+    identical = identical && test_identical(pop, ga_get_entity_from_rank(pop, i), this_entity, TRUE);
+    }
+
+  printf("Random access to %d entities: %s.\n", ga_population_get_size(empty), identical?"identical":"FAILED");
+
+  ga_population_file_close(file);
+  ga_extinction(empty);
+
+/*
+ * Streamed, in reverse order.
+ */
+  file = ga_population_file_create(pop, FILENAME);
+  for (i=POP_SIZE-1; i>=0; i--)
+    ga_population_file_append(file, pop, ga_get_entity_from_rank(pop, i));
+  ga_population_file_close(file);
+
+  in = ga_population_read(FILENAME);
+  printf( "Streamed %d entities in reverse: %s.\n",
+          ga_population_get_size(in),
+          test_compare(pop, in, TRUE)&&ga_population_get_size(in)==POP_SIZE?"ranked correctly":"FAILED" );
+  ga_extinction(in);
+
+/*
+ * Legacy format.
+ */
+  test_write_004(pop, FILENAME);
+  in = ga_population_read(FILENAME);
+  printf( "Read %d entities from format 004: %s.\n",
+          ga_population_get_size(in),
+          test_compare(pop, in, FALSE)&&ga_population_get_size(in)==POP_SIZE?"identical":"FAILED" );
+  ga_extinction(in);
+
+  in = ga_population_read_best(FILENAME, NUM_BEST);
+  printf( "Read best %d entities from format 004: %s.\n",
+          ga_population_get_size(in),
+          test_compare(pop, in, FALSE)?"identical":"FAILED" );
+  ga_extinction(in);
+
+  remove(FILENAME);
+  ga_extinction(pop);
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,255 @@
+/**********************************************************************
+  test_profile.c
+ **********************************************************************
+
+  test_profile - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's profiler.
+
+		Generational, steady-state and differential evolution
+		runs are profiled.  Each must give the same result as
+		an unprofiled run, every evaluation must appear in the
+		latency histogram and the phase times must be
+		consistent with the elapsed time.  Only these
+		reproducible facts, and the phases entered, are
+		displayed.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIMS	8
+#define POP_SIZE	50
+
+/*
+ * The evolutionary drivers under test.
+ */
+typedef enum
+  {
+  TEST_GENERATIONAL, TEST_STEADY_STATE, TEST_DE
+  } test_driver_t;
+
+/*
+ * Number of calls to the fitness function.
+ */
+static unsigned long	test_evaluations=0;
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Sphere function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Sphere function. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += x*x;
+    }
+
+  ga_entity_set_fitness(this_entity, -sum);
+
+  test_evaluations++;
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_population()
+  synopsis:	Create a population.
+  parameters:	const test_driver_t driver
+  return:	New population.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static population *test_population(const test_driver_t driver)
+  {
+  population	*pop;		/* New population. */
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       ga_replace_by_fitness,	/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, -5.0);
+  ga_population_set_allele_max_double(pop, 5.0);
+
+  ga_population_set_parameters(
+       pop,				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+  if (driver == TEST_DE)
+    ga_population_set_differentialevolution_parameters(
+        pop, GA_DE_STRATEGY_RAND, GA_DE_CROSSOVER_BINOMIAL, 1, 0.5, 1.0, 0.8 );
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  test_run()
+  synopsis:	Run the evolutionary driver under test.
+  parameters:	population *pop
+		const test_driver_t driver
+		const int max_generations
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_run(population *pop, const test_driver_t driver, const int max_generations)
+  {
+
+  switch (driver)
+    {
+    case TEST_GENERATIONAL:
+      ga_evolution(pop, max_generations);
+      break;
+    case TEST_STEADY_STATE:
+      ga_evolution_steady_state(pop, max_generations);
+      break;
+    case TEST_DE:
+      ga_differentialevolution(pop, max_generations);
+      break;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  test_driver()
+  synopsis:	Compare a profiled run with an unprofiled run, and
+		check the consistency of the profile.
+  parameters:	const test_driver_t driver
+		char *name
+		const int max_generations
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_driver( const test_driver_t driver, char *name,
+                         const int max_generations )
+  {
+  population	*reference, *pop;	/* Populations. */
+  double	start, elapsed;		/* Wall-clock time. */
+  double	wall, cpu, total=0.0;	/* Phase times. */
+  double	busy;			/* Thread time. */
+  unsigned long	calls;			/* Phase calls. */
+  unsigned long	evaluations;		/* Evaluations profiled. */
+  unsigned long	counts[GA_PROFILE_HISTOGRAM_BINS];	/* Latency histogram. */
+  unsigned long	binned=0;		/* Sum of histogram. */
+  int		i;			/* Loop over phases, bins. */
+
+  random_seed(42);
+  reference = test_population(driver);
+  test_run(reference, driver, max_generations);
+
+  random_seed(42);
+  pop = test_population(driver);
+  ga_population_set_profiling(pop, TRUE);
+  test_evaluations = 0;
+  start = timer_monotonic();
+  test_run(pop, driver, max_generations);
+  elapsed = timer_monotonic()-start;
+
+  printf( "%s: best fitness %s unprofiled run.\n", name,
+          ga_get_entity_from_rank(reference, 0)->fitness == ga_get_entity_from_rank(pop, 0)->fitness ?
+          "identical to" : "FAILED to match" );
+
+  printf("%s: phases", name);
+  for (i=0; i<GA_NUM_PHASES; i++)
+    {
+    ga_population_profile_get_phase(pop, (ga_phase_type) i, &wall, &cpu, &calls);
+    if (calls > 0) printf(" %s", ga_profile_phase_name((ga_phase_type) i));
+    if (wall < 0.0 || cpu < 0.0) printf(" (FAILED: negative time)");
+    total += wall;
+    }
+  printf(".\n");
+
+  evaluations = ga_population_profile_get_histogram(pop, counts);
+  for (i=0; i<GA_PROFILE_HISTOGRAM_BINS; i++)
+    binned += counts[i];
+  ga_population_profile_get_thread(pop, 0, NULL, &busy, NULL);
+
+  printf( "%s: evaluations %s, histogram %s, phase times %s.\n", name,
+          evaluations == test_evaluations ? "all counted" : "FAILED to be counted",
+          binned == evaluations ? "complete" : "FAILED",
+          total <= elapsed && busy <= elapsed ? "consistent" : "FAILED to be consistent" );
+
+  ga_population_set_profiling(pop, FALSE);
+  printf( "%s: profiling %s.\n", name,
+          ga_population_profile_get_phase(pop, GA_PHASE_SORT, NULL, NULL, NULL) ?
+          "FAILED to be disabled" : "disabled" );
+
+  ga_extinction(reference);
+  ga_extinction(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+
+  test_driver(TEST_GENERATIONAL, "ga_evolution()", 40);
+  test_driver(TEST_STEADY_STATE, "ga_evolution_steady_state()", 400);
+  test_driver(TEST_DE, "ga_differentialevolution()", 30);
+
+  exit(EXIT_SUCCESS);
+  }
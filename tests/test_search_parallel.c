@@ -0,0 +1,205 @@
+/**********************************************************************
+  test_search_parallel.c
+ **********************************************************************
+
+  test_search_parallel - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's parallel systematic search.
+
+		All 10^5 combinations of five decimal digits are
+		searched for the one closest to a target.  The search
+		is performed with one thread and with several threads,
+		and is then interrupted and resumed from its checkpoint
+		file.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIGITS	5
+#define NUM_STATES	100000
+#define CHECKPOINT_FNAME	"test_search_parallel.chk"
+
+static int	target[NUM_DIGITS]={3, 1, 4, 1, 5};
+
+/*
+ * Number of enumerations after which the iteration hook requests
+ * termination, or 0 for none.
+ */
+static int	stop_after=0;
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  int		i;		/* Loop over digits. */
+
+  this_entity->fitness = 0.0;
+
+  for (i=0; i<NUM_DIGITS; i++)
+    this_entity->fitness -= SQU(((int *)this_entity->chromosome[0])[i]-target[i]);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_scan_chromosome()
+  synopsis:	Generate the digits for an enumeration index.
+  parameters:
+  return:	TRUE for the final enumeration.
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_scan_chromosome(population *pop, entity *this_entity, int enumeration)
+  {
+  int		i;		/* Loop over digits. */
+  int		remainder=enumeration;	/* Undecoded part of index. */
+
+  for (i=NUM_DIGITS-1; i>=0; i--)
+    {
+    ((int *)this_entity->chromosome[0])[i] = remainder%10;
+    remainder /= 10;
+    }
+
+  return enumeration == NUM_STATES-1;
+  }
+
+
+/**********************************************************************
+  test_iteration_callback()
+  synopsis:	Simulates an interruption.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static boolean test_iteration_callback(int iteration, entity *solution)
+  {
+  return stop_after == 0 || iteration < stop_after;
+  }
+
+
+/**********************************************************************
+  print_solution()
+  synopsis:	Display a solution.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+static void print_solution(const char *label, entity *solution, const int num_evaluated)
+  {
+  int		i;		/* Loop over digits. */
+
+  printf("%s: evaluated %d, best = ", label, num_evaluated);
+  for (i=0; i<NUM_DIGITS; i++)
+    printf("%d", ((int *)solution->chromosome[0])[i]);
+  printf(" (fitness = %f)\n", solution->fitness);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	16 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population	*pop;			/* Population of solutions. */
+  entity	*solution;		/* Best solution. */
+  int		num_evaluated;		/* Enumerations evaluated. */
+
+  random_seed(23091975);
+
+  remove(CHECKPOINT_FNAME);
+
+  pop = ga_genesis_integer(
+       1,			/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIGITS,		/* const int              len_chromo */
+       NULL,		 	/* GAgeneration_hook      generation_hook */
+       test_iteration_callback,	/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       NULL,			/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace		replace */
+       NULL			/* vpointer		User data */
+            );
+
+  ga_population_set_search_parameters(pop, test_scan_chromosome);
+
+  solution = ga_get_free_entity(pop);
+
+/*
+ * Serial and threaded searches of the whole space.
+ */
+  ga_population_set_search_parallel(pop, 1, 1000, NULL, 0);
+  num_evaluated = ga_search_parallel(pop, solution, 0, NUM_STATES);
+  print_solution("1 thread", solution, num_evaluated);
+
+  ga_population_set_search_parallel(pop, 4, 1000, NULL, 0);
+  num_evaluated = ga_search_parallel(pop, solution, 0, NUM_STATES);
+  print_solution("4 threads", solution, num_evaluated);
+
+/*
+ * Interrupted, then resumed, search.
+ */
+  ga_population_set_search_parallel(pop, 1, 1000, CHECKPOINT_FNAME, 0);
+  stop_after = 40000;
+  num_evaluated = ga_search_parallel(pop, solution, 0, NUM_STATES);
+  print_solution("Interrupted", solution, num_evaluated);
+
+  ga_population_set_search_parallel(pop, 4, 1000, CHECKPOINT_FNAME, 0);
+  stop_after = 0;
+  num_evaluated = ga_search_parallel(pop, solution, 0, NUM_STATES);
+  print_solution("Resumed", solution, num_evaluated);
+
+  num_evaluated = ga_search_parallel(pop, solution, 0, NUM_STATES);
+  print_solution("Completed", solution, num_evaluated);
+
+  remove(CHECKPOINT_FNAME);
+
+  ga_extinction(pop);
+
+  exit(EXIT_SUCCESS);
+  }
+
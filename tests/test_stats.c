@@ -0,0 +1,234 @@
+/**********************************************************************
+  test_stats.c
+ **********************************************************************
+
+  test_stats - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's fitness statistics.
+
+		The statistics of small and large populations are
+		compared with two-pass moments and quantiles of sorted
+		fitnesses, and the cached statistics are checked after
+		the population has been re-evaluated and after
+		fitnesses have been set directly.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIMS	4
+#define TOLERANCE	1e-9
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  A skewed function of the alleles.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Fitness. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += x*x*x;
+    }
+
+  ga_entity_set_fitness(this_entity, sum + *((double *)pop->data));
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_compare()
+  synopsis:	Sort comparison function, ascending order.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static int test_compare(const void *a, const void *b)
+  {
+  double	x=*((const double *)a), y=*((const double *)b);
+
+  return x<y ? -1 : x>y ? 1 : 0;
+  }
+
+
+/**********************************************************************
+  test_close()
+  synopsis:	Whether two values agree to within a relative
+		tolerance.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_close(double a, double b)
+  {
+  return fabs(a-b) <= TOLERANCE*MAX(1.0, MAX(fabs(a), fabs(b)));
+  }
+
+
+/**********************************************************************
+  test_population()
+  synopsis:	Check the statistics of a population of the given
+		size.
+  parameters:	int size	Population size.
+  return:	none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void test_population(int size)
+  {
+  population	*pop;			/* Population. */
+  double	offset=0.0;		/* Added to all fitnesses. */
+  double	*x;			/* Sorted fitnesses. */
+  double	sum=0.0, mean, d;	/* Two-pass mean. */
+  double	m2=0.0, m3=0.0, m4=0.0;	/* Two-pass moments. */
+  double	variance, skew, kurtosis;	/* Expected values. */
+  double	maximum, minimum, gmean, median, gvariance, stddev, gkurtosis, gskew;
+  double	q, expected;		/* Quantile. */
+  boolean	ok=TRUE;		/* Whether quantiles agree. */
+  int		i;			/* Loop over entities. */
+
+  pop = ga_genesis_double(
+       size,			/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       NULL,			/* GAselect_one           select_one */
+       NULL,			/* GAselect_two           select_two */
+       NULL,			/* GAmutate               mutate */
+       NULL,			/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       &offset			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, -5.0);
+  ga_population_set_allele_max_double(pop, 5.0);
+  ga_population_seed(pop);
+  ga_population_score_and_sort(pop);
+
+  x = s_malloc(size*sizeof(double));
+  for (i=0; i<size; i++)
+    {
+    x[i] = ga_get_entity_from_rank(pop, i)->fitness;
+    sum += x[i];
+    }
+  qsort(x, size, sizeof(double), test_compare);
+  mean = sum/size;
+  for (i=0; i<size; i++)
+    {
+    d = x[i]-mean;
+    m2 += d*d;
+    m3 += d*d*d;
+    m4 += d*d*d*d;
+    }
+  variance = m2/size;
+  skew = variance>0.0 ? (m3/size)/pow(variance, 1.5) : 0.0;
+  kurtosis = variance>0.0 ? (m4/size)/(variance*variance) : 0.0;
+
+  ga_fitness_stats(pop, &maximum, &minimum, &gmean, &median, &gvariance, &stddev, &gkurtosis, &gskew);
+
+  printf( "%d entities: range %s, mean %s, moments %s, median %s.\n", size,
+          minimum==x[0]&&maximum==x[size-1] ? "correct" : "FAILED",
+          test_close(gmean, mean) ? "correct" : "FAILED",
+          test_close(gvariance, variance)&&test_close(stddev, sqrt(variance))&&
+          test_close(gskew, skew)&&test_close(gkurtosis, kurtosis) ? "correct" : "FAILED",
+          test_close(median, size%2 ? x[size/2] : (x[size/2-1]+x[size/2])/2) ? "exact" : "FAILED" );
+
+  for (i=0; i<=20; i++)
+    {
+    q = i/20.0;
+    d = q*(size-1);
+    expected = (int)d==size-1 ? x[size-1] : x[(int)d] + (d-(int)d)*(x[(int)d+1]-x[(int)d]);
+    ga_fitness_quantile(pop, q, &d);
+    if (!test_close(d, expected)) ok = FALSE;
+    }
+
+  printf("%d entities: quantiles %s.\n", size, ok ? "exact" : "FAILED");
+
+/*
+ * Re-evaluation must discard the cached statistics.
+ */
+  offset = 1000.0;
+  ga_population_score_and_sort(pop);
+  ga_fitness_mean(pop, &gmean);
+  ga_fitness_quantile(pop, 0.5, &median);
+
+  printf( "%d entities: statistics %s after re-evaluation.\n", size,
+          test_close(gmean, mean+1000.0)&&test_close(median, x[size/2]+(size%2 ? 0.0 : (x[size/2-1]-x[size/2])/2)+1000.0) ? "updated" : "FAILED to update" );
+
+/*
+ * So must setting fitnesses directly, and blanking an entity.
+ */
+  for (i=0; i<size; i++)
+    ga_entity_set_fitness(ga_get_entity_from_rank(pop, i), ga_get_entity_from_rank(pop, i)->fitness+1000.0);
+  ga_fitness_mean(pop, &gmean);
+  ga_entity_blank(pop, ga_get_entity_from_rank(pop, size-1));
+  ga_fitness_stats(pop, &maximum, &minimum, &d, &median, &gvariance, &stddev, &gkurtosis, &gskew);
+
+  printf( "%d entities: statistics %s after setting fitnesses.\n", size,
+          test_close(gmean, mean+2000.0)&&minimum==GA_MIN_FITNESS ? "updated" : "FAILED to update" );
+
+  s_free(x);
+  ga_extinction(pop);
+
+  return;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+
+  random_seed(42);
+
+  test_population(1);
+  test_population(100);
+  test_population(101);
+  test_population(10000);
+
+  exit(EXIT_SUCCESS);
+  }
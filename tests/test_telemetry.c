@@ -0,0 +1,225 @@
+/**********************************************************************
+  test_telemetry.c
+ **********************************************************************
+
+  test_telemetry - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's streaming telemetry.
+
+		An evolution is repeated with CSV, binary and
+		OpenMetrics telemetry, and the output is checked
+		against the evolution itself and against an evolution
+		without telemetry.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIMS	8
+#define POP_SIZE	50
+#define GENERATIONS	100
+#define INTERVAL	5
+#define FILENAME	"test_telemetry.dat"
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Sphere function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Sphere function. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += x*x;
+    }
+
+  ga_entity_set_fitness(this_entity, -sum);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_evolve()
+  synopsis:	Run an evolution, optionally with telemetry.
+  parameters:	ga_telemetry_format format
+		boolean telemetry	Whether to enable telemetry.
+		int *generations	Returns the generations performed.
+  return:	Best fitness.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static double test_evolve(ga_telemetry_format format, boolean telemetry, int *generations)
+  {
+  population	*pop;		/* Population. */
+  double	best;		/* Best fitness. */
+
+  random_seed(42);
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, -5.0);
+  ga_population_set_allele_max_double(pop, 5.0);
+
+  ga_population_set_parameters(
+       pop,				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+  if (telemetry && !ga_population_set_telemetry(pop, FILENAME, format, INTERVAL))
+    printf("FAILED to open telemetry file.\n");
+
+  *generations = ga_evolution(pop, GENERATIONS);
+  best = ga_get_entity_from_rank(pop, 0)->fitness;
+
+  if (telemetry && ga_population_telemetry_get_dropped(pop) != 0)
+    printf("FAILED: telemetry records dropped.\n");
+
+  ga_extinction(pop);
+
+  return best;
+  }
+
+
+/**********************************************************************
+  test_count()
+  synopsis:	Count the lines of the telemetry file which contain a
+		string.
+  parameters:	char *pattern
+  return:	Number of lines.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int test_count(char *pattern)
+  {
+  FILE		*fp;		/* File handle. */
+  char		line[1024];	/* One line of the file. */
+  int		count=0;	/* Number of occurrences. */
+
+  if ( !(fp = fopen(FILENAME, "r")) ) return -1;
+
+  while (fgets(line, 1024, fp))
+    if (strstr(line, pattern)) count++;
+
+  fclose(fp);
+
+  return count;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  ga_telemetry_record	*records;	/* Records read back. */
+  double		best, best0;	/* Best fitnesses. */
+  unsigned long		evaluations=0;	/* Evaluations recorded. */
+  boolean		ordered=TRUE;	/* Whether records are consistent. */
+  int			num;		/* Number of records. */
+  int			generations;	/* Generations performed. */
+  int			i;		/* Loop over records. */
+
+  best0 = test_evolve(GA_TELEMETRY_CSV, FALSE, &generations);
+
+/*
+ * CSV.  One header line, then one line per record.
+ */
+  best = test_evolve(GA_TELEMETRY_CSV, TRUE, &generations);
+  printf( "CSV: header %s, %s records, evolution %s.\n",
+          test_count("generation,elapsed,size,best,mean,stddev,diversity,evaluations,reused")==1 ? "written" : "FAILED",
+          test_count(",")==generations/INTERVAL+2 ? "all" : "FAILED: not all",
+          best==best0 ? "unchanged" : "FAILED: changed" );
+
+/*
+ * Binary stream, which is read back.
+ */
+  best = test_evolve(GA_TELEMETRY_BINARY, TRUE, &generations);
+  num = ga_telemetry_read(FILENAME, &records);
+  for (i=0; i<num; i++)
+    {
+    evaluations += records[i].evaluations;
+    if ( records[i].generation != i*INTERVAL || records[i].size < POP_SIZE ||
+         records[i].best < records[i].mean || records[i].stddev < 0.0 ||
+         records[i].diversity < 0.0 || records[i].diversity > 1.0 ||
+         (i > 0 && records[i].best < records[i-1].best) )
+      ordered = FALSE;
+    }
+  printf( "Binary: %s records, %s, evaluations %s, evolution %s.\n",
+          num==generations/INTERVAL+1 ? "all" : "FAILED: not all",
+          ordered ? "consistent" : "FAILED: inconsistent",
+          evaluations>=POP_SIZE ? "counted" : "FAILED",
+          best==best0 ? "unchanged" : "FAILED: changed" );
+  printf( "Binary: fitnesses %s, diversity %s.\n",
+          num>0&&records[num-1].reused>0 ? "reused" : "FAILED: none reused",
+          num>0&&records[num-1].diversity<records[0].diversity ? "decreasing" : "FAILED: not decreasing" );
+  s_free(records);
+
+/*
+ * OpenMetrics, which holds only the latest record.
+ */
+  best = test_evolve(GA_TELEMETRY_OPENMETRICS, TRUE, &generations);
+  printf( "OpenMetrics: %s exposition, %s phases, evolution %s.\n",
+          test_count("# EOF")==1&&test_count("gaul_evaluations_total")==1 ? "complete" : "FAILED: incomplete",
+          test_count("gaul_phase_seconds_total{phase=")==GA_NUM_PHASES ? "all" : "FAILED: not all",
+          best==best0 ? "unchanged" : "FAILED: changed" );
+
+  remove(FILENAME);
+
+  exit(EXIT_SUCCESS);
+  }
@@ -0,0 +1,233 @@
+/**********************************************************************
+  test_trace.c
+ **********************************************************************
+
+  test_trace - Test program for GAUL.
+  Copyright ©2002-2026, Stewart Adcock <stewart@linux-domain.com>
+  All rights reserved.
+
+  The latest version of this program should be available at:
+  http://gaul.sourceforge.net/
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.  Alternatively, if your project
+  is incompatible with the GPL, I will probably agree to requests
+  for permission to use the terms of any other license.
+
+  This program is distributed in the hope that it will be useful, but
+  WITHOUT ANY WARRANTY WHATSOEVER.
+
+  A full copy of the GNU General Public License should be in the file
+  "COPYING" provided with this distribution; if not, see:
+  http://www.gnu.org/
+
+ **********************************************************************
+
+  Synopsis:	Test program for GAUL's timeline tracing.
+
+		Generational, threaded, forked and simulated annealing
+		runs are traced and the events in the resulting trace
+		files are counted.  The number of recorded events is
+		then checked with sampling and with small buffers.
+
+ **********************************************************************/
+
+#include "gaul.h"
+
+#define NUM_DIMS	8
+#define POP_SIZE	50
+#define FILENAME	"test_trace.json"
+
+/**********************************************************************
+  test_score()
+  synopsis:	Fitness function.  Sphere function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+static boolean test_score(population *pop, entity *this_entity)
+  {
+  double		x;		/* Parameter. */
+  double		sum=0.0;	/* Sphere function. */
+  int			i;		/* Loop over dimensions. */
+
+  for (i=0; i<NUM_DIMS; i++)
+    {
+    x = ((double *)this_entity->chromosome[0])[i];
+    sum += x*x;
+    }
+
+  ga_entity_set_fitness(this_entity, -sum);
+
+  return TRUE;
+  }
+
+
+/**********************************************************************
+  test_population()
+  synopsis:	Create a population.
+  parameters:
+  return:	New population.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static population *test_population(void)
+  {
+  population	*pop;		/* New population. */
+
+  pop = ga_genesis_double(
+       POP_SIZE,		/* const int              population_size */
+       1,			/* const int              num_chromo */
+       NUM_DIMS,		/* const int              len_chromo */
+       NULL,			/* GAgeneration_hook      generation_hook */
+       NULL,			/* GAiteration_hook       iteration_hook */
+       NULL,			/* GAdata_destructor      data_destructor */
+       NULL,			/* GAdata_ref_incrementor data_ref_incrementor */
+       test_score,		/* GAevaluate             evaluate */
+       ga_seed_double_random,	/* GAseed                 seed */
+       NULL,			/* GAadapt                adapt */
+       ga_select_one_bestof2,	/* GAselect_one           select_one */
+       ga_select_two_bestof2,	/* GAselect_two           select_two */
+       ga_mutate_double_singlepoint_drift,	/* GAmutate               mutate */
+       ga_crossover_double_doublepoints,	/* GAcrossover            crossover */
+       NULL,			/* GAreplace              replace */
+       NULL			/* vpointer	User data */
+            );
+
+  ga_population_set_allele_min_double(pop, -5.0);
+  ga_population_set_allele_max_double(pop, 5.0);
+
+  ga_population_set_parameters(
+       pop,				/* population      *pop */
+       GA_SCHEME_DARWIN,		/* const ga_scheme_type     scheme */
+       GA_ELITISM_PARENTS_SURVIVE,	/* const ga_elitism_type   elitism */
+       0.8,				/* double  crossover */
+       0.2,				/* double  mutation */
+       0.0      		        /* double  migration */
+                              );
+
+  return pop;
+  }
+
+
+/**********************************************************************
+  test_count()
+  synopsis:	Count the occurrences of a string in the trace file.
+  parameters:	char *pattern
+  return:	Number of occurrences.
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static int test_count(char *pattern)
+  {
+  FILE		*fp;		/* File handle. */
+  char		line[1024];	/* One line of the file. */
+  int		count=0;	/* Number of occurrences. */
+
+  if ( !(fp = fopen(FILENAME, "r")) ) return -1;
+
+  while (fgets(line, 1024, fp))
+    if (strstr(line, pattern)) count++;
+
+  fclose(fp);
+
+  return count;
+  }
+
+
+/**********************************************************************
+  main()
+  synopsis:	Main function.
+  parameters:
+  return:
+  updated:	17 Oct 2026
+ **********************************************************************/
+
+int main(int argc, char **argv)
+  {
+  population	*pop;			/* Population. */
+  entity	*solution;		/* Simulated annealing solution. */
+  unsigned long	recorded, dropped;	/* Event counts. */
+  int		generations;		/* Generations performed. */
+
+  random_seed(42);
+
+/*
+ * Serial evolution.  Every phase of every generation is traced.
+ */
+  ga_trace_enable(100000, 1);
+  pop = test_population();
+  generations = ga_evolution(pop, 20);
+  ga_trace_write(FILENAME);
+  printf( "ga_evolution(): trace file %s, %s sort for each generation, evaluations %s.\n",
+          test_count("{\"traceEvents\":[")==1&&test_count("\"dropped\":0}}")==1 ? "complete" : "FAILED",
+          test_count("\"name\":\"sort\"")==generations+1 ? "one" : "FAILED",
+          test_count("\"name\":\"evaluate\"")>=POP_SIZE ? "traced" : "FAILED" );
+  ga_extinction(pop);
+
+/*
+ * Threaded evaluation, which shows the evaluation threads.
+ */
+  setenv("GAUL_NUM_THREADS", "4", 1);
+  ga_trace_enable(100000, 1);
+  pop = test_population();
+  ga_evolution_threaded(pop, 20);
+  ga_trace_write(FILENAME);
+  printf( "ga_evolution_threaded(): evaluations traced on %s.\n",
+          test_count("\"name\":\"thread_name\"")>1 ? "several threads" : "FAILED to trace several threads" );
+  ga_extinction(pop);
+
+/*
+ * Forked evaluation, which shows each forked process.
+ */
+  ga_trace_enable(100000, 1);
+  pop = test_population();
+  ga_evolution_forked(pop, 5);
+  ga_trace_write(FILENAME);
+  printf( "ga_evolution_forked(): forked processes %s.\n",
+          test_count("\"name\":\"fork\"")>=POP_SIZE ? "traced" : "FAILED to be traced" );
+  ga_extinction(pop);
+
+/*
+ * Local search.
+ */
+  ga_trace_enable(100000, 1);
+  pop = test_population();
+  ga_population_set_sa_parameters(pop, ga_sa_boltzmann_acceptance, 10.0, 0.1, 0.1, 10);
+  solution = ga_get_free_entity(pop);
+  ga_entity_seed(pop, solution);
+  ga_sa(pop, solution, 100);
+  ga_trace_write(FILENAME);
+  printf( "ga_sa(): %s search traced.\n",
+          test_count("\"name\":\"search\"")==1&&test_count("\"function\":\"ga_sa\"")==1 ? "one" : "FAILED" );
+  ga_extinction(pop);
+
+/*
+ * Sampling, then bounded buffers.
+ */
+  ga_trace_enable(100000, 10);
+  pop = test_population();
+  ga_evolution(pop, 100);
+  ga_trace_get_counts(&recorded, &dropped);
+  printf( "Sampling: %s events recorded, %lu dropped.\n",
+          recorded > 0 && recorded < 2000 ? "fewer" : "FAILED: too many", dropped );
+  ga_extinction(pop);
+
+  ga_trace_enable(100, 1);
+  pop = test_population();
+  ga_evolution(pop, 100);
+  ga_trace_get_counts(&recorded, &dropped);
+  printf( "Bounded buffer: %lu events recorded, %s dropped.\n",
+          recorded, dropped > 0 ? "later events" : "FAILED: none" );
+  ga_extinction(pop);
+
+  ga_trace_disable();
+  printf("Tracing %s.\n", ga_trace_get_enabled() ? "FAILED to be disabled" : "disabled");
+
+  remove(FILENAME);
+
+  exit(EXIT_SUCCESS);
+  }
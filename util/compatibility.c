@@ -553,6 +553,9 @@ void dief(const char *format, ...)
   va_end(ap);
   printf("\n");
 
+  log_flush();
+  fflush(NULL);
+
   abort();
   }
 #endif /* HAVE_DIEF */
@@ -128,6 +128,24 @@
 # endif
 #endif
 
+/*
+ * Ordered loads and stores, for lock-free structures shared between
+ * exactly one writer and one reader.  ATOMIC_STORE_RELEASE() makes
+ * all prior writes visible before the stored value, and
+ * ATOMIC_LOAD_ACQUIRE() ensures that later reads are not satisfied
+ * before the loaded value.
+ */
+#if defined(__GNUC__) && ( __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7) )
+# define ATOMIC_LOAD_ACQUIRE(x)		__atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE_RELEASE(x, v)	__atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#elif defined(__GNUC__)
+# define ATOMIC_LOAD_ACQUIRE(x)		({ __typeof__(x) _atomic_v = *(volatile __typeof__(x) *)&(x); __sync_synchronize(); _atomic_v; })
+# define ATOMIC_STORE_RELEASE(x, v)	do { __sync_synchronize(); *(volatile __typeof__(x) *)&(x) = (v); } while(0)
+#else
+# define ATOMIC_LOAD_ACQUIRE(x)		(x)
+# define ATOMIC_STORE_RELEASE(x, v)	((x) = (v))
+#endif
+
 /*
  * Includes needed for this stuff.
  */
@@ -375,14 +393,18 @@ typedef unsigned char gaulbyte;
                         } } MWRAP_END
 
 /*
- * die() macro, inspired by perl!
+ * die() macro, inspired by perl!  Queued log messages are written
+ * first.  log_flush() is defined in log_util.c.
  */
+GAULFUNC void log_flush(void);
+
 #define die(X)  MWRAP_BEGIN {                                           \
                 printf("FATAL ERROR: %s\nin %s at \"%s\" line %d\n",    \
                 (X),                                    \
                 __PRETTY_FUNCTION__,                    \
                 __FILE__,                               \
                 __LINE__);                              \
+                log_flush();                            \
                 fflush(NULL);                           \
                 s_breakpoint;                           \
                 } MWRAP_END
@@ -398,6 +420,7 @@ typedef unsigned char gaulbyte;
                         __PRETTY_FUNCTION__,                    \
                         __FILE__,                               \
                         __LINE__);                              \
+                        log_flush();                            \
                         fflush(NULL);                           \
                         s_breakpoint;                           \
                         } MWRAP_END
@@ -78,6 +78,7 @@ GAULFUNC void	log_init(enum log_level_type level, char *fname, log_func func, bo
 GAULFUNC void	log_set_level(enum log_level_type level);
 GAULFUNC void	log_set_file(const char *fname);
 GAULFUNC enum log_level_type	log_get_level(void);
+GAULFUNC void	log_flush(void);
 
 /*
  * This is the actual logging function, but isn't intended to be used
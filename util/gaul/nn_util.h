@@ -67,6 +67,7 @@ typedef struct
   float      **weight;        /* Synapse weights. */
   float      **weight_save;   /* Saved weights for stopped training. */
   float      **weight_change; /* Last weight deltas for momentum. */
+  int        stride;          /* Padded length of output, error and next layer's weight rows. */
   } layer_t;
 
 /*
@@ -83,6 +84,9 @@ typedef struct
   float      error;           /* Total network error. */
   layer_t    *layer;          /* Layers of neurons. */
   int        num_layers;      /* Number of layers of neurons (incl. input_output). */
+  float      *block;          /* Single allocation holding every layer's data. */
+  float      **rows;          /* Row pointers of every layer's weights. */
+  size_t     num_floats;      /* Length of data, starting at layer[0].output. */
   } network_t;
 
 /*
@@ -90,6 +94,7 @@ typedef struct
  */
 #define NN_MAX_FNAME_LEN	128
 #define NN_DATA_ALLOC_SIZE	1024
+#define NN_ALIGN_FLOATS		8	/* Rows are padded, and aligned, to this many floats. */
 
 /*
  * Default parameter constants.
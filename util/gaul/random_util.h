@@ -91,6 +91,9 @@ GAULFUNC unsigned int random_get_state_str_len(void);
 GAULFUNC void	random_set_state_str(char *state);
 GAULFUNC random_state	random_get_state(void);
 GAULFUNC void	random_set_state(random_state state);
+GAULFUNC void	random_seed_state(random_state *state, const unsigned int seed);
+GAULFUNC void	random_set_thread_state(random_state *state);
+GAULFUNC random_state	*random_get_thread_state(void);
 
 GAULFUNC boolean	random_boolean(void);
 GAULFUNC boolean	random_boolean_prob(const double prob);
@@ -57,6 +57,8 @@ typedef struct
 GAULFUNC void	timer_diagnostics(void);
 GAULFUNC void	timer_start(chrono_t *t);
 GAULFUNC double	timer_check(chrono_t *t);
+GAULFUNC double	timer_monotonic(void);
+GAULFUNC double	timer_cpu(void);
 
 /*
  * SLang intrinsic function with equivalent functionality.
@@ -33,6 +33,13 @@
 
 		These functions are thread-safe.
 
+		The log file is kept open.  With pthreads, each thread
+		queues its messages in its own ring buffer, without
+		locking, and a background thread appends the queued
+		messages to the file.  log_flush() writes everything
+		queued so far.  It is called for fatal messages, by
+		die() and dief(), and at exit.
+
   To do:	Seperate levels for callback, file, stderr outputs.
 		Validate the logging level when set.
 		Seperate levels/files/whatever possible for seperate files.
@@ -42,6 +49,34 @@
 
 #include "gaul/log_util.h"
 
+#ifdef HAVE_PTHREADS
+# include <sys/time.h>
+#endif
+
+/*
+ * Constants.
+ */
+#define LOG_LINE_LEN		(4*LOG_MAX_LEN)	/* Longest formatted message. */
+#define LOG_RING_SIZE		16384		/* Bytes queued per thread. */
+#define LOG_WRITER_INTERVAL	100		/* Milliseconds between writes. */
+
+/*
+ * Per-thread logging state.  The ring is written only by its owner
+ * and read only by whoever holds gaul_log_writer_lock.
+ */
+typedef struct log_thread_s
+  {
+  time_t		date_time;	/* Time of cached date. */
+  char			date[32];	/* Cached date string. */
+#ifdef HAVE_PTHREADS
+  struct log_thread_s	*next;		/* Next thread in list. */
+  unsigned long		head;		/* Bytes queued by owner. */
+  unsigned long		tail;		/* Bytes written to file. */
+  boolean		orphaned;	/* Whether owner has exited. */
+  char			ring[LOG_RING_SIZE];	/* Queued messages. */
+#endif
+  } log_thread_t;
+
 /*
  * Global variables.
  *
@@ -51,10 +86,33 @@ static char		*log_filename=NULL;		/* Log filename */
 static log_func		log_callback=NULL;		/* Callback function for log */
 static enum log_level_type	log_level=LOG_NONE;	/* Logging level */
 static boolean		log_date=TRUE;			/* Whether to display date in logs */
+static FILE		*log_fh=NULL;			/* Open log file */
+static boolean		log_atexit=FALSE;		/* Whether log_flush() is registered */
+static boolean		log_stdout_pending=FALSE;	/* Whether messages await stdout flush; atomic */
+static const char	log_text[7][10] = {"?????: ", "FATAL: ", "WARNING: ",
+                                  "",        "",
+                                  "FIXME: ", "DEBUG: " };
+
+#ifdef HAVE_PTHREADS
+static log_thread_t	*log_threads=NULL;		/* All threads which have logged */
+static pthread_key_t	log_thread_key;			/* Per-thread state */
+static pthread_once_t	log_thread_once=PTHREAD_ONCE_INIT;
+static boolean		log_writer_started=FALSE;	/* Whether writer thread exists */
+static pthread_cond_t	log_writer_cond=PTHREAD_COND_INITIALIZER;
+#else
+static log_thread_t	log_thread_single;		/* The only thread's state */
+#endif
 
 THREAD_LOCK_DEFINE_STATIC(gaul_log_callback_lock);
 THREAD_LOCK_DEFINE_STATIC(gaul_log_global_lock);
 THREAD_LOCK_DEFINE_STATIC(gaul_log_level_lock);
+THREAD_LOCK_DEFINE_STATIC(gaul_log_writer_lock);
+#ifdef HAVE_PTHREADS
+THREAD_LOCK_DEFINE_STATIC(gaul_log_threads_lock);
+THREAD_LOCK_DEFINE_STATIC(gaul_log_wake_lock);
+
+static void log_drain(void);
+#endif
 
 #ifdef HAVE_MPI
 static int mpi_get_rank(void)
@@ -67,6 +125,462 @@ static int mpi_get_rank(void)
   }
 #endif
 
+/**********************************************************************
+  log_open()
+  synopsis:	Open the log file for appending, if it isn't open.
+		gaul_log_writer_lock must be held.
+  parameters:	none
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_open(void)
+  {
+
+  if (log_fh) return;
+
+  if ( !(log_fh=fopen(log_filename, "a")) )
+    {
+    fprintf(stdout, "FATAL: Unable to open logfile \"%s\" for appending.\n", log_filename);
+    abort();	/* FIXME: Find more elegant method */
+    }
+
+  if (!log_atexit)
+    {
+    atexit(log_flush);
+    log_atexit = TRUE;
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  log_switch()
+  synopsis:	Write any queued messages to the current log file, then
+		close it and use a new log file.
+  parameters:	const char *fname	New filename.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_switch(const char *fname)
+  {
+  char	*oldfname=NULL;
+
+  THREAD_LOCK(gaul_log_writer_lock);
+#ifdef HAVE_PTHREADS
+  log_drain();
+#endif
+  if (log_fh)
+    {
+    fclose(log_fh);
+    log_fh = NULL;
+    }
+
+  THREAD_LOCK(gaul_log_global_lock);
+  if (log_filename != fname) oldfname = log_filename;
+  log_filename = s_strdup(fname);
+  THREAD_UNLOCK(gaul_log_global_lock);
+  THREAD_UNLOCK(gaul_log_writer_lock);
+
+  if (oldfname) s_free(oldfname);
+
+  return;
+  }
+
+
+#ifdef HAVE_PTHREADS
+/**********************************************************************
+  log_drain()
+  synopsis:	Append the messages queued by every thread to the log
+		file.  The state of threads which have exited is
+		released once their messages are written.
+		gaul_log_writer_lock must be held.
+  parameters:	none
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_drain(void)
+  {
+  log_thread_t	*this, **link;	/* Thread's state. */
+  unsigned long	head, tail;	/* Queued bytes. */
+  unsigned long	offset, num;	/* Contiguous bytes. */
+  boolean	orphaned;	/* Whether thread has exited. */
+  boolean	written=FALSE;	/* Whether anything was written. */
+
+  THREAD_LOCK(gaul_log_threads_lock);
+
+  link = &log_threads;
+  while ( (this = *link) != NULL )
+    {
+/*
+ * The owner sets orphaned after queueing its final message, so
+ * reading orphaned first ensures that nothing is missed.
+ */
+    orphaned = ATOMIC_LOAD_ACQUIRE(this->orphaned);
+    head = ATOMIC_LOAD_ACQUIRE(this->head);
+    tail = this->tail;
+
+    if (tail != head)
+      {
+      log_open();
+      written = TRUE;
+      }
+
+    while (tail != head)
+      {
+      offset = tail%LOG_RING_SIZE;
+      num = head-tail;
+      if (num > LOG_RING_SIZE-offset) num = LOG_RING_SIZE-offset;
+      fwrite(&(this->ring[offset]), sizeof(char), num, log_fh);
+      tail += num;
+      }
+
+    ATOMIC_STORE_RELEASE(this->tail, tail);
+
+    if (orphaned)
+      {
+      *link = this->next;
+      s_free(this);
+      }
+    else
+      {
+      link = &(this->next);
+      }
+    }
+
+  THREAD_UNLOCK(gaul_log_threads_lock);
+
+  if (written) fflush(log_fh);
+
+  return;
+  }
+
+
+/**********************************************************************
+  log_writer()
+  synopsis:	Background thread which periodically writes queued
+		messages.  It is woken early when a thread's ring is
+		half full.
+  parameters:	void *data	Unused.
+  return:	never returns.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void *log_writer(void *data)
+  {
+  struct timeval	now;		/* Current time. */
+  struct timespec	until;		/* Time to wake up. */
+
+  while (TRUE)
+    {
+    gettimeofday(&now, NULL);
+    until.tv_sec = now.tv_sec;
+    until.tv_nsec = now.tv_usec*1000L + LOG_WRITER_INTERVAL*1000000L;
+    if (until.tv_nsec >= 1000000000L)
+      {
+      until.tv_sec++;
+      until.tv_nsec -= 1000000000L;
+      }
+
+    THREAD_LOCK(gaul_log_wake_lock);
+    pthread_cond_timedwait(&log_writer_cond, &gaul_log_wake_lock, &until);
+    THREAD_UNLOCK(gaul_log_wake_lock);
+
+    THREAD_LOCK(gaul_log_writer_lock);
+    log_drain();
+    THREAD_UNLOCK(gaul_log_writer_lock);
+    }
+
+  return NULL;
+  }
+
+
+/**********************************************************************
+  log_writer_start()
+  synopsis:	Start the background writer thread, if it isn't
+		running.  If it can't be started, messages are
+		written whenever a ring fills, and by log_flush().
+  parameters:	none
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_writer_start(void)
+  {
+  pthread_t	thread;		/* Writer thread. */
+
+  THREAD_LOCK(gaul_log_threads_lock);
+  if (!log_writer_started)
+    {
+    if (pthread_create(&thread, NULL, log_writer, NULL) == 0)
+      pthread_detach(thread);
+    ATOMIC_STORE_RELEASE(log_writer_started, TRUE);
+    }
+  THREAD_UNLOCK(gaul_log_threads_lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  log_thread_exit()
+  synopsis:	pthread key destructor.  The thread's state is released
+		by log_drain() once its messages have been written.
+  parameters:	void *data	Thread's state.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_thread_exit(void *data)
+  {
+  log_thread_t	*this=(log_thread_t *)data;	/* Thread's state. */
+
+  ATOMIC_STORE_RELEASE(this->orphaned, TRUE);
+
+  return;
+  }
+
+
+/**********************************************************************
+  log_fork_prepare(), log_fork_parent(), log_fork_child()
+  synopsis:	pthread_atfork() handlers.  Queued messages, and
+		stdout, are written before forking, so that the child
+		doesn't write them again, and the child starts its own
+		writer thread.
+		Only the forking thread exists in the child.
+  parameters:	none
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_fork_prepare(void)
+  {
+  THREAD_LOCK(gaul_log_writer_lock);
+  log_drain();
+  fflush(stdout);
+  ATOMIC_STORE_RELEASE(log_stdout_pending, FALSE);
+  THREAD_LOCK(gaul_log_threads_lock);
+  return;
+  }
+
+static void log_fork_parent(void)
+  {
+  THREAD_UNLOCK(gaul_log_threads_lock);
+  THREAD_UNLOCK(gaul_log_writer_lock);
+  return;
+  }
+
+static void log_fork_child(void)
+  {
+  log_thread_t	*self, *this;	/* Threads' state. */
+
+  self = (log_thread_t *)pthread_getspecific(log_thread_key);
+
+  for (this=log_threads; this; this=this->next)
+    {
+    this->tail = this->head;
+    if (this != self) this->orphaned = TRUE;
+    }
+
+  log_writer_started = FALSE;
+  THREAD_LOCK_NEW(gaul_log_wake_lock);
+  pthread_cond_init(&log_writer_cond, NULL);
+
+  THREAD_UNLOCK(gaul_log_threads_lock);
+  THREAD_UNLOCK(gaul_log_writer_lock);
+
+  return;
+  }
+
+
+/**********************************************************************
+  log_thread_key_create()
+  synopsis:	One-time initialisation of per-thread state.
+  parameters:	none
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_thread_key_create(void)
+  {
+  pthread_key_create(&log_thread_key, log_thread_exit);
+  pthread_atfork(log_fork_prepare, log_fork_parent, log_fork_child);
+  return;
+  }
+#endif
+
+
+/**********************************************************************
+  log_thread_self()
+  synopsis:	Return the calling thread's logging state, creating it
+		if necessary.
+  parameters:	none
+  return:	Thread's state.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static log_thread_t *log_thread_self(void)
+  {
+#ifdef HAVE_PTHREADS
+  log_thread_t	*self;		/* Thread's state. */
+
+  pthread_once(&log_thread_once, log_thread_key_create);
+
+  if ( (self = (log_thread_t *)pthread_getspecific(log_thread_key)) != NULL )
+    return self;
+
+  self = s_malloc(sizeof(log_thread_t));
+  self->date_time = (time_t) -1;
+  self->head = 0;
+  self->tail = 0;
+  self->orphaned = FALSE;
+  pthread_setspecific(log_thread_key, self);
+
+  THREAD_LOCK(gaul_log_threads_lock);
+  self->next = log_threads;
+  log_threads = self;
+  THREAD_UNLOCK(gaul_log_threads_lock);
+
+  return self;
+#else
+  return &log_thread_single;
+#endif
+  }
+
+
+/**********************************************************************
+  log_format()
+  synopsis:	Format a message as it appears in the log.  The date
+		is only formatted when it has changed.
+  parameters:	char *line	Buffer of LOG_LINE_LEN characters.
+		const enum log_level_type level
+		const char *func_name
+		const char *file_name
+		const int line_num
+		const char *message
+  return:	Length of formatted text.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static int log_format( char *line,
+                       const enum log_level_type level,
+                       const char *func_name,
+                       const char *file_name,
+                       const int line_num,
+                       const char *message )
+  {
+  log_thread_t	*self;		/* Thread's state. */
+  const char	*date="";	/* Date string. */
+  time_t	t;		/* Current time. */
+  int		len;		/* Length of text. */
+
+/*
+ * NB/ Dates are displayed when log_date is FALSE, as they always
+ * have been.
+ */
+  if (!log_date)
+    {
+    self = log_thread_self();
+    t = time(NULL);
+    if (t != self->date_time)
+      {
+#ifdef HAVE_PTHREADS
+      ctime_r(&t, self->date);
+#else
+      strncpy(self->date, ctime(&t), 31);
+      self->date[31] = '\0';
+#endif
+      self->date_time = t;
+      }
+    date = self->date;
+    }
+
+#ifdef HAVE_MPI
+  len = snprintf( line, LOG_LINE_LEN, "%d: %s%s%s%s\n",
+                  mpi_get_rank(),
+                  date, log_date?"":" - ",
+                  log_text[level], message );
+#else
+  len = snprintf( line, LOG_LINE_LEN, "%s%s%s%s\n",
+                  date, log_date?"":" - ",
+                  log_text[level], message );
+#endif
+
+  if (level >= LOG_FIXME && len < LOG_LINE_LEN-1)
+    len += snprintf( &(line[len]), LOG_LINE_LEN-len,
+                     "   in %s(), \"%s\", line %d\n",
+                     func_name, file_name, line_num );
+
+  if (len > LOG_LINE_LEN-1)
+    {	/* Truncated. */
+    len = LOG_LINE_LEN-1;
+    line[len-1] = '\n';
+    }
+
+  return len;
+  }
+
+
+/**********************************************************************
+  log_queue()
+  synopsis:	Queue a formatted message for the log file.  With
+		pthreads, the message is copied to the calling
+		thread's ring, and written later by the writer thread.
+		A full ring is written by the calling thread.
+  parameters:	const char *line
+		const int len
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void log_queue(const char *line, const int len)
+  {
+#ifdef HAVE_PTHREADS
+  log_thread_t	*self;		/* Thread's state. */
+  unsigned long	queued;		/* Bytes already queued. */
+  unsigned long	offset, num;	/* Contiguous bytes. */
+
+  self = log_thread_self();
+
+  if (!ATOMIC_LOAD_ACQUIRE(log_writer_started)) log_writer_start();
+
+  queued = self->head - ATOMIC_LOAD_ACQUIRE(self->tail);
+
+  if (queued+len > LOG_RING_SIZE)
+    {
+    THREAD_LOCK(gaul_log_writer_lock);
+    log_drain();
+    THREAD_UNLOCK(gaul_log_writer_lock);
+    queued = self->head - self->tail;
+    }
+
+  offset = self->head%LOG_RING_SIZE;
+  num = len;
+  if (num > LOG_RING_SIZE-offset) num = LOG_RING_SIZE-offset;
+  memcpy(&(self->ring[offset]), line, num);
+  memcpy(self->ring, &(line[num]), len-num);
+
+  ATOMIC_STORE_RELEASE(self->head, self->head+len);
+
+  if (queued <= LOG_RING_SIZE/2 && queued+len > LOG_RING_SIZE/2)
+    {
+    THREAD_LOCK(gaul_log_wake_lock);
+    pthread_cond_signal(&log_writer_cond);
+    THREAD_UNLOCK(gaul_log_wake_lock);
+    }
+#else
+  THREAD_LOCK(gaul_log_writer_lock);
+  log_open();
+  fwrite(line, sizeof(char), len, log_fh);
+  THREAD_UNLOCK(gaul_log_writer_lock);
+#endif
+
+  return;
+  }
+
 
 /**********************************************************************
   log_init()
@@ -76,7 +590,7 @@ static int mpi_get_rank(void)
 		char	*fname	Filename, or NULL.
 		log_func	func	Callback function, or NULL.
   return:	none
-  last updated:	26 Feb 2002
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 void log_init(	enum log_level_type	level,
@@ -84,24 +598,18 @@ void log_init(	enum log_level_type	level,
 			log_func		func,
 			boolean			date)
   {
-  char	*oldfname=NULL;
 
   THREAD_LOCK(gaul_log_global_lock);
   log_level = level;
-  if (fname)
-    {
-    if (log_filename != fname) oldfname = log_filename;
-    log_filename = s_strdup(fname);
-    }
   log_date = date;
   THREAD_UNLOCK(gaul_log_global_lock);
 
+  if (fname) log_switch(fname);
+
   THREAD_LOCK(gaul_log_callback_lock);
     log_callback = func;
   THREAD_UNLOCK(gaul_log_callback_lock);
 
-  if (oldfname) s_free(oldfname);
-
 #ifdef HAVE_MPI
   plog(LOG_VERBOSE, "Log started. (parallel with MPI)");
 #else
@@ -151,19 +659,13 @@ enum log_level_type log_get_level(void)
   synopsis:	Adjust log file.
   parameters:	const char *fname	Filename for output.
   return:	none
-  last updated:	31 Jan 2002
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 void log_set_file(const char *fname)
   {
-  char	*oldfname=NULL;
 
-  THREAD_LOCK(gaul_log_global_lock);
-  if (log_filename != fname) oldfname = log_filename;
-  log_filename = s_strdup(fname);
-  THREAD_UNLOCK(gaul_log_global_lock);
-
-  if (oldfname) s_free(oldfname);
+  log_switch(fname);
 
   plog(LOG_VERBOSE, "Log file adjusted to \"%s\".", fname);
 
@@ -171,17 +673,50 @@ void log_set_file(const char *fname)
   }
 
 
+/**********************************************************************
+  log_flush()
+  synopsis:	Write all queued log messages to the log file, and
+		flush stdout if messages have been written to it.
+		stdout is otherwise left alone, so that forked
+		processes which call this before _exit() don't repeat
+		their parent's buffered output.
+  parameters:	none
+  return:	none
+  last updated:	17 Oct 2026
+ **********************************************************************/
+
+void log_flush(void)
+  {
+
+  THREAD_LOCK(gaul_log_writer_lock);
+#ifdef HAVE_PTHREADS
+  log_drain();
+#endif
+  if (log_fh) fflush(log_fh);
+  THREAD_UNLOCK(gaul_log_writer_lock);
+
+  if (ATOMIC_LOAD_ACQUIRE(log_stdout_pending))
+    {
+    ATOMIC_STORE_RELEASE(log_stdout_pending, FALSE);
+    fflush(stdout);
+    }
+
+  return;
+  }
+
+
 /**********************************************************************
   log_output()
   synopsis:	If log level is appropriate, append message to log
 		file.  log_init() should really be called prior
 		to the first use of the function, although nothing will
-		break if you don't.
+		break if you don't.  Messages for the log file are
+		queued, and fatal messages are flushed immediately.
   parameters:	int	level	Logging level.
 		char		format	Format string.
 		...		Variable args.
   return:       none
-  last updated: 21/06/00
+  last updated: 16 Oct 2026
  **********************************************************************/
 
 void log_output(	const enum	log_level_type level,
@@ -192,15 +727,8 @@ void log_output(	const enum	log_level_type level,
   {
   va_list	ap;				/* variable args structure */
   char		message[LOG_MAX_LEN];	/* The text to write */
-  FILE		*fh;				/* File handle */
-/* FIXME: Needs to be more general */
-  const char	log_text[7][10] = {"?????: ", "FATAL: ", "WARNING: ",
-                                  "",        "",
-                                  "FIXME: ", "DEBUG: " };
-  time_t	t;				/* Time structure */
-
-  t = time(&t);	/* Less than optimal when no time display is required. */
-		/* I tried variations on ctime(time()), withou success. */
+  char		line[LOG_LINE_LEN];	/* Formatted message */
+  int		len;			/* Length of formatted message */
 
 /*
  * Should message be dropped?
@@ -223,55 +751,30 @@ void log_output(	const enum	log_level_type level,
   THREAD_UNLOCK(gaul_log_callback_lock);
 
 /* Write to file? */
-  THREAD_LOCK(gaul_log_global_lock);
   if (log_filename)
     {
-    if ( !(fh=fopen(log_filename, "a+")) )
-      {
-      fprintf(stdout, "FATAL: Unable to open logfile \"%s\" for appending.\n", log_filename);
-      abort();	/* FIXME: Find more elegant method */
-      }
+    len = log_format(line, level, func_name, file_name, line_num, message);
+    log_queue(line, len);
 
-#ifdef HAVE_MPI
-    fprintf(fh, "%d: %s%s%s%s\n",
-             mpi_get_rank(),
-             log_date?"":ctime(&t), log_date?"":" - ",
-             log_text[level], message);
-#else
-    fprintf(fh, "%s%s%s%s\n",
-             log_date?"":ctime(&t), log_date?"":" - ",
-             log_text[level], message);
-#endif
-
-    if (level >= LOG_FIXME)
-      fprintf(fh, "   in %s(), \"%s\", line %d\n",
-                       func_name, file_name, line_num);
-
-/*    fflush(fh);*/
-    fclose(fh);
+    if (level == LOG_FATAL) log_flush();
     }
-  THREAD_UNLOCK(gaul_log_global_lock);
 
 /* Write to stdout? */
   if ( !(log_callback || log_filename) )
     {
-#ifdef HAVE_MPI
-    if (mpi_get_rank() >= 0)
-      fprintf(stdout, "%d: %s%s%s%s\n", mpi_get_rank(),
-              log_date?"":ctime(&t), log_date?"":" - ",
-              log_text[level], message);
-    else
-#endif
-      fprintf(stdout, "%s%s%s%s\n", 
-              log_date?"":ctime(&t), log_date?"":" - ",
-              log_text[level], message);
-
-    if (level >= LOG_FIXME)
-      fprintf(stdout, "   in %s(), \"%s\", line %d\n",
-                       func_name, file_name, line_num);
+    len = log_format(line, level, func_name, file_name, line_num, message);
+    fwrite(line, sizeof(char), len, stdout);
 
     /*fprintf(stderr, "%s%s\n", log_text[level], message);*/
-    fflush(stdout);
+    if (level <= LOG_WARNING)
+      {
+      ATOMIC_STORE_RELEASE(log_stdout_pending, FALSE);
+      fflush(stdout);
+      }
+    else
+      {
+      ATOMIC_STORE_RELEASE(log_stdout_pending, TRUE);
+      }
     }
 
   return;
@@ -286,9 +789,6 @@ void plog(const enum log_level_type level, const char *format, ...)
   {
   va_list       ap;                             /* variable args structure */
   char          message[LOG_MAX_LEN];     /* The text to write */
-  const char    log_text[7][10] = {"?????: ", "FATAL: ", "WARNING: ",
-                                  "",        "",
-                                  "FIXME: ", "DEBUG: " };
   time_t        t;                              /* Time structure */
 
   t = time(&t);
@@ -329,9 +829,6 @@ void log_wrapper(int *level, char *message)
 /*
   unsigned int	num = SLang_Num_Function_Args;
 */
-  const char	log_text[7][10] = {"?????: ", "FATAL: ", "WARNING: ",
-                                  "",        "",
-                                  "FIXME: ", "DEBUG: " };
   time_t	t;				/* Time structure. */
 
   t = time(&t);
@@ -47,6 +47,21 @@
 
 #include "gaul/nn_util.h"
 
+/*
+ * Run-time selection of the forward pass kernel for the best
+ * instruction set.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6 && defined(__x86_64__) && defined(__linux__)
+# define NN_CLONES	__attribute__((target_clones("arch=haswell","default")))
+#else
+# define NN_CLONES
+#endif
+
+/*
+ * Bits of 126.0f, the largest exponent passed to the fast sigmoid.
+ */
+#define NN_EXP2_LIMIT	0x42fc0000
+
 /*
  * Yucky global variables.
  */
@@ -82,7 +97,7 @@ static char       **predict_labels=NULL;   /* Labels for prediction data. */
   synopsis:     Display diagnostic information. 
   parameters:   none
   return:       none
-  last updated: 13 Mar 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 void NN_diagnostics(void)
@@ -96,6 +111,7 @@ void NN_diagnostics(void)
   printf("NN_DEBUG:                  %d\n", NN_DEBUG);
   printf("NN_MAX_FNAME_LEN:          %d\n", NN_MAX_FNAME_LEN);
   printf("NN_DATA_ALLOC_SIZE:        %d\n", NN_DATA_ALLOC_SIZE);
+  printf("NN_ALIGN_FLOATS:           %d\n", NN_ALIGN_FLOATS);
   printf("NN_SIGNAL_OFF:             %f\n", NN_SIGNAL_OFF);
   printf("NN_SIGNAL_ON:              %f\n", NN_SIGNAL_ON);
   printf("NN_DEFAULT_BIAS:           %f\n", NN_DEFAULT_BIAS);
@@ -145,20 +161,106 @@ void NN_display_summary(network_t *network)
   }
 
 
+/**********************************************************************
+  nn_allocate()
+  synopsis:     Allocate the outputs, errors and weights of every layer
+		of a network as a single block, aligned to
+		NN_ALIGN_FLOATS floats.  Each output and error vector,
+		and each weight row, is padded with zeros to a multiple
+		of NN_ALIGN_FLOATS, so a layer's weights form one
+		contiguous matrix and the whole network may be copied
+		with a single memcpy().  The number of neurons in each
+		layer must already be set.
+  parameters:   network_t *network
+  return:       none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+static void nn_allocate(network_t *network)
+  {
+  float		*data;		/* Aligned start of block. */
+  float		**rows;		/* Next unused row pointer. */
+  int		num_rows=0;	/* Total number of row pointers. */
+  int		l;		/* Layer index. */
+  int		i;		/* Neuron index. */
+
+  network->num_floats = 0;
+
+  for (l=0; l<network->num_layers; l++)
+    {
+    network->layer[l].stride = (network->layer[l].neurons+NN_ALIGN_FLOATS) & ~(NN_ALIGN_FLOATS-1);
+    network->num_floats += 2*network->layer[l].stride;
+
+    if (l != 0)
+      {
+      network->num_floats += 3*(size_t) network->layer[l].neurons*network->layer[l-1].stride;
+      num_rows += 3*(network->layer[l].neurons+1);
+      }
+    }
+
+  if ( !(network->block = (float*) s_calloc(network->num_floats+NN_ALIGN_FLOATS, sizeof(float))) )
+    die("Unable to allocate memory");
+  if ( !(network->rows = (float**) s_calloc(MAX(num_rows, 1), sizeof(float*))) )
+    die("Unable to allocate memory");
+
+  data = (float*) (((size_t) network->block + NN_ALIGN_FLOATS*sizeof(float)-1) & ~(NN_ALIGN_FLOATS*sizeof(float)-1));
+  rows = network->rows;
+
+  for (l=0; l<network->num_layers; l++)
+    {
+    network->layer[l].output = data;
+    data += network->layer[l].stride;
+    network->layer[l].error = data;
+    data += network->layer[l].stride;
+
+    if (l == 0)
+      {
+      network->layer[l].weight      = NULL;
+      network->layer[l].weight_save  = NULL;
+      network->layer[l].weight_change = NULL;
+      }
+    else
+      {
+      network->layer[l].weight      = rows;
+      network->layer[l].weight_save  = rows+network->layer[l].neurons+1;
+      network->layer[l].weight_change = rows+2*(network->layer[l].neurons+1);
+      rows += 3*(network->layer[l].neurons+1);
+
+      for (i=1; i<=network->layer[l].neurons; i++)
+        {
+        network->layer[l].weight[i] = data;
+        data += network->layer[l-1].stride;
+        }
+      for (i=1; i<=network->layer[l].neurons; i++)
+        {
+        network->layer[l].weight_save[i] = data;
+        data += network->layer[l-1].stride;
+        }
+      for (i=1; i<=network->layer[l].neurons; i++)
+        {
+        network->layer[l].weight_change[i] = data;
+        data += network->layer[l-1].stride;
+        }
+      }
+    }
+
+  return;
+  }
+
+
 /**********************************************************************
   NN_new()
   synopsis:     Allocate and initialise a Neural Network datastructure.
   parameters:   int num_layers	Number of layers (incl. input+output)
 		int *neurons	Array containing number of nodes per layer.
   return:       network_t *network
-  last updated: 01 Mar 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 network_t *NN_new(int num_layers, int *neurons)
   {
   network_t	*network;	/* The new network. */
   int		l;		/* Layer index. */
-  int		i;		/* Neuron index. */
 
   if ( !(network = (network_t*) s_malloc(sizeof(network_t))) )
     die("Unable to allocate memory");
@@ -167,31 +269,13 @@ network_t *NN_new(int num_layers, int *neurons)
 
   network->num_layers = num_layers;
 
-  network->layer[0].neurons     = neurons[0];
-  network->layer[0].output      = (float*) s_calloc(neurons[0]+1, sizeof(float));
-  network->layer[0].error       = (float*) s_calloc(neurons[0]+1, sizeof(float));
-  network->layer[0].weight      = NULL;
-  network->layer[0].weight_save  = NULL;
-  network->layer[0].weight_change = NULL;
-  network->layer[0].output[0]   = NN_DEFAULT_BIAS;
-   
-  for (l=1; l<num_layers; l++)
-    {
-    network->layer[l].neurons     = neurons[l];
-    network->layer[l].output      = (float*)  s_calloc(neurons[l]+1, sizeof(float));
-    network->layer[l].error       = (float*)  s_calloc(neurons[l]+1, sizeof(float));
-    network->layer[l].weight      = (float**) s_calloc(neurons[l]+1, sizeof(float*));
-    network->layer[l].weight_save  = (float**) s_calloc(neurons[l]+1, sizeof(float*));
-    network->layer[l].weight_change = (float**) s_calloc(neurons[l]+1, sizeof(float*));
-    network->layer[l].output[0]   = NN_DEFAULT_BIAS;
-      
-    for (i=1; i<=neurons[l]; i++)
-      {
-      network->layer[l].weight[i]      = (float*) s_calloc(neurons[l-1]+1, sizeof(float));
-      network->layer[l].weight_save[i]  = (float*) s_calloc(neurons[l-1]+1, sizeof(float));
-      network->layer[l].weight_change[i] = (float*) s_calloc(neurons[l-1]+1, sizeof(float));
-      }
-    }
+  for (l=0; l<num_layers; l++)
+    network->layer[l].neurons = neurons[l];
+
+  nn_allocate(network);
+
+  for (l=0; l<num_layers; l++)
+    network->layer[l].output[0] = NN_DEFAULT_BIAS;
 
 /* Tuneable parameters: */
   network->momentum = NN_DEFAULT_MOMENTUM;
@@ -208,16 +292,16 @@ network_t *NN_new(int num_layers, int *neurons)
   NN_clone()
   synopsis:     Allocate and initialise a Neural Network datastructure
   		using the contents of an existing datastructure.
+		The contents are copied with a single memcpy().
   parameters:   network_t *network
   return:       network_t *network
-  last updated: 01 Mar 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 network_t *NN_clone(network_t *src)
   {
   network_t	*network;	/* The new network. */
   int		l;		/* Layer index. */
-  int		i;		/* Neuron index. */
 
   if ( !(network = (network_t*) s_malloc(sizeof(network_t))) )
     die("Unable to allocate memory");
@@ -226,46 +310,12 @@ network_t *NN_clone(network_t *src)
 
   network->num_layers = src->num_layers;
 
-  network->layer[0].neurons     = src->layer[0].neurons;
-  if ( !(network->layer[0].output      = (float*) s_malloc((src->layer[0].neurons+1)*sizeof(float))) )
-    die("Unable to allocate memory");
-  memcpy(network->layer[0].output, src->layer[0].output, src->layer[0].neurons+1);
-  if ( !(network->layer[0].error       = (float*) s_malloc((src->layer[0].neurons+1)*sizeof(float))) )
-    die("Unable to allocate memory");
-  memcpy(network->layer[0].error, src->layer[0].error, src->layer[0].neurons+1);
-  network->layer[0].weight      = NULL;
-  network->layer[0].weight_save  = NULL;
-  network->layer[0].weight_change = NULL;
-   
-  for (l=1; l<src->num_layers; l++)
-    {
-    network->layer[l].neurons     = src->layer[l].neurons;
-    if ( !(network->layer[l].output      = (float*)  s_malloc((src->layer[l].neurons+1)*sizeof(float))) )
-      die("Unable to allocate memory");
-    memcpy(network->layer[l].output, src->layer[l].output, src->layer[l].neurons+1);
-    if ( !(network->layer[l].error       = (float*)  s_malloc((src->layer[l].neurons+1)*sizeof(float))) )
-      die("Unable to allocate memory");
-    memcpy(network->layer[l].error, src->layer[l].error, src->layer[l].neurons+1);
-    if ( !(network->layer[l].weight      = (float**) s_malloc((src->layer[l].neurons+1)*sizeof(float*))) )
-      die("Unable to allocate memory");
-    if ( !(network->layer[l].weight_save  = (float**) s_malloc((src->layer[l].neurons+1)*sizeof(float*))) )
-      die("Unable to allocate memory");
-    if ( !(network->layer[l].weight_change = (float**) s_malloc((src->layer[l].neurons+1)*sizeof(float*))) )
-      die("Unable to allocate memory");
-      
-    for (i=1; i<=src->layer[l].neurons; i++)
-      {
-      if ( !(network->layer[l].weight[i]      = (float*) s_malloc((src->layer[l-1].neurons+1)*sizeof(float))) )
-        die("Unable to allocate memory");
-      memcpy(network->layer[l].weight[i], src->layer[l].weight[i], src->layer[l-1].neurons+1);
-      if ( !(network->layer[l].weight_save[i]  = (float*) s_malloc((src->layer[l-1].neurons+1)*sizeof(float))) )
-        die("Unable to allocate memory");
-      memcpy(network->layer[l].weight_save[i], src->layer[l].weight_save[i], src->layer[l-1].neurons+1);
-      if ( !(network->layer[l].weight_change[i] = (float*) s_malloc((src->layer[l-1].neurons+1)*sizeof(float))) )
-        die("Unable to allocate memory");
-      memcpy(network->layer[l].weight_change[i], src->layer[l].weight_change[i], src->layer[l-1].neurons+1);
-      }
-    }
+  for (l=0; l<src->num_layers; l++)
+    network->layer[l].neurons = src->layer[l].neurons;
+
+  nn_allocate(network);
+
+  memcpy(network->layer[0].output, src->layer[0].output, src->num_floats*sizeof(float));
 
 /* Tuneable parameters: */
   network->momentum = src->momentum;
@@ -281,40 +331,23 @@ network_t *NN_clone(network_t *src)
 /**********************************************************************
   NN_copy()
   synopsis:     Copy the data in one Neural Network datastructure over
-  		the data in another.
+  		the data in another, with a single memcpy().  Both
+		must have the same topology.
   parameters:   network_t *src
                 network_t *dest
   return:       none
-  last updated: 01 Mar 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 void NN_copy(network_t *src, network_t *dest)
   {
   int		l;		/* Layer index. */
-  int		i;		/* Neuron index. */
 
   if (dest->num_layers != src->num_layers) die("Incompatiable topology for copy (layers)");
   for (l=0; l<src->num_layers; l++)
     if (dest->layer[l].neurons != src->layer[l].neurons) die("Incompatiable topology for copy (neurons)");
 
-  memcpy(dest->layer[0].output, src->layer[0].output, src->layer[0].neurons+1);
-  memcpy(dest->layer[0].error, src->layer[0].error, src->layer[0].neurons+1);
-  dest->layer[0].weight      = NULL;
-  dest->layer[0].weight_save  = NULL;
-  dest->layer[0].weight_change = NULL;
-   
-  for (l=1; l<src->num_layers; l++)
-    {
-    memcpy(dest->layer[l].output, src->layer[l].output, src->layer[l].neurons+1);
-    memcpy(dest->layer[l].error, src->layer[l].error, src->layer[l].neurons+1);
-      
-    for (i=1; i<=src->layer[l].neurons; i++)
-      {
-      memcpy(dest->layer[l].weight[i], src->layer[l].weight[i], src->layer[l-1].neurons+1);
-      memcpy(dest->layer[l].weight_save[i], src->layer[l].weight_save[i], src->layer[l-1].neurons+1);
-      memcpy(dest->layer[l].weight_change[i], src->layer[l].weight_change[i], src->layer[l-1].neurons+1);
-      }
-    }
+  memcpy(dest->layer[0].output, src->layer[0].output, src->num_floats*sizeof(float));
 
 /* Tuneable parameters: */
   dest->momentum = src->momentum;
@@ -455,13 +488,13 @@ void NN_set_decay(network_t *network, const float decay)
   parameters:   network_t *network
   		const char *fname
   return:       none
-  last updated: 29 Apr 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 void NN_write(network_t *network, const char *fname)
   {
   FILE		*fp;				/* File handle. */
-  char		*fmt_str="FORMAT NN: 002\n";	/* File identifier tag. */
+  char		*fmt_str="FORMAT NN: 003\n";	/* File identifier tag. */
   int		l;				/* Layer index. */
   int		i;				/* Neuron index. */
 
@@ -473,6 +506,7 @@ void NN_write(network_t *network, const char *fname)
   fwrite(&(network->gain), sizeof(float), 1, fp);
   fwrite(&(network->rate), sizeof(float), 1, fp);
   fwrite(&(network->bias), sizeof(float), 1, fp);
+  fwrite(&(network->decay), sizeof(float), 1, fp);
 
   fwrite(&(network->num_layers), sizeof(int), 1, fp);
 
@@ -509,7 +543,7 @@ network_t *NN_read_compat(const char *fname)
   {
   FILE		*fp;				/* File handle. */
   char		*fmt_str="FORMAT NN: 001\n";	/* File identifier tag. */
-  char		*fmt_str_in="                ";	/* File identifier tag. */
+  char		fmt_str_in[16];			/* File identifier tag. */
   network_t	*network;			/* The new network. */
   int		l;				/* Layer index. */
   int		i;				/* Neuron index. */
@@ -534,30 +568,18 @@ network_t *NN_read_compat(const char *fname)
     die("Unable to allocate memory");
 
   fread(&(network->layer[0].neurons), sizeof(int), 1, fp);
-  network->layer[0].output      = (float*) s_calloc(network->layer[0].neurons+1, sizeof(float));
-  network->layer[0].error       = (float*) s_calloc(network->layer[0].neurons+1, sizeof(float));
-  network->layer[0].weight      = NULL;
-  network->layer[0].weight_save  = NULL;
-  network->layer[0].weight_change = NULL;
+  for (l=1; l<network->num_layers; l++)
+    fread(&(network->layer[l].neurons), sizeof(float), 1, fp);
+
+  nn_allocate(network);
+
   network->layer[0].output[0]   = network->bias;
-   
   for (l=1; l<network->num_layers; l++)
     {
-    fread(&(network->layer[l].neurons), sizeof(float), 1, fp);
-    network->layer[l].output      = (float*)  s_calloc(network->layer[l].neurons+1, sizeof(float));
-    network->layer[l].error       = (float*)  s_calloc(network->layer[l].neurons+1, sizeof(float));
-    network->layer[l].weight      = (float**) s_calloc(network->layer[l].neurons+1, sizeof(float*));
-    network->layer[l].weight_save  = (float**) s_calloc(network->layer[l].neurons+1, sizeof(float*));
-    network->layer[l].weight_change = (float**) s_calloc(network->layer[l].neurons+1, sizeof(float*));
     network->layer[l].output[0]   = network->bias;
-      
+
     for (i=1; i<=network->layer[l].neurons; i++)
-      {
-      network->layer[l].weight[i]      = (float*) s_calloc(network->layer[l-1].neurons+1, sizeof(float));
       fread(network->layer[l].weight[i], sizeof(float), network->layer[l-1].neurons, fp);
-      network->layer[l].weight_save[i]  = (float*) s_calloc(network->layer[l-1].neurons+1, sizeof(float));
-      network->layer[l].weight_change[i] = (float*) s_calloc(network->layer[l-1].neurons+1, sizeof(float));
-      }
     }
 
   fclose(fp);
@@ -569,27 +591,34 @@ network_t *NN_read_compat(const char *fname)
 /**********************************************************************
   NN_read()
   synopsis:     Read (and allocate) a network_t structure and its
-		contents from a binary format file on disk.
+		contents from a binary format file on disk.  Format
+		002 files, which have no weight decay, are also read.
   parameters:   const char *fname
   return:	network_t *network
-  last updated: 29 Apr 2002
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 network_t *NN_read(const char *fname)
   {
   FILE		*fp;				/* File handle. */
-  char		*fmt_str="FORMAT NN: 002\n";	/* File identifier tag. */
-  char		*fmt_str_in="                ";	/* File identifier tag. */
+  char		*fmt_str="FORMAT NN: 003\n";	/* File identifier tag. */
+  char		*fmt_str_002="FORMAT NN: 002\n";	/* Tag of format without decay. */
+  char		fmt_str_in[16];			/* File identifier tag. */
   network_t	*network;			/* The new network. */
   int		l;				/* Layer index. */
   int		i;				/* Neuron index. */
+  boolean	has_decay;			/* Whether file stores the decay. */
 
   if ( !(fp = fopen(fname, "r")) ) dief("Unable to open file \"%s\" for input.\n", fname);
 
-  fread(fmt_str_in, sizeof(char), strlen(fmt_str), fp);
-  
-  if (strncmp(fmt_str, fmt_str_in, strlen(fmt_str)))
+  if ( fread(fmt_str_in, sizeof(char), strlen(fmt_str), fp) != strlen(fmt_str) )
+    dief("Unable to read neural network file \"%s\".\n", fname);
+
+  has_decay = !strncmp(fmt_str, fmt_str_in, strlen(fmt_str));
+
+  if ( !has_decay && strncmp(fmt_str_002, fmt_str_in, strlen(fmt_str_002)) )
     {
+    fclose(fp);
     return NN_read_compat(fname);
     }
 
@@ -600,36 +629,27 @@ network_t *NN_read(const char *fname)
   fread(&(network->gain), sizeof(float), 1, fp);
   fread(&(network->rate), sizeof(float), 1, fp);
   fread(&(network->bias), sizeof(float), 1, fp);
-  fread(&(network->decay), sizeof(float), 1, fp);
+  if (has_decay)
+    fread(&(network->decay), sizeof(float), 1, fp);
+  else
+    network->decay = NN_DEFAULT_DECAY;
 
   fread(&(network->num_layers), sizeof(int), 1, fp);
   if ( !(network->layer = (layer_t*) s_malloc(network->num_layers*sizeof(layer_t))) )
     die("Unable to allocate memory");
 
-  fread(&(network->layer[0].neurons), sizeof(int), 1, fp);
-  network->layer[0].output      = (float*) s_calloc(network->layer[0].neurons+1, sizeof(float));
-  network->layer[0].error       = (float*) s_calloc(network->layer[0].neurons+1, sizeof(float));
-  network->layer[0].weight      = NULL;
-  network->layer[0].weight_save  = NULL;
-  network->layer[0].weight_change = NULL;
-   
+  for (l=0; l<network->num_layers; l++)
+    fread(&(network->layer[l].neurons), sizeof(int), 1, fp);
+
+  nn_allocate(network);
+
+  network->layer[0].output[0]   = network->bias;
   for (l=1; l<network->num_layers; l++)
     {
-    fread(&(network->layer[l].neurons), sizeof(float), 1, fp);
-    network->layer[l].output      = (float*)  s_calloc(network->layer[l].neurons+1, sizeof(float));
-    network->layer[l].error       = (float*)  s_calloc(network->layer[l].neurons+1, sizeof(float));
-    network->layer[l].weight      = (float**) s_calloc(network->layer[l].neurons+1, sizeof(float*));
-    network->layer[l].weight_save  = (float**) s_calloc(network->layer[l].neurons+1, sizeof(float*));
-    network->layer[l].weight_change = (float**) s_calloc(network->layer[l].neurons+1, sizeof(float*));
     network->layer[l].output[0]   = network->bias;
-      
+
     for (i=1; i<=network->layer[l].neurons; i++)
-      {
-      network->layer[l].weight[i]      = (float*) s_calloc(network->layer[l-1].neurons+1, sizeof(float));
       fread(network->layer[l].weight[i], sizeof(float), network->layer[l-1].neurons+1, fp);
-      network->layer[l].weight_save[i]  = (float*) s_calloc(network->layer[l-1].neurons+1, sizeof(float));
-      network->layer[l].weight_change[i] = (float*) s_calloc(network->layer[l-1].neurons+1, sizeof(float));
-      }
     }
 
   fclose(fp);
@@ -643,32 +663,14 @@ network_t *NN_read(const char *fname)
   synopsis:     Deallocate a network_t structure and its contents.
   parameters:   network_t *network
   return:       none
-  last updated: 29 Nov 2001
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 void NN_destroy(network_t *network)
   {
-  int l,i;
-
-  for (l=0; l<network->num_layers; l++)
-    {
-    if (l != 0)
-      {
-      for (i=1; i<=network->layer[l].neurons; i++)
-        {
-        s_free(network->layer[l].weight[i]);
-        s_free(network->layer[l].weight_save[i]);
-        s_free(network->layer[l].weight_change[i]);
-        }
-
-      s_free(network->layer[l].output);
-      s_free(network->layer[l].error);
-      s_free(network->layer[l].weight);
-      s_free(network->layer[l].weight_save);
-      s_free(network->layer[l].weight_change);
-      }
-    }
 
+  s_free(network->block);
+  s_free(network->rows);
   s_free(network->layer);
   s_free(network);
 
@@ -890,31 +892,176 @@ void NN_restore_weights(network_t *network)
   }
 
 
+/**********************************************************************
+  nn_gemv()
+  synopsis:     Multiply a layer's weight matrix by the previous
+		layer's outputs.  Rows are taken four at a time, each
+		with independent partial sums over blocks of
+		NN_ALIGN_FLOATS columns, which the compiler may
+		vectorise.  The padding of both rows and outputs is
+		zero, so whole blocks are always summed.
+  parameters:   const float *weight	First row of the matrix.
+		const int stride	Padded length of each row.
+		const int num_rows	Number of rows.
+		const float *input	Previous layer's outputs.
+		float *sum		Returns the dot product of each
+					row with the outputs.
+  return:       none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+NN_CLONES
+static void nn_gemv( const float *weight, const int stride, const int num_rows,
+                     const float *input, float *sum )
+  {
+  float		acc[4][NN_ALIGN_FLOATS];	/* Partial sums. */
+  const float	*row;		/* Current row. */
+  int		i;		/* Row index. */
+  int		j;		/* Column index. */
+  int		k;		/* Partial sum index. */
+
+  for (i=0; i+4<=num_rows; i+=4)
+    {
+    row = weight+(size_t) i*stride;
+
+    for (k=0; k<NN_ALIGN_FLOATS; k++)
+      acc[0][k] = acc[1][k] = acc[2][k] = acc[3][k] = 0.0f;
+
+    for (j=0; j<stride; j+=NN_ALIGN_FLOATS)
+      {
+      for (k=0; k<NN_ALIGN_FLOATS; k++)
+        {
+        acc[0][k] += row[j+k]*input[j+k];
+        acc[1][k] += row[stride+j+k]*input[j+k];
+        acc[2][k] += row[2*stride+j+k]*input[j+k];
+        acc[3][k] += row[3*stride+j+k]*input[j+k];
+        }
+      }
+
+    for (k=1; k<NN_ALIGN_FLOATS; k++)
+      {
+      acc[0][0] += acc[0][k];
+      acc[1][0] += acc[1][k];
+      acc[2][0] += acc[2][k];
+      acc[3][0] += acc[3][k];
+      }
+
+    sum[i] = acc[0][0];
+    sum[i+1] = acc[1][0];
+    sum[i+2] = acc[2][0];
+    sum[i+3] = acc[3][0];
+    }
+
+  for (; i<num_rows; i++)
+    {
+    row = weight+(size_t) i*stride;
+
+    for (k=0; k<NN_ALIGN_FLOATS; k++)
+      acc[0][k] = 0.0f;
+
+    for (j=0; j<stride; j+=NN_ALIGN_FLOATS)
+      for (k=0; k<NN_ALIGN_FLOATS; k++)
+        acc[0][k] += row[j+k]*input[j+k];
+
+    for (k=1; k<NN_ALIGN_FLOATS; k++)
+      acc[0][0] += acc[0][k];
+
+    sum[i] = acc[0][0];
+    }
+
+  return;
+  }
+
+
+/**********************************************************************
+  nn_sigmoid()
+  synopsis:     Single precision sigmoidal response, 1/(1+exp(-gain*x)),
+		of a padded vector of neurons.  The exponential is
+		computed as 2^n * 2^f, with n the nearest integer to
+		-gain*x/ln(2), 2^f from the Taylor series of
+		e^(f*ln(2)) for |f| <= 0.5, and 2^n formed directly in
+		the exponent bits.  The exponent is clamped by
+		comparing its bits as an integer.  The relative error
+		is below 1e-6, and there are no branches or library
+		calls, so each block of NN_ALIGN_FLOATS neurons may be
+		vectorised.
+  parameters:   float *x		Summed inputs, replaced by
+					the responses.
+		const int stride	Padded number of neurons.
+		const float gain	Gain of sigmoidal function.
+  return:       none
+  last updated: 17 Oct 2026
+ **********************************************************************/
+
+NN_CLONES
+static void nn_sigmoid(float *x, const int stride, const float gain)
+  {
+  union { float f; int i; }	t;	/* Exponent, in base 2. */
+  union { float f; int i; }	scale;	/* 2^n. */
+  float		f;		/* Fractional part of exponent. */
+  float		p;		/* e^(f*ln(2)). */
+  int		n;		/* Biased integer part of exponent. */
+  int		j;		/* Block index. */
+  int		k;		/* Neuron index within block. */
+
+  for (j=0; j<stride; j+=NN_ALIGN_FLOATS)
+    {
+    for (k=0; k<NN_ALIGN_FLOATS; k++)
+      {
+      t.f = -gain*x[j+k]*1.44269504f;
+      if ((t.i & 0x7fffffff) > NN_EXP2_LIMIT) t.i = (t.i & (int) 0x80000000) | NN_EXP2_LIMIT;
+
+      n = (int) (t.f+127.5f);		/* Nearest integer, plus 127, as t+127.5 > 0. */
+      f = (t.f-(float) (n-127))*0.693147181f;
+
+      p = 1.0f+f*(1.0f+f*(0.5f+f*(0.166666667f+f*(0.0416666667f+f*(0.00833333333f+f*0.00138888889f)))));
+
+      scale.i = n << 23;
+
+      x[j+k] = 1.0f/(1.0f+p*scale.f);
+      }
+    }
+
+  return;
+  }
+
+
 /**********************************************************************
   NN_propagate()
-  synopsis:     Propagate errors through network.
+  synopsis:     Propagate signals forward through network.  Each
+		layer's weights are a contiguous matrix, so this is a
+		blocked matrix-vector product followed by the
+		sigmoidal response.
   parameters:   network_t *network
   return:       none
-  last updated: 
+  last updated: 17 Oct 2026
  **********************************************************************/
 
 void NN_propagate(network_t *network)
   {
-  int l;
-  int  i,j;
-  float sum;
+  int		l;		/* Layer index. */
+  int		i;		/* Neuron index. */
+  float		*output;	/* Outputs of next layer. */
+  float		bias;		/* Bias of next layer. */
    
   for (l=0; l<network->num_layers-1; l++)
     {
-    for (i=1; i<=network->layer[l+1].neurons; i++)
-      {
-      sum = 0;
-      for (j=0; j<=network->layer[l].neurons; j++)
-        {
-        sum += network->layer[l+1].weight[i][j] * network->layer[l].output[j];
-        }
-      network->layer[l+1].output[i] = 1.0f / (1.0f + exp(-network->gain * sum));
-      }
+    output = network->layer[l+1].output;
+    bias = output[0];
+
+    if (network->layer[l+1].neurons > 0)
+      nn_gemv( network->layer[l+1].weight[1], network->layer[l].stride,
+               network->layer[l+1].neurons, network->layer[l].output, &(output[1]) );
+
+/*
+ * The response is computed for whole blocks, then the bias and
+ * padding are restored.
+ */
+    nn_sigmoid(output, network->layer[l+1].stride, network->gain);
+
+    output[0] = bias;
+    for (i=network->layer[l+1].neurons+1; i<network->layer[l+1].stride; i++)
+      output[i] = 0.0f;
     }
 
   return;
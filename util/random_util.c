@@ -83,6 +83,12 @@
 		o random_get_state() and random_set_state() may be used
 		  to set, save, restore, and query the current state.
 
+		o random_seed_state() and random_set_thread_state() may
+		  be used to give a thread its own private stream.  All
+		  of the functions below will then draw from that stream,
+		  without locking, until random_set_thread_state(NULL)
+		  is called from the same thread.
+
 		These functions can be tested by compiling with
 		something like:
 		gcc -o testrand random_util.c -DRANDOM_UTIL_TEST
@@ -117,6 +123,77 @@ static boolean		is_initialised=FALSE;
 
 THREAD_LOCK_DEFINE_STATIC(random_state_lock);
 
+/*
+ * Per-thread state override.
+ */
+#ifdef HAVE_PTHREADS
+static pthread_key_t	thread_state_key;
+static pthread_once_t	thread_state_key_once = PTHREAD_ONCE_INIT;
+
+static void random_thread_state_key_create(void)
+  {
+  if (pthread_key_create(&thread_state_key, NULL) != 0)
+    die("Unable to create thread-specific data key.");
+
+  return;
+  }
+#else
+static random_state	*thread_state=NULL;
+#endif
+
+
+/**********************************************************************
+  random_state_next()
+  synopsis:	Advance the given state and return the next value in
+		its sequence.  No locking is performed here.
+  parameters:	random_state *state
+  return:	unsigned int	Next value, from 0 to RANDOM_RAND_MAX.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static unsigned int random_state_next(random_state *state)
+  {
+  unsigned int val;
+
+  val = (state->v[state->j]+state->v[state->k])
+        & RANDOM_RAND_MAX;
+
+  state->x = (state->x+1) % RANDOM_NUM_STATE_VALS;
+  state->j = (state->j+1) % RANDOM_NUM_STATE_VALS;
+  state->k = (state->k+1) % RANDOM_NUM_STATE_VALS;
+  state->v[state->x] = val;
+
+  return val;
+  }
+
+
+/**********************************************************************
+  random_state_fill()
+  synopsis:	Use the linear congruential algorithm to fill the
+		given state array.  No locking is performed here.
+  parameters:	random_state *state
+		const unsigned int seed		Seed value.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+static void random_state_fill(random_state *state, const unsigned int seed)
+  {
+  int	i;
+
+  state->v[0]=(seed & RANDOM_RAND_MAX);
+
+  for(i=1; i<RANDOM_NUM_STATE_VALS; i++)
+    state->v[i] = (RANDOM_LC_ALPHA * state->v[i-1]
+                   + RANDOM_LC_BETA) & RANDOM_RAND_MAX;
+
+  state->j = 0;
+  state->k = RANDOM_MM_ALPHA-RANDOM_MM_BETA;
+  state->x = RANDOM_MM_ALPHA-0;
+
+  return;
+  }
+
 /**********************************************************************
  random_rand()
  Synopsis:	Replacement for the standard rand().
@@ -124,26 +201,34 @@ THREAD_LOCK_DEFINE_STATIC(random_state_lock);
 		the range 0 to RANDOM_RAND_MAX inclusive, and updates
 		global state for next call.  size should be non-zero,
 		and state should be initialized.
+		If the calling thread has a private state, installed
+		by random_set_thread_state(), then that is used instead
+		and no lock is taken.
   parameters:
   return:	none
-  last updated:	30/12/00
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 GAULFUNC unsigned int random_rand(void)
   {
   unsigned int val;
+  random_state	*state;		/* Thread's private state, if any. */
+
+#ifdef HAVE_PTHREADS
+  pthread_once(&thread_state_key_once, random_thread_state_key_create);
+
+  if ( (state = (random_state *) pthread_getspecific(thread_state_key)) != NULL )
+    return random_state_next(state);
+#else
+  if ( (state = thread_state) != NULL )
+    return random_state_next(state);
+#endif
 
   if (!is_initialised) die("Neither random_init() or random_seed() have been called.");
 
   THREAD_LOCK(random_state_lock);
 
-  val = (current_state.v[current_state.j]+current_state.v[current_state.k])
-        & RANDOM_RAND_MAX;
-
-  current_state.x = (current_state.x+1) % RANDOM_NUM_STATE_VALS;
-  current_state.j = (current_state.j+1) % RANDOM_NUM_STATE_VALS;
-  current_state.k = (current_state.k+1) % RANDOM_NUM_STATE_VALS;
-  current_state.v[current_state.x] = val;
+  val = random_state_next(&current_state);
 
   THREAD_UNLOCK(random_state_lock);
 
@@ -163,7 +248,6 @@ GAULFUNC unsigned int random_rand(void)
 
 GAULFUNC void random_seed(const unsigned int seed)
   { 
-  int	i; 
 
 #ifdef USE_OPENMP
   if (is_initialised == FALSE)
@@ -177,15 +261,7 @@ GAULFUNC void random_seed(const unsigned int seed)
 
   THREAD_LOCK(random_state_lock);
 
-  current_state.v[0]=(seed & RANDOM_RAND_MAX);
-
-  for(i=1; i<RANDOM_NUM_STATE_VALS; i++)
-    current_state.v[i] = (RANDOM_LC_ALPHA * current_state.v[i-1]
-                          + RANDOM_LC_BETA) & RANDOM_RAND_MAX;
-
-  current_state.j = 0;
-  current_state.k = RANDOM_MM_ALPHA-RANDOM_MM_BETA;
-  current_state.x = RANDOM_MM_ALPHA-0;
+  random_state_fill(&current_state, seed);
 
   THREAD_UNLOCK(random_state_lock);
 
@@ -193,6 +269,80 @@ GAULFUNC void random_seed(const unsigned int seed)
   } 
 
 
+/**********************************************************************
+  random_seed_state()
+  synopsis:	Seed a caller-owned state structure, using exactly
+		the same procedure as random_seed() does for the
+		global state.  The global state is untouched.
+  parameters:	random_state *state	State to initialise.
+		const unsigned int seed	Seed value.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void random_seed_state(random_state *state, const unsigned int seed)
+  {
+
+  if (!state) die("Null pointer to random_state structure passed.");
+
+  random_state_fill(state, seed);
+
+  return;
+  }
+
+
+/**********************************************************************
+  random_set_thread_state()
+  synopsis:	Install a private state for the calling thread.  All
+		subsequent PRNG calls made by this thread will use,
+		and advance, this state rather than the shared global
+		state, without any locking.  The state must remain
+		valid until random_set_thread_state(NULL) is called
+		from the same thread.
+		When compiled without pthreads support, there is only
+		one thread, so this simply overrides the global state.
+  parameters:	random_state *state	Private state, or NULL.
+  return:	none
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC void random_set_thread_state(random_state *state)
+  {
+
+#ifdef HAVE_PTHREADS
+  pthread_once(&thread_state_key_once, random_thread_state_key_create);
+
+  if (pthread_setspecific(thread_state_key, (void *) state) != 0)
+    die("Unable to set thread-specific data.");
+#else
+  thread_state = state;
+#endif
+
+  return;
+  }
+
+
+/**********************************************************************
+  random_get_thread_state()
+  synopsis:	Retrieve the calling thread's private state, if any.
+  parameters:	none
+  return:	random_state *	Private state, or NULL.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC random_state *random_get_thread_state(void)
+  {
+
+#ifdef HAVE_PTHREADS
+  pthread_once(&thread_state_key_once, random_thread_state_key_create);
+
+  return (random_state *) pthread_getspecific(thread_state_key);
+#else
+  return thread_state;
+#endif
+  }
+
+
 /**********************************************************************
   random_tseed()
   synopsis:	Set seed for pseudo random number generator from
@@ -739,21 +889,18 @@ double random_unit_gaussian(void)
 		deviation 1.0
   parameters:
   return:
-  last updated:	07 Jan 2002
+  last updated:	16 Oct 2026
  **********************************************************************/
 
 GAULFUNC double random_unit_gaussian(void)
   {
-  double		r, u, v, fac;
-  static boolean	set = FALSE;
-  static double		dset;
-
-  if (set)
-    {
-    set = FALSE;
-    return dset;
-    }
+  double		r, u, v;
 
+/*
+ * The second deviate of each pair used to be stored in a static
+ * variable, but it was never returned, and writing it from several
+ * threads was a data race.
+ */
   do
     {
     u = 2.0 * random_unit_uniform() - 1.0;
@@ -761,10 +908,7 @@ GAULFUNC double random_unit_gaussian(void)
     r = u*u + v*v;
     } while (r >= 1.0);
 
-  fac = sqrt(-2.0 * log(r) / r);
-  dset = v*fac;
-
-  return u*fac;
+  return u*sqrt(-2.0 * log(r) / r);
   }
 
 /* The original (thread-safe) version was this: */
@@ -33,10 +33,17 @@
   Bugs:		Note that the user time will be incorrect after about
 		72 minutes.
 
+		timer_monotonic() and timer_cpu() are cheap, high
+		resolution clocks intended for profiling.
+
  **********************************************************************/
 
 #include "gaul/timer_util.h"
 
+#if !defined(CLOCK_MONOTONIC) && defined(HAVE_SYS_TIME_H)
+# include <sys/time.h>
+#endif
+
 /**********************************************************************
   timer_diagnostics()
   synopsis:	Display diagnostic information.
@@ -108,6 +115,62 @@ GAULFUNC double timer_check(chrono_t *t)
   }
 
 
+/**********************************************************************
+  timer_monotonic()
+  synopsis:	Read a monotonic, high resolution, wall clock.  Only
+		differences between readings are meaningful.  Falls
+		back to gettimeofday(), which may jump if the system
+		time is changed, and then to clock().
+  parameters:	none
+  return:	time in seconds.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double timer_monotonic(void)
+  {
+#if defined(CLOCK_MONOTONIC)
+  struct timespec	ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return ts.tv_sec + ts.tv_nsec*1.0e-9;
+#elif defined(HAVE_SYS_TIME_H)
+  struct timeval	tv;
+
+  gettimeofday(&tv, NULL);
+
+  return tv.tv_sec + tv.tv_usec*1.0e-6;
+#else
+  return clock() / (double) CLOCKS_PER_SEC;
+#endif
+  }
+
+
+/**********************************************************************
+  timer_cpu()
+  synopsis:	Read the CPU time consumed by the calling thread, or
+		by the whole process where per-thread clocks are
+		unavailable.  Unlike timer_monotonic(), this usually
+		requires a system call.
+  parameters:	none
+  return:	CPU time in seconds.
+  last updated:	16 Oct 2026
+ **********************************************************************/
+
+GAULFUNC double timer_cpu(void)
+  {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+  struct timespec	ts;
+
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+  return ts.tv_sec + ts.tv_nsec*1.0e-9;
+#else
+  return clock() / (double) CLOCKS_PER_SEC;
+#endif
+  }
+
+
 /**********************************************************************
   SLang intrinsic wrappers.
   We can't use pointers from S-Lang, and structures are a pain in the